@@ -0,0 +1,254 @@
+#include "generators.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+namespace tsexam::benchmarks {
+
+using problem1::Point;
+using problem1::Triangle;
+
+//----------------------------------------------------
+// Synthetic triangle meshes
+//----------------------------------------------------
+
+void append_uv_sphere(
+    std::vector<Triangle>& triangles, const Point& center, double radius, std::size_t rings,
+    std::size_t segments
+) {
+    if (rings < 2 || segments < 3) {
+        throw std::invalid_argument("a UV sphere needs at least 2 rings and 3 segments");
+    }
+
+    // Ring vertices, computed once so that neighboring triangles share them bit for bit
+    std::vector<Point> ring_vertices;
+    ring_vertices.reserve((rings - 1) * segments);
+    for (std::size_t i = 1; i < rings; ++i) {
+        const double theta{std::numbers::pi * static_cast<double>(i) / static_cast<double>(rings)};
+        for (std::size_t j = 0; j < segments; ++j) {
+            const double phi{
+                2. * std::numbers::pi * static_cast<double>(j) / static_cast<double>(segments)
+            };
+            ring_vertices.push_back(
+                {center[0] + radius * std::sin(theta) * std::cos(phi),
+                 center[1] + radius * std::sin(theta) * std::sin(phi),
+                 center[2] + radius * std::cos(theta)}
+            );
+        }
+    }
+    auto vertex = [&ring_vertices, segments](std::size_t ring, std::size_t segment) {
+        return ring_vertices[(ring - 1) * segments + segment % segments];
+    };
+    const Point top{center[0], center[1], center[2] + radius};
+    const Point bottom{center[0], center[1], center[2] - radius};
+
+    triangles.reserve(triangles.size() + 2 * (rings - 1) * segments);
+    for (std::size_t j = 0; j < segments; ++j) {
+        // Counterclockwise seen from outside: down the meridian, then along the parallel
+        triangles.push_back({top, vertex(1, j), vertex(1, j + 1)});
+        for (std::size_t i = 1; i + 1 < rings; ++i) {
+            triangles.push_back({vertex(i, j), vertex(i + 1, j), vertex(i + 1, j + 1)});
+            triangles.push_back({vertex(i, j), vertex(i + 1, j + 1), vertex(i, j + 1)});
+        }
+        triangles.push_back({vertex(rings - 1, j), bottom, vertex(rings - 1, j + 1)});
+    }
+}
+
+void append_subdivided_cube(
+    std::vector<Triangle>& triangles, const Point& origin, double size, std::size_t subdivisions
+) {
+    if (subdivisions == 0) {
+        throw std::invalid_argument("a subdivided cube needs at least one subdivision");
+    }
+
+    // Grid point (i, j, k) of the cube; computed per coordinate so shared face borders match
+    const double step{size / static_cast<double>(subdivisions)};
+    auto grid_point = [&origin, step](const std::array<std::size_t, 3>& ijk) {
+        return Point{
+            origin[0] + step * static_cast<double>(ijk[0]),
+            origin[1] + step * static_cast<double>(ijk[1]),
+            origin[2] + step * static_cast<double>(ijk[2])
+        };
+    };
+
+    // Faces as (fixed axis, fixed at max?, u axis, v axis) with u x v pointing outward
+    struct Face {
+        std::size_t axis;
+        bool at_max;
+        std::size_t u;
+        std::size_t v;
+    };
+    constexpr std::array<Face, 6> kFaces{{
+        {2, false, 1, 0},
+        {2, true, 0, 1},
+        {1, false, 0, 2},
+        {1, true, 2, 0},
+        {0, false, 2, 1},
+        {0, true, 1, 2},
+    }};
+
+    triangles.reserve(triangles.size() + 12 * subdivisions * subdivisions);
+    for (const Face& face : kFaces) {
+        for (std::size_t s = 0; s < subdivisions; ++s) {
+            for (std::size_t t = 0; t < subdivisions; ++t) {
+                std::array<std::size_t, 3> ijk{};
+                ijk[face.axis] = face.at_max ? subdivisions : 0;
+                auto corner = [&](std::size_t du, std::size_t dv) {
+                    ijk[face.u] = s + du;
+                    ijk[face.v] = t + dv;
+                    return grid_point(ijk);
+                };
+                const Point p0{corner(0, 0)};
+                const Point p1{corner(1, 0)};
+                const Point p2{corner(1, 1)};
+                const Point p3{corner(0, 1)};
+                triangles.push_back({p0, p1, p2});
+                triangles.push_back({p0, p2, p3});
+            }
+        }
+    }
+}
+
+/// Smallest n such that n^3 >= count
+static std::size_t cube_root_ceil(std::size_t count) {
+    std::size_t n{0};
+    while (n * n * n < count) {
+        ++n;
+    }
+    return n;
+}
+
+std::vector<Triangle> make_nested_spheres(
+    std::size_t num_voids, std::size_t rings, std::size_t segments
+) {
+    std::vector<Triangle> triangles;
+    triangles.reserve((num_voids + 1) * 2 * (rings - 1) * segments);
+    append_uv_sphere(triangles, {0., 0., 0.}, 1., rings, segments);
+
+    // Inner spheres on a regular grid inside the cube [-0.4, 0.4]^3, which stays inside the
+    // tessellated unit sphere for any practical number of rings and segments
+    constexpr double kHalfExtent{0.4};
+    const std::size_t per_axis{cube_root_ceil(num_voids)};
+    const double cell{2. * kHalfExtent / static_cast<double>(std::max<std::size_t>(per_axis, 1))};
+    for (std::size_t n = 0; n < num_voids; ++n) {
+        const std::size_t ix{n % per_axis};
+        const std::size_t iy{(n / per_axis) % per_axis};
+        const std::size_t iz{n / (per_axis * per_axis)};
+        const Point center{
+            -kHalfExtent + cell * (static_cast<double>(ix) + 0.5),
+            -kHalfExtent + cell * (static_cast<double>(iy) + 0.5),
+            -kHalfExtent + cell * (static_cast<double>(iz) + 0.5)
+        };
+        append_uv_sphere(triangles, center, 0.35 * cell, rings, segments);
+    }
+    return triangles;
+}
+
+std::vector<Triangle> make_shell_lattice(std::size_t num_shells, std::size_t subdivisions) {
+    const std::size_t per_axis{cube_root_ceil(num_shells)};
+
+    std::vector<Triangle> triangles;
+    triangles.reserve(12 + num_shells * 12 * subdivisions * subdivisions);
+    append_subdivided_cube(triangles, {-0.5, -0.5, -0.5}, static_cast<double>(per_axis) + 1., 1);
+
+    // Inner cube n occupies [0.25, 0.75]^3 of its unit lattice cell
+    for (std::size_t n = 0; n < num_shells; ++n) {
+        const Point origin{
+            static_cast<double>(n % per_axis) + 0.25,
+            static_cast<double>((n / per_axis) % per_axis) + 0.25,
+            static_cast<double>(n / (per_axis * per_axis)) + 0.25
+        };
+        append_subdivided_cube(triangles, origin, 0.5, subdivisions);
+    }
+    return triangles;
+}
+
+std::size_t flip_random_triangles(
+    std::vector<Triangle>& triangles, double fraction, std::uint64_t seed
+) {
+    std::mt19937_64 generator{seed};
+    std::bernoulli_distribution flip{fraction};
+    std::size_t num_flipped{0};
+    for (Triangle& triangle : triangles) {
+        if (flip(generator)) {
+            std::swap(triangle.b, triangle.c);
+            ++num_flipped;
+        }
+    }
+    return num_flipped;
+}
+
+//----------------------------------------------------
+// Synthetic polylines
+//----------------------------------------------------
+
+SyntheticPolyline make_random_polyline(std::size_t num_segments, bool closed, std::uint64_t seed) {
+    if (num_segments < (closed ? 3u : 1u)) {
+        throw std::invalid_argument("too few segments for the requested polyline type");
+    }
+    const std::size_t num_vertices{closed ? num_segments : num_segments + 1};
+    constexpr auto kMaxVertices{
+        static_cast<std::size_t>(std::numeric_limits<problem2::VertexIndex>::max())
+    };
+    if (num_vertices > kMaxVertices) {
+        throw std::invalid_argument("too many vertices for the polyline vertex index type");
+    }
+
+    std::mt19937_64 generator{seed};
+
+    // Traversal order: a random permutation of the vertex ids
+    std::vector<problem2::VertexIndex> order(num_vertices);
+    std::iota(order.begin(), order.end(), problem2::VertexIndex{0});
+    std::shuffle(order.begin(), order.end(), generator);
+
+    // Segments between consecutive vertices of the traversal, each with a random direction
+    std::vector<std::pair<problem2::VertexIndex, problem2::VertexIndex>> pairs;
+    pairs.reserve(num_segments);
+    std::bernoulli_distribution flip{0.5};
+    for (std::size_t i = 0; i < num_segments; ++i) {
+        const problem2::VertexIndex from{order[i]};
+        const problem2::VertexIndex to{order[(i + 1) % num_vertices]};
+        pairs.push_back(flip(generator) ? std::pair{to, from} : std::pair{from, to});
+    }
+    std::shuffle(pairs.begin(), pairs.end(), generator);
+
+    SyntheticPolyline polyline;
+    polyline.segments.reserve(2 * num_segments);
+    for (const auto& [from, to] : pairs) {
+        polyline.segments.push_back(from);
+        polyline.segments.push_back(to);
+    }
+
+    std::uniform_real_distribution<double> coordinate{-1., 1.};
+    polyline.vertices.resize(num_vertices);
+    for (problem2::Point& vertex : polyline.vertices) {
+        vertex = {coordinate(generator), coordinate(generator), coordinate(generator)};
+    }
+    return polyline;
+}
+
+SyntheticPolylineBatch make_random_polyline_batch(
+    std::size_t num_polylines, std::size_t num_segments, std::uint64_t seed
+) {
+    SyntheticPolylineBatch batch;
+    batch.offsets.push_back(0);
+    for (std::size_t k = 0; k < num_polylines; ++k) {
+        const SyntheticPolyline polyline{make_random_polyline(num_segments, k % 2 == 1, seed + k)};
+        const auto first_vertex{static_cast<problem2::VertexIndex>(batch.vertices.size())};
+        for (const problem2::VertexIndex vertex : polyline.segments) {
+            batch.data.push_back(first_vertex + vertex);
+        }
+        batch.offsets.push_back(batch.data.size());
+        batch.vertices.insert(batch.vertices.end(), polyline.vertices.begin(),
+                              polyline.vertices.end());
+    }
+    return batch;
+}
+
+}  // namespace tsexam::benchmarks
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "problem_1/geometry.hpp"
+#include "problem_2/polyline.hpp"
+
+namespace tsexam::benchmarks {
+
+//----------------------------------------------------
+// Synthetic triangle meshes
+//----------------------------------------------------
+
+/**
+ * @brief Appends a closed, outward-oriented UV sphere
+ *
+ * Every vertex is computed once and shared bit-for-bit by its triangles, so the sphere is a
+ * closed 2-manifold without degenerate triangles.
+ *
+ * @param triangles Triangle list to append to
+ * @param center Sphere center
+ * @param radius Sphere radius
+ * @param rings Number of latitude bands (>= 2)
+ * @param segments Number of longitude segments (>= 3)
+ *
+ * @throws std::invalid_argument if rings < 2 or segments < 3
+ */
+void append_uv_sphere(
+    std::vector<problem1::Triangle>& triangles, const problem1::Point& center, double radius,
+    std::size_t rings, std::size_t segments
+);
+
+/**
+ * @brief Appends a closed, outward-oriented axis-aligned cube with every face split into a grid
+ *
+ * @param triangles Triangle list to append to
+ * @param origin Minimum corner
+ * @param size Edge length
+ * @param subdivisions Number of grid cells along every cube edge (>= 1); the cube has
+ *        12 * subdivisions^2 triangles
+ *
+ * @throws std::invalid_argument if subdivisions is 0
+ */
+void append_subdivided_cube(
+    std::vector<problem1::Triangle>& triangles, const problem1::Point& origin, double size,
+    std::size_t subdivisions
+);
+
+/**
+ * @brief Makes a large sphere enclosing `num_voids` smaller, disjoint spheres
+ *
+ * The outer sphere is the first component; the inner spheres sit on a regular grid inside it and
+ * are all voids, both by AABB containment and by point-in-solid classification.
+ *
+ * @param num_voids Number of inner spheres
+ * @param rings Latitude bands of every sphere
+ * @param segments Longitude segments of every sphere
+ * @return Triangles of all spheres, 2 * (rings - 1) * segments per sphere
+ */
+std::vector<problem1::Triangle> make_nested_spheres(
+    std::size_t num_voids, std::size_t rings, std::size_t segments
+);
+
+/**
+ * @brief Makes a lattice of `num_shells` disjoint cube shells enclosed by one outer cube
+ *
+ * Models lattice parts with many small shells: every inner cube is a separate component and a
+ * void of the outer cube.
+ *
+ * @param num_shells Number of inner cubes
+ * @param subdivisions Face subdivisions of every inner cube
+ * @return Triangles of the outer cube followed by the inner cubes
+ */
+std::vector<problem1::Triangle> make_shell_lattice(
+    std::size_t num_shells, std::size_t subdivisions
+);
+
+/**
+ * @brief Flips a random subset of triangles (swaps their second and third vertices)
+ *
+ * @param triangles Triangles to modify
+ * @param fraction Probability that any one triangle is flipped
+ * @param seed Random seed (the result is deterministic for a given seed)
+ * @return Number of flipped triangles
+ */
+std::size_t flip_random_triangles(
+    std::vector<problem1::Triangle>& triangles, double fraction, std::uint64_t seed
+);
+
+//----------------------------------------------------
+// Synthetic polylines
+//----------------------------------------------------
+
+/// Polyline input in verbose segment form together with its vertex coordinates
+struct SyntheticPolyline {
+    std::vector<problem2::VertexIndex> segments;  ///< flat list of vertex index pairs
+    std::vector<problem2::Point> vertices;        ///< vertex coordinates
+};
+
+/**
+ * @brief Makes a single open or closed polyline with shuffled, randomly flipped segments
+ *
+ * The vertices are visited in a random permutation of [0, num_segments + 1) (open) or
+ * [0, num_segments) (closed), so the traversal jumps all over the index space like real data.
+ *
+ * @param num_segments Number of segments (>= 1 open, >= 3 closed)
+ * @param closed Whether the polyline is closed
+ * @param seed Random seed (the result is deterministic for a given seed)
+ * @return Verbose segments and vertex coordinates
+ *
+ * @throws std::invalid_argument if there are fewer segments than the polyline type allows
+ */
+SyntheticPolyline make_random_polyline(std::size_t num_segments, bool closed, std::uint64_t seed);
+
+/// Batch of polylines in one flat verbose segment buffer over a shared vertex pool
+struct SyntheticPolylineBatch {
+    std::vector<problem2::VertexIndex> data;  ///< verbose segments of all polylines, back to back
+    std::vector<std::size_t> offsets;         ///< start of every polyline in `data`, then its size
+    std::vector<problem2::Point> vertices;    ///< shared vertex pool
+};
+
+/**
+ * @brief Makes a batch of alternately open and closed polylines, like the contours of a slice
+ *
+ * Polyline k is `make_random_polyline(num_segments, k % 2 == 1, seed + k)` with its vertex ids
+ * shifted past those of the previous polylines, so every polyline spans its own range of the pool.
+ *
+ * @param num_polylines Number of polylines
+ * @param num_segments Number of segments of every polyline (>= 3)
+ * @param seed Random seed (the result is deterministic for a given seed)
+ * @return Flat segments, offsets and vertex pool
+ */
+SyntheticPolylineBatch make_random_polyline_batch(
+    std::size_t num_polylines, std::size_t num_segments, std::uint64_t seed
+);
+
+}  // namespace tsexam::benchmarks
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+
+namespace tsexam::benchmarks {
+
+/**
+ * @brief Output stream that discards everything written to it and counts the bytes
+ *
+ * Lets the writer benchmarks measure formatting and buffering without memory or disk traffic for
+ * the output itself.
+ */
+class NullStream : public std::ostream {
+public:
+    NullStream() : std::ostream(&buffer_) {}
+
+    /// Number of bytes written so far
+    std::size_t BytesWritten() const { return buffer_.bytes_written; }
+
+private:
+    struct CountingBuffer : std::streambuf {
+        std::size_t bytes_written{0};
+
+        int_type overflow(int_type c) override {
+            if (!traits_type::eq_int_type(c, traits_type::eof())) {
+                ++this->bytes_written;
+            }
+            return traits_type::not_eof(c);
+        }
+
+        std::streamsize xsputn(const char*, std::streamsize count) override {
+            this->bytes_written += static_cast<std::size_t>(count);
+            return count;
+        }
+    };
+
+    CountingBuffer buffer_;
+};
+
+}  // namespace tsexam::benchmarks
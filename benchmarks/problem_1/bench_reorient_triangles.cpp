@@ -0,0 +1,179 @@
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "generators.hpp"
+#include "null_stream.hpp"
+#include "problem_1/geometry.hpp"
+#include "problem_1/mesh_analysis.hpp"
+#include "problem_1/reorient_triangles.hpp"
+#include "problem_1/stl_io.hpp"
+#include "problem_1/triangle_mesh.hpp"
+
+using tsexam::benchmarks::flip_random_triangles;
+using tsexam::benchmarks::make_nested_spheres;
+using tsexam::benchmarks::make_shell_lattice;
+using tsexam::benchmarks::NullStream;
+using tsexam::problem1::are_orientations_consistent;
+using tsexam::problem1::export_inconsistent_triangles;
+using tsexam::problem1::export_voids_to_stl;
+using tsexam::problem1::flip_triangle;
+using tsexam::problem1::has_directed_edge;
+using tsexam::problem1::make_edge;
+using tsexam::problem1::MeshAnalysis;
+using tsexam::problem1::reorient_all_components;
+using tsexam::problem1::reorient_inconsistent_triangles;
+using tsexam::problem1::StlFormat;
+using tsexam::problem1::Triangle;
+using tsexam::problem1::TriangleMesh;
+
+//---------------------------------------------------------------------------
+// Fixtures
+//---------------------------------------------------------------------------
+
+/// Fraction of triangles flipped in the reorientation fixtures
+constexpr double kFlipFraction{0.25};
+
+/// Nested spheres with `num_voids` voids and a quarter of the triangles flipped
+static TriangleMesh make_scrambled_spheres(std::int64_t num_voids) {
+    std::vector<Triangle> triangles{
+        make_nested_spheres(static_cast<std::size_t>(num_voids), 32, 64)
+    };
+    flip_random_triangles(triangles, kFlipFraction, 42);
+    return TriangleMesh(std::move(triangles));
+}
+
+//---------------------------------------------------------------------------
+// Triangle predicates
+//---------------------------------------------------------------------------
+
+static void BM_FlipTriangle(benchmark::State& state) {
+    Triangle triangle{{0., 0., 0.}, {1., 0., 0.}, {0., 1., 0.}};
+    for (auto _ : state) {
+        flip_triangle(triangle);
+        benchmark::DoNotOptimize(triangle);
+    }
+}
+BENCHMARK(BM_FlipTriangle);
+
+static void BM_HasDirectedEdge(benchmark::State& state) {
+    const Triangle triangle{{0., 0., 0.}, {1., 0., 0.}, {0., 1., 0.}};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(has_directed_edge(triangle, triangle.c, triangle.a));
+    }
+}
+BENCHMARK(BM_HasDirectedEdge);
+
+static void BM_AreOrientationsConsistent(benchmark::State& state) {
+    const Triangle t0{{0., 0., 0.}, {1., 0., 0.}, {0., 1., 0.}};
+    const Triangle t1{{1., 0., 0.}, {1., 1., 0.}, {0., 1., 0.}};
+    const auto edge{make_edge(t0.b, t0.c)};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(are_orientations_consistent(t0, t1, edge));
+    }
+}
+BENCHMARK(BM_AreOrientationsConsistent);
+
+//---------------------------------------------------------------------------
+// Reorientation
+//---------------------------------------------------------------------------
+
+/// Args: number of voids (the seed component is the outer sphere)
+static void BM_ReorientInconsistentTriangles(benchmark::State& state) {
+    TriangleMesh mesh{make_scrambled_spheres(state.range(0))};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(reorient_inconsistent_triangles(mesh, 0));
+    }
+}
+BENCHMARK(BM_ReorientInconsistentTriangles)->Arg(8)->Arg(64)->Unit(benchmark::kMillisecond);
+
+/// Args: output format, number of voids
+static void BM_ExportInconsistentTriangles(benchmark::State& state) {
+    TriangleMesh mesh{make_scrambled_spheres(state.range(1))};
+    const auto format{static_cast<StlFormat>(state.range(0))};
+    NullStream out;
+    for (auto _ : state) {
+        export_inconsistent_triangles(mesh, 0, out, format);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(out.BytesWritten()));
+}
+BENCHMARK(BM_ExportInconsistentTriangles)
+    ->ArgsProduct({{static_cast<std::int64_t>(StlFormat::kAscii),
+                    static_cast<std::int64_t>(StlFormat::kBinary)},
+                   {8, 64}})
+    ->Unit(benchmark::kMillisecond);
+
+/// Args: number of voids, number of threads
+static void BM_ReorientAllComponentsSpheres(benchmark::State& state) {
+    const TriangleMesh scrambled{make_scrambled_spheres(state.range(0))};
+    const auto num_threads{static_cast<std::size_t>(state.range(1))};
+    for (auto _ : state) {
+        // Every run repairs a fresh copy; the copy is not timed
+        state.PauseTiming();
+        TriangleMesh mesh{scrambled};
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(reorient_all_components(mesh, num_threads));
+    }
+    state.SetItemsProcessed(
+        state.iterations() * static_cast<std::int64_t>(scrambled.GetTriangles().size())
+    );
+}
+BENCHMARK(BM_ReorientAllComponentsSpheres)
+    ->ArgsProduct({{64, 256}, {1, 4}})
+    ->Unit(benchmark::kMillisecond);
+
+/// Args: number of lattice shells, number of threads
+static void BM_ReorientAllComponentsLattice(benchmark::State& state) {
+    std::vector<Triangle> triangles{
+        make_shell_lattice(static_cast<std::size_t>(state.range(0)), 2)
+    };
+    flip_random_triangles(triangles, kFlipFraction, 42);
+    const TriangleMesh scrambled(std::move(triangles));
+    const auto num_threads{static_cast<std::size_t>(state.range(1))};
+    for (auto _ : state) {
+        state.PauseTiming();
+        TriangleMesh mesh{scrambled};
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(reorient_all_components(mesh, num_threads));
+    }
+    state.SetItemsProcessed(
+        state.iterations() * static_cast<std::int64_t>(scrambled.GetTriangles().size())
+    );
+}
+BENCHMARK(BM_ReorientAllComponentsLattice)
+    ->ArgsProduct({{1000, 10000}, {1, 4}})
+    ->Unit(benchmark::kMillisecond);
+
+//---------------------------------------------------------------------------
+// Combined repair and void check
+//---------------------------------------------------------------------------
+
+/// Args: number of voids; the two exports each traverse the mesh
+static void BM_RepairAndVoidCheckSeparately(benchmark::State& state) {
+    const TriangleMesh mesh{make_scrambled_spheres(state.range(0))};
+    for (auto _ : state) {
+        NullStream voids_out;
+        NullStream reoriented_out;
+        export_voids_to_stl(mesh, voids_out, StlFormat::kBinary);
+        export_inconsistent_triangles(mesh, 0, reoriented_out, StlFormat::kBinary);
+        benchmark::DoNotOptimize(reoriented_out.BytesWritten());
+    }
+}
+BENCHMARK(BM_RepairAndVoidCheckSeparately)->Arg(8)->Arg(64)->Unit(benchmark::kMillisecond);
+
+/// Args: number of voids; both exports run from one `MeshAnalysis`
+static void BM_RepairAndVoidCheckWithMeshAnalysis(benchmark::State& state) {
+    const TriangleMesh mesh{make_scrambled_spheres(state.range(0))};
+    for (auto _ : state) {
+        NullStream voids_out;
+        NullStream reoriented_out;
+        const MeshAnalysis analysis(mesh);
+        export_voids_to_stl(analysis, voids_out, StlFormat::kBinary);
+        export_inconsistent_triangles(analysis, 0, reoriented_out, StlFormat::kBinary);
+        benchmark::DoNotOptimize(reoriented_out.BytesWritten());
+    }
+}
+BENCHMARK(BM_RepairAndVoidCheckWithMeshAnalysis)->Arg(8)->Arg(64)->Unit(benchmark::kMillisecond);
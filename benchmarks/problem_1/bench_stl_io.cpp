@@ -0,0 +1,204 @@
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "generators.hpp"
+#include "null_stream.hpp"
+#include "problem_1/stl_io.hpp"
+
+using tsexam::benchmarks::make_nested_spheres;
+using tsexam::benchmarks::NullStream;
+using tsexam::problem1::convert_binary_stl_to_ascii;
+using tsexam::problem1::detect_stl_format;
+using tsexam::problem1::parse_ascii_stl;
+using tsexam::problem1::parse_binary_stl;
+using tsexam::problem1::StlFormat;
+using tsexam::problem1::StlWriter;
+using tsexam::problem1::Triangle;
+using tsexam::problem1::write_ascii_stl;
+using tsexam::problem1::write_binary_stl;
+using tsexam::problem1::write_triangle_in_ascii_stl;
+
+//---------------------------------------------------------------------------
+// Fixtures
+//---------------------------------------------------------------------------
+
+/// Nested spheres with `num_voids` voids, 3968 triangles per sphere
+static std::vector<Triangle> make_triangles(std::int64_t num_voids) {
+    return make_nested_spheres(static_cast<std::size_t>(num_voids), 32, 64);
+}
+
+static std::string to_ascii_stl(const std::vector<Triangle>& triangles) {
+    std::ostringstream out;
+    write_ascii_stl(out, "bench", triangles);
+    return out.str();
+}
+
+static std::string to_binary_stl(const std::vector<Triangle>& triangles) {
+    std::ostringstream out(std::ios::binary);
+    write_binary_stl(out, "bench", triangles);
+    return out.str();
+}
+
+//---------------------------------------------------------------------------
+// Format detection
+//---------------------------------------------------------------------------
+
+static void BM_DetectStlFormatBytes(benchmark::State& state) {
+    const std::string bytes{to_binary_stl(make_triangles(8))};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(detect_stl_format(std::string_view{bytes}));
+    }
+}
+BENCHMARK(BM_DetectStlFormatBytes);
+
+static void BM_DetectStlFormatStream(benchmark::State& state) {
+    const std::string bytes{to_binary_stl(make_triangles(8))};
+    for (auto _ : state) {
+        std::istringstream in(bytes, std::ios::binary);
+        benchmark::DoNotOptimize(detect_stl_format(in));
+    }
+}
+BENCHMARK(BM_DetectStlFormatStream);
+
+//---------------------------------------------------------------------------
+// Parsing
+//---------------------------------------------------------------------------
+
+/// Args: number of voids
+static void BM_ParseAsciiStlStream(benchmark::State& state) {
+    const std::string text{to_ascii_stl(make_triangles(state.range(0)))};
+    for (auto _ : state) {
+        std::istringstream in(text);
+        benchmark::DoNotOptimize(parse_ascii_stl(in));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(text.size()));
+}
+BENCHMARK(BM_ParseAsciiStlStream)->Arg(8)->Arg(64)->Unit(benchmark::kMillisecond);
+
+/// Args: number of voids
+static void BM_ParseAsciiStlText(benchmark::State& state) {
+    const std::string text{to_ascii_stl(make_triangles(state.range(0)))};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parse_ascii_stl(std::string_view{text}));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(text.size()));
+}
+BENCHMARK(BM_ParseAsciiStlText)->Arg(8)->Arg(64)->Unit(benchmark::kMillisecond);
+
+/// Args: number of voids, number of threads
+static void BM_ParseAsciiStlTextParallel(benchmark::State& state) {
+    const std::string text{to_ascii_stl(make_triangles(state.range(0)))};
+    const auto num_threads{static_cast<std::size_t>(state.range(1))};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parse_ascii_stl(std::string_view{text}, num_threads));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(text.size()));
+}
+BENCHMARK(BM_ParseAsciiStlTextParallel)
+    ->ArgsProduct({{8, 64}, {1, 4}})
+    ->Unit(benchmark::kMillisecond);
+
+/// Args: number of voids
+static void BM_ParseBinaryStlStream(benchmark::State& state) {
+    const std::string bytes{to_binary_stl(make_triangles(state.range(0)))};
+    for (auto _ : state) {
+        std::istringstream in(bytes, std::ios::binary);
+        benchmark::DoNotOptimize(parse_binary_stl(in));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(bytes.size()));
+}
+BENCHMARK(BM_ParseBinaryStlStream)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+
+/// Args: number of voids
+static void BM_ParseBinaryStlBytes(benchmark::State& state) {
+    const std::string bytes{to_binary_stl(make_triangles(state.range(0)))};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parse_binary_stl(std::string_view{bytes}));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(bytes.size()));
+}
+BENCHMARK(BM_ParseBinaryStlBytes)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+
+//---------------------------------------------------------------------------
+// Writing
+//---------------------------------------------------------------------------
+
+static void BM_WriteTriangleInAsciiStl(benchmark::State& state) {
+    const Triangle triangle{{0.1, 1. / 3., -2.5}, {123.456, 1e-7, 7.}, {-4.75, 1e6, 0.5}};
+    NullStream out;
+    for (auto _ : state) {
+        write_triangle_in_ascii_stl(out, triangle);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(out.BytesWritten()));
+}
+BENCHMARK(BM_WriteTriangleInAsciiStl);
+
+/// Args: number of voids
+static void BM_WriteAsciiStl(benchmark::State& state) {
+    const std::vector<Triangle> triangles{make_triangles(state.range(0))};
+    NullStream out;
+    for (auto _ : state) {
+        write_ascii_stl(out, "bench", triangles);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(out.BytesWritten()));
+}
+BENCHMARK(BM_WriteAsciiStl)->Arg(8)->Arg(64)->Unit(benchmark::kMillisecond);
+
+/// Args: number of voids
+static void BM_WriteBinaryStl(benchmark::State& state) {
+    const std::vector<Triangle> triangles{make_triangles(state.range(0))};
+    NullStream out;
+    for (auto _ : state) {
+        write_binary_stl(out, "bench", triangles);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(out.BytesWritten()));
+}
+BENCHMARK(BM_WriteBinaryStl)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+
+/// Args: output format, number of voids
+static void BM_StlWriterStreaming(benchmark::State& state) {
+    const std::vector<Triangle> triangles{make_triangles(state.range(1))};
+    const auto format{static_cast<StlFormat>(state.range(0))};
+    NullStream out;
+    for (auto _ : state) {
+        StlWriter writer(out, format, "bench", triangles.size());
+        for (const Triangle& triangle : triangles) {
+            writer.Write(triangle);
+        }
+        writer.Finish();
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(out.BytesWritten()));
+}
+BENCHMARK(BM_StlWriterStreaming)
+    ->ArgsProduct({{static_cast<std::int64_t>(StlFormat::kAscii),
+                    static_cast<std::int64_t>(StlFormat::kBinary)},
+                   {8, 64}})
+    ->Unit(benchmark::kMillisecond);
+
+/// Args: number of voids
+static void BM_ConvertBinaryStlToAscii(benchmark::State& state) {
+    const std::filesystem::path directory{std::filesystem::temp_directory_path()};
+    const std::filesystem::path binary_path{directory / "tsexam_bench_convert_binary.stl"};
+    const std::filesystem::path ascii_path{directory / "tsexam_bench_convert_ascii.stl"};
+    {
+        std::ofstream out(binary_path, std::ios::binary);
+        write_binary_stl(out, "bench", make_triangles(state.range(0)));
+    }
+    for (auto _ : state) {
+        convert_binary_stl_to_ascii(binary_path.string(), ascii_path.string());
+    }
+    state.SetBytesProcessed(
+        state.iterations() * static_cast<std::int64_t>(std::filesystem::file_size(binary_path))
+    );
+    std::filesystem::remove(binary_path);
+    std::filesystem::remove(ascii_path);
+}
+BENCHMARK(BM_ConvertBinaryStlToAscii)->Arg(8)->Arg(64)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,531 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "generators.hpp"
+#include "null_stream.hpp"
+#include "problem_1/mesh_cache.hpp"
+#include "problem_1/mesh_editor.hpp"
+#include "problem_1/stl_io.hpp"
+#include "problem_1/triangle_mesh.hpp"
+#include "problem_1/triangle_validation.hpp"
+#include "problem_1/void_detection.hpp"
+
+using tsexam::benchmarks::make_nested_spheres;
+using tsexam::benchmarks::make_shell_lattice;
+using tsexam::benchmarks::NullStream;
+using tsexam::problem1::aabb_contains;
+using tsexam::problem1::AabbContainmentIndex;
+using tsexam::problem1::AxisAlignedBoundingBox;
+using tsexam::problem1::classify_triangle;
+using tsexam::problem1::compute_component_aabb;
+using tsexam::problem1::ComponentSet;
+using tsexam::problem1::ConnectedComponent;
+using tsexam::problem1::ConnectivityEngine;
+using tsexam::problem1::Edge;
+using tsexam::problem1::EdgeBitsHash;
+using tsexam::problem1::EdgeEquality;
+using tsexam::problem1::EdgeHash;
+using tsexam::problem1::export_voids_to_stl;
+using tsexam::problem1::find_component_set;
+using tsexam::problem1::find_connected_components;
+using tsexam::problem1::find_first_degenerate_triangle;
+using tsexam::problem1::identify_voids;
+using tsexam::problem1::is_connected_component_closed;
+using tsexam::problem1::load_mesh_with_cache;
+using tsexam::problem1::make_edge;
+using tsexam::problem1::MeshEditor;
+using tsexam::problem1::StlFormat;
+using tsexam::problem1::Triangle;
+using tsexam::problem1::TriangleMesh;
+using tsexam::problem1::TriangleMeshF;
+using tsexam::problem1::TriangleDefect;
+using tsexam::problem1::TriangleIndex;
+using tsexam::problem1::TriangleMeshOptions;
+using tsexam::problem1::triangle_validation_kernel;
+using tsexam::problem1::VoidClassification;
+using tsexam::problem1::write_binary_stl;
+
+//---------------------------------------------------------------------------
+// Fixtures
+//---------------------------------------------------------------------------
+
+/// Tessellation of every generated sphere: 2 * 31 * 64 = 3968 triangles
+constexpr std::size_t kSphereRings{32};
+constexpr std::size_t kSphereSegments{64};
+
+/// Nested spheres fixture: one outer sphere and `num_voids` inner spheres
+static std::vector<Triangle> nested_spheres(std::int64_t num_voids) {
+    return make_nested_spheres(static_cast<std::size_t>(num_voids), kSphereRings, kSphereSegments);
+}
+
+/// Closed components of a mesh
+static std::vector<ConnectedComponent> closed_components(const TriangleMesh& mesh) {
+    std::vector<ConnectedComponent> closed;
+    for (ConnectedComponent& component : find_connected_components(mesh)) {
+        if (is_connected_component_closed(mesh, component)) {
+            closed.push_back(std::move(component));
+        }
+    }
+    return closed;
+}
+
+/// AABBs of the closed components of a mesh
+static std::vector<AxisAlignedBoundingBox> component_boxes(const TriangleMesh& mesh) {
+    std::vector<AxisAlignedBoundingBox> boxes;
+    for (const ConnectedComponent& component : closed_components(mesh)) {
+        boxes.push_back(compute_component_aabb(mesh, component));
+    }
+    return boxes;
+}
+
+//---------------------------------------------------------------------------
+// Load / connectivity
+//---------------------------------------------------------------------------
+
+/// Args: connectivity engine, number of voids
+static void BM_TriangleMeshFromTriangles(benchmark::State& state) {
+    const std::vector<Triangle> triangles{nested_spheres(state.range(1))};
+    const TriangleMeshOptions options{static_cast<ConnectivityEngine>(state.range(0))};
+    for (auto _ : state) {
+        TriangleMesh mesh(triangles, options);
+        benchmark::DoNotOptimize(mesh);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(triangles.size()));
+}
+BENCHMARK(BM_TriangleMeshFromTriangles)
+    ->ArgsProduct({{0, 1, 2, 4}, {8, 64, 256}})
+    ->Unit(benchmark::kMillisecond);
+
+/// Canonical edges of every triangle of the nested spheres, three per triangle (duplicates kept)
+static std::vector<Edge> nested_sphere_edges(std::int64_t num_voids) {
+    std::vector<Edge> edges;
+    for (const Triangle& triangle : nested_spheres(num_voids)) {
+        edges.push_back(make_edge(triangle.a, triangle.b));
+        edges.push_back(make_edge(triangle.b, triangle.c));
+        edges.push_back(make_edge(triangle.c, triangle.a));
+    }
+    return edges;
+}
+
+/// Hashes every triangle edge with `Hash`
+template <typename Hash>
+static void run_edge_hash(benchmark::State& state) {
+    const std::vector<Edge> edges{nested_sphere_edges(state.range(0))};
+    const Hash hash{};
+    for (auto _ : state) {
+        std::size_t sum{0};
+        for (const Edge& edge : edges) {
+            sum += hash(edge);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(edges.size()));
+}
+
+/// Args: number of voids; `std::hash<double>` per coordinate + boost combine
+static void BM_EdgeHash(benchmark::State& state) { run_edge_hash<EdgeHash>(state); }
+BENCHMARK(BM_EdgeHash)->Arg(64)->Unit(benchmark::kMicrosecond);
+
+/// Args: number of voids; raw coordinate bits, one multiply per lane + finalizer
+static void BM_EdgeBitsHash(benchmark::State& state) { run_edge_hash<EdgeBitsHash>(state); }
+BENCHMARK(BM_EdgeBitsHash)->Arg(64)->Unit(benchmark::kMicrosecond);
+
+/// Looks up every triangle edge in a `Map` filled with the unique edges (the queries of the
+/// neighbor table build)
+template <typename Map>
+static void run_edge_lookup(benchmark::State& state) {
+    const std::vector<Edge> edges{nested_sphere_edges(state.range(0))};
+    Map map;
+    map.reserve(edges.size() / 2);
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        map.try_emplace(edges[i], std::array<TriangleIndex, 2>{static_cast<TriangleIndex>(i), 0});
+    }
+    for (auto _ : state) {
+        TriangleIndex sum{0};
+        for (const Edge& edge : edges) {
+            sum ^= map.find(edge)->second[0];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(edges.size()));
+    state.counters["edges"] = static_cast<double>(map.size());
+}
+
+/// Args: number of voids; node-based map with `EdgeHash` (the `kEdgeHashMap` engine)
+static void BM_EdgeLookupUnorderedMap(benchmark::State& state) {
+    run_edge_lookup<TriangleMesh::EdgeMap>(state);
+}
+BENCHMARK(BM_EdgeLookupUnorderedMap)->Arg(8)->Arg(64)->Arg(256)->Unit(benchmark::kMicrosecond);
+
+/// Args: number of voids; node-based map with `EdgeBitsHash`, to separate hash and layout costs
+static void BM_EdgeLookupUnorderedMapBitsHash(benchmark::State& state) {
+    run_edge_lookup<std::pmr::unordered_map<
+        Edge, std::array<TriangleIndex, 2>, EdgeBitsHash, EdgeEquality>>(state);
+}
+BENCHMARK(BM_EdgeLookupUnorderedMapBitsHash)
+    ->Arg(8)
+    ->Arg(64)
+    ->Arg(256)
+    ->Unit(benchmark::kMicrosecond);
+
+/// Args: number of voids; flat open-addressing table with `EdgeBitsHash` (`kFlatEdgeHashMap`)
+static void BM_EdgeLookupFlatHashMap(benchmark::State& state) {
+    run_edge_lookup<TriangleMesh::FlatEdgeMap>(state);
+}
+BENCHMARK(BM_EdgeLookupFlatHashMap)->Arg(8)->Arg(64)->Arg(256)->Unit(benchmark::kMicrosecond);
+
+/// Loads a mapped binary STL of nested spheres into a `Mesh` (double or float coordinates)
+template <typename Mesh>
+static void run_mesh_from_mapped_file(benchmark::State& state, const char* file_name) {
+    const std::vector<Triangle> triangles{nested_spheres(state.range(1))};
+    const std::filesystem::path path{std::filesystem::temp_directory_path() / file_name};
+    {
+        std::ofstream out(path, std::ios::binary);
+        write_binary_stl(out, "nested_spheres", triangles);
+    }
+    const TriangleMeshOptions options{static_cast<ConnectivityEngine>(state.range(0))};
+    for (auto _ : state) {
+        Mesh mesh{Mesh::FromMappedFile(path.string(), options)};
+        benchmark::DoNotOptimize(mesh);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(triangles.size()));
+    state.counters["triangle_bytes"] = static_cast<double>(
+        triangles.size() * sizeof(typename Mesh::TriangleType)
+    );
+    std::filesystem::remove(path);
+}
+
+/// Args: connectivity engine, number of voids
+static void BM_TriangleMeshFromMappedFile(benchmark::State& state) {
+    run_mesh_from_mapped_file<TriangleMesh>(state, "tsexam_bench_nested_spheres.stl");
+}
+BENCHMARK(BM_TriangleMeshFromMappedFile)
+    ->ArgsProduct({{0, 2}, {64, 256}})
+    ->Unit(benchmark::kMillisecond);
+
+/// Args: connectivity engine, number of voids; float coordinates, same connectivity
+static void BM_TriangleMeshFFromMappedFile(benchmark::State& state) {
+    run_mesh_from_mapped_file<TriangleMeshF>(state, "tsexam_bench_nested_spheres_f.stl");
+}
+BENCHMARK(BM_TriangleMeshFFromMappedFile)
+    ->ArgsProduct({{0, 2}, {64, 256}})
+    ->Unit(benchmark::kMillisecond);
+
+/// Args: number of voids; every iteration after the first one is a cache hit
+static void BM_LoadMeshWithCache(benchmark::State& state) {
+    const std::vector<Triangle> triangles{nested_spheres(state.range(0))};
+    const std::filesystem::path path{
+        std::filesystem::temp_directory_path() / "tsexam_bench_cached_spheres.stl"
+    };
+    {
+        std::ofstream out(path, std::ios::binary);
+        write_binary_stl(out, "nested_spheres", triangles);
+    }
+    const std::string cache_path{path.string() + ".tscache"};
+    std::filesystem::remove(cache_path);
+    benchmark::DoNotOptimize(load_mesh_with_cache(path.string(), {}, cache_path));
+    for (auto _ : state) {
+        TriangleMesh mesh{load_mesh_with_cache(path.string(), {}, cache_path)};
+        benchmark::DoNotOptimize(mesh);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(triangles.size()));
+    std::filesystem::remove(path);
+    std::filesystem::remove(cache_path);
+}
+BENCHMARK(BM_LoadMeshWithCache)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+
+/// Args: number of voids; one triangle at a time, as the constructor used to validate
+static void BM_ValidateTrianglesScalar(benchmark::State& state) {
+    const std::vector<Triangle> triangles{nested_spheres(state.range(0))};
+    for (auto _ : state) {
+        std::size_t num_degenerate{0};
+        for (const Triangle& triangle : triangles) {
+            num_degenerate += (classify_triangle(triangle) != TriangleDefect::kNone) ? 1u : 0u;
+        }
+        benchmark::DoNotOptimize(num_degenerate);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(triangles.size()));
+}
+BENCHMARK(BM_ValidateTrianglesScalar)->Arg(256)->Unit(benchmark::kMillisecond);
+
+/// Args: number of voids, number of threads
+static void BM_ValidateTriangles(benchmark::State& state) {
+    const std::vector<Triangle> triangles{nested_spheres(state.range(0))};
+    const auto num_threads{static_cast<std::size_t>(state.range(1))};
+    state.SetLabel(triangle_validation_kernel());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(find_first_degenerate_triangle(triangles, num_threads));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(triangles.size()));
+}
+BENCHMARK(BM_ValidateTriangles)
+    ->Args({256, 1})
+    ->Args({256, 4})
+    ->Unit(benchmark::kMillisecond);
+
+//---------------------------------------------------------------------------
+// Connected components
+//---------------------------------------------------------------------------
+
+/// Args: number of lattice shells
+static void BM_FindConnectedComponents(benchmark::State& state) {
+    const TriangleMesh mesh(make_shell_lattice(static_cast<std::size_t>(state.range(0)), 2));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(find_connected_components(mesh));
+    }
+    state.SetItemsProcessed(
+        state.iterations() * static_cast<std::int64_t>(mesh.GetTriangles().size())
+    );
+}
+BENCHMARK(BM_FindConnectedComponents)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+/// Args: number of lattice shells, number of threads
+static void BM_FindConnectedComponentsParallel(benchmark::State& state) {
+    const TriangleMesh mesh(make_shell_lattice(static_cast<std::size_t>(state.range(0)), 2));
+    const auto num_threads{static_cast<std::size_t>(state.range(1))};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(find_connected_components(mesh, num_threads));
+    }
+    state.SetItemsProcessed(
+        state.iterations() * static_cast<std::int64_t>(mesh.GetTriangles().size())
+    );
+}
+BENCHMARK(BM_FindConnectedComponentsParallel)
+    ->ArgsProduct({{1000, 10000}, {1, 4}})
+    ->Unit(benchmark::kMillisecond);
+
+/// Args: number of lattice shells, memory resource (0: default, 1: monotonic arena per search)
+static void BM_FindComponentSet(benchmark::State& state) {
+    const TriangleMesh mesh(make_shell_lattice(static_cast<std::size_t>(state.range(0)), 2));
+    const bool use_arena{state.range(1) != 0};
+    for (auto _ : state) {
+        std::pmr::monotonic_buffer_resource arena;
+        const ComponentSet components{find_component_set(
+            mesh, use_arena ? &arena : std::pmr::get_default_resource()
+        )};
+        benchmark::DoNotOptimize(components.GetTriangles().data());
+    }
+    state.SetItemsProcessed(
+        state.iterations() * static_cast<std::int64_t>(mesh.GetTriangles().size())
+    );
+}
+BENCHMARK(BM_FindComponentSet)
+    ->ArgsProduct({{1000, 10000}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+/// Args: number of voids
+static void BM_IsConnectedComponentClosed(benchmark::State& state) {
+    const TriangleMesh mesh(nested_spheres(state.range(0)));
+    const std::vector<ConnectedComponent> components{find_connected_components(mesh)};
+    for (auto _ : state) {
+        std::size_t num_closed{0};
+        for (const ConnectedComponent& component : components) {
+            num_closed += is_connected_component_closed(mesh, component) ? 1u : 0u;
+        }
+        benchmark::DoNotOptimize(num_closed);
+    }
+    state.SetItemsProcessed(
+        state.iterations() * static_cast<std::int64_t>(mesh.GetTriangles().size())
+    );
+}
+BENCHMARK(BM_IsConnectedComponentClosed)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+
+/// One repair edit (remove a triangle, put it back) with incremental connectivity and labels
+/// Args: number of voids
+static void BM_MeshEditorRemoveInsert(benchmark::State& state) {
+    TriangleMesh mesh(nested_spheres(state.range(0)));
+    MeshEditor editor(mesh);
+    std::size_t index{0};
+    for (auto _ : state) {
+        index = (index + 7919) % mesh.GetTriangles().size();
+        const Triangle triangle{mesh.GetTriangles()[index]};
+        editor.RemoveTriangle(index);
+        editor.InsertTriangle(triangle);
+        benchmark::DoNotOptimize(editor.GetComponentCount());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MeshEditorRemoveInsert)->Arg(8)->Arg(64)->Arg(256)->Unit(benchmark::kMicrosecond);
+
+/// The same edit followed by a full rebuild of the mesh and its components
+/// Args: number of voids
+static void BM_RebuildAfterEdit(benchmark::State& state) {
+    std::vector<Triangle> triangles{nested_spheres(state.range(0))};
+    std::size_t index{0};
+    for (auto _ : state) {
+        index = (index + 7919) % triangles.size();
+        std::swap(triangles[index], triangles.back());
+        const TriangleMesh mesh(triangles);
+        benchmark::DoNotOptimize(find_connected_components(mesh).size());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RebuildAfterEdit)->Arg(8)->Arg(64)->Unit(benchmark::kMicrosecond);
+
+//---------------------------------------------------------------------------
+// Bounding boxes
+//---------------------------------------------------------------------------
+
+static void BM_AxisAlignedBoundingBoxFromPoints(benchmark::State& state) {
+    const tsexam::problem1::Point a{0.5, -1., 2.};
+    const tsexam::problem1::Point b{-0.25, 3., 1.};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(AxisAlignedBoundingBox(a, b));
+    }
+}
+BENCHMARK(BM_AxisAlignedBoundingBoxFromPoints);
+
+static void BM_AabbContains(benchmark::State& state) {
+    const AxisAlignedBoundingBox outer(-1., -1., -1., 1., 1., 1.);
+    const AxisAlignedBoundingBox inner(-0.5, -0.5, -0.5, 0.5, 0.5, 0.5);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(aabb_contains(outer, inner));
+    }
+}
+BENCHMARK(BM_AabbContains);
+
+/// Args: number of voids
+static void BM_ComputeComponentAabb(benchmark::State& state) {
+    const TriangleMesh mesh(nested_spheres(state.range(0)));
+    const std::vector<ConnectedComponent> components{find_connected_components(mesh)};
+    for (auto _ : state) {
+        for (const ConnectedComponent& component : components) {
+            benchmark::DoNotOptimize(compute_component_aabb(mesh, component));
+        }
+    }
+    state.SetItemsProcessed(
+        state.iterations() * static_cast<std::int64_t>(mesh.GetTriangles().size())
+    );
+}
+BENCHMARK(BM_ComputeComponentAabb)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+
+/// Args: number of lattice shells
+static void BM_AabbContainmentIndexBuild(benchmark::State& state) {
+    const TriangleMesh mesh(make_shell_lattice(static_cast<std::size_t>(state.range(0)), 1));
+    const std::vector<AxisAlignedBoundingBox> boxes{component_boxes(mesh)};
+    for (auto _ : state) {
+        AabbContainmentIndex index(boxes);
+        benchmark::DoNotOptimize(index);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(boxes.size()));
+}
+BENCHMARK(BM_AabbContainmentIndexBuild)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+/// Args: number of lattice shells
+static void BM_AabbContainmentIndexHasContainer(benchmark::State& state) {
+    const TriangleMesh mesh(make_shell_lattice(static_cast<std::size_t>(state.range(0)), 1));
+    const AabbContainmentIndex index(component_boxes(mesh));
+    for (auto _ : state) {
+        std::size_t num_contained{0};
+        for (std::size_t i = 0; i < index.GetBoxes().size(); ++i) {
+            num_contained += index.HasContainer(i) ? 1u : 0u;
+        }
+        benchmark::DoNotOptimize(num_contained);
+    }
+    state.SetItemsProcessed(
+        state.iterations() * static_cast<std::int64_t>(index.GetBoxes().size())
+    );
+}
+BENCHMARK(BM_AabbContainmentIndexHasContainer)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMicrosecond);
+
+/// Args: number of lattice shells
+static void BM_AabbContainmentIndexFindContainers(benchmark::State& state) {
+    const TriangleMesh mesh(make_shell_lattice(static_cast<std::size_t>(state.range(0)), 1));
+    const AabbContainmentIndex index(component_boxes(mesh));
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < index.GetBoxes().size(); ++i) {
+            benchmark::DoNotOptimize(index.FindContainers(i));
+        }
+    }
+    state.SetItemsProcessed(
+        state.iterations() * static_cast<std::int64_t>(index.GetBoxes().size())
+    );
+}
+BENCHMARK(BM_AabbContainmentIndexFindContainers)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMicrosecond);
+
+//---------------------------------------------------------------------------
+// Voids
+//---------------------------------------------------------------------------
+
+/// Args: classification, number of voids
+static void BM_IdentifyVoidsNestedSpheres(benchmark::State& state) {
+    const TriangleMesh mesh(nested_spheres(state.range(1)));
+    const std::vector<ConnectedComponent> closed{closed_components(mesh)};
+    const auto classification{static_cast<VoidClassification>(state.range(0))};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(identify_voids(mesh, closed, classification));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(closed.size()));
+}
+BENCHMARK(BM_IdentifyVoidsNestedSpheres)
+    ->ArgsProduct({{0, 1}, {8, 64, 256}})
+    ->Unit(benchmark::kMillisecond);
+
+/// Args: classification, number of lattice shells
+static void BM_IdentifyVoidsShellLattice(benchmark::State& state) {
+    const TriangleMesh mesh(make_shell_lattice(static_cast<std::size_t>(state.range(1)), 1));
+    const std::vector<ConnectedComponent> closed{closed_components(mesh)};
+    const auto classification{static_cast<VoidClassification>(state.range(0))};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(identify_voids(mesh, closed, classification));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(closed.size()));
+}
+BENCHMARK(BM_IdentifyVoidsShellLattice)
+    ->ArgsProduct({{0, 1}, {1000, 10000}})
+    ->Unit(benchmark::kMillisecond);
+
+/// Args: output format, number of voids
+static void BM_ExportVoidsToStl(benchmark::State& state) {
+    const TriangleMesh mesh(nested_spheres(state.range(1)));
+    const auto format{static_cast<StlFormat>(state.range(0))};
+    std::size_t bytes_per_export{0};
+    for (auto _ : state) {
+        NullStream out;
+        export_voids_to_stl(mesh, out, format);
+        bytes_per_export = out.BytesWritten();
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(bytes_per_export));
+}
+BENCHMARK(BM_ExportVoidsToStl)
+    ->ArgsProduct({{static_cast<std::int64_t>(StlFormat::kAscii),
+                    static_cast<std::int64_t>(StlFormat::kBinary)},
+                   {64, 256}})
+    ->Unit(benchmark::kMillisecond);
+
+/// Args: memory resource (0: default, 1: monotonic arena per job), number of voids; one whole
+/// job: mesh build, component set and binary void export
+static void BM_VoidExportJob(benchmark::State& state) {
+    const std::vector<Triangle> triangles{nested_spheres(state.range(1))};
+    const bool use_arena{state.range(0) != 0};
+    for (auto _ : state) {
+        std::pmr::monotonic_buffer_resource arena;
+        std::pmr::memory_resource* resource{
+            use_arena ? &arena : std::pmr::get_default_resource()
+        };
+        TriangleMeshOptions options;
+        options.memory_resource = resource;
+        const TriangleMesh mesh(triangles, options);
+        NullStream out;
+        export_voids_to_stl(mesh, find_component_set(mesh, resource), out, StlFormat::kBinary);
+        benchmark::DoNotOptimize(out.BytesWritten());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(triangles.size()));
+}
+BENCHMARK(BM_VoidExportJob)->ArgsProduct({{0, 1}, {64, 256}})->Unit(benchmark::kMillisecond);
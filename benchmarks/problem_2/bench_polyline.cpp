@@ -0,0 +1,436 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "generators.hpp"
+#include "problem_2/encoded_polyline.hpp"
+#include "problem_2/polyline.hpp"
+#include "problem_2/polyline_builder.hpp"
+#include "problem_2/polyline_geometry.hpp"
+#include "problem_2/polyline_set.hpp"
+#include "problem_2/polyline_view.hpp"
+#include "problem_2/segment_soup.hpp"
+
+using tsexam::benchmarks::make_random_polyline;
+using tsexam::benchmarks::make_random_polyline_batch;
+using tsexam::benchmarks::SyntheticPolyline;
+using tsexam::benchmarks::SyntheticPolylineBatch;
+using tsexam::problem2::EncodedPolyline;
+using tsexam::problem2::Point;
+using tsexam::problem2::Polyline;
+using tsexam::problem2::PolylineBuilder;
+using tsexam::problem2::PolylineRepresentation;
+using tsexam::problem2::PolylineSet;
+using tsexam::problem2::PolylineView;
+using tsexam::problem2::simplify_douglas_peucker;
+using tsexam::problem2::split_segment_soup;
+using tsexam::problem2::TraversalVertices;
+using tsexam::problem2::VertexIndex;
+
+//---------------------------------------------------------------------------
+// Construction
+//---------------------------------------------------------------------------
+
+/// Args: number of segments, closed (0/1)
+static void BM_PolylineFromVerboseSegments(benchmark::State& state) {
+    const SyntheticPolyline input{
+        make_random_polyline(static_cast<std::size_t>(state.range(0)), state.range(1) != 0, 7)
+    };
+    for (auto _ : state) {
+        Polyline polyline(PolylineRepresentation::kVerboseSegments, input.segments);
+        benchmark::DoNotOptimize(polyline);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PolylineFromVerboseSegments)
+    ->ArgsProduct({benchmark::CreateRange(1 << 12, 1 << 22, 16), {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+/// Args: number of segments
+static void BM_PolylineFromVerboseSegmentsWithVertices(benchmark::State& state) {
+    const SyntheticPolyline input{
+        make_random_polyline(static_cast<std::size_t>(state.range(0)), false, 7)
+    };
+    for (auto _ : state) {
+        Polyline polyline(PolylineRepresentation::kVerboseSegments, input.segments, input.vertices);
+        benchmark::DoNotOptimize(polyline);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PolylineFromVerboseSegmentsWithVertices)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 22)
+    ->Unit(benchmark::kMillisecond);
+
+/// Args: number of segments
+static void BM_PolylineFromCompressedOrdering(benchmark::State& state) {
+    const SyntheticPolyline input{
+        make_random_polyline(static_cast<std::size_t>(state.range(0)), true, 7)
+    };
+    const Polyline reference(PolylineRepresentation::kVerboseSegments, input.segments);
+    const std::vector<VertexIndex>& ordering{reference.GetCompressedSegments()};
+    for (auto _ : state) {
+        Polyline polyline(PolylineRepresentation::kCompressedVertexOrdering, ordering);
+        benchmark::DoNotOptimize(polyline);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PolylineFromCompressedOrdering)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 22)
+    ->Unit(benchmark::kMillisecond);
+
+/// Same ordering viewed in place: validation only, no copy
+/// Args: number of segments
+static void BM_PolylineViewFromCompressedOrdering(benchmark::State& state) {
+    const SyntheticPolyline input{
+        make_random_polyline(static_cast<std::size_t>(state.range(0)), true, 7)
+    };
+    const Polyline reference(PolylineRepresentation::kVerboseSegments, input.segments);
+    const std::vector<VertexIndex>& ordering{reference.GetCompressedSegments()};
+    for (auto _ : state) {
+        PolylineView view(ordering);
+        benchmark::DoNotOptimize(view);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PolylineViewFromCompressedOrdering)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 22)
+    ->Unit(benchmark::kMillisecond);
+
+/// Polyline with global vertex ids spread over the whole 31-bit range (compacted to dense ranks)
+/// Args: number of segments
+static void BM_PolylineFromSparseGlobalIds(benchmark::State& state) {
+    const auto num_segments{static_cast<std::size_t>(state.range(0))};
+    const SyntheticPolyline polyline{make_random_polyline(num_segments, false, 42)};
+    const auto stride{static_cast<VertexIndex>((std::size_t{1} << 31) / (num_segments + 2))};
+    std::vector<VertexIndex> segments;
+    for (const VertexIndex vertex : polyline.segments) {
+        segments.push_back(vertex * stride + 1);
+    }
+    for (auto _ : state) {
+        Polyline p(PolylineRepresentation::kVerboseSegments, segments);
+        benchmark::DoNotOptimize(p);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PolylineFromSparseGlobalIds)
+    ->RangeMultiplier(32)
+    ->Range(4, 1 << 22)
+    ->Unit(benchmark::kMicrosecond);
+
+/// Same segments streamed into a reused builder one at a time (shuffled: many chain joins)
+/// Args: number of segments, closed (0/1)
+static void BM_PolylineBuilderFromSegments(benchmark::State& state) {
+    const SyntheticPolyline input{
+        make_random_polyline(static_cast<std::size_t>(state.range(0)), state.range(1) != 0, 7)
+    };
+    PolylineBuilder builder;
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < input.segments.size(); i += 2) {
+            builder.AddSegment(input.segments[i], input.segments[i + 1]);
+        }
+        Polyline polyline{builder.Build()};
+        benchmark::DoNotOptimize(polyline);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PolylineBuilderFromSegments)
+    ->ArgsProduct({benchmark::CreateRange(1 << 12, 1 << 22, 16), {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+/// Segments streamed in traversal order, as a contour tracer emits them: every segment extends
+/// the single chain
+/// Args: number of segments
+static void BM_PolylineBuilderFromTracedSegments(benchmark::State& state) {
+    const SyntheticPolyline input{
+        make_random_polyline(static_cast<std::size_t>(state.range(0)), false, 7)
+    };
+    const Polyline reference(PolylineRepresentation::kVerboseSegments, input.segments);
+    const std::vector<VertexIndex>& ordering{reference.GetCompressedSegments()};
+    PolylineBuilder builder;
+    for (auto _ : state) {
+        for (std::size_t i = 0; i + 1 < ordering.size(); ++i) {
+            builder.AddSegment(ordering[i], ordering[i + 1]);
+        }
+        Polyline polyline{builder.Build()};
+        benchmark::DoNotOptimize(polyline);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PolylineBuilderFromTracedSegments)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 22)
+    ->Unit(benchmark::kMillisecond);
+
+/// One `Polyline` per contour, each owning its vertices and ordering
+/// Args: number of polylines (32 segments each)
+static void BM_PolylinesFromVerboseSegments(benchmark::State& state) {
+    const SyntheticPolylineBatch batch{
+        make_random_polyline_batch(static_cast<std::size_t>(state.range(0)), 32, 7)
+    };
+    for (auto _ : state) {
+        std::vector<Polyline> polylines;
+        polylines.reserve(batch.offsets.size() - 1);
+        for (std::size_t k = 0; k + 1 < batch.offsets.size(); ++k) {
+            const auto begin{batch.data.begin() + static_cast<std::ptrdiff_t>(batch.offsets[k])};
+            const auto end{batch.data.begin() + static_cast<std::ptrdiff_t>(batch.offsets[k + 1])};
+            polylines.emplace_back(
+                PolylineRepresentation::kVerboseSegments, std::vector<VertexIndex>(begin, end)
+            );
+        }
+        benchmark::DoNotOptimize(polylines);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PolylinesFromVerboseSegments)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 20)
+    ->Unit(benchmark::kMillisecond);
+
+/// The same contours in one `PolylineSet`
+/// Args: number of polylines (32 segments each), number of threads
+static void BM_PolylineSetFromVerboseSegments(benchmark::State& state) {
+    const SyntheticPolylineBatch batch{
+        make_random_polyline_batch(static_cast<std::size_t>(state.range(0)), 32, 7)
+    };
+    for (auto _ : state) {
+        PolylineSet set(
+            PolylineRepresentation::kVerboseSegments, batch.data, batch.offsets, {},
+            static_cast<std::size_t>(state.range(1))
+        );
+        benchmark::DoNotOptimize(set);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PolylineSetFromVerboseSegments)
+    ->ArgsProduct({benchmark::CreateRange(1 << 12, 1 << 20, 16), {1, 0}})
+    ->Unit(benchmark::kMillisecond);
+
+/// Segment soup of many contours split into chains and loops
+/// Args: number of contours (32 segments each), number of threads (1: walk; more: list ranking)
+static void BM_SplitSegmentSoupContours(benchmark::State& state) {
+    const SyntheticPolylineBatch batch{
+        make_random_polyline_batch(static_cast<std::size_t>(state.range(0)), 32, 7)
+    };
+    for (auto _ : state) {
+        PolylineSet set{
+            split_segment_soup(batch.data, {}, static_cast<std::size_t>(state.range(1)))
+        };
+        benchmark::DoNotOptimize(set);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch.data.size() / 2));
+}
+BENCHMARK(BM_SplitSegmentSoupContours)
+    ->ArgsProduct({{1 << 12, 1 << 16}, {1, 4}})
+    ->Unit(benchmark::kMillisecond);
+
+/// One long chain as a segment soup: the walk is a single dependent pointer chase
+/// Args: number of segments, number of threads (1: walk; more: list ranking)
+static void BM_SplitSegmentSoupLongChain(benchmark::State& state) {
+    const SyntheticPolyline polyline{
+        make_random_polyline(static_cast<std::size_t>(state.range(0)), false, 42)
+    };
+    for (auto _ : state) {
+        PolylineSet set{
+            split_segment_soup(polyline.segments, {}, static_cast<std::size_t>(state.range(1)))
+        };
+        benchmark::DoNotOptimize(set);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SplitSegmentSoupLongChain)
+    ->ArgsProduct({{1 << 16, 1 << 22}, {1, 4}})
+    ->Unit(benchmark::kMillisecond);
+
+//---------------------------------------------------------------------------
+// Compression and classification
+//---------------------------------------------------------------------------
+
+/// Args: number of segments, closed (0/1)
+static void BM_GetCompressedVertexOrdering(benchmark::State& state) {
+    const SyntheticPolyline input{
+        make_random_polyline(static_cast<std::size_t>(state.range(0)), state.range(1) != 0, 7)
+    };
+    const std::span<const VertexIndex> segments{input.segments};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            Polyline::GetCompressedVertexOrdering(segments, input.vertices.size())
+        );
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GetCompressedVertexOrdering)
+    ->ArgsProduct({benchmark::CreateRange(1 << 12, 1 << 22, 16), {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_PolylineIsPolygonAndGetType(benchmark::State& state) {
+    const SyntheticPolyline input{make_random_polyline(1 << 12, true, 7)};
+    const Polyline polyline(PolylineRepresentation::kVerboseSegments, input.segments);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(polyline.IsPolygon());
+        benchmark::DoNotOptimize(polyline.GetType());
+    }
+}
+BENCHMARK(BM_PolylineIsPolygonAndGetType);
+
+//---------------------------------------------------------------------------
+// Encoded storage
+//---------------------------------------------------------------------------
+
+/// Compressed ordering of a closed polyline: scan-line (consecutive ids) or random ids
+static std::vector<VertexIndex> make_ordering(std::size_t num_segments, bool scan_line) {
+    if (scan_line) {
+        std::vector<VertexIndex> ordering(num_segments);
+        std::iota(ordering.begin(), ordering.end(), VertexIndex{0});
+        ordering.push_back(0);
+        return ordering;
+    }
+    const SyntheticPolyline input{make_random_polyline(num_segments, true, 7)};
+    return Polyline(PolylineRepresentation::kVerboseSegments, input.segments)
+        .GetCompressedSegments();
+}
+
+/// Args: number of segments, scan-line ids (0/1)
+static void BM_EncodedPolylineEncode(benchmark::State& state) {
+    const std::vector<VertexIndex> ordering{
+        make_ordering(static_cast<std::size_t>(state.range(0)), state.range(1) != 0)
+    };
+    std::size_t num_bytes{0};
+    for (auto _ : state) {
+        EncodedPolyline encoded{PolylineView(ordering)};
+        num_bytes = encoded.GetEncodedBytes().size();
+        benchmark::DoNotOptimize(encoded);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes_per_index"] =
+        static_cast<double>(num_bytes) / static_cast<double>(ordering.size());
+}
+BENCHMARK(BM_EncodedPolylineEncode)
+    ->ArgsProduct({{1 << 16, 1 << 22}, {1, 0}})
+    ->Unit(benchmark::kMillisecond);
+
+/// Args: number of segments, scan-line ids (0/1)
+static void BM_EncodedPolylineDecode(benchmark::State& state) {
+    const std::vector<VertexIndex> ordering{
+        make_ordering(static_cast<std::size_t>(state.range(0)), state.range(1) != 0)
+    };
+    const EncodedPolyline encoded{PolylineView(ordering)};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(encoded.Decode());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EncodedPolylineDecode)
+    ->ArgsProduct({{1 << 16, 1 << 22}, {1, 0}})
+    ->Unit(benchmark::kMillisecond);
+
+/// Streaming the indices through the iterator without materializing them
+/// Args: number of segments, scan-line ids (0/1)
+static void BM_EncodedPolylineIterate(benchmark::State& state) {
+    const std::vector<VertexIndex> ordering{
+        make_ordering(static_cast<std::size_t>(state.range(0)), state.range(1) != 0)
+    };
+    const EncodedPolyline encoded{PolylineView(ordering)};
+    for (auto _ : state) {
+        std::int64_t sum{0};
+        for (const VertexIndex vertex : encoded) {
+            sum += vertex;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EncodedPolylineIterate)
+    ->ArgsProduct({{1 << 16, 1 << 22}, {1, 0}})
+    ->Unit(benchmark::kMillisecond);
+
+//---------------------------------------------------------------------------
+// Geometry
+//---------------------------------------------------------------------------
+
+/// Random walk polygon; the ordering visits the vertex array in order or in shuffled order
+struct WalkPolygon {
+    std::vector<Point> vertices;
+    std::vector<VertexIndex> ordering;
+};
+
+static WalkPolygon make_walk_polygon(std::size_t num_segments, bool shuffled) {
+    std::mt19937_64 generator{7};
+    std::normal_distribution<double> step{0., 1.};
+    WalkPolygon polygon;
+    polygon.vertices.resize(num_segments);
+    for (std::size_t i = 1; i < num_segments; ++i) {
+        for (std::size_t axis = 0; axis < 2; ++axis) {
+            polygon.vertices[i][axis] = polygon.vertices[i - 1][axis] + step(generator);
+        }
+    }
+    polygon.ordering.resize(num_segments);
+    std::iota(polygon.ordering.begin(), polygon.ordering.end(), VertexIndex{0});
+    if (shuffled) {
+        std::shuffle(polygon.ordering.begin(), polygon.ordering.end(), generator);
+    }
+    polygon.ordering.push_back(polygon.ordering.front());
+    return polygon;
+}
+
+/// Length, bounds and moments gathered through the ordering
+/// Args: number of segments, shuffled ordering (0/1)
+static void BM_PolylineGeometryGathered(benchmark::State& state) {
+    const WalkPolygon input{
+        make_walk_polygon(static_cast<std::size_t>(state.range(0)), state.range(1) != 0)
+    };
+    const PolylineView polygon(input.ordering, input.vertices);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(polyline_length(polygon));
+        benchmark::DoNotOptimize(polyline_bounds(polygon));
+        benchmark::DoNotOptimize(polygon_properties(polygon));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PolylineGeometryGathered)
+    ->ArgsProduct({{1 << 12, 1 << 20}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+/// The same kernels streaming the vertices reordered once into `TraversalVertices`
+/// Args: number of segments, shuffled ordering (0/1)
+static void BM_PolylineGeometryTraversalOrder(benchmark::State& state) {
+    const WalkPolygon input{
+        make_walk_polygon(static_cast<std::size_t>(state.range(0)), state.range(1) != 0)
+    };
+    const TraversalVertices points{PolylineView(input.ordering, input.vertices)};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(polyline_length(points));
+        benchmark::DoNotOptimize(polyline_bounds(points));
+        benchmark::DoNotOptimize(polygon_properties(points));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PolylineGeometryTraversalOrder)
+    ->ArgsProduct({{1 << 12, 1 << 20}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+/// Args: number of segments, number of threads
+static void BM_SimplifyDouglasPeucker(benchmark::State& state) {
+    const WalkPolygon input{make_walk_polygon(static_cast<std::size_t>(state.range(0)), false)};
+    const PolylineView polygon(input.ordering, input.vertices);
+    const auto num_threads{static_cast<std::size_t>(state.range(1))};
+    std::size_t num_kept{0};
+    for (auto _ : state) {
+        const std::vector<VertexIndex> kept{simplify_douglas_peucker(polygon, 2., num_threads)};
+        num_kept = kept.size();
+        benchmark::DoNotOptimize(kept.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["kept"] = static_cast<double>(num_kept);
+}
+BENCHMARK(BM_SimplifyDouglasPeucker)
+    ->ArgsProduct({{1 << 16, 1 << 20}, {1, 4}})
+    ->Unit(benchmark::kMillisecond);
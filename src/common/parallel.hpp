@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tsexam::common {
+
+/**
+ * @brief Resolves a requested thread count
+ *
+ * @param requested Requested number of threads; 0 means one thread per hardware core
+ * @return Number of threads to use (at least 1)
+ */
+inline std::size_t resolve_thread_count(std::size_t requested) {
+    if (requested != 0) {
+        return requested;
+    }
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Runs `task(i)` for every i in [0, num_tasks) on up to `num_threads` threads
+ *
+ * Tasks are handed out dynamically, so uneven task sizes balance across threads. The calling thread
+ * takes part in the work. If a task throws, the remaining tasks are skipped and the first exception
+ * is rethrown on the calling thread once all threads have finished.
+ *
+ * @param num_tasks Number of tasks
+ * @param num_threads Maximum number of threads (0: one per hardware core)
+ * @param task Callable invoked with the task index
+ */
+template <typename Task>
+void parallel_for(std::size_t num_tasks, std::size_t num_threads, const Task& task) {
+    const std::size_t thread_count{std::min(resolve_thread_count(num_threads), num_tasks)};
+
+    // Nothing to share -> run inline without spawning threads
+    if (thread_count <= 1) {
+        for (std::size_t i = 0; i < num_tasks; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next_task{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr first_exception{nullptr};
+    std::mutex exception_mutex;
+
+    // Lambda: pull task indices until none are left or a task failed
+    auto worker = [&]() {
+        while (!failed.load(std::memory_order_relaxed)) {
+            const std::size_t i{next_task.fetch_add(1, std::memory_order_relaxed)};
+            if (i >= num_tasks) {
+                return;
+            }
+            try {
+                task(i);
+            } catch (...) {
+                const std::lock_guard<std::mutex> lock(exception_mutex);
+                if (!first_exception) {
+                    first_exception = std::current_exception();
+                }
+                failed.store(true, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+    for (std::size_t t = 1; t < thread_count; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    if (first_exception) {
+        std::rethrow_exception(first_exception);
+    }
+}
+
+}  // namespace tsexam::common
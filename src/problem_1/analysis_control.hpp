@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <utility>
+
+namespace tsexam::problem1 {
+
+/**
+ * @brief Stage of the mesh pipeline, as reported to a progress callback
+ *
+ * The stages follow the `PipelineStats` timings; `kReorientation` is the BFS of
+ * `reorient_inconsistent_triangles`.
+ */
+enum class AnalysisStage {
+    kParse,          ///< STL parsing; counts bytes of the input
+    kValidation,     ///< degenerate triangle checks; counts triangles
+    kWelding,        ///< vertex welding (indexed engines); counts triangles
+    kConnectivity,   ///< edge-to-triangle connectivity; counts triangles
+    kNeighborTable,  ///< triangle neighbor table; counts triangles
+    kComponents,     ///< components + closed check; counts visited triangles
+    kReorientation,  ///< reorientation BFS; counts visited triangles of the mesh
+    kVoids,          ///< void identification; counts closed components
+    kExport,         ///< writing the output triangles; counts triangles
+};
+
+/**
+ * @brief Returns the name of a stage
+ *
+ * @param stage Pipeline stage
+ * @return Lower-case name, e.g. "connectivity"
+ */
+inline const char* stage_name(AnalysisStage stage) {
+    switch (stage) {
+        case AnalysisStage::kParse:
+            return "parse";
+        case AnalysisStage::kValidation:
+            return "validation";
+        case AnalysisStage::kWelding:
+            return "welding";
+        case AnalysisStage::kConnectivity:
+            return "connectivity";
+        case AnalysisStage::kNeighborTable:
+            return "neighbor table";
+        case AnalysisStage::kComponents:
+            return "components";
+        case AnalysisStage::kReorientation:
+            return "reorientation";
+        case AnalysisStage::kVoids:
+            return "voids";
+        case AnalysisStage::kExport:
+            return "export";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Progress of one stage
+ *
+ * A stage reports `completed == 0` when it starts and `completed == total` when it ends; void
+ * identification of fewer than two closed components only reports the end. The reorientation BFS
+ * only visits the seed's component, so it jumps to `total` when it ends.
+ */
+struct AnalysisProgress {
+    AnalysisStage stage;    ///< stage running
+    std::size_t completed;  ///< work items done so far
+    std::size_t total;      ///< work items of the stage
+};
+
+/// Callback receiving the progress of the pipeline stages
+using ProgressCallback = std::function<void(const AnalysisProgress&)>;
+
+/**
+ * @brief Thrown by a pipeline stage that observed a stop request
+ */
+class AnalysisCancelled : public std::runtime_error {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param stage Stage that was interrupted
+     */
+    explicit AnalysisCancelled(AnalysisStage stage)
+        : std::runtime_error(std::string{"analysis cancelled during "} + stage_name(stage)),
+          stage_{stage} {}
+
+    /**
+     * @brief Returns the stage that was interrupted
+     *
+     * @return Pipeline stage
+     */
+    AnalysisStage GetStage() const { return stage_; }
+
+private:
+    /// Stage that was interrupted
+    AnalysisStage stage_;
+};
+
+/**
+ * @brief Stop token and progress callback checked by the pipeline stages
+ *
+ * Pass a pointer through `TriangleMeshOptions::control`, `MeshAnalysis`, `identify_void_indices`
+ * and the other stages that take one, like a `PipelineStats` sink. Every stage calls `Checkpoint`
+ * when it starts, every `kCheckpointInterval` work items of its loops (including the BFS loops)
+ * and when it ends. A null pointer (the default) costs one branch per loop iteration.
+ *
+ * The callback runs on the thread of the stage, between two work items, so it must be cheap and
+ * thread-safe with respect to the caller. It may itself request the stop.
+ */
+class AnalysisControl {
+public:
+    /// A control that never stops and reports nowhere
+    AnalysisControl() = default;
+
+    /**
+     * @brief Constructor
+     *
+     * @param stop_token Token whose stop request interrupts the stages
+     * @param on_progress Callback receiving the progress (may be empty)
+     */
+    explicit AnalysisControl(std::stop_token stop_token, ProgressCallback on_progress = {})
+        : stop_token_{std::move(stop_token)}, on_progress_{std::move(on_progress)} {}
+
+    /**
+     * @brief Returns whether a stop was requested
+     *
+     * @return true once the stop source of the token requested a stop
+     */
+    bool IsStopRequested() const { return stop_token_.stop_requested(); }
+
+    /**
+     * @brief Reports the progress of a stage, then checks for a stop request
+     *
+     * @param stage Stage running
+     * @param completed Work items done so far
+     * @param total Work items of the stage
+     *
+     * @throws AnalysisCancelled if a stop was requested
+     */
+    void Checkpoint(AnalysisStage stage, std::size_t completed, std::size_t total) const {
+        if (this->on_progress_) {
+            this->on_progress_(AnalysisProgress{stage, completed, total});
+        }
+        if (this->stop_token_.stop_requested()) {
+            throw AnalysisCancelled(stage);
+        }
+    }
+
+private:
+    /// Token whose stop request interrupts the stages
+    std::stop_token stop_token_{};
+
+    /// Progress callback (may be empty)
+    ProgressCallback on_progress_{};
+};
+
+/// Work items between two checkpoints of a stage loop
+constexpr std::size_t kCheckpointInterval{4096};
+
+/**
+ * @brief Checkpoint of a stage loop: calls `AnalysisControl::Checkpoint` at the start, every
+ * `kCheckpointInterval` items and at the end of the stage
+ *
+ * @param control Control (may be null)
+ * @param stage Stage running
+ * @param completed Work items done so far
+ * @param total Work items of the stage
+ *
+ * @throws AnalysisCancelled if a stop was requested
+ */
+inline void checkpoint(
+    const AnalysisControl* control, AnalysisStage stage, std::size_t completed, std::size_t total
+) {
+    if (control != nullptr && (completed % kCheckpointInterval == 0 || completed == total)) {
+        control->Checkpoint(stage, completed, total);
+    }
+}
+
+}  // namespace tsexam::problem1
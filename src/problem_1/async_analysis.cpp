@@ -0,0 +1,99 @@
+#include "async_analysis.hpp"
+
+#include <exception>
+#include <memory>
+#include <utility>
+
+#include "mesh_analysis.hpp"
+#include "reorient_triangles.hpp"
+
+namespace tsexam::problem1 {
+
+namespace {
+
+/**
+ * @brief Queues a job on an executor and returns the future of its result
+ *
+ * @param executor Pool running the job
+ * @param job Callable returning the job result; its exceptions go to the future
+ * @return Future of the result
+ */
+template <typename Job>
+std::future<AsyncAnalysisResult> submit_job(ThreadPool& executor, Job job) {
+    // Shared so that the task stays copyable for `std::function`
+    auto promise{std::make_shared<std::promise<AsyncAnalysisResult>>()};
+    std::future<AsyncAnalysisResult> future{promise->get_future()};
+    executor.Submit([promise, job = std::move(job)]() {
+        try {
+            promise->set_value(job());
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+    return future;
+}
+
+/**
+ * @brief Loads the mesh of a job with its control and stats sink
+ *
+ * @param path Path to the STL file
+ * @param options Job options
+ * @param control Control of the job
+ * @param result Result receiving the stats and the triangle count
+ * @return Loaded mesh
+ */
+TriangleMesh load_job_mesh(
+    const std::string& path, const AsyncAnalysisOptions& options, const AnalysisControl& control,
+    AsyncAnalysisResult& result
+) {
+    TriangleMeshOptions mesh_options;
+    mesh_options.connectivity = options.connectivity;
+    mesh_options.num_threads = options.num_threads;
+    mesh_options.stats = &result.stats;
+    mesh_options.control = &control;
+    TriangleMesh mesh(path, mesh_options);
+    result.num_triangles = mesh.GetTriangles().size();
+    return mesh;
+}
+
+}  // namespace
+
+std::future<AsyncAnalysisResult> export_voids_to_stl_async(
+    ThreadPool& executor, std::string path, std::ostream& out, AsyncAnalysisOptions options
+) {
+    return submit_job(
+        executor, [path = std::move(path), out = &out, options = std::move(options)]() {
+            AsyncAnalysisResult result;
+            PipelineStats* const stats{&result.stats};
+            const AnalysisControl control(options.stop_token, options.on_progress);
+
+            // Same stages as `process_mesh_batch`, each checking the control
+            const TriangleMesh mesh{load_job_mesh(path, options, control, result)};
+            const MeshAnalysis analysis(mesh, stats, &control);
+            result.num_components = analysis.GetComponents().size();
+
+            result.num_voids =
+                export_voids_to_stl(analysis, *out, options.output_format, stats, &control);
+            return result;
+        }
+    );
+}
+
+std::future<AsyncAnalysisResult> export_inconsistent_triangles_async(
+    ThreadPool& executor, std::string path, std::size_t seed, std::ostream& out,
+    AsyncAnalysisOptions options
+) {
+    return submit_job(
+        executor, [path = std::move(path), seed, out = &out, options = std::move(options)]() {
+            AsyncAnalysisResult result;
+            const AnalysisControl control(options.stop_token, options.on_progress);
+
+            const TriangleMesh mesh{load_job_mesh(path, options, control, result)};
+            result.num_reoriented =
+                export_inconsistent_triangles(mesh, seed, *out, options.output_format, &control);
+            return result;
+        }
+    );
+}
+
+}  // namespace tsexam::problem1
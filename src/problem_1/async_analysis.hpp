@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <future>
+#include <ostream>
+#include <stop_token>
+#include <string>
+
+#include "analysis_control.hpp"
+#include "pipeline_stats.hpp"
+#include "stl_io.hpp"
+#include "thread_pool.hpp"
+#include "triangle_mesh.hpp"
+
+namespace tsexam::problem1 {
+
+/**
+ * @brief Options of an asynchronous analysis job
+ */
+struct AsyncAnalysisOptions {
+    /// Connectivity engine of the mesh
+    ConnectivityEngine connectivity{ConnectivityEngine::kEdgeHashMap};
+
+    /// Number of threads for the triangle validation (0: one per hardware core). Jobs already
+    /// run in parallel on the executor, so one thread per job is the default.
+    std::size_t num_threads{1};
+
+    /// STL encoding of the output
+    StlFormat output_format{StlFormat::kAscii};
+
+    /// Token whose stop request interrupts the job (default: never stops)
+    std::stop_token stop_token{};
+
+    /// Callback receiving the progress of the stages, on the worker running the job (may be
+    /// empty)
+    ProgressCallback on_progress{};
+};
+
+/**
+ * @brief Outcome of an asynchronous analysis job
+ */
+struct AsyncAnalysisResult {
+    std::size_t num_triangles{0};   ///< triangles of the mesh
+    std::size_t num_components{0};  ///< connected components (void export only)
+    std::size_t num_voids{0};       ///< closed components classified as voids (void export only)
+    std::size_t num_reoriented{0};  ///< triangles flipped from the seed (reorientation only)
+    PipelineStats stats{};          ///< stage timings and counters of the job
+};
+
+/**
+ * @brief Exports the voids of an STL file on an executor
+ *
+ * Queues one job on the executor that runs parse -> connectivity -> components -> voids ->
+ * export and writes the same output as `export_voids_to_stl(TriangleMesh(path), out, format)`.
+ * Every stage checks `options.stop_token` and reports to `options.on_progress` when it starts,
+ * every `kCheckpointInterval` work items of its loops (including the component BFS) and when it
+ * ends.
+ *
+ * @param executor Pool running the job; it must outlive the job
+ * @param path Path to an ASCII or binary STL file
+ * @param out The output stream (binary mode for `StlFormat::kBinary`); it must outlive the job
+ *        and is only written by the export stage
+ * @param options Job options
+ * @return Future of the job result. It rethrows `AnalysisCancelled` if the job was stopped (the
+ *         output may then hold a partial STL file), and the exceptions of `TriangleMesh` or the
+ *         output stream if the job failed.
+ */
+std::future<AsyncAnalysisResult> export_voids_to_stl_async(
+    ThreadPool& executor, std::string path, std::ostream& out, AsyncAnalysisOptions options = {}
+);
+
+/**
+ * @brief Exports the triangles with inconsistent orientations of an STL file on an executor
+ *
+ * Queues one job on the executor that runs parse -> connectivity -> reorientation -> export and
+ * writes the same output as `export_inconsistent_triangles(TriangleMesh(path), seed, out,
+ * format)`. Stop requests and progress are handled as in `export_voids_to_stl_async`; the
+ * reorientation BFS checks them too.
+ *
+ * @param executor Pool running the job; it must outlive the job
+ * @param path Path to an ASCII or binary STL file
+ * @param seed Index of the seed triangle
+ * @param out Output stream to write the exported triangles to; it must outlive the job
+ * @param options Job options
+ * @return Future of the job result (see `export_voids_to_stl_async`)
+ */
+std::future<AsyncAnalysisResult> export_inconsistent_triangles_async(
+    ThreadPool& executor, std::string path, std::size_t seed, std::ostream& out,
+    AsyncAnalysisOptions options = {}
+);
+
+}  // namespace tsexam::problem1
@@ -0,0 +1,262 @@
+#include "batch_processing.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include "common/parallel.hpp"
+
+#include "mesh_analysis.hpp"
+#include "thread_pool.hpp"
+#include "void_detection.hpp"
+
+namespace tsexam::problem1 {
+
+namespace {
+
+/**
+ * @brief Input bytes held by the jobs of a batch, bounded by `BatchOptions::max_in_flight_bytes`
+ */
+class InFlightBudget {
+public:
+    /**
+     * @brief Constructor
+     * @param max_bytes Bound on the bytes in flight
+     */
+    explicit InFlightBudget(std::size_t max_bytes) : max_bytes_{max_bytes} {}
+
+    /**
+     * @brief Blocks until a job of `bytes` fits, then charges it
+     *
+     * A job always fits when nothing is in flight, so a file larger than the bound runs alone.
+     * The check adds instead of subtracting: while such a file runs, the bytes in flight exceed
+     * the bound and `max_bytes_ - in_flight_` would wrap around.
+     *
+     * @param bytes Input size of the job
+     * @return Bytes in flight once the job is charged, the job included
+     */
+    std::size_t Acquire(std::size_t bytes) {
+        std::unique_lock<std::mutex> lock(this->mutex_);
+        this->released_.wait(lock, [this, bytes]() {
+            return this->in_flight_ == 0 || this->in_flight_ + bytes <= this->max_bytes_;
+        });
+        this->in_flight_ += bytes;
+        return this->in_flight_;
+    }
+
+    /**
+     * @brief Gives back the bytes of a finished job
+     * @param bytes Input size of the job
+     */
+    void Release(std::size_t bytes) {
+        {
+            const std::lock_guard<std::mutex> lock(this->mutex_);
+            this->in_flight_ -= bytes;
+        }
+        this->released_.notify_all();
+    }
+
+private:
+    std::size_t max_bytes_;
+    std::size_t in_flight_{0};
+    std::mutex mutex_;
+    std::condition_variable released_;
+};
+
+/**
+ * @brief Reads a whole file into memory
+ *
+ * @param path Path of the file
+ * @return Bytes of the file
+ *
+ * @throws std::invalid_argument if the file cannot be opened
+ * @throws std::runtime_error if reading fails
+ */
+std::string read_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::invalid_argument("failed to open STL file: " + path);
+    }
+    std::string bytes{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    if (file.bad()) {
+        throw std::runtime_error("failed to read STL file: " + path);
+    }
+    return bytes;
+}
+
+/**
+ * @brief Opens an output STL file of a batch
+ *
+ * @param path Path of the output file
+ * @return Binary output stream
+ *
+ * @throws std::runtime_error if the file cannot be created
+ */
+std::ofstream open_output(const std::string& path) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        throw std::runtime_error("failed to create output file: " + path);
+    }
+    return out;
+}
+
+/**
+ * @brief Returns the number of threads for the internal stages of a file
+ *
+ * @param num_bytes Input size of the file
+ * @param options Batch options
+ * @param running_files Files being processed, this one included
+ * @return 1 for a small file; `large_file_threads`, or the file's share of the hardware cores if
+ *         it is 0, for a large one
+ */
+std::size_t file_thread_count(
+    std::size_t num_bytes, const BatchOptions& options, std::size_t running_files
+) {
+    if (num_bytes < options.large_file_bytes) {
+        return 1;
+    }
+    if (options.large_file_threads != 0) {
+        return options.large_file_threads;
+    }
+    return std::max<std::size_t>(1, common::resolve_thread_count(0) / running_files);
+}
+
+/**
+ * @brief Parses, builds, analyzes and exports one file of a batch
+ *
+ * @param bytes Contents of the input STL file
+ * @param options Batch options
+ * @param num_threads Number of threads for the parsing and the validation
+ * @param result Result of the file, filled in
+ */
+void process_file(
+    std::string_view bytes, const BatchOptions& options, std::size_t num_threads,
+    BatchResult& result
+) {
+    PipelineStats* const stats{&result.stats};
+
+    // Parse -> mesh, as `TriangleMesh::FromMappedFile` does over a mapping
+    std::vector<Triangle> triangles;
+    {
+        const ScopedStageTimer timer(stats, &PipelineStats::parse_time);
+        triangles = (detect_stl_format(bytes) == StlFormat::kBinary)
+                        ? parse_binary_stl(bytes)
+                        : parse_ascii_stl(bytes, num_threads);
+    }
+    record_stats(stats, [&](PipelineStats& s) {
+        s.bytes_parsed += bytes.size();
+        s.triangles_parsed += triangles.size();
+    });
+    const TriangleMesh mesh(
+        std::move(triangles), TriangleMeshOptions{options.connectivity, num_threads, stats}
+    );
+    result.num_triangles = mesh.GetTriangles().size();
+
+    // One traversal feeds both analyses
+    const MeshAnalysis analysis(mesh, stats);
+    result.num_components = analysis.GetComponents().size();
+    const std::filesystem::path stem{std::filesystem::path(result.input_path).stem()};
+    const std::filesystem::path directory{options.output_directory};
+
+    if (options.export_voids) {
+        const std::vector<ConnectedComponent> voids{
+            identify_voids(analysis, VoidClassification::kAabbContainment, stats)
+        };
+        result.num_voids = voids.size();
+        if (!options.output_directory.empty()) {
+            const std::vector<ComponentView> views(voids.begin(), voids.end());
+            result.voids_path = (directory / (stem.string() + "_voids.stl")).string();
+            std::ofstream out{open_output(result.voids_path)};
+            write_voids_to_stl(mesh, views, out, options.output_format, stats);
+        }
+    }
+
+    if (options.export_reoriented) {
+        const std::vector<Triangle> flipped{
+            analysis.GetInconsistentTriangles(options.reorient_seed)
+        };
+        result.num_reoriented = flipped.size();
+        if (!options.output_directory.empty()) {
+            result.reoriented_path = (directory / (stem.string() + "_reoriented.stl")).string();
+            std::ofstream out{open_output(result.reoriented_path)};
+            StlWriter writer(out, options.output_format, "reoriented_triangles", flipped.size());
+            for (const Triangle& triangle : flipped) {
+                writer.Write(triangle);
+            }
+            writer.Finish();
+        }
+    }
+}
+
+}  // namespace
+
+std::vector<BatchResult> process_mesh_batch(
+    const std::vector<std::string>& paths, const BatchOptions& options
+) {
+    std::vector<BatchResult> results(paths.size());
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        results[i].input_path = paths[i];
+    }
+    if (!options.output_directory.empty()) {
+        std::filesystem::create_directories(options.output_directory);
+    }
+
+    InFlightBudget budget(options.max_in_flight_bytes);
+    ThreadPool pool(options.num_workers);
+    std::atomic<std::size_t> running_files{0};
+
+    // Lambda: record the failure of a file
+    auto fail = [](BatchResult& result, const std::exception& e) {
+        result.succeeded = false;
+        result.error = e.what();
+    };
+
+    // The calling thread reads ahead while the pool processes the files already read
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        BatchResult& result{results[i]};
+        std::error_code size_error;
+        const std::uintmax_t file_size{std::filesystem::file_size(paths[i], size_error)};
+        const std::size_t charge{
+            size_error ? std::size_t{0} : static_cast<std::size_t>(file_size)
+        };
+        result.in_flight_bytes = budget.Acquire(charge);
+
+        std::string bytes;
+        try {
+            bytes = read_file(paths[i]);
+        } catch (const std::exception& e) {
+            fail(result, e);
+            budget.Release(charge);
+            continue;
+        }
+
+        pool.Submit([&budget, &options, &result, &fail, &running_files, charge,
+                     bytes = std::move(bytes)]() mutable {
+            const std::size_t num_running{running_files.fetch_add(1) + 1};
+            try {
+                process_file(
+                    bytes, options, file_thread_count(bytes.size(), options, num_running), result
+                );
+                result.succeeded = true;
+            } catch (const std::exception& e) {
+                fail(result, e);
+            }
+            running_files.fetch_sub(1);
+            std::string().swap(bytes);  // free the input before giving its budget back
+            budget.Release(charge);
+        });
+    }
+    pool.Wait();
+    return results;
+}
+
+}  // namespace tsexam::problem1
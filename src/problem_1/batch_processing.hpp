@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "pipeline_stats.hpp"
+#include "stl_io.hpp"
+#include "triangle_mesh.hpp"
+
+namespace tsexam::problem1 {
+
+/**
+ * @brief Options of a batch run (see `process_mesh_batch`)
+ */
+struct BatchOptions {
+    /// Number of worker threads of the pool (0: one per hardware core)
+    std::size_t num_workers{0};
+
+    /// Upper bound on the input bytes read and not yet fully processed. A file is read only once
+    /// it fits next to the files in flight, except that a single file larger than the bound
+    /// still runs, alone.
+    std::size_t max_in_flight_bytes{std::size_t{1} << 30};
+
+    /// Files of at least this many bytes run their ASCII parsing and triangle validation on
+    /// `large_file_threads` threads; smaller ones run single-threaded on their worker
+    std::size_t large_file_bytes{std::size_t{64} << 20};
+
+    /// Number of threads for the internal stages of a large file. 0 (the default) shares the
+    /// hardware cores among the files being processed: a large file that starts while k files run
+    /// (itself included) gets cores / k threads, at least 1. A large file alone thus uses every
+    /// core, while busy workers do not each spawn one thread per core on top of the pool.
+    std::size_t large_file_threads{0};
+
+    /// Connectivity engine of the meshes
+    ConnectivityEngine connectivity{ConnectivityEngine::kEdgeHashMap};
+
+    /// Directory of the output STL files (empty: the analyses run but nothing is written)
+    std::string output_directory{};
+
+    /// Write the voids of every mesh as `<stem>_voids.stl`
+    bool export_voids{true};
+
+    /// Write the triangles that reorienting from `reorient_seed` flips as `<stem>_reoriented.stl`
+    bool export_reoriented{false};
+
+    /// Seed triangle of the reorientation
+    std::size_t reorient_seed{0};
+
+    /// STL encoding of the outputs
+    StlFormat output_format{StlFormat::kBinary};
+};
+
+/**
+ * @brief Outcome of one file of a batch
+ */
+struct BatchResult {
+    std::string input_path{};        ///< path of the input STL file
+    bool succeeded{false};           ///< false if reading, loading or exporting failed
+    std::string error{};             ///< message of the failure (empty on success)
+    std::size_t num_triangles{0};    ///< triangles of the mesh
+    std::size_t num_components{0};   ///< connected components of the mesh
+    std::size_t num_voids{0};        ///< closed components classified as voids
+    std::size_t num_reoriented{0};   ///< triangles flipped by reorienting from the seed
+    std::string voids_path{};        ///< void output written (empty if none)
+    std::string reoriented_path{};   ///< reorientation output written (empty if none)
+    std::size_t in_flight_bytes{0};  ///< input bytes in flight at admission, its own included
+    PipelineStats stats{};           ///< stage timings and counters of the file
+};
+
+/**
+ * @brief Runs parse -> connectivity -> voids / reorientation over many STL files
+ *
+ * The calling thread reads the files, one after the other, into memory, and hands every file to
+ * a work-stealing `ThreadPool` that parses it, builds the mesh, analyzes it in one `MeshAnalysis`
+ * traversal and writes the requested outputs. Reading the next files thus overlaps with the
+ * processing of the previous ones, while `BatchOptions::max_in_flight_bytes` bounds how much
+ * input is held at once (the memory of a job's mesh is proportional to its input size).
+ *
+ * A failing file does not stop the batch: its result records the error and the other files go
+ * on. Output names derive from the input file stem, so inputs with the same file name in one
+ * batch overwrite each other's outputs.
+ *
+ * @param paths Paths of the input STL files (ASCII or binary)
+ * @param options Batch options
+ * @return One result per input path, in input order
+ */
+std::vector<BatchResult> process_mesh_batch(
+    const std::vector<std::string>& paths, const BatchOptions& options = {}
+);
+
+}  // namespace tsexam::problem1
@@ -0,0 +1,455 @@
+#include "bvh.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "common/parallel.hpp"
+
+namespace tsexam::problem1 {
+
+namespace {
+
+/// Number of SAH bins per split
+constexpr std::size_t kNumBins{12};
+
+/// Nodes with at most this many triangles may become leaves when splitting does not pay off
+constexpr std::size_t kMaxLeafTriangles{8};
+
+/// Nodes with at most this many triangles always become leaves
+constexpr std::size_t kMinSplitTriangles{2};
+
+/// Subtrees smaller than this are not worth a parallel task
+constexpr std::size_t kMinParallelSubtree{1024};
+
+/// Initial capacity of the traversal stack (enough for the depth of typical trees)
+constexpr std::size_t kTraversalStackCapacity{64};
+
+//----------------------------------------------
+// Vector helpers
+//----------------------------------------------
+
+Point subtract(const Point& p, const Point& q) {
+    return {p[0] - q[0], p[1] - q[1], p[2] - q[2]};
+}
+
+Point cross(const Point& p, const Point& q) {
+    return {p[1] * q[2] - p[2] * q[1], p[2] * q[0] - p[0] * q[2], p[0] * q[1] - p[1] * q[0]};
+}
+
+double dot(const Point& p, const Point& q) {
+    return p[0] * q[0] + p[1] * q[1] + p[2] * q[2];
+}
+
+//----------------------------------------------
+// Build data
+//----------------------------------------------
+
+/// Axis-aligned bounds that can be grown point by point
+struct Bounds {
+    Point min{
+        std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+        std::numeric_limits<double>::infinity()
+    };
+    Point max{
+        -std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+        -std::numeric_limits<double>::infinity()
+    };
+
+    void Grow(const Point& point) {
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+            this->min[axis] = std::min(this->min[axis], point[axis]);
+            this->max[axis] = std::max(this->max[axis], point[axis]);
+        }
+    }
+
+    void Grow(const Bounds& other) {
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+            this->min[axis] = std::min(this->min[axis], other.min[axis]);
+            this->max[axis] = std::max(this->max[axis], other.max[axis]);
+        }
+    }
+
+    /// Surface area; 0 for empty bounds
+    double SurfaceArea() const {
+        if (this->min[0] > this->max[0]) {
+            return 0.;
+        }
+        const Point extent{subtract(this->max, this->min)};
+        return 2. * (extent[0] * extent[1] + extent[1] * extent[2] + extent[2] * extent[0]);
+    }
+};
+
+/// Triangle reference used while building
+struct Primitive {
+    Bounds bounds;           ///< bounds of the triangle
+    Point centroid;          ///< centroid of the triangle
+    std::uint32_t position;  ///< position in the input triangle index list
+};
+
+/// Subtree whose construction was deferred to a parallel task
+struct DeferredSubtree {
+    std::size_t node;   ///< placeholder node in the top-level tree
+    std::size_t begin;  ///< first primitive of the subtree
+    std::size_t end;    ///< one past the last primitive of the subtree
+};
+
+/**
+ * @brief Top-down binned SAH builder over a primitive array
+ *
+ * Each node partitions its own primitive range in place, so subtrees over disjoint ranges can be
+ * built concurrently into separate node arrays.
+ */
+class BvhBuilder {
+public:
+    explicit BvhBuilder(std::vector<Primitive>& primitives) : primitives_(primitives) {}
+
+    /**
+     * @brief Builds the subtree of a node over primitives [begin, end)
+     *
+     * @param nodes Node array; `nodes[node]` must exist, children are appended
+     * @param node Index of the subtree root
+     * @param begin First primitive
+     * @param end One past the last primitive
+     * @param depth Depth of the node
+     * @param defer_depth Depth at which subtrees are deferred instead of built (none if null)
+     * @param deferred Receives the deferred subtrees
+     */
+    void BuildNode(
+        std::vector<TriangleBvh::Node>& nodes, std::size_t node, std::size_t begin,
+        std::size_t end, std::size_t depth, std::size_t defer_depth,
+        std::vector<DeferredSubtree>* deferred
+    ) const {
+        if (deferred != nullptr && depth == defer_depth && end - begin >= kMinParallelSubtree) {
+            deferred->push_back({node, begin, end});
+            return;
+        }
+
+        // Node bounds and centroid bounds of the range
+        Bounds bounds;
+        Bounds centroid_bounds;
+        for (std::size_t i = begin; i < end; ++i) {
+            bounds.Grow(this->primitives_[i].bounds);
+            centroid_bounds.Grow(this->primitives_[i].centroid);
+        }
+        nodes[node].min = bounds.min;
+        nodes[node].max = bounds.max;
+
+        // Lambda: turn the node into a leaf over the whole range
+        auto make_leaf = [&]() {
+            nodes[node].first = static_cast<std::uint32_t>(begin);
+            nodes[node].count = static_cast<std::uint32_t>(end - begin);
+        };
+
+        const std::size_t count{end - begin};
+        if (count <= kMinSplitTriangles) {
+            make_leaf();
+            return;
+        }
+
+        // Split axis: largest centroid extent; identical centroids cannot be separated
+        const Point extent{subtract(centroid_bounds.max, centroid_bounds.min)};
+        const std::size_t axis{static_cast<std::size_t>(
+            std::max_element(extent.begin(), extent.end()) - extent.begin()
+        )};
+        if (extent[axis] <= 0.) {
+            make_leaf();
+            return;
+        }
+
+        // Lambda: SAH bin of a primitive along the split axis
+        const double bin_scale{static_cast<double>(kNumBins) / extent[axis]};
+        auto bin_of = [&](const Primitive& primitive) -> std::size_t {
+            const double offset{(primitive.centroid[axis] - centroid_bounds.min[axis]) * bin_scale};
+            return std::min(kNumBins - 1, static_cast<std::size_t>(offset));
+        };
+
+        std::array<Bounds, kNumBins> bin_bounds{};
+        std::array<std::size_t, kNumBins> bin_counts{};
+        for (std::size_t i = begin; i < end; ++i) {
+            const std::size_t bin{bin_of(this->primitives_[i])};
+            bin_bounds[bin].Grow(this->primitives_[i].bounds);
+            ++bin_counts[bin];
+        }
+
+        // Sweep from the right to get the area and count right of every split plane
+        std::array<double, kNumBins> right_area{};
+        std::array<std::size_t, kNumBins> right_count{};
+        Bounds right;
+        std::size_t right_total{0};
+        for (std::size_t bin = kNumBins - 1; bin > 0; --bin) {
+            right.Grow(bin_bounds[bin]);
+            right_total += bin_counts[bin];
+            right_area[bin] = right.SurfaceArea();
+            right_count[bin] = right_total;
+        }
+
+        // Best split "bins [0, split) | [split, kNumBins)" by SAH cost (relative to the node area)
+        Bounds left;
+        std::size_t left_total{0};
+        std::size_t best_split{0};
+        double best_cost{std::numeric_limits<double>::infinity()};
+        for (std::size_t split = 1; split < kNumBins; ++split) {
+            left.Grow(bin_bounds[split - 1]);
+            left_total += bin_counts[split - 1];
+            if (left_total == 0 || right_count[split] == 0) {
+                continue;
+            }
+            const double cost{
+                left.SurfaceArea() * static_cast<double>(left_total) +
+                right_area[split] * static_cast<double>(right_count[split])
+            };
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_split = split;
+            }
+        }
+
+        // Leaf if splitting does not beat intersecting every triangle (unit traversal cost)
+        const double node_area{bounds.SurfaceArea()};
+        const double split_cost{1. + ((node_area > 0.) ? best_cost / node_area : 0.)};
+        const bool split_pays_off{
+            count > kMaxLeafTriangles || split_cost < static_cast<double>(count)
+        };
+        if (best_split == 0 || !split_pays_off) {
+            make_leaf();
+            return;
+        }
+
+        auto* const first{this->primitives_.data() + begin};
+        auto* const middle{std::partition(
+            first, this->primitives_.data() + end,
+            [&](const Primitive& primitive) { return bin_of(primitive) < best_split; }
+        )};
+        const std::size_t mid{begin + static_cast<std::size_t>(middle - first)};
+
+        // Children are allocated as a pair
+        const std::size_t left_child{nodes.size()};
+        nodes.resize(nodes.size() + 2);
+        nodes[node].first = static_cast<std::uint32_t>(left_child);
+        nodes[node].count = 0;
+        this->BuildNode(nodes, left_child, begin, mid, depth + 1, defer_depth, deferred);
+        this->BuildNode(nodes, left_child + 1, mid, end, depth + 1, defer_depth, deferred);
+    }
+
+private:
+    /// Primitives being partitioned
+    std::vector<Primitive>& primitives_;
+};
+
+/**
+ * @brief Intersects a ray with node bounds (slab test)
+ *
+ * @return true if the ray overlaps the bounds at some parameter t > kRayEpsilon
+ */
+bool ray_hits_bounds(
+    const Point& origin, const Point& inverse_direction, const Point& direction,
+    const TriangleBvh::Node& node
+) {
+    double t_near{kRayEpsilon};
+    double t_far{std::numeric_limits<double>::infinity()};
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+        if (direction[axis] == 0.) {
+            // Parallel to the slab -> inside or never
+            if (origin[axis] < node.min[axis] || origin[axis] > node.max[axis]) {
+                return false;
+            }
+            continue;
+        }
+        double t0{(node.min[axis] - origin[axis]) * inverse_direction[axis]};
+        double t1{(node.max[axis] - origin[axis]) * inverse_direction[axis]};
+        if (t0 > t1) {
+            std::swap(t0, t1);
+        }
+        t_near = std::max(t_near, t0);
+        t_far = std::min(t_far, t1);
+        if (t_near > t_far) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+bool ray_intersects_triangle(
+    const Point& origin, const Point& direction, const Triangle& triangle, double& t
+) {
+    const Point edge1{subtract(triangle.b, triangle.a)};
+    const Point edge2{subtract(triangle.c, triangle.a)};
+    const Point p{cross(direction, edge2)};
+    const double determinant{dot(edge1, p)};
+
+    // Ray parallel to the triangle plane -> no (counted) hit
+    if (determinant == 0.) {
+        return false;
+    }
+    const double inverse_determinant{1. / determinant};
+
+    // Barycentric coordinates (u, v) of the hit point
+    const Point s{subtract(origin, triangle.a)};
+    const double u{dot(s, p) * inverse_determinant};
+    if (u < 0. || u > 1.) {
+        return false;
+    }
+    const Point q{cross(s, edge1)};
+    const double v{dot(direction, q) * inverse_determinant};
+    if (v < 0. || u + v > 1.) {
+        return false;
+    }
+
+    const double hit{dot(edge2, q) * inverse_determinant};
+    if (hit <= kRayEpsilon) {
+        return false;
+    }
+    t = hit;
+    return true;
+}
+
+TriangleBvh::TriangleBvh(const std::vector<Triangle>& triangles, std::size_t num_threads) {
+    this->triangle_indices_.resize(triangles.size());
+    for (std::size_t i = 0; i < triangles.size(); ++i) {
+        this->triangle_indices_[i] = static_cast<TriangleIndex>(i);
+    }
+    this->Build(triangles, num_threads);
+}
+
+TriangleBvh::TriangleBvh(
+    const std::vector<Triangle>& triangles, std::vector<TriangleIndex> triangle_indices,
+    std::size_t num_threads
+)
+    : triangle_indices_(std::move(triangle_indices)) {
+    this->Build(triangles, num_threads);
+}
+
+void TriangleBvh::Build(const std::vector<Triangle>& triangles, std::size_t num_threads) {
+    const std::size_t num_triangles{this->triangle_indices_.size()};
+    if (num_triangles > std::numeric_limits<std::uint32_t>::max() / 2) {
+        throw std::invalid_argument("too many triangles for a 32-bit BVH");
+    }
+    // Small trees (e.g. one small shell) are not worth spawning threads for
+    const std::size_t thread_count{
+        (num_triangles >= kMinParallelSubtree) ? common::resolve_thread_count(num_threads) : 1
+    };
+
+    //----------------------------------------------
+    // Primitive bounds and centroids
+    //----------------------------------------------
+
+    std::vector<Primitive> primitives(num_triangles);
+    common::parallel_for(num_triangles, thread_count, [&](std::size_t i) {
+        const Triangle& t{triangles[static_cast<std::size_t>(this->triangle_indices_[i])]};
+        Primitive& primitive{primitives[i]};
+        primitive.bounds.Grow(t.a);
+        primitive.bounds.Grow(t.b);
+        primitive.bounds.Grow(t.c);
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+            primitive.centroid[axis] = (t.a[axis] + t.b[axis] + t.c[axis]) / 3.;
+        }
+        primitive.position = static_cast<std::uint32_t>(i);
+    });
+
+    //----------------------------------------------
+    // Tree: top levels serially, deferred subtrees in parallel, then splice
+    //----------------------------------------------
+
+    this->nodes_.assign(1, Node{{0., 0., 0.}, {0., 0., 0.}, 0, 0});
+    if (num_triangles > 0) {
+        const BvhBuilder builder(primitives);
+
+        // Defer at the depth that yields about 4 subtrees per thread
+        std::size_t defer_depth{0};
+        while (thread_count > 1 && (std::size_t{1} << defer_depth) < 4 * thread_count) {
+            ++defer_depth;
+        }
+        std::vector<DeferredSubtree> deferred;
+        builder.BuildNode(
+            this->nodes_, 0, 0, num_triangles, 0, defer_depth,
+            (thread_count > 1) ? &deferred : nullptr
+        );
+
+        std::vector<std::vector<Node>> subtrees(deferred.size());
+        common::parallel_for(deferred.size(), thread_count, [&](std::size_t k) {
+            subtrees[k].assign(1, Node{});
+            builder.BuildNode(
+                subtrees[k], 0, deferred[k].begin, deferred[k].end, 0, 0, nullptr
+            );
+        });
+
+        // Splice: the subtree root replaces its placeholder, the other nodes are appended and
+        // their child offsets shifted
+        for (std::size_t k = 0; k < deferred.size(); ++k) {
+            std::vector<Node>& subtree{subtrees[k]};
+            const auto offset{static_cast<std::uint32_t>(this->nodes_.size() - 1)};
+            for (Node& node : subtree) {
+                if (node.count == 0) {
+                    node.first += offset;
+                }
+            }
+            this->nodes_[deferred[k].node] = subtree.front();
+            this->nodes_.insert(this->nodes_.end(), subtree.begin() + 1, subtree.end());
+        }
+    }
+
+    //----------------------------------------------
+    // Triangles in leaf order
+    //----------------------------------------------
+
+    std::vector<TriangleIndex> ordered_indices(num_triangles);
+    this->triangles_.resize(num_triangles);
+    for (std::size_t i = 0; i < num_triangles; ++i) {
+        const TriangleIndex index{this->triangle_indices_[primitives[i].position]};
+        ordered_indices[i] = index;
+        this->triangles_[i] = triangles[static_cast<std::size_t>(index)];
+    }
+    this->triangle_indices_ = std::move(ordered_indices);
+}
+
+std::size_t TriangleBvh::CountRayHits(const Point& origin, const Point& direction) const {
+    if (this->triangles_.empty()) {
+        return 0;
+    }
+    const Point inverse_direction{1. / direction[0], 1. / direction[1], 1. / direction[2]};
+
+    std::size_t hits{0};
+    std::vector<std::uint32_t> stack;
+    stack.reserve(kTraversalStackCapacity);
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const Node& node{this->nodes_[stack.back()]};
+        stack.pop_back();
+        if (!ray_hits_bounds(origin, inverse_direction, direction, node)) {
+            continue;
+        }
+        if (node.count > 0) {
+            for (std::uint32_t i = node.first; i < node.first + node.count; ++i) {
+                double t{0.};
+                if (ray_intersects_triangle(origin, direction, this->triangles_[i], t)) {
+                    ++hits;
+                }
+            }
+            continue;
+        }
+        stack.push_back(node.first);
+        stack.push_back(node.first + 1);
+    }
+    return hits;
+}
+
+bool TriangleBvh::ContainsPoint(const Point& point) const {
+    // Fixed, mutually skewed directions: no axis alignment with typical CAD geometry
+    constexpr std::array<Point, 3> kDirections{
+        Point{0.6123, 0.5187, 0.5967}, Point{-0.4871, 0.7213, -0.4926},
+        Point{0.3329, -0.6451, 0.6876}
+    };
+
+    std::size_t inside_votes{0};
+    for (const Point& direction : kDirections) {
+        inside_votes += this->CountRayHits(point, direction) % 2;
+    }
+    return inside_votes >= 2;
+}
+
+}  // namespace tsexam::problem1
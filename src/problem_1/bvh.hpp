@@ -0,0 +1,141 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "geometry.hpp"
+#include "triangle_mesh.hpp"
+
+namespace tsexam::problem1 {
+
+//----------------------------------------------------
+// Ray / triangle intersection
+//----------------------------------------------------
+
+/// Minimum ray parameter counted as a hit (rejects hits at the ray origin)
+constexpr double kRayEpsilon{1e-12};
+
+/**
+ * @brief Intersects a ray with a triangle (Möller–Trumbore)
+ *
+ * @param origin Ray origin
+ * @param direction Ray direction (need not be normalized)
+ * @param triangle Triangle to intersect
+ * @param t Ray parameter of the hit point, set only on a hit
+ * @return true if the ray hits the triangle at a parameter t > kRayEpsilon
+ */
+bool ray_intersects_triangle(
+    const Point& origin, const Point& direction, const Triangle& triangle, double& t
+);
+
+//----------------------------------------------------
+// Bounding volume hierarchy
+//----------------------------------------------------
+
+/**
+ * @brief Bounding volume hierarchy over the triangles of a mesh
+ *
+ * The tree is built top-down with binned surface area heuristic (SAH) splits on the axis of
+ * largest centroid extent. With several threads, the top levels are split serially until there
+ * are enough independent subtrees, which are then built in parallel into separate node arrays and
+ * spliced into the final tree; the result is the same tree as a serial build.
+ *
+ * The BVH keeps its own copy of the indexed triangles, stored in leaf order for locality, so it
+ * stays valid independently of the mesh it was built from.
+ */
+class TriangleBvh {
+public:
+    /**
+     * @brief BVH node
+     *
+     * Inner nodes have `count == 0` and their children at `first` and `first + 1`. Leaves hold
+     * `count` triangles starting at position `first` of the BVH triangle order.
+     */
+    struct Node {
+        std::array<double, 3> min;  ///< minimum corner of the node bounds
+        std::array<double, 3> max;  ///< maximum corner of the node bounds
+        std::uint32_t first;        ///< first child (inner node) or first triangle (leaf)
+        std::uint32_t count;        ///< number of triangles (leaf), 0 for inner nodes
+    };
+
+    /**
+     * @brief Builds a BVH over all triangles
+     *
+     * @param triangles Triangles to index
+     * @param num_threads Number of build threads (0: one per hardware core)
+     *
+     * @throws std::invalid_argument if there are more triangles than 32-bit node offsets address
+     */
+    explicit TriangleBvh(const std::vector<Triangle>& triangles, std::size_t num_threads = 0);
+
+    /**
+     * @brief Builds a BVH over a subset of triangles (e.g. one connected component)
+     *
+     * @param triangles Triangles of the mesh
+     * @param triangle_indices Indices of the triangles to index
+     * @param num_threads Number of build threads (0: one per hardware core)
+     *
+     * @throws std::invalid_argument if there are more triangles than 32-bit node offsets address
+     */
+    TriangleBvh(
+        const std::vector<Triangle>& triangles, std::vector<TriangleIndex> triangle_indices,
+        std::size_t num_threads = 0
+    );
+
+    /**
+     * @brief Counts the triangles hit by a ray
+     *
+     * @param origin Ray origin
+     * @param direction Ray direction (need not be normalized)
+     * @return Number of indexed triangles hit at a parameter t > kRayEpsilon
+     */
+    std::size_t CountRayHits(const Point& origin, const Point& direction) const;
+
+    /**
+     * @brief Checks whether a point lies inside the solid bounded by the indexed triangles
+     *
+     * Casts rays in three fixed, non axis-aligned directions and takes the majority of their
+     * crossing parities, which guards against a ray grazing an edge or vertex and being counted
+     * twice. The indexed triangles must form a closed surface.
+     *
+     * @param point Query point
+     * @return true if the point is inside
+     */
+    bool ContainsPoint(const Point& point) const;
+
+    /**
+     * @brief Returns the nodes of the tree; node 0 is the root
+     *
+     * @return Reference to the nodes
+     */
+    const std::vector<Node>& GetNodes() const { return nodes_; }
+
+    /**
+     * @brief Returns the original indices of the indexed triangles, in BVH (leaf) order
+     *
+     * @return Reference to the triangle indices
+     */
+    const std::vector<TriangleIndex>& GetTriangleIndices() const { return triangle_indices_; }
+
+private:
+    /**
+     * @brief Builds the tree over `triangle_indices_`
+     *
+     * @param triangles Triangles of the mesh
+     * @param num_threads Number of build threads (0: one per hardware core)
+     */
+    void Build(const std::vector<Triangle>& triangles, std::size_t num_threads);
+
+    /// Tree nodes, root first
+    std::vector<Node> nodes_;
+
+    /// Indexed triangles in BVH order
+    std::vector<Triangle> triangles_;
+
+    /// Original index of every triangle in `triangles_`
+    std::vector<TriangleIndex> triangle_indices_;
+};
+
+}  // namespace tsexam::problem1
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace tsexam::problem1 {
+
+/**
+ * @brief Lock-free union-find (disjoint-set forest) over the elements [0, size)
+ *
+ * `Find` and `Unite` may be called concurrently from any number of threads. Roots are only ever
+ * linked below a smaller root, so parent indices strictly decrease along every path and, once all
+ * unions are done, the root of every set is its smallest element. `Find` compresses paths by
+ * halving with a compare-and-swap that only ever moves a parent to one of its own ancestors, which
+ * keeps concurrent finds and unions safe without locks.
+ */
+class ConcurrentDisjointSets {
+public:
+    /**
+     * @brief Creates `size` singleton sets
+     *
+     * @param size Number of elements
+     *
+     * @throws std::invalid_argument if size exceeds the 32-bit element range
+     */
+    explicit ConcurrentDisjointSets(std::size_t size) : parents_(size) {
+        if (size > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::invalid_argument("too many elements for 32-bit disjoint sets");
+        }
+        for (std::size_t i = 0; i < size; ++i) {
+            this->parents_[i].store(static_cast<std::uint32_t>(i), std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Returns the number of elements
+     */
+    std::size_t Size() const { return parents_.size(); }
+
+    /**
+     * @brief Returns the root of the set containing an element
+     *
+     * @param element Element index
+     * @return Root element of the set
+     */
+    std::size_t Find(std::size_t element) {
+        auto x{static_cast<std::uint32_t>(element)};
+        while (true) {
+            std::uint32_t parent{this->parents_[x].load(std::memory_order_relaxed)};
+            if (parent == x) {
+                return x;
+            }
+            const std::uint32_t grandparent{this->parents_[parent].load(std::memory_order_relaxed)};
+            if (grandparent != parent) {
+                // Path halving: point x at its grandparent unless another thread moved it already
+                this->parents_[x].compare_exchange_weak(
+                    parent, grandparent, std::memory_order_relaxed
+                );
+            }
+            x = grandparent;
+        }
+    }
+
+    /**
+     * @brief Merges the sets containing two elements
+     *
+     * The larger root is linked below the smaller one.
+     *
+     * @param a First element
+     * @param b Second element
+     * @return true if the elements were in different sets
+     */
+    bool Unite(std::size_t a, std::size_t b) {
+        while (true) {
+            auto root_a{static_cast<std::uint32_t>(this->Find(a))};
+            auto root_b{static_cast<std::uint32_t>(this->Find(b))};
+            if (root_a == root_b) {
+                return false;
+            }
+            if (root_a < root_b) {
+                std::swap(root_a, root_b);
+            }
+
+            // Link only if root_a is still a root; otherwise another union got there first ->
+            // retry from the new roots
+            std::uint32_t expected{root_a};
+            if (this->parents_[root_a].compare_exchange_strong(
+                    expected, root_b, std::memory_order_acq_rel, std::memory_order_relaxed
+                )) {
+                return true;
+            }
+        }
+    }
+
+private:
+    /// Parent of every element; roots are their own parent
+    std::vector<std::atomic<std::uint32_t>> parents_;
+};
+
+}  // namespace tsexam::problem1
@@ -0,0 +1,326 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tsexam::problem1 {
+
+/**
+ * @brief Open-addressing hash map with linear probing over flat slot arrays
+ *
+ * Keys and values live in one contiguous slot array, next to a parallel array of one control byte
+ * per slot: 0 for an empty slot, otherwise a tag holding the top 7 bits of the key hash. A lookup
+ * is one hash, then a linear scan from the home slot that only compares keys whose tag matches,
+ * and stops at the first empty slot. There is no node per entry and no bucket list to chase, so
+ * the probes stay within a few cache lines.
+ *
+ * The capacity is a power of two and the table grows by doubling before its load exceeds
+ * `kMaxLoadFactor`. Entries cannot be erased (the connectivity engines only insert), which keeps
+ * the probe sequences free of tombstones. Both arrays are drawn from the allocator's memory
+ * resource, like the `std::pmr` containers; a copy uses the default resource.
+ *
+ * The hash must spread its entropy over all bits: the low bits pick the home slot and the high
+ * bits the tag (see `mix_coordinate_bits`).
+ *
+ * @tparam Key Key type (default-constructible and copyable)
+ * @tparam Value Mapped type (default-constructible and copyable)
+ * @tparam Hash Hash functor of the keys
+ * @tparam KeyEqual Equality functor of the keys, consistent with `Hash`
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+class FlatHashMap {
+public:
+    /// Entry type; iterators expose the key mutably, but it must not be modified
+    using value_type = std::pair<Key, Value>;
+
+    /// Allocator of the slot arrays
+    using allocator_type = std::pmr::polymorphic_allocator<value_type>;
+
+    /// Highest fraction of occupied slots before the table grows
+    static constexpr double kMaxLoadFactor{0.75};
+
+private:
+    /// Forward iterator over the occupied slots, in slot order
+    template <bool kConst>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = FlatHashMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<kConst, const value_type*, value_type*>;
+        using reference = std::conditional_t<kConst, const value_type&, value_type&>;
+
+        Iterator() = default;
+
+        /// A mutable iterator converts to a const one
+        operator Iterator<true>() const {
+            return Iterator<true>(controls_, slots_, index_, capacity_);
+        }
+
+        reference operator*() const { return slots_[index_]; }
+        pointer operator->() const { return slots_ + index_; }
+
+        Iterator& operator++() {
+            ++index_;
+            this->SkipEmpty();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous{*this};
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const { return index_ == other.index_; }
+
+    private:
+        friend class FlatHashMap;
+        template <bool>
+        friend class Iterator;
+
+        Iterator(
+            const std::uint8_t* controls, pointer slots, std::size_t index, std::size_t capacity
+        )
+            : controls_{controls}, slots_{slots}, index_{index}, capacity_{capacity} {}
+
+        /// Advances to the next occupied slot (or the end)
+        void SkipEmpty() {
+            while (index_ < capacity_ && controls_[index_] == kEmpty) {
+                ++index_;
+            }
+        }
+
+        const std::uint8_t* controls_{nullptr};
+        pointer slots_{nullptr};
+        std::size_t index_{0};
+        std::size_t capacity_{0};
+    };
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    /**
+     * @brief Constructs an empty map without slots
+     *
+     * @param allocator Allocator of the slot arrays
+     */
+    explicit FlatHashMap(const allocator_type& allocator = {})
+        : controls_(allocator.resource()), slots_(allocator) {}
+
+    /**
+     * @brief Returns the allocator of the slot arrays
+     */
+    allocator_type get_allocator() const { return this->slots_.get_allocator(); }
+
+    iterator begin() { return this->MakeIterator<false>(0); }
+    iterator end() { return this->MakeIterator<false>(this->bucket_count()); }
+    const_iterator begin() const { return this->MakeIterator<true>(0); }
+    const_iterator end() const { return this->MakeIterator<true>(this->bucket_count()); }
+
+    /**
+     * @brief Returns the number of entries
+     */
+    std::size_t size() const { return size_; }
+
+    /**
+     * @brief Returns whether the map has no entries
+     */
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @brief Returns the number of slots (0 or a power of two)
+     */
+    std::size_t bucket_count() const { return slots_.size(); }
+
+    /**
+     * @brief Returns the fraction of occupied slots
+     */
+    float load_factor() const {
+        return this->slots_.empty()
+                   ? 0.0F
+                   : static_cast<float>(this->size_) / static_cast<float>(this->slots_.size());
+    }
+
+    /**
+     * @brief Removes every entry and keeps the slots
+     */
+    void clear() {
+        std::fill(this->controls_.begin(), this->controls_.end(), kEmpty);
+        this->size_ = 0;
+    }
+
+    /**
+     * @brief Grows the table so that `count` entries fit without another growth
+     *
+     * @param count Number of entries to make room for
+     */
+    void reserve(std::size_t count) {
+        std::size_t capacity{kMinCapacity};
+        while (!fits(count, capacity)) {
+            capacity *= 2;
+        }
+        if (capacity > this->bucket_count()) {
+            this->Rehash(capacity);
+        }
+    }
+
+    /**
+     * @brief Inserts an entry unless its key is already present
+     *
+     * @param key Key of the entry
+     * @param value Value stored if the key is new
+     * @return Iterator to the entry with the key, and whether it was inserted
+     */
+    std::pair<iterator, bool> try_emplace(const Key& key, const Value& value) {
+        const std::size_t hash{this->hash_(key)};
+        if (!this->slots_.empty()) {
+            const auto [index, found] = this->Probe(key, hash);
+            if (found) {
+                return {this->MakeIterator<false>(index), false};
+            }
+        }
+        if (!fits(this->size_ + 1, this->bucket_count())) {
+            this->Rehash(this->slots_.empty() ? kMinCapacity : 2 * this->bucket_count());
+        }
+        const std::size_t index{this->Probe(key, hash).first};
+        this->controls_[index] = tag_of(hash);
+        this->slots_[index] = value_type{key, value};
+        ++this->size_;
+        return {this->MakeIterator<false>(index), true};
+    }
+
+    /**
+     * @brief Looks up a key
+     *
+     * @param key Key to look up
+     * @return Iterator to the entry, or `end()` if the key is absent
+     */
+    iterator find(const Key& key) {
+        return this->MakeIterator<false>(this->FindIndex(key));
+    }
+
+    /// @copydoc find
+    const_iterator find(const Key& key) const {
+        return this->MakeIterator<true>(this->FindIndex(key));
+    }
+
+private:
+    /// Control byte of an empty slot; occupied slots have the top bit set
+    static constexpr std::uint8_t kEmpty{0};
+
+    /// Capacity of the first allocation
+    static constexpr std::size_t kMinCapacity{16};
+
+    /**
+     * @brief Returns whether `count` entries stay within the load factor of `capacity` slots
+     */
+    static constexpr bool fits(std::size_t count, std::size_t capacity) {
+        // count <= 0.75 * capacity, in integers
+        return 4 * count <= 3 * capacity;
+    }
+
+    /**
+     * @brief Returns the control byte of an occupied slot: the top 7 hash bits and the top bit
+     */
+    static constexpr std::uint8_t tag_of(std::size_t hash) {
+        constexpr int kShift{std::numeric_limits<std::size_t>::digits - 7};
+        return static_cast<std::uint8_t>(0x80U | static_cast<unsigned>(hash >> kShift));
+    }
+
+    /**
+     * @brief Follows the probe sequence of a key
+     *
+     * Requires at least one empty slot, which the load factor guarantees.
+     *
+     * @param key Key to look up
+     * @param hash Hash of the key
+     * @return Slot holding the key and true, or the empty slot ending the sequence and false
+     */
+    std::pair<std::size_t, bool> Probe(const Key& key, std::size_t hash) const {
+        const std::size_t mask{this->bucket_count() - 1};
+        const std::uint8_t tag{tag_of(hash)};
+        for (std::size_t index = hash & mask;; index = (index + 1) & mask) {
+            const std::uint8_t control{this->controls_[index]};
+            if (control == kEmpty) {
+                return {index, false};
+            }
+            if (control == tag && this->equal_(this->slots_[index].first, key)) {
+                return {index, true};
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the slot of a key, or `bucket_count()` if it is absent
+     */
+    std::size_t FindIndex(const Key& key) const {
+        if (this->size_ == 0) {
+            return this->bucket_count();
+        }
+        const auto [index, found] = this->Probe(key, this->hash_(key));
+        return found ? index : this->bucket_count();
+    }
+
+    /**
+     * @brief Moves every entry into a table of `capacity` slots
+     *
+     * @param capacity New number of slots (a power of two)
+     */
+    void Rehash(std::size_t capacity) {
+        std::pmr::vector<std::uint8_t> controls(capacity, kEmpty, this->controls_.get_allocator());
+        std::pmr::vector<value_type> slots(capacity, this->slots_.get_allocator());
+        const std::size_t mask{capacity - 1};
+        for (std::size_t i = 0; i < this->slots_.size(); ++i) {
+            if (this->controls_[i] == kEmpty) {
+                continue;
+            }
+            // Keys are distinct -> the first empty slot of the probe sequence is the new home
+            const std::size_t hash{this->hash_(this->slots_[i].first)};
+            std::size_t index{hash & mask};
+            while (controls[index] != kEmpty) {
+                index = (index + 1) & mask;
+            }
+            controls[index] = this->controls_[i];
+            slots[index] = std::move(this->slots_[i]);
+        }
+        this->controls_ = std::move(controls);
+        this->slots_ = std::move(slots);
+    }
+
+    /**
+     * @brief Returns an iterator at a slot, advanced to the first occupied one
+     */
+    template <bool kConst>
+    Iterator<kConst> MakeIterator(std::size_t index) const {
+        using Pointer = typename Iterator<kConst>::pointer;
+        Iterator<kConst> it(
+            this->controls_.data(), const_cast<Pointer>(this->slots_.data()), index,
+            this->bucket_count()
+        );
+        it.SkipEmpty();
+        return it;
+    }
+
+    /// Control byte of every slot
+    std::pmr::vector<std::uint8_t> controls_;
+
+    /// Entries, valid where the control byte is not `kEmpty`
+    std::pmr::vector<value_type> slots_;
+
+    /// Number of occupied slots
+    std::size_t size_{0};
+
+    [[no_unique_address]] Hash hash_{};
+    [[no_unique_address]] KeyEqual equal_{};
+};
+
+}  // namespace tsexam::problem1
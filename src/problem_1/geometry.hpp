@@ -1,8 +1,11 @@
 #pragma once
 
 #include <array>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <type_traits>
 #include <utility>
 
 namespace tsexam::problem1 {
@@ -11,22 +14,36 @@ namespace tsexam::problem1 {
 // Point
 //----------------------------------------------
 
-/// A 3D point represented by Cartesian coordinates (x, y, z)
-using Point = std::array<double, 3>;
+/**
+ * @brief A 3D point represented by Cartesian coordinates (x, y, z)
+ *
+ * The geometry types are templated on the coordinate type: `double` is the default used throughout
+ * the pipeline, `float` halves the memory of meshes whose source data is float32 anyway (binary
+ * STL).
+ */
+template <typename Scalar>
+using BasicPoint = std::array<Scalar, 3>;
+
+/// A 3D point with double coordinates
+using Point = BasicPoint<double>;
+
+/// A 3D point with float coordinates
+using PointF = BasicPoint<float>;
 
 /**
- * @brief Hash functor for Point
+ * @brief Hash functor for BasicPoint
  *
  * Computes a combined hash of the three coordinate values using a boost-style hash combination
  * technique.
  *
  * @note `noexcept` allows the compiler and library to optimize more aggressively.
  */
-struct PointHash {
-    std::size_t operator()(const Point& p) const noexcept {
-        std::size_t h1 = std::hash<double>{}(p[0]);  // hash x coordinate
-        std::size_t h2 = std::hash<double>{}(p[1]);  // hash y coordinate
-        std::size_t h3 = std::hash<double>{}(p[2]);  // hash z coordinate
+template <typename Scalar>
+struct BasicPointHash {
+    std::size_t operator()(const BasicPoint<Scalar>& p) const noexcept {
+        std::size_t h1 = std::hash<Scalar>{}(p[0]);  // hash x coordinate
+        std::size_t h2 = std::hash<Scalar>{}(p[1]);  // hash y coordinate
+        std::size_t h3 = std::hash<Scalar>{}(p[2]);  // hash z coordinate
 
         // Combine hashes using boost-style technique
         std::size_t hash = h1;
@@ -36,19 +53,26 @@ struct PointHash {
     }
 };
 
+/// Hash functor for Point
+using PointHash = BasicPointHash<double>;
+
 /**
- * @brief Equality functor for Point
+ * @brief Equality functor for BasicPoint
  *
  * Points are considered equal if all three coordinates compare equal.
  *
  * @note `noexcept` allows the compiler and library to optimize more aggressively.
  */
-struct PointEquality {
-    bool operator()(const Point& a, const Point& b) const noexcept {
+template <typename Scalar>
+struct BasicPointEquality {
+    bool operator()(const BasicPoint<Scalar>& a, const BasicPoint<Scalar>& b) const noexcept {
         return a[0] == b[0] && a[1] == b[1] && a[2] == b[2];
     }
 };
 
+/// Equality functor for Point
+using PointEquality = BasicPointEquality<double>;
+
 //----------------------------------------------
 // Edge
 //----------------------------------------------
@@ -60,31 +84,45 @@ struct PointEquality {
  * the second. Lexicographic ordering means that the x-coordinate is the primary key, followed by the
  * y-coordinate, and then the z-coordinate.
  */
-using Edge = std::pair<Point, Point>;
+template <typename Scalar>
+using BasicEdge = std::pair<BasicPoint<Scalar>, BasicPoint<Scalar>>;
+
+/// An edge between two Point
+using Edge = BasicEdge<double>;
+
+/// An edge between two PointF
+using EdgeF = BasicEdge<float>;
 
 /**
  * @brief Builds a canonical edge from two points
  *
- * The returned edge is ordered such that the smaller point (lexicographically) appears first.
+ * The returned edge is ordered such that the smaller point (lexicographically) appears first. The
+ * coordinate type is not deduced, so braced points build a double edge; float edges are built
+ * with `make_edge<float>(p, q)`.
  *
  * @param p First endpoint
  * @param q Second endpoint
  * @return Canonicalized edge
  */
-inline Edge make_edge(const Point& p, const Point& q) {
-    return (p < q) ? Edge{p, q} : Edge{q, p};
+template <typename Scalar = double>
+BasicEdge<Scalar> make_edge(
+    const std::type_identity_t<BasicPoint<Scalar>>& p,
+    const std::type_identity_t<BasicPoint<Scalar>>& q
+) {
+    return (p < q) ? BasicEdge<Scalar>{p, q} : BasicEdge<Scalar>{q, p};
 }
 
 /**
- * @brief Hash functor for Edge
+ * @brief Hash functor for BasicEdge
  *
  * Combines the hashes of the two endpoint points using a boost-style hash combination technique.
  *
  * @note `noexcept` allows the compiler and library to optimize more aggressively.
  */
-struct EdgeHash {
-    std::size_t operator()(const Edge& e) const noexcept {
-        PointHash point_hash;
+template <typename Scalar>
+struct BasicEdgeHash {
+    std::size_t operator()(const BasicEdge<Scalar>& e) const noexcept {
+        BasicPointHash<Scalar> point_hash;
         std::size_t h1 = point_hash(e.first);
         std::size_t h2 = point_hash(e.second);
 
@@ -95,21 +133,148 @@ struct EdgeHash {
     }
 };
 
+/// Hash functor for Edge
+using EdgeHash = BasicEdgeHash<double>;
+
 /**
- * @brief Equality functor for Edge
+ * @brief Equality functor for BasicEdge
  *
  * Two edges are equal if both corresponding endpoints compare equal. Edges are assumed to be in
  * canonical form.
  *
  * @note `noexcept` allows the compiler and library to optimize more aggressively.
  */
-struct EdgeEquality {
-    bool operator()(const Edge& e1, const Edge& e2) const noexcept {
-        PointEquality eq;
+template <typename Scalar>
+struct BasicEdgeEquality {
+    bool operator()(const BasicEdge<Scalar>& e1, const BasicEdge<Scalar>& e2) const noexcept {
+        BasicPointEquality<Scalar> eq;
         return eq(e1.first, e2.first) && eq(e1.second, e2.second);
     }
 };
 
+/// Equality functor for Edge
+using EdgeEquality = BasicEdgeEquality<double>;
+
+//----------------------------------------------
+// Bit-pattern hashing of exact coordinates
+//----------------------------------------------
+
+/**
+ * @brief Returns the bit pattern of a coordinate, with -0.0 mapped to +0.0
+ *
+ * The two zeros compare equal, so they must hash equal; adding +0.0 turns -0.0 into +0.0 and
+ * leaves every other value unchanged.
+ *
+ * @param value Coordinate value
+ * @return Bit pattern of the normalized value, zero-extended to 64 bits
+ */
+template <typename Scalar>
+constexpr std::uint64_t coordinate_bits(Scalar value) noexcept {
+    static_assert(std::is_floating_point_v<Scalar>, "coordinates must be floating point");
+    const Scalar normalized{value + Scalar{0}};
+    if constexpr (sizeof(Scalar) == sizeof(std::uint64_t)) {
+        return std::bit_cast<std::uint64_t>(normalized);
+    } else {
+        return std::uint64_t{std::bit_cast<std::uint32_t>(normalized)};
+    }
+}
+
+/**
+ * @brief Mixes up to six coordinate bit patterns into one hash
+ *
+ * Every lane is folded and multiplied by its own odd constant independently of the others, so the
+ * lane loop vectorizes, and the lanes are summed and run through the MurmurHash3 finalizer. The
+ * distinct multipliers keep the hash sensitive to the lane order (swapped coordinates or
+ * endpoints hash differently).
+ *
+ * @param lanes Bit patterns from `coordinate_bits`
+ * @return Hash whose bits are all usable, low and high (e.g. as a table index and a tag)
+ */
+template <std::size_t N>
+constexpr std::size_t mix_coordinate_bits(const std::array<std::uint64_t, N>& lanes) noexcept {
+    static_assert(N <= 6, "at most six lanes (one edge)");
+    constexpr std::array<std::uint64_t, 6> kLaneMultipliers{
+        0x9e3779b97f4a7c15ULL, 0xc2b2ae3d27d4eb4fULL, 0x165667b19e3779f9ULL,
+        0xd6e8feb86659fd93ULL, 0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL,
+    };
+    std::uint64_t hash{0};
+    for (std::size_t i = 0; i < N; ++i) {
+        hash += (lanes[i] ^ (lanes[i] >> 32)) * kLaneMultipliers[i];
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return static_cast<std::size_t>(hash);
+}
+
+/**
+ * @brief Hash functor for BasicPoint over the raw coordinate bits
+ *
+ * Cheaper drop-in for `BasicPointHash` with exact-match keys: no `std::hash` call per coordinate,
+ * one multiply per coordinate plus a single finalizer. Consistent with `BasicPointEquality`
+ * (including -0.0 == +0.0). NaN coordinates never compare equal, as with `BasicPointHash`.
+ */
+template <typename Scalar>
+struct BasicPointBitsHash {
+    std::size_t operator()(const BasicPoint<Scalar>& p) const noexcept {
+        return mix_coordinate_bits(std::array<std::uint64_t, 3>{
+            coordinate_bits(p[0]), coordinate_bits(p[1]), coordinate_bits(p[2])
+        });
+    }
+};
+
+/// Bit-pattern hash functor for Point
+using PointBitsHash = BasicPointBitsHash<double>;
+
+/**
+ * @brief Hash functor for BasicEdge over the raw coordinate bits of both endpoints
+ *
+ * The six coordinates are mixed as the lanes of one hash, instead of combining two point hashes.
+ * Consistent with `BasicEdgeEquality`.
+ */
+template <typename Scalar>
+struct BasicEdgeBitsHash {
+    std::size_t operator()(const BasicEdge<Scalar>& e) const noexcept {
+        return mix_coordinate_bits(std::array<std::uint64_t, 6>{
+            coordinate_bits(e.first[0]), coordinate_bits(e.first[1]),
+            coordinate_bits(e.first[2]), coordinate_bits(e.second[0]),
+            coordinate_bits(e.second[1]), coordinate_bits(e.second[2])
+        });
+    }
+};
+
+/// Bit-pattern hash functor for Edge
+using EdgeBitsHash = BasicEdgeBitsHash<double>;
+
+//----------------------------------------------
+// Indexed (welded) vertices and edges
+//----------------------------------------------
+
+/// Index of a welded vertex, i.e. a unique point shared by all triangles that touch it
+using VertexIndex = std::uint32_t;
+
+/**
+ * @brief An edge between two welded vertices, packed into 64 bits
+ *
+ * The smaller vertex index occupies the upper 32 bits and the larger one the lower 32 bits, so the
+ * key is canonical (independent of the direction the edge is traversed in) and cheap to hash and
+ * compare.
+ */
+using EdgeKey = std::uint64_t;
+
+/**
+ * @brief Builds a canonical edge key from two vertex indices
+ *
+ * @param p First endpoint
+ * @param q Second endpoint
+ * @return Edge key with the smaller index in the upper half
+ */
+constexpr EdgeKey make_edge_key(VertexIndex p, VertexIndex q) {
+    return (p < q) ? (EdgeKey{p} << 32) | EdgeKey{q} : (EdgeKey{q} << 32) | EdgeKey{p};
+}
+
 //----------------------------------------------
 // Triangle
 //----------------------------------------------
@@ -117,10 +282,34 @@ struct EdgeEquality {
 /**
  * @brief Triangle in 3D for storing STL mesh data
  */
-struct Triangle {
-    Point a;  //< first vertex
-    Point b;  //< second vertex
-    Point c;  //< third vertex
+template <typename Scalar>
+struct BasicTriangle {
+    BasicPoint<Scalar> a;  //< first vertex
+    BasicPoint<Scalar> b;  //< second vertex
+    BasicPoint<Scalar> c;  //< third vertex
 };
 
+/// Triangle with double coordinates (72 bytes)
+using Triangle = BasicTriangle<double>;
+
+/// Triangle with float coordinates (36 bytes)
+using TriangleF = BasicTriangle<float>;
+
+/**
+ * @brief Converts a triangle to another coordinate type
+ *
+ * float -> double is exact, so a triangle read as float and widened compares and orders
+ * exactly like the float original; double -> float rounds to nearest.
+ *
+ * @param triangle Triangle to convert
+ * @return Triangle with `To` coordinates
+ */
+template <typename To, typename From>
+BasicTriangle<To> triangle_cast(const BasicTriangle<From>& triangle) {
+    const auto point = [](const BasicPoint<From>& p) {
+        return BasicPoint<To>{static_cast<To>(p[0]), static_cast<To>(p[1]), static_cast<To>(p[2])};
+    };
+    return BasicTriangle<To>{point(triangle.a), point(triangle.b), point(triangle.c)};
+}
+
 }  // namespace tsexam::problem1
@@ -0,0 +1,142 @@
+#include "mapped_file.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tsexam::problem1 {
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile(const std::string& path) {
+    HANDLE file{CreateFileA(
+        path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr
+    )};
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("failed to open file for mapping: " + path);
+    }
+
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(file, &file_size)) {
+        CloseHandle(file);
+        throw std::runtime_error("failed to query file size: " + path);
+    }
+    this->size_ = static_cast<std::size_t>(file_size.QuadPart);
+
+    // Empty files cannot be mapped -> expose an empty view
+    if (this->size_ == 0) {
+        CloseHandle(file);
+        return;
+    }
+
+    this->mapping_handle_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);  // the mapping object keeps the file open
+    if (this->mapping_handle_ == nullptr) {
+        throw std::runtime_error("failed to map file: " + path);
+    }
+
+    this->data_ = static_cast<const char*>(
+        MapViewOfFile(this->mapping_handle_, FILE_MAP_READ, 0, 0, 0)
+    );
+    if (this->data_ == nullptr) {
+        CloseHandle(this->mapping_handle_);
+        throw std::runtime_error("failed to map file: " + path);
+    }
+}
+
+void MappedFile::Release() noexcept {
+    if (this->data_ != nullptr) {
+        UnmapViewOfFile(this->data_);
+    }
+    if (this->mapping_handle_ != nullptr) {
+        CloseHandle(this->mapping_handle_);
+    }
+    this->data_ = nullptr;
+    this->mapping_handle_ = nullptr;
+    this->size_ = 0;
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path) {
+    const int fd{::open(path.c_str(), O_RDONLY)};
+    if (fd < 0) {
+        throw std::runtime_error("failed to open file for mapping: " + path);
+    }
+
+    struct stat file_status{};
+    if (::fstat(fd, &file_status) != 0) {
+        ::close(fd);
+        throw std::runtime_error("failed to query file size: " + path);
+    }
+    this->size_ = static_cast<std::size_t>(file_status.st_size);
+
+    // Empty files cannot be mapped -> expose an empty view
+    if (this->size_ == 0) {
+        ::close(fd);
+        return;
+    }
+
+    void* mapping{::mmap(nullptr, this->size_, PROT_READ, MAP_PRIVATE, fd, 0)};
+    ::close(fd);  // the mapping keeps the file referenced
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("failed to map file: " + path);
+    }
+
+    // Parsers scan the file front to back -> ask the kernel for aggressive read-ahead
+    ::madvise(mapping, this->size_, MADV_SEQUENTIAL);
+    this->data_ = static_cast<const char*>(mapping);
+}
+
+void MappedFile::Release() noexcept {
+    if (this->data_ != nullptr) {
+        ::munmap(const_cast<char*>(this->data_), this->size_);
+    }
+    this->data_ = nullptr;
+    this->size_ = 0;
+}
+
+#endif
+
+MappedFile::~MappedFile() {
+    this->Release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0))
+#if defined(_WIN32)
+      ,
+      mapping_handle_(std::exchange(other.mapping_handle_, nullptr))
+#endif
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        this->Release();
+        this->data_ = std::exchange(other.data_, nullptr);
+        this->size_ = std::exchange(other.size_, 0);
+#if defined(_WIN32)
+        this->mapping_handle_ = std::exchange(other.mapping_handle_, nullptr);
+#endif
+    }
+    return *this;
+}
+
+}  // namespace tsexam::problem1
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace tsexam::problem1 {
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * The file is mapped with `mmap` on POSIX systems and with `CreateFileMapping` / `MapViewOfFile` on
+ * Windows. The mapped bytes stay valid for the lifetime of the object, so parsers can tokenize them
+ * in place instead of copying the file through a stream buffer.
+ *
+ * The class is move-only: the mapping is released exactly once by the owning object.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Maps the file at the provided path into memory
+     *
+     * @param path Path to the file
+     *
+     * @throws std::runtime_error if the file cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string& path);
+
+    /// Unmaps the file
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) noexcept;
+    MappedFile& operator=(MappedFile&&) noexcept;
+
+    /**
+     * @brief Returns the mapped bytes
+     *
+     * @return View over the whole file (empty for an empty file)
+     */
+    std::string_view GetData() const { return {data_, size_}; }
+
+    /**
+     * @brief Returns the size of the mapped file
+     *
+     * @return File size in bytes
+     */
+    std::size_t GetSize() const { return size_; }
+
+private:
+    /// Releases the mapping (and the OS handles on Windows)
+    void Release() noexcept;
+
+    /// Start of the mapped bytes (nullptr for an empty file)
+    const char* data_{nullptr};
+
+    /// Size of the mapped file in bytes
+    std::size_t size_{0};
+
+#if defined(_WIN32)
+    /// Handle of the mapping object
+    void* mapping_handle_{nullptr};
+#endif
+};
+
+}  // namespace tsexam::problem1
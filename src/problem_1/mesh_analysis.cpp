@@ -0,0 +1,208 @@
+#include "mesh_analysis.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <utility>
+
+#include "reorient_triangles.hpp"
+
+namespace tsexam::problem1 {
+
+MeshAnalysis::MeshAnalysis(
+    const TriangleMesh& mesh, PipelineStats* stats, const AnalysisControl* control
+)
+    : mesh_{&mesh} {
+    const ScopedStageTimer timer(stats, &PipelineStats::components_time);
+    const auto& triangles{mesh.GetTriangles()};
+    const auto& neighbors{mesh.GetTriangleNeighbors()};
+    const std::size_t num_triangles{triangles.size()};
+
+    constexpr auto kUnvisited{std::numeric_limits<std::uint32_t>::max()};
+    this->component_of_.assign(num_triangles, kUnvisited);
+    this->inconsistent_with_parent_.assign(num_triangles, 0);
+    std::size_t num_visited{0};
+
+    // Seeds in ascending order, BFS in neighbor slot order -> same components, same order and same
+    // BFS trees as `find_connected_components` and `reorient_inconsistent_triangles`
+    for (std::size_t seed = 0; seed < num_triangles; ++seed) {
+        if (this->component_of_[seed] != kUnvisited) {
+            continue;
+        }
+        const auto label{static_cast<std::uint32_t>(this->components_.size())};
+        ConnectedComponent component;
+        bool closed{true};
+
+        const Triangle& root{triangles[seed]};
+        AxisAlignedBoundingBox box{
+            root.a[0], root.a[1], root.a[2], root.a[0], root.a[1], root.a[2]
+        };
+
+        // The component list doubles as the FIFO queue: triangles are appended when reached and
+        // visited in list order
+        this->component_of_[seed] = label;
+        component.push_back(static_cast<TriangleIndex>(seed));
+        for (std::size_t head = 0; head < component.size(); ++head) {
+            checkpoint(control, AnalysisStage::kComponents, num_visited++, num_triangles);
+            const auto triangle_index{static_cast<std::size_t>(component[head])};
+            const Triangle& triangle{triangles[triangle_index]};
+            const std::array<const Point*, 3> corners{&triangle.a, &triangle.b, &triangle.c};
+
+            for (const Point* corner : corners) {
+                box.min_x = std::min(box.min_x, (*corner)[0]);
+                box.min_y = std::min(box.min_y, (*corner)[1]);
+                box.min_z = std::min(box.min_z, (*corner)[2]);
+                box.max_x = std::max(box.max_x, (*corner)[0]);
+                box.max_y = std::max(box.max_y, (*corner)[1]);
+                box.max_z = std::max(box.max_z, (*corner)[2]);
+            }
+
+            for (std::size_t local_edge = 0; local_edge < 3; ++local_edge) {
+                const TriangleIndex neighbor{neighbors[triangle_index][local_edge]};
+
+                // Boundary edge -> component is open
+                if (neighbor == kBoundaryTriangleIndex) {
+                    closed = false;
+                    continue;
+                }
+                const auto neighbor_index{static_cast<std::size_t>(neighbor)};
+                if (this->component_of_[neighbor_index] != kUnvisited) {
+                    continue;
+                }
+
+                // The triangle traverses the shared edge from -> to; a consistently oriented
+                // neighbor traverses it to -> from (same result as `are_orientations_consistent`)
+                const Point& from{*corners[local_edge]};
+                const Point& to{*corners[(local_edge + 1) % 3]};
+                if (has_directed_edge(triangles[neighbor_index], from, to)) {
+                    this->inconsistent_with_parent_[neighbor_index] = 1;
+                }
+                this->component_of_[neighbor_index] = label;
+                component.push_back(neighbor);
+            }
+        }
+
+        // Same padding as the default of `compute_component_aabb`
+        box.min_x -= kEpsilon;
+        box.min_y -= kEpsilon;
+        box.min_z -= kEpsilon;
+        box.max_x += kEpsilon;
+        box.max_y += kEpsilon;
+        box.max_z += kEpsilon;
+
+        this->components_.push_back(std::move(component));
+        this->closed_.push_back(closed ? 1 : 0);
+        this->aabbs_.push_back(box);
+    }
+    checkpoint(control, AnalysisStage::kComponents, num_triangles, num_triangles);
+
+    record_stats(stats, [this](PipelineStats& s) {
+        s.num_components += this->components_.size();
+        s.num_closed_components += static_cast<std::size_t>(
+            std::count(this->closed_.begin(), this->closed_.end(), 1)
+        );
+    });
+}
+
+std::vector<ConnectedComponent> MeshAnalysis::GetClosedComponents() const {
+    std::vector<ConnectedComponent> closed_components;
+    for (std::size_t k = 0; k < this->components_.size(); ++k) {
+        if (this->IsClosed(k)) {
+            closed_components.push_back(this->components_[k]);
+        }
+    }
+    return closed_components;
+}
+
+std::vector<Triangle> MeshAnalysis::GetInconsistentTriangles(std::size_t seed) const {
+    const auto& triangles{this->mesh_->GetTriangles()};
+    if (seed >= triangles.size()) {
+        return {};  // seed is out of range -> no triangles to reorient
+    }
+
+    // Only the component roots share the BFS tree of the analysis traversal
+    const ConnectedComponent& component{this->components_[this->component_of_[seed]]};
+    if (static_cast<std::size_t>(component.front()) != seed) {
+        return reorient_inconsistent_triangles(*this->mesh_, seed);
+    }
+
+    std::vector<Triangle> flipped_triangles;
+    for (const TriangleIndex index : component) {
+        const auto triangle_index{static_cast<std::size_t>(index)};
+        if (this->inconsistent_with_parent_[triangle_index] != 0) {
+            Triangle to_be_flipped{triangles[triangle_index]};
+            flip_triangle(to_be_flipped);
+            flipped_triangles.push_back(to_be_flipped);
+        }
+    }
+    return flipped_triangles;
+}
+
+namespace {
+
+/**
+ * @brief Views and AABBs of the closed components of an analysis
+ */
+struct ClosedComponentViews {
+    std::vector<ComponentView> views;           ///< triangles of every closed component
+    std::vector<AxisAlignedBoundingBox> aabbs;  ///< padded AABB of every closed component
+};
+
+/**
+ * @brief Selects the closed components of an analysis, as views into its components
+ *
+ * @param analysis Analysis of the mesh
+ * @return The closed components, in component order
+ */
+ClosedComponentViews select_closed_components(const MeshAnalysis& analysis) {
+    ClosedComponentViews closed;
+    for (std::size_t k = 0; k < analysis.GetComponents().size(); ++k) {
+        if (analysis.IsClosed(k)) {
+            closed.views.push_back(analysis.GetComponents()[k]);
+            closed.aabbs.push_back(analysis.GetComponentAabbs()[k]);
+        }
+    }
+    return closed;
+}
+
+}  // namespace
+
+std::vector<ConnectedComponent> identify_voids(
+    const MeshAnalysis& analysis, VoidClassification classification, PipelineStats* stats,
+    const AnalysisControl* control
+) {
+    ClosedComponentViews closed{select_closed_components(analysis)};
+    std::vector<ConnectedComponent> voids;
+    for (const std::size_t i : identify_void_indices(
+             analysis.GetMesh(), closed.views, std::move(closed.aabbs), classification, stats,
+             control
+         )) {
+        voids.emplace_back(closed.views[i].begin(), closed.views[i].end());
+    }
+    return voids;
+}
+
+std::size_t export_voids_to_stl(
+    const MeshAnalysis& analysis, std::ostream& out, StlFormat format, PipelineStats* stats,
+    const AnalysisControl* control
+) {
+    // The voids are views into the analysis: no component is copied
+    ClosedComponentViews closed{select_closed_components(analysis)};
+    std::vector<ComponentView> voids;
+    for (const std::size_t i : identify_void_indices(
+             analysis.GetMesh(), closed.views, std::move(closed.aabbs),
+             VoidClassification::kAabbContainment, stats, control
+         )) {
+        voids.push_back(closed.views[i]);
+    }
+    write_voids_to_stl(analysis.GetMesh(), voids, out, format, stats, control);
+    return voids.size();
+}
+
+void export_inconsistent_triangles(
+    const MeshAnalysis& analysis, std::size_t seed, std::ostream& out, StlFormat format
+) {
+    write_reoriented_triangles(analysis.GetInconsistentTriangles(seed), out, format);
+}
+
+}  // namespace tsexam::problem1
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "analysis_control.hpp"
+#include "geometry.hpp"
+#include "pipeline_stats.hpp"
+#include "stl_io.hpp"
+#include "triangle_mesh.hpp"
+#include "void_detection.hpp"
+
+namespace tsexam::problem1 {
+
+/**
+ * @brief Component structure and orientation of a mesh, gathered in one traversal
+ *
+ * A single BFS per connected component over the neighbor table yields, at once, the components
+ * (identical to `find_connected_components`, in the same order), whether every component is
+ * closed, the AABB of every component and, for every triangle, whether its orientation disagrees
+ * with the triangle it was reached from. Both the void export and the reorientation export can
+ * then run from the analysis without traversing the mesh again.
+ *
+ * The analysis refers to the mesh it was built from, which must outlive it and must not be
+ * modified (e.g. by `TriangleMesh::FlipTriangle`) while the analysis is in use.
+ */
+class MeshAnalysis {
+public:
+    /**
+     * @brief Analyzes a mesh
+     *
+     * @param mesh Mesh to analyze
+     * @param stats Sink for the components time and component counts (may be null)
+     * @param control Stop token and progress callback checked per visited triangle (may be null)
+     *
+     * @throws AnalysisCancelled if the control requested a stop
+     */
+    explicit MeshAnalysis(
+        const TriangleMesh& mesh, PipelineStats* stats = nullptr,
+        const AnalysisControl* control = nullptr
+    );
+
+    /**
+     * @brief Returns the analyzed mesh
+     *
+     * @return Reference to the mesh
+     */
+    const TriangleMesh& GetMesh() const { return *mesh_; }
+
+    /**
+     * @brief Returns the connected components
+     *
+     * Every component lists its triangles in BFS order from its smallest triangle index, and the
+     * components are ordered by that index, exactly as `find_connected_components` returns them.
+     *
+     * @return Reference to the components
+     */
+    const std::vector<ConnectedComponent>& GetComponents() const { return components_; }
+
+    /**
+     * @brief Returns whether a component is closed (no boundary edge)
+     *
+     * @param component Index into `GetComponents()`
+     * @return true if every edge of the component is shared by two triangles
+     */
+    bool IsClosed(std::size_t component) const { return closed_[component] != 0; }
+
+    /**
+     * @brief Returns the closed components, in component order
+     *
+     * @return Copies of the closed components
+     */
+    std::vector<ConnectedComponent> GetClosedComponents() const;
+
+    /**
+     * @brief Returns the AABB of every component
+     *
+     * Entry k is the box of `GetComponents()[k]`, padded by `kEpsilon` like the default of
+     * `compute_component_aabb`.
+     *
+     * @return Reference to the component AABBs
+     */
+    const std::vector<AxisAlignedBoundingBox>& GetComponentAabbs() const { return aabbs_; }
+
+    /**
+     * @brief Returns the component a triangle belongs to
+     *
+     * @param triangle_index Index of the triangle
+     * @return Index into `GetComponents()`
+     */
+    std::size_t GetComponentOf(std::size_t triangle_index) const {
+        return component_of_[triangle_index];
+    }
+
+    /**
+     * @brief Returns the triangles that `reorient_inconsistent_triangles` would flip, flipped
+     *
+     * If the seed is the smallest triangle of its component (e.g. seed 0), the result is read from
+     * the orientation flags of the analysis traversal. Any other seed gets a BFS of its own with
+     * `reorient_inconsistent_triangles`. Either way the result is identical to
+     * `reorient_inconsistent_triangles(GetMesh(), seed)`.
+     *
+     * @param seed Index of the seed triangle
+     * @return Flipped copies of the inconsistent triangles, in BFS order (empty if the seed is out
+     *         of range)
+     */
+    std::vector<Triangle> GetInconsistentTriangles(std::size_t seed) const;
+
+private:
+    /// Analyzed mesh
+    const TriangleMesh* mesh_;
+
+    /// Connected components in `find_connected_components` order
+    std::vector<ConnectedComponent> components_;
+
+    /// Whether each component is closed
+    std::vector<unsigned char> closed_;
+
+    /// Padded AABB of each component
+    std::vector<AxisAlignedBoundingBox> aabbs_;
+
+    /// Component index of every triangle
+    std::vector<std::uint32_t> component_of_;
+
+    /// Whether every triangle's orientation disagrees with its BFS parent (0 for the roots)
+    std::vector<unsigned char> inconsistent_with_parent_;
+};
+
+/**
+ * @brief Identify the voids among the closed components of an analysis
+ *
+ * Equivalent to `identify_voids(analysis.GetMesh(), analysis.GetClosedComponents(),
+ * classification, stats)`, reusing the component AABBs of the analysis.
+ *
+ * @param analysis Analysis of the mesh
+ * @param classification Void classification mode
+ * @param stats Sink for the stage time, AABB test and point-in-solid query counts (may be null)
+ * @param control Stop token and progress callback checked per closed component (may be null)
+ * @return A list of voids
+ *
+ * @throws AnalysisCancelled if the control requested a stop
+ */
+std::vector<ConnectedComponent> identify_voids(
+    const MeshAnalysis& analysis,
+    VoidClassification classification = VoidClassification::kAabbContainment,
+    PipelineStats* stats = nullptr, const AnalysisControl* control = nullptr
+);
+
+/**
+ * @brief Export the voids of an analyzed mesh to an STL file
+ *
+ * Writes the same output as `export_voids_to_stl(analysis.GetMesh(), out, format)`.
+ *
+ * @param analysis Analysis of the mesh
+ * @param out The output stream (binary mode for `StlFormat::kBinary`)
+ * @param format STL encoding of the output
+ * @param stats Sink for the void detection and export timings and counters (may be null)
+ * @param control Stop token and progress callback of the void and export stages (may be null)
+ * @return Number of voids written
+ *
+ * @throws AnalysisCancelled if the control requested a stop; the output may then hold a partial
+ *         STL file
+ */
+std::size_t export_voids_to_stl(
+    const MeshAnalysis& analysis, std::ostream& out, StlFormat format = StlFormat::kAscii,
+    PipelineStats* stats = nullptr, const AnalysisControl* control = nullptr
+);
+
+/**
+ * @brief Exports the triangles of an analyzed mesh with inconsistent orientations
+ *
+ * Writes the same output as `export_inconsistent_triangles(analysis.GetMesh(), seed, out,
+ * format)`.
+ *
+ * @param analysis Analysis of the mesh
+ * @param seed Index of the seed triangle
+ * @param out Output stream to write the exported triangles to
+ * @param format STL encoding of the output
+ */
+void export_inconsistent_triangles(
+    const MeshAnalysis& analysis, std::size_t seed, std::ostream& out,
+    StlFormat format = StlFormat::kAscii
+);
+
+}  // namespace tsexam::problem1
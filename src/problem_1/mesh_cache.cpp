@@ -0,0 +1,380 @@
+#include "mesh_cache.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "mapped_file.hpp"
+#include "stl_io.hpp"
+#include "void_detection.hpp"
+
+namespace tsexam::problem1 {
+
+/**
+ * @brief Grants the cache reader and loader access to the mesh internals
+ */
+class MeshCacheAccess {
+public:
+    /**
+     * @brief Creates a neighbor table mesh from restored cache sections
+     *
+     * @param triangles Triangles of the mesh
+     * @param neighbors Neighbor table of the triangles
+     * @param components Connected components of the mesh
+     * @return Mesh holding the given data as is
+     */
+    static TriangleMesh Restore(
+        std::vector<Triangle> triangles, std::vector<std::array<TriangleIndex, 3>> neighbors,
+        std::vector<ConnectedComponent> components
+    ) {
+        TriangleMesh mesh;
+        mesh.triangles_ = std::move(triangles);
+        mesh.connectivity_engine_ = ConnectivityEngine::kNeighborTable;
+        mesh.triangle_neighbors_ = std::move(neighbors);
+        mesh.cached_components_ = std::move(components);
+        return mesh;
+    }
+
+    /**
+     * @brief Attaches the connected components to a mesh
+     *
+     * @param mesh Mesh the components were computed from
+     * @param components Connected components of the mesh
+     */
+    static void SetCachedComponents(
+        TriangleMesh& mesh, std::vector<ConnectedComponent> components
+    ) {
+        mesh.cached_components_ = std::move(components);
+    }
+};
+
+namespace {
+
+/// File magic of the connectivity cache
+constexpr std::array<char, 8> kMagic{'T', 'S', 'X', 'M', 'E', 'S', 'H', '\0'};
+
+/// Written as a native `uint32`; reads back differently on a machine of the other byte order
+constexpr std::uint32_t kByteOrderTag{0x01020304u};
+
+/// Fixed-size header at the start of the cache file
+struct MeshCacheHeader {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t content_hash;
+    std::uint64_t source_size;
+    std::uint64_t num_triangles;
+    std::uint64_t num_components;
+};
+
+static_assert(sizeof(MeshCacheHeader) == 48, "cache header must have no padding");
+static_assert(std::is_trivially_copyable_v<Triangle> && sizeof(Triangle) == 9 * sizeof(double));
+static_assert(sizeof(std::array<TriangleIndex, 3>) == 3 * sizeof(TriangleIndex));
+
+/// Mixes the bits of a 64-bit value (MurmurHash3 finalizer)
+constexpr std::uint64_t mix64(std::uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdull;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ull;
+    value ^= value >> 33;
+    return value;
+}
+
+/// Byte size of the cache sections following the header
+std::uint64_t payload_size(std::uint64_t num_triangles, std::uint64_t num_components) {
+    return num_triangles * sizeof(Triangle) + (num_components + 1) * sizeof(std::uint64_t) +
+           num_triangles * sizeof(std::array<TriangleIndex, 3>) +
+           num_triangles * sizeof(TriangleIndex);
+}
+
+/**
+ * @brief Copies a section of the mapped cache into a vector
+ *
+ * @param bytes Mapped cache file
+ * @param offset Byte offset of the section, advanced past it
+ * @param count Number of elements
+ * @return Section elements
+ */
+template <typename T>
+std::vector<T> read_section(std::string_view bytes, std::size_t& offset, std::size_t count) {
+    std::vector<T> section(count);
+    std::memcpy(section.data(), bytes.data() + offset, count * sizeof(T));
+    offset += count * sizeof(T);
+    return section;
+}
+
+/**
+ * @brief Writes a contiguous array to a binary stream
+ *
+ * @param out Output stream
+ * @param data Array elements
+ */
+template <typename T>
+void write_section(std::ostream& out, const std::vector<T>& data) {
+    out.write(
+        reinterpret_cast<const char*>(data.data()),
+        static_cast<std::streamsize>(data.size() * sizeof(T))
+    );
+}
+
+/**
+ * @brief Writes the cache file of a mesh with already computed components
+ *
+ * @param cache_path Path of the cache file to write
+ * @param mesh Mesh whose connectivity to store
+ * @param components Connected components of the mesh
+ * @param key Key of the STL content the mesh was loaded from
+ *
+ * @throws std::runtime_error if the file cannot be written
+ */
+void write_cache_file(
+    const std::string& cache_path, const TriangleMesh& mesh,
+    const std::vector<ConnectedComponent>& components, const MeshCacheKey& key
+) {
+    const std::vector<Triangle>& triangles{mesh.GetTriangles()};
+    const auto& neighbors{mesh.GetTriangleNeighbors()};
+    if (neighbors.size() != triangles.size()) {
+        throw std::runtime_error("cannot cache a mesh without a neighbor table");
+    }
+
+    // Components as CSR: offsets into the concatenated triangle lists
+    std::vector<std::uint64_t> offsets;
+    offsets.reserve(components.size() + 1);
+    offsets.push_back(0);
+    std::vector<TriangleIndex> members;
+    members.reserve(triangles.size());
+    for (const ConnectedComponent& component : components) {
+        members.insert(members.end(), component.begin(), component.end());
+        offsets.push_back(members.size());
+    }
+
+    const MeshCacheHeader header{
+        kMagic,          kMeshCacheVersion, kByteOrderTag,     key.content_hash,
+        key.source_size, triangles.size(),  components.size(),
+    };
+
+    // Write under a temporary name and rename, so that a reader never maps a partial file
+    const std::string temporary_path{cache_path + ".tmp"};
+    {
+        std::ofstream out(temporary_path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("failed to open cache file for writing: " + temporary_path);
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        write_section(out, triangles);
+        write_section(out, offsets);
+        write_section(out, neighbors);
+        write_section(out, members);
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("failed to write cache file: " + temporary_path);
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary_path, cache_path, error);
+    if (error) {
+        std::filesystem::remove(temporary_path, error);
+        throw std::runtime_error("failed to move cache file into place: " + cache_path);
+    }
+}
+
+}  // namespace
+
+std::uint64_t hash_stl_content(std::string_view bytes) {
+    constexpr std::uint64_t kMultiplier{0x9e3779b97f4a7c15ull};
+
+    // Word at a time: mix every 64-bit word into the running state
+    std::uint64_t hash{mix64(bytes.size() ^ kMultiplier)};
+    std::size_t offset{0};
+    for (; offset + sizeof(std::uint64_t) <= bytes.size(); offset += sizeof(std::uint64_t)) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes.data() + offset, sizeof(word));
+        hash = (hash ^ mix64(word)) * kMultiplier;
+    }
+
+    // Remaining 0-7 bytes as one zero-padded word
+    if (offset < bytes.size()) {
+        std::uint64_t word{0};
+        std::memcpy(&word, bytes.data() + offset, bytes.size() - offset);
+        hash = (hash ^ mix64(word)) * kMultiplier;
+    }
+    return mix64(hash);
+}
+
+MeshCacheKey make_mesh_cache_key(std::string_view bytes) {
+    return {hash_stl_content(bytes), bytes.size()};
+}
+
+std::string default_mesh_cache_path(const std::string& stl_path) { return stl_path + ".tscache"; }
+
+void write_mesh_cache(
+    const std::string& cache_path, const TriangleMesh& mesh, const MeshCacheKey& key,
+    PipelineStats* stats
+) {
+    const std::vector<ConnectedComponent> components{find_connected_components(mesh)};
+    const ScopedStageTimer timer(stats, &PipelineStats::cache_time);
+    write_cache_file(cache_path, mesh, components, key);
+}
+
+std::optional<TriangleMesh> read_mesh_cache(
+    const std::string& cache_path, const MeshCacheKey& key, PipelineStats* stats
+) {
+    const ScopedStageTimer timer(stats, &PipelineStats::cache_time);
+
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(cache_path, error)) {
+        return std::nullopt;
+    }
+    std::optional<MappedFile> file;
+    try {
+        file.emplace(cache_path);
+    } catch (const std::runtime_error&) {
+        return std::nullopt;
+    }
+    const std::string_view bytes{file->GetData()};
+
+    //----------------------------------------------
+    // Header: format, version and content key
+    //----------------------------------------------
+
+    MeshCacheHeader header{};
+    if (bytes.size() < sizeof(header)) {
+        return std::nullopt;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (header.magic != kMagic || header.version != kMeshCacheVersion ||
+        header.byte_order != kByteOrderTag ||
+        MeshCacheKey{header.content_hash, header.source_size} != key) {
+        return std::nullopt;
+    }
+
+    // Bounding the counts first keeps the size arithmetic below free of overflow
+    constexpr auto kMaxTriangles{
+        static_cast<std::uint64_t>(std::numeric_limits<TriangleIndex>::max())
+    };
+    if (header.num_triangles == 0 || header.num_triangles > kMaxTriangles ||
+        header.num_components > header.num_triangles) {
+        return std::nullopt;
+    }
+    if (bytes.size() !=
+        sizeof(header) + payload_size(header.num_triangles, header.num_components)) {
+        return std::nullopt;
+    }
+    const auto num_triangles{static_cast<std::size_t>(header.num_triangles)};
+    const auto num_components{static_cast<std::size_t>(header.num_components)};
+
+    //----------------------------------------------
+    // Sections, checked for consistency so that a corrupt cache cannot cause out-of-range reads
+    //----------------------------------------------
+
+    const auto triangle_index_in_range = [num_triangles](TriangleIndex index) {
+        return index >= 0 && static_cast<std::size_t>(index) < num_triangles;
+    };
+
+    std::size_t offset{sizeof(header)};
+    std::vector<Triangle> triangles{read_section<Triangle>(bytes, offset, num_triangles)};
+    const std::vector<std::uint64_t> component_offsets{
+        read_section<std::uint64_t>(bytes, offset, num_components + 1)
+    };
+    std::vector<std::array<TriangleIndex, 3>> neighbors{
+        read_section<std::array<TriangleIndex, 3>>(bytes, offset, num_triangles)
+    };
+    const std::vector<TriangleIndex> members{
+        read_section<TriangleIndex>(bytes, offset, num_triangles)
+    };
+
+    for (const auto& triangle_neighbors : neighbors) {
+        for (const TriangleIndex neighbor : triangle_neighbors) {
+            if (neighbor != kBoundaryTriangleIndex && !triangle_index_in_range(neighbor)) {
+                return std::nullopt;
+            }
+        }
+    }
+    if (component_offsets.front() != 0 || component_offsets.back() != num_triangles) {
+        return std::nullopt;
+    }
+
+    std::vector<ConnectedComponent> components(num_components);
+    for (std::size_t k = 0; k < num_components; ++k) {
+        const std::uint64_t begin{component_offsets[k]};
+        const std::uint64_t end{component_offsets[k + 1]};
+        if (begin >= end || end > num_triangles) {
+            return std::nullopt;
+        }
+        components[k].assign(
+            members.begin() + static_cast<std::ptrdiff_t>(begin),
+            members.begin() + static_cast<std::ptrdiff_t>(end)
+        );
+        for (const TriangleIndex member : components[k]) {
+            if (!triangle_index_in_range(member)) {
+                return std::nullopt;
+            }
+        }
+    }
+
+    return MeshCacheAccess::Restore(
+        std::move(triangles), std::move(neighbors), std::move(components)
+    );
+}
+
+TriangleMesh load_mesh_with_cache(
+    const std::string& stl_path, const TriangleMeshOptions& options, const std::string& cache_path
+) {
+    const std::string resolved_cache_path{
+        cache_path.empty() ? default_mesh_cache_path(stl_path) : cache_path
+    };
+
+    const MappedFile file(stl_path);
+    const std::string_view bytes{file.GetData()};
+    MeshCacheKey key;
+    {
+        const ScopedStageTimer timer(options.stats, &PipelineStats::cache_time);
+        key = make_mesh_cache_key(bytes);
+    }
+
+    if (std::optional<TriangleMesh> cached{
+            read_mesh_cache(resolved_cache_path, key, options.stats)
+        }) {
+        record_stats(options.stats, [](PipelineStats& s) { ++s.cache_hits; });
+        return std::move(*cached);
+    }
+    record_stats(options.stats, [](PipelineStats& s) { ++s.cache_misses; });
+
+    // Cache miss -> parse the mapped bytes and build the mesh as `FromMappedFile` does
+    std::vector<Triangle> triangles;
+    {
+        const ScopedStageTimer timer(options.stats, &PipelineStats::parse_time);
+        triangles = (detect_stl_format(bytes) == StlFormat::kBinary)
+                        ? parse_binary_stl(bytes)
+                        : parse_ascii_stl(bytes, options.num_threads);
+        record_stats(options.stats, [&](PipelineStats& s) {
+            s.bytes_parsed += bytes.size();
+            s.triangles_parsed += triangles.size();
+        });
+    }
+    TriangleMesh mesh(std::move(triangles), options);
+
+    std::vector<ConnectedComponent> components{
+        find_connected_components(mesh, options.num_threads)
+    };
+    try {
+        const ScopedStageTimer timer(options.stats, &PipelineStats::cache_time);
+        write_cache_file(resolved_cache_path, mesh, components, key);
+    } catch (const std::runtime_error&) {
+        // The cache only speeds up the next load; an unwritable location must not fail this one
+    }
+    MeshCacheAccess::SetCachedComponents(mesh, std::move(components));
+    return mesh;
+}
+
+}  // namespace tsexam::problem1
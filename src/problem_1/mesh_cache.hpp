@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "triangle_mesh.hpp"
+
+namespace tsexam::problem1 {
+
+/// Version of the connectivity cache layout; caches of any other version are ignored
+constexpr std::uint32_t kMeshCacheVersion{1};
+
+/**
+ * @brief Identifies the STL content a connectivity cache was built from
+ */
+struct MeshCacheKey {
+    std::uint64_t content_hash{0};  ///< `hash_stl_content` of the STL bytes
+    std::uint64_t source_size{0};   ///< size of the STL file in bytes
+
+    bool operator==(const MeshCacheKey&) const = default;
+};
+
+/**
+ * @brief Hashes the raw bytes of an STL file
+ *
+ * A fast 64-bit non-cryptographic hash. It reads the bytes as native-endian 64-bit words, so
+ * values are only comparable on machines of the same byte order, which is also what the cache
+ * files require.
+ *
+ * @param bytes STL file content
+ * @return 64-bit hash
+ */
+std::uint64_t hash_stl_content(std::string_view bytes);
+
+/**
+ * @brief Computes the cache key of an STL file's content
+ *
+ * @param bytes STL file content
+ * @return Hash and size of the content
+ */
+MeshCacheKey make_mesh_cache_key(std::string_view bytes);
+
+/**
+ * @brief Returns the default cache path of an STL file: the STL path with ".tscache" appended
+ *
+ * @param stl_path Path to the STL file
+ * @return Path of the sidecar cache file
+ */
+std::string default_mesh_cache_path(const std::string& stl_path);
+
+/**
+ * @brief Writes the connectivity cache of a mesh
+ *
+ * The cache is a flat binary file laid out for memory mapping, every section naturally aligned:
+ *
+ * | offset         | content                                                              |
+ * |----------------|----------------------------------------------------------------------|
+ * | 0              | magic "TSXMESH\0" (8 bytes)                                          |
+ * | 8              | `uint32` layout version (`kMeshCacheVersion`), `uint32` byte order tag |
+ * | 16             | `uint64` content hash, `uint64` source size (`MeshCacheKey`)         |
+ * | 32             | `uint64` number of triangles n, `uint64` number of components m      |
+ * | 48             | n triangles (9 `double` each)                                        |
+ * | 48 + 72n       | m + 1 component offsets (`uint64`)                                   |
+ * | ...            | n neighbor triples (3 `int32` each)                                  |
+ * | ...            | n triangle indices of the components in order (`int32`)              |
+ *
+ * The components are those of `find_connected_components(mesh)`, stored as offsets into the
+ * concatenated triangle lists; they double as the component label of every triangle. The file is
+ * written under a temporary name and renamed into place, so readers never see a partial cache.
+ *
+ * @param cache_path Path of the cache file to write
+ * @param mesh Mesh whose connectivity to store
+ * @param key Key of the STL content the mesh was loaded from
+ * @param stats Sink for the cache time (may be null)
+ *
+ * @throws std::runtime_error if the file cannot be written
+ */
+void write_mesh_cache(
+    const std::string& cache_path, const TriangleMesh& mesh, const MeshCacheKey& key,
+    PipelineStats* stats = nullptr
+);
+
+/**
+ * @brief Restores a mesh from its connectivity cache
+ *
+ * The cache is memory-mapped and its sections are copied straight into the mesh: no parsing,
+ * validation or connectivity build takes place. The restored mesh uses
+ * `ConnectivityEngine::kNeighborTable` and carries the cached components (see
+ * `TriangleMesh::GetCachedComponents`).
+ *
+ * @param cache_path Path of the cache file
+ * @param key Key of the current STL content
+ * @param stats Sink for the cache time (may be null)
+ * @return Restored mesh, or nothing if the cache is missing, was built from other content, has a
+ *         different version or byte order, or is truncated or inconsistent
+ */
+std::optional<TriangleMesh> read_mesh_cache(
+    const std::string& cache_path, const MeshCacheKey& key, PipelineStats* stats = nullptr
+);
+
+/**
+ * @brief Loads an STL file through its connectivity cache
+ *
+ * The STL file is memory-mapped and hashed. If the cache holds the connectivity of exactly this
+ * content, the mesh is restored from it (see `read_mesh_cache`). Otherwise the mesh is parsed and
+ * built with `options` as in `TriangleMesh::FromMappedFile`, and the cache is (re)written; a cache
+ * that cannot be written is skipped. Either way the returned mesh carries its connected
+ * components, so `find_connected_components` does not traverse it again.
+ *
+ * @param stl_path Path to an ASCII or binary STL file
+ * @param options Load options (the connectivity engine applies to rebuilt meshes only)
+ * @param cache_path Path of the cache file (empty: `default_mesh_cache_path(stl_path)`)
+ * @return Loaded mesh
+ *
+ * @throws std::runtime_error if the STL file cannot be mapped or a binary file is truncated
+ * @throws std::invalid_argument if the mesh is invalid
+ */
+TriangleMesh load_mesh_with_cache(
+    const std::string& stl_path, const TriangleMeshOptions& options = {},
+    const std::string& cache_path = {}
+);
+
+}  // namespace tsexam::problem1
@@ -0,0 +1,277 @@
+#include "mesh_editor.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+namespace tsexam::problem1 {
+
+MeshEditor::MeshEditor(TriangleMesh& mesh) : mesh_{&mesh} {
+    if (mesh.GetConnectivityEngine() != ConnectivityEngine::kEdgeHashMap) {
+        throw std::logic_error("mesh edits require the kEdgeHashMap connectivity engine");
+    }
+    const std::size_t num_triangles{mesh.GetTriangles().size()};
+    this->label_of_.resize(num_triangles);
+    this->slot_of_.resize(num_triangles);
+    this->visit_epoch_.assign(num_triangles, 0);
+    this->visited_by_.assign(num_triangles, 0);
+
+    // Component k of the initial traversal gets label k
+    for (ConnectedComponent& component : find_connected_components(mesh)) {
+        const auto label{static_cast<std::uint32_t>(this->members_.size())};
+        for (std::size_t slot = 0; slot < component.size(); ++slot) {
+            const auto triangle{static_cast<std::size_t>(component[slot])};
+            this->label_of_[triangle] = label;
+            this->slot_of_[triangle] = static_cast<std::uint32_t>(slot);
+        }
+        this->members_.push_back(std::move(component));
+    }
+}
+
+TriangleIndex MeshEditor::InsertTriangle(const Triangle& triangle) {
+    // The mesh validates first and stays unchanged if it throws -> so do the labels
+    const TriangleIndex inserted{this->mesh_->InsertTriangle(triangle)};
+    const std::array<TriangleIndex, 3> neighbors{
+        this->mesh_->GetTriangleNeighbors()[static_cast<std::size_t>(inserted)]
+    };
+
+    // The largest adjacent component survives; an isolated triangle starts a new one
+    constexpr std::uint32_t kNoLabel{~std::uint32_t{0}};
+    std::uint32_t target{kNoLabel};
+    for (const TriangleIndex neighbor : neighbors) {
+        if (neighbor == kBoundaryTriangleIndex) {
+            continue;
+        }
+        const std::uint32_t label{this->label_of_[static_cast<std::size_t>(neighbor)]};
+        if (target == kNoLabel || this->members_[label].size() > this->members_[target].size()) {
+            target = label;
+        }
+    }
+    if (target == kNoLabel) {
+        target = this->NewLabel();
+    }
+
+    this->label_of_.push_back(target);
+    this->slot_of_.push_back(0);
+    this->visit_epoch_.push_back(0);
+    this->visited_by_.push_back(0);
+    this->AddToComponent(static_cast<std::size_t>(inserted), target);
+
+    for (const TriangleIndex neighbor : neighbors) {
+        if (neighbor == kBoundaryTriangleIndex) {
+            continue;
+        }
+        const std::uint32_t label{this->label_of_[static_cast<std::size_t>(neighbor)]};
+        if (label != target) {
+            this->MergeComponents(label, target);
+        }
+    }
+    return inserted;
+}
+
+void MeshEditor::RemoveTriangle(std::size_t triangle_index) {
+    const auto& table{this->mesh_->GetTriangleNeighbors()};
+    const std::array<TriangleIndex, 3> neighbors{
+        (triangle_index < table.size())
+            ? table[triangle_index]
+            : std::array<TriangleIndex, 3>{
+                  kBoundaryTriangleIndex, kBoundaryTriangleIndex, kBoundaryTriangleIndex
+              }
+    };
+    this->mesh_->RemoveTriangle(triangle_index);  // throws before any change
+
+    //----------------------------------------------
+    // Mirror the move of the last triangle into the freed index
+    //----------------------------------------------
+
+    const std::uint32_t label{this->label_of_[triangle_index]};
+    this->RemoveFromComponent(triangle_index);
+    const std::size_t last{this->label_of_.size() - 1};
+    if (triangle_index != last) {
+        this->label_of_[triangle_index] = this->label_of_[last];
+        this->slot_of_[triangle_index] = this->slot_of_[last];
+        const std::uint32_t moved_label{this->label_of_[triangle_index]};
+        this->members_[moved_label][this->slot_of_[triangle_index]] =
+            static_cast<TriangleIndex>(triangle_index);
+    }
+    this->label_of_.pop_back();
+    this->slot_of_.pop_back();
+    this->visit_epoch_.pop_back();
+    this->visited_by_.pop_back();
+
+    //----------------------------------------------
+    // Split check from the distinct former neighbors
+    //----------------------------------------------
+
+    std::array<TriangleIndex, 3> seeds{};
+    std::size_t num_seeds{0};
+    for (TriangleIndex neighbor : neighbors) {
+        if (neighbor == kBoundaryTriangleIndex) {
+            continue;
+        }
+        if (static_cast<std::size_t>(neighbor) == last) {
+            neighbor = static_cast<TriangleIndex>(triangle_index);  // it was moved
+        }
+        const auto seeds_end{seeds.begin() + static_cast<std::ptrdiff_t>(num_seeds)};
+        if (std::find(seeds.begin(), seeds_end, neighbor) == seeds_end) {
+            seeds[num_seeds++] = neighbor;
+        }
+    }
+
+    if (num_seeds == 0) {
+        // Isolated triangle -> its component is gone
+        std::vector<TriangleIndex>().swap(this->members_[label]);
+        this->free_labels_.push_back(label);
+        return;
+    }
+    if (num_seeds > 1) {
+        this->SplitComponent(std::span<const TriangleIndex>(seeds.data(), num_seeds));
+    }
+}
+
+void MeshEditor::FlipTriangle(std::size_t triangle_index) {
+    this->mesh_->FlipTriangle(triangle_index);
+}
+
+std::vector<ConnectedComponent> MeshEditor::GetComponents() const {
+    std::vector<ConnectedComponent> components;
+    components.reserve(this->GetComponentCount());
+    for (const std::vector<TriangleIndex>& members : this->members_) {
+        if (!members.empty()) {
+            components.emplace_back(members.begin(), members.end());
+            std::sort(components.back().begin(), components.back().end());
+        }
+    }
+    std::sort(components.begin(), components.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.front() < rhs.front();
+    });
+    return components;
+}
+
+std::uint32_t MeshEditor::NewLabel() {
+    if (!this->free_labels_.empty()) {
+        const std::uint32_t label{this->free_labels_.back()};
+        this->free_labels_.pop_back();
+        return label;
+    }
+    this->members_.emplace_back();
+    return static_cast<std::uint32_t>(this->members_.size() - 1);
+}
+
+void MeshEditor::AddToComponent(std::size_t triangle_index, std::uint32_t label) {
+    std::vector<TriangleIndex>& members{this->members_[label]};
+    this->label_of_[triangle_index] = label;
+    this->slot_of_[triangle_index] = static_cast<std::uint32_t>(members.size());
+    members.push_back(static_cast<TriangleIndex>(triangle_index));
+}
+
+void MeshEditor::RemoveFromComponent(std::size_t triangle_index) {
+    // Swap with the last triangle of the list so that the removal is O(1)
+    std::vector<TriangleIndex>& members{this->members_[this->label_of_[triangle_index]]};
+    const std::uint32_t slot{this->slot_of_[triangle_index]};
+    const TriangleIndex back{members.back()};
+    members[slot] = back;
+    this->slot_of_[static_cast<std::size_t>(back)] = slot;
+    members.pop_back();
+}
+
+void MeshEditor::MergeComponents(std::uint32_t from, std::uint32_t into) {
+    std::vector<TriangleIndex> moved;
+    moved.swap(this->members_[from]);
+    for (const TriangleIndex triangle : moved) {
+        this->AddToComponent(static_cast<std::size_t>(triangle), into);
+    }
+    this->free_labels_.push_back(from);
+}
+
+void MeshEditor::SplitComponent(std::span<const TriangleIndex> seeds) {
+    const auto& neighbors{this->mesh_->GetTriangleNeighbors()};
+    const std::size_t num_searches{seeds.size()};
+
+    // Fresh stamp for this search; on wrap-around the stale stamps are cleared once
+    if (++this->search_epoch_ == 0) {
+        std::fill(this->visit_epoch_.begin(), this->visit_epoch_.end(), 0);
+        this->search_epoch_ = 1;
+    }
+
+    // Searches that met are merged into groups (tiny union-find over at most 3 searches)
+    std::array<std::size_t, 3> group{0, 1, 2};
+    std::array<bool, 3> separated{false, false, false};
+    auto find_group = [&group](std::size_t search) {
+        while (group[search] != search) {
+            search = group[search];
+        }
+        return search;
+    };
+
+    std::array<std::size_t, 3> heads{0, 0, 0};
+    for (std::size_t s = 0; s < num_searches; ++s) {
+        const auto seed{static_cast<std::size_t>(seeds[s])};
+        this->search_queues_[s].assign(1, seeds[s]);
+        this->visit_epoch_[seed] = this->search_epoch_;
+        this->visited_by_[seed] = static_cast<std::uint8_t>(s);
+    }
+
+    std::size_t num_groups{num_searches};
+    while (num_groups > 1) {
+        // One BFS step per search with triangles left
+        for (std::size_t s = 0; s < num_searches && num_groups > 1; ++s) {
+            std::vector<TriangleIndex>& queue{this->search_queues_[s]};
+            if (heads[s] == queue.size()) {
+                continue;
+            }
+            const auto current{static_cast<std::size_t>(queue[heads[s]++])};
+            for (const TriangleIndex neighbor : neighbors[current]) {
+                if (neighbor == kBoundaryTriangleIndex) {
+                    continue;
+                }
+                const auto index{static_cast<std::size_t>(neighbor)};
+                if (this->visit_epoch_[index] != this->search_epoch_) {
+                    this->visit_epoch_[index] = this->search_epoch_;
+                    this->visited_by_[index] = static_cast<std::uint8_t>(s);
+                    queue.push_back(neighbor);
+                    continue;
+                }
+                // Reached a triangle of another search -> both are in the same part
+                const std::size_t mine{find_group(s)};
+                const std::size_t theirs{find_group(this->visited_by_[index])};
+                if (mine != theirs) {
+                    group[theirs] = mine;
+                    --num_groups;
+                }
+            }
+        }
+
+        // A group whose searches all ran dry is a whole part of its own -> new label. The last
+        // group standing keeps the old label.
+        for (std::size_t g = 0; g < num_searches && num_groups > 1; ++g) {
+            if (find_group(g) != g || separated[g]) {
+                continue;
+            }
+            bool exhausted{true};
+            for (std::size_t s = 0; s < num_searches; ++s) {
+                if (find_group(s) == g && heads[s] != this->search_queues_[s].size()) {
+                    exhausted = false;
+                }
+            }
+            if (!exhausted) {
+                continue;
+            }
+            const std::uint32_t label{this->NewLabel()};
+            for (std::size_t s = 0; s < num_searches; ++s) {
+                if (find_group(s) != g) {
+                    continue;
+                }
+                for (const TriangleIndex triangle : this->search_queues_[s]) {
+                    this->RemoveFromComponent(static_cast<std::size_t>(triangle));
+                    this->AddToComponent(static_cast<std::size_t>(triangle), label);
+                }
+            }
+            separated[g] = true;
+            --num_groups;
+        }
+    }
+}
+
+}  // namespace tsexam::problem1
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "geometry.hpp"
+#include "triangle_mesh.hpp"
+#include "void_detection.hpp"
+
+namespace tsexam::problem1 {
+
+/**
+ * @brief Edits a mesh triangle by triangle and keeps its connected components up to date
+ *
+ * Insertions, removals and flips go through `TriangleMesh::InsertTriangle`, `RemoveTriangle` and
+ * `FlipTriangle`, which update the edge connectivity and the neighbor table locally. The editor
+ * additionally maintains a component label for every triangle, so repair loops can query the
+ * components after each edit without a traversal of the whole mesh:
+ *
+ * - An insertion joins the components of the triangles across its edges. The smaller components
+ *   are relabeled into the largest, so every triangle is relabeled O(log n) times overall.
+ * - A removal can split its component. The triangles that were adjacent to the removed one are
+ *   searched from in lockstep, one BFS per neighbor over the neighbor table. Searches that meet
+ *   are merged, and a group of searches that runs out of triangles is a separate component and is
+ *   relabeled. The search stops as soon as one group is left, so a removal costs about the number
+ *   of neighbors times the size of the smallest part it splits off, and a removal that does not
+ *   split stops once the searches meet, usually around a vertex fan.
+ * - A flip changes no adjacency, hence no label.
+ *
+ * Labels are stable ids (not dense indices) and are reused once their component is merged away.
+ * The mesh must be built with `ConnectivityEngine::kEdgeHashMap`, must outlive the editor and must
+ * only be edited through it.
+ */
+class MeshEditor {
+public:
+    /**
+     * @brief Labels the components of a mesh for editing
+     *
+     * @param mesh Mesh to edit
+     *
+     * @throws std::logic_error if the mesh was not built with `ConnectivityEngine::kEdgeHashMap`
+     */
+    explicit MeshEditor(TriangleMesh& mesh);
+
+    /**
+     * @brief Returns the edited mesh
+     *
+     * @return Reference to the mesh
+     */
+    const TriangleMesh& GetMesh() const { return *mesh_; }
+
+    /**
+     * @brief Inserts a triangle (see `TriangleMesh::InsertTriangle`)
+     *
+     * @param triangle Triangle to insert
+     * @return Index of the inserted triangle
+     *
+     * @throws std::invalid_argument if the triangle is degenerate or would create a non-manifold
+     *         edge; the mesh and the labels are then unchanged
+     */
+    TriangleIndex InsertTriangle(const Triangle& triangle);
+
+    /**
+     * @brief Removes a triangle (see `TriangleMesh::RemoveTriangle`)
+     *
+     * The last triangle moves into the freed index and keeps its label.
+     *
+     * @param triangle_index Index of the triangle to remove
+     *
+     * @throws std::invalid_argument if the index is out of range or the triangle is the last one
+     *         of the mesh; the mesh and the labels are then unchanged
+     */
+    void RemoveTriangle(std::size_t triangle_index);
+
+    /**
+     * @brief Flips the orientation of a triangle in place (see `TriangleMesh::FlipTriangle`)
+     *
+     * @param triangle_index Index of the triangle to flip
+     */
+    void FlipTriangle(std::size_t triangle_index);
+
+    /**
+     * @brief Returns the number of connected components
+     *
+     * @return Number of components
+     */
+    std::size_t GetComponentCount() const { return members_.size() - free_labels_.size(); }
+
+    /**
+     * @brief Returns the component label of a triangle
+     *
+     * Two triangles are connected if and only if they have the same label.
+     *
+     * @param triangle_index Index of the triangle
+     * @return Label of its component
+     */
+    std::uint32_t GetComponentOf(std::size_t triangle_index) const {
+        return label_of_[triangle_index];
+    }
+
+    /**
+     * @brief Returns the triangles of a component, in no particular order
+     *
+     * @param label Label of the component (see `GetComponentOf`)
+     * @return View of the triangle indices, invalidated by the next edit
+     */
+    std::span<const TriangleIndex> GetComponentTriangles(std::uint32_t label) const {
+        return members_[label];
+    }
+
+    /**
+     * @brief Returns the components in `find_connected_components` order
+     *
+     * Components are ordered by their smallest triangle index and list their triangles in
+     * ascending order (instead of BFS order). Costs O(n log n); the labels are the cheap query.
+     *
+     * @return Connected components
+     */
+    std::vector<ConnectedComponent> GetComponents() const;
+
+private:
+    /**
+     * @brief Returns an unused label with an empty triangle list
+     *
+     * @return Label
+     */
+    std::uint32_t NewLabel();
+
+    /**
+     * @brief Appends a triangle to the triangle list of a component and labels it
+     *
+     * @param triangle_index Index of the triangle (already labeled or the next new index)
+     * @param label Label of the component
+     */
+    void AddToComponent(std::size_t triangle_index, std::uint32_t label);
+
+    /**
+     * @brief Takes a triangle out of the triangle list of its component
+     *
+     * @param triangle_index Index of the triangle
+     */
+    void RemoveFromComponent(std::size_t triangle_index);
+
+    /**
+     * @brief Relabels the triangles of one component into another and frees its label
+     *
+     * @param from Label of the component to merge away
+     * @param into Label of the surviving component
+     */
+    void MergeComponents(std::uint32_t from, std::uint32_t into);
+
+    /**
+     * @brief Relabels the parts a component fell into after a removal
+     *
+     * @param seeds Former neighbors of the removed triangle (2 or 3 distinct triangles of the
+     *              component)
+     */
+    void SplitComponent(std::span<const TriangleIndex> seeds);
+
+    /// Edited mesh
+    TriangleMesh* mesh_;
+
+    /// Component label of every triangle
+    std::vector<std::uint32_t> label_of_;
+
+    /// Position of every triangle in the triangle list of its component
+    std::vector<std::uint32_t> slot_of_;
+
+    /// Triangles of every label (empty for free labels)
+    std::vector<std::vector<TriangleIndex>> members_;
+
+    /// Labels whose component was merged away, for reuse
+    std::vector<std::uint32_t> free_labels_;
+
+    /// Per-triangle search stamp of the split searches (`search_epoch_` when visited)
+    std::vector<std::uint32_t> visit_epoch_;
+
+    /// Split search that visited every triangle first (valid when the stamp is current)
+    std::vector<std::uint8_t> visited_by_;
+
+    /// Stamp of the current split search
+    std::uint32_t search_epoch_{0};
+
+    /// Visited triangles of every split search, reused across removals; each doubles as the FIFO
+    /// queue of its search
+    std::array<std::vector<TriangleIndex>, 3> search_queues_;
+};
+
+}  // namespace tsexam::problem1
@@ -0,0 +1,781 @@
+#include "out_of_core_analysis.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "disjoint_sets.hpp"
+#include "triangle_validation.hpp"
+
+namespace tsexam::problem1 {
+
+namespace {
+
+/// One canonical edge of a triangle, as written to the edge bucket files
+struct EdgeRecord {
+    Edge edge;                 ///< canonical edge
+    TriangleIndex triangle;    ///< triangle using the edge
+    std::uint32_t local_edge;  ///< local edge number of the edge in that triangle
+};
+
+/// One side of a shared edge, as written to the neighbor range files
+struct NeighborRecord {
+    TriangleIndex triangle;    ///< triangle
+    std::uint32_t local_edge;  ///< local edge number of the shared edge in `triangle`
+    TriangleIndex neighbor;    ///< triangle on the other side of the edge
+};
+
+/// Neighbor table row: the triangles across local edges 0, 1 and 2
+using NeighborRow = std::array<TriangleIndex, 3>;
+
+/// Largest number of bucket or range files written at once (keeps the open file count bounded)
+constexpr std::size_t kMaxScratchFiles{256};
+
+/// Deepest re-partitioning of an edge bucket; buckets still too large after it (only possible if
+/// distinct edges collide on their full hash) are matched in memory as they are
+constexpr std::size_t kMaxPartitionLevel{4};
+
+/// Smallest accepted memory budget
+constexpr std::size_t kMinMemoryBudget{std::size_t{1} << 12};
+
+/// Records staged per scratch file before they are handed to the stream
+constexpr std::size_t kWriteBufferRecords{1024};
+
+/**
+ * @brief Append-only scratch file of trivially copyable records in native byte order
+ */
+template <typename Record>
+class RecordWriter {
+public:
+    /**
+     * @brief Creates (or truncates) the file
+     *
+     * @param path Path of the file
+     *
+     * @throws std::runtime_error if the file cannot be created
+     */
+    explicit RecordWriter(std::filesystem::path path)
+        : path_(std::move(path)), out_(path_, std::ios::binary | std::ios::trunc) {
+        if (!this->out_) {
+            throw std::runtime_error("failed to create scratch file: " + this->path_.string());
+        }
+        this->buffer_.reserve(kWriteBufferRecords);
+    }
+
+    /// Appends one record
+    void Append(const Record& record) {
+        this->buffer_.push_back(record);
+        if (this->buffer_.size() == kWriteBufferRecords) {
+            this->Flush();
+        }
+    }
+
+    /**
+     * @brief Writes the staged records and closes the file
+     *
+     * @throws std::runtime_error if writing failed (e.g. the disk is full)
+     */
+    void Close() {
+        this->Flush();
+        this->out_.close();
+        if (!this->out_) {
+            throw std::runtime_error("failed to write scratch file: " + this->path_.string());
+        }
+    }
+
+private:
+    /// Hands the staged records to the stream
+    void Flush() {
+        this->out_.write(
+            reinterpret_cast<const char*>(this->buffer_.data()),
+            static_cast<std::streamsize>(this->buffer_.size() * sizeof(Record))
+        );
+        this->buffer_.clear();
+    }
+
+    /// Path of the file (error messages)
+    std::filesystem::path path_;
+
+    /// Output stream
+    std::ofstream out_;
+
+    /// Staged records
+    std::vector<Record> buffer_;
+};
+
+/**
+ * @brief Sequential reader of a scratch file written by `RecordWriter`
+ */
+template <typename Record>
+class RecordReader {
+public:
+    /**
+     * @brief Opens the file
+     *
+     * @param path Path of the file
+     *
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    explicit RecordReader(const std::filesystem::path& path) : in_(path, std::ios::binary) {
+        if (!this->in_) {
+            throw std::runtime_error("failed to open scratch file: " + path.string());
+        }
+    }
+
+    /**
+     * @brief Reads the next records
+     *
+     * @param records Replaced by the records read
+     * @param max_records Largest number of records to read
+     * @return Number of records read
+     */
+    std::size_t Read(std::vector<Record>& records, std::size_t max_records) {
+        records.resize(max_records);
+        this->in_.read(
+            reinterpret_cast<char*>(records.data()),
+            static_cast<std::streamsize>(max_records * sizeof(Record))
+        );
+        records.resize(static_cast<std::size_t>(this->in_.gcount()) / sizeof(Record));
+        return records.size();
+    }
+
+private:
+    /// Input stream
+    std::ifstream in_;
+};
+
+/**
+ * @brief Reads a whole scratch file and deletes it
+ *
+ * @param path Path of the file
+ * @return Records of the file
+ */
+template <typename Record>
+std::vector<Record> take_records(const std::filesystem::path& path) {
+    std::vector<Record> records;
+    {
+        RecordReader<Record> reader(path);
+        reader.Read(records, static_cast<std::size_t>(std::filesystem::file_size(path)) /
+                                 sizeof(Record));
+    }
+    std::filesystem::remove(path);
+    return records;
+}
+
+/**
+ * @brief Creates a uniquely named, empty scratch directory
+ *
+ * @param parent Directory to create it in (empty: the system temporary directory)
+ * @return Path of the new directory
+ *
+ * @throws std::runtime_error if no directory could be created
+ */
+std::filesystem::path create_scratch_directory(const std::string& parent) {
+    const std::filesystem::path base{
+        parent.empty() ? std::filesystem::temp_directory_path() : std::filesystem::path(parent)
+    };
+    std::random_device device;
+    std::mt19937_64 generator{(std::uint64_t{device()} << 32) ^ device()};
+    for (int attempt = 0; attempt < 16; ++attempt) {
+        const std::filesystem::path candidate{
+            base / ("tsexam_out_of_core_" + std::to_string(generator()))
+        };
+        if (std::filesystem::create_directory(candidate)) {
+            return candidate;
+        }
+    }
+    throw std::runtime_error("failed to create a scratch directory in " + base.string());
+}
+
+/**
+ * @brief Returns the bucket of an edge at a partition level
+ *
+ * The edge hash, offset by a multiple of a Fibonacci constant per level, goes through the
+ * SplitMix64 finalizer and its high bits are mapped onto the buckets. This spreads edges evenly
+ * even if the low bits of the hash are not well mixed, and the edges of one bucket over all the
+ * buckets of the next level.
+ *
+ * @param edge Canonical edge
+ * @param num_buckets Number of buckets
+ * @param level Partition level (0 for the first partition of the edges)
+ * @return Bucket index in [0, num_buckets)
+ */
+std::size_t bucket_of(const Edge& edge, std::size_t num_buckets, std::size_t level) {
+    std::uint64_t mixed{std::uint64_t{EdgeHash{}(edge)} + level * 0x9e3779b97f4a7c15ULL};
+    mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111ebULL;
+    mixed ^= mixed >> 31;
+    return static_cast<std::size_t>(((mixed >> 32) * num_buckets) >> 32);
+}
+
+/**
+ * @brief Total order that sorts the records of equal edges next to each other
+ *
+ * Coordinates are compared by their bit patterns after mapping -0 to +0, so edges that
+ * `EdgeEquality` considers equal are adjacent, and NaN coordinates cannot break the sort. Records
+ * of one edge stay in triangle order, which gives the same connectivity slots as the hash map
+ * engines.
+ */
+bool edge_record_less(const EdgeRecord& lhs, const EdgeRecord& rhs) {
+    const auto bits = [](const EdgeRecord& record) {
+        std::array<std::uint64_t, 6> key{};
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+            key[axis] = std::bit_cast<std::uint64_t>(record.edge.first[axis] + 0.);
+            key[3 + axis] = std::bit_cast<std::uint64_t>(record.edge.second[axis] + 0.);
+        }
+        return key;
+    };
+    const auto lhs_key{bits(lhs)};
+    const auto rhs_key{bits(rhs)};
+    if (lhs_key != rhs_key) {
+        return lhs_key < rhs_key;
+    }
+    return std::pair(lhs.triangle, lhs.local_edge) < std::pair(rhs.triangle, rhs.local_edge);
+}
+
+/// Number of parts of `count` items split into parts of `part_size`
+constexpr std::size_t divide_round_up(std::size_t count, std::size_t part_size) {
+    return (count + part_size - 1) / part_size;
+}
+
+/// Path of a numbered scratch file
+std::filesystem::path scratch_file(
+    const std::filesystem::path& directory, const char* prefix, std::size_t index
+) {
+    return directory / (prefix + std::to_string(index) + ".bin");
+}
+
+/**
+ * @brief Splits a scratch file into part files and deletes it
+ *
+ * The file is streamed in chunks, so at most `max_records` of its records are held at a time.
+ * Records keep their order within each part.
+ *
+ * @param path File to split
+ * @param part_paths Paths of the part files
+ * @param max_records Largest number of records read at a time
+ * @param part_of Callable returning the part of a record, in [0, part_paths.size())
+ */
+template <typename Record, typename PartOf>
+void split_records(
+    const std::filesystem::path& path, const std::vector<std::filesystem::path>& part_paths,
+    std::size_t max_records, const PartOf& part_of
+) {
+    {
+        std::vector<RecordWriter<Record>> parts;
+        parts.reserve(part_paths.size());
+        for (const std::filesystem::path& part_path : part_paths) {
+            parts.emplace_back(part_path);
+        }
+        RecordReader<Record> reader(path);
+        std::vector<Record> records;
+        while (reader.Read(records, max_records) > 0) {
+            for (const Record& record : records) {
+                parts[part_of(record)].Append(record);
+            }
+        }
+        for (RecordWriter<Record>& part : parts) {
+            part.Close();
+        }
+    }
+    std::filesystem::remove(path);
+}
+
+/// Scratch file of neighbor records covering a range of triangles
+struct NeighborRange {
+    std::filesystem::path path;  ///< file of the records
+    std::size_t first;           ///< first triangle of the range
+    std::size_t count;           ///< number of triangles of the range
+};
+
+}  // namespace
+
+//----------------------------------------------
+// OutOfCoreAnalysis
+//----------------------------------------------
+
+OutOfCoreAnalysis::OutOfCoreAnalysis(const std::string& path, const OutOfCoreOptions& options) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::invalid_argument("failed to open STL file: " + path);
+    }
+    this->Analyze(file, options);
+}
+
+OutOfCoreAnalysis::OutOfCoreAnalysis(std::istream& input, const OutOfCoreOptions& options) {
+    this->Analyze(input, options);
+}
+
+OutOfCoreAnalysis::~OutOfCoreAnalysis() {
+    // Unmap before removing the files
+    this->triangles_.reset();
+    this->neighbors_.reset();
+    std::error_code error;
+    std::filesystem::remove_all(this->scratch_path_, error);
+}
+
+void OutOfCoreAnalysis::Analyze(std::istream& input, const OutOfCoreOptions& options) {
+    this->scratch_path_ = create_scratch_directory(options.scratch_directory);
+    try {
+        PipelineStats* const stats{options.stats};
+        const std::size_t budget{std::max(options.memory_budget, kMinMemoryBudget)};
+        const std::filesystem::path triangle_path{this->scratch_path_ / "triangles.bin"};
+        const std::filesystem::path neighbor_path{this->scratch_path_ / "neighbors.bin"};
+
+        //----------------------------------------------
+        // Pass 1: read, validate and spill the triangles
+        //----------------------------------------------
+
+        // A chunk and its edge records fit the budget
+        const std::size_t chunk_size{
+            std::max<std::size_t>(1, budget / (sizeof(Triangle) + 3 * sizeof(EdgeRecord)))
+        };
+        std::vector<Triangle> chunk;
+        {
+            StlReader reader(input);
+            RecordWriter<Triangle> spill(triangle_path);
+            while (true) {
+                std::size_t count{0};
+                {
+                    const ScopedStageTimer timer(stats, &PipelineStats::parse_time);
+                    count = reader.Read(chunk, chunk_size);
+                }
+                if (count == 0) {
+                    break;
+                }
+                if (this->num_triangles_ + count >
+                    static_cast<std::size_t>(std::numeric_limits<TriangleIndex>::max())) {
+                    throw std::invalid_argument("too many triangles for 32-bit triangle indices");
+                }
+                {
+                    // Same checks and messages as the validation of a `TriangleMesh`
+                    const ScopedStageTimer timer(stats, &PipelineStats::validation_time);
+                    validate_triangles(chunk, 1, this->num_triangles_);
+                }
+                for (const Triangle& triangle : chunk) {
+                    spill.Append(triangle);
+                }
+                this->num_triangles_ += count;
+            }
+            spill.Close();
+        }
+        record_stats(stats, [this](PipelineStats& s) {
+            s.triangles_parsed += this->num_triangles_;
+        });
+        if (this->num_triangles_ == 0) {
+            throw std::invalid_argument("triangle mesh cannot be empty");
+        }
+        const std::size_t num_triangles{this->num_triangles_};
+
+        //----------------------------------------------
+        // Pass 2: partition the edges by hash
+        //----------------------------------------------
+
+        std::optional<ScopedStageTimer> connectivity_timer{
+            std::in_place, stats, &PipelineStats::connectivity_time
+        };
+        // Buckets still larger than the budget (more than `kMaxScratchFiles` budgets of edges, or
+        // an uneven spread) are partitioned again in pass 3
+        const std::size_t num_first_buckets{std::clamp<std::size_t>(
+            divide_round_up(3 * num_triangles * sizeof(EdgeRecord), budget), 1, kMaxScratchFiles
+        )};
+        std::size_t num_edge_files{num_first_buckets};
+        {
+            std::vector<RecordWriter<EdgeRecord>> buckets;
+            buckets.reserve(num_first_buckets);
+            for (std::size_t b = 0; b < num_first_buckets; ++b) {
+                buckets.emplace_back(scratch_file(this->scratch_path_, "edges_", b));
+            }
+
+            RecordReader<Triangle> triangles(triangle_path);
+            for (std::size_t first = 0; triangles.Read(chunk, chunk_size) > 0;
+                 first += chunk.size()) {
+                for (std::size_t i = 0; i < chunk.size(); ++i) {
+                    const std::array<const Point*, 3> corners{
+                        &chunk[i].a, &chunk[i].b, &chunk[i].c
+                    };
+                    for (std::uint32_t local_edge = 0; local_edge < 3; ++local_edge) {
+                        const EdgeRecord record{
+                            make_edge(*corners[local_edge], *corners[(local_edge + 1) % 3]),
+                            static_cast<TriangleIndex>(first + i), local_edge
+                        };
+                        buckets[bucket_of(record.edge, num_first_buckets, 0)].Append(record);
+                    }
+                }
+            }
+            for (RecordWriter<EdgeRecord>& bucket : buckets) {
+                bucket.Close();
+            }
+        }
+
+        //----------------------------------------------
+        // Pass 3: match the edges bucket by bucket
+        //----------------------------------------------
+
+        // A range of the neighbor table, its records and its triangles fit the budget; the first
+        // ranges are wider if that takes more than `kMaxScratchFiles` files, and split in pass 4
+        const std::size_t range_size{std::max<std::size_t>(
+            1, budget / (3 * sizeof(NeighborRecord) + sizeof(NeighborRow) + sizeof(Triangle))
+        )};
+        const std::size_t first_range_size{
+            std::max(range_size, divide_round_up(num_triangles, kMaxScratchFiles))
+        };
+        const std::size_t num_first_ranges{divide_round_up(num_triangles, first_range_size)};
+
+        // Labels carried across the buckets; the root of every set is its smallest triangle
+        ConcurrentDisjointSets sets(num_triangles);
+        {
+            std::vector<RecordWriter<NeighborRecord>> ranges;
+            ranges.reserve(num_first_ranges);
+            for (std::size_t r = 0; r < num_first_ranges; ++r) {
+                ranges.emplace_back(scratch_file(this->scratch_path_, "neighbors_", r));
+            }
+
+            // Lambda: record that a triangle has a neighbor across one of its edges
+            auto add_neighbor = [&](const EdgeRecord& side, const EdgeRecord& other) {
+                ranges[static_cast<std::size_t>(side.triangle) / first_range_size].Append(
+                    {side.triangle, side.local_edge, other.triangle}
+                );
+            };
+
+            // Bucket files left to match, with their partition level (the order does not change
+            // the result: the union-find roots and the neighbor table slots are fixed)
+            std::vector<std::pair<std::size_t, std::size_t>> pending;
+            for (std::size_t b = num_first_buckets; b-- > 0;) {
+                pending.emplace_back(b, 0);
+            }
+            while (!pending.empty()) {
+                const auto [file, level] = pending.back();
+                pending.pop_back();
+                const std::filesystem::path bucket_path{
+                    scratch_file(this->scratch_path_, "edges_", file)
+                };
+
+                // Too large for the budget -> partition the bucket again by the next level
+                const auto bucket_bytes{
+                    static_cast<std::size_t>(std::filesystem::file_size(bucket_path))
+                };
+                if (bucket_bytes > budget && level < kMaxPartitionLevel) {
+                    const std::size_t num_parts{std::clamp<std::size_t>(
+                        divide_round_up(bucket_bytes, budget), 2, kMaxScratchFiles
+                    )};
+                    std::vector<std::filesystem::path> part_paths;
+                    for (std::size_t part = 0; part < num_parts; ++part) {
+                        pending.emplace_back(num_edge_files + part, level + 1);
+                        part_paths.push_back(
+                            scratch_file(this->scratch_path_, "edges_", num_edge_files + part)
+                        );
+                    }
+                    num_edge_files += num_parts;
+                    split_records<EdgeRecord>(
+                        bucket_path, part_paths, budget / sizeof(EdgeRecord),
+                        [num_parts, level](const EdgeRecord& record) {
+                            return bucket_of(record.edge, num_parts, level + 1);
+                        }
+                    );
+                    continue;
+                }
+
+                std::vector<EdgeRecord> records{take_records<EdgeRecord>(bucket_path)};
+                std::sort(records.begin(), records.end(), edge_record_less);
+                ++this->num_buckets_;
+
+                for (std::size_t begin = 0; begin < records.size();) {
+                    std::size_t end{begin + 1};
+                    while (end < records.size() &&
+                           EdgeEquality{}(records[end].edge, records[begin].edge)) {
+                        ++end;
+                    }
+
+                    // Check for NON-MANIFOLD edges (shared by 3 or more triangles) -> throw
+                    if (end - begin > 2) {
+                        throw std::invalid_argument(
+                            "non-manifold mesh detected: edge shared by more than 2 triangles"
+                        );
+                    }
+                    if (end - begin == 2) {
+                        const EdgeRecord& first{records[begin]};
+                        const EdgeRecord& second{records[begin + 1]};
+                        sets.Unite(
+                            static_cast<std::size_t>(first.triangle),
+                            static_cast<std::size_t>(second.triangle)
+                        );
+                        add_neighbor(first, second);
+                        add_neighbor(second, first);
+                    }
+                    begin = end;
+                }
+            }
+            for (RecordWriter<NeighborRecord>& range : ranges) {
+                range.Close();
+            }
+        }
+        connectivity_timer.reset();
+
+        //----------------------------------------------
+        // Pass 4: neighbor table, component sizes, closedness and AABBs
+        //----------------------------------------------
+
+        const ScopedStageTimer neighbor_timer(stats, &PipelineStats::neighbor_table_time);
+        for (std::size_t t = 0; t < num_triangles; ++t) {
+            if (sets.Find(t) == t) {
+                this->roots_.push_back(static_cast<TriangleIndex>(t));
+            }
+        }
+        const std::size_t num_components{this->roots_.size()};
+        this->sizes_.assign(num_components, 0);
+        this->closed_.assign(num_components, 1);
+
+        constexpr double kInfinity{std::numeric_limits<double>::infinity()};
+        std::vector<Point> lower(num_components, Point{kInfinity, kInfinity, kInfinity});
+        std::vector<Point> upper(num_components, Point{-kInfinity, -kInfinity, -kInfinity});
+        {
+            RecordWriter<NeighborRow> table(neighbor_path);
+            RecordReader<Triangle> triangles(triangle_path);
+            std::vector<NeighborRow> rows;
+
+            // Ranges left to assemble, the next one at the back so that the table is written in
+            // triangle order
+            std::vector<NeighborRange> pending;
+            for (std::size_t r = num_first_ranges; r-- > 0;) {
+                const std::size_t first{r * first_range_size};
+                pending.push_back(
+                    {scratch_file(this->scratch_path_, "neighbors_", r), first,
+                     std::min(first_range_size, num_triangles - first)}
+                );
+            }
+            std::size_t num_range_files{num_first_ranges};
+            while (!pending.empty()) {
+                const NeighborRange range{std::move(pending.back())};
+                pending.pop_back();
+                const std::size_t first{range.first};
+                const std::size_t count{range.count};
+
+                // Too large for the budget -> split the range into narrower ones
+                if (count > range_size) {
+                    const std::size_t part_size{divide_round_up(
+                        count, std::min(divide_round_up(count, range_size), kMaxScratchFiles)
+                    )};
+                    const std::size_t num_parts{divide_round_up(count, part_size)};
+                    std::vector<std::filesystem::path> part_paths;
+                    for (std::size_t part = 0; part < num_parts; ++part) {
+                        part_paths.push_back(scratch_file(
+                            this->scratch_path_, "neighbors_", num_range_files + part
+                        ));
+                    }
+                    num_range_files += num_parts;
+                    split_records<NeighborRecord>(
+                        range.path, part_paths, budget / sizeof(NeighborRecord),
+                        [first, part_size](const NeighborRecord& record) {
+                            return (static_cast<std::size_t>(record.triangle) - first) / part_size;
+                        }
+                    );
+                    for (std::size_t part = num_parts; part-- > 0;) {
+                        const std::size_t part_first{first + part * part_size};
+                        pending.push_back(
+                            {part_paths[part], part_first,
+                             std::min(part_size, first + count - part_first)}
+                        );
+                    }
+                    continue;
+                }
+
+                rows.assign(
+                    count, {kBoundaryTriangleIndex, kBoundaryTriangleIndex, kBoundaryTriangleIndex}
+                );
+                for (const NeighborRecord& record : take_records<NeighborRecord>(range.path)) {
+                    rows[static_cast<std::size_t>(record.triangle) - first][record.local_edge] =
+                        record.neighbor;
+                }
+
+                triangles.Read(chunk, count);
+                for (std::size_t i = 0; i < count; ++i) {
+                    const auto root{static_cast<TriangleIndex>(sets.Find(first + i))};
+                    const auto k{static_cast<std::size_t>(
+                        std::lower_bound(this->roots_.begin(), this->roots_.end(), root) -
+                        this->roots_.begin()
+                    )};
+                    ++this->sizes_[k];
+                    if (std::find(rows[i].begin(), rows[i].end(), kBoundaryTriangleIndex) !=
+                        rows[i].end()) {
+                        this->closed_[k] = 0;
+                    }
+                    for (const Point* corner : {&chunk[i].a, &chunk[i].b, &chunk[i].c}) {
+                        for (std::size_t axis = 0; axis < 3; ++axis) {
+                            lower[k][axis] = std::min(lower[k][axis], (*corner)[axis]);
+                            upper[k][axis] = std::max(upper[k][axis], (*corner)[axis]);
+                        }
+                    }
+                    table.Append(rows[i]);
+                }
+            }
+            table.Close();
+        }
+
+        // Padded like `compute_component_aabb`
+        this->aabbs_.reserve(num_components);
+        for (std::size_t k = 0; k < num_components; ++k) {
+            this->aabbs_.emplace_back(
+                lower[k][0] - kEpsilon, lower[k][1] - kEpsilon, lower[k][2] - kEpsilon,
+                upper[k][0] + kEpsilon, upper[k][1] + kEpsilon, upper[k][2] + kEpsilon
+            );
+        }
+
+        this->triangles_.emplace(triangle_path.string());
+        this->neighbors_.emplace(neighbor_path.string());
+    } catch (...) {
+        this->triangles_.reset();
+        this->neighbors_.reset();
+        std::error_code error;
+        std::filesystem::remove_all(this->scratch_path_, error);
+        throw;
+    }
+}
+
+Triangle OutOfCoreAnalysis::GetTriangle(std::size_t triangle_index) const {
+    Triangle triangle;
+    std::memcpy(
+        &triangle, this->triangles_->GetData().data() + triangle_index * sizeof(Triangle),
+        sizeof(Triangle)
+    );
+    return triangle;
+}
+
+void OutOfCoreAnalysis::AppendComponent(
+    std::size_t component, std::vector<bool>& visited, ConnectedComponent& out
+) const {
+    const char* const table{this->neighbors_->GetData().data()};
+    const auto seed{static_cast<std::size_t>(this->roots_[component])};
+    visited[seed] = true;
+    out.push_back(static_cast<TriangleIndex>(seed));
+
+    // BFS as in `find_connected_components`: the appended part of `out` is the FIFO queue
+    for (std::size_t head = out.size() - 1; head < out.size(); ++head) {
+        NeighborRow row;
+        std::memcpy(
+            &row, table + static_cast<std::size_t>(out[head]) * sizeof(NeighborRow), sizeof(row)
+        );
+        for (const TriangleIndex neighbor : row) {
+            if (neighbor == kBoundaryTriangleIndex) {
+                continue;  // boundary edge -> skip
+            }
+            const auto neighbor_index{static_cast<std::size_t>(neighbor)};
+            if (visited[neighbor_index]) {
+                continue;
+            }
+            visited[neighbor_index] = true;
+            out.push_back(neighbor);
+        }
+    }
+}
+
+ConnectedComponent OutOfCoreAnalysis::GetComponent(std::size_t component) const {
+    std::vector<bool> visited(this->num_triangles_, false);
+    ConnectedComponent triangles;
+    triangles.reserve(this->sizes_[component]);
+    this->AppendComponent(component, visited, triangles);
+    return triangles;
+}
+
+std::vector<ConnectedComponent> OutOfCoreAnalysis::GetComponents() const {
+    std::vector<bool> visited(this->num_triangles_, false);
+    std::vector<ConnectedComponent> components(this->roots_.size());
+    for (std::size_t k = 0; k < components.size(); ++k) {
+        components[k].reserve(this->sizes_[k]);
+        this->AppendComponent(k, visited, components[k]);
+    }
+    return components;
+}
+
+void OutOfCoreAnalysis::WriteComponents(
+    std::span<const std::size_t> components, StlWriter& writer
+) const {
+    std::vector<bool> visited(this->num_triangles_, false);
+    ConnectedComponent triangles;
+    for (const std::size_t k : components) {
+        triangles.clear();
+        this->AppendComponent(k, visited, triangles);
+        for (const TriangleIndex index : triangles) {
+            writer.Write(this->GetTriangle(static_cast<std::size_t>(index)));
+        }
+    }
+}
+
+//----------------------------------------------
+// Void detection
+//----------------------------------------------
+
+std::vector<ConnectedComponent> find_connected_components(const OutOfCoreAnalysis& analysis) {
+    return analysis.GetComponents();
+}
+
+std::vector<std::size_t> find_void_components(
+    const OutOfCoreAnalysis& analysis, PipelineStats* stats
+) {
+    std::vector<std::size_t> closed;
+    std::vector<AxisAlignedBoundingBox> boxes;
+    for (std::size_t k = 0; k < analysis.GetNumComponents(); ++k) {
+        if (analysis.IsClosed(k)) {
+            closed.push_back(k);
+            boxes.push_back(analysis.GetComponentAabbs()[k]);
+        }
+    }
+    record_stats(stats, [&](PipelineStats& s) {
+        s.num_components += analysis.GetNumComponents();
+        s.num_closed_components += closed.size();
+    });
+
+    const ScopedStageTimer timer(stats, &PipelineStats::void_identification_time);
+    if (closed.size() < 2U) {
+        return {};  // 0 or 1 closed component -> no voids
+    }
+
+    // Same classification as `identify_void_indices` with `VoidClassification::kAabbContainment`
+    const AabbContainmentIndex index(std::move(boxes));
+    std::size_t aabb_tests{0};
+    std::size_t* const aabb_test_counter{
+        (kStatsEnabled && stats != nullptr) ? &aabb_tests : nullptr
+    };
+    std::vector<std::size_t> voids;
+    for (std::size_t i = 0; i < closed.size(); ++i) {
+        if (index.HasContainer(i, kEpsilon, aabb_test_counter)) {
+            voids.push_back(closed[i]);
+        }
+    }
+    record_stats(stats, [&](PipelineStats& s) {
+        s.aabb_tests += aabb_tests;
+        s.num_voids += voids.size();
+    });
+    return voids;
+}
+
+void export_voids_to_stl(
+    const OutOfCoreAnalysis& analysis, std::ostream& out, StlFormat format, PipelineStats* stats
+) {
+    const std::vector<std::size_t> voids{find_void_components(analysis, stats)};
+    std::size_t num_void_triangles{0};
+    for (const std::size_t k : voids) {
+        num_void_triangles += analysis.GetComponentSize(k);
+    }
+
+    const ScopedStageTimer export_timer(stats, &PipelineStats::export_time);
+    record_stats(stats, [num_void_triangles](PipelineStats& s) {
+        s.triangles_exported += num_void_triangles;
+    });
+    StlWriter writer(out, format, "voids", num_void_triangles);
+    analysis.WriteComponents(voids, writer);
+    writer.Finish();
+}
+
+}  // namespace tsexam::problem1
@@ -0,0 +1,267 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "geometry.hpp"
+#include "mapped_file.hpp"
+#include "pipeline_stats.hpp"
+#include "stl_io.hpp"
+#include "triangle_mesh.hpp"
+#include "void_detection.hpp"
+
+namespace tsexam::problem1 {
+
+/**
+ * @brief Options of an out-of-core mesh analysis
+ */
+struct OutOfCoreOptions {
+    /// Directory in which the temporary scratch directory of the analysis is created (empty: the
+    /// system temporary directory)
+    std::string scratch_directory;
+
+    /// Bytes of triangles and edge records that one pass holds in memory at a time; sets the read
+    /// chunk size, the number of edge buckets and the size of the neighbor table ranges
+    std::size_t memory_budget{std::size_t{64} << 20};
+
+    /// Sink for the stage timings and counters (null: no stats are recorded)
+    PipelineStats* stats{nullptr};
+};
+
+/**
+ * @brief Component structure of an STL mesh too large to hold in memory
+ *
+ * The analysis never holds the triangle list or the edge connectivity of the whole mesh. It runs
+ * in passes over files in a private scratch directory:
+ *
+ * 1. The STL input is read in chunks (`StlReader`), validated like a `TriangleMesh` and spilled to
+ *    a triangle file.
+ * 2. The canonical edges of the triangles are partitioned by edge hash into bucket files, one per
+ *    memory budget of edge records but at most 256.
+ * 3. Bucket by bucket, the edge records are sorted and matched. A bucket larger than the budget
+ *    (from the 256 cap or an uneven spread) is first partitioned again, by another hash, and so
+ *    on for up to four levels; only edges colliding on their full hash can leave a bucket larger
+ *    than the budget after that. Every shared edge unites its two triangles in a union-find
+ *    (`ConcurrentDisjointSets`) that carries the labels across buckets, and yields a neighbor
+ *    record for each side. An edge of three or more triangles is rejected.
+ * 4. The neighbor records are partitioned by triangle range into at most 256 files, and a range
+ *    too wide for the budget is split into narrower ones as it is reached. Range by range, the
+ *    records are assembled into an on-disk neighbor table. The same pass counts the triangles,
+ *    the boundary edges and the AABB of every component from the triangle file.
+ *
+ * The components are numbered by their smallest triangle and listed in BFS order over the mapped
+ * neighbor table, so `GetComponents()` is identical to `find_connected_components` of a
+ * `TriangleMesh` built from the same file. Likewise, closedness and AABBs match
+ * `is_connected_component_closed` and `compute_component_aabb`. Besides the memory budget, the
+ * analysis holds 4 bytes per triangle for the union-find while it is built, and afterwards a few
+ * dozen bytes per component. A component traversal needs one bit per triangle and its own
+ * triangle list.
+ *
+ * The scratch directory is removed when the analysis is destroyed. The class is neither copyable
+ * nor movable because it owns that directory and the mappings into it.
+ */
+class OutOfCoreAnalysis {
+public:
+    /**
+     * @brief Analyzes an ASCII or binary STL file
+     *
+     * @param path Path to the STL file
+     * @param options Scratch directory, memory budget and stats sink
+     *
+     * @throws std::invalid_argument if the file cannot be opened or the mesh is invalid (empty,
+     *         degenerate triangles or non-manifold edges, with the messages of `TriangleMesh`)
+     * @throws std::runtime_error if a binary file is truncated or a scratch file fails
+     */
+    explicit OutOfCoreAnalysis(const std::string& path, const OutOfCoreOptions& options = {});
+
+    /**
+     * @brief Analyzes an ASCII or binary STL stream
+     *
+     * @param input Stream positioned at the start of the STL data (binary mode)
+     * @param options Scratch directory, memory budget and stats sink
+     *
+     * @throws std::invalid_argument if the mesh is invalid
+     * @throws std::runtime_error if a binary stream is truncated or a scratch file fails
+     */
+    explicit OutOfCoreAnalysis(std::istream& input, const OutOfCoreOptions& options = {});
+
+    /// Removes the scratch directory
+    ~OutOfCoreAnalysis();
+
+    OutOfCoreAnalysis(const OutOfCoreAnalysis&) = delete;
+    OutOfCoreAnalysis& operator=(const OutOfCoreAnalysis&) = delete;
+
+    /**
+     * @brief Returns the number of triangles of the mesh
+     *
+     * @return Number of triangles
+     */
+    std::size_t GetNumTriangles() const { return num_triangles_; }
+
+    /**
+     * @brief Returns the number of edge buckets the connectivity was matched in
+     *
+     * @return Number of bucket files matched, counting a re-partitioned bucket by its parts
+     */
+    std::size_t GetNumBuckets() const { return num_buckets_; }
+
+    /**
+     * @brief Returns the number of connected components
+     *
+     * @return Number of components
+     */
+    std::size_t GetNumComponents() const { return roots_.size(); }
+
+    /**
+     * @brief Returns the number of triangles of a component
+     *
+     * @param component Index of the component
+     * @return Number of triangles
+     */
+    std::size_t GetComponentSize(std::size_t component) const { return sizes_[component]; }
+
+    /**
+     * @brief Returns whether a component is closed (no boundary edge)
+     *
+     * @param component Index of the component
+     * @return true if every edge of the component is shared by two triangles
+     */
+    bool IsClosed(std::size_t component) const { return closed_[component] != 0; }
+
+    /**
+     * @brief Returns the AABB of every component
+     *
+     * Entry k is the box of component k, padded by `kEpsilon` like the default of
+     * `compute_component_aabb`.
+     *
+     * @return Reference to the component AABBs
+     */
+    const std::vector<AxisAlignedBoundingBox>& GetComponentAabbs() const { return aabbs_; }
+
+    /**
+     * @brief Returns a triangle of the mesh
+     *
+     * @param triangle_index Index of the triangle, in input order
+     * @return Triangle read from the triangle file
+     */
+    Triangle GetTriangle(std::size_t triangle_index) const;
+
+    /**
+     * @brief Returns the triangles of a component
+     *
+     * @param component Index of the component
+     * @return Triangle indices in BFS order from the smallest one, as `find_connected_components`
+     *         lists them
+     */
+    ConnectedComponent GetComponent(std::size_t component) const;
+
+    /**
+     * @brief Returns all connected components
+     *
+     * @return Components in `find_connected_components` order
+     */
+    std::vector<ConnectedComponent> GetComponents() const;
+
+    /**
+     * @brief Streams the triangles of some components to an STL writer
+     *
+     * The components are traversed one after the other, each in the order of `GetComponent`, and
+     * only one of them is held in memory at a time.
+     *
+     * @param components Indices of the components to write
+     * @param writer Writer receiving the triangles
+     */
+    void WriteComponents(std::span<const std::size_t> components, StlWriter& writer) const;
+
+private:
+    /**
+     * @brief Runs the passes over the STL input
+     *
+     * @param input STL stream
+     * @param options Analysis options
+     */
+    void Analyze(std::istream& input, const OutOfCoreOptions& options);
+
+    /**
+     * @brief Appends the triangles of a component in BFS order
+     *
+     * @param component Index of the component
+     * @param visited Per-triangle visited flags, updated for the triangles of the component
+     * @param out List the triangle indices are appended to
+     */
+    void AppendComponent(
+        std::size_t component, std::vector<bool>& visited, ConnectedComponent& out
+    ) const;
+
+    /// Private scratch directory holding the triangle, bucket and neighbor table files
+    std::filesystem::path scratch_path_;
+
+    /// Number of triangles of the mesh
+    std::size_t num_triangles_{0};
+
+    /// Number of edge buckets
+    std::size_t num_buckets_{0};
+
+    /// Smallest triangle of every component, ascending
+    std::vector<TriangleIndex> roots_;
+
+    /// Number of triangles of every component
+    std::vector<std::size_t> sizes_;
+
+    /// Whether each component is closed
+    std::vector<unsigned char> closed_;
+
+    /// Padded AABB of each component
+    std::vector<AxisAlignedBoundingBox> aabbs_;
+
+    /// Mapped triangle file (input order)
+    std::optional<MappedFile> triangles_;
+
+    /// Mapped neighbor table: three `TriangleIndex` per triangle, for local edges 0, 1 and 2
+    std::optional<MappedFile> neighbors_;
+};
+
+/**
+ * @brief Find the connected components of an out-of-core analysis
+ *
+ * @param analysis Out-of-core analysis of a mesh
+ * @return Components identical to `find_connected_components` of the in-memory mesh
+ */
+std::vector<ConnectedComponent> find_connected_components(const OutOfCoreAnalysis& analysis);
+
+/**
+ * @brief Identify the voids of an out-of-core analysis
+ *
+ * Classifies the closed components by AABB containment, like `export_voids_to_stl`.
+ *
+ * @param analysis Out-of-core analysis of a mesh
+ * @param stats Sink for the component counts and the void identification figures (may be null)
+ * @return Indices of the void components, ascending
+ */
+std::vector<std::size_t> find_void_components(
+    const OutOfCoreAnalysis& analysis, PipelineStats* stats = nullptr
+);
+
+/**
+ * @brief Export the voids of an out-of-core analysis to an STL file
+ *
+ * Writes the same output as `export_voids_to_stl` on the in-memory mesh, streaming one void at a
+ * time from the scratch files.
+ *
+ * @param analysis Out-of-core analysis of a mesh
+ * @param out The output stream (binary mode for `StlFormat::kBinary`)
+ * @param format STL encoding of the output
+ * @param stats Sink for the void detection and export timings and counters (may be null)
+ */
+void export_voids_to_stl(
+    const OutOfCoreAnalysis& analysis, std::ostream& out, StlFormat format = StlFormat::kAscii,
+    PipelineStats* stats = nullptr
+);
+
+}  // namespace tsexam::problem1
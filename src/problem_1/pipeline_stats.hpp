@@ -0,0 +1,133 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+/**
+ * Stats collection is compiled in unless the build defines `TSEXAM_ENABLE_STATS=0` (CMake option
+ * `TSEXAM_ENABLE_STATS`). When it is compiled out, every recording site below is discarded at
+ * compile time and a `PipelineStats` passed to the pipeline stays untouched.
+ */
+#ifndef TSEXAM_ENABLE_STATS
+#define TSEXAM_ENABLE_STATS 1
+#endif
+
+namespace tsexam::problem1 {
+
+/// Whether the pipeline records stats at all (see `TSEXAM_ENABLE_STATS`)
+constexpr bool kStatsEnabled{TSEXAM_ENABLE_STATS != 0};
+
+/**
+ * @brief Per-stage timings and counters of the mesh pipeline
+ *
+ * Pass a pointer to an instance through `TriangleMeshOptions::stats`, `identify_voids` or
+ * `export_voids_to_stl` to have the stages fill it in; a null pointer (the default) records
+ * nothing. Times and counters accumulate across calls, so one instance can collect a whole job;
+ * the hash map figures describe the most recent connectivity build.
+ */
+struct PipelineStats {
+    //----------------------------------------------
+    // Wall time per stage
+    //----------------------------------------------
+
+    std::chrono::nanoseconds parse_time{0};                ///< STL parsing (incl. file mapping)
+    std::chrono::nanoseconds validation_time{0};           ///< degenerate triangle checks
+    std::chrono::nanoseconds welding_time{0};              ///< vertex welding (indexed engines)
+    std::chrono::nanoseconds connectivity_time{0};         ///< edge-to-triangle connectivity
+    std::chrono::nanoseconds neighbor_table_time{0};       ///< triangle neighbor table
+    std::chrono::nanoseconds components_time{0};           ///< components + closed check
+    std::chrono::nanoseconds void_identification_time{0};  ///< `identify_voids`
+    std::chrono::nanoseconds export_time{0};               ///< writing the void triangles
+    std::chrono::nanoseconds cache_time{0};                ///< connectivity cache hash/read/write
+
+    //----------------------------------------------
+    // Loading
+    //----------------------------------------------
+
+    std::size_t bytes_parsed{0};      ///< size of the parsed STL input
+    std::size_t triangles_parsed{0};  ///< triangles produced by the parser
+    std::size_t vertices_welded{0};   ///< distinct vertices found by welding
+    std::size_t cache_hits{0};        ///< meshes restored from a connectivity cache
+    std::size_t cache_misses{0};      ///< meshes rebuilt because the cache was missing or stale
+
+    //----------------------------------------------
+    // Connectivity hash map (hash map engines only)
+    //----------------------------------------------
+
+    std::size_t edge_map_size{0};          ///< number of distinct edges in the map
+    std::size_t edge_map_bucket_count{0};  ///< number of buckets after the build
+    double edge_map_load_factor{0.};       ///< size / bucket count after the build
+    std::size_t edge_map_rehash_count{0};  ///< rehashes during the build (after the reserve)
+
+    //----------------------------------------------
+    // Void detection
+    //----------------------------------------------
+
+    std::size_t num_components{0};         ///< connected components found
+    std::size_t num_closed_components{0};  ///< closed components among them
+    std::size_t num_voids{0};              ///< components classified as voids
+    std::size_t aabb_tests{0};             ///< pairwise `aabb_contains` tests performed
+    std::size_t point_in_solid_tests{0};   ///< BVH point-in-solid queries performed
+    std::size_t triangles_exported{0};     ///< void triangles written
+};
+
+/**
+ * @brief Applies an update to a stats sink if stats are enabled and the sink is not null
+ *
+ * @param stats Stats sink (may be null)
+ * @param update Callable taking a `PipelineStats&`
+ */
+template <typename Update>
+inline void record_stats(PipelineStats* stats, const Update& update) {
+    if constexpr (kStatsEnabled) {
+        if (stats != nullptr) {
+            update(*stats);
+        }
+    }
+}
+
+/**
+ * @brief Adds the wall time of a scope to one of the durations of a stats sink
+ *
+ * Reads the clock only if stats are enabled and the sink is not null.
+ */
+class ScopedStageTimer {
+public:
+    /**
+     * @brief Starts timing
+     *
+     * @param stats Stats sink (may be null)
+     * @param stage Duration member to add the elapsed time to, e.g. `&PipelineStats::parse_time`
+     */
+    ScopedStageTimer(PipelineStats* stats, std::chrono::nanoseconds PipelineStats::*stage) {
+        if constexpr (kStatsEnabled) {
+            if (stats != nullptr) {
+                this->total_ = &(stats->*stage);
+                this->start_ = std::chrono::steady_clock::now();
+            }
+        }
+    }
+
+    ScopedStageTimer(const ScopedStageTimer&) = delete;
+    ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+    /// Adds the elapsed time to the stage duration
+    ~ScopedStageTimer() {
+        if constexpr (kStatsEnabled) {
+            if (this->total_ != nullptr) {
+                *this->total_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - this->start_
+                );
+            }
+        }
+    }
+
+private:
+    /// Duration to add to (null: not timing)
+    std::chrono::nanoseconds* total_{nullptr};
+
+    /// Start of the timed scope
+    std::chrono::steady_clock::time_point start_{};
+};
+
+}  // namespace tsexam::problem1
@@ -1,11 +1,15 @@
 #include "reorient_triangles.hpp"
 
+#include <algorithm>
 #include <array>
 #include <queue>
 #include <vector>
 
+#include "common/parallel.hpp"
+
 #include "geometry.hpp"
 #include "stl_io.hpp"
+#include "void_detection.hpp"
 
 namespace tsexam::problem1 {
 
@@ -27,9 +31,11 @@ bool are_orientations_consistent(const Triangle& t1, const Triangle& t2, const E
     return t1_edge != t2_edge;
 }
 
-std::vector<Triangle> reorient_inconsistent_triangles(TriangleMesh& mesh, std::size_t seed) {
+std::vector<Triangle> reorient_inconsistent_triangles(
+    const TriangleMesh& mesh, std::size_t seed, const AnalysisControl* control
+) {
     const auto& triangles{mesh.GetTriangles()};
-    const auto& edge_connectivity{mesh.GetEdgeConnectivity()};
+    const auto& neighbors{mesh.GetTriangleNeighbors()};
 
     if (seed >= triangles.size()) {
         // seed is out of range -> no triangles to reorient
@@ -42,47 +48,35 @@ std::vector<Triangle> reorient_inconsistent_triangles(TriangleMesh& mesh, std::s
 
     visited_triangles[seed] = true;
     queue.push(seed);
+    std::size_t num_visited{0};
 
     // Propagate the orientation through the mesh using BFS
     while (!queue.empty()) {
+        checkpoint(control, AnalysisStage::kReorientation, num_visited++, triangles.size());
         std::size_t triangle_index{queue.front()};
         queue.pop();
 
         const Triangle& triangle{triangles[triangle_index]};
-
-        // Examine all three edges of this triangle
-        std::array<Edge, 3> edges{
-            make_edge(triangle.a, triangle.b), make_edge(triangle.b, triangle.c),
-            make_edge(triangle.c, triangle.a)
-        };
+        const std::array<const Point*, 3> corners{&triangle.a, &triangle.b, &triangle.c};
 
         // For each edge of triangle: find neighbor triangle and check if orientations are consistent
-        for (const Edge& edge : edges) {
-            // Find the neighbor triangle for this edge
-            auto it{edge_connectivity.find(edge)};
-            if (it == edge_connectivity.end()) {
-                continue;  // edge not found in the mesh
-            }
+        for (std::size_t local_edge = 0; local_edge < 3; ++local_edge) {
+            const TriangleIndex neighbor{neighbors[triangle_index][local_edge]};
 
-            // Check if edge is boundary or non-manifold -> skip
-            const auto& degree_of_edge{it->second};
-            if (degree_of_edge[1] == kBoundaryTriangleIndex) {
+            // Check if edge is boundary (or unknown) -> skip
+            if (neighbor == kBoundaryTriangleIndex) {
                 continue;  // boundary edge -> skip
             }
-
-            // Get neighbor triangle index from degree of edge
-            std::size_t neighbor_index{
-                (degree_of_edge[0] == static_cast<TriangleIndex>(triangle_index))
-                    ? static_cast<std::size_t>(degree_of_edge[1])
-                    : static_cast<std::size_t>(degree_of_edge[0])
-            };
+            const auto neighbor_index{static_cast<std::size_t>(neighbor)};
 
             // If neighbor triangle is already visited -> skip
             if (visited_triangles[neighbor_index]) {
                 continue;
             }
 
-            // If orientations are inconsistent -> flip neighbor triangle orientation
+            // If orientations are inconsistent -> flip neighbor triangle orientation; the shared
+            // edge is only built for the unvisited neighbors that need the check
+            const Edge edge{make_edge(*corners[local_edge], *corners[(local_edge + 1) % 3])};
             if (!are_orientations_consistent(triangle, triangles[neighbor_index], edge)) {
                 // copy the triangle to be flipped to avoid modifying the original triangle
                 Triangle to_be_flipped{triangles[neighbor_index]};
@@ -95,14 +89,96 @@ std::vector<Triangle> reorient_inconsistent_triangles(TriangleMesh& mesh, std::s
             queue.push(neighbor_index);
         }
     }
+    checkpoint(control, AnalysisStage::kReorientation, triangles.size(), triangles.size());
     return flipped_triangles;
 }
 
-void export_inconsistent_triangles(TriangleMesh& mesh, std::size_t seed, std::ostream& out) {
+void write_reoriented_triangles(
+    std::span<const Triangle> triangles, std::ostream& out, StlFormat format,
+    const AnalysisControl* control
+) {
+    const std::size_t num_triangles{triangles.size()};
+    StlWriter writer(out, format, "reoriented_triangles", num_triangles);
+    for (std::size_t i = 0; i < num_triangles; ++i) {
+        checkpoint(control, AnalysisStage::kExport, i, num_triangles);
+        writer.Write(triangles[i]);
+    }
+    checkpoint(control, AnalysisStage::kExport, num_triangles, num_triangles);
+    writer.Finish();
+}
+
+std::size_t export_inconsistent_triangles(
+    const TriangleMesh& mesh, std::size_t seed, std::ostream& out, StlFormat format,
+    const AnalysisControl* control
+) {
     // step 1: reorient the inconsistent triangles
-    std::vector<Triangle> flipped_triangles{reorient_inconsistent_triangles(mesh, seed)};
+    const std::vector<Triangle> flipped_triangles{
+        reorient_inconsistent_triangles(mesh, seed, control)
+    };
     // step 2: write the reoriented triangles to the output stream
-    write_ascii_stl(out, "reoriented_triangles", flipped_triangles);
+    write_reoriented_triangles(flipped_triangles, out, format, control);
+    return flipped_triangles.size();
+}
+
+std::vector<TriangleIndex> reorient_all_components(TriangleMesh& mesh, std::size_t num_threads) {
+    const std::size_t thread_count{common::resolve_thread_count(num_threads)};
+    const auto& triangles{mesh.GetTriangles()};
+    const auto& neighbors{mesh.GetTriangleNeighbors()};
+
+    // Components are rooted at their smallest triangle (first entry), the orientation reference
+    const std::vector<ConnectedComponent> components{find_connected_components(mesh, thread_count)};
+
+    // Components are disjoint, so concurrent traversals touch disjoint triangles, neighbor rows and
+    // visited flags
+    std::vector<unsigned char> visited(triangles.size(), 0);
+    std::vector<std::vector<TriangleIndex>> flipped_per_component(components.size());
+    common::parallel_for(components.size(), thread_count, [&](std::size_t k) {
+        const auto seed{static_cast<std::size_t>(components[k].front())};
+        std::vector<TriangleIndex>& flipped{flipped_per_component[k]};
+        std::queue<std::size_t> queue;
+        visited[seed] = 1;
+        queue.push(seed);
+
+        // Propagate the orientation through the component using BFS
+        while (!queue.empty()) {
+            const std::size_t triangle_index{queue.front()};
+            queue.pop();
+
+            // Triangle is already in its final orientation (flipped when it was reached)
+            const Triangle& triangle{triangles[triangle_index]};
+            const std::array<const Point*, 3> corners{&triangle.a, &triangle.b, &triangle.c};
+
+            for (std::size_t local_edge = 0; local_edge < 3; ++local_edge) {
+                const TriangleIndex neighbor{neighbors[triangle_index][local_edge]};
+
+                // Boundary edge or neighbor already oriented -> skip
+                if (neighbor == kBoundaryTriangleIndex ||
+                    visited[static_cast<std::size_t>(neighbor)] != 0) {
+                    continue;
+                }
+                const auto neighbor_index{static_cast<std::size_t>(neighbor)};
+
+                // If orientations are inconsistent -> flip neighbor in the mesh
+                const Edge edge{make_edge(*corners[local_edge], *corners[(local_edge + 1) % 3])};
+                if (!are_orientations_consistent(triangle, triangles[neighbor_index], edge)) {
+                    mesh.FlipTriangle(neighbor_index);
+                    flipped.push_back(neighbor);
+                }
+
+                // Mark neighbor as visited and add it to the queue
+                visited[neighbor_index] = 1;
+                queue.push(neighbor_index);
+            }
+        }
+    });
+
+    // Merge the per-component lists into one ascending list of indices
+    std::vector<TriangleIndex> flipped_triangles;
+    for (const auto& flipped : flipped_per_component) {
+        flipped_triangles.insert(flipped_triangles.end(), flipped.begin(), flipped.end());
+    }
+    std::sort(flipped_triangles.begin(), flipped_triangles.end());
+    return flipped_triangles;
 }
 
 }  // namespace tsexam::problem1
@@ -1,6 +1,12 @@
 #pragma once
 
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "analysis_control.hpp"
 #include "geometry.hpp"
+#include "stl_io.hpp"
 #include "triangle_mesh.hpp"
 
 namespace tsexam::problem1 {
@@ -48,24 +54,74 @@ bool are_orientations_consistent(const Triangle&, const Triangle&, const Edge&);
  * connected component of the mesh and flips triangles as needed to enforce consistent orientation
  * across shared edges.
  *
- * Only triangles in the connected component containing the seed triangle are processed.
+ * Only triangles in the connected component containing the seed triangle are processed. The mesh
+ * itself is left unchanged; the flipped triangles are returned as copies.
  *
  * @param mesh Mesh whose triangles are to be reoriented
  * @param seed Index of the seed triangle
+ * @param control Stop token and progress callback checked per visited triangle (may be null)
  * @return List of triangles that were reoriented
+ *
+ * @throws AnalysisCancelled if the control requested a stop
+ */
+std::vector<Triangle> reorient_inconsistent_triangles(
+    const TriangleMesh&, std::size_t seed, const AnalysisControl* control = nullptr
+);
+
+/**
+ * @brief Writes reoriented triangles to an STL file
+ *
+ * The triangles go through a buffered `StlWriter` into a solid named "reoriented_triangles", as
+ * all the `export_inconsistent_triangles` overloads do.
+ *
+ * @param triangles Reoriented triangles, e.g. from `reorient_inconsistent_triangles`
+ * @param out Output stream (binary mode for `StlFormat::kBinary`)
+ * @param format STL encoding of the output
+ * @param control Stop token and progress callback checked per written triangle (may be null)
+ *
+ * @throws AnalysisCancelled if the control requested a stop; the output then holds a partial STL
+ *         file
  */
-std::vector<Triangle> reorient_inconsistent_triangles(TriangleMesh&, std::size_t seed);
+void write_reoriented_triangles(
+    std::span<const Triangle> triangles, std::ostream& out, StlFormat format,
+    const AnalysisControl* control = nullptr
+);
 
 /**
  * @brief Exports triangles with inconsistent orientations to an output stream
  *
  * The function identifies triangles with inconsistent orientation relative to the provided seed
- * triangle and writes them to the output stream in ASCII STL format.
+ * triangle and writes them to the output stream in ASCII (default) or binary STL format.
  *
  * @param mesh Mesh containing the triangles
  * @param seed Index of the seed triangle
  * @param out Output stream to write the exported triangles to
+ * @param format STL encoding of the output
+ * @param control Stop token and progress callback of the reorientation and export (may be null)
+ * @return Number of reoriented triangles written
+ *
+ * @throws AnalysisCancelled if the control requested a stop; the output may then hold a partial
+ *         STL file
+ */
+std::size_t export_inconsistent_triangles(
+    const TriangleMesh&, std::size_t seed, std::ostream& out, StlFormat format = StlFormat::kAscii,
+    const AnalysisControl* control = nullptr
+);
+
+/**
+ * @brief Reorients every connected component of a mesh in place
+ *
+ * Each connected component keeps the orientation of its smallest-index triangle and is traversed
+ * independently, in parallel across components. Triangles are flipped in the mesh as soon as they
+ * are reached, and every neighbor is checked against the current (possibly already flipped)
+ * orientation of the triangle it was reached from, so the whole component ends up consistently
+ * oriented. For a non-orientable component (e.g. a Möbius strip) some shared edges necessarily
+ * stay inconsistent.
+ *
+ * @param mesh Mesh whose triangles are reoriented in place
+ * @param num_threads Number of threads (0: one per hardware core)
+ * @return Indices of the flipped triangles in ascending order
  */
-void export_inconsistent_triangles(TriangleMesh&, std::size_t seed, std::ostream& out);
+std::vector<TriangleIndex> reorient_all_components(TriangleMesh&, std::size_t num_threads = 0);
 
 }  // namespace tsexam::problem1
@@ -1,151 +1,876 @@
 #include "stl_io.hpp"
 
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <charconv>
 #include <cctype>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <cmath>
 #include <cstring>
 #include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <system_error>
+
+#include "common/parallel.hpp"
 
 namespace tsexam::problem1 {
 
-std::vector<Triangle> parse_ascii_stl(std::istream& input) {
-    std::vector<Triangle> triangles{};
+namespace {
 
-    // Streaming parser state: collect three vertices per triangle
-    std::array<Point, 3> triangle_vertices{};  // three vertices of a triangle
-    std::size_t triangle_vertex_count{0};      // collected vertices count for current triangle
-    double coord_buffer[3]{};                  // buffer for x, y, z of a vertex
-    std::size_t coord_index{0};                // index into coord_buffer
-    std::size_t remaining_coords{0};  // number of coordinates left to read for the current vertex
+/// Size of the binary STL prefix: header followed by the uint32 triangle count (bytes)
+constexpr std::size_t kBinaryStlPrefixSize{kBinaryStlHeaderSize + sizeof(std::uint32_t)};
 
-    // Read chunks to avoid loading the full file in memory
-    std::string buffer;
-    buffer.reserve(1 << 16);  // 64KB buffer
-    char chunk[1 << 16];      // 64KB chunk
-
-    // Lambda: consume tokens from the buffer and parse triangles
-    auto consume_buffer = [&](bool eof) {
-        std::size_t cursor = 0;
-        const std::size_t buffer_size = buffer.size();
-
-        // Lambda: skip whitespace and advance the cursor to the start of the next token
-        auto skip_space = [&]() {
-            while (cursor < buffer_size &&
-                   std::isspace(static_cast<unsigned char>(buffer[cursor]))) {
-                ++cursor;
-            }
+/// Decodes a little-endian uint32 from 4 bytes, independent of the host byte order
+std::uint32_t decode_little_endian_uint32(const char* bytes) {
+    return static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[0])) |
+           static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[1])) << 8 |
+           static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[2])) << 16 |
+           static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[3])) << 24;
+}
+
+/// Decodes a little-endian IEEE-754 float from 4 bytes
+float decode_little_endian_float(const char* bytes) {
+    return std::bit_cast<float>(decode_little_endian_uint32(bytes));
+}
+
+/// Decodes the three vertices of one 50-byte binary STL record (the normal is skipped)
+template <typename Scalar>
+BasicTriangle<Scalar> decode_binary_stl_record(const char* record) {
+    // Record layout: normal (3 floats), vertex a, b, c (3 floats each), attribute (uint16)
+    const char* v{record + 3 * sizeof(float)};
+    auto coordinate = [](const char* p) {
+        return static_cast<Scalar>(decode_little_endian_float(p));
+    };
+    auto point = [v, &coordinate](std::size_t vertex) {
+        const char* p{v + 3 * sizeof(float) * vertex};
+        return BasicPoint<Scalar>{
+            coordinate(p), coordinate(p + sizeof(float)), coordinate(p + 2 * sizeof(float))
         };
+    };
+    return BasicTriangle<Scalar>{point(0), point(1), point(2)};
+}
+
+/// Returns the number of bytes between the current read position and the end of the stream, or -1
+/// if the stream is not seekable. The read position is left unchanged.
+std::streamoff remaining_stream_size(std::istream& input) {
+    const std::streampos start{input.tellg()};
+    if (start == std::streampos(-1)) {
+        return -1;
+    }
+    input.seekg(0, std::ios::end);
+    const std::streampos end{input.tellg()};
+    input.seekg(start);
+    if (end == std::streampos(-1)) {
+        return -1;
+    }
+    return end - start;
+}
+
+/**
+ * @brief Decides the STL encoding from the first bytes of the data
+ *
+ * @param prefix First bytes of the data (up to the 84-byte binary prefix)
+ * @param prefix_size Number of bytes available in `prefix`
+ * @param total_size Total size of the data in bytes, or -1 if unknown
+ * @return Detected STL format
+ */
+StlFormat detect_stl_format_from_prefix(
+    const char* prefix, std::size_t prefix_size, std::int64_t total_size
+) {
+    // Too short to hold a binary header -> must be ASCII (possibly empty)
+    if (prefix_size < kBinaryStlPrefixSize) {
+        return StlFormat::kAscii;
+    }
+
+    // File size consistent with the announced triangle count -> binary, even if the header starts
+    // with "solid" (many CAD exporters do that)
+    if (total_size >= 0) {
+        const std::uint64_t num_triangles{
+            decode_little_endian_uint32(prefix + kBinaryStlHeaderSize)
+        };
+        if (static_cast<std::uint64_t>(total_size) ==
+            kBinaryStlPrefixSize + kBinaryStlRecordSize * num_triangles) {
+            return StlFormat::kBinary;
+        }
+    }
+
+    // ASCII files start with the "solid" keyword (after optional whitespace)
+    const char* first{prefix};
+    const char* last{prefix + kBinaryStlPrefixSize};
+    const char* token{std::find_if(first, last, [](char c) {
+        return !std::isspace(static_cast<unsigned char>(c));
+    })};
+    if (last - token >= 5 && std::memcmp(token, "solid", 5) == 0) {
+        return StlFormat::kAscii;
+    }
+
+    // No keyword: treat as ASCII only if the prefix is plain text, otherwise as binary
+    const bool is_text{std::all_of(first, last, [](char c) {
+        const auto byte{static_cast<unsigned char>(c)};
+        return std::isprint(byte) || std::isspace(byte);
+    })};
+    return is_text ? StlFormat::kAscii : StlFormat::kBinary;
+}
+
+/// Builds the exception thrown when a binary STL holds fewer records than its header announces
+std::runtime_error truncated_binary_stl_error(std::uint64_t announced, std::uint64_t present) {
+    return std::runtime_error(
+        "binary STL is truncated: header announces " + std::to_string(announced) +
+        " triangles but only " + std::to_string(present) + " records are present"
+    );
+}
+
+/// True for the whitespace characters of the "C" locale (what `std::isspace` accepts by default),
+/// without the per-character locale lookup
+constexpr bool is_space(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * @brief Incremental ASCII STL tokenizer
+ *
+ * The tokenizer scans raw bytes for `vertex` tokens and groups every three vertices into a
+ * triangle.
+ * It works directly on the caller's memory: a memory-mapped file is consumed in one call, a stream
+ * is consumed chunk by chunk with the incomplete trailing token carried over by the caller.
+ */
+class AsciiStlTokenizer {
+public:
+    explicit AsciiStlTokenizer(std::vector<Triangle>& triangles) : triangles_(triangles) {}
+
+    /**
+     * @brief Consumes the tokens in [data, data + size)
+     *
+     * @param data Start of the bytes to consume
+     * @param size Number of bytes
+     * @param eof True if no more bytes follow, i.e. a token ending at `data + size` is complete
+     * @return Number of bytes consumed; the remaining bytes form an incomplete token that must be
+     *         passed again, followed by the next chunk
+     */
+    std::size_t Consume(const char* data, std::size_t size, bool eof) {
+        std::size_t cursor{0};
+
+        // Parsing stopped at a malformed number -> ignore the rest of the input
+        if (this->stopped_) {
+            return size;
+        }
 
         // Main token parsing loop: extract tokens and look for "vertex" to identify geometry lines
-        while (cursor < buffer_size) {
-            skip_space();
-            if (cursor >= buffer_size) {
+        while (cursor < size) {
+            // Skip whitespace and advance the cursor to the start of the next token
+            while (cursor < size && is_space(data[cursor])) {
+                ++cursor;
+            }
+            if (cursor >= size) {
                 break;
             }
 
             // Token starts at the current cursor position; find the end of the token by looking for
             // the next whitespace
-            const std::size_t token_start = cursor;
-            while (cursor < buffer_size &&
-                   !std::isspace(static_cast<unsigned char>(buffer[cursor]))) {
+            const std::size_t token_start{cursor};
+            while (cursor < size && !is_space(data[cursor])) {
                 ++cursor;
             }
 
-            // If not at EOF, we may have an incomplete token; keep it in the buffer for next chunk
-            if (cursor == buffer_size && !eof) {
-                buffer.erase(0, token_start);
-                return;
+            // If not at EOF, we may have an incomplete token; hand it back for the next chunk
+            if (cursor == size && !eof) {
+                return token_start;
             }
 
-            const std::size_t token_len = cursor - token_start;
+            const char* token{data + token_start};
+            const std::size_t token_len{cursor - token_start};
 
             // If we're in the middle of parsing vertex coordinates, parse the token as a number
-            if (remaining_coords > 0) {
-                // Parse coordinate value
-                char saved = buffer[cursor];
-                buffer[cursor] = '\0';
-                char* endptr = nullptr;
-                double value = std::strtod(buffer.data() + token_start, &endptr);
-                buffer[cursor] = saved;
-
-                if (endptr != buffer.data() + cursor) {
+            if (this->remaining_coords_ > 0) {
+                double value{0.};
+                if (!parse_coordinate(token, token_len, value)) {
                     // Malformed number -> stop parsing
-                    buffer.erase(0, token_start);
-                    return;
-                }
-
-                // Store the parsed coordinate value in the buffer
-                coord_buffer[coord_index++] = value;
-                if (--remaining_coords == 0) {
-                    triangle_vertices[triangle_vertex_count++] =
-                        Point{coord_buffer[0], coord_buffer[1], coord_buffer[2]};
-                    coord_index = 0;
-
-                    // If we have collected three vertices -> emit a triangle and reset
-                    if (triangle_vertex_count == 3) {
-                        triangles.push_back(
-                            {triangle_vertices[0], triangle_vertices[1], triangle_vertices[2]}
-                        );
-                        triangle_vertex_count = 0;
-                    }
+                    this->stopped_ = true;
+                    return size;
                 }
-            } else if (token_len == 6 &&
-                       std::memcmp(buffer.data() + token_start, "vertex", 6) == 0) {
+                this->AddCoordinate(value);
+            } else if (token_len == 6 && std::memcmp(token, "vertex", 6) == 0) {
                 // Geometry lines are prefixed by "vertex" -> parse the next three tokens as x y z
-                remaining_coords = 3;
-                coord_index = 0;
+                this->remaining_coords_ = 3;
+                this->coord_index_ = 0;
             }
         }
-        // All tokens consumed -> clear the buffer
-        buffer.clear();
-    };
+        // All tokens consumed
+        return size;
+    }
 
-    // Read the input stream in chunks and consume tokens to parse triangles
-    while (input.read(chunk, sizeof(chunk)), input.gcount() > 0) {
-        buffer.append(chunk, static_cast<std::size_t>(input.gcount()));
-        consume_buffer(false);
+    /**
+     * @brief Checks whether the tokenizer sits between two triangles
+     *
+     * @return true if no vertex or triangle is partially collected and parsing has not stopped
+     */
+    bool IsAtTriangleBoundary() const {
+        return !this->stopped_ && this->remaining_coords_ == 0 && this->triangle_vertex_count_ == 0;
     }
 
-    // Flush any remaining tokens at EOF
-    consume_buffer(true);
+    /**
+     * @brief Checks whether parsing stopped at a malformed number
+     *
+     * @return true if the rest of the input is ignored
+     */
+    bool IsStopped() const { return this->stopped_; }
+
+private:
+    /**
+     * @brief Parses a whole token as a floating point number
+     *
+     * The fast path is `std::from_chars`, which is locale-independent and bounded by the token (no
+     * NUL terminator needed, the token may live in read-only mapped memory). Tokens it does not
+     * accept completely (leading '+', hexadecimal floats, out-of-range values, malformed input)
+     * fall back to `std::strtod` on a NUL-terminated copy, so the accepted syntax and the parsed
+     * values are the same as with `std::strtod` alone.
+     *
+     * @return true if the complete token is a valid number
+     */
+    static bool parse_coordinate(const char* token, std::size_t token_len, double& value) {
+        const auto [end, error] = std::from_chars(token, token + token_len, value);
+        if (error == std::errc{} && end == token + token_len) {
+            return true;
+        }
 
-    return triangles;
+        char local[64];
+        std::string long_token;
+        char* text{local};
+        if (token_len < sizeof(local)) {
+            std::memcpy(local, token, token_len);
+            local[token_len] = '\0';
+        } else {
+            long_token.assign(token, token_len);
+            text = long_token.data();
+        }
+
+        char* endptr{nullptr};
+        value = std::strtod(text, &endptr);
+        return endptr == text + token_len;
+    }
+
+    /// Stores a parsed coordinate and emits a triangle once three full vertices are collected
+    void AddCoordinate(double value) {
+        this->coord_buffer_[this->coord_index_++] = value;
+        if (--this->remaining_coords_ > 0) {
+            return;
+        }
+
+        this->triangle_vertices_[this->triangle_vertex_count_++] =
+            Point{this->coord_buffer_[0], this->coord_buffer_[1], this->coord_buffer_[2]};
+        this->coord_index_ = 0;
+
+        // If we have collected three vertices -> emit a triangle and reset
+        if (this->triangle_vertex_count_ == 3) {
+            this->triangles_.push_back(
+                {this->triangle_vertices_[0], this->triangle_vertices_[1],
+                 this->triangle_vertices_[2]}
+            );
+            this->triangle_vertex_count_ = 0;
+        }
+    }
+
+    std::vector<Triangle>& triangles_;           //< output triangles
+    std::array<Point, 3> triangle_vertices_{};  //< three vertices of a triangle
+    std::size_t triangle_vertex_count_{0};      //< collected vertices count for current triangle
+    double coord_buffer_[3]{};                  //< buffer for x, y, z of a vertex
+    std::size_t coord_index_{0};                //< index into coord_buffer_
+    std::size_t remaining_coords_{0};  //< number of coordinates left to read for the current vertex
+    bool stopped_{false};              //< true once a malformed number was encountered
+};
+
+/// Number of bytes read from a stream at a time by the ASCII parsers
+constexpr std::size_t kAsciiReadChunkSize{1 << 16};
+
+/**
+ * @brief Reads the next chunk of an ASCII STL stream and consumes its complete tokens
+ *
+ * The chunk is read directly behind the incomplete token carried over from the previous chunk,
+ * and the new incomplete trailing token is moved to the front of the buffer. At the end of the
+ * stream the carried bytes are consumed as the last token.
+ *
+ * @param input Stream to read from
+ * @param tokenizer Tokenizer consuming the bytes
+ * @param buffer Read buffer, grown if a single token fills it (pathological input)
+ * @param carried Number of bytes of the incomplete token at the front of the buffer
+ * @return false once the end of the stream is reached and all bytes are consumed
+ */
+bool read_ascii_stl_chunk(
+    std::istream& input, AsciiStlTokenizer& tokenizer, std::vector<char>& buffer,
+    std::size_t& carried
+) {
+    if (buffer.size() - carried < kAsciiReadChunkSize / 2) {
+        buffer.resize(buffer.size() * 2);
+    }
+    input.read(buffer.data() + carried, static_cast<std::streamsize>(buffer.size() - carried));
+    const auto bytes_read{static_cast<std::size_t>(input.gcount())};
+    if (bytes_read == 0) {
+        // Flush any remaining tokens at EOF
+        tokenizer.Consume(buffer.data(), carried, true);
+        carried = 0;
+        return false;
+    }
+
+    // Consume complete tokens and move the incomplete trailing token to the front
+    const std::size_t available{carried + bytes_read};
+    const std::size_t consumed{tokenizer.Consume(buffer.data(), available, false)};
+    carried = available - consumed;
+    std::memmove(buffer.data(), buffer.data() + consumed, carried);
+    return true;
 }
 
-void write_triangle_in_ascii_stl(std::ostream& out, const Triangle& t) {
+/// Minimum number of bytes per chunk in the parallel ASCII parser (smaller inputs stay serial)
+constexpr std::size_t kMinAsciiChunkSize{1 << 16};
+
+/**
+ * @brief Splits ASCII STL text into chunks that end right after an `endfacet` token
+ *
+ * Each split point is the whitespace following the first complete `endfacet` token at or after an
+ * evenly spaced target offset, so no token straddles two chunks.
+ *
+ * @param text Complete ASCII STL data
+ * @param max_chunks Maximum number of chunks
+ * @return Offsets of the chunk starts, followed by `text.size()`
+ */
+std::vector<std::size_t> split_ascii_stl_at_facets(std::string_view text, std::size_t max_chunks) {
+    constexpr std::string_view kEndFacet{"endfacet"};
+
+    std::vector<std::size_t> boundaries{0};
+    for (std::size_t i = 1; i < max_chunks; ++i) {
+        std::size_t position{std::max(boundaries.back(), i * (text.size() / max_chunks))};
+
+        // Find the next "endfacet" that is a whole token: preceded and followed by whitespace
+        while ((position = text.find(kEndFacet, position)) != std::string_view::npos) {
+            const std::size_t token_end{position + kEndFacet.size()};
+            const bool starts_token{position == 0 || is_space(text[position - 1])};
+            if (starts_token && token_end < text.size() && is_space(text[token_end])) {
+                break;
+            }
+            position = token_end;
+        }
+
+        // No facet boundary left -> the last chunk extends to the end of the text
+        if (position == std::string_view::npos) {
+            break;
+        }
+        boundaries.push_back(position + kEndFacet.size());
+    }
+    boundaries.push_back(text.size());
+    return boundaries;
+}
+
+
+//----------------------------------------------
+// Writing
+//----------------------------------------------
+
+/// Size at which the STL writer hands its buffer to the stream (bytes)
+constexpr std::size_t kStlWriterBufferSize{std::size_t{1} << 16};
+
+/// Upper bound of the text of one ASCII facet (bytes)
+constexpr std::size_t kMaxStlRecordText{512};
+
+/// Appends a uint32 as 4 little-endian bytes, independent of the host byte order
+void append_little_endian_uint32(std::string& out, std::uint32_t value) {
+    const char bytes[4]{
+        static_cast<char>(value & 0xFFu), static_cast<char>((value >> 8) & 0xFFu),
+        static_cast<char>((value >> 16) & 0xFFu), static_cast<char>((value >> 24) & 0xFFu)
+    };
+    out.append(bytes, sizeof(bytes));
+}
+
+/// Appends a coordinate as a little-endian single precision float
+void append_little_endian_float(std::string& out, double value) {
+    append_little_endian_uint32(out, std::bit_cast<std::uint32_t>(static_cast<float>(value)));
+}
+
+/**
+ * @brief Appends a number formatted like `std::ostream << double` with default flags
+ *
+ * `std::to_chars` in general format with precision 6 is `%g`, which is what the default stream
+ * formatting produces, so the text is identical but skips the locale and stream machinery.
+ */
+void append_number(std::string& out, double value) {
+    constexpr int kPrecision{6};
+    char text[32];
+    const auto result{
+        std::to_chars(text, text + sizeof(text), value, std::chars_format::general, kPrecision)
+    };
+    out.append(text, result.ptr);
+}
+
+/// Unnormalized facet normal (b - a) x (c - a) of a triangle
+std::array<double, 3> facet_normal(const Triangle& t) {
     // Compute edge vectors
-    double v1[3]{t.b[0] - t.a[0], t.b[1] - t.a[1], t.b[2] - t.a[2]};
-    double v2[3]{t.c[0] - t.a[0], t.c[1] - t.a[1], t.c[2] - t.a[2]};
+    const double v1[3]{t.b[0] - t.a[0], t.b[1] - t.a[1], t.b[2] - t.a[2]};
+    const double v2[3]{t.c[0] - t.a[0], t.c[1] - t.a[1], t.c[2] - t.a[2]};
 
     // Cross product to get normal
-    double nx = v1[1] * v2[2] - v1[2] * v2[1];
-    double ny = v1[2] * v2[0] - v1[0] * v2[2];
-    double nz = v1[0] * v2[1] - v1[1] * v2[0];
+    return {
+        v1[1] * v2[2] - v1[2] * v2[1], v1[2] * v2[0] - v1[0] * v2[2],
+        v1[0] * v2[1] - v1[1] * v2[0]
+    };
+}
+
+/// Appends one ASCII STL facet; the normal is unnormalized, as computed from the vertex order
+void append_ascii_stl_facet(std::string& out, const Triangle& t) {
+    const std::array<double, 3> normal{facet_normal(t)};
+
+    // Lambda: append a keyword followed by three space-separated numbers
+    auto append_triple = [&out](std::string_view keyword, const std::array<double, 3>& values) {
+        out.append(keyword);
+        append_number(out, values[0]);
+        out.push_back(' ');
+        append_number(out, values[1]);
+        out.push_back(' ');
+        append_number(out, values[2]);
+        out.push_back('\n');
+    };
 
     // Emit facet
-    out << "  facet normal " << nx << ' ' << ny << ' ' << nz << '\n';
-    out << "    outer loop\n";
+    append_triple("  facet normal ", normal);
+    out.append("    outer loop\n");
+    append_triple("      vertex ", t.a);
+    append_triple("      vertex ", t.b);
+    append_triple("      vertex ", t.c);
+    out.append("    endloop\n");
+    out.append("  endfacet\n");
+}
+
+/// Appends one 50-byte binary STL record; the normal is normalized (zero for degenerate facets)
+void append_binary_stl_record(std::string& out, const Triangle& t) {
+    std::array<double, 3> normal{facet_normal(t)};
+    const double length{
+        std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2])
+    };
+    if (length > 0.) {
+        for (double& component : normal) {
+            component /= length;
+        }
+    }
+
+    for (const double component : normal) {
+        append_little_endian_float(out, component);
+    }
+    for (const Point* vertex : {&t.a, &t.b, &t.c}) {
+        for (const double coordinate : *vertex) {
+            append_little_endian_float(out, coordinate);
+        }
+    }
+    out.append(2, '\0');  // attribute byte count
+}
+
+/**
+ * @brief Reads the header and triangle count of a binary STL stream
+ *
+ * A stream whose size is known is checked against the count up front, so that a corrupt count does
+ * not trigger a huge allocation.
+ *
+ * @param input Stream positioned at the start of the binary STL data
+ * @return Number of triangle records announced by the header
+ *
+ * @throws std::runtime_error if the header is missing or the stream is too short for the count
+ */
+std::uint32_t read_binary_stl_prefix(std::istream& input) {
+    // Read the 80-byte header and the triangle count
+    char prefix[kBinaryStlPrefixSize];
+    if (!input.read(prefix, static_cast<std::streamsize>(kBinaryStlPrefixSize))) {
+        throw std::runtime_error("binary STL is truncated: missing 84-byte header");
+    }
+    const std::uint32_t num_triangles{decode_little_endian_uint32(prefix + kBinaryStlHeaderSize)};
+
+    const std::streamoff remaining{remaining_stream_size(input)};
+    const std::uint64_t required_size{kBinaryStlRecordSize * std::uint64_t{num_triangles}};
+    if (remaining >= 0 && static_cast<std::uint64_t>(remaining) < required_size) {
+        throw truncated_binary_stl_error(
+            num_triangles, static_cast<std::uint64_t>(remaining) / kBinaryStlRecordSize
+        );
+    }
+    return num_triangles;
+}
+
+/// Stream binary STL parser shared by the double and float entry points
+template <typename Scalar>
+std::vector<BasicTriangle<Scalar>> parse_binary_stl_records(std::istream& input) {
+    const std::uint32_t num_triangles{read_binary_stl_prefix(input)};
+
+    std::vector<BasicTriangle<Scalar>> triangles{};
+    triangles.reserve(num_triangles);
+
+    // Decode records in blocks to keep the number of stream reads low
+    constexpr std::size_t kRecordsPerBlock{1024};
+    std::vector<char> block(kRecordsPerBlock * kBinaryStlRecordSize);
+    std::size_t remaining_records{num_triangles};
+    while (remaining_records > 0) {
+        const std::size_t records{std::min(remaining_records, kRecordsPerBlock)};
+        input.read(block.data(), static_cast<std::streamsize>(records * kBinaryStlRecordSize));
+        const auto records_read{static_cast<std::size_t>(input.gcount()) / kBinaryStlRecordSize};
+
+        for (std::size_t i = 0; i < records_read; ++i) {
+            triangles.push_back(
+                decode_binary_stl_record<Scalar>(block.data() + i * kBinaryStlRecordSize)
+            );
+        }
+
+        // Stream ended before all announced records were read -> throw
+        if (records_read < records) {
+            throw truncated_binary_stl_error(num_triangles, triangles.size());
+        }
+        remaining_records -= records;
+    }
+
+    return triangles;
+}
+
+/// In-memory binary STL parser shared by the double and float entry points
+template <typename Scalar>
+std::vector<BasicTriangle<Scalar>> parse_binary_stl_records(std::string_view bytes) {
+    if (bytes.size() < kBinaryStlPrefixSize) {
+        throw std::runtime_error("binary STL is truncated: missing 84-byte header");
+    }
+    const std::uint32_t num_triangles{
+        decode_little_endian_uint32(bytes.data() + kBinaryStlHeaderSize)
+    };
+
+    // Records are decoded in place from the caller's memory
+    const std::size_t records_present{(bytes.size() - kBinaryStlPrefixSize) / kBinaryStlRecordSize};
+    if (records_present < num_triangles) {
+        throw truncated_binary_stl_error(num_triangles, records_present);
+    }
+
+    std::vector<BasicTriangle<Scalar>> triangles(num_triangles);
+    const char* record{bytes.data() + kBinaryStlPrefixSize};
+    for (BasicTriangle<Scalar>& triangle : triangles) {
+        triangle = decode_binary_stl_record<Scalar>(record);
+        record += kBinaryStlRecordSize;
+    }
+    return triangles;
+}
+
+}  // namespace
+
+StlFormat detect_stl_format(std::istream& input) {
+    const std::streampos start{input.tellg()};
+    const std::streamoff total_size{remaining_stream_size(input)};
 
-    out << "      vertex " << t.a[0] << ' ' << t.a[1] << ' ' << t.a[2] << '\n';
-    out << "      vertex " << t.b[0] << ' ' << t.b[1] << ' ' << t.b[2] << '\n';
-    out << "      vertex " << t.c[0] << ' ' << t.c[1] << ' ' << t.c[2] << '\n';
+    // Read the would-be binary prefix: 80-byte header + triangle count
+    char prefix[kBinaryStlPrefixSize]{};
+    input.read(prefix, static_cast<std::streamsize>(kBinaryStlPrefixSize));
+    const auto prefix_size{static_cast<std::size_t>(input.gcount())};
 
-    out << "    endloop\n";
-    out << "  endfacet\n";
+    // Restore the read position for the actual parser
+    input.clear();
+    if (start != std::streampos(-1)) {
+        input.seekg(start);
+    }
+
+    return detect_stl_format_from_prefix(
+        prefix, prefix_size, static_cast<std::int64_t>(total_size)
+    );
+}
+
+StlFormat detect_stl_format(std::string_view bytes) {
+    return detect_stl_format_from_prefix(
+        bytes.data(), bytes.size(), static_cast<std::int64_t>(bytes.size())
+    );
+}
+
+std::vector<Triangle> parse_ascii_stl(std::istream& input) {
+    std::vector<Triangle> triangles{};
+    AsciiStlTokenizer tokenizer(triangles);
+
+    // Read chunks to avoid loading the full file in memory
+    std::vector<char> buffer(kAsciiReadChunkSize);
+    std::size_t carried{0};  // bytes of the incomplete token at the front of the buffer
+    while (read_ascii_stl_chunk(input, tokenizer, buffer, carried)) {
+    }
+
+    return triangles;
+}
+
+std::vector<Triangle> parse_ascii_stl(std::string_view text) {
+    std::vector<Triangle> triangles{};
+    AsciiStlTokenizer tokenizer(triangles);
+    tokenizer.Consume(text.data(), text.size(), true);
+    return triangles;
+}
+
+std::vector<Triangle> parse_ascii_stl(std::string_view text, std::size_t num_threads) {
+    const std::size_t max_chunks{
+        std::min(common::resolve_thread_count(num_threads), text.size() / kMinAsciiChunkSize)
+    };
+    if (max_chunks <= 1) {
+        return parse_ascii_stl(text);
+    }
+
+    //----------------------------------------------
+    // Parse the chunks independently
+    //----------------------------------------------
+
+    const std::vector<std::size_t> boundaries{split_ascii_stl_at_facets(text, max_chunks)};
+    const std::size_t num_chunks{boundaries.size() - 1};
+
+    std::vector<std::vector<Triangle>> chunk_triangles(num_chunks);
+    std::vector<std::uint8_t> chunk_at_boundary(num_chunks, 0);  // ended between two triangles
+    std::vector<std::uint8_t> chunk_stopped(num_chunks, 0);      // hit a malformed number
+
+    common::parallel_for(num_chunks, num_threads, [&](std::size_t chunk) {
+        AsciiStlTokenizer tokenizer(chunk_triangles[chunk]);
+        const std::string_view bytes{
+            text.substr(boundaries[chunk], boundaries[chunk + 1] - boundaries[chunk])
+        };
+        tokenizer.Consume(bytes.data(), bytes.size(), true);
+        chunk_at_boundary[chunk] = tokenizer.IsAtTriangleBoundary() ? 1 : 0;
+        chunk_stopped[chunk] = tokenizer.IsStopped() ? 1 : 0;
+    });
+
+    //----------------------------------------------
+    // Concatenate in order
+    //----------------------------------------------
+
+    // A chunk parsed from a fresh state gives the serial result as long as every chunk before it
+    // ended between two triangles. Stop at the first chunk where that does not hold.
+    std::size_t total{0};
+    for (const auto& triangles : chunk_triangles) {
+        total += triangles.size();
+    }
+    std::vector<Triangle> triangles{};
+    triangles.reserve(total);
+
+    for (std::size_t chunk = 0; chunk < num_chunks; ++chunk) {
+        // Serial parsing stops at a malformed number -> so does the concatenation
+        if (chunk_stopped[chunk]) {
+            triangles.insert(
+                triangles.end(), chunk_triangles[chunk].begin(), chunk_triangles[chunk].end()
+            );
+            return triangles;
+        }
+
+        // A vertex or triangle continues into the next chunk (malformed facet) -> parse the rest
+        // serially from this chunk on, which starts from a clean state
+        if (!chunk_at_boundary[chunk] && chunk + 1 < num_chunks) {
+            std::vector<Triangle> rest{parse_ascii_stl(text.substr(boundaries[chunk]))};
+            triangles.insert(triangles.end(), rest.begin(), rest.end());
+            return triangles;
+        }
+
+        triangles.insert(
+            triangles.end(), chunk_triangles[chunk].begin(), chunk_triangles[chunk].end()
+        );
+    }
+    return triangles;
+}
+
+std::vector<Triangle> parse_binary_stl(std::istream& input) {
+    return parse_binary_stl_records<double>(input);
+}
+
+std::vector<Triangle> parse_binary_stl(std::string_view bytes) {
+    return parse_binary_stl_records<double>(bytes);
+}
+
+std::vector<TriangleF> parse_binary_stl_float(std::istream& input) {
+    return parse_binary_stl_records<float>(input);
+}
+
+std::vector<TriangleF> parse_binary_stl_float(std::string_view bytes) {
+    return parse_binary_stl_records<float>(bytes);
+}
+
+void write_triangle_in_ascii_stl(std::ostream& out, const Triangle& t) {
+    std::string facet;
+    append_ascii_stl_facet(facet, t);
+    out.write(facet.data(), static_cast<std::streamsize>(facet.size()));
 }
 
 void write_ascii_stl(
     std::ostream& out, std::string_view solid_name, std::span<const Triangle> triangles
 ) {
-    out << "solid " << solid_name << '\n';
+    StlWriter writer(out, StlFormat::kAscii, solid_name, triangles.size());
     // Emit the triangles
     for (const Triangle& t : triangles) {
-        write_triangle_in_ascii_stl(out, t);
+        writer.Write(t);
+    }
+    writer.Finish();
+}
+
+void write_binary_stl(
+    std::ostream& out, std::string_view solid_name, std::span<const Triangle> triangles
+) {
+    StlWriter writer(out, StlFormat::kBinary, solid_name, triangles.size());
+    for (const Triangle& t : triangles) {
+        writer.Write(t);
+    }
+    writer.Finish();
+}
+
+//----------------------------------------------
+// StlWriter
+//----------------------------------------------
+
+StlWriter::StlWriter(
+    std::ostream& out, StlFormat format, std::string_view name, std::size_t num_triangles
+)
+    : out_(out), format_(format), name_(name), num_triangles_(num_triangles) {
+    this->buffer_.reserve(kStlWriterBufferSize + kMaxStlRecordText);
+
+    if (this->format_ == StlFormat::kAscii) {
+        this->buffer_.append("solid ").append(this->name_).push_back('\n');
+        return;
+    }
+
+    if (num_triangles > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::invalid_argument("too many triangles for a binary STL file");
+    }
+    // Header: solid name truncated or zero-padded to 80 bytes, then the triangle count
+    std::string header(this->name_.substr(0, kBinaryStlHeaderSize));
+    header.resize(kBinaryStlHeaderSize, '\0');
+    this->buffer_.append(header);
+    append_little_endian_uint32(this->buffer_, static_cast<std::uint32_t>(num_triangles));
+}
+
+StlWriter::~StlWriter() {
+    if (!this->finished_) {
+        try {
+            this->Finish();
+        } catch (...) {
+            // Destructors must not throw; call Finish explicitly to observe errors
+        }
+    }
+}
+
+void StlWriter::Write(const Triangle& triangle) {
+    if (this->format_ == StlFormat::kAscii) {
+        append_ascii_stl_facet(this->buffer_, triangle);
+    } else {
+        append_binary_stl_record(this->buffer_, triangle);
+    }
+    ++this->num_written_;
+
+    if (this->buffer_.size() >= kStlWriterBufferSize) {
+        this->Flush();
+    }
+}
+
+void StlWriter::Finish() {
+    if (this->finished_) {
+        return;
+    }
+    this->finished_ = true;
+
+    if (this->format_ == StlFormat::kAscii) {
+        this->buffer_.append("endsolid ").append(this->name_).push_back('\n');
+    }
+    this->Flush();
+
+    if (this->format_ == StlFormat::kBinary && this->num_written_ != this->num_triangles_) {
+        throw std::logic_error(
+            "binary STL header announced " + std::to_string(this->num_triangles_) +
+            " triangles but " + std::to_string(this->num_written_) + " were written"
+        );
+    }
+    if (!this->out_) {
+        throw std::runtime_error("failed to write STL output");
+    }
+}
+
+void StlWriter::Flush() {
+    this->out_.write(this->buffer_.data(), static_cast<std::streamsize>(this->buffer_.size()));
+    this->buffer_.clear();
+}
+
+//----------------------------------------------
+// StlReader
+//----------------------------------------------
+
+/// Tokenizer and read buffer of an ASCII input
+struct StlReader::AsciiState {
+    /// Parsed triangles that were not handed out yet
+    std::vector<Triangle> pending;
+
+    /// Tokenizer appending to `pending`
+    AsciiStlTokenizer tokenizer{pending};
+
+    /// Read buffer
+    std::vector<char> buffer = std::vector<char>(kAsciiReadChunkSize);
+
+    /// Bytes of the incomplete token at the front of the buffer
+    std::size_t carried{0};
+
+    /// Set once the whole stream is consumed
+    bool at_end{false};
+};
+
+StlReader::StlReader(std::istream& input)
+    : input_(input), format_(detect_stl_format(input)) {
+    if (this->format_ == StlFormat::kBinary) {
+        this->num_records_ = read_binary_stl_prefix(input);
+        this->remaining_records_ = this->num_records_;
+    } else {
+        this->ascii_ = std::make_unique<AsciiState>();
+    }
+}
+
+StlReader::~StlReader() = default;
+
+std::size_t StlReader::Read(std::vector<Triangle>& triangles, std::size_t max_triangles) {
+    if (max_triangles == 0) {
+        throw std::invalid_argument("StlReader: at least one triangle must be requested");
+    }
+    triangles.clear();
+
+    //----------------------------------------------
+    // Binary: decode the next records
+    //----------------------------------------------
+
+    if (this->format_ == StlFormat::kBinary) {
+        const auto records{static_cast<std::size_t>(
+            std::min<std::uint64_t>(max_triangles, this->remaining_records_)
+        )};
+        this->record_bytes_.resize(records * kBinaryStlRecordSize);
+        this->input_.read(
+            this->record_bytes_.data(), static_cast<std::streamsize>(this->record_bytes_.size())
+        );
+        const auto records_read{
+            static_cast<std::size_t>(this->input_.gcount()) / kBinaryStlRecordSize
+        };
+
+        triangles.reserve(records_read);
+        for (std::size_t i = 0; i < records_read; ++i) {
+            const char* record{this->record_bytes_.data() + i * kBinaryStlRecordSize};
+            triangles.push_back(decode_binary_stl_record<double>(record));
+        }
+
+        // Stream ended before all announced records were read -> throw
+        if (records_read < records) {
+            throw truncated_binary_stl_error(
+                this->num_records_, this->num_records_ - this->remaining_records_ + records_read
+            );
+        }
+        this->remaining_records_ -= records;
+        return records;
+    }
+
+    //----------------------------------------------
+    // ASCII: tokenize until enough triangles are pending
+    //----------------------------------------------
+
+    AsciiState& state{*this->ascii_};
+    while (state.pending.size() < max_triangles && !state.at_end) {
+        state.at_end =
+            !read_ascii_stl_chunk(this->input_, state.tokenizer, state.buffer, state.carried);
     }
-    out << "endsolid " << solid_name << '\n';
+    const std::size_t count{std::min(max_triangles, state.pending.size())};
+    const auto split{state.pending.begin() + static_cast<std::ptrdiff_t>(count)};
+    triangles.assign(state.pending.begin(), split);
+    state.pending.erase(state.pending.begin(), split);
+    return count;
 }
 
 void convert_binary_stl_to_ascii(const std::string& binary_path, const std::string& ascii_path) {
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <istream>
+#include <memory>
 #include <ostream>
 #include <span>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -10,6 +14,41 @@
 
 namespace tsexam::problem1 {
 
+/// Size of the fixed header at the start of a binary STL file (bytes)
+constexpr std::size_t kBinaryStlHeaderSize{80};
+
+/// Size of one triangle record in a binary STL file: normal, three vertices, attribute (bytes)
+constexpr std::size_t kBinaryStlRecordSize{50};
+
+/// Encoding of an STL file
+enum class StlFormat {
+    kAscii = 0,   ///< text format with `facet` / `vertex` keywords
+    kBinary = 1,  ///< 80-byte header, uint32 triangle count, 50-byte triangle records
+};
+
+/**
+ * @brief Detects whether an STL stream is ASCII or binary encoded
+ *
+ * A stream whose size is exactly `84 + 50 * count` bytes (count taken from the binary header) is
+ * binary, even if its header starts with `solid` as some exporters write. Otherwise a stream that
+ * starts with `solid` or whose first 84 bytes are all printable text is ASCII; anything else is
+ * binary. The read position of the stream is restored before returning.
+ *
+ * @param input Input stream positioned at the start of the STL data
+ * @return Detected STL format
+ */
+StlFormat detect_stl_format(std::istream&);
+
+/**
+ * @brief Detects whether in-memory STL data (e.g. a memory-mapped file) is ASCII or binary
+ *
+ * Same rules as the stream overload, with the size of the view as the file size.
+ *
+ * @param bytes Complete STL data
+ * @return Detected STL format
+ */
+StlFormat detect_stl_format(std::string_view bytes);
+
 /**
  * @brief Parses an ASCII STL stream and extracts triangle geometry
  *
@@ -21,6 +60,157 @@ namespace tsexam::problem1 {
  */
 std::vector<Triangle> parse_ascii_stl(std::istream&);
 
+/**
+ * @brief Parses in-memory ASCII STL data and extracts triangle geometry
+ *
+ * Tokens are scanned directly over the provided bytes, without copying them into an intermediate
+ * buffer, which makes this the preferred entry point for memory-mapped files. The output is
+ * identical to the stream overload.
+ *
+ * @param text Complete ASCII STL data
+ * @return List of parsed triangles
+ */
+std::vector<Triangle> parse_ascii_stl(std::string_view text);
+
+/**
+ * @brief Parses in-memory ASCII STL data on several threads
+ *
+ * The text is split right after `endfacet` tokens into roughly equal chunks, the chunks are parsed
+ * concurrently and the per-chunk triangle lists are concatenated in order. The output is identical
+ * to the serial parser, including for malformed input: a chunk boundary that falls inside an
+ * incomplete facet makes the remainder parse serially, and a malformed number ends the output
+ * exactly where the serial parser stops. Inputs too small to be worth splitting are parsed
+ * serially.
+ *
+ * @param text Complete ASCII STL data
+ * @param num_threads Number of threads (0: one per hardware core)
+ * @return List of parsed triangles
+ */
+std::vector<Triangle> parse_ascii_stl(std::string_view text, std::size_t num_threads);
+
+/**
+ * @brief Parses a binary STL stream and extracts triangle geometry
+ *
+ * The 50-byte little-endian records are decoded straight into triangles; facet normals and
+ * attribute bytes are ignored.
+ *
+ * @param input Input stream containing binary STL data
+ * @return List of parsed triangles
+ *
+ * @throws std::runtime_error if the header is missing or the stream holds fewer triangle records
+ *         than the header announces
+ */
+std::vector<Triangle> parse_binary_stl(std::istream&);
+
+/**
+ * @brief Parses in-memory binary STL data (e.g. a memory-mapped file)
+ *
+ * The records are decoded in place from the provided bytes.
+ *
+ * @param bytes Complete binary STL data
+ * @return List of parsed triangles
+ *
+ * @throws std::runtime_error if the header is missing or the data holds fewer triangle records
+ *         than the header announces
+ */
+std::vector<Triangle> parse_binary_stl(std::string_view bytes);
+
+/**
+ * @brief Parses a binary STL stream into float triangles
+ *
+ * Same as `parse_binary_stl`, but keeps the float32 coordinates of the records as they are, at
+ * half the memory. Widening the result with `triangle_cast<double>` gives exactly the triangles of
+ * `parse_binary_stl`.
+ *
+ * @param input Input stream containing binary STL data
+ * @return List of parsed triangles
+ *
+ * @throws std::runtime_error if the header is missing or the stream holds fewer triangle records
+ *         than the header announces
+ */
+std::vector<TriangleF> parse_binary_stl_float(std::istream&);
+
+/**
+ * @brief Parses in-memory binary STL data into float triangles
+ *
+ * @param bytes Complete binary STL data
+ * @return List of parsed triangles
+ *
+ * @throws std::runtime_error if the header is missing or the data holds fewer triangle records
+ *         than the header announces
+ */
+std::vector<TriangleF> parse_binary_stl_float(std::string_view bytes);
+
+/**
+ * @brief Incremental STL reader for streaming triangles batch by batch
+ *
+ * The counterpart of `StlWriter` for inputs too large to hold as one triangle list. The encoding
+ * is detected with `detect_stl_format`, and every `Read` decodes at most the requested number of
+ * triangles: ASCII text is tokenized in 64 KB chunks, binary records are decoded straight from the
+ * stream. Concatenating the batches gives exactly the triangles of `parse_ascii_stl` or
+ * `parse_binary_stl` on the whole stream.
+ */
+class StlReader {
+public:
+    /**
+     * @brief Detects the encoding of an STL stream and reads a binary header
+     *
+     * @param input Input stream positioned at the start of the STL data (binary mode); it must
+     *        outlive the reader
+     *
+     * @throws std::runtime_error if a binary header is missing or the stream is shorter than the
+     *         records it announces
+     */
+    explicit StlReader(std::istream& input);
+
+    StlReader(const StlReader&) = delete;
+    StlReader& operator=(const StlReader&) = delete;
+
+    ~StlReader();
+
+    /**
+     * @brief Returns the detected encoding
+     *
+     * @return STL format of the input
+     */
+    StlFormat GetFormat() const { return format_; }
+
+    /**
+     * @brief Reads the next triangles
+     *
+     * @param triangles Replaced by the triangles read
+     * @param max_triangles Largest number of triangles to read (at least 1)
+     * @return Number of triangles read; fewer than `max_triangles` only at the end of the input,
+     *         and 0 once it is exhausted
+     *
+     * @throws std::invalid_argument if `max_triangles` is 0
+     * @throws std::runtime_error if a binary stream holds fewer records than its header announces
+     */
+    std::size_t Read(std::vector<Triangle>& triangles, std::size_t max_triangles);
+
+private:
+    /// Tokenizer state of an ASCII input
+    struct AsciiState;
+
+    /// Input stream
+    std::istream& input_;
+
+    /// Encoding of the input
+    StlFormat format_;
+
+    /// Number of records announced by a binary header
+    std::uint64_t num_records_{0};
+
+    /// Binary records that were not read yet
+    std::uint64_t remaining_records_{0};
+
+    /// Raw bytes of the binary records being decoded
+    std::vector<char> record_bytes_;
+
+    /// Tokenizer state (ASCII input only)
+    std::unique_ptr<AsciiState> ascii_;
+};
+
 /**
  * @brief Writes a single triangle to an output stream in ASCII STL format
  *
@@ -44,6 +234,97 @@ void write_triangle_in_ascii_stl(std::ostream&, const Triangle&);
  */
 void write_ascii_stl(std::ostream&, std::string_view name, std::span<const Triangle>);
 
+/**
+ * @brief Writes a collection of triangles to an output stream in binary STL format
+ *
+ * The 80-byte header holds the (truncated) solid name, followed by the triangle count and one
+ * 50-byte little-endian record per triangle: unit normal, three vertices (single precision) and a
+ * zero attribute.
+ *
+ * @param out Output stream to write to (should be opened in binary mode)
+ * @param name Name of the STL solid, stored in the header
+ * @param triangles Collection of triangles to emit
+ *
+ * @throws std::invalid_argument if there are more triangles than a binary STL can count
+ */
+void write_binary_stl(std::ostream&, std::string_view name, std::span<const Triangle>);
+
+/**
+ * @brief Buffered STL writer for streaming triangles one by one
+ *
+ * Output is assembled in an internal buffer and handed to the stream in large blocks, and ASCII
+ * coordinates are formatted with `std::to_chars` (six significant digits, the same text as the
+ * default `std::ostream` formatting). Triangles can therefore be streamed straight from their
+ * source (e.g. component indices into a mesh) without collecting them first.
+ *
+ * A binary STL stores the triangle count before the records, so the count must be announced up
+ * front. `Finish` writes the footer and flushes; it is called by the destructor if needed, but
+ * only an explicit call reports errors.
+ */
+class StlWriter {
+public:
+    /**
+     * @brief Starts an STL document and writes its header
+     *
+     * @param out Output stream to write to (binary mode for `StlFormat::kBinary`)
+     * @param format Encoding to write
+     * @param name Name of the STL solid
+     * @param num_triangles Number of triangles that will be written (checked for binary output)
+     *
+     * @throws std::invalid_argument if there are more triangles than a binary STL can count
+     */
+    StlWriter(
+        std::ostream& out, StlFormat format, std::string_view name, std::size_t num_triangles
+    );
+
+    StlWriter(const StlWriter&) = delete;
+    StlWriter& operator=(const StlWriter&) = delete;
+
+    /// Finishes the document if `Finish` was not called
+    ~StlWriter();
+
+    /**
+     * @brief Appends one triangle
+     *
+     * @param triangle Triangle to write
+     */
+    void Write(const Triangle& triangle);
+
+    /**
+     * @brief Writes the footer and flushes the buffer to the stream
+     *
+     * @throws std::logic_error if a binary document received a different number of triangles than
+     *         announced
+     * @throws std::runtime_error if the stream failed
+     */
+    void Finish();
+
+private:
+    /// Hands the buffered bytes to the stream
+    void Flush();
+
+    /// Output stream
+    std::ostream& out_;
+
+    /// Encoding being written
+    StlFormat format_;
+
+    /// Name of the solid (ASCII footer)
+    std::string name_;
+
+    /// Announced number of triangles
+    std::size_t num_triangles_;
+
+    /// Number of triangles written so far
+    std::size_t num_written_{0};
+
+    /// Pending output bytes
+    std::string buffer_;
+
+    /// Set once the footer is written
+    bool finished_{false};
+};
+
 /**
  * @brief Converts a binary STL file to an ASCII STL file
  *
@@ -0,0 +1,146 @@
+#include "thread_pool.hpp"
+
+#include <utility>
+
+#include "common/parallel.hpp"
+
+namespace tsexam::problem1 {
+
+namespace {
+
+/// Pool and worker index of the calling thread (null pool: not a worker)
+struct WorkerIdentity {
+    const ThreadPool* pool{nullptr};
+    std::size_t index{0};
+};
+
+thread_local WorkerIdentity current_worker{};
+
+}  // namespace
+
+ThreadPool::ThreadPool(std::size_t num_threads) {
+    const std::size_t thread_count{common::resolve_thread_count(num_threads)};
+    this->queues_.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        this->queues_.push_back(std::make_unique<TaskQueue>());
+    }
+    this->threads_.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        this->threads_.emplace_back([this, i]() { this->Run(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::unique_lock<std::mutex> lock(this->mutex_);
+        this->all_done_.wait(lock, [this]() { return this->num_pending_ == 0; });
+        this->stopping_ = true;
+    }
+    this->work_available_.notify_all();
+    for (std::thread& thread : this->threads_) {
+        thread.join();
+    }
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+    // Inside a worker of this pool -> own deque, otherwise round-robin
+    std::size_t index{0};
+    if (current_worker.pool == this) {
+        index = current_worker.index;
+    } else {
+        const std::lock_guard<std::mutex> lock(this->mutex_);
+        index = this->next_queue_;
+        this->next_queue_ = (this->next_queue_ + 1) % this->queues_.size();
+    }
+    {
+        TaskQueue& queue{*this->queues_[index]};
+        const std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    // Counted only once the task is in a deque, so a reserving worker always finds one
+    {
+        const std::lock_guard<std::mutex> lock(this->mutex_);
+        ++this->num_queued_;
+        ++this->num_pending_;
+    }
+    this->work_available_.notify_one();
+}
+
+void ThreadPool::Wait() {
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    this->all_done_.wait(lock, [this]() { return this->num_pending_ == 0; });
+    if (this->first_exception_) {
+        std::rethrow_exception(std::exchange(this->first_exception_, nullptr));
+    }
+}
+
+bool ThreadPool::TryTake(std::size_t index, std::function<void()>& task) {
+    // Own deque: newest task first
+    {
+        TaskQueue& own{*this->queues_[index]};
+        const std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // Steal the oldest task of the next non-empty deque
+    for (std::size_t offset = 1; offset < this->queues_.size(); ++offset) {
+        TaskQueue& victim{*this->queues_[(index + offset) % this->queues_.size()]};
+        const std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::Run(std::size_t index) {
+    current_worker = {this, index};
+    for (;;) {
+        // Reserve one queued task (or stop once none is left)
+        {
+            std::unique_lock<std::mutex> lock(this->mutex_);
+            this->work_available_.wait(lock, [this]() {
+                return this->stopping_ || this->num_queued_ > 0;
+            });
+            if (this->num_queued_ == 0) {
+                return;  // stopping and nothing left to run
+            }
+            --this->num_queued_;
+        }
+
+        // The reserved task is in some deque; another worker may take it first only with a
+        // reservation of its own, so this loop ends
+        std::function<void()> task;
+        while (!this->TryTake(index, task)) {
+            std::this_thread::yield();
+        }
+
+        try {
+            task();
+        } catch (...) {
+            const std::lock_guard<std::mutex> lock(this->mutex_);
+            if (!this->first_exception_) {
+                this->first_exception_ = std::current_exception();
+            }
+        }
+        task = nullptr;  // release captured state before reporting completion
+
+        bool all_done{false};
+        {
+            const std::lock_guard<std::mutex> lock(this->mutex_);
+            all_done = (--this->num_pending_ == 0);
+        }
+        if (all_done) {
+            this->all_done_.notify_all();
+        }
+    }
+}
+
+}  // namespace tsexam::problem1
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tsexam::problem1 {
+
+/**
+ * @brief Fixed-size thread pool with one task deque per worker and work stealing
+ *
+ * A task submitted from one of the pool's workers goes to the back of that worker's deque; tasks
+ * submitted from other threads are spread round-robin over the deques. A worker takes its own
+ * newest task first (the data it just produced is likely still in cache) and, once its deque is
+ * empty, steals the oldest task of another worker. Idle workers sleep until a task is submitted.
+ *
+ * If a task throws, the other tasks still run; the first exception is rethrown by `Wait`.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Starts the workers
+     *
+     * @param num_threads Number of worker threads (0: one per hardware core)
+     */
+    explicit ThreadPool(std::size_t num_threads = 0);
+
+    /**
+     * @brief Runs the pending tasks to completion and joins the workers
+     *
+     * An exception of a task that was not collected by `Wait` is dropped.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Returns the number of worker threads
+     *
+     * @return Number of workers
+     */
+    std::size_t GetThreadCount() const { return threads_.size(); }
+
+    /**
+     * @brief Queues a task
+     *
+     * Safe to call from any thread, including from inside a running task.
+     *
+     * @param task Callable to run on a worker
+     */
+    void Submit(std::function<void()> task);
+
+    /**
+     * @brief Blocks until every submitted task has finished
+     *
+     * Must not be called from inside a task of the same pool.
+     *
+     * @throws The first exception thrown by a task since the previous `Wait`
+     */
+    void Wait();
+
+private:
+    /// Task deque of one worker
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    /**
+     * @brief Worker loop: reserve a queued task, take it, run it
+     *
+     * @param index Index of the worker
+     */
+    void Run(std::size_t index);
+
+    /**
+     * @brief Takes a task: the newest of the worker's own deque, else the oldest of another one
+     *
+     * @param index Index of the worker
+     * @param task Receives the task
+     * @return True if a task was taken
+     */
+    bool TryTake(std::size_t index, std::function<void()>& task);
+
+    /// One task deque per worker
+    std::vector<std::unique_ptr<TaskQueue>> queues_;
+
+    /// Worker threads
+    std::vector<std::thread> threads_;
+
+    /// Guards the counters, the stop flag and the first exception
+    std::mutex mutex_;
+
+    /// Signaled when a task is queued or the pool stops
+    std::condition_variable work_available_;
+
+    /// Signaled when the last pending task finishes
+    std::condition_variable all_done_;
+
+    /// Tasks in the deques that no worker has reserved yet
+    std::size_t num_queued_{0};
+
+    /// Tasks submitted and not finished yet
+    std::size_t num_pending_{0};
+
+    /// Deque of the next task submitted from outside the pool
+    std::size_t next_queue_{0};
+
+    /// Set by the destructor once no task is pending
+    bool stopping_{false};
+
+    /// First exception thrown by a task since the previous `Wait`
+    std::exception_ptr first_exception_{nullptr};
+};
+
+}  // namespace tsexam::problem1
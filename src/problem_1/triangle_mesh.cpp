@@ -1,105 +1,884 @@
 #include "triangle_mesh.hpp"
 
+#include <algorithm>
+#include <filesystem>
 #include <fstream>
+#include <limits>
+#include <memory_resource>
+#include <optional>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 
+#include "mapped_file.hpp"
 #include "stl_io.hpp"
+#include "triangle_validation.hpp"
 
 namespace tsexam::problem1 {
 
-TriangleMesh::TriangleMesh(const std::string& path) {
-    //----------------------------------------------
-    // Checks
-    //----------------------------------------------
+namespace {
+
+/**
+ * @brief Records that a triangle uses an edge in an edge-to-triangle connectivity map
+ *
+ * @param connectivity Connectivity map (coordinate or packed vertex-index edge keys)
+ * @param edge Canonical edge key
+ * @param triangle_index Index of the triangle using the edge
+ *
+ * @throws std::invalid_argument if the edge is already shared by 2 triangles (non-manifold)
+ */
+template <typename ConnectivityMap, typename Key>
+void add_triangle_to_edge(
+    ConnectivityMap& connectivity, const Key& edge, TriangleIndex triangle_index
+) {
+    // Try to insert the edge into the edge-to-triangle connectivity map
+    // should work for the first time
+    auto [it, inserted] = connectivity.try_emplace(
+        edge,  // edge to be inserted into unordered map
+        std::array<TriangleIndex, 2>{
+            triangle_index,         // index 1: current triangle index
+            kBoundaryTriangleIndex  // index 2: boundary triangle index
+        }
+    );
+
+    // above insertion failed -> edge is already in the connectivity map
+    // we need to check if the edge is shared by 3 or more triangles
+    if (!inserted) {
+        // Check for NON-MANIFOLD edges (shared by 3 or more triangles) -> throw
+        // Logic: if the second connection slot is NOT the boundary triangle index (i.e. we
+        // cannot insert the current triangle index into the second position), then the edge
+        // must be shared by 3 or more triangles
+        if (it->second[1] != kBoundaryTriangleIndex) {
+            throw std::invalid_argument(
+                "non-manifold mesh detected: edge shared by more than 2 triangles"
+            );
+        }
+        // Edge is already in the connectivity map -> add current triangle index to second
+        // position -- at this point, the edge degree is 2 i.e. shared by 2 triangles -- next
+        // insertion attempt will throw
+        it->second[1] = triangle_index;
+    }
+}
+
+/**
+ * @brief Counts a rehash of a connectivity map if the last insertion changed its bucket count
+ *
+ * @param connectivity Connectivity map
+ * @param bucket_count Bucket count before the insertion, updated to the current one
+ * @param rehash_count Number of rehashes so far
+ */
+template <typename ConnectivityMap>
+void track_rehash(
+    const ConnectivityMap& connectivity, std::size_t& bucket_count, std::size_t& rehash_count
+) {
+    if (connectivity.bucket_count() != bucket_count) {
+        bucket_count = connectivity.bucket_count();
+        ++rehash_count;
+    }
+}
+
+/**
+ * @brief Records the figures of a connectivity hash map after its build
+ *
+ * @param stats Stats sink (may be null)
+ * @param connectivity Connectivity map
+ * @param rehash_count Number of rehashes during the build
+ */
+template <typename ConnectivityMap>
+void record_edge_map_stats(
+    PipelineStats* stats, const ConnectivityMap& connectivity, std::size_t rehash_count
+) {
+    record_stats(stats, [&](PipelineStats& s) {
+        s.edge_map_size = connectivity.size();
+        s.edge_map_bucket_count = connectivity.bucket_count();
+        s.edge_map_load_factor = static_cast<double>(connectivity.load_factor());
+        s.edge_map_rehash_count = rehash_count;
+    });
+}
+
+/// One triangle edge in the flat record array of the sorted edge engine
+struct EdgeRecord {
+    EdgeKey key;               ///< packed vertex-index edge
+    TriangleIndex triangle;    ///< triangle using the edge
+    std::uint32_t local_edge;  ///< local edge number within the triangle (0, 1 or 2)
+};
+
+/**
+ * @brief Sorts edge records by key with a stable LSD radix sort
+ *
+ * The 64-bit key is sorted one byte at a time. All byte histograms are gathered in a single pass
+ * up front, and passes whose byte is the same for every record (e.g. the upper bytes of the
+ * vertex ids of a small mesh) are skipped. Being stable, records with equal keys keep their input
+ * order.
+ *
+ * @param records Records to sort in place (the scratch buffer uses the same memory resource)
+ */
+void radix_sort_edge_records(std::pmr::vector<EdgeRecord>& records) {
+    constexpr std::size_t kDigitBits{8};
+    constexpr std::size_t kNumBuckets{std::size_t{1} << kDigitBits};
+    constexpr std::size_t kNumPasses{8 * sizeof(EdgeKey) / kDigitBits};
+
+    // Lambda: digit of a key for a given pass
+    auto digit = [](EdgeKey key, std::size_t pass) -> std::size_t {
+        return static_cast<std::size_t>((key >> (pass * kDigitBits)) & (kNumBuckets - 1));
+    };
+
+    std::vector<std::array<std::size_t, kNumBuckets>> counts(kNumPasses);
+    for (const EdgeRecord& record : records) {
+        for (std::size_t pass = 0; pass < kNumPasses; ++pass) {
+            ++counts[pass][digit(record.key, pass)];
+        }
+    }
+
+    std::pmr::vector<EdgeRecord> buffer(records.size(), records.get_allocator());
+    for (std::size_t pass = 0; pass < kNumPasses; ++pass) {
+        auto& offsets = counts[pass];
+
+        // Every record has the same digit -> pass would not change the order
+        if (std::find(offsets.begin(), offsets.end(), records.size()) != offsets.end()) {
+            continue;
+        }
+
+        // Exclusive prefix sum: bucket counts -> first output position of each bucket
+        std::size_t offset{0};
+        for (std::size_t& bucket : offsets) {
+            offset += std::exchange(bucket, offset);
+        }
+
+        for (const EdgeRecord& record : records) {
+            buffer[offsets[digit(record.key, pass)]++] = record;
+        }
+        records.swap(buffer);
+    }
+}
+
+/**
+ * @brief Converts parsed double triangles to the coordinate type of a mesh
+ *
+ * @param triangles Parsed triangles
+ * @return The triangles unchanged for double meshes, rounded to nearest for float meshes
+ */
+template <typename Scalar>
+std::vector<BasicTriangle<Scalar>> to_mesh_triangles(std::vector<Triangle> triangles) {
+    if constexpr (std::is_same_v<Scalar, double>) {
+        return triangles;
+    } else {
+        std::vector<BasicTriangle<Scalar>> converted;
+        converted.reserve(triangles.size());
+        for (const Triangle& triangle : triangles) {
+            converted.push_back(triangle_cast<Scalar>(triangle));
+        }
+        return converted;
+    }
+}
+
+/**
+ * @brief Parses binary STL data into triangles of a mesh's coordinate type
+ *
+ * Float meshes decode the float32 records directly, without a double intermediate.
+ *
+ * @param source Input stream or in-memory bytes of a binary STL file
+ * @return Parsed triangles
+ */
+template <typename Scalar, typename Source>
+std::vector<BasicTriangle<Scalar>> parse_binary_stl_as(Source&& source) {
+    if constexpr (std::is_same_v<Scalar, float>) {
+        return parse_binary_stl_float(source);
+    } else {
+        return to_mesh_triangles<Scalar>(parse_binary_stl(source));
+    }
+}
+
+/// Triangles decoded between two parse checkpoints of the path constructor
+constexpr std::size_t kParseBatchTriangles{std::size_t{1} << 16};
+
+/**
+ * @brief Parses an ASCII or binary STL stream in batches, checkpointing after every batch
+ *
+ * @param input STL stream (binary mode)
+ * @param num_bytes Size of the stream, the total of the parse progress
+ * @param control Stop token and progress callback
+ * @return Parsed triangles, identical to `parse_ascii_stl` or `parse_binary_stl`
+ *
+ * @throws AnalysisCancelled if the control requested a stop
+ * @throws std::runtime_error if a binary stream is truncated
+ */
+std::vector<Triangle> parse_stl_with_checkpoints(
+    std::istream& input, std::size_t num_bytes, const AnalysisControl& control
+) {
+    control.Checkpoint(AnalysisStage::kParse, 0, num_bytes);
+    StlReader reader(input);
+    std::vector<Triangle> triangles;
+    std::vector<Triangle> batch;
+    while (reader.Read(batch, kParseBatchTriangles) > 0) {
+        triangles.insert(triangles.end(), batch.begin(), batch.end());
+
+        // The position is unknown (-1) once the reader hit the end of the stream
+        const std::streamoff position{input.tellg()};
+        const auto bytes_read{static_cast<std::size_t>(position)};
+        if (position >= 0 && bytes_read < num_bytes) {
+            control.Checkpoint(AnalysisStage::kParse, bytes_read, num_bytes);
+        }
+    }
+    control.Checkpoint(AnalysisStage::kParse, num_bytes, num_bytes);
+    return triangles;
+}
+
+/**
+ * @brief Returns the canonical edges of a triangle in local edge order (a-b, b-c, c-a)
+ *
+ * @param triangle Triangle
+ * @return Canonical edges 0, 1 and 2
+ */
+template <typename Scalar>
+std::array<BasicEdge<Scalar>, 3> triangle_edges(const BasicTriangle<Scalar>& triangle) {
+    return {
+        make_edge<Scalar>(triangle.a, triangle.b),  // edge 1
+        make_edge<Scalar>(triangle.b, triangle.c),  // edge 2
+        make_edge<Scalar>(triangle.c, triangle.a)   // edge 3
+    };
+}
+
+/**
+ * @brief Adds the coordinate edges of every triangle to an edge-to-triangle connectivity map
+ *
+ * @param connectivity Empty connectivity map keyed by coordinate edges
+ * @param triangles Triangles of the mesh
+ * @param stats Sink for the hash map figures (may be null)
+ * @param control Stop token and progress callback checked per triangle (may be null)
+ *
+ * @throws AnalysisCancelled if the control requested a stop
+ * @throws std::invalid_argument if an edge is shared by more than 2 triangles
+ */
+template <typename ConnectivityMap, typename Scalar>
+void add_coordinate_edges(
+    ConnectivityMap& connectivity, const std::vector<BasicTriangle<Scalar>>& triangles,
+    PipelineStats* stats, const AnalysisControl* control
+) {
+    const std::size_t num_triangles{triangles.size()};
+    std::size_t bucket_count{connectivity.bucket_count()};
+    std::size_t rehash_count{0};
+
+    // For each triangle, add its 3 edges to the edge-to-triangle connectivity map
+    for (std::size_t i = 0; i < num_triangles; ++i) {
+        checkpoint(control, AnalysisStage::kConnectivity, i, num_triangles);
+        const std::array<BasicEdge<Scalar>, 3> edges{triangle_edges(triangles[i])};
+
+        // For each edge, add the triangle index to the edge-to-triangle connectivity map
+        for (const BasicEdge<Scalar>& edge : edges) {
+            add_triangle_to_edge(connectivity, edge, static_cast<TriangleIndex>(i));
+            if constexpr (kStatsEnabled) {
+                if (stats != nullptr) {
+                    track_rehash(connectivity, bucket_count, rehash_count);
+                }
+            }
+        }
+    }
+    checkpoint(control, AnalysisStage::kConnectivity, num_triangles, num_triangles);
+    record_edge_map_stats(stats, connectivity, rehash_count);
+}
 
-    std::ifstream file(path);
+/**
+ * @brief Rejects edits of a mesh whose engine cannot be updated in place
+ *
+ * Only the coordinate-keyed map can take new edges without the welding map, which the indexed
+ * engines drop after their build.
+ *
+ * @param engine Connectivity engine of the mesh
+ *
+ * @throws std::logic_error unless the engine is `ConnectivityEngine::kEdgeHashMap`
+ */
+void require_editable_engine(ConnectivityEngine engine) {
+    if (engine != ConnectivityEngine::kEdgeHashMap) {
+        throw std::logic_error("mesh edits require the kEdgeHashMap connectivity engine");
+    }
+}
+
+/**
+ * @brief Returns the memory resource selected by the load options
+ *
+ * @param options Load options
+ * @return `options.memory_resource`, or the default resource if it is null
+ */
+std::pmr::memory_resource* memory_resource_of(const TriangleMeshOptions& options) {
+    return (options.memory_resource != nullptr) ? options.memory_resource
+                                                : std::pmr::get_default_resource();
+}
+
+}  // namespace
+
+template <typename Scalar>
+BasicTriangleMesh<Scalar>::BasicTriangleMesh(
+    const std::string& path, const TriangleMeshOptions& options
+)
+    : connectivity_engine_(options.connectivity),
+      edge_connectivity_(typename EdgeMap::allocator_type{memory_resource_of(options)}),
+      flat_edge_connectivity_(typename FlatEdgeMap::allocator_type{memory_resource_of(options)}),
+      indexed_edge_connectivity_(
+          typename IndexedEdgeMap::allocator_type{memory_resource_of(options)}
+      ) {
+    // Binary mode so that binary records are read verbatim; the ASCII parser treats '\r' as
+    // whitespace
+    std::ifstream file(path, std::ios::binary);
     if (!file) {
         throw std::invalid_argument("failed to open STL file: " + path);
     }
-    this->triangles_ = parse_ascii_stl(file);
+    const auto num_bytes{static_cast<std::size_t>(std::filesystem::file_size(path))};
+    {
+        const ScopedStageTimer timer(options.stats, &PipelineStats::parse_time);
+        if (options.control != nullptr) {
+            // Batched reads so that a stop request interrupts the parse
+            this->triangles_ = to_mesh_triangles<Scalar>(
+                parse_stl_with_checkpoints(file, num_bytes, *options.control)
+            );
+        } else {
+            this->triangles_ = (detect_stl_format(file) == StlFormat::kBinary)
+                                   ? parse_binary_stl_as<Scalar>(file)
+                                   : to_mesh_triangles<Scalar>(parse_ascii_stl(file));
+        }
+    }
+    record_stats(options.stats, [&](PipelineStats& s) {
+        s.bytes_parsed += num_bytes;
+        s.triangles_parsed += this->triangles_.size();
+    });
+    this->Initialize(options.stats, options.num_threads, options.control);
+}
+
+template <typename Scalar>
+BasicTriangleMesh<Scalar>::BasicTriangleMesh(
+    std::vector<TriangleType> triangles, const TriangleMeshOptions& options
+)
+    : triangles_(std::move(triangles)),
+      connectivity_engine_(options.connectivity),
+      edge_connectivity_(typename EdgeMap::allocator_type{memory_resource_of(options)}),
+      flat_edge_connectivity_(typename FlatEdgeMap::allocator_type{memory_resource_of(options)}),
+      indexed_edge_connectivity_(
+          typename IndexedEdgeMap::allocator_type{memory_resource_of(options)}
+      ) {
+    this->Initialize(options.stats, options.num_threads, options.control);
+}
+
+template <typename Scalar>
+BasicTriangleMesh<Scalar> BasicTriangleMesh<Scalar>::FromMappedFile(
+    const std::string& path, const TriangleMeshOptions& options
+) {
+    std::vector<TriangleType> triangles;
+    {
+        const ScopedStageTimer timer(options.stats, &PipelineStats::parse_time);
+        const MappedFile file(path);
+        const std::string_view bytes{file.GetData()};
+        triangles = (detect_stl_format(bytes) == StlFormat::kBinary)
+                        ? parse_binary_stl_as<Scalar>(bytes)
+                        : to_mesh_triangles<Scalar>(parse_ascii_stl(bytes, options.num_threads));
+        record_stats(options.stats, [&](PipelineStats& s) {
+            s.bytes_parsed += bytes.size();
+            s.triangles_parsed += triangles.size();
+        });
+    }
+    return BasicTriangleMesh(std::move(triangles), options);
+}
+
+template <typename Scalar>
+void BasicTriangleMesh<Scalar>::Initialize(
+    PipelineStats* stats, std::size_t num_threads, const AnalysisControl* control
+) {
+    //----------------------------------------------
+    // Checks
+    //----------------------------------------------
 
     // Empty mesh -> throw
     if (this->triangles_.empty()) {
         throw std::invalid_argument("triangle mesh cannot be empty");
     }
 
+    // Degenerate triangle validation is timed as its own stage (stopped after the loop)
+    std::optional<ScopedStageTimer> validation_timer{
+        std::in_place, stats, &PipelineStats::validation_time
+    };
+
     // Check for degenerate triangles (two vertices are the same or all three vertices lie on the
-    // same line) -> throw
-    for (std::size_t i = 0; i < this->triangles_.size(); ++i) {
-        const auto& t = this->triangles_[i];
+    // same line) -> throw; the parallel scan is only checked before and after
+    const std::size_t num_triangles{this->triangles_.size()};
+    checkpoint(control, AnalysisStage::kValidation, 0, num_triangles);
+    validate_triangles(this->triangles_, num_threads);
+    checkpoint(control, AnalysisStage::kValidation, num_triangles, num_triangles);
+    validation_timer.reset();
 
-        // Check if any two vertices are the same -> throw
-        if (t.a == t.b || t.b == t.c || t.c == t.a) {
-            throw std::invalid_argument(
-                "degenerate triangle at index " + std::to_string(i) + ": duplicate vertices"
+    // The neighbor table engine builds through the sorted edge table and drops it afterwards
+    const ConnectivityEngine requested_engine{this->connectivity_engine_};
+    if (requested_engine == ConnectivityEngine::kNeighborTable) {
+        this->connectivity_engine_ = ConnectivityEngine::kSortedEdges;
+    }
+
+    // Build connectivity and validate manifold assumptions
+    switch (this->connectivity_engine_) {
+        case ConnectivityEngine::kEdgeHashMap:
+            this->BuildEdgeToTriangleConnectivity(stats, control);
+            break;
+        case ConnectivityEngine::kFlatEdgeHashMap:
+            this->BuildFlatEdgeToTriangleConnectivity(stats, control);
+            break;
+        case ConnectivityEngine::kIndexedHashMap:
+            this->BuildIndexedRepresentation(stats, control);
+            this->BuildIndexedEdgeToTriangleConnectivity(stats, control);
+            break;
+        case ConnectivityEngine::kSortedEdges:
+        case ConnectivityEngine::kNeighborTable:
+            this->BuildIndexedRepresentation(stats, control);
+            this->BuildSortedEdgeToTriangleConnectivity(stats, control);
+            break;
+    }
+
+    // Resolve the neighbors once so that traversals do not repeat the edge lookups
+    this->BuildTriangleNeighbors(stats, control);
+
+    if (requested_engine == ConnectivityEngine::kNeighborTable) {
+        this->ReleaseEdgeTables();
+        this->connectivity_engine_ = requested_engine;
+    }
+}
+
+template <typename Scalar>
+void BasicTriangleMesh<Scalar>::ReleaseEdgeTables() {
+    // Swap with empty containers so that the memory is actually returned
+    std::vector<PointType>().swap(this->vertices_);
+    std::vector<std::array<VertexIndex, 3>>().swap(this->triangle_vertices_);
+    std::vector<EdgeKey>().swap(this->sorted_edge_keys_);
+    std::vector<std::array<TriangleIndex, 2>>().swap(this->sorted_edge_triangles_);
+    std::vector<std::array<std::uint32_t, 3>>().swap(this->triangle_edge_ids_);
+}
+
+template <typename Scalar>
+void BasicTriangleMesh<Scalar>::BuildEdgeToTriangleConnectivity(
+    PipelineStats* stats, const AnalysisControl* control
+) {
+    const ScopedStageTimer timer(stats, &PipelineStats::connectivity_time);
+    this->edge_connectivity_.clear();
+    this->edge_connectivity_.reserve(3 * this->triangles_.size());
+    add_coordinate_edges(this->edge_connectivity_, this->triangles_, stats, control);
+}
+
+template <typename Scalar>
+void BasicTriangleMesh<Scalar>::BuildFlatEdgeToTriangleConnectivity(
+    PipelineStats* stats, const AnalysisControl* control
+) {
+    const ScopedStageTimer timer(stats, &PipelineStats::connectivity_time);
+    this->flat_edge_connectivity_.clear();
+    // A closed mesh has exactly 3/2 edges per triangle; the slots cost room even when empty, so
+    // open meshes grow the table instead of every mesh reserving 3 edges per triangle
+    this->flat_edge_connectivity_.reserve(3 * this->triangles_.size() / 2);
+    add_coordinate_edges(this->flat_edge_connectivity_, this->triangles_, stats, control);
+}
+
+template <typename Scalar>
+void BasicTriangleMesh<Scalar>::BuildIndexedRepresentation(
+    PipelineStats* stats, const AnalysisControl* control
+) {
+    const ScopedStageTimer timer(stats, &PipelineStats::welding_time);
+    const std::size_t num_triangles{this->triangles_.size()};
+
+    // Single hash pass: each distinct point gets the next vertex index on first appearance
+    std::pmr::unordered_map<
+        PointType, VertexIndex, BasicPointHash<Scalar>, BasicPointEquality<Scalar>>
+        vertex_ids(this->MemoryResource());
+    vertex_ids.reserve(3 * num_triangles);
+
+    std::vector<PointType> vertices;
+    std::vector<std::array<VertexIndex, 3>> triangle_vertices(num_triangles);
+
+    // Lambda: return the vertex index of a point, adding it to the vertex buffer if new
+    auto weld = [&](const PointType& point) -> VertexIndex {
+        const auto next_index{static_cast<VertexIndex>(vertices.size())};
+        auto [it, inserted] = vertex_ids.try_emplace(point, next_index);
+        if (inserted) {
+            if (vertices.size() > std::numeric_limits<VertexIndex>::max()) {
+                throw std::invalid_argument("too many distinct vertices for 32-bit vertex indices");
+            }
+            vertices.push_back(point);
+        }
+        return it->second;
+    };
+
+    for (std::size_t i = 0; i < num_triangles; ++i) {
+        checkpoint(control, AnalysisStage::kWelding, i, num_triangles);
+        const TriangleType& triangle{this->triangles_[i]};
+        triangle_vertices[i] = {weld(triangle.a), weld(triangle.b), weld(triangle.c)};
+    }
+    checkpoint(control, AnalysisStage::kWelding, num_triangles, num_triangles);
+    record_stats(stats, [&vertices](PipelineStats& s) { s.vertices_welded = vertices.size(); });
+
+    this->vertices_ = std::move(vertices);
+    this->triangle_vertices_ = std::move(triangle_vertices);
+}
+
+template <typename Scalar>
+void BasicTriangleMesh<Scalar>::BuildIndexedEdgeToTriangleConnectivity(
+    PipelineStats* stats, const AnalysisControl* control
+) {
+    const ScopedStageTimer timer(stats, &PipelineStats::connectivity_time);
+    const std::size_t num_triangles{this->triangle_vertices_.size()};
+    this->indexed_edge_connectivity_.clear();
+    this->indexed_edge_connectivity_.reserve(3 * num_triangles);
+    std::size_t bucket_count{this->indexed_edge_connectivity_.bucket_count()};
+    std::size_t rehash_count{0};
+
+    // For each triangle, add its 3 packed edges to the edge-to-triangle connectivity map
+    for (std::size_t i = 0; i < num_triangles; ++i) {
+        checkpoint(control, AnalysisStage::kConnectivity, i, num_triangles);
+        const auto& [a, b, c] = this->triangle_vertices_[i];
+        for (const EdgeKey edge : {make_edge_key(a, b), make_edge_key(b, c), make_edge_key(c, a)}) {
+            add_triangle_to_edge(
+                this->indexed_edge_connectivity_, edge, static_cast<TriangleIndex>(i)
             );
+            if constexpr (kStatsEnabled) {
+                if (stats != nullptr) {
+                    track_rehash(this->indexed_edge_connectivity_, bucket_count, rehash_count);
+                }
+            }
         }
+    }
+    checkpoint(control, AnalysisStage::kConnectivity, num_triangles, num_triangles);
+    record_edge_map_stats(stats, this->indexed_edge_connectivity_, rehash_count);
+}
+
+template <typename Scalar>
+void BasicTriangleMesh<Scalar>::BuildSortedEdgeToTriangleConnectivity(
+    PipelineStats* stats, const AnalysisControl* control
+) {
+    const ScopedStageTimer timer(stats, &PipelineStats::connectivity_time);
+    const std::size_t num_triangles{this->triangle_vertices_.size()};
+
+    //----------------------------------------------
+    // Emit one record per triangle edge and sort
+    //----------------------------------------------
 
-        // More comprehensive and robust check than above:
-        // Check if vertices are lies on the same line i.e. area of triangle is zero
-        // Area = 0.5 * |(b-a) × (c-a)|
-        double v1[3] = {t.b[0] - t.a[0], t.b[1] - t.a[1], t.b[2] - t.a[2]};
-        double v2[3] = {t.c[0] - t.a[0], t.c[1] - t.a[1], t.c[2] - t.a[2]};
-        double cross_x = v1[1] * v2[2] - v1[2] * v2[1];
-        double cross_y = v1[2] * v2[0] - v1[0] * v2[2];
-        double cross_z = v1[0] * v2[1] - v1[1] * v2[0];
-        double area_squared = cross_x * cross_x + cross_y * cross_y + cross_z * cross_z;
-        if (area_squared < kTolerance * kTolerance) {
+    std::pmr::vector<EdgeRecord> records(this->MemoryResource());
+    records.reserve(3 * num_triangles);
+    for (std::size_t i = 0; i < num_triangles; ++i) {
+        checkpoint(control, AnalysisStage::kConnectivity, i, num_triangles);
+        const auto& vertices{this->triangle_vertices_[i]};
+        for (std::uint32_t local_edge = 0; local_edge < 3; ++local_edge) {
+            records.push_back(EdgeRecord{
+                make_edge_key(vertices[local_edge], vertices[(local_edge + 1) % 3]),
+                static_cast<TriangleIndex>(i), local_edge
+            });
+        }
+    }
+    radix_sort_edge_records(records);
+
+    //----------------------------------------------
+    // Collapse runs of equal keys into unique edges
+    //----------------------------------------------
+
+    std::vector<EdgeKey> edge_keys;
+    std::vector<std::array<TriangleIndex, 2>> edge_triangles;
+    std::vector<std::array<std::uint32_t, 3>> triangle_edge_ids(num_triangles);
+    edge_keys.reserve(records.size());
+    edge_triangles.reserve(records.size());
+
+    for (std::size_t begin = 0; begin < records.size();) {
+        std::size_t end{begin + 1};
+        while (end < records.size() && records[end].key == records[begin].key) {
+            ++end;
+        }
+
+        // Check for NON-MANIFOLD edges (shared by 3 or more triangles) -> throw
+        if (end - begin > 2) {
             throw std::invalid_argument(
-                "degenerate triangle at index " + std::to_string(i) +
-                ": vertices are co-linear (area is effectively zero)"
+                "non-manifold mesh detected: edge shared by more than 2 triangles"
             );
         }
+        if (edge_keys.size() > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::invalid_argument("too many distinct edges for 32-bit edge ids");
+        }
+
+        // Records of one edge are in triangle order (stable sort) -> same slots as the hash maps
+        const auto edge_id{static_cast<std::uint32_t>(edge_keys.size())};
+        edge_keys.push_back(records[begin].key);
+        edge_triangles.push_back(
+            {records[begin].triangle,
+             (end - begin == 2) ? records[begin + 1].triangle : kBoundaryTriangleIndex}
+        );
+        for (std::size_t r = begin; r < end; ++r) {
+            const auto triangle{static_cast<std::size_t>(records[r].triangle)};
+            triangle_edge_ids[triangle][records[r].local_edge] = edge_id;
+        }
+        begin = end;
     }
 
-    // Build connectivity and validate manifold assumptions
-    this->BuildEdgeToTriangleConnectivity();
+    checkpoint(control, AnalysisStage::kConnectivity, num_triangles, num_triangles);
+
+    edge_keys.shrink_to_fit();
+    edge_triangles.shrink_to_fit();
+    this->sorted_edge_keys_ = std::move(edge_keys);
+    this->sorted_edge_triangles_ = std::move(edge_triangles);
+    this->triangle_edge_ids_ = std::move(triangle_edge_ids);
 }
 
-void TriangleMesh::BuildEdgeToTriangleConnectivity() {
-    this->edge_connectivity_.clear();
-    this->edge_connectivity_.reserve(3 * this->triangles_.size());
+template <typename Scalar>
+void BasicTriangleMesh<Scalar>::BuildTriangleNeighbors(
+    PipelineStats* stats, const AnalysisControl* control
+) {
+    const ScopedStageTimer timer(stats, &PipelineStats::neighbor_table_time);
+    const std::size_t num_triangles{this->triangles_.size()};
+    std::vector<std::array<TriangleIndex, 3>> neighbors(num_triangles);
 
-    // For each triangle, add its 3 edges to the edge-to-triangle connectivity map
-    for (std::size_t i = 0; i < this->triangles_.size(); ++i) {
-        const auto& triangle = this->triangles_[i];
-        const std::array<Edge, 3> edges{
-            make_edge(triangle.a, triangle.b),  // edge 1
-            make_edge(triangle.b, triangle.c),  // edge 2
-            make_edge(triangle.c, triangle.a)   // edge 3
-        };
+    for (std::size_t i = 0; i < num_triangles; ++i) {
+        checkpoint(control, AnalysisStage::kNeighborTable, i, num_triangles);
+        for (std::size_t local_edge = 0; local_edge < 3; ++local_edge) {
+            const auto degree_of_edge{this->GetEdgeTriangles(i, local_edge)};
 
-        // For each edge, add the triangle index to the edge-to-triangle connectivity map
-        for (const Edge& edge : edges) {
-            // Try to insert the edge into the edge-to-triangle connectivity map
-            // should work for the first time
-            auto [it, inserted] = this->edge_connectivity_.try_emplace(
-                edge,  // edge to be inserted into unordered map
-                std::array<TriangleIndex, 2>{
-                    static_cast<TriangleIndex>(i),  // index 1: current triangle index
-                    kBoundaryTriangleIndex          // index 2: boundary triangle index
-                }
+            // Logic: Only 2 triangles share an edge -> one we are on OR neighbor triangle; a
+            // boundary (or unknown) edge keeps kBoundaryTriangleIndex
+            neighbors[i][local_edge] = (degree_of_edge[0] == static_cast<TriangleIndex>(i))
+                                           ? degree_of_edge[1]
+                                           : degree_of_edge[0];
+        }
+    }
+    checkpoint(control, AnalysisStage::kNeighborTable, num_triangles, num_triangles);
+    this->triangle_neighbors_ = std::move(neighbors);
+}
+
+template <typename Scalar>
+void BasicTriangleMesh<Scalar>::FlipTriangle(std::size_t triangle_index) {
+    TriangleType& triangle{this->triangles_[triangle_index]};
+    std::swap(triangle.b, triangle.c);
+
+    // a-b, b-c, c-a -> a-c, c-b, b-a: old edge 2 becomes edge 0 and old edge 0 becomes edge 2
+    if (!this->triangle_vertices_.empty()) {
+        auto& vertices{this->triangle_vertices_[triangle_index]};
+        std::swap(vertices[1], vertices[2]);
+    }
+    if (!this->triangle_edge_ids_.empty()) {
+        auto& edge_ids{this->triangle_edge_ids_[triangle_index]};
+        std::swap(edge_ids[0], edge_ids[2]);
+    }
+    if (!this->triangle_neighbors_.empty()) {
+        auto& neighbors{this->triangle_neighbors_[triangle_index]};
+        std::swap(neighbors[0], neighbors[2]);
+    }
+}
+
+template <typename Scalar>
+TriangleIndex BasicTriangleMesh<Scalar>::InsertTriangle(const TriangleType& triangle) {
+    require_editable_engine(this->connectivity_engine_);
+    const std::size_t index{this->triangles_.size()};
+    if (index >= static_cast<std::size_t>(std::numeric_limits<TriangleIndex>::max())) {
+        throw std::invalid_argument("too many triangles for 32-bit triangle indices");
+    }
+
+    //----------------------------------------------
+    // Checks (before anything is modified)
+    //----------------------------------------------
+
+    const TriangleDefect defect{classify_triangle(triangle)};
+    if (defect != TriangleDefect::kNone) {
+        const std::string prefix{"degenerate triangle at index " + std::to_string(index)};
+        throw std::invalid_argument(
+            prefix + ((defect == TriangleDefect::kDuplicateVertices)
+                          ? ": duplicate vertices"
+                          : ": vertices are co-linear (area is effectively zero)")
+        );
+    }
+    const std::array<EdgeType, 3> edges{triangle_edges(triangle)};
+    for (const EdgeType& edge : edges) {
+        const auto it{this->edge_connectivity_.find(edge)};
+        if (it != this->edge_connectivity_.end() && it->second[1] != kBoundaryTriangleIndex) {
+            throw std::invalid_argument(
+                "non-manifold mesh detected: edge shared by more than 2 triangles"
             );
+        }
+    }
 
-            // above insertion failed -> edge is already in the connectivity map
-            // we need to check if the edge is shared by 3 or more triangles
-            if (!inserted) {
-                // Check for NON-MANIFOLD edges (shared by 3 or more triangles) -> throw
-                // Logic: if the second connection slot is NOT the boundary triangle index (i.e. we
-                // cannot insert the current triangle index into the second position), then the edge
-                // must be shared by 3 or more triangles
-                if (it->second[1] != kBoundaryTriangleIndex) {
-                    throw std::invalid_argument(
-                        "non-manifold mesh detected: edge shared by more than 2 triangles"
-                    );
-                }
-                // Edge is already in the connectivity map -> add current triangle index to second
-                // position -- at this point, the edge degree is 2 i.e. shared by 2 triangles -- next
-                // insertion attempt will throw
-                it->second[1] = static_cast<TriangleIndex>(i);
+    //----------------------------------------------
+    // Link the triangle to the triangles across its edges
+    //----------------------------------------------
+
+    const auto self{static_cast<TriangleIndex>(index)};
+    std::array<TriangleIndex, 3> neighbors{
+        kBoundaryTriangleIndex, kBoundaryTriangleIndex, kBoundaryTriangleIndex
+    };
+    this->cached_components_.clear();  // edits invalidate the components of the cache
+    this->triangles_.push_back(triangle);
+    for (std::size_t local_edge = 0; local_edge < 3; ++local_edge) {
+        auto [it, inserted] = this->edge_connectivity_.try_emplace(
+            edges[local_edge], std::array<TriangleIndex, 2>{self, kBoundaryTriangleIndex}
+        );
+        if (!inserted) {
+            // The new index is the largest -> second slot, as a rebuild would order them
+            const TriangleIndex other{it->second[0]};
+            it->second[1] = self;
+            neighbors[local_edge] = other;
+            const auto other_index{static_cast<std::size_t>(other)};
+            this->triangle_neighbors_[other_index][this->FindLocalEdge(
+                other_index, edges[local_edge]
+            )] = self;
+        }
+    }
+    this->triangle_neighbors_.push_back(neighbors);
+    return self;
+}
+
+template <typename Scalar>
+void BasicTriangleMesh<Scalar>::RemoveTriangle(std::size_t triangle_index) {
+    require_editable_engine(this->connectivity_engine_);
+    const std::size_t num_triangles{this->triangles_.size()};
+    if (triangle_index >= num_triangles) {
+        throw std::invalid_argument(
+            "triangle index out of range: " + std::to_string(triangle_index)
+        );
+    }
+    if (num_triangles == 1) {
+        throw std::invalid_argument("triangle mesh cannot be empty");
+    }
+
+    //----------------------------------------------
+    // Unlink the removed triangle
+    //----------------------------------------------
+
+    this->cached_components_.clear();  // edits invalidate the components of the cache
+    const auto removed{static_cast<TriangleIndex>(triangle_index)};
+    for (const EdgeType& edge : triangle_edges(this->triangles_[triangle_index])) {
+        const auto it{this->edge_connectivity_.find(edge)};
+        std::array<TriangleIndex, 2>& slots{it->second};
+        if (slots[1] == kBoundaryTriangleIndex) {
+            this->edge_connectivity_.erase(it);  // boundary edge -> no triangle left on it
+            continue;
+        }
+        const TriangleIndex other{(slots[0] == removed) ? slots[1] : slots[0]};
+        slots = {other, kBoundaryTriangleIndex};
+        const auto other_index{static_cast<std::size_t>(other)};
+        this->triangle_neighbors_[other_index][this->FindLocalEdge(other_index, edge)] =
+            kBoundaryTriangleIndex;
+    }
+
+    //----------------------------------------------
+    // Move the last triangle into the freed index
+    //----------------------------------------------
+
+    const std::size_t last{num_triangles - 1};
+    if (triangle_index != last) {
+        const auto moved{static_cast<TriangleIndex>(last)};
+        const std::array<EdgeType, 3> edges{triangle_edges(this->triangles_[last])};
+        for (std::size_t local_edge = 0; local_edge < 3; ++local_edge) {
+            std::array<TriangleIndex, 2>& slots{
+                this->edge_connectivity_.find(edges[local_edge])->second
+            };
+            ((slots[0] == moved) ? slots[0] : slots[1]) = removed;
+            if (slots[1] != kBoundaryTriangleIndex && slots[0] > slots[1]) {
+                std::swap(slots[0], slots[1]);  // keep the smaller index first
+            }
+
+            const TriangleIndex other{this->triangle_neighbors_[last][local_edge]};
+            if (other != kBoundaryTriangleIndex) {
+                const auto other_index{static_cast<std::size_t>(other)};
+                this->triangle_neighbors_[other_index][this->FindLocalEdge(
+                    other_index, edges[local_edge]
+                )] = removed;
+            }
+        }
+        this->triangles_[triangle_index] = this->triangles_[last];
+        this->triangle_neighbors_[triangle_index] = this->triangle_neighbors_[last];
+    }
+    this->triangles_.pop_back();
+    this->triangle_neighbors_.pop_back();
+}
+
+template <typename Scalar>
+std::size_t BasicTriangleMesh<Scalar>::FindLocalEdge(
+    std::size_t triangle_index, const EdgeType& edge
+) const {
+    const std::array<EdgeType, 3> edges{triangle_edges(this->triangles_[triangle_index])};
+    const BasicEdgeEquality<Scalar> equal{};
+    for (std::size_t local_edge = 0; local_edge < 3; ++local_edge) {
+        if (equal(edges[local_edge], edge)) {
+            return local_edge;
+        }
+    }
+    return 0;  // unreachable for an edge taken from the connectivity of this triangle
+}
+
+template <typename Scalar>
+std::array<TriangleIndex, 2> BasicTriangleMesh<Scalar>::FindEdgeTriangles(EdgeKey edge) const {
+    constexpr std::array<TriangleIndex, 2> kUnknownEdge{
+        kBoundaryTriangleIndex, kBoundaryTriangleIndex
+    };
+
+    switch (this->connectivity_engine_) {
+        case ConnectivityEngine::kSortedEdges: {
+            const auto& keys{this->sorted_edge_keys_};
+            const auto it{std::lower_bound(keys.begin(), keys.end(), edge)};
+            if (it == keys.end() || *it != edge) {
+                return kUnknownEdge;
             }
+            return this->sorted_edge_triangles_[static_cast<std::size_t>(it - keys.begin())];
+        }
+        case ConnectivityEngine::kIndexedHashMap: {
+            const auto it{this->indexed_edge_connectivity_.find(edge)};
+            return (it == this->indexed_edge_connectivity_.end()) ? kUnknownEdge : it->second;
         }
+        case ConnectivityEngine::kEdgeHashMap:
+        case ConnectivityEngine::kNeighborTable:
+        case ConnectivityEngine::kFlatEdgeHashMap:
+            break;
     }
+    return kUnknownEdge;
 }
 
+template <typename Scalar>
+std::array<TriangleIndex, 2> BasicTriangleMesh<Scalar>::GetEdgeTriangles(
+    std::size_t triangle_index, std::size_t local_edge
+) const {
+    constexpr std::array<TriangleIndex, 2> kUnknownEdge{
+        kBoundaryTriangleIndex, kBoundaryTriangleIndex
+    };
+
+    // Lambda: look up an edge key in a connectivity map
+    auto find = [&kUnknownEdge](const auto& connectivity, const auto& edge) {
+        const auto it{connectivity.find(edge)};
+        return (it == connectivity.end()) ? kUnknownEdge : it->second;
+    };
+
+    if (this->connectivity_engine_ == ConnectivityEngine::kNeighborTable) {
+        if (this->triangle_neighbors_.empty()) {
+            return kUnknownEdge;
+        }
+        // Edge slots are filled in triangle order by every engine -> smaller index first
+        const auto self{static_cast<TriangleIndex>(triangle_index)};
+        const TriangleIndex other{this->triangle_neighbors_[triangle_index][local_edge]};
+        if (other == kBoundaryTriangleIndex) {
+            return {self, kBoundaryTriangleIndex};
+        }
+        return {std::min(self, other), std::max(self, other)};
+    }
+
+    if (this->connectivity_engine_ == ConnectivityEngine::kSortedEdges) {
+        if (this->triangle_edge_ids_.empty()) {
+            return kUnknownEdge;
+        }
+        return this->sorted_edge_triangles_[this->triangle_edge_ids_[triangle_index][local_edge]];
+    }
+
+    if (this->connectivity_engine_ == ConnectivityEngine::kIndexedHashMap) {
+        const auto& vertices{this->triangle_vertices_[triangle_index]};
+        return find(
+            this->indexed_edge_connectivity_,
+            make_edge_key(vertices[local_edge], vertices[(local_edge + 1) % 3])
+        );
+    }
+
+    const TriangleType& triangle{this->triangles_[triangle_index]};
+    const std::array<const PointType*, 3> corners{&triangle.a, &triangle.b, &triangle.c};
+    const EdgeType edge{make_edge<Scalar>(*corners[local_edge], *corners[(local_edge + 1) % 3])};
+    if (this->connectivity_engine_ == ConnectivityEngine::kFlatEdgeHashMap) {
+        return find(this->flat_edge_connectivity_, edge);
+    }
+    return find(this->edge_connectivity_, edge);
+}
+
+template class BasicTriangleMesh<double>;
+template class BasicTriangleMesh<float>;
+
 }  // namespace tsexam::problem1
@@ -3,14 +3,20 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <memory_resource>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "analysis_control.hpp"
+#include "flat_hash_map.hpp"
 #include "geometry.hpp"
+#include "pipeline_stats.hpp"
 
 namespace tsexam::problem1 {
 
+class MeshCacheAccess;
+
 /// Index type for triangles in the mesh (max ~2 billion triangles)
 using TriangleIndex = std::int32_t;
 
@@ -20,34 +26,161 @@ constexpr TriangleIndex kBoundaryTriangleIndex{static_cast<TriangleIndex>(-1)};
 /// Tolerance for floating point comparisons
 constexpr double kTolerance{1e-16};
 
+/// Data structure used to build and query the edge-to-triangle connectivity
+enum class ConnectivityEngine {
+    kEdgeHashMap = 0,      ///< hash map keyed by coordinate edges (`GetEdgeConnectivity`)
+    kIndexedHashMap = 1,   ///< welded vertices + hash map keyed by packed vertex-index edges
+    kSortedEdges = 2,      ///< welded vertices + radix-sorted flat edge table (no per-edge nodes)
+    kNeighborTable = 3,    ///< neighbor table only (sorted edge table dropped after the build)
+    kFlatEdgeHashMap = 4,  ///< open-addressing table keyed by coordinate edges (raw-bits hash)
+};
+
+/**
+ * @brief Options controlling how a BasicTriangleMesh is loaded and which connectivity it builds
+ */
+struct TriangleMeshOptions {
+    /// Connectivity engine to build at load time
+    ConnectivityEngine connectivity{ConnectivityEngine::kEdgeHashMap};
+
+    /// Number of threads for the parallel loading stages: ASCII parsing of mapped files and
+    /// triangle validation (0: one per hardware core)
+    std::size_t num_threads{0};
+
+    /// Sink for the load stage timings and counters (null: no stats are recorded)
+    PipelineStats* stats{nullptr};
+
+    /// Stop token and progress callback checked by the load stages (null: never stops): parsing
+    /// by the path constructor, validation, welding, connectivity and neighbor table.
+    /// `FromMappedFile` does not check its parse.
+    const AnalysisControl* control{nullptr};
+
+    /// Memory resource for the connectivity hash maps and the temporary build buffers (null: the
+    /// default resource). It must outlive the mesh.
+    std::pmr::memory_resource* memory_resource{nullptr};
+};
+
 /**
- * @brief Triangle mesh loaded from an ASCII STL file
+ * @brief Triangle mesh loaded from an ASCII or binary STL file
  *
  * The mesh stores a collection of triangles and provides functionality to build edge-to-triangle
  * connectivity information. Edges are treated in canonical form to ensure consistent
  * adjacency/connectivity mapping.
+ *
+ * Two connectivity engines are available (see `ConnectivityEngine`). The default keys edges by
+ * their coordinates. The indexed engine first welds identical points into a vertex buffer with
+ * `uint32` index triples per triangle, and keys edges by a packed 64-bit pair of vertex indices,
+ * which is about 5x smaller per edge and far cheaper to hash. The sorted engine uses the same
+ * welded vertices but replaces the node-based hash map with flat arrays: one (edge key, triangle)
+ * record per triangle edge is radix-sorted and adjacent records are paired into a table of unique
+ * edges, plus the edge id of every triangle edge. The neighbor table engine builds the same way but
+ * keeps only the triangle neighbor table, which is also what a mesh restored from a connectivity
+ * cache holds (see `mesh_cache.hpp`). The flat engine keeps the coordinate keys of the default
+ * engine but hashes the raw bits of their coordinates and stores them in an open-addressing table
+ * (see `flat_hash_map.hpp`). Traversals should use `GetEdgeTriangles`, which works with every
+ * engine.
+ *
+ * The mesh is templated on its coordinate type. `TriangleMesh` stores doubles; `TriangleMeshF`
+ * stores floats, halving the triangle and vertex memory. Binary STL coordinates are float32, so
+ * `TriangleMeshF` keeps them unchanged. Its validation widens them to double, and points are
+ * welded, ordered and compared exactly as their widened copies would be. The connectivity, the
+ * neighbor table and the components are therefore bit-identical to a `TriangleMesh` of the same
+ * float-sourced data. ASCII STL input is parsed as double and then rounded to float.
+ *
+ * The hash map engines allocate one node per edge or vertex. Those nodes, the hash map buckets and
+ * the temporary buffers of the connectivity build are drawn from `TriangleMeshOptions::
+ * memory_resource`, so a `std::pmr::monotonic_buffer_resource` turns them into a few large blocks
+ * that are released at once when the resource is destroyed. A copy of a mesh uses the default
+ * resource; a moved-to mesh keeps the resource of its source.
+ *
+ * @tparam Scalar Coordinate type (`double` or `float`)
  */
-class TriangleMesh {
+template <typename Scalar>
+class BasicTriangleMesh {
 public:
+    /// Coordinate type of the mesh
+    using ScalarType = Scalar;
+
+    /// Point type of the mesh
+    using PointType = BasicPoint<Scalar>;
+
+    /// Triangle type of the mesh
+    using TriangleType = BasicTriangle<Scalar>;
+
+    /// Coordinate edge type of the mesh
+    using EdgeType = BasicEdge<Scalar>;
+
+    /// Coordinate-keyed edge-to-triangle map of the `ConnectivityEngine::kEdgeHashMap` engine
+    using EdgeMap = std::pmr::unordered_map<
+        EdgeType, std::array<TriangleIndex, 2>, BasicEdgeHash<Scalar>, BasicEdgeEquality<Scalar>>;
+
+    /// Coordinate-keyed edge-to-triangle table of the `ConnectivityEngine::kFlatEdgeHashMap` engine
+    using FlatEdgeMap = FlatHashMap<
+        EdgeType, std::array<TriangleIndex, 2>, BasicEdgeBitsHash<Scalar>,
+        BasicEdgeEquality<Scalar>>;
+
+    /// Packed vertex-index edge-to-triangle map of the `ConnectivityEngine::kIndexedHashMap` engine
+    using IndexedEdgeMap = std::pmr::unordered_map<EdgeKey, std::array<TriangleIndex, 2>>;
+
     /**
      * @brief Constructs an empty triangle mesh
      */
-    TriangleMesh() = default;
+    BasicTriangleMesh() = default;
 
     /**
-     * @brief Constructs a mesh by parsing an ASCII STL file
+     * @brief Constructs a mesh by parsing an ASCII or binary STL file
      *
      * The file at the provided path is parsed and all triangles contained in the STL are loaded into
-     * the mesh.
+     * the mesh. The encoding is detected with `detect_stl_format`; binary records are decoded
+     * directly into the triangle list without going through text.
      *
-     * @param path Path to an ASCII STL file
+     * @param path Path to an ASCII or binary STL file
+     * @param options Load options
      *
-     * @throws std::runtime_error if the file cannot be opened or parsed
+     * @throws std::invalid_argument if the file cannot be opened or the mesh is invalid
+     * @throws std::runtime_error if a binary file is truncated
+     * @throws AnalysisCancelled if `options.control` requested a stop
      *
      * @note Constructor is explicit to avoid implicit conversion from path strings to mesh;
      *       constructing a mesh does I/O and parsing, so call sites should be explicit.
      */
-    explicit TriangleMesh(const std::string& path);
+    explicit BasicTriangleMesh(const std::string& path, const TriangleMeshOptions& options = {});
+
+    /**
+     * @brief Constructs a mesh from triangles that are already in memory
+     *
+     * The triangles go through the same validation and connectivity build as a mesh loaded from
+     * file.
+     *
+     * @param triangles Triangles of the mesh
+     * @param options Load options
+     *
+     * @throws std::invalid_argument if the mesh is empty, has degenerate triangles or non-manifold
+     *         edges
+     * @throws AnalysisCancelled if `options.control` requested a stop
+     */
+    explicit BasicTriangleMesh(
+        std::vector<TriangleType> triangles, const TriangleMeshOptions& options = {}
+    );
+
+    /**
+     * @brief Creates a mesh by memory-mapping an ASCII or binary STL file
+     *
+     * The file is mapped read-only and tokenized (ASCII) or decoded (binary) directly over the
+     * mapped bytes, so no stream buffer copies are made. Large ASCII files are parsed on
+     * `options.num_threads` threads. The resulting mesh is identical to the one produced by the
+     * path constructor.
+     *
+     * @param path Path to an ASCII or binary STL file
+     * @param options Load options
+     * @return Loaded mesh
+     *
+     * @throws std::runtime_error if the file cannot be mapped or a binary file is truncated
+     * @throws std::invalid_argument if the mesh is invalid
+     * @throws AnalysisCancelled if `options.control` requested a stop after the parse
+     */
+    static BasicTriangleMesh FromMappedFile(
+        const std::string& path, const TriangleMeshOptions& options = {}
+    );
 
     /**
      * @brief Builds the EDGE -> TRIANGLE connectivity map
@@ -55,35 +188,382 @@ public:
      * For each triangle in the mesh, its three edges are inserted into a connectivity map that
      * associates each canonical edge with the indices of triangles that share it. A manifold mesh
      * is guaranteed to have a maximum of 2 triangles sharing each edge.
+     *
+     * @param stats Sink for the build time and hash map figures (may be null)
+     * @param control Stop token and progress callback checked per triangle (may be null)
+     *
+     * @throws AnalysisCancelled if the control requested a stop
+     */
+    void BuildEdgeToTriangleConnectivity(
+        PipelineStats* stats = nullptr, const AnalysisControl* control = nullptr
+    );
+
+    /**
+     * @brief Builds the EDGE -> TRIANGLE connectivity in a flat coordinate-keyed table
+     *
+     * Same edges, triangle slots and non-manifold rejection as `BuildEdgeToTriangleConnectivity`,
+     * but the edges are hashed over the raw bits of their six coordinates (`BasicEdgeBitsHash`)
+     * and stored in an open-addressing table (`FlatHashMap`) instead of one node per edge. For
+     * meshes that keep exact coordinate keys without welding their vertices.
+     *
+     * @param stats Sink for the build time and hash table figures (may be null)
+     * @param control Stop token and progress callback checked per triangle (may be null)
+     *
+     * @throws AnalysisCancelled if the control requested a stop
+     * @throws std::invalid_argument if an edge is shared by more than 2 triangles
      */
-    void BuildEdgeToTriangleConnectivity();
+    void BuildFlatEdgeToTriangleConnectivity(
+        PipelineStats* stats = nullptr, const AnalysisControl* control = nullptr
+    );
+
+    /**
+     * @brief Welds identical points into a shared vertex buffer
+     *
+     * A single hash pass over all triangle corners assigns each distinct point a `VertexIndex` in
+     * order of first appearance and records the three vertex indices of every triangle. Points are
+     * welded on exact coordinate equality, the same equality used by the coordinate-keyed
+     * connectivity.
+     *
+     * @param stats Sink for the welding time and vertex count (may be null)
+     * @param control Stop token and progress callback checked per triangle (may be null)
+     *
+     * @throws AnalysisCancelled if the control requested a stop
+     * @throws std::invalid_argument if the mesh has more distinct points than `VertexIndex` can
+     *         address
+     */
+    void BuildIndexedRepresentation(
+        PipelineStats* stats = nullptr, const AnalysisControl* control = nullptr
+    );
+
+    /**
+     * @brief Builds the EDGE -> TRIANGLE connectivity keyed by packed vertex-index edges
+     *
+     * Requires the indexed representation (see `BuildIndexedRepresentation`). Non-manifold edges
+     * are rejected exactly as in `BuildEdgeToTriangleConnectivity`.
+     *
+     * @param stats Sink for the build time and hash map figures (may be null)
+     * @param control Stop token and progress callback checked per triangle (may be null)
+     *
+     * @throws AnalysisCancelled if the control requested a stop
+     * @throws std::invalid_argument if an edge is shared by more than 2 triangles
+     */
+    void BuildIndexedEdgeToTriangleConnectivity(
+        PipelineStats* stats = nullptr, const AnalysisControl* control = nullptr
+    );
+
+    /**
+     * @brief Builds the EDGE -> TRIANGLE connectivity as a radix-sorted flat edge table
+     *
+     * Requires the indexed representation (see `BuildIndexedRepresentation`). One record per
+     * triangle edge is emitted into a flat array and radix-sorted by packed edge key; the sort is
+     * stable, so records of the same edge stay in triangle order and the resulting adjacency is
+     * identical to the hash map engines. Runs of equal keys are then collapsed into unique edges.
+     * Non-manifold edges are rejected exactly as in `BuildEdgeToTriangleConnectivity`.
+     *
+     * @param stats Sink for the build time (may be null)
+     * @param control Stop token and progress callback checked per triangle (may be null)
+     *
+     * @throws AnalysisCancelled if the control requested a stop
+     * @throws std::invalid_argument if an edge is shared by more than 2 triangles
+     */
+    void BuildSortedEdgeToTriangleConnectivity(
+        PipelineStats* stats = nullptr, const AnalysisControl* control = nullptr
+    );
+
+    /**
+     * @brief Builds the TRIANGLE -> NEIGHBOR TRIANGLE table from the edge connectivity
+     *
+     * Resolves every triangle edge to the triangle on the other side once, so that traversals
+     * become plain array indexing instead of one edge lookup per visit. Called at load time after
+     * the connectivity of the selected engine is built.
+     *
+     * @param stats Sink for the build time (may be null)
+     * @param control Stop token and progress callback checked per triangle (may be null)
+     *
+     * @throws AnalysisCancelled if the control requested a stop
+     */
+    void BuildTriangleNeighbors(
+        PipelineStats* stats = nullptr, const AnalysisControl* control = nullptr
+    );
+
+    /**
+     * @brief Flips the orientation of a triangle in place
+     *
+     * Swaps the triangle's second and third vertices (see `flip_triangle`) and keeps the derived
+     * per-triangle data in step: the vertex indices, the sorted edge table ids and the neighbor
+     * table are permuted to the new local edge order (edge 1 is reversed, edges 0 and 2 swap
+     * places). The edge connectivity itself is unaffected, since edges are stored in canonical
+     * form. Flipping different triangles from different threads is safe.
+     *
+     * @param triangle_index Index of the triangle to flip
+     */
+    void FlipTriangle(std::size_t triangle_index);
+
+    /**
+     * @brief Appends a triangle and updates the connectivity around it
+     *
+     * The triangle gets index `GetTriangles().size()`. Its three edges are added to the edge
+     * connectivity map and the neighbor table entries of the triangles across them are pointed at
+     * it, so an insertion costs three hash lookups instead of a rebuild. The connectivity and the
+     * neighbor table stay exactly what a mesh built from `GetTriangles()` would hold. The
+     * triangle is validated like the triangles of a loaded mesh, and the mesh is left unchanged if
+     * it is rejected.
+     *
+     * @param triangle Triangle to insert
+     * @return Index of the inserted triangle
+     *
+     * @throws std::logic_error if the mesh was not built with `ConnectivityEngine::kEdgeHashMap`
+     * @throws std::invalid_argument if the triangle is degenerate or one of its edges is already
+     *         shared by 2 triangles
+     */
+    TriangleIndex InsertTriangle(const TriangleType& triangle);
+
+    /**
+     * @brief Removes a triangle and updates the connectivity around it
+     *
+     * The last triangle of the mesh is moved into the freed index (unless it is the removed one),
+     * so the other indices stay valid. Only the edge map entries and neighbor table entries of
+     * the removed and the moved triangle are touched. As with `InsertTriangle`, the result is
+     * identical to a mesh built from the remaining `GetTriangles()`.
+     *
+     * @param triangle_index Index of the triangle to remove
+     *
+     * @throws std::logic_error if the mesh was not built with `ConnectivityEngine::kEdgeHashMap`
+     * @throws std::invalid_argument if the index is out of range or the triangle is the last one
+     *         of the mesh
+     */
+    void RemoveTriangle(std::size_t triangle_index);
 
     /**
      * @brief Returns the list of triangles in the mesh
      *
      * @return Reference to the triangle container
      */
-    const std::vector<Triangle>& GetTriangles() const { return triangles_; }
+    const std::vector<TriangleType>& GetTriangles() const { return triangles_; }
 
     /**
      * @brief Returns the edge-to-triangle connectivity map
      *
-     * Each entry maps a canonical edge to the indices of triangles that share that edge.
+     * Each entry maps a canonical edge to the indices of triangles that share that edge. Only
+     * populated by the `ConnectivityEngine::kEdgeHashMap` engine (or an explicit call to
+     * `BuildEdgeToTriangleConnectivity`).
      *
      * @return Reference to the edge connectivity map
      */
-    const std::unordered_map<Edge, std::array<TriangleIndex, 2>, EdgeHash, EdgeEquality>&
-    GetEdgeConnectivity() const {
-        return edge_connectivity_;
+    const EdgeMap& GetEdgeConnectivity() const { return edge_connectivity_; }
+
+    /**
+     * @brief Returns the edge-to-triangle connectivity of the flat coordinate-keyed table
+     *
+     * Holds the same entries as `GetEdgeConnectivity` would. Only populated by the
+     * `ConnectivityEngine::kFlatEdgeHashMap` engine (or an explicit call to
+     * `BuildFlatEdgeToTriangleConnectivity`).
+     *
+     * @return Reference to the flat edge connectivity table
+     */
+    const FlatEdgeMap& GetFlatEdgeConnectivity() const { return flat_edge_connectivity_; }
+
+    /**
+     * @brief Returns the welded vertex buffer
+     *
+     * Only populated by the `ConnectivityEngine::kIndexedHashMap` engine (or an explicit call to
+     * `BuildIndexedRepresentation`).
+     *
+     * @return Reference to the distinct points of the mesh
+     */
+    const std::vector<PointType>& GetVertices() const { return vertices_; }
+
+    /**
+     * @brief Returns the vertex indices of every triangle
+     *
+     * Entry i holds the indices of triangle i's vertices a, b and c into `GetVertices()`.
+     *
+     * @return Reference to the triangle index triples
+     */
+    const std::vector<std::array<VertexIndex, 3>>& GetTriangleVertices() const {
+        return triangle_vertices_;
     }
 
+    /**
+     * @brief Returns the edge-to-triangle connectivity keyed by packed vertex-index edges
+     *
+     * @return Reference to the indexed edge connectivity map
+     */
+    const IndexedEdgeMap& GetIndexedEdgeConnectivity() const { return indexed_edge_connectivity_; }
+
+    /**
+     * @brief Returns the unique packed edge keys of the sorted edge table, in ascending order
+     *
+     * Only populated by the `ConnectivityEngine::kSortedEdges` engine (or an explicit call to
+     * `BuildSortedEdgeToTriangleConnectivity`). Entry i is the key of edge id i.
+     *
+     * @return Reference to the sorted edge keys
+     */
+    const std::vector<EdgeKey>& GetSortedEdgeKeys() const { return sorted_edge_keys_; }
+
+    /**
+     * @brief Returns the triangles sharing every edge of the sorted edge table
+     *
+     * Entry i holds the triangles sharing the edge with key `GetSortedEdgeKeys()[i]`.
+     *
+     * @return Reference to the per-edge triangle pairs
+     */
+    const std::vector<std::array<TriangleIndex, 2>>& GetSortedEdgeTriangles() const {
+        return sorted_edge_triangles_;
+    }
+
+    /**
+     * @brief Looks up the triangles sharing an edge given by its packed vertex-index key
+     *
+     * Works with the indexed engines: a binary search over the sorted edge keys for
+     * `ConnectivityEngine::kSortedEdges`, a hash lookup for `ConnectivityEngine::kIndexedHashMap`.
+     * The neighbor table engine keeps no vertex ids, so every edge is unknown to it.
+     *
+     * @param edge Packed edge key (see `make_edge_key`)
+     * @return Indices of the triangles sharing the edge; the second slot is
+     *         `kBoundaryTriangleIndex` for a boundary edge, and both slots are if the edge is
+     *         unknown
+     */
+    std::array<TriangleIndex, 2> FindEdgeTriangles(EdgeKey edge) const;
+
+    /**
+     * @brief Returns the neighbor table of the mesh
+     *
+     * Entry i holds the triangles adjacent to triangle i across its local edges 0: a-b, 1: b-c and
+     * 2: c-a, with `kBoundaryTriangleIndex` for open edges.
+     *
+     * @return Reference to the per-triangle neighbor indices
+     */
+    const std::vector<std::array<TriangleIndex, 3>>& GetTriangleNeighbors() const {
+        return triangle_neighbors_;
+    }
+
+    /**
+     * @brief Returns the connectivity engine the mesh was built with
+     *
+     * @return Connectivity engine
+     */
+    ConnectivityEngine GetConnectivityEngine() const { return connectivity_engine_; }
+
+    /**
+     * @brief Returns the connected components restored from a connectivity cache
+     *
+     * Components are listed exactly as `find_connected_components` produced them when the cache
+     * was written, which then returns them without traversing the mesh again. Empty unless the
+     * mesh was loaded through `load_mesh_with_cache`, and cleared by `InsertTriangle` and
+     * `RemoveTriangle`. `FlipTriangle` keeps them (and so stays safe to call from several threads):
+     * a flip changes no component, only possibly the BFS order a new traversal would list.
+     *
+     * @return Reference to the cached components
+     */
+    const std::vector<std::vector<TriangleIndex>>& GetCachedComponents() const {
+        return cached_components_;
+    }
+
+    /**
+     * @brief Returns the triangles sharing one edge of a triangle
+     *
+     * Works with every connectivity engine. The local edges of a triangle are numbered
+     * 0: a-b, 1: b-c and 2: c-a. The neighbor table engine answers from the neighbor table, with
+     * the two triangles in ascending order like the edge engines.
+     *
+     * @param triangle_index Index of the triangle
+     * @param local_edge Local edge number (0, 1 or 2)
+     * @return Indices of the triangles sharing the edge; the second slot is
+     *         `kBoundaryTriangleIndex` for a boundary edge, and both slots are if the edge is
+     *         unknown (connectivity not built)
+     */
+    std::array<TriangleIndex, 2> GetEdgeTriangles(
+        std::size_t triangle_index, std::size_t local_edge
+    ) const;
+
 private:
+    friend class MeshCacheAccess;
+
+    /**
+     * @brief Returns the resource of the connectivity hash maps and the temporary build buffers
+     *
+     * Taken from the edge map, so that it follows the maps through copies (which switch to the
+     * default resource) and moves.
+     */
+    std::pmr::memory_resource* MemoryResource() const {
+        return this->edge_connectivity_.get_allocator().resource();
+    }
+
+    /**
+     * @brief Drops the welded vertices and the sorted edge table once the neighbor table is built
+     */
+    void ReleaseEdgeTables();
+
+    /**
+     * @brief Returns the local edge of a triangle that equals a coordinate edge
+     *
+     * @param triangle_index Index of the triangle
+     * @param edge Canonical edge of the triangle
+     * @return Local edge number (0, 1 or 2)
+     */
+    std::size_t FindLocalEdge(std::size_t triangle_index, const EdgeType& edge) const;
+
+    /**
+     * @brief Validates the triangles and builds the connectivity
+     *
+     * @param stats Sink for the stage timings and counters (may be null)
+     * @param num_threads Number of threads for the triangle validation (0: one per hardware core)
+     * @param control Stop token and progress callback of the stages (may be null)
+     *
+     * @throws std::invalid_argument if the mesh is empty, has degenerate triangles or non-manifold
+     *         edges
+     * @throws AnalysisCancelled if the control requested a stop
+     */
+    void Initialize(
+        PipelineStats* stats, std::size_t num_threads, const AnalysisControl* control
+    );
+
     /// List of triangles in the mesh
-    std::vector<Triangle> triangles_;
+    std::vector<TriangleType> triangles_;
+
+    /// Connectivity engine selected at load time
+    ConnectivityEngine connectivity_engine_{ConnectivityEngine::kEdgeHashMap};
 
     /// Maps each canonical edge to the indices of triangles that share it
-    std::unordered_map<Edge, std::array<TriangleIndex, 2>, EdgeHash, EdgeEquality>
-        edge_connectivity_;
+    EdgeMap edge_connectivity_;
+
+    /// Flat table mapping each canonical edge to the indices of triangles that share it
+    FlatEdgeMap flat_edge_connectivity_;
+
+    /// Distinct points of the mesh (indexed representation)
+    std::vector<PointType> vertices_;
+
+    /// Vertex indices of every triangle (indexed representation)
+    std::vector<std::array<VertexIndex, 3>> triangle_vertices_;
+
+    /// Maps each packed vertex-index edge to the indices of triangles that share it
+    IndexedEdgeMap indexed_edge_connectivity_;
+
+    /// Triangles adjacent to every triangle across its local edges 0, 1 and 2
+    std::vector<std::array<TriangleIndex, 3>> triangle_neighbors_;
+
+    /// Unique packed edge keys in ascending order (sorted edge table)
+    std::vector<EdgeKey> sorted_edge_keys_;
+
+    /// Triangles sharing each edge of `sorted_edge_keys_` (sorted edge table)
+    std::vector<std::array<TriangleIndex, 2>> sorted_edge_triangles_;
+
+    /// Edge id of local edges 0, 1 and 2 of every triangle (sorted edge table)
+    std::vector<std::array<std::uint32_t, 3>> triangle_edge_ids_;
+
+    /// Connected components restored from a connectivity cache
+    std::vector<std::vector<TriangleIndex>> cached_components_;
 };
 
+/// Mesh with double coordinates, the default used throughout the pipeline
+using TriangleMesh = BasicTriangleMesh<double>;
+
+/// Mesh with float coordinates: half the triangle and vertex memory of `TriangleMesh`
+using TriangleMeshF = BasicTriangleMesh<float>;
+
+// Member definitions live in triangle_mesh.cpp, instantiated for these two coordinate types
+extern template class BasicTriangleMesh<double>;
+extern template class BasicTriangleMesh<float>;
+
 }  // namespace tsexam::problem1
@@ -0,0 +1,335 @@
+#include "triangle_validation.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+#include "common/parallel.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define TSEXAM_VALIDATION_AVX2 1
+#define TSEXAM_VALIDATION_SIMD 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define TSEXAM_VALIDATION_NEON 1
+#define TSEXAM_VALIDATION_SIMD 1
+#endif
+
+namespace tsexam::problem1 {
+
+namespace {
+
+/// Triangles staged into one structure-of-arrays block
+constexpr std::size_t kBlockSize{256};
+
+/// Triangles checked per task of the parallel validation
+constexpr std::size_t kChunkSize{std::size_t{1} << 16};
+
+/// Squared area threshold below which a triangle counts as co-linear
+constexpr double kMinAreaSquared{kTolerance * kTolerance};
+
+static_assert(kChunkSize % kBlockSize == 0, "chunks must hold whole blocks");
+
+#if defined(TSEXAM_VALIDATION_SIMD)
+
+/// Number of triangles checked per kernel step
+#if defined(TSEXAM_VALIDATION_AVX2)
+constexpr std::size_t kLanes{4};
+#else
+constexpr std::size_t kLanes{2};
+#endif
+
+static_assert(kBlockSize % kLanes == 0, "blocks must hold whole kernel steps");
+
+/**
+ * @brief Block of triangles in structure-of-arrays layout
+ *
+ * Row 3 * v + d holds coordinate d of vertex v (a, b, c) of every triangle of the block, so a
+ * kernel step loads the same coordinate of consecutive triangles with one aligned load.
+ */
+struct alignas(32) SoaBlock {
+    std::array<std::array<double, kBlockSize>, 9> coords;
+};
+
+/**
+ * @brief Copies triangles [begin, begin + count) into a block
+ *
+ * Lanes past `count` up to the next whole kernel step are padded with a valid triangle, so the
+ * kernel never reports them.
+ *
+ * @param triangles All triangles
+ * @param begin Index of the first triangle of the block
+ * @param count Number of triangles in the block (at most `kBlockSize`)
+ * @param block Block to fill
+ */
+template <typename Scalar>
+void stage_block(
+    std::span<const BasicTriangle<Scalar>> triangles, std::size_t begin, std::size_t count,
+    SoaBlock& block
+) {
+    // float coordinates are widened while staging (exact)
+    for (std::size_t i = 0; i < count; ++i) {
+        const BasicTriangle<Scalar>& t{triangles[begin + i]};
+        for (std::size_t d = 0; d < 3; ++d) {
+            block.coords[d][i] = static_cast<double>(t.a[d]);
+            block.coords[3 + d][i] = static_cast<double>(t.b[d]);
+            block.coords[6 + d][i] = static_cast<double>(t.c[d]);
+        }
+    }
+    const std::size_t padded{(count + kLanes - 1) / kLanes * kLanes};
+    for (std::size_t i = count; i < padded; ++i) {
+        for (auto& row : block.coords) {
+            row[i] = 0.;
+        }
+        block.coords[3][i] = 1.;  // b = (1, 0, 0)
+        block.coords[7][i] = 1.;  // c = (0, 1, 0)
+    }
+}
+
+#if defined(TSEXAM_VALIDATION_AVX2)
+
+/**
+ * @brief Returns a 4-bit mask of the degenerate triangles among lanes [i, i + 4) of a block
+ */
+unsigned degenerate_mask(const SoaBlock& block, std::size_t i) {
+    const auto load = [&](std::size_t row) { return _mm256_load_pd(&block.coords[row][i]); };
+    const __m256d ax{load(0)}, ay{load(1)}, az{load(2)};
+    const __m256d bx{load(3)}, by{load(4)}, bz{load(5)};
+    const __m256d cx{load(6)}, cy{load(7)}, cz{load(8)};
+
+    // Lambda: all-ones lanes where two points are equal (same semantics as Point::operator==)
+    const auto equal = [](__m256d px, __m256d py, __m256d pz,
+                          __m256d qx, __m256d qy, __m256d qz) {
+        return _mm256_and_pd(
+            _mm256_and_pd(_mm256_cmp_pd(px, qx, _CMP_EQ_OQ), _mm256_cmp_pd(py, qy, _CMP_EQ_OQ)),
+            _mm256_cmp_pd(pz, qz, _CMP_EQ_OQ)
+        );
+    };
+    const __m256d duplicate{_mm256_or_pd(
+        _mm256_or_pd(equal(ax, ay, az, bx, by, bz), equal(bx, by, bz, cx, cy, cz)),
+        equal(cx, cy, cz, ax, ay, az)
+    )};
+
+    const __m256d v1x{_mm256_sub_pd(bx, ax)}, v1y{_mm256_sub_pd(by, ay)};
+    const __m256d v1z{_mm256_sub_pd(bz, az)};
+    const __m256d v2x{_mm256_sub_pd(cx, ax)}, v2y{_mm256_sub_pd(cy, ay)};
+    const __m256d v2z{_mm256_sub_pd(cz, az)};
+    const __m256d cross_x{_mm256_sub_pd(_mm256_mul_pd(v1y, v2z), _mm256_mul_pd(v1z, v2y))};
+    const __m256d cross_y{_mm256_sub_pd(_mm256_mul_pd(v1z, v2x), _mm256_mul_pd(v1x, v2z))};
+    const __m256d cross_z{_mm256_sub_pd(_mm256_mul_pd(v1x, v2y), _mm256_mul_pd(v1y, v2x))};
+    const __m256d area_squared{_mm256_add_pd(
+        _mm256_add_pd(_mm256_mul_pd(cross_x, cross_x), _mm256_mul_pd(cross_y, cross_y)),
+        _mm256_mul_pd(cross_z, cross_z)
+    )};
+    const __m256d collinear{
+        _mm256_cmp_pd(area_squared, _mm256_set1_pd(kMinAreaSquared), _CMP_LT_OQ)
+    };
+
+    return static_cast<unsigned>(_mm256_movemask_pd(_mm256_or_pd(duplicate, collinear)));
+}
+
+#elif defined(TSEXAM_VALIDATION_NEON)
+
+/**
+ * @brief Returns a 2-bit mask of the degenerate triangles among lanes [i, i + 2) of a block
+ */
+unsigned degenerate_mask(const SoaBlock& block, std::size_t i) {
+    const auto load = [&](std::size_t row) { return vld1q_f64(&block.coords[row][i]); };
+    const float64x2_t ax{load(0)}, ay{load(1)}, az{load(2)};
+    const float64x2_t bx{load(3)}, by{load(4)}, bz{load(5)};
+    const float64x2_t cx{load(6)}, cy{load(7)}, cz{load(8)};
+
+    // Lambda: all-ones lanes where two points are equal (same semantics as Point::operator==)
+    const auto equal = [](float64x2_t px, float64x2_t py, float64x2_t pz,
+                          float64x2_t qx, float64x2_t qy, float64x2_t qz) {
+        return vandq_u64(vandq_u64(vceqq_f64(px, qx), vceqq_f64(py, qy)), vceqq_f64(pz, qz));
+    };
+    const uint64x2_t duplicate{vorrq_u64(
+        vorrq_u64(equal(ax, ay, az, bx, by, bz), equal(bx, by, bz, cx, cy, cz)),
+        equal(cx, cy, cz, ax, ay, az)
+    )};
+
+    const float64x2_t v1x{vsubq_f64(bx, ax)}, v1y{vsubq_f64(by, ay)}, v1z{vsubq_f64(bz, az)};
+    const float64x2_t v2x{vsubq_f64(cx, ax)}, v2y{vsubq_f64(cy, ay)}, v2z{vsubq_f64(cz, az)};
+    const float64x2_t cross_x{vsubq_f64(vmulq_f64(v1y, v2z), vmulq_f64(v1z, v2y))};
+    const float64x2_t cross_y{vsubq_f64(vmulq_f64(v1z, v2x), vmulq_f64(v1x, v2z))};
+    const float64x2_t cross_z{vsubq_f64(vmulq_f64(v1x, v2y), vmulq_f64(v1y, v2x))};
+    const float64x2_t area_squared{vaddq_f64(
+        vaddq_f64(vmulq_f64(cross_x, cross_x), vmulq_f64(cross_y, cross_y)),
+        vmulq_f64(cross_z, cross_z)
+    )};
+    const uint64x2_t collinear{vcltq_f64(area_squared, vdupq_n_f64(kMinAreaSquared))};
+
+    const uint64x2_t degenerate{vorrq_u64(duplicate, collinear)};
+    return static_cast<unsigned>(vgetq_lane_u64(degenerate, 0) & 1u) |
+           static_cast<unsigned>((vgetq_lane_u64(degenerate, 1) & 1u) << 1);
+}
+
+#endif  // TSEXAM_VALIDATION_AVX2 / TSEXAM_VALIDATION_NEON
+
+#endif  // TSEXAM_VALIDATION_SIMD
+
+/**
+ * @brief Finds the first degenerate triangle in [begin, end)
+ *
+ * @param triangles All triangles
+ * @param begin Index of the first triangle to check
+ * @param end Index past the last triangle to check
+ * @param stop_at Index at which to stop early (a degenerate triangle before it is already known)
+ * @return Index of the first degenerate triangle, or `end` if there is none before `stop_at`
+ */
+template <typename Scalar>
+std::size_t find_first_in_range(
+    std::span<const BasicTriangle<Scalar>> triangles, std::size_t begin, std::size_t end,
+    const std::atomic<std::size_t>& stop_at
+) {
+#if defined(TSEXAM_VALIDATION_SIMD)
+    SoaBlock block;
+#endif
+    for (std::size_t block_begin = begin; block_begin < end; block_begin += kBlockSize) {
+        if (block_begin >= stop_at.load(std::memory_order_relaxed)) {
+            return end;
+        }
+        const std::size_t count{std::min(kBlockSize, end - block_begin)};
+#if defined(TSEXAM_VALIDATION_SIMD)
+        stage_block(triangles, block_begin, count, block);
+        for (std::size_t i = 0; i < count; i += kLanes) {
+            const unsigned mask{degenerate_mask(block, i)};
+            if (mask != 0) {
+                std::size_t lane{0};
+                while ((mask & (1u << lane)) == 0) {
+                    ++lane;
+                }
+                return block_begin + i + lane;
+            }
+        }
+#else
+        // No vector kernel -> staging would only add copies, check the triangles in place
+        for (std::size_t i = block_begin; i < block_begin + count; ++i) {
+            if (classify_triangle(triangles[i]) != TriangleDefect::kNone) {
+                return i;
+            }
+        }
+#endif
+    }
+    return end;
+}
+
+/// Parallel search shared by the double and float entry points
+template <typename Scalar>
+std::optional<DegenerateTriangle> find_first_degenerate(
+    std::span<const BasicTriangle<Scalar>> triangles, std::size_t num_threads
+) {
+    const std::size_t num_triangles{triangles.size()};
+    const std::size_t num_chunks{(num_triangles + kChunkSize - 1) / kChunkSize};
+
+    // Smallest degenerate index found so far; chunks and blocks past it are skipped
+    std::atomic<std::size_t> first{num_triangles};
+    common::parallel_for(num_chunks, num_threads, [&](std::size_t chunk) {
+        const std::size_t begin{chunk * kChunkSize};
+        const std::size_t end{std::min(begin + kChunkSize, num_triangles)};
+        const std::size_t found{find_first_in_range(triangles, begin, end, first)};
+        if (found == end) {
+            return;
+        }
+        std::size_t current{first.load(std::memory_order_relaxed)};
+        while (found < current &&
+               !first.compare_exchange_weak(current, found, std::memory_order_relaxed)) {
+        }
+    });
+
+    if (first.load() == num_triangles) {
+        return std::nullopt;
+    }
+    const std::size_t index{first.load()};
+    return DegenerateTriangle{index, classify_triangle(triangles[index])};
+}
+
+/// Validation shared by the double and float entry points
+template <typename Scalar>
+void validate(
+    std::span<const BasicTriangle<Scalar>> triangles, std::size_t num_threads,
+    std::size_t first_index
+) {
+    const std::optional<DegenerateTriangle> degenerate{
+        find_first_degenerate(triangles, num_threads)
+    };
+    if (!degenerate) {
+        return;
+    }
+    const std::string prefix{
+        "degenerate triangle at index " + std::to_string(first_index + degenerate->index)
+    };
+    if (degenerate->defect == TriangleDefect::kDuplicateVertices) {
+        throw std::invalid_argument(prefix + ": duplicate vertices");
+    }
+    throw std::invalid_argument(prefix + ": vertices are co-linear (area is effectively zero)");
+}
+
+}  // namespace
+
+TriangleDefect classify_triangle(const Triangle& triangle) {
+    const auto& t = triangle;
+
+    // Check if any two vertices are the same
+    if (t.a == t.b || t.b == t.c || t.c == t.a) {
+        return TriangleDefect::kDuplicateVertices;
+    }
+
+    // More comprehensive and robust check than above:
+    // Check if vertices are lies on the same line i.e. area of triangle is zero
+    // Area = 0.5 * |(b-a) × (c-a)|
+    const double v1[3] = {t.b[0] - t.a[0], t.b[1] - t.a[1], t.b[2] - t.a[2]};
+    const double v2[3] = {t.c[0] - t.a[0], t.c[1] - t.a[1], t.c[2] - t.a[2]};
+    const double cross_x = v1[1] * v2[2] - v1[2] * v2[1];
+    const double cross_y = v1[2] * v2[0] - v1[0] * v2[2];
+    const double cross_z = v1[0] * v2[1] - v1[1] * v2[0];
+    const double area_squared = cross_x * cross_x + cross_y * cross_y + cross_z * cross_z;
+    if (area_squared < kMinAreaSquared) {
+        return TriangleDefect::kCollinearVertices;
+    }
+    return TriangleDefect::kNone;
+}
+
+TriangleDefect classify_triangle(const TriangleF& triangle) {
+    return classify_triangle(triangle_cast<double>(triangle));
+}
+
+std::optional<DegenerateTriangle> find_first_degenerate_triangle(
+    std::span<const Triangle> triangles, std::size_t num_threads
+) {
+    return find_first_degenerate(triangles, num_threads);
+}
+
+std::optional<DegenerateTriangle> find_first_degenerate_triangle(
+    std::span<const TriangleF> triangles, std::size_t num_threads
+) {
+    return find_first_degenerate(triangles, num_threads);
+}
+
+void validate_triangles(
+    std::span<const Triangle> triangles, std::size_t num_threads, std::size_t first_index
+) {
+    validate(triangles, num_threads, first_index);
+}
+
+void validate_triangles(
+    std::span<const TriangleF> triangles, std::size_t num_threads, std::size_t first_index
+) {
+    validate(triangles, num_threads, first_index);
+}
+
+const char* triangle_validation_kernel() {
+#if defined(TSEXAM_VALIDATION_AVX2)
+    return "avx2";
+#elif defined(TSEXAM_VALIDATION_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+}  // namespace tsexam::problem1
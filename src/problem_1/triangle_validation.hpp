@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <span>
+
+#include "geometry.hpp"
+#include "triangle_mesh.hpp"
+
+namespace tsexam::problem1 {
+
+/// Why a triangle is degenerate
+enum class TriangleDefect {
+    kNone = 0,               ///< valid triangle
+    kDuplicateVertices = 1,  ///< two vertices are equal
+    kCollinearVertices = 2,  ///< squared area below `kTolerance^2` (co-linear vertices)
+};
+
+/// First degenerate triangle of a triangle list
+struct DegenerateTriangle {
+    std::size_t index{0};                         ///< index of the triangle
+    TriangleDefect defect{TriangleDefect::kNone};  ///< what is wrong with it
+};
+
+/**
+ * @brief Classifies one triangle (scalar reference check)
+ *
+ * Duplicate vertices are tested first, by exact coordinate equality. Then the squared area
+ * |(b - a) x (c - a)|^2 is compared against `kTolerance^2`. A triangle with both defects reports
+ * duplicate vertices.
+ *
+ * @param triangle Triangle to check
+ * @return Defect of the triangle (`TriangleDefect::kNone` if valid)
+ */
+TriangleDefect classify_triangle(const Triangle& triangle);
+
+/**
+ * @brief Classifies one float triangle
+ *
+ * The coordinates are widened to double (exact) and checked like a double triangle, so a float
+ * mesh accepts and rejects exactly the triangles its widened copy would.
+ *
+ * @param triangle Triangle to check
+ * @return Defect of the triangle (`TriangleDefect::kNone` if valid)
+ */
+TriangleDefect classify_triangle(const TriangleF& triangle);
+
+/**
+ * @brief Finds the first degenerate triangle of a triangle list
+ *
+ * With a vector kernel, the triangles are staged block by block into a structure-of-arrays layout
+ * and checked several at a time: AVX2 (4 triangles per step, when compiled with AVX2, see the
+ * CMake option `TSEXAM_ENABLE_AVX2`) or NEON (2 per step on AArch64). Without one, the triangles
+ * are checked in place by `classify_triangle`. Large inputs are split into chunks checked on
+ * `num_threads` threads; chunks past the first defect found so far are skipped. The kernels
+ * evaluate the same expressions in the same order as `classify_triangle` (floating point
+ * contraction is disabled for them), so the result is identical to checking the triangles one at
+ * a time.
+ *
+ * @param triangles Triangles to check
+ * @param num_threads Number of threads (0: one per hardware core)
+ * @return Smallest index of a degenerate triangle and its defect, or nothing if all are valid
+ */
+std::optional<DegenerateTriangle> find_first_degenerate_triangle(
+    std::span<const Triangle> triangles, std::size_t num_threads = 1
+);
+
+/**
+ * @brief Finds the first degenerate triangle of a float triangle list
+ *
+ * Same as the double overload; coordinates are widened while they are staged.
+ *
+ * @param triangles Triangles to check
+ * @param num_threads Number of threads (0: one per hardware core)
+ * @return Smallest index of a degenerate triangle and its defect, or nothing if all are valid
+ */
+std::optional<DegenerateTriangle> find_first_degenerate_triangle(
+    std::span<const TriangleF> triangles, std::size_t num_threads = 1
+);
+
+/**
+ * @brief Rejects a triangle list that contains degenerate triangles
+ *
+ * @param triangles Triangles to check
+ * @param num_threads Number of threads (0: one per hardware core)
+ * @param first_index Index of the first triangle in the reported index, for a list that is one
+ *        chunk of a larger mesh
+ *
+ * @throws std::invalid_argument naming the first degenerate triangle, e.g.
+ *         "degenerate triangle at index 7: duplicate vertices"
+ */
+void validate_triangles(
+    std::span<const Triangle> triangles, std::size_t num_threads = 1, std::size_t first_index = 0
+);
+
+/**
+ * @brief Rejects a float triangle list that contains degenerate triangles
+ *
+ * @param triangles Triangles to check
+ * @param num_threads Number of threads (0: one per hardware core)
+ * @param first_index Index of the first triangle in the reported index
+ *
+ * @throws std::invalid_argument naming the first degenerate triangle, with the same messages as
+ *         the double overload
+ */
+void validate_triangles(
+    std::span<const TriangleF> triangles, std::size_t num_threads = 1, std::size_t first_index = 0
+);
+
+/**
+ * @brief Returns the name of the vector kernel compiled into `find_first_degenerate_triangle`
+ *
+ * @return "avx2", "neon" or "scalar"
+ */
+const char* triangle_validation_kernel();
+
+}  // namespace tsexam::problem1
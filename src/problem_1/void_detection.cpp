@@ -1,10 +1,22 @@
 #include "void_detection.hpp"
 
+#include <algorithm>
 #include <array>
-#include <queue>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
+#include "common/parallel.hpp"
+
+#include "bvh.hpp"
+#include "disjoint_sets.hpp"
 #include "geometry.hpp"
+#include "mesh_analysis.hpp"
 #include "stl_io.hpp"
 
 namespace tsexam::problem1 {
@@ -39,119 +51,304 @@ bool aabb_contains(
            outer.min_z <= inner.min_z - tol && inner.max_z + tol <= outer.max_z;
 }
 
-std::vector<ConnectedComponent> find_connected_components(const TriangleMesh& mesh) {
-    const auto& triangles{mesh.GetTriangles()};
-    const auto& edge_connectivity{mesh.GetEdgeConnectivity()};
-    const std::size_t num_triangles{triangles.size()};
+AabbContainmentIndex::AabbContainmentIndex(std::vector<AxisAlignedBoundingBox> boxes)
+    : boxes_(std::move(boxes)) {
+    const std::size_t num_boxes{this->boxes_.size()};
 
-    std::vector<bool> visited(num_triangles, false);  // list of visited triangles
-    std::vector<ConnectedComponent> components;       // list of connected components
-    components.reserve(20);  // estimating the number of components as a heuristic
+    // Sort by min_x -> the possible containers of any box are a prefix of this order
+    this->order_.resize(num_boxes);
+    std::iota(this->order_.begin(), this->order_.end(), std::size_t{0});
+    const auto by_min_x = [this](std::size_t i, std::size_t j) {
+        return this->boxes_[i].min_x < this->boxes_[j].min_x;
+    };
+    std::stable_sort(this->order_.begin(), this->order_.end(), by_min_x);
+    this->sorted_min_x_.reserve(num_boxes);
+    for (const std::size_t i : this->order_) {
+        this->sorted_min_x_.push_back(this->boxes_[i].min_x);
+    }
 
-    // Lambda: find the smallest unvisited triangle index, or return num_triangles if none
-    const auto smallest_unvisited_triangle_index = [&visited, num_triangles]() -> std::size_t {
-        for (std::size_t i = 0; i < num_triangles; ++i) {
-            if (!visited[i]) {
-                return i;  // return the smallest unvisited triangle index
-            }
-        }
-        return num_triangles;  // return num_triangles if no unvisited triangles
+    // Empty leaves get bounds that can never contain anything
+    constexpr double kInfinity{std::numeric_limits<double>::infinity()};
+    constexpr NodeBounds kEmpty{-kInfinity, kInfinity, -kInfinity, kInfinity, -kInfinity};
+
+    this->num_leaves_ = 1;
+    while (this->num_leaves_ < num_boxes) {
+        this->num_leaves_ *= 2;
+    }
+    this->nodes_.assign(2 * this->num_leaves_, kEmpty);
+    for (std::size_t k = 0; k < num_boxes; ++k) {
+        const AxisAlignedBoundingBox& box{this->boxes_[this->order_[k]]};
+        this->nodes_[this->num_leaves_ + k] = {
+            box.max_x, box.min_y, box.max_y, box.min_z, box.max_z
+        };
+    }
+    for (std::size_t node = this->num_leaves_ - 1; node >= 1; --node) {
+        const NodeBounds& left{this->nodes_[2 * node]};
+        const NodeBounds& right{this->nodes_[2 * node + 1]};
+        this->nodes_[node] = {
+            std::max(left.max_max_x, right.max_max_x), std::min(left.min_min_y, right.min_min_y),
+            std::max(left.max_max_y, right.max_max_y), std::min(left.min_min_z, right.min_min_z),
+            std::max(left.max_max_z, right.max_max_z)
+        };
+    }
+}
+
+template <typename Visitor>
+bool AabbContainmentIndex::VisitContainers(
+    std::size_t inner, double tol, std::size_t* num_box_tests, const Visitor& visitor
+) const {
+    const AxisAlignedBoundingBox& box{this->boxes_[inner]};
+
+    // Candidate prefix: every box with outer.min_x <= inner.min_x - tol (same expression as
+    // aabb_contains)
+    const auto prefix_end{static_cast<std::size_t>(
+        std::upper_bound(this->sorted_min_x_.begin(), this->sorted_min_x_.end(), box.min_x - tol) -
+        this->sorted_min_x_.begin()
+    )};
+    if (prefix_end == 0) {
+        return false;
+    }
+
+    // Lambda: can any box below a node contain the query box? (necessary conditions only)
+    auto may_contain = [&box, tol](const NodeBounds& bounds) {
+        return box.max_x + tol <= bounds.max_max_x && bounds.min_min_y <= box.min_y - tol &&
+               box.max_y + tol <= bounds.max_max_y && bounds.min_min_z <= box.min_z - tol &&
+               box.max_z + tol <= bounds.max_max_z;
     };
 
-    // Repeatedly pick an unvisited triangle as seed -> perform BFS to get one connected component
-    while (true) {
-        const std::size_t seed{smallest_unvisited_triangle_index()};
-        if (seed >= num_triangles) {
-            break;  // no unvisited triangles -> stop
+    // Depth-first over the nodes overlapping [0, prefix_end), left to right
+    struct Frame {
+        std::size_t node, begin, end;  // node covers sorted positions [begin, end)
+    };
+    std::vector<Frame> stack{{1, 0, this->num_leaves_}};
+    while (!stack.empty()) {
+        const Frame frame{stack.back()};
+        stack.pop_back();
+        if (frame.begin >= prefix_end || !may_contain(this->nodes_[frame.node])) {
+            continue;
         }
+        if (frame.node >= this->num_leaves_) {
+            const std::size_t outer{this->order_[frame.begin]};
+            if (outer == inner) {
+                continue;
+            }
+            if (num_box_tests != nullptr) {
+                ++*num_box_tests;
+            }
+            if (aabb_contains(this->boxes_[outer], box, tol) && visitor(outer)) {
+                return true;
+            }
+            continue;
+        }
+        const std::size_t middle{frame.begin + (frame.end - frame.begin) / 2};
+        stack.push_back({2 * frame.node + 1, middle, frame.end});
+        stack.push_back({2 * frame.node, frame.begin, middle});
+    }
+    return false;
+}
 
-        ConnectedComponent component;
-        std::queue<std::size_t> queue;
-        visited[seed] = true;
-        queue.push(seed);
-
-        // Propagate the connected component through the mesh using BFS
-        while (!queue.empty()) {
-            // Get the next triangle to visit from the FIFO queue
-            const std::size_t triangle_index{queue.front()};
-            queue.pop();
-            component.push_back(static_cast<TriangleIndex>(triangle_index));
-
-            const Triangle& triangle{triangles[triangle_index]};
-            // Examine all three edges of this triangle
-            const std::array<Edge, 3> edges{
-                make_edge(triangle.a, triangle.b),  // edge 1
-                make_edge(triangle.b, triangle.c),  // edge 2
-                make_edge(triangle.c, triangle.a)   // edge 3
-            };
-
-            // For each edge of triangle: find neighbor triangle and check if it is already visited
-            for (const Edge& edge : edges) {
-                // Find the neighbor triangle for this edge
-                auto it{edge_connectivity.find(edge)};
-                if (it == edge_connectivity.end()) {
-                    continue;  // edge not found in the mesh -> skip
-                }
+bool AabbContainmentIndex::HasContainer(
+    std::size_t inner, double tol, std::size_t* num_box_tests
+) const {
+    return this->VisitContainers(inner, tol, num_box_tests, [](std::size_t) { return true; });
+}
 
-                // Check if edge is boundary or non-manifold -> skip
-                const auto& degree_of_edge{it->second};
-                if (degree_of_edge[1] == kBoundaryTriangleIndex) {
-                    continue;  // boundary edge -> skip
-                }
+std::vector<std::size_t> AabbContainmentIndex::FindContainers(
+    std::size_t inner, double tol, std::size_t* num_box_tests
+) const {
+    std::vector<std::size_t> containers;
+    this->VisitContainers(inner, tol, num_box_tests, [&containers](std::size_t outer) {
+        containers.push_back(outer);
+        return false;  // keep visiting
+    });
+    std::sort(containers.begin(), containers.end());
+    return containers;
+}
 
-                // Get neighbor triangle index from degree of edge
-                // Logic: Only 2 triangles share an edge -> one we are on OR neighbor triangle
-                const std::size_t neighbor_index{
-                    (degree_of_edge[0] == static_cast<TriangleIndex>(triangle_index))
-                        ? static_cast<std::size_t>(degree_of_edge[1])
-                        : static_cast<std::size_t>(degree_of_edge[0])
-                };
-
-                // If neighbor triangle is already visited -> skip
-                if (visited[neighbor_index]) {
-                    continue;
-                }
+ComponentSet::ComponentSet(std::pmr::memory_resource* resource)
+    : triangles_(resource), offsets_(1, std::size_t{0}, resource) {
+}
+
+ComponentSet::ComponentSet(
+    std::pmr::vector<TriangleIndex> triangles, std::pmr::vector<std::size_t> offsets
+)
+    : triangles_(std::move(triangles)), offsets_(std::move(offsets)) {
+    if (this->offsets_.empty() || this->offsets_.front() != 0 ||
+        this->offsets_.back() != this->triangles_.size() ||
+        !std::is_sorted(this->offsets_.begin(), this->offsets_.end())) {
+        throw std::invalid_argument(
+            "ComponentSet: offsets must rise from 0 to the number of triangles"
+        );
+    }
+}
+
+namespace {
+
+/// Number of triangles per task in the parallel union step of the component labeling
+constexpr std::size_t kLabelingChunkSize{4096};
+
+/**
+ * @brief Appends the connected component of a seed triangle, found by BFS over the neighbor table
+ *
+ * Triangles are appended in BFS order, and the appended part of `out` doubles as the FIFO queue:
+ * triangles are visited in list order, so no separate queue is allocated. Only triangles of the
+ * seed's component are marked in `visited`, so BFS runs over different components may share one
+ * `visited` array concurrently.
+ *
+ * @param neighbors Neighbor table of the mesh
+ * @param seed Seed triangle index
+ * @param visited Per-triangle visited flags, updated for the triangles of the component
+ * @param out Triangle index list the component is appended to
+ */
+template <typename Visited, typename Out>
+void append_component(
+    const std::vector<std::array<TriangleIndex, 3>>& neighbors, std::size_t seed,
+    Visited& visited, Out& out
+) {
+    visited[seed] = 1;
+    out.push_back(static_cast<TriangleIndex>(seed));
+
+    // Propagate the connected component through the mesh using BFS
+    for (std::size_t head = out.size() - 1; head < out.size(); ++head) {
+        // Get the next triangle to visit from the FIFO queue
+        const auto triangle_index{static_cast<std::size_t>(out[head])};
+
+        // For each of the three edges of triangle: look up the neighbor triangle and check if
+        // it is already visited
+        for (const TriangleIndex neighbor : neighbors[triangle_index]) {
+            // Check if edge is boundary (or unknown) -> skip
+            if (neighbor == kBoundaryTriangleIndex) {
+                continue;  // boundary edge -> skip
+            }
+            const auto neighbor_index{static_cast<std::size_t>(neighbor)};
 
-                // Mark neighbor as visited and add it to the FIFO queue
-                visited[neighbor_index] = true;
-                queue.push(neighbor_index);
+            // If neighbor triangle is already visited -> skip
+            if (visited[neighbor_index] != 0) {
+                continue;
             }
+
+            // Mark neighbor as visited and add it to the FIFO queue
+            visited[neighbor_index] = 1;
+            out.push_back(neighbor);
         }
+    }
+}
+
+/**
+ * @brief Collects the connected component of a seed triangle (see `append_component`)
+ *
+ * @param neighbors Neighbor table of the mesh
+ * @param seed Seed triangle index
+ * @param visited Per-triangle visited flags, updated for the triangles of the component
+ * @return Triangle indices of the component
+ */
+ConnectedComponent collect_component(
+    const std::vector<std::array<TriangleIndex, 3>>& neighbors, std::size_t seed,
+    std::vector<unsigned char>& visited
+) {
+    ConnectedComponent component;
+    append_component(neighbors, seed, visited, component);
+    return component;
+}
 
-        // Add the connected component to the list of components
-        components.push_back(std::move(component));
+/// Serial component search shared by the double and float meshes
+template <typename Scalar>
+std::vector<ConnectedComponent> find_components(const BasicTriangleMesh<Scalar>& mesh) {
+    // Components restored from a connectivity cache -> no traversal needed
+    if (!mesh.GetCachedComponents().empty()) {
+        return mesh.GetCachedComponents();
+    }
+
+    const std::size_t num_triangles{mesh.GetTriangles().size()};
+    const auto& neighbors{mesh.GetTriangleNeighbors()};
+
+    std::vector<unsigned char> visited(num_triangles, 0);  // list of visited triangles
+    std::vector<ConnectedComponent> components;            // list of connected components
+    components.reserve(20);  // estimating the number of components as a heuristic
+
+    // Repeatedly pick the smallest unvisited triangle as seed -> perform BFS to get one connected
+    // component. Every triangle below the cursor is visited, so the scan for the next seed resumes
+    // where the previous one stopped and all seed scans together are O(triangles).
+    for (std::size_t seed = 0; seed < num_triangles; ++seed) {
+        if (visited[seed] != 0) {
+            continue;
+        }
+        components.push_back(collect_component(neighbors, seed, visited));
     }
 
     return components;
 }
 
-bool is_connected_component_closed(const TriangleMesh& mesh, const ConnectedComponent& component) {
-    const auto& triangles{mesh.GetTriangles()};
-    const auto& edge_connectivity{mesh.GetEdgeConnectivity()};
+/// Parallel component search shared by the double and float meshes
+template <typename Scalar>
+std::vector<ConnectedComponent> find_components(
+    const BasicTriangleMesh<Scalar>& mesh, std::size_t num_threads
+) {
+    const std::size_t thread_count{common::resolve_thread_count(num_threads)};
+    if (thread_count <= 1 || !mesh.GetCachedComponents().empty()) {
+        return find_components(mesh);
+    }
 
-    // Check if all edges of the component are shared by exactly two triangles
-    for (const TriangleIndex& triangle_index : component) {
-        const Triangle& triangle{triangles[static_cast<std::size_t>(triangle_index)]};
+    const std::size_t num_triangles{mesh.GetTriangles().size()};
+    const auto& neighbors{mesh.GetTriangleNeighbors()};
+
+    //----------------------------------------------
+    // Step 1: label triangles with lock-free union-find over the shared edges
+    //----------------------------------------------
+
+    ConcurrentDisjointSets sets(num_triangles);
+    const std::size_t num_chunks{(num_triangles + kLabelingChunkSize - 1) / kLabelingChunkSize};
+    common::parallel_for(num_chunks, thread_count, [&](std::size_t chunk) {
+        const std::size_t begin{chunk * kLabelingChunkSize};
+        const std::size_t end{std::min(begin + kLabelingChunkSize, num_triangles)};
+        for (std::size_t i = begin; i < end; ++i) {
+            for (const TriangleIndex neighbor : neighbors[i]) {
+                // Each shared edge is seen from both sides -> unite from the smaller index only
+                if (neighbor != kBoundaryTriangleIndex && static_cast<std::size_t>(neighbor) > i) {
+                    sets.Unite(i, static_cast<std::size_t>(neighbor));
+                }
+            }
+        }
+    });
 
-        // Examine all three edges of this triangle
-        const std::array<Edge, 3> edges{
-            make_edge(triangle.a, triangle.b),  // edge 1
-            make_edge(triangle.b, triangle.c),  // edge 2
-            make_edge(triangle.c, triangle.a)   // edge 3
-        };
+    //----------------------------------------------
+    // Step 2: roots are the smallest triangle of each component -> same seeds, in the same
+    // ascending order, as the serial labeling
+    //----------------------------------------------
 
-        // For each edge of triangle: find neighbor triangle and check if it is shared by exactly two
-        // triangles
-        for (const Edge& edge : edges) {
-            auto it{edge_connectivity.find(edge)};
-            if (it == edge_connectivity.end()) {
-                // Should not happen if invariants hold -> treat as open
-                return false;
-            }
+    std::vector<std::size_t> roots;
+    for (std::size_t i = 0; i < num_triangles; ++i) {
+        if (sets.Find(i) == i) {
+            roots.push_back(i);
+        }
+    }
+
+    //----------------------------------------------
+    // Step 3: BFS every component from its root in parallel, so the triangle order within each
+    // component is also identical to the serial labeling
+    //----------------------------------------------
+
+    std::vector<ConnectedComponent> components(roots.size());
+    std::vector<unsigned char> visited(num_triangles, 0);
+    common::parallel_for(roots.size(), thread_count, [&](std::size_t k) {
+        components[k] = collect_component(neighbors, roots[k], visited);
+    });
+
+    return components;
+}
+
+/// Closed check shared by the double and float meshes
+template <typename Scalar>
+bool is_component_closed(const BasicTriangleMesh<Scalar>& mesh, ComponentView component) {
+    const auto& neighbors{mesh.GetTriangleNeighbors()};
 
-            const auto& degree_of_edge{it->second};
-            // Boundary edge -> component is open
-            if (degree_of_edge[1] == kBoundaryTriangleIndex) {
+    // Check if all edges of the component are shared by exactly two triangles
+    for (const TriangleIndex& triangle_index : component) {
+        // For each of the three edges of triangle: check if it has a neighbor triangle
+        for (const TriangleIndex neighbor : neighbors[static_cast<std::size_t>(triangle_index)]) {
+            // Boundary edge (or unknown edge, which should not happen if invariants hold) ->
+            // component is open
+            if (neighbor == kBoundaryTriangleIndex) {
                 return false;
             }
         }
@@ -160,8 +357,108 @@ bool is_connected_component_closed(const TriangleMesh& mesh, const ConnectedComp
     return true;
 }
 
+/// Component set search shared by the double and float meshes
+template <typename Scalar>
+ComponentSet find_set(const BasicTriangleMesh<Scalar>& mesh, std::pmr::memory_resource* resource) {
+    std::pmr::vector<TriangleIndex> triangles(resource);
+    std::pmr::vector<std::size_t> offsets(resource);
+    offsets.push_back(0);
+
+    // Components restored from a connectivity cache -> no traversal needed
+    if (!mesh.GetCachedComponents().empty()) {
+        for (const ConnectedComponent& component : mesh.GetCachedComponents()) {
+            triangles.insert(triangles.end(), component.begin(), component.end());
+            offsets.push_back(triangles.size());
+        }
+        return ComponentSet(std::move(triangles), std::move(offsets));
+    }
+
+    const std::size_t num_triangles{mesh.GetTriangles().size()};
+    const auto& neighbors{mesh.GetTriangleNeighbors()};
+    triangles.reserve(num_triangles);
+    std::pmr::vector<unsigned char> visited(num_triangles, 0, resource);
+
+    // Same seeds in the same order as the serial search
+    for (std::size_t seed = 0; seed < num_triangles; ++seed) {
+        if (visited[seed] != 0) {
+            continue;
+        }
+        append_component(neighbors, seed, visited, triangles);
+        offsets.push_back(triangles.size());
+    }
+    return ComponentSet(std::move(triangles), std::move(offsets));
+}
+
+/**
+ * @brief Views and AABBs of the closed components of a component set
+ */
+struct ClosedComponents {
+    std::vector<std::size_t> indices;           ///< index of every closed component in the set
+    std::vector<ComponentView> views;           ///< triangles of every closed component
+    std::vector<AxisAlignedBoundingBox> aabbs;  ///< padded AABB of every closed component
+};
+
+/**
+ * @brief Selects the closed components of a component set and computes their AABBs
+ *
+ * @param mesh The triangle mesh
+ * @param components All connected components of the mesh
+ * @return The closed components, in set order
+ */
+ClosedComponents select_closed_components(
+    const TriangleMesh& mesh, const ComponentSet& components
+) {
+    ClosedComponents closed;
+    for (std::size_t k = 0; k < components.size(); ++k) {
+        if (is_component_closed(mesh, components[k])) {
+            closed.indices.push_back(k);
+            closed.views.push_back(components[k]);
+            closed.aabbs.push_back(compute_component_aabb(mesh, components[k]));
+        }
+    }
+    return closed;
+}
+
+}  // namespace
+
+std::vector<ConnectedComponent> find_connected_components(const TriangleMesh& mesh) {
+    return find_components(mesh);
+}
+
+std::vector<ConnectedComponent> find_connected_components(const TriangleMeshF& mesh) {
+    return find_components(mesh);
+}
+
+std::vector<ConnectedComponent> find_connected_components(
+    const TriangleMesh& mesh, std::size_t num_threads
+) {
+    return find_components(mesh, num_threads);
+}
+
+std::vector<ConnectedComponent> find_connected_components(
+    const TriangleMeshF& mesh, std::size_t num_threads
+) {
+    return find_components(mesh, num_threads);
+}
+
+ComponentSet find_component_set(const TriangleMesh& mesh, std::pmr::memory_resource* resource) {
+    return find_set(mesh, resource);
+}
+
+ComponentSet find_component_set(const TriangleMeshF& mesh, std::pmr::memory_resource* resource) {
+    return find_set(mesh, resource);
+}
+
+bool is_connected_component_closed(const TriangleMesh& mesh, ComponentView component) {
+    return is_component_closed(mesh, component);
+}
+
+bool is_connected_component_closed(const TriangleMeshF& mesh, ComponentView component) {
+    return is_component_closed(mesh, component);
+}
+
 AxisAlignedBoundingBox compute_component_aabb(
-    const TriangleMesh& mesh, const ConnectedComponent& component, double pad
+    const TriangleMesh& mesh, ComponentView component, double pad
 ) {
     const auto& triangles{mesh.GetTriangles()};
 
@@ -204,68 +501,197 @@ AxisAlignedBoundingBox compute_component_aabb(
 }
 
 std::vector<ConnectedComponent> identify_voids(
-    const TriangleMesh& mesh, const std::vector<ConnectedComponent>& closed_components
+    const TriangleMesh& mesh, const std::vector<ConnectedComponent>& closed_components,
+    VoidClassification classification, PipelineStats* stats
 ) {
-    if (closed_components.size() < 2U) {
-        return {};  // 0 or 1 closed component -> no voids
-    }
-
-    // Compute the AABB for each closed component
     std::vector<AxisAlignedBoundingBox> component_aabbs;
-    component_aabbs.reserve(closed_components.size());
-    for (const ConnectedComponent& component : closed_components) {
-        component_aabbs.push_back(compute_component_aabb(mesh, component));
+    {
+        const ScopedStageTimer timer(stats, &PipelineStats::void_identification_time);
+        if (closed_components.size() < 2U) {
+            return {};  // 0 or 1 closed component -> no voids
+        }
+
+        // Compute the AABB for each closed component
+        component_aabbs.reserve(closed_components.size());
+        for (const ConnectedComponent& component : closed_components) {
+            component_aabbs.push_back(compute_component_aabb(mesh, component));
+        }
     }
+    return identify_voids(
+        mesh, closed_components, std::move(component_aabbs), classification, stats
+    );
+}
 
-    // A component is a void if its AABB is contained in the AABB of any other component
+std::vector<ConnectedComponent> identify_voids(
+    const TriangleMesh& mesh, const std::vector<ConnectedComponent>& closed_components,
+    std::vector<AxisAlignedBoundingBox> component_aabbs, VoidClassification classification,
+    PipelineStats* stats
+) {
+    const std::vector<ComponentView> views(closed_components.begin(), closed_components.end());
     std::vector<ConnectedComponent> voids{};
-    voids.reserve(closed_components.size());
-    for (std::size_t i = 0; i < closed_components.size(); ++i) {
-        const AxisAlignedBoundingBox& inner = component_aabbs[i];
-        bool is_void{false};
-        for (std::size_t j = 0; j < closed_components.size(); ++j) {
-            if (i == j) {
-                continue;  // skip self comparison
-            }
-            // Check if the AABB of the inner component is contained in the AABB of the outer
-            // component
-            if (aabb_contains(component_aabbs[j], inner)) {
-                is_void = true;
-                break;  // inner component is a void -> no need to check other components
+    for (const std::size_t i :
+         identify_void_indices(mesh, views, std::move(component_aabbs), classification, stats)) {
+        voids.push_back(closed_components[i]);
+    }
+    return voids;
+}
+
+std::vector<std::size_t> identify_void_indices(
+    const TriangleMesh& mesh, std::span<const ComponentView> closed_components,
+    std::vector<AxisAlignedBoundingBox> component_aabbs, VoidClassification classification,
+    PipelineStats* stats, const AnalysisControl* control
+) {
+    const ScopedStageTimer timer(stats, &PipelineStats::void_identification_time);
+    const std::size_t num_closed{closed_components.size()};
+    if (num_closed < 2U) {
+        checkpoint(control, AnalysisStage::kVoids, num_closed, num_closed);
+        return {};  // 0 or 1 closed component -> no voids
+    }
+    if (component_aabbs.size() != closed_components.size()) {
+        throw std::invalid_argument("identify_voids: one AABB per closed component is required");
+    }
+
+    // A component is a void if its AABB is contained in the AABB of any other component; the
+    // index only tests the components whose AABBs can contain it
+    const AabbContainmentIndex index(std::move(component_aabbs));
+    std::vector<std::size_t> voids{};
+
+    // Counters for the stats sink; the index only counts when given a counter
+    std::size_t aabb_tests{0};
+    std::size_t* const aabb_test_counter{
+        (kStatsEnabled && stats != nullptr) ? &aabb_tests : nullptr
+    };
+    std::size_t point_in_solid_tests{0};
+
+    // Lambda: hand the counters to the stats sink
+    auto record_void_stats = [&]() {
+        record_stats(stats, [&](PipelineStats& s) {
+            s.aabb_tests += aabb_tests;
+            s.point_in_solid_tests += point_in_solid_tests;
+            s.num_voids += voids.size();
+        });
+    };
+
+    if (classification == VoidClassification::kAabbContainment) {
+        for (std::size_t i = 0; i < num_closed; ++i) {
+            checkpoint(control, AnalysisStage::kVoids, i, num_closed);
+            if (index.HasContainer(i, kEpsilon, aabb_test_counter)) {
+                voids.push_back(i);
             }
         }
-        if (is_void) {
-            voids.push_back(closed_components[i]);
+        checkpoint(control, AnalysisStage::kVoids, num_closed, num_closed);
+        record_void_stats();
+        return voids;
+    }
+
+    // Exact mode: confirm AABB containment with a point-in-solid test against the container
+    const auto& triangles{mesh.GetTriangles()};
+    std::vector<std::unique_ptr<TriangleBvh>> bvhs(closed_components.size());
+
+    // Lambda: BVH of a closed component, built on first use
+    auto bvh_of = [&](std::size_t j) -> const TriangleBvh& {
+        if (!bvhs[j]) {
+            const ComponentView component{closed_components[j]};
+            bvhs[j] = std::make_unique<TriangleBvh>(
+                triangles, std::vector<TriangleIndex>(component.begin(), component.end())
+            );
+        }
+        return *bvhs[j];
+    };
+
+    for (std::size_t i = 0; i < num_closed; ++i) {
+        // A point-in-solid test is expensive -> check for a stop before every component
+        if (control != nullptr) {
+            control->Checkpoint(AnalysisStage::kVoids, i, num_closed);
+        }
+
+        // Query point: centroid of a triangle of the component, i.e. a point on its surface
+        const Triangle& t{triangles[static_cast<std::size_t>(closed_components[i].front())]};
+        const Point point{
+            (t.a[0] + t.b[0] + t.c[0]) / 3., (t.a[1] + t.b[1] + t.c[1]) / 3.,
+            (t.a[2] + t.b[2] + t.c[2]) / 3.
+        };
+
+        for (const std::size_t j : index.FindContainers(i, kEpsilon, aabb_test_counter)) {
+            ++point_in_solid_tests;
+            if (bvh_of(j).ContainsPoint(point)) {
+                voids.push_back(i);
+                break;  // inside one solid is enough
+            }
         }
     }
+    checkpoint(control, AnalysisStage::kVoids, num_closed, num_closed);
+    record_void_stats();
     return voids;
 }
 
-void export_voids_to_stl(const TriangleMesh& mesh, std::ostream& out) {
-    // step 1: find the connected components in triangle mesh
-    std::vector<ConnectedComponent> connected_components{find_connected_components(mesh)};
+std::vector<std::size_t> find_void_components(
+    const TriangleMesh& mesh, const ComponentSet& components, VoidClassification classification,
+    PipelineStats* stats
+) {
+    ClosedComponents closed;
+    {
+        const ScopedStageTimer timer(stats, &PipelineStats::void_identification_time);
+        closed = select_closed_components(mesh, components);
+    }
+    record_stats(stats, [&](PipelineStats& s) {
+        s.num_components += components.size();
+        s.num_closed_components += closed.views.size();
+    });
+
+    // Positions among the closed components -> indices in the set
+    std::vector<std::size_t> voids{identify_void_indices(
+        mesh, closed.views, std::move(closed.aabbs), classification, stats
+    )};
+    for (std::size_t& index : voids) {
+        index = closed.indices[index];
+    }
+    return voids;
+}
 
-    // Step 2: look for the closed connected components out of all connected components
-    std::vector<ConnectedComponent> closed_components{};
-    closed_components.reserve(connected_components.size());
-    for (const ConnectedComponent& component : connected_components) {
-        if (is_connected_component_closed(mesh, component)) {
-            closed_components.push_back(std::move(component));
+void write_voids_to_stl(
+    const TriangleMesh& mesh, std::span<const ComponentView> voids, std::ostream& out,
+    StlFormat format, PipelineStats* stats, const AnalysisControl* control
+) {
+    // Stream the void triangles straight from the component indices to the output stream
+    std::size_t num_void_triangles{0};
+    for (const ComponentView component : voids) {
+        num_void_triangles += component.size();
+    }
+    const ScopedStageTimer export_timer(stats, &PipelineStats::export_time);
+    record_stats(stats, [num_void_triangles](PipelineStats& s) {
+        s.triangles_exported += num_void_triangles;
+    });
+    const auto& all_triangles{mesh.GetTriangles()};
+    StlWriter writer(out, format, "voids", num_void_triangles);
+    std::size_t num_written{0};
+    for (const ComponentView component : voids) {
+        for (const TriangleIndex index : component) {
+            checkpoint(control, AnalysisStage::kExport, num_written++, num_void_triangles);
+            writer.Write(all_triangles[static_cast<std::size_t>(index)]);
         }
     }
+    checkpoint(control, AnalysisStage::kExport, num_void_triangles, num_void_triangles);
+    writer.Finish();
+}
 
-    // step 3: identify the voids out of all closed connected components
-    std::vector<ConnectedComponent> voids{identify_voids(mesh, closed_components)};
+void export_voids_to_stl(
+    const TriangleMesh& mesh, std::ostream& out, StlFormat format, PipelineStats* stats
+) {
+    // One traversal gives the components, their closedness and their AABBs
+    export_voids_to_stl(MeshAnalysis(mesh, stats), out, format, stats);
+}
 
-    // step 4: flatten void components to triangles and write in ASCII STL format to output stream
-    std::vector<Triangle> triangles_to_write;
-    const auto& all_triangles = mesh.GetTriangles();
-    for (const ConnectedComponent& comp : voids) {
-        for (TriangleIndex idx : comp) {
-            triangles_to_write.push_back(all_triangles[static_cast<std::size_t>(idx)]);
-        }
+void export_voids_to_stl(
+    const TriangleMesh& mesh, const ComponentSet& components, std::ostream& out,
+    StlFormat format, PipelineStats* stats
+) {
+    std::vector<ComponentView> voids;
+    for (const std::size_t k :
+         find_void_components(mesh, components, VoidClassification::kAabbContainment, stats)) {
+        voids.push_back(components[k]);
     }
-    write_ascii_stl(out, "voids", triangles_to_write);
+    write_voids_to_stl(mesh, voids, out, format, stats);
 }
 
 }  // namespace tsexam::problem1
@@ -1,8 +1,14 @@
 #pragma once
 
+#include <cstddef>
+#include <memory_resource>
+#include <span>
 #include <vector>
 
+#include "analysis_control.hpp"
 #include "geometry.hpp"
+#include "pipeline_stats.hpp"
+#include "stl_io.hpp"
 #include "triangle_mesh.hpp"
 
 namespace tsexam::problem1 {
@@ -55,6 +61,83 @@ bool aabb_contains(
     const AxisAlignedBoundingBox&, const AxisAlignedBoundingBox&, double tol = kEpsilon
 );
 
+/**
+ * @brief Sorted-interval index answering "which other boxes contain this box?" queries
+ *
+ * Boxes are sorted by `min_x`, so the boxes that can contain a query box form a prefix of the
+ * sorted order (those with `min_x <= inner.min_x - tol`). A segment tree over that order stores,
+ * per node, the largest `max_x`, `max_y`, `max_z` and the smallest `min_y`, `min_z` of its boxes;
+ * subtrees whose bounds cannot contain the query box are pruned without visiting their boxes.
+ * Surviving leaves are tested with `aabb_contains`, so query results are exactly those of a
+ * brute-force pairwise comparison. Building is O(k log k) for k boxes.
+ */
+class AabbContainmentIndex {
+public:
+    /**
+     * @brief Builds the index
+     * @param boxes Boxes to index; queries refer to boxes by their position in this list
+     */
+    explicit AabbContainmentIndex(std::vector<AxisAlignedBoundingBox> boxes);
+
+    /**
+     * @brief Checks if any other indexed box contains a box
+     * @param inner Index of the box to test
+     * @param tol The tolerance for floating point comparisons (see `aabb_contains`)
+     * @param num_box_tests If not null, incremented by the number of `aabb_contains` tests run
+     * @return True if `aabb_contains(boxes[j], boxes[inner], tol)` for some j != inner
+     */
+    bool HasContainer(
+        std::size_t inner, double tol = kEpsilon, std::size_t* num_box_tests = nullptr
+    ) const;
+
+    /**
+     * @brief Finds all other indexed boxes that contain a box
+     * @param inner Index of the box to test
+     * @param tol The tolerance for floating point comparisons (see `aabb_contains`)
+     * @param num_box_tests If not null, incremented by the number of `aabb_contains` tests run
+     * @return Indices j != inner with `aabb_contains(boxes[j], boxes[inner], tol)`, ascending
+     */
+    std::vector<std::size_t> FindContainers(
+        std::size_t inner, double tol = kEpsilon, std::size_t* num_box_tests = nullptr
+    ) const;
+
+    /**
+     * @brief Returns the indexed boxes
+     * @return Reference to the boxes in their original order
+     */
+    const std::vector<AxisAlignedBoundingBox>& GetBoxes() const { return boxes_; }
+
+private:
+    /// Aggregated bounds of the boxes below a segment tree node
+    struct NodeBounds {
+        double max_max_x, min_min_y, max_max_y, min_min_z, max_max_z;
+    };
+
+    /**
+     * @brief Visits the candidate containers of a box until the visitor returns true
+     * @return True if the visitor returned true
+     */
+    template <typename Visitor>
+    bool VisitContainers(
+        std::size_t inner, double tol, std::size_t* num_box_tests, const Visitor& visitor
+    ) const;
+
+    /// Boxes in their original order
+    std::vector<AxisAlignedBoundingBox> boxes_;
+
+    /// Original index of every box in ascending `min_x` order
+    std::vector<std::size_t> order_;
+
+    /// `min_x` of every box in ascending order (binary search for the candidate prefix)
+    std::vector<double> sorted_min_x_;
+
+    /// Number of leaves of the segment tree (power of two, >= number of boxes)
+    std::size_t num_leaves_{0};
+
+    /// Implicit segment tree: node i has children 2i and 2i + 1, leaves start at `num_leaves_`
+    std::vector<NodeBounds> nodes_;
+};
+
 //----------------------------------------------------
 // Connected components
 //----------------------------------------------------
@@ -62,12 +145,148 @@ bool aabb_contains(
 /// A connected component is a list of triangle indices
 using ConnectedComponent = std::vector<TriangleIndex>;
 
+/// Read-only view of the triangle indices of a connected component
+using ComponentView = std::span<const TriangleIndex>;
+
+/**
+ * @brief Connected components stored back to back in one triangle index array (CSR layout)
+ *
+ * Component k holds the triangles `GetTriangles()[GetOffsets()[k]]` up to, excluding,
+ * `GetTriangles()[GetOffsets()[k + 1]]`. All components share two arrays allocated from one
+ * memory resource, instead of one vector per component.
+ */
+class ComponentSet {
+public:
+    /**
+     * @brief Constructs an empty component set
+     * @param resource Memory resource of the arrays
+     */
+    explicit ComponentSet(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    /**
+     * @brief Constructs a component set from its arrays
+     * @param triangles Triangle indices of all components, component after component
+     * @param offsets Start of every component in `triangles`, followed by `triangles.size()`
+     *
+     * @throws std::invalid_argument if the offsets do not start at 0, decrease, or do not end at
+     *         the number of triangles
+     */
+    ComponentSet(std::pmr::vector<TriangleIndex> triangles, std::pmr::vector<std::size_t> offsets);
+
+    /**
+     * @brief Returns the number of components
+     * @return Number of components
+     */
+    std::size_t size() const { return offsets_.size() - 1; }
+
+    /**
+     * @brief Returns whether the set has no component
+     * @return True if there is no component
+     */
+    bool empty() const { return this->size() == 0; }
+
+    /**
+     * @brief Returns the triangles of a component
+     * @param k Index of the component
+     * @return View of the component's triangle indices
+     */
+    ComponentView operator[](std::size_t k) const {
+        return ComponentView(triangles_).subspan(offsets_[k], offsets_[k + 1] - offsets_[k]);
+    }
+
+    /**
+     * @brief Returns the triangle indices of all components, component after component
+     * @return Reference to the triangle index array
+     */
+    const std::pmr::vector<TriangleIndex>& GetTriangles() const { return triangles_; }
+
+    /**
+     * @brief Returns the start of every component, followed by the number of triangles
+     * @return Reference to the offset array
+     */
+    const std::pmr::vector<std::size_t>& GetOffsets() const { return offsets_; }
+
+private:
+    /// Triangle indices of all components
+    std::pmr::vector<TriangleIndex> triangles_;
+
+    /// Start of every component in `triangles_`, plus one past the last component
+    std::pmr::vector<std::size_t> offsets_;
+};
+
 /**
  * @brief Find the connected components in a triangle mesh
+ *
+ * Components restored from a connectivity cache (see `TriangleMesh::GetCachedComponents`) are
+ * returned as they are, without a traversal.
+ *
  * @param mesh The triangle mesh
  * @return A list of connected components
  */
 std::vector<ConnectedComponent> find_connected_components(const TriangleMesh&);
+
+/**
+ * @brief Find the connected components in a float triangle mesh
+ *
+ * @param mesh The triangle mesh
+ * @return A list of connected components, identical to those of a double mesh of the same triangles
+ */
+std::vector<ConnectedComponent> find_connected_components(const TriangleMeshF&);
+
+/**
+ * @brief Find the connected components in a triangle mesh on several threads
+ *
+ * Triangles are first labeled with a lock-free union-find over the neighbor table, in parallel
+ * across triangle chunks. Each set's root is its smallest triangle index, which is also the seed
+ * the serial search would pick, so the components are then collected by a BFS from every root in
+ * parallel across components. The result is identical to `find_connected_components(mesh)`:
+ * same components, same order, same triangle order within each component.
+ *
+ * @param mesh The triangle mesh
+ * @param num_threads Number of threads (0: one per hardware core; 1: serial search)
+ * @return A list of connected components
+ */
+std::vector<ConnectedComponent> find_connected_components(
+    const TriangleMesh& mesh, std::size_t num_threads
+);
+
+/**
+ * @brief Find the connected components in a float triangle mesh on several threads
+ *
+ * @param mesh The triangle mesh
+ * @param num_threads Number of threads (0: one per hardware core; 1: serial search)
+ * @return A list of connected components, identical to `find_connected_components(mesh)`
+ */
+std::vector<ConnectedComponent> find_connected_components(
+    const TriangleMeshF& mesh, std::size_t num_threads
+);
+/**
+ * @brief Find the connected components in a triangle mesh, in a component set
+ *
+ * Same components, order and triangle order as `find_connected_components(mesh)`. The BFS uses
+ * the triangle array of the set as its queue, so the whole search allocates the triangle array,
+ * the offsets and the visited flags from `resource` and nothing per component.
+ *
+ * @param mesh The triangle mesh
+ * @param resource Memory resource of the set and of the temporary visited flags
+ * @return The connected components
+ */
+ComponentSet find_component_set(
+    const TriangleMesh& mesh, std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+);
+
+/**
+ * @brief Find the connected components in a float triangle mesh, in a component set
+ *
+ * @param mesh The triangle mesh
+ * @param resource Memory resource of the set and of the temporary visited flags
+ * @return The connected components, identical to those of a double mesh of the same triangles
+ */
+ComponentSet find_component_set(
+    const TriangleMeshF& mesh,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+);
+
 /**
  * @brief Check if a connected component is closed
  * @param mesh The triangle mesh
@@ -81,7 +300,15 @@ std::vector<ConnectedComponent> find_connected_components(const TriangleMesh&);
  * @param component The connected component
  * @return True if the connected component is closed, false otherwise
  */
-bool is_connected_component_closed(const TriangleMesh&, const ConnectedComponent&);
+bool is_connected_component_closed(const TriangleMesh&, ComponentView);
+
+/**
+ * @brief Check if a connected component of a float triangle mesh is closed
+ * @param mesh The triangle mesh
+ * @param component The connected component
+ * @return True if the connected component is closed, false otherwise
+ */
+bool is_connected_component_closed(const TriangleMeshF&, ComponentView);
 
 //----------------------------------------------------
 // Void detection
@@ -95,28 +322,155 @@ bool is_connected_component_closed(const TriangleMesh&, const ConnectedComponent
  * @return The AABB for the connected component
  */
 AxisAlignedBoundingBox compute_component_aabb(
-    const TriangleMesh& mesh, const ConnectedComponent& component, double pad = kEpsilon
+    const TriangleMesh& mesh, ComponentView component, double pad = kEpsilon
 );
 
+/// How `identify_voids` decides that a closed component lies inside another one
+enum class VoidClassification {
+    kAabbContainment = 0,  ///< AABB containment only (fast, coarse: concave shells can give false
+                           ///< positives)
+    kPointInSolid = 1,     ///< AABB containment as a filter + exact point-in-solid by ray parity
+};
+
 /**
  * @brief Identify the voids in a triangle mesh
+ *
+ * With `VoidClassification::kPointInSolid`, every component whose AABB is contained in another
+ * one is confirmed by casting rays from a point on its surface against a BVH of the containing
+ * component (built lazily, once per containing component): the component is a void only if the
+ * point is inside that solid. This removes the false positives of concave or interlocking shells.
+ *
  * @param mesh The triangle mesh
  * @param closed_components The closed connected components
+ * @param classification Void classification mode
+ * @param stats Sink for the stage time, AABB test and point-in-solid query counts (may be null)
  * @return A list of voids
  */
 std::vector<ConnectedComponent> identify_voids(
-    const TriangleMesh& mesh, const std::vector<ConnectedComponent>& closed_components
+    const TriangleMesh& mesh, const std::vector<ConnectedComponent>& closed_components,
+    VoidClassification classification = VoidClassification::kAabbContainment,
+    PipelineStats* stats = nullptr
+);
+
+/**
+ * @brief Identify the voids in a triangle mesh from precomputed component AABBs
+ *
+ * Same as the overload above, with the AABBs of the closed components already computed (e.g. by
+ * `MeshAnalysis`, which gathers them during its traversal).
+ *
+ * @param mesh The triangle mesh
+ * @param closed_components The closed connected components
+ * @param component_aabbs AABB of every closed component, as from `compute_component_aabb`
+ * @param classification Void classification mode
+ * @param stats Sink for the stage time, AABB test and point-in-solid query counts (may be null)
+ * @return A list of voids
+ *
+ * @throws std::invalid_argument if the number of AABBs differs from the number of components
+ */
+std::vector<ConnectedComponent> identify_voids(
+    const TriangleMesh& mesh, const std::vector<ConnectedComponent>& closed_components,
+    std::vector<AxisAlignedBoundingBox> component_aabbs, VoidClassification classification,
+    PipelineStats* stats = nullptr
+);
+
+/**
+ * @brief Identify the voids among closed components given as views
+ *
+ * Core of the `identify_voids` overloads: the same classification, without copying any
+ * component.
+ *
+ * @param mesh The triangle mesh
+ * @param closed_components Views of the closed connected components
+ * @param component_aabbs AABB of every closed component, as from `compute_component_aabb`
+ * @param classification Void classification mode
+ * @param stats Sink for the stage time, AABB test and point-in-solid query counts (may be null)
+ * @param control Stop token and progress callback checked per closed component (may be null)
+ * @return Positions in `closed_components` of the voids, ascending
+ *
+ * @throws std::invalid_argument if the number of AABBs differs from the number of components
+ * @throws AnalysisCancelled if the control requested a stop
+ */
+std::vector<std::size_t> identify_void_indices(
+    const TriangleMesh& mesh, std::span<const ComponentView> closed_components,
+    std::vector<AxisAlignedBoundingBox> component_aabbs,
+    VoidClassification classification = VoidClassification::kAabbContainment,
+    PipelineStats* stats = nullptr, const AnalysisControl* control = nullptr
+);
+
+/**
+ * @brief Identify the voids of a component set
+ *
+ * Checks which components are closed, computes their AABBs and classifies them like
+ * `identify_voids`.
+ *
+ * @param mesh The triangle mesh
+ * @param components All connected components of the mesh (see `find_component_set`)
+ * @param classification Void classification mode
+ * @param stats Sink for the component counts and the void identification figures (may be null)
+ * @return Indices in `components` of the voids, ascending
+ */
+std::vector<std::size_t> find_void_components(
+    const TriangleMesh& mesh, const ComponentSet& components,
+    VoidClassification classification = VoidClassification::kAabbContainment,
+    PipelineStats* stats = nullptr
+);
+
+/**
+ * @brief Writes the triangles of the given voids to an STL file
+ *
+ * The triangles are streamed straight from the component indices through a buffered `StlWriter`
+ * into a solid named "voids", as all the `export_voids_to_stl` overloads do.
+ *
+ * @param mesh The triangle mesh
+ * @param voids Views of the void components
+ * @param out The output stream (binary mode for `StlFormat::kBinary`)
+ * @param format STL encoding of the output
+ * @param stats Sink for the export time and exported triangle count (may be null)
+ * @param control Stop token and progress callback checked per written triangle (may be null)
+ *
+ * @throws AnalysisCancelled if the control requested a stop; the output then holds a partial STL
+ *         file
+ */
+void write_voids_to_stl(
+    const TriangleMesh& mesh, std::span<const ComponentView> voids, std::ostream& out,
+    StlFormat format, PipelineStats* stats = nullptr, const AnalysisControl* control = nullptr
 );
 
 /**
  * @brief Export the voids to an STL file
  *
  * This is a wrapper function that finds the connected components, checks if they are closed,
- * identifies the voids, and exports the voids to an STL file.
+ * identifies the voids, and exports the voids to an STL file. The components, their closedness
+ * and their AABBs come from a single `MeshAnalysis` traversal. The void triangles are streamed
+ * straight from the component indices through a buffered `StlWriter`.
  *
  * @param mesh The triangle mesh
- * @param out The output stream
+ * @param out The output stream (binary mode for `StlFormat::kBinary`)
+ * @param format STL encoding of the output
+ * @param stats Sink for the stage timings and void detection counters (may be null)
  */
-void export_voids_to_stl(const TriangleMesh& mesh, std::ostream& out);
+void export_voids_to_stl(
+    const TriangleMesh& mesh, std::ostream& out, StlFormat format = StlFormat::kAscii,
+    PipelineStats* stats = nullptr
+);
+
+/**
+ * @brief Export the voids of a component set to an STL file
+ *
+ * Writes the same output as `export_voids_to_stl(mesh, out, format)`. Only the void
+ * identification allocates, per component rather than per triangle, so with the components and
+ * the mesh connectivity on a `std::pmr::monotonic_buffer_resource` (see `find_component_set` and
+ * `TriangleMeshOptions::memory_resource`) the whole analysis runs on a few large blocks.
+ *
+ * @param mesh The triangle mesh
+ * @param components All connected components of the mesh (see `find_component_set`)
+ * @param out The output stream (binary mode for `StlFormat::kBinary`)
+ * @param format STL encoding of the output
+ * @param stats Sink for the void detection and export timings and counters (may be null)
+ */
+void export_voids_to_stl(
+    const TriangleMesh& mesh, const ComponentSet& components, std::ostream& out,
+    StlFormat format = StlFormat::kAscii, PipelineStats* stats = nullptr
+);
 
 }  // namespace tsexam::problem1
@@ -0,0 +1,173 @@
+#include "encoded_polyline.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace tsexam::problem2 {
+
+namespace {
+
+/// Longest varint of a 32-bit value (5 x 7 bits)
+constexpr size_t kMaxVarintBytes{5};
+
+/// High bit of every byte of a 64-bit word
+constexpr uint64_t kContinuationBits{0x8080808080808080ull};
+
+/// Zig-zag maps a wrapped delta to an unsigned value: 0, -1, 1, -2, ... -> 0, 1, 2, 3, ...
+uint32_t zigzag(uint32_t delta) { return (delta << 1) ^ (0u - (delta >> 31)); }
+
+/// Inverse of `zigzag`
+uint32_t unzigzag(uint32_t encoded) { return (encoded >> 1) ^ (0u - (encoded & 1u)); }
+
+/// Appends the LEB128 varint of a value
+void put_varint(std::vector<uint8_t>& bytes, uint64_t value) {
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(value));
+}
+
+/// Reads a LEB128 varint of at most `max_bytes` bytes, advancing `position`
+uint64_t get_varint(std::span<const uint8_t> bytes, size_t& position, size_t max_bytes) {
+    uint64_t value{0};
+    for (size_t i = 0; i < max_bytes; ++i) {
+        if (position >= bytes.size()) {
+            throw std::invalid_argument("encoded polyline is truncated");
+        }
+        const uint8_t byte{bytes[position++]};
+        value |= uint64_t{byte & 0x7Fu} << (7 * i);
+        if ((byte & 0x80u) == 0) {
+            return value;
+        }
+    }
+    throw std::invalid_argument("encoded polyline holds a malformed varint");
+}
+
+}  // namespace
+
+EncodedPolyline::EncodedPolyline(PolylineView polyline) {
+    const std::span<const VertexIndex> ordering{polyline.GetCompressedSegments()};
+    if (ordering.empty()) {
+        throw std::invalid_argument("segments buffer cannot be empty");
+    }
+
+    // About one byte per index for nearby ids -> reserve that and let unrelated ids grow it
+    this->bytes_.reserve(ordering.size());
+    uint32_t previous{0};
+    for (const VertexIndex vertex : ordering) {
+        const auto current{static_cast<uint32_t>(vertex)};
+        put_varint(this->bytes_, zigzag(current - previous));
+        previous = current;
+    }
+    this->size_ = ordering.size();
+    this->closed_ = polyline.IsPolygon();
+}
+
+std::vector<VertexIndex> EncodedPolyline::Decode() const {
+    std::vector<VertexIndex> ordering(this->size_);
+    const uint8_t* in{this->bytes_.data()};
+    const uint8_t* const end{in + this->bytes_.size()};
+    uint32_t previous{0};
+    size_t i{0};
+    while (i < this->size_) {
+        // Fast path: the next eight varints are single bytes (no continuation bit in the word)
+        if (i + 8 <= this->size_ && end - in >= 8) {
+            uint64_t word;
+            std::memcpy(&word, in, sizeof(word));
+            if ((word & kContinuationBits) == 0) {
+                for (size_t k = 0; k < 8; ++k) {
+                    previous += unzigzag(static_cast<uint32_t>(in[k]));
+                    ordering[i + k] = static_cast<VertexIndex>(previous);
+                }
+                in += 8;
+                i += 8;
+                continue;
+            }
+        }
+
+        // General case: one varint of up to five bytes
+        uint32_t encoded{0};
+        for (int shift = 0;; shift += 7) {
+            const uint8_t byte{*in++};
+            encoded |= uint32_t{byte & 0x7Fu} << shift;
+            if ((byte & 0x80u) == 0) {
+                break;
+            }
+        }
+        previous += unzigzag(encoded);
+        ordering[i++] = static_cast<VertexIndex>(previous);
+    }
+    return ordering;
+}
+
+std::vector<uint8_t> EncodedPolyline::Serialize() const {
+    std::vector<uint8_t> bytes;
+    bytes.reserve(this->bytes_.size() + 2 * 10 + 1);
+    put_varint(bytes, this->size_);
+    bytes.push_back(this->closed_ ? uint8_t{1} : uint8_t{0});
+    put_varint(bytes, this->bytes_.size());
+    bytes.insert(bytes.end(), this->bytes_.begin(), this->bytes_.end());
+    return bytes;
+}
+
+EncodedPolyline EncodedPolyline::Deserialize(std::span<const uint8_t> bytes) {
+    //----------------------------------------------
+    // Header
+    //----------------------------------------------
+
+    size_t position{0};
+    const uint64_t size{get_varint(bytes, position, 10)};
+    if (size == 0) {
+        throw std::invalid_argument("segments buffer cannot be empty");
+    }
+    if (position >= bytes.size()) {
+        throw std::invalid_argument("encoded polyline is truncated");
+    }
+    const uint8_t flags{bytes[position++]};
+    if ((flags & ~uint8_t{1}) != 0) {
+        throw std::invalid_argument("encoded polyline has unknown flags " + std::to_string(flags));
+    }
+    const uint64_t payload_size{get_varint(bytes, position, 10)};
+    if (payload_size != bytes.size() - position) {
+        throw std::invalid_argument(
+            "encoded polyline payload is " + std::to_string(bytes.size() - position) +
+            " bytes, header says " + std::to_string(payload_size)
+        );
+    }
+
+    //----------------------------------------------
+    // Payload: every varint is checked, so iterating and decoding need no bounds checks
+    //----------------------------------------------
+
+    const std::span<const uint8_t> payload{bytes.subspan(position)};
+    size_t payload_position{0};
+    uint32_t previous{0};
+    uint32_t first{0};
+    for (uint64_t i = 0; i < size; ++i) {
+        const uint64_t encoded{get_varint(payload, payload_position, kMaxVarintBytes)};
+        if (encoded > UINT32_MAX) {
+            throw std::invalid_argument("encoded polyline holds a malformed varint");
+        }
+        previous += unzigzag(static_cast<uint32_t>(encoded));
+        if (i == 0) {
+            first = previous;
+        }
+    }
+    if (payload_position != payload.size()) {
+        throw std::invalid_argument("encoded polyline has trailing bytes");
+    }
+    const bool closed{size >= 2 && first == previous};
+    if (closed != ((flags & 1u) != 0)) {
+        throw std::invalid_argument("encoded polyline contradicts its closed flag");
+    }
+
+    EncodedPolyline polyline;
+    polyline.bytes_.assign(payload.begin(), payload.end());
+    polyline.size_ = static_cast<size_t>(size);
+    polyline.closed_ = closed;
+    return polyline;
+}
+
+}  // namespace tsexam::problem2
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <vector>
+
+#include "polyline.hpp"
+#include "polyline_view.hpp"
+
+namespace tsexam::problem2 {
+
+/**
+ * @brief Compressed vertex ordering stored as delta + zig-zag varint bytes
+ *
+ * Every index is stored as its difference to the previous one (the first one to 0), zig-zag mapped
+ * so small negative steps stay small, in LEB128 varint bytes: 7 payload bits per byte, the high
+ * bit set on every byte but the last. Scan-line polylines step between consecutive or nearby ids,
+ * so most entries take a single byte instead of four; unrelated ids take up to five.
+ *
+ * Only the indices are encoded; the vertex coordinates stay wherever they are. The type of the
+ * polyline is kept in a flag, so `GetType()` and `IsPolygon()` are O(1) without decoding.
+ */
+class EncodedPolyline {
+public:
+    /**
+     * @brief Forward iterator decoding one index per step
+     *
+     * Indices are decoded into the iterator and returned by value, so it is a C++20 forward
+     * iterator but only a legacy input iterator (like `std::views::iota`'s iterator).
+     */
+    class Iterator {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = VertexIndex;
+        using difference_type = std::ptrdiff_t;
+        using reference = VertexIndex;
+
+        Iterator() = default;
+
+        VertexIndex operator*() const { return value_; }
+
+        Iterator& operator++() {
+            --remaining_;
+            if (remaining_ != 0) {
+                Advance();
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous{*this};
+            ++*this;
+            return previous;
+        }
+
+        /// Iterators of the same polyline are equal if as many indices remain after them
+        bool operator==(const Iterator& other) const { return remaining_ == other.remaining_; }
+
+    private:
+        friend class EncodedPolyline;
+
+        Iterator(const uint8_t* next, size_t remaining) : next_(next), remaining_(remaining) {
+            if (remaining_ != 0) {
+                Advance();
+            }
+        }
+
+        /// Decodes the next varint and adds its zig-zag decoded delta to the current index
+        void Advance() {
+            uint32_t encoded{0};
+            for (int shift = 0;; shift += 7) {
+                const uint8_t byte{*next_++};
+                encoded |= uint32_t{byte & 0x7Fu} << shift;
+                if ((byte & 0x80u) == 0) {
+                    break;
+                }
+            }
+            // Deltas wrap modulo 2^32, so any two 32-bit indices are one delta apart
+            const uint32_t delta{(encoded >> 1) ^ (0u - (encoded & 1u))};
+            value_ = static_cast<VertexIndex>(static_cast<uint32_t>(value_) + delta);
+        }
+
+        const uint8_t* next_{nullptr};  ///< first byte of the next varint
+        size_t remaining_{0};           ///< indices left, including the current one
+        VertexIndex value_{0};          ///< current index
+    };
+
+    /**
+     * Encodes the compressed vertex ordering of a polyline
+     *
+     * @param polyline Polyline, set member or external ordering to encode
+     *
+     * @throws std::invalid_argument if the ordering is empty
+     */
+    explicit EncodedPolyline(PolylineView polyline);
+
+    /**
+     * Returns the number of indices in the compressed ordering
+     *
+     * @return Number of indices (a polygon counts its start twice)
+     */
+    size_t size() const { return size_; }
+
+    /**
+     * Returns an iterator to the first index
+     *
+     * @return Iterator decoding from the start
+     */
+    Iterator begin() const { return Iterator(bytes_.data(), size_); }
+
+    /**
+     * Returns the past-the-end iterator
+     *
+     * @return Iterator with no index left
+     */
+    Iterator end() const { return Iterator(nullptr, 0); }
+
+    /**
+     * Decodes the whole compressed ordering
+     *
+     * Runs of eight single-byte varints, the common case for nearby ids, are decoded from one
+     * 64-bit load.
+     *
+     * @return Vertex indices in traversal order
+     */
+    std::vector<VertexIndex> Decode() const;
+
+    /**
+     * Returns the topological type of the polyline
+     *
+     * @return PolylineType::kOpen or PolylineType::kClosed
+     */
+    PolylineType GetType() const { return closed_ ? PolylineType::kClosed : PolylineType::kOpen; }
+
+    /**
+     * Determines whether the polyline is a closed polygon
+     *
+     * @return true if the polyline is closed; false otherwise
+     */
+    bool IsPolygon() const { return closed_; }
+
+    /**
+     * Returns the encoded index bytes
+     *
+     * @return View of the varint payload
+     */
+    std::span<const uint8_t> GetEncodedBytes() const { return bytes_; }
+
+    /**
+     * Serializes the encoded polyline
+     *
+     * Layout: index count (varint), flags (1 byte, bit 0: closed), payload size in bytes (varint),
+     * payload. The payload is stored as is, so serializing costs one copy.
+     *
+     * @return Serialized bytes
+     */
+    std::vector<uint8_t> Serialize() const;
+
+    /**
+     * Restores an encoded polyline from `Serialize()` output
+     *
+     * @param bytes Serialized bytes
+     * @return Encoded polyline
+     *
+     * @throws std::invalid_argument if the bytes are truncated, have trailing data, hold a
+     *         malformed varint or an empty ordering, or contradict the closed flag
+     */
+    static EncodedPolyline Deserialize(std::span<const uint8_t> bytes);
+
+private:
+    EncodedPolyline() = default;
+
+    /// Delta + zig-zag varint payload
+    std::vector<uint8_t> bytes_;
+
+    /// Number of encoded indices
+    size_t size_{0};
+
+    /// Whether the ordering starts and ends with the same vertex
+    bool closed_{false};
+};
+
+}  // namespace tsexam::problem2
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <cstdint>
+#include <initializer_list>
 #include <span>
 #include <vector>
 
@@ -41,6 +42,9 @@ public:
     /**
      * Constructs a polyline from the given representation
      *
+     * Verbose segments are compressed straight from the caller's memory (e.g. a memory-mapped
+     * file); a compressed ordering is copied into the polyline.
+     *
      * @param representation Input representation format
      * @param data Vertex indices describing the polyline
      * @param vertices Optional list of vertex coordinates
@@ -48,7 +52,38 @@ public:
      * @throws std::invalid_argument if the input data violates polyline validity constraints
      */
     Polyline(
-        PolylineRepresentation representation, const std::vector<VertexIndex>& data,
+        PolylineRepresentation representation, std::span<const VertexIndex> data,
+        std::vector<Point> vertices = {}
+    );
+
+    /**
+     * Constructs a polyline from the given representation, taking over the buffer
+     *
+     * A compressed ordering becomes the polyline's storage without a copy; verbose segments are
+     * compressed as by the span constructor.
+     *
+     * @param representation Input representation format
+     * @param data Vertex indices describing the polyline (moved from)
+     * @param vertices Optional list of vertex coordinates
+     *
+     * @throws std::invalid_argument if the input data violates polyline validity constraints
+     */
+    Polyline(
+        PolylineRepresentation representation, std::vector<VertexIndex>&& data,
+        std::vector<Point> vertices = {}
+    );
+
+    /**
+     * Constructs a polyline from a braced list of vertex indices
+     *
+     * @param representation Input representation format
+     * @param data Vertex indices describing the polyline
+     * @param vertices Optional list of vertex coordinates
+     *
+     * @throws std::invalid_argument if the input data violates polyline validity constraints
+     */
+    Polyline(
+        PolylineRepresentation representation, std::initializer_list<VertexIndex> data,
         std::vector<Point> vertices = {}
     );
 
@@ -76,6 +111,9 @@ public:
     /**
      * Converts a verbose segment representation into a compressed vertex ordering
      *
+     * Connectivity is built over the whole index space, unless that space is sparse compared to
+     * the segment count, in which case the ids are compacted to dense ranks first.
+     *
      * @param segments Flat list of vertex index pairs (2N entries)
      * @param num_vertices Total number of vertices in the index space
      * @return Vertex indices in traversal order
@@ -92,6 +130,14 @@ public:
     bool IsPolygon() const;
 
 private:
+    /**
+     * Validates the input, compresses verbose segments and sets the polyline type
+     *
+     * @param representation Input representation format
+     * @param data Vertex indices describing the polyline (a compressed ordering is already stored)
+     */
+    void Initialize(PolylineRepresentation representation, std::span<const VertexIndex> data);
+
     /// List of vertices in the polyline
     std::vector<Point> vertices_;
 
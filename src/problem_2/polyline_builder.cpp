@@ -0,0 +1,346 @@
+#include "polyline_builder.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "segment_compression.hpp"
+
+namespace tsexam::problem2 {
+
+namespace {
+
+/// Table size below which ids are always kept in the table (8 bytes per slot)
+constexpr size_t kMinDenseSlots{1024};
+
+/// Text of a segment for error messages
+std::string segment_text(VertexIndex vertex_1, VertexIndex vertex_2) {
+    return "segment (" + std::to_string(vertex_1) + ", " + std::to_string(vertex_2) + ")";
+}
+
+}  // namespace
+
+void PolylineBuilder::AddSegment(VertexIndex vertex_1, VertexIndex vertex_2) {
+    //----------------------------------------------
+    // Checks (before any change, so a rejected segment leaves the builder as it was)
+    //----------------------------------------------
+
+    if (vertex_1 < 0 || vertex_2 < 0) {
+        throw std::invalid_argument(
+            "negative vertex index " + std::to_string(std::min(vertex_1, vertex_2))
+        );
+    }
+    if (vertex_1 == vertex_2) {
+        throw std::invalid_argument(
+            segment_text(vertex_1, vertex_2) + " connects a vertex to itself"
+        );
+    }
+
+    // A polygon has no endpoint left -> any further segment starts a second chain or raises a
+    // degree to 3
+    if (this->closed_) {
+        throw std::invalid_argument(
+            segment_text(vertex_1, vertex_2) + " cannot be added to a closed polygon"
+        );
+    }
+
+    this->GrowSlots(std::max(vertex_1, vertex_2));
+    VertexSlot& slot_1{this->Slot(vertex_1)};
+    VertexSlot& slot_2{this->Slot(vertex_2)};
+    const bool seen_1{this->IsSeen(slot_1)};
+    const bool seen_2{this->IsSeen(slot_2)};
+
+    // Lambda: both segments of an interior vertex are already known -> this would be its third
+    auto check_degree = [](bool seen, const VertexSlot& slot, VertexIndex vertex) {
+        if (seen && slot.state == kInterior) {
+            throw std::invalid_argument(
+                "vertex " + std::to_string(vertex) +
+                " has degree 3; expected at most 2 for a single connected polyline/polygon"
+            );
+        }
+    };
+    check_degree(seen_1, slot_1, vertex_1);
+    check_degree(seen_2, slot_2, vertex_2);
+
+    // Two endpoints of the same chain: the segment closes it, which is only valid for the single
+    // chain of a polygon, and not for the two ends of one segment (it would be repeated)
+    const bool same_chain{seen_1 && seen_2 && (slot_1.state >> 1) == (slot_2.state >> 1)};
+    if (same_chain && this->chains_[slot_1.state >> 1].size() == 2) {
+        throw std::invalid_argument(segment_text(vertex_1, vertex_2) + " is repeated");
+    }
+    if (same_chain && this->num_chains_ != 1) {
+        throw std::invalid_argument(
+            segment_text(vertex_1, vertex_2) + " closes a polygon that " +
+            std::to_string(this->num_chains_ - 1) + " other chain(s) cannot connect to"
+        );
+    }
+
+    //----------------------------------------------
+    // Join the segment into the chains
+    //----------------------------------------------
+
+    ++this->num_segments_;
+    const uint32_t generation{this->generation_};
+
+    if (!seen_1 && !seen_2) {
+        // Two new vertices -> new chain of one segment (reusing a released chain's storage)
+        uint32_t chain;
+        if (!this->free_chains_.empty()) {
+            chain = this->free_chains_.back();
+            this->free_chains_.pop_back();
+        } else {
+            chain = static_cast<uint32_t>(this->chains_.size());
+            this->chains_.emplace_back();
+        }
+        this->chains_[chain].tail.assign({vertex_1, vertex_2});
+        slot_1 = {generation, chain << 1};
+        slot_2 = {generation, chain << 1 | 1};
+        ++this->num_chains_;
+
+        // Only a new vertex can become the smallest one
+        const VertexIndex smaller{std::min(vertex_1, vertex_2)};
+        if (this->smallest_vertex_ == kUnconnectedVertex || smaller < this->smallest_vertex_) {
+            this->smallest_vertex_ = smaller;
+            this->smallest_vertex_neighbor_ = std::max(vertex_1, vertex_2);
+            this->smallest_vertex_chain_ = chain;
+            this->smallest_vertex_position_ = {false, smaller == vertex_1 ? 0u : 1u};
+        }
+
+    } else if (seen_1 != seen_2) {
+        // One new vertex -> extend the chain ending at the known one
+        const VertexIndex known{seen_1 ? vertex_1 : vertex_2};
+        const VertexIndex added{seen_1 ? vertex_2 : vertex_1};
+        VertexSlot& known_slot{seen_1 ? slot_1 : slot_2};
+        const uint32_t chain{known_slot.state >> 1};
+        const ChainPosition position{this->Extend(chain, (known_slot.state & 1) != 0, added)};
+        known_slot.state = kInterior;
+
+        if (added < this->smallest_vertex_) {
+            this->smallest_vertex_ = added;
+            this->smallest_vertex_neighbor_ = known;
+            this->smallest_vertex_chain_ = chain;
+            this->smallest_vertex_position_ = position;
+        }
+
+    } else if (same_chain) {
+        // Both ends of the single chain -> polygon
+        slot_1.state = kInterior;
+        slot_2.state = kInterior;
+        this->closed_ = true;
+
+    } else {
+        // Ends of two chains -> append the shorter one to the longer one (each vertex moves
+        // O(log N) times at most)
+        uint32_t into{slot_1.state >> 1};
+        uint32_t from{slot_2.state >> 1};
+        bool into_back{(slot_1.state & 1) != 0};
+        bool from_back{(slot_2.state & 1) != 0};
+        if (this->chains_[into].size() < this->chains_[from].size()) {
+            std::swap(into, from);
+            std::swap(into_back, from_back);
+        }
+        slot_1.state = kInterior;
+        slot_2.state = kInterior;
+        this->Join(into, into_back, from, from_back);
+        --this->num_chains_;
+    }
+}
+
+void PolylineBuilder::AddSegments(std::span<const VertexIndex> segments) {
+    if (segments.size() % 2 != 0) {
+        throw std::invalid_argument("segments buffer must contain an even number of entries");
+    }
+    for (size_t i = 0; i < segments.size(); i += 2) {
+        this->AddSegment(segments[i], segments[i + 1]);
+    }
+}
+
+Polyline PolylineBuilder::Build(std::vector<Point> vertices) {
+    //----------------------------------------------
+    // Checks
+    //----------------------------------------------
+
+    if (this->num_segments_ == 0) {
+        throw std::invalid_argument("segments buffer cannot be empty");
+    }
+    if (this->num_chains_ != 1) {
+        throw std::invalid_argument(
+            "segments do not form a single connected polyline/polygon: they form " +
+            std::to_string(this->num_chains_) + " chains"
+        );
+    }
+
+    //----------------------------------------------
+    // Write the chain in canonical order
+    //----------------------------------------------
+
+    // The single chain holds every vertex, the smallest one included
+    const Chain& chain{this->chains_[this->smallest_vertex_chain_]};
+    const std::vector<VertexIndex>& head{chain.head};
+    const std::vector<VertexIndex>& tail{chain.tail};
+    const size_t num_head{head.size()};
+    const size_t num_vertices{chain.size()};
+
+    // Lambda: vertex at a position of the chain sequence (`head` reversed, then `tail`)
+    auto at = [&](size_t i) -> VertexIndex {
+        return i < num_head ? head[num_head - 1 - i] : tail[i - num_head];
+    };
+
+    std::vector<VertexIndex> ordering;
+    ordering.reserve(this->closed_ ? num_vertices + 1 : num_vertices);
+
+    // Lambda: appends the positions [first, last) of the chain sequence, forward or backward
+    auto append = [&](size_t first, size_t last, bool backward) {
+        const size_t head_last{std::min(last, num_head)};
+        const size_t tail_first{std::max(first, num_head)};
+        auto head_range = [&] {
+            return std::pair{head.begin() + static_cast<std::ptrdiff_t>(num_head - head_last),
+                             head.begin() + static_cast<std::ptrdiff_t>(num_head - first)};
+        };
+        auto tail_range = [&] {
+            return std::pair{tail.begin() + static_cast<std::ptrdiff_t>(tail_first - num_head),
+                             tail.begin() + static_cast<std::ptrdiff_t>(last - num_head)};
+        };
+        if (!backward) {
+            if (first < head_last) {
+                const auto [begin, end] = head_range();
+                std::reverse_copy(begin, end, std::back_inserter(ordering));
+            }
+            if (tail_first < last) {
+                const auto [begin, end] = tail_range();
+                std::copy(begin, end, std::back_inserter(ordering));
+            }
+        } else {
+            if (tail_first < last) {
+                const auto [begin, end] = tail_range();
+                std::reverse_copy(begin, end, std::back_inserter(ordering));
+            }
+            if (first < head_last) {
+                const auto [begin, end] = head_range();
+                std::copy(begin, end, std::back_inserter(ordering));
+            }
+        }
+    };
+
+    if (!this->closed_) {
+        // Polyline: start at the smaller endpoint
+        append(0, num_vertices, at(num_vertices - 1) < at(0));
+    } else {
+        // Polygon: start at the smallest vertex towards the other vertex of its first segment,
+        // and repeat the start at the end
+        const ChainPosition position{this->smallest_vertex_position_};
+        const size_t start{position.in_head ? num_head - 1 - position.index
+                                            : num_head + position.index};
+        if (at((start + 1) % num_vertices) == this->smallest_vertex_neighbor_) {
+            append(start, num_vertices, false);
+            append(0, start, false);
+        } else {
+            append(0, start + 1, true);
+            append(start + 1, num_vertices, true);
+        }
+        ordering.push_back(this->smallest_vertex_);
+    }
+
+    this->Clear();
+    return Polyline(
+        PolylineRepresentation::kCompressedVertexOrdering, std::move(ordering), std::move(vertices)
+    );
+}
+
+void PolylineBuilder::Clear() {
+    // Release every chain, keeping its storage
+    this->free_chains_.clear();
+    for (size_t chain = this->chains_.size(); chain-- > 0;) {
+        this->chains_[chain].head.clear();
+        this->chains_[chain].tail.clear();
+        this->free_chains_.push_back(static_cast<uint32_t>(chain));
+    }
+
+    // New generation: every slot is unseen again without touching the table (reset once every
+    // 2^32 generations)
+    if (++this->generation_ == 0) {
+        std::fill(this->slots_.begin(), this->slots_.end(), VertexSlot{});
+        this->generation_ = 1;
+    }
+    this->sparse_slots_.clear();
+
+    this->num_segments_ = 0;
+    this->num_chains_ = 0;
+    this->closed_ = false;
+    this->smallest_vertex_ = kUnconnectedVertex;
+    this->smallest_vertex_neighbor_ = kUnconnectedVertex;
+}
+
+void PolylineBuilder::GrowSlots(VertexIndex vertex) {
+    const size_t needed{static_cast<size_t>(vertex) + 1};
+    if (this->slots_.size() >= needed) {
+        return;
+    }
+    // Table sparse for the segments so far, this one included -> the id goes to the hash map
+    if (needed > kMinDenseSlots && is_sparse_window(needed, 2 * (this->num_segments_ + 1))) {
+        return;
+    }
+
+    // Geometric growth: ids arriving in increasing order cost amortized O(1) each
+    this->slots_.resize(std::max(needed, 2 * this->slots_.size()));
+    const auto size{static_cast<VertexIndex>(std::min<size_t>(this->slots_.size(), INT32_MAX))};
+    for (auto it = this->sparse_slots_.begin(); it != this->sparse_slots_.end();) {
+        if (it->first < size) {
+            this->slots_[static_cast<size_t>(it->first)] = it->second;
+            it = this->sparse_slots_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+PolylineBuilder::VertexSlot& PolylineBuilder::Slot(VertexIndex vertex) {
+    const auto index{static_cast<size_t>(vertex)};
+    return index < this->slots_.size() ? this->slots_[index] : this->sparse_slots_[vertex];
+}
+
+PolylineBuilder::ChainPosition PolylineBuilder::Extend(
+    uint32_t chain, bool at_back, VertexIndex vertex
+) {
+    Chain& extended{this->chains_[chain]};
+    std::vector<VertexIndex>& part{at_back ? extended.tail : extended.head};
+    part.push_back(vertex);
+    const uint32_t end_state{chain << 1 | (at_back ? 1u : 0u)};
+    this->Slot(vertex) = {this->generation_, end_state};
+    return {!at_back, part.size() - 1};
+}
+
+void PolylineBuilder::Join(uint32_t into, bool at_back, uint32_t from, bool from_back) {
+    Chain& source{this->chains_[from]};
+    Chain& target{this->chains_[into]};
+    std::vector<VertexIndex>& part{at_back ? target.tail : target.head};
+    const bool moves_smallest{this->smallest_vertex_chain_ == from};
+
+    // Lambda: moves one vertex of `from` to the end of `into` (interior vertices keep their slot)
+    auto move = [&](VertexIndex vertex) {
+        if (moves_smallest && vertex == this->smallest_vertex_) {
+            this->smallest_vertex_chain_ = into;
+            this->smallest_vertex_position_ = {!at_back, part.size()};
+        }
+        part.push_back(vertex);
+    };
+
+    // `from` starting at its front is `head` reversed then `tail`; starting at its back, `tail`
+    // reversed then `head`
+    std::vector<VertexIndex>& first{from_back ? source.tail : source.head};
+    std::vector<VertexIndex>& second{from_back ? source.head : source.tail};
+    std::for_each(first.rbegin(), first.rend(), move);
+    std::for_each(second.begin(), second.end(), move);
+
+    // The far end of `from` is the new end of `into`
+    const uint32_t end_state{into << 1 | (at_back ? 1u : 0u)};
+    this->Slot(part.back()) = {this->generation_, end_state};
+
+    source.head.clear();
+    source.tail.clear();
+    this->free_chains_.push_back(from);
+}
+
+}  // namespace tsexam::problem2
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "polyline.hpp"
+
+namespace tsexam::problem2 {
+
+/**
+ * @brief Incremental construction of a polyline from segments arriving one at a time
+ *
+ * Constructing a `Polyline` from verbose segments needs the whole buffer: it scans it for the
+ * vertex window, then for the degrees, then builds the connectivity and walks it. The builder
+ * instead joins every segment into the chains built so far as it arrives: a segment starts a new
+ * chain, extends a chain at one of its endpoints, joins two chains (the shorter one is appended to
+ * the longer one) or closes a chain into a polygon. Degrees, endpoints and the number of chains
+ * are therefore known at all times, and `Build()` writes the compressed ordering straight from the
+ * single remaining chain.
+ *
+ * Invalid input is rejected by the segment that makes it invalid, which leaves the builder as it
+ * was: a vertex of degree 3, a segment from a vertex to itself, a repeated segment, or a segment
+ * added to (or next to) a closed polygon. The ordering built is the one `Polyline` produces for
+ * the same segments in the same order.
+ *
+ * Vertex state is kept in a table indexed by vertex id while the ids stay dense, i.e. while the
+ * table would not be sparse for the segments added so far (the threshold of the `Polyline` vertex
+ * window). Ids beyond it are kept in a hash map instead and move into the table once it grows
+ * over them, so memory scales with the number of segments even for ids far apart.
+ */
+class PolylineBuilder {
+public:
+    /**
+     * Constructs an empty builder
+     */
+    PolylineBuilder() = default;
+
+    /**
+     * Adds one segment
+     *
+     * @param vertex_1 First vertex of the segment
+     * @param vertex_2 Second vertex of the segment
+     *
+     * @throws std::invalid_argument if the segment cannot be part of a single connected
+     *         polyline/polygon with the segments added so far; the builder is left unchanged
+     */
+    void AddSegment(VertexIndex vertex_1, VertexIndex vertex_2);
+
+    /**
+     * Adds a batch of segments in verbose form
+     *
+     * @param segments Flat list of vertex index pairs (2N entries)
+     *
+     * @throws std::invalid_argument if the batch has an odd number of entries (nothing is added),
+     *         or as by `AddSegment` (the segments before the offending one stay added)
+     */
+    void AddSegments(std::span<const VertexIndex> segments);
+
+    /**
+     * Returns the number of segments added
+     *
+     * @return Number of segments
+     */
+    size_t GetNumSegments() const { return num_segments_; }
+
+    /**
+     * Returns the number of connected chains the segments form so far
+     *
+     * @return Number of chains (1 once the segments form a single polyline or polygon)
+     */
+    size_t GetNumChains() const { return num_chains_; }
+
+    /**
+     * Returns the topological type of the segments added so far
+     *
+     * @return PolylineType::kClosed once a segment closed the chain; PolylineType::kOpen otherwise
+     */
+    PolylineType GetType() const { return closed_ ? PolylineType::kClosed : PolylineType::kOpen; }
+
+    /**
+     * Determines whether the segments added so far form a closed polygon
+     *
+     * @return true if the polyline is closed; false otherwise
+     */
+    bool IsPolygon() const { return closed_; }
+
+    /**
+     * Builds the polyline from the segments added so far, and clears the builder
+     *
+     * @param vertices Optional list of vertex coordinates
+     * @return Polyline with the compressed ordering of the chain
+     *
+     * @throws std::invalid_argument if no segment was added or the segments form several chains;
+     *         the builder is left unchanged
+     */
+    Polyline Build(std::vector<Point> vertices = {});
+
+    /**
+     * Removes all segments, keeping the allocated storage for the next polyline
+     */
+    void Clear();
+
+private:
+    /// Chain of vertices: `head` reversed followed by `tail`, so both ends grow by `push_back`
+    struct Chain {
+        std::vector<VertexIndex> head;  ///< front part, reversed (`head.back()` is the front)
+        std::vector<VertexIndex> tail;  ///< back part (`tail.back()` is the back)
+
+        size_t size() const { return head.size() + tail.size(); }
+    };
+
+    /// Position of a vertex inside a chain: its part and its index in that part
+    struct ChainPosition {
+        bool in_head{false};
+        size_t index{0};
+    };
+
+    /// State of a vertex: its generation (older ones are unseen) and where it is in the chains
+    struct VertexSlot {
+        uint32_t generation{0};
+        uint32_t state{0};  ///< `kInterior`, or chain << 1 | end of the chain the vertex ends
+    };
+
+    /// Slot state of a vertex with two segments
+    static constexpr uint32_t kInterior{UINT32_MAX};
+
+    /**
+     * Grows the slot table to cover a vertex, unless the table would then be sparse
+     *
+     * Slots of the hash map that the grown table covers move into it.
+     *
+     * @param vertex Non-negative vertex index
+     */
+    void GrowSlots(VertexIndex vertex);
+
+    /**
+     * Returns the slot of a vertex, in the table or in the hash map (added unseen if absent)
+     *
+     * The reference stays valid until the next `GrowSlots` or `Clear`.
+     *
+     * @param vertex Non-negative vertex index
+     * @return Slot of the vertex
+     */
+    VertexSlot& Slot(VertexIndex vertex);
+
+    /// Whether a slot belongs to a vertex of the current polyline
+    bool IsSeen(const VertexSlot& slot) const { return slot.generation == generation_; }
+
+    /**
+     * Appends a vertex to one end of a chain and records it as that end
+     *
+     * @param chain Chain to extend
+     * @param at_back true to extend the back; false to extend the front
+     * @param vertex Vertex to append
+     * @return Position of the appended vertex
+     */
+    ChainPosition Extend(uint32_t chain, bool at_back, VertexIndex vertex);
+
+    /**
+     * Appends the vertices of one chain, starting from one of its ends, to an end of another one
+     *
+     * @param into Chain to extend
+     * @param at_back true to extend the back of `into`; false to extend its front
+     * @param from Chain to append, released afterwards
+     * @param from_back true to start from the back of `from`; false to start from its front
+     */
+    void Join(uint32_t into, bool at_back, uint32_t from, bool from_back);
+
+    /// Chains by id; released chains keep their storage and are listed in `free_chains_`
+    std::vector<Chain> chains_;
+    std::vector<uint32_t> free_chains_;
+
+    /// Slot of every vertex id below the table size seen in any generation
+    std::vector<VertexSlot> slots_;
+
+    /// Slots of the current polyline's vertex ids at or beyond the table size
+    std::unordered_map<VertexIndex, VertexSlot> sparse_slots_;
+
+    /// Generation of the current polyline; `Clear()` starts a new one instead of resetting slots
+    uint32_t generation_{1};
+
+    /// Number of segments added and chains formed
+    size_t num_segments_{0};
+    size_t num_chains_{0};
+
+    /// Whether a segment closed the (single) chain
+    bool closed_{false};
+
+    /// Smallest vertex, the other vertex of its first segment, and its position in the chains:
+    /// a polygon starts there and walks towards that neighbor, like the `Polyline` walk
+    VertexIndex smallest_vertex_{kUnconnectedVertex};
+    VertexIndex smallest_vertex_neighbor_{kUnconnectedVertex};
+    uint32_t smallest_vertex_chain_{0};
+    ChainPosition smallest_vertex_position_;
+};
+
+}  // namespace tsexam::problem2
@@ -0,0 +1,610 @@
+#include "polyline_geometry.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+#include "common/parallel.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define TSEXAM_GEOMETRY_AVX2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define TSEXAM_GEOMETRY_NEON 1
+#endif
+
+namespace tsexam::problem2 {
+
+namespace {
+
+/// Segments (or points) per kernel step; the NEON and scalar builds use the same four lanes, so
+/// every build sums in the same order
+constexpr size_t kLanes{4};
+
+/// Segments staged per structure-of-arrays block when the vertices are gathered on the fly
+constexpr size_t kBlockSize{256};
+
+/// Points per task of the parallel farthest-point search
+constexpr size_t kChunkSize{size_t{1} << 14};
+
+static_assert(kBlockSize % kLanes == 0, "blocks must hold whole kernel steps");
+static_assert(kChunkSize % kBlockSize == 0, "chunks must hold whole blocks");
+
+//----------------------------------------------
+// Lanes: four doubles with the arithmetic the kernels need
+//----------------------------------------------
+
+#if defined(TSEXAM_GEOMETRY_AVX2)
+
+struct Lanes {
+    __m256d v;
+};
+
+Lanes load(const double* p) { return {_mm256_loadu_pd(p)}; }
+Lanes broadcast(double s) { return {_mm256_set1_pd(s)}; }
+void store(double* p, Lanes a) { _mm256_storeu_pd(p, a.v); }
+Lanes operator+(Lanes a, Lanes b) { return {_mm256_add_pd(a.v, b.v)}; }
+Lanes operator-(Lanes a, Lanes b) { return {_mm256_sub_pd(a.v, b.v)}; }
+Lanes operator*(Lanes a, Lanes b) { return {_mm256_mul_pd(a.v, b.v)}; }
+Lanes lane_sqrt(Lanes a) { return {_mm256_sqrt_pd(a.v)}; }
+Lanes lane_min(Lanes a, Lanes b) { return {_mm256_min_pd(a.v, b.v)}; }
+Lanes lane_max(Lanes a, Lanes b) { return {_mm256_max_pd(a.v, b.v)}; }
+
+#elif defined(TSEXAM_GEOMETRY_NEON)
+
+struct Lanes {
+    float64x2_t lo, hi;
+};
+
+Lanes load(const double* p) { return {vld1q_f64(p), vld1q_f64(p + 2)}; }
+Lanes broadcast(double s) { return {vdupq_n_f64(s), vdupq_n_f64(s)}; }
+void store(double* p, Lanes a) {
+    vst1q_f64(p, a.lo);
+    vst1q_f64(p + 2, a.hi);
+}
+Lanes operator+(Lanes a, Lanes b) { return {vaddq_f64(a.lo, b.lo), vaddq_f64(a.hi, b.hi)}; }
+Lanes operator-(Lanes a, Lanes b) { return {vsubq_f64(a.lo, b.lo), vsubq_f64(a.hi, b.hi)}; }
+Lanes operator*(Lanes a, Lanes b) { return {vmulq_f64(a.lo, b.lo), vmulq_f64(a.hi, b.hi)}; }
+Lanes lane_sqrt(Lanes a) { return {vsqrtq_f64(a.lo), vsqrtq_f64(a.hi)}; }
+Lanes lane_min(Lanes a, Lanes b) { return {vminq_f64(a.lo, b.lo), vminq_f64(a.hi, b.hi)}; }
+Lanes lane_max(Lanes a, Lanes b) { return {vmaxq_f64(a.lo, b.lo), vmaxq_f64(a.hi, b.hi)}; }
+
+#else
+
+// Portable fallback: fixed-size loops the compiler can vectorize for the target
+struct Lanes {
+    std::array<double, kLanes> v;
+};
+
+template <typename Op>
+Lanes lane_wise(Lanes a, Lanes b, Op op) {
+    Lanes result;
+    for (size_t i = 0; i < kLanes; ++i) {
+        result.v[i] = op(a.v[i], b.v[i]);
+    }
+    return result;
+}
+
+Lanes load(const double* p) { return {{p[0], p[1], p[2], p[3]}}; }
+Lanes broadcast(double s) { return {{s, s, s, s}}; }
+void store(double* p, Lanes a) { std::copy(a.v.begin(), a.v.end(), p); }
+Lanes operator+(Lanes a, Lanes b) { return lane_wise(a, b, std::plus<>{}); }
+Lanes operator-(Lanes a, Lanes b) { return lane_wise(a, b, std::minus<>{}); }
+Lanes operator*(Lanes a, Lanes b) { return lane_wise(a, b, std::multiplies<>{}); }
+Lanes lane_sqrt(Lanes a) {
+    return lane_wise(a, a, [](double x, double) { return std::sqrt(x); });
+}
+Lanes lane_min(Lanes a, Lanes b) {
+    return lane_wise(a, b, [](double x, double y) { return std::min(x, y); });
+}
+Lanes lane_max(Lanes a, Lanes b) {
+    return lane_wise(a, b, [](double x, double y) { return std::max(x, y); });
+}
+
+#endif  // TSEXAM_GEOMETRY_AVX2 / TSEXAM_GEOMETRY_NEON
+
+/// The four lanes of a value, in order
+std::array<double, kLanes> lanes_of(Lanes a) {
+    std::array<double, kLanes> lanes;
+    store(lanes.data(), a);
+    return lanes;
+}
+
+/// Sum of the lanes, always paired the same way
+double reduce_add(Lanes a) {
+    const std::array<double, kLanes> l{lanes_of(a)};
+    return (l[0] + l[1]) + (l[2] + l[3]);
+}
+
+double reduce_min(Lanes a) {
+    const std::array<double, kLanes> l{lanes_of(a)};
+    return std::min(std::min(l[0], l[1]), std::min(l[2], l[3]));
+}
+
+double reduce_max(Lanes a) {
+    const std::array<double, kLanes> l{lanes_of(a)};
+    return std::max(std::max(l[0], l[1]), std::max(l[2], l[3]));
+}
+
+/// Number of kernel steps covering `count` items
+size_t num_steps(size_t count) { return (count + kLanes - 1) / kLanes; }
+
+//----------------------------------------------
+// Point streams
+//----------------------------------------------
+
+/// Coordinates of consecutive points of the traversal, padded by repeating the last point through
+/// index `count + kLanes - 1` at least, so kernel steps may read past the last point
+struct PointStream {
+    const double* x;
+    const double* y;
+    const double* z;
+    size_t count;  ///< number of points (count - 1 segments)
+};
+
+/// Points of the traversal staged into structure-of-arrays blocks
+struct alignas(32) PointBlock {
+    std::array<std::array<double, kBlockSize + 2 * kLanes>, 3> coords;
+};
+
+/// Vertex of an index in the compressed ordering, checked against the vertex coordinates
+const Point& vertex_at(std::span<const Point> vertices, VertexIndex vertex) {
+    if (vertex < 0 || static_cast<size_t>(vertex) >= vertices.size()) {
+        throw std::invalid_argument(
+            "vertex " + std::to_string(vertex) + " has no coordinates (" +
+            std::to_string(vertices.size()) + " vertices)"
+        );
+    }
+    return vertices[static_cast<size_t>(vertex)];
+}
+
+/**
+ * Calls `kernel(stream)` on consecutive pieces of the traversal of a polyline
+ *
+ * The vertices are gathered through the compressed ordering into one block at a time. Blocks
+ * overlap by one point, so every segment is in exactly one block.
+ */
+template <typename Kernel>
+void for_each_block(PolylineView polyline, Kernel&& kernel) {
+    const std::span<const VertexIndex> ordering{polyline.GetCompressedSegments()};
+    const std::span<const Point> vertices{polyline.GetVertices()};
+    PointBlock block;
+    size_t first{0};
+    do {
+        // Points [first, first + count) with the last one repeated as padding
+        const size_t count{std::min(kBlockSize + 1, ordering.size() - first)};
+        for (size_t i = 0; i < count; ++i) {
+            const Point& p{vertex_at(vertices, ordering[first + i])};
+            for (size_t d = 0; d < 3; ++d) {
+                block.coords[d][i] = p[d];
+            }
+        }
+        for (auto& row : block.coords) {
+            std::fill(row.begin() + static_cast<std::ptrdiff_t>(count), row.end(), row[count - 1]);
+        }
+        kernel(PointStream{
+            block.coords[0].data(), block.coords[1].data(), block.coords[2].data(), count
+        });
+        first += count - 1;
+    } while (first + 1 < ordering.size());
+}
+
+/// Stream over all points of a traversal
+PointStream stream_of(const TraversalVertices& points) {
+    return {points.GetX().data(), points.GetY().data(), points.GetZ().data(), points.size()};
+}
+
+//----------------------------------------------
+// Kernels
+//----------------------------------------------
+
+/// Adds the lengths of the segments of a stream to per-lane sums
+void accumulate_length(const PointStream& s, Lanes& sum) {
+    for (size_t j = 0; j < num_steps(s.count - 1) * kLanes; j += kLanes) {
+        const Lanes dx{load(s.x + j + 1) - load(s.x + j)};
+        const Lanes dy{load(s.y + j + 1) - load(s.y + j)};
+        const Lanes dz{load(s.z + j + 1) - load(s.z + j)};
+        sum = sum + lane_sqrt(dx * dx + dy * dy + dz * dz);
+    }
+}
+
+/// Writes the lengths of the segments of a stream, and up to `kLanes - 1` more past them
+void store_lengths(const PointStream& s, double* lengths) {
+    for (size_t j = 0; j < num_steps(s.count - 1) * kLanes; j += kLanes) {
+        const Lanes dx{load(s.x + j + 1) - load(s.x + j)};
+        const Lanes dy{load(s.y + j + 1) - load(s.y + j)};
+        const Lanes dz{load(s.z + j + 1) - load(s.z + j)};
+        store(lengths + j, lane_sqrt(dx * dx + dy * dy + dz * dz));
+    }
+}
+
+/// Per-lane bounds of the points of a stream
+struct LaneBounds {
+    std::array<Lanes, 3> min;
+    std::array<Lanes, 3> max;
+};
+
+void accumulate_bounds(const PointStream& s, LaneBounds& bounds) {
+    const std::array<const double*, 3> coords{s.x, s.y, s.z};
+    for (size_t j = 0; j < num_steps(s.count) * kLanes; j += kLanes) {
+        for (size_t d = 0; d < 3; ++d) {
+            const Lanes c{load(coords[d] + j)};
+            bounds.min[d] = lane_min(bounds.min[d], c);
+            bounds.max[d] = lane_max(bounds.max[d], c);
+        }
+    }
+}
+
+/**
+ * Per-lane moments of a polygon relative to its start `o`: the vector area A = sum of
+ * cross(q_j, q_j+1) / 2 with q = p - o, and M = sum of (q_j + q_j+1) / 3 (x) a_j, the fan
+ * triangle centroids weighed by their vector areas (scaled by 6 and 2 until the end)
+ */
+struct LaneMoments {
+    std::array<Lanes, 3> area;
+    std::array<Lanes, 9> centroid;
+};
+
+void accumulate_moments(const PointStream& s, const Point& origin, LaneMoments& moments) {
+    const Lanes ox{broadcast(origin[0])}, oy{broadcast(origin[1])}, oz{broadcast(origin[2])};
+    for (size_t j = 0; j < num_steps(s.count - 1) * kLanes; j += kLanes) {
+        const Lanes ax{load(s.x + j) - ox}, ay{load(s.y + j) - oy}, az{load(s.z + j) - oz};
+        const Lanes bx{load(s.x + j + 1) - ox}, by{load(s.y + j + 1) - oy};
+        const Lanes bz{load(s.z + j + 1) - oz};
+        const std::array<Lanes, 3> cross{ay * bz - az * by, az * bx - ax * bz, ax * by - ay * bx};
+        const std::array<Lanes, 3> sum{ax + bx, ay + by, az + bz};
+        for (size_t k = 0; k < 3; ++k) {
+            moments.area[k] = moments.area[k] + cross[k];
+            for (size_t i = 0; i < 3; ++i) {
+                moments.centroid[3 * i + k] = moments.centroid[3 * i + k] + sum[i] * cross[k];
+            }
+        }
+    }
+}
+
+/// Farthest point of a range and its squared distance
+struct FarthestPoint {
+    double distance_squared{-1.};
+    size_t index{0};
+};
+
+/**
+ * Finds the point of [begin, end) farthest from the segment between points `first` and `last`
+ * (the first one on ties)
+ */
+FarthestPoint find_farthest(
+    const PointStream& s, size_t first, size_t last, size_t begin, size_t end
+) {
+    const double ux{s.x[last] - s.x[first]};
+    const double uy{s.y[last] - s.y[first]};
+    const double uz{s.z[last] - s.z[first]};
+    const double length_squared{ux * ux + uy * uy + uz * uz};
+
+    // Degenerate segment (the start and end of a polygon) -> distance to its point
+    const Lanes inverse{broadcast(length_squared > 0. ? 1. / length_squared : 0.)};
+    const Lanes vx{broadcast(ux)}, vy{broadcast(uy)}, vz{broadcast(uz)};
+    const Lanes ax{broadcast(s.x[first])}, ay{broadcast(s.y[first])}, az{broadcast(s.z[first])};
+    const Lanes zero{broadcast(0.)}, one{broadcast(1.)};
+
+    FarthestPoint farthest;
+    std::array<double, kBlockSize> distances;
+    for (size_t block = begin; block < end; block += kBlockSize) {
+        const size_t count{std::min(kBlockSize, end - block)};
+        for (size_t j = 0; j < num_steps(count) * kLanes; j += kLanes) {
+            const Lanes dx{load(s.x + block + j) - ax};
+            const Lanes dy{load(s.y + block + j) - ay};
+            const Lanes dz{load(s.z + block + j) - az};
+
+            // Projection onto the segment, clamped to its ends
+            const Lanes t{lane_min(lane_max((dx * vx + dy * vy + dz * vz) * inverse, zero), one)};
+            const Lanes ex{dx - t * vx}, ey{dy - t * vy}, ez{dz - t * vz};
+            store(distances.data() + j, ex * ex + ey * ey + ez * ez);
+        }
+        for (size_t j = 0; j < count; ++j) {
+            if (distances[j] > farthest.distance_squared) {
+                farthest = {distances[j], block + j};
+            }
+        }
+    }
+    return farthest;
+}
+
+}  // namespace
+
+//----------------------------------------------
+// Traversal vertices
+//----------------------------------------------
+
+TraversalVertices::TraversalVertices(PolylineView polyline) {
+    const std::span<const VertexIndex> ordering{polyline.GetCompressedSegments()};
+    const std::span<const Point> vertices{polyline.GetVertices()};
+
+    // Padding: the last point repeated through a whole kernel step past the last read
+    this->size_ = ordering.size();
+    const size_t padded{num_steps(this->size_) * kLanes + kLanes};
+    this->x_.resize(padded);
+    this->y_.resize(padded);
+    this->z_.resize(padded);
+    for (size_t i = 0; i < this->size_; ++i) {
+        const Point& p{vertex_at(vertices, ordering[i])};
+        this->x_[i] = p[0];
+        this->y_[i] = p[1];
+        this->z_[i] = p[2];
+    }
+    for (std::vector<double>* coords : {&this->x_, &this->y_, &this->z_}) {
+        std::fill(coords->begin() + static_cast<std::ptrdiff_t>(this->size_), coords->end(),
+                  (*coords)[this->size_ - 1]);
+    }
+    this->closed_ = polyline.IsPolygon();
+}
+
+//----------------------------------------------
+// Length and bounds
+//----------------------------------------------
+
+double polyline_length(PolylineView polyline) {
+    Lanes sum{broadcast(0.)};
+    for_each_block(polyline, [&](const PointStream& s) { accumulate_length(s, sum); });
+    return reduce_add(sum);
+}
+
+double polyline_length(const TraversalVertices& points) {
+    Lanes sum{broadcast(0.)};
+    accumulate_length(stream_of(points), sum);
+    return reduce_add(sum);
+}
+
+std::vector<double> segment_lengths(PolylineView polyline) {
+    // Room for the lanes past the last segment, dropped at the end
+    const size_t num_segments{polyline.GetCompressedSegments().size() - 1};
+    std::vector<double> lengths(num_steps(num_segments) * kLanes + kLanes);
+    size_t first{0};
+    for_each_block(polyline, [&](const PointStream& s) {
+        store_lengths(s, lengths.data() + first);
+        first += s.count - 1;
+    });
+    lengths.resize(num_segments);
+    return lengths;
+}
+
+std::vector<double> segment_lengths(const TraversalVertices& points) {
+    const size_t num_segments{points.size() - 1};
+    std::vector<double> lengths(num_steps(num_segments) * kLanes);
+    store_lengths(stream_of(points), lengths.data());
+    lengths.resize(num_segments);
+    return lengths;
+}
+
+namespace {
+
+/// Bounds from per-lane bounds started at the first point
+template <typename Accumulate>
+BoundingBox reduce_bounds(const Point& first, Accumulate&& accumulate) {
+    LaneBounds bounds;
+    for (size_t d = 0; d < 3; ++d) {
+        bounds.min[d] = broadcast(first[d]);
+        bounds.max[d] = broadcast(first[d]);
+    }
+    accumulate(bounds);
+    BoundingBox box;
+    for (size_t d = 0; d < 3; ++d) {
+        box.min[d] = reduce_min(bounds.min[d]);
+        box.max[d] = reduce_max(bounds.max[d]);
+    }
+    return box;
+}
+
+}  // namespace
+
+BoundingBox polyline_bounds(PolylineView polyline) {
+    const Point& first{vertex_at(polyline.GetVertices(), polyline.GetCompressedSegments().front())};
+    return reduce_bounds(first, [&](LaneBounds& bounds) {
+        for_each_block(polyline, [&](const PointStream& s) { accumulate_bounds(s, bounds); });
+    });
+}
+
+BoundingBox polyline_bounds(const TraversalVertices& points) {
+    const Point first{points.GetX()[0], points.GetY()[0], points.GetZ()[0]};
+    return reduce_bounds(first, [&](LaneBounds& bounds) {
+        accumulate_bounds(stream_of(points), bounds);
+    });
+}
+
+//----------------------------------------------
+// Polygon area and centroid
+//----------------------------------------------
+
+namespace {
+
+/// Area, centroid and normal from the moments relative to the start vertex
+template <typename Accumulate>
+PolygonProperties reduce_moments(bool closed, const Point& origin, Accumulate&& accumulate) {
+    if (!closed) {
+        throw std::invalid_argument("polygon properties require a closed polyline");
+    }
+    LaneMoments moments;
+    moments.area.fill(broadcast(0.));
+    moments.centroid.fill(broadcast(0.));
+    accumulate(moments);
+
+    // Lanes hold 2 A and 6 M
+    Point area_vector;
+    for (size_t k = 0; k < 3; ++k) {
+        area_vector[k] = reduce_add(moments.area[k]) / 2.;
+    }
+    const double area{std::sqrt(area_vector[0] * area_vector[0] +
+                                area_vector[1] * area_vector[1] +
+                                area_vector[2] * area_vector[2])};
+
+    PolygonProperties properties{area, origin, {0., 0., 0.}};
+    if (area == 0.) {
+        return properties;
+    }
+    for (size_t k = 0; k < 3; ++k) {
+        properties.normal[k] = area_vector[k] / area;
+    }
+
+    // centroid = o + M n / |A|
+    for (size_t i = 0; i < 3; ++i) {
+        double projected{0.};
+        for (size_t k = 0; k < 3; ++k) {
+            projected += reduce_add(moments.centroid[3 * i + k]) / 6. * properties.normal[k];
+        }
+        properties.centroid[i] += projected / area;
+    }
+    return properties;
+}
+
+}  // namespace
+
+PolygonProperties polygon_properties(PolylineView polygon) {
+    const Point& origin{vertex_at(polygon.GetVertices(), polygon.GetCompressedSegments().front())};
+    return reduce_moments(polygon.IsPolygon(), origin, [&](LaneMoments& moments) {
+        for_each_block(polygon, [&](const PointStream& s) {
+            accumulate_moments(s, origin, moments);
+        });
+    });
+}
+
+PolygonProperties polygon_properties(const TraversalVertices& points) {
+    const Point origin{points.GetX()[0], points.GetY()[0], points.GetZ()[0]};
+    return reduce_moments(points.IsPolygon(), origin, [&](LaneMoments& moments) {
+        accumulate_moments(stream_of(points), origin, moments);
+    });
+}
+
+//----------------------------------------------
+// Douglas–Peucker simplification
+//----------------------------------------------
+
+std::vector<VertexIndex> simplify_douglas_peucker(
+    PolylineView polyline, double tolerance, size_t num_threads
+) {
+    if (!(tolerance >= 0.)) {
+        throw std::invalid_argument(
+            "tolerance must be a non-negative number, got " + std::to_string(tolerance)
+        );
+    }
+    const std::span<const VertexIndex> ordering{polyline.GetCompressedSegments()};
+    const TraversalVertices points{polyline};
+    const PointStream stream{stream_of(points)};
+    const size_t num_points{points.size()};
+    if (num_points <= 2) {
+        return {ordering.begin(), ordering.end()};
+    }
+    const double tolerance_squared{tolerance * tolerance};
+
+    // Ranges of the traversal whose ends are kept; the root range of a polygon is always split
+    struct Range {
+        size_t first;
+        size_t last;
+        bool forced;
+    };
+    std::vector<uint8_t> keep(num_points, 0);
+    keep.front() = 1;
+    keep.back() = 1;
+
+    // Lambda: keeps the farthest point of a range if needed and queues its two halves
+    auto split = [&](const Range& range, const FarthestPoint& farthest, std::vector<Range>& next) {
+        if (!range.forced && !(farthest.distance_squared > tolerance_squared)) {
+            return;
+        }
+        keep[farthest.index] = 1;
+        for (const Range half : {Range{range.first, farthest.index, false},
+                                 Range{farthest.index, range.last, false}}) {
+            if (half.last - half.first >= 2) {
+                next.push_back(half);
+            }
+        }
+    };
+
+    //----------------------------------------------
+    // Parallel levels: the points of all ranges of a level are cut into chunks, and the farthest
+    // point of a range is the first of the farthest points of its chunks
+    //----------------------------------------------
+
+    const size_t thread_count{common::resolve_thread_count(num_threads)};
+    std::vector<Range> level{{0, num_points - 1, points.IsPolygon()}};
+    std::vector<Range> next;
+    struct Chunk {
+        size_t range;
+        size_t begin;
+        size_t end;
+    };
+    std::vector<Chunk> chunks;
+    std::vector<FarthestPoint> chunk_farthest;
+    while (thread_count > 1 && !level.empty()) {
+        chunks.clear();
+        for (size_t r = 0; r < level.size(); ++r) {
+            for (size_t begin = level[r].first + 1; begin < level[r].last; begin += kChunkSize) {
+                chunks.push_back({r, begin, std::min(begin + kChunkSize, level[r].last)});
+            }
+        }
+        // Too little work left to share -> finish sequentially
+        if (chunks.size() < 2 * thread_count) {
+            break;
+        }
+        chunk_farthest.assign(chunks.size(), FarthestPoint{});
+        common::parallel_for(chunks.size(), thread_count, [&](size_t c) {
+            const Range& range{level[chunks[c].range]};
+            chunk_farthest[c] =
+                find_farthest(stream, range.first, range.last, chunks[c].begin, chunks[c].end);
+        });
+
+        next.clear();
+        for (size_t c = 0; c < chunks.size();) {
+            FarthestPoint farthest{chunk_farthest[c]};
+            const size_t r{chunks[c].range};
+            for (++c; c < chunks.size() && chunks[c].range == r; ++c) {
+                if (chunk_farthest[c].distance_squared > farthest.distance_squared) {
+                    farthest = chunk_farthest[c];
+                }
+            }
+            split(level[r], farthest, next);
+        }
+        std::swap(level, next);
+    }
+
+    //----------------------------------------------
+    // Sequential: depth-first over the remaining ranges
+    //----------------------------------------------
+
+    while (!level.empty()) {
+        const Range range{level.back()};
+        level.pop_back();
+        split(range, find_farthest(stream, range.first, range.last, range.first + 1, range.last),
+              level);
+    }
+
+    // A polygon reduced to its start and farthest point also keeps the farthest point of the
+    // farther half, so it keeps at least three vertices
+    if (points.IsPolygon() && num_points >= 4 &&
+        std::count(keep.begin(), keep.end(), uint8_t{1}) < 4) {
+        const auto middle{static_cast<size_t>(
+            std::find(keep.begin() + 1, keep.end(), uint8_t{1}) - keep.begin()
+        )};
+        FarthestPoint farthest{find_farthest(stream, 0, middle, 1, middle)};
+        const FarthestPoint second{
+            find_farthest(stream, middle, num_points - 1, middle + 1, num_points - 1)
+        };
+        if (second.distance_squared > farthest.distance_squared) {
+            farthest = second;
+        }
+        keep[farthest.index] = 1;
+    }
+
+    std::vector<VertexIndex> simplified;
+    for (size_t i = 0; i < num_points; ++i) {
+        if (keep[i] != 0) {
+            simplified.push_back(ordering[i]);
+        }
+    }
+    return simplified;
+}
+
+}  // namespace tsexam::problem2
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "polyline.hpp"
+#include "polyline_view.hpp"
+
+namespace tsexam::problem2 {
+
+/// Axis-aligned bounding box
+struct BoundingBox {
+    Point min;  ///< smallest coordinate along every axis
+    Point max;  ///< largest coordinate along every axis
+};
+
+/// Area, centroid and orientation of a closed planar polygon
+struct PolygonProperties {
+    double area;     ///< enclosed area
+    Point centroid;  ///< area centroid
+    Point normal;    ///< unit normal, oriented by the traversal (right-hand rule); 0 if area is 0
+};
+
+/**
+ * @brief Vertex coordinates of a polyline in traversal order, in structure-of-arrays layout
+ *
+ * The geometric kernels read the vertices of a polyline in the order of its compressed ordering,
+ * which gathers them through the indices when they come from `GetVertices()`. Reordering them once
+ * into contiguous x, y and z arrays lets every later kernel stream them instead. The arrays are
+ * padded by repeating the last point up to a whole kernel step, which leaves every kernel result
+ * unchanged.
+ */
+class TraversalVertices {
+public:
+    /**
+     * Gathers the vertices of a polyline in traversal order
+     *
+     * @param polyline Polyline, set member or external ordering with its vertex coordinates
+     *
+     * @throws std::invalid_argument if an index of the ordering has no vertex coordinates
+     */
+    explicit TraversalVertices(PolylineView polyline);
+
+    /**
+     * Returns the number of points (a polygon repeats its start at the end)
+     *
+     * @return Number of points in traversal order
+     */
+    size_t size() const { return size_; }
+
+    /**
+     * Returns the x coordinates in traversal order
+     *
+     * @return View of `size()` coordinates (the padding follows them in memory)
+     */
+    std::span<const double> GetX() const { return {x_.data(), size_}; }
+
+    /**
+     * Returns the y coordinates in traversal order
+     *
+     * @return View of `size()` coordinates
+     */
+    std::span<const double> GetY() const { return {y_.data(), size_}; }
+
+    /**
+     * Returns the z coordinates in traversal order
+     *
+     * @return View of `size()` coordinates
+     */
+    std::span<const double> GetZ() const { return {z_.data(), size_}; }
+
+    /**
+     * Determines whether the points form a closed polygon
+     *
+     * @return true if the polyline is closed; false otherwise
+     */
+    bool IsPolygon() const { return closed_; }
+
+private:
+    /// Coordinates in traversal order, padded to whole kernel steps
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> z_;
+
+    /// Number of points before the padding
+    size_t size_{0};
+
+    /// Whether the ordering starts and ends with the same vertex
+    bool closed_{false};
+};
+
+/**
+ * Computes the total length of a polyline
+ *
+ * @param polyline Polyline with vertex coordinates
+ * @return Sum of the segment lengths
+ *
+ * @throws std::invalid_argument if an index of the ordering has no vertex coordinates
+ */
+double polyline_length(PolylineView polyline);
+
+/**
+ * Computes the total length of a polyline from its vertices in traversal order
+ *
+ * @param points Vertices in traversal order
+ * @return Sum of the segment lengths
+ */
+double polyline_length(const TraversalVertices& points);
+
+/**
+ * Computes the length of every segment of a polyline
+ *
+ * @param polyline Polyline with vertex coordinates
+ * @return Length of segment i (from point i to point i + 1 of the traversal), for every segment
+ *
+ * @throws std::invalid_argument if an index of the ordering has no vertex coordinates
+ */
+std::vector<double> segment_lengths(PolylineView polyline);
+
+/**
+ * Computes the length of every segment from the vertices in traversal order
+ *
+ * @param points Vertices in traversal order
+ * @return Length of segment i (from point i to point i + 1), for every segment
+ */
+std::vector<double> segment_lengths(const TraversalVertices& points);
+
+/**
+ * Computes the axis-aligned bounding box of a polyline
+ *
+ * @param polyline Polyline with vertex coordinates
+ * @return Bounding box of the traversed vertices
+ *
+ * @throws std::invalid_argument if an index of the ordering has no vertex coordinates
+ */
+BoundingBox polyline_bounds(PolylineView polyline);
+
+/**
+ * Computes the axis-aligned bounding box from the vertices in traversal order
+ *
+ * @param points Vertices in traversal order
+ * @return Bounding box of the points
+ */
+BoundingBox polyline_bounds(const TraversalVertices& points);
+
+/**
+ * Computes the area, centroid and normal of a closed planar polygon
+ *
+ * The vector area (half the sum of the cross products of consecutive vertices) gives the area and
+ * the normal; the centroid weighs the triangles of a fan from the start vertex by their area along
+ * that normal, so non-convex polygons are handled. Vertices are taken relative to the start vertex,
+ * which keeps the precision of polygons far from the origin.
+ *
+ * @param polygon Closed polyline with vertex coordinates
+ * @return Area, centroid and normal (the centroid of a zero-area polygon is its start vertex)
+ *
+ * @throws std::invalid_argument if the polyline is open or an index has no vertex coordinates
+ */
+PolygonProperties polygon_properties(PolylineView polygon);
+
+/**
+ * Computes the area, centroid and normal of a closed planar polygon from its vertices in
+ * traversal order
+ *
+ * @param points Vertices of a polygon in traversal order
+ * @return Area, centroid and normal (the centroid of a zero-area polygon is its start vertex)
+ *
+ * @throws std::invalid_argument if the points do not form a closed polyline
+ */
+PolygonProperties polygon_properties(const TraversalVertices& points);
+
+/**
+ * Simplifies a polyline with the Douglas–Peucker algorithm
+ *
+ * Every range of the traversal keeps the point farthest from the segment between its ends (the
+ * first one on ties) if it is farther than `tolerance`, and then is handled as two ranges. The
+ * ends of an open polyline are always kept. A polygon keeps its start and the point farthest from
+ * it, and at least one more point if it has one, so it remains a polygon.
+ *
+ * The ranges of one level of the recursion, and the points of large ranges, are split into tasks
+ * over `num_threads` threads; the result does not depend on the thread count.
+ *
+ * @param polyline Polyline with vertex coordinates
+ * @param tolerance Largest distance of a dropped point to the simplified polyline (>= 0)
+ * @param num_threads Number of threads (0: one per hardware core)
+ * @return Compressed ordering of the kept vertices, in traversal order
+ *
+ * @throws std::invalid_argument if the tolerance is negative or not a number, or an index of the
+ *         ordering has no vertex coordinates
+ */
+std::vector<VertexIndex> simplify_douglas_peucker(
+    PolylineView polyline, double tolerance, size_t num_threads = 1
+);
+
+}  // namespace tsexam::problem2
@@ -0,0 +1,146 @@
+#include "polyline_set.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "common/parallel.hpp"
+#include "segment_compression.hpp"
+
+namespace tsexam::problem2 {
+
+namespace {
+
+/// Polylines per parallel task. A multiple of 64, so every word of the type bitset is written by
+/// a single task.
+constexpr size_t kPolylinesPerChunk{4096};
+
+/// First invalid polyline of a chunk
+struct PolylineError {
+    size_t polyline;      ///< index of the polyline in the set
+    std::string message;  ///< validation message of the `Polyline` constructor
+};
+
+/// Throws unless `offsets` delimit a buffer of `size` entries
+void check_offsets(std::span<const size_t> offsets, size_t size) {
+    if (offsets.empty() || offsets.front() != 0 || offsets.back() != size) {
+        throw std::invalid_argument(
+            "offsets must start at 0 and end at the size of the data buffer"
+        );
+    }
+    if (std::adjacent_find(offsets.begin(), offsets.end(), std::greater<size_t>()) !=
+        offsets.end()) {
+        throw std::invalid_argument("offsets must be non-decreasing");
+    }
+}
+
+}  // namespace
+
+PolylineSet::PolylineSet(
+    PolylineRepresentation representation, std::span<const VertexIndex> data,
+    std::span<const size_t> offsets, std::vector<Point> vertices, size_t num_threads
+)
+    : vertices_(std::move(vertices)) {
+    //----------------------------------------------
+    // Checks
+    //----------------------------------------------
+
+    // Offsets must delimit the data buffer -> throw otherwise
+    check_offsets(offsets, data.size());
+    if (representation != PolylineRepresentation::kVerboseSegments &&
+        representation != PolylineRepresentation::kCompressedVertexOrdering) {
+        throw std::invalid_argument("Invalid PolylineRepresentation value: not supported");
+    }
+    const bool verbose{representation == PolylineRepresentation::kVerboseSegments};
+    const size_t num_polylines{offsets.size() - 1};
+
+    //----------------------------------------------
+    // Output layout
+    //----------------------------------------------
+
+    // A valid polyline of N segments compresses to N + 1 entries, so every ordering's place in the
+    // flat buffer is known before anything is compressed
+    std::vector<size_t> output_offsets(num_polylines + 1, 0);
+    for (size_t i = 0; i < num_polylines; ++i) {
+        const size_t input_size{offsets[i + 1] - offsets[i]};
+        output_offsets[i + 1] = output_offsets[i] + (verbose ? input_size / 2 + 1 : input_size);
+    }
+    this->offsets_ = std::move(output_offsets);
+    this->indices_.resize(this->offsets_.back());
+    this->closed_.assign((num_polylines + 63) / 64, 0);
+
+    //----------------------------------------------
+    // Validate and compress, one chunk of polylines per task
+    //----------------------------------------------
+
+    const size_t num_chunks{(num_polylines + kPolylinesPerChunk - 1) / kPolylinesPerChunk};
+    std::vector<std::optional<PolylineError>> errors(num_chunks);
+    tsexam::common::parallel_for(num_chunks, num_threads, [&](size_t chunk) {
+        SegmentScratch scratch;  // reused by all polylines of the chunk
+        const size_t begin{chunk * kPolylinesPerChunk};
+        const size_t end{std::min(begin + kPolylinesPerChunk, num_polylines)};
+        for (size_t i = begin; i < end; ++i) {
+            const std::span<const VertexIndex> input{
+                data.subspan(offsets[i], offsets[i + 1] - offsets[i])
+            };
+            const std::span<VertexIndex> ordering{
+                this->indices_.data() + this->offsets_[i], this->offsets_[i + 1] - this->offsets_[i]
+            };
+            try {
+                if (input.empty()) {
+                    throw std::invalid_argument("segments buffer cannot be empty");
+                }
+                if (verbose) {
+                    compress_verbose_segments(input, scratch, ordering);
+                } else {
+                    std::copy(input.begin(), input.end(), ordering.begin());
+                }
+            } catch (const std::invalid_argument& e) {
+                // Later polylines of the chunk cannot have a smaller index -> stop the chunk
+                errors[chunk] = PolylineError{i, e.what()};
+                return;
+            }
+
+            // A polygon's compressed ordering starts and ends with the same vertex
+            if (ordering.size() >= 2 && ordering.front() == ordering.back()) {
+                this->closed_[i / 64] |= uint64_t{1} << (i % 64);
+            }
+        }
+    });
+
+    // Chunks are in polyline order -> the first error is the smallest invalid index
+    for (const std::optional<PolylineError>& error : errors) {
+        if (error) {
+            throw std::invalid_argument(
+                "polyline " + std::to_string(error->polyline) + ": " + error->message
+            );
+        }
+    }
+}
+
+PolylineSet::PolylineSet(
+    std::vector<VertexIndex> indices, std::vector<size_t> offsets, std::vector<Point> vertices
+)
+    : vertices_(std::move(vertices)), indices_(std::move(indices)), offsets_(std::move(offsets)) {
+    check_offsets(this->offsets_, this->indices_.size());
+
+    // Derive the type bitset, as the bulk constructor does for every polyline it compresses
+    const size_t num_polylines{this->offsets_.size() - 1};
+    this->closed_.assign((num_polylines + 63) / 64, 0);
+    for (size_t i = 0; i < num_polylines; ++i) {
+        const std::span<const VertexIndex> ordering{GetCompressedSegments(i)};
+        if (ordering.empty()) {
+            throw std::invalid_argument(
+                "polyline " + std::to_string(i) + ": segments buffer cannot be empty"
+            );
+        }
+        if (ordering.size() >= 2 && ordering.front() == ordering.back()) {
+            this->closed_[i / 64] |= uint64_t{1} << (i % 64);
+        }
+    }
+}
+
+}  // namespace tsexam::problem2
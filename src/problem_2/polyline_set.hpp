@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "polyline.hpp"
+#include "polyline_view.hpp"
+
+namespace tsexam::problem2 {
+
+/**
+ * @brief Batch of polylines stored in flat, shared buffers
+ *
+ * A `Polyline` owns its vertices and its compressed ordering, so a million polylines cost a few
+ * million small allocations. A set instead keeps all compressed orderings back to back in one
+ * index buffer with an offsets array (CSR layout: polyline i is `indices[offsets[i],
+ * offsets[i + 1])`), the types of all polylines in a packed bitset, and a single vertex pool the
+ * indices of every polyline refer to.
+ *
+ * The bulk constructor validates and compresses every polyline exactly like the `Polyline`
+ * constructor, in parallel. The vertex window of each polyline (its smallest to largest index) is
+ * what its compression touches, so polylines indexing into a large shared pool stay cheap.
+ */
+class PolylineSet {
+public:
+    /**
+     * Constructs an empty set
+     */
+    PolylineSet() = default;
+
+    /**
+     * Constructs a set from a batch of polylines given in one flat buffer
+     *
+     * Polyline i is `data[offsets[i], offsets[i + 1])`, in the given representation. Verbose
+     * segments are validated and compressed as by the `Polyline` constructor; compressed orderings
+     * are stored as they are. Work is split into chunks of polylines that run on `num_threads`
+     * threads. If several polylines are invalid, the error names the one with the smallest index,
+     * whatever the thread count.
+     *
+     * @param representation Input representation format of every polyline
+     * @param data Vertex indices of all polylines, back to back
+     * @param offsets Start of every polyline in `data`, followed by `data.size()`
+     * @param vertices Optional vertex pool shared by all polylines
+     * @param num_threads Number of threads (0: one per hardware core)
+     *
+     * @throws std::invalid_argument if the offsets are malformed or a polyline violates the
+     *         polyline validity constraints; the message starts with "polyline <i>: "
+     */
+    PolylineSet(
+        PolylineRepresentation representation, std::span<const VertexIndex> data,
+        std::span<const size_t> offsets, std::vector<Point> vertices = {}, size_t num_threads = 0
+    );
+
+    /**
+     * Constructs a set that takes over compressed orderings already laid out in flat buffers
+     *
+     * Polyline i is `indices[offsets[i], offsets[i + 1])`, e.g. as produced by
+     * `split_segment_soup`. The orderings are adopted without copying; only the offsets and the
+     * polyline types are derived.
+     *
+     * @param indices Compressed orderings of all polylines, back to back
+     * @param offsets Start of every polyline in `indices`, followed by `indices.size()`
+     * @param vertices Optional vertex pool shared by all polylines
+     *
+     * @throws std::invalid_argument if the offsets are malformed or a polyline is empty
+     */
+    PolylineSet(
+        std::vector<VertexIndex> indices, std::vector<size_t> offsets,
+        std::vector<Point> vertices = {}
+    );
+
+    /**
+     * Returns the number of polylines in the set
+     *
+     * @return Number of polylines
+     */
+    size_t size() const { return offsets_.size() - 1; }
+
+    /**
+     * Returns whether the set holds no polyline
+     *
+     * @return true if the set is empty
+     */
+    bool empty() const { return size() == 0; }
+
+    /**
+     * Returns the compressed vertex ordering of one polyline
+     *
+     * @param i Index of the polyline
+     * @return View of its compressed vertex index sequence
+     */
+    std::span<const VertexIndex> GetCompressedSegments(size_t i) const {
+        return std::span<const VertexIndex>(indices_).subspan(
+            offsets_[i], offsets_[i + 1] - offsets_[i]
+        );
+    }
+
+    /**
+     * Returns a view of one polyline and the shared vertex pool
+     *
+     * @param i Index of the polyline
+     * @return Non-owning view, valid as long as the set
+     */
+    PolylineView GetPolyline(size_t i) const {
+        return PolylineView(GetCompressedSegments(i), vertices_);
+    }
+
+    /**
+     * Returns the topological type of one polyline
+     *
+     * @param i Index of the polyline
+     * @return PolylineType::kOpen or PolylineType::kClosed
+     */
+    PolylineType GetType(size_t i) const {
+        return IsPolygon(i) ? PolylineType::kClosed : PolylineType::kOpen;
+    }
+
+    /**
+     * Determines whether one polyline is a closed polygon
+     *
+     * @param i Index of the polyline
+     * @return true if the polyline is closed; false otherwise
+     */
+    bool IsPolygon(size_t i) const { return ((closed_[i / 64] >> (i % 64)) & 1u) != 0; }
+
+    /**
+     * Returns the vertex pool shared by all polylines
+     *
+     * @return Reference to the vertex coordinate array
+     */
+    const std::vector<Point>& GetVertices() const { return vertices_; }
+
+    /**
+     * Returns the compressed orderings of all polylines, back to back
+     *
+     * @return Reference to the flat index buffer
+     */
+    const std::vector<VertexIndex>& GetIndices() const { return indices_; }
+
+    /**
+     * Returns the start of every polyline in `GetIndices()`, followed by its size
+     *
+     * @return Reference to the `size() + 1` offsets
+     */
+    const std::vector<size_t>& GetOffsets() const { return offsets_; }
+
+private:
+    /// Vertex pool shared by all polylines
+    std::vector<Point> vertices_;
+
+    /// Compressed orderings of all polylines, back to back
+    std::vector<VertexIndex> indices_;
+
+    /// Start of every polyline in `indices_`, followed by `indices_.size()`
+    std::vector<size_t> offsets_{0};
+
+    /// Bit i % 64 of word i / 64 is set if polyline i is closed
+    std::vector<uint64_t> closed_;
+};
+
+}  // namespace tsexam::problem2
@@ -0,0 +1,17 @@
+#include "polyline_view.hpp"
+
+#include <stdexcept>
+
+namespace tsexam::problem2 {
+
+PolylineView::PolylineView(
+    std::span<const VertexIndex> compressed_ordering, std::span<const Point> vertices
+)
+    : vertices_(vertices), compressed_segments_(compressed_ordering) {
+    // Same guard as the Polyline constructor; nothing else is checked or copied
+    if (compressed_ordering.empty()) {
+        throw std::invalid_argument("segments buffer cannot be empty");
+    }
+}
+
+}  // namespace tsexam::problem2
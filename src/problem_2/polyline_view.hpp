@@ -0,0 +1,86 @@
+#pragma once
+
+#include <span>
+
+#include "polyline.hpp"
+
+namespace tsexam::problem2 {
+
+/**
+ * @brief Non-owning view of a polyline stored in compressed form elsewhere
+ *
+ * A view refers to a compressed vertex ordering (and optionally its vertex coordinates) in memory
+ * it does not own: a memory-mapped file, an arena, a `Polyline` or one polyline of a
+ * `PolylineSet`. Creating a view costs only validation, and the viewed memory must outlive the
+ * view. Verbose segments cannot be viewed, since compressing them needs storage; construct a
+ * `Polyline` (or `PolylineSet`) for those.
+ */
+class PolylineView {
+public:
+    /**
+     * Constructs a view of a compressed vertex ordering in external memory
+     *
+     * @param compressed_ordering Vertex indices in traversal order (a polygon repeats its start)
+     * @param vertices Optional vertex coordinates the indices refer to
+     *
+     * @throws std::invalid_argument if the ordering is empty
+     */
+    explicit PolylineView(
+        std::span<const VertexIndex> compressed_ordering, std::span<const Point> vertices = {}
+    );
+
+    /**
+     * Constructs a view of a polyline, which must outlive the view
+     *
+     * Implicit, like `std::string_view` from `std::string`, so functions taking a view accept
+     * polylines as well.
+     *
+     * @param polyline Polyline to view
+     */
+    PolylineView(const Polyline& polyline)
+        : vertices_(polyline.GetVertices()),
+          compressed_segments_(polyline.GetCompressedSegments()) {}
+
+    /**
+     * Returns the vertex coordinates the view refers to
+     *
+     * @return View of the vertex coordinate array (empty if none were given)
+     */
+    std::span<const Point> GetVertices() const { return vertices_; }
+
+    /**
+     * Returns the compressed vertex ordering of the polyline
+     *
+     * @return View of the compressed vertex index sequence
+     */
+    std::span<const VertexIndex> GetCompressedSegments() const { return compressed_segments_; }
+
+    /**
+     * Returns the topological type of the polyline
+     *
+     * @return PolylineType::kOpen or PolylineType::kClosed
+     */
+    PolylineType GetType() const {
+        return IsPolygon() ? PolylineType::kClosed : PolylineType::kOpen;
+    }
+
+    /**
+     * Determines whether the polyline is a closed polygon
+     *
+     * @return true if the polyline is closed; false otherwise
+     */
+    bool IsPolygon() const {
+        // A polygon's compressed ordering starts and ends with the same vertex
+        return compressed_segments_.size() >= 2 &&
+               compressed_segments_.front() == compressed_segments_.back();
+    }
+
+private:
+    /// Vertex coordinates the indices refer to
+    std::span<const Point> vertices_;
+
+    /// Compressed vertex ordering representing the polyline traversal
+    std::span<const VertexIndex> compressed_segments_;
+};
+
+}  // namespace tsexam::problem2
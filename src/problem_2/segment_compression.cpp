@@ -0,0 +1,323 @@
+#include "segment_compression.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace tsexam::problem2 {
+
+namespace {
+
+/// Windows wider than this many times the number of segment entries are compacted: window-sized
+/// arrays cost 12 bytes per vertex, the compaction about 40 bytes per entry
+constexpr size_t kSparseWindowRatio{4};
+
+}  // namespace
+
+bool is_sparse_window(size_t num_vertices, size_t num_entries) {
+    return num_vertices > kSparseWindowRatio * num_entries;
+}
+
+void compact_vertex_ids(std::span<const VertexIndex> segments, VertexCompaction& compaction) {
+    const size_t num_entries{segments.size()};
+
+    // Key: id in the high half, position in the low half -> sorting by the high half keeps the
+    // positions of equal ids together
+    auto& keys{compaction.keys};
+    auto& buffer{compaction.sort_buffer};
+    keys.resize(num_entries);
+    buffer.resize(num_entries);
+    for (size_t i = 0; i < num_entries; ++i) {
+        keys[i] = (uint64_t{static_cast<uint32_t>(segments[i])} << 32) | i;
+    }
+
+    //----------------------------------------------
+    // LSD radix sort on the 4 id bytes
+    //----------------------------------------------
+
+    for (int shift = 32; shift < 64; shift += 8) {
+        std::array<size_t, 256> counts{};
+        for (const uint64_t key : keys) {
+            ++counts[(key >> shift) & 0xFF];
+        }
+        // All ids share this byte -> the pass would not move anything
+        if (counts[(keys.front() >> shift) & 0xFF] == num_entries) {
+            continue;
+        }
+        size_t start{0};
+        for (size_t& count : counts) {
+            start += std::exchange(count, start);
+        }
+        for (const uint64_t key : keys) {
+            buffer[counts[(key >> shift) & 0xFF]++] = key;
+        }
+        keys.swap(buffer);
+    }
+
+    //----------------------------------------------
+    // Ranks
+    //----------------------------------------------
+
+    auto& local_segments{compaction.local_segments};
+    auto& vertex_ids{compaction.vertex_ids};
+    local_segments.resize(num_entries);
+    vertex_ids.clear();
+    for (const uint64_t key : keys) {
+        const auto vertex{static_cast<VertexIndex>(key >> 32)};
+        if (vertex_ids.empty() || vertex_ids.back() != vertex) {
+            vertex_ids.push_back(vertex);
+        }
+        local_segments[key & 0xFFFFFFFFu] = static_cast<VertexIndex>(vertex_ids.size() - 1);
+    }
+}
+
+size_t walk_vertex_ordering(
+    std::span<const VertexIndex> segments, VertexIndex first_vertex, size_t num_vertices,
+    SegmentScratch& scratch, std::span<VertexIndex> ordering
+) {
+    const size_t num_segments{segments.size() / 2};
+    if (num_segments == 0 || ordering.empty()) {
+        return 0;
+    }
+
+    // Lambda: slot of a vertex in the window
+    auto local = [first_vertex](VertexIndex vertex) {
+        return static_cast<size_t>(vertex - first_vertex);
+    };
+
+    //----------------------------------------------
+    // Build vertex connectivity
+    //----------------------------------------------
+
+    // Each vertex connects to up to two others (-1 = unconnected vertex)
+    auto& vertex_connectivity{scratch.connectivity};
+    vertex_connectivity.assign(num_vertices, {kUnconnectedVertex, kUnconnectedVertex});
+
+    // Assign a neighbor to the first available slot (-1) of a vertex
+    auto assign_neighbor = [&](VertexIndex vertex, VertexIndex neighbor) {
+        auto& slots{vertex_connectivity[local(vertex)]};
+        if (slots.first == kUnconnectedVertex) {
+            slots.first = neighbor;
+            return;
+        }
+        // first slot is already taken -> use second slot
+        slots.second = neighbor;
+    };
+
+    // Each segment connects two vertices -> build connectivity pairs by looping over segments
+    for (size_t i_segment = 0; i_segment < num_segments; ++i_segment) {
+        const VertexIndex vertex_1 = segments[2 * i_segment];
+        const VertexIndex vertex_2 = segments[2 * i_segment + 1];
+        assign_neighbor(vertex_1, vertex_2);  // vertex_2 -- neighbor --> vertex_1
+        assign_neighbor(vertex_2, vertex_1);  // vertex_1 -- neighbor --> vertex_2
+    }
+
+    //----------------------------------------------
+    // Determine polyline type
+    //----------------------------------------------
+
+    // One ascending scan finds the smallest participating vertex and the smallest endpoint
+    // (degree-1 vertex: only .first is set AND .second is -1)
+    VertexIndex smallest_vertex{kUnconnectedVertex};
+    VertexIndex smallest_endpoint{kUnconnectedVertex};
+    for (size_t vertex = 0; vertex < num_vertices; ++vertex) {
+        const auto [v1, v2] = vertex_connectivity[vertex];
+        if (v1 == kUnconnectedVertex) {
+            continue;
+        }
+        const VertexIndex v{first_vertex + static_cast<VertexIndex>(vertex)};
+        if (smallest_vertex == kUnconnectedVertex) {
+            smallest_vertex = v;
+        }
+        if (v2 == kUnconnectedVertex) {
+            smallest_endpoint = v;
+            break;  // endpoints come after the smallest vertex -> both are known
+        }
+    }
+
+    // Two scenarios possible:
+    // Polyline: 2 endpoints (2 vertices w/ degree 1, rest degree 2) -> start at the smaller one
+    // (to satisfy DETERMINISM)
+    // Polygon: no endpoints (all vertices w/ degree 2) -> start at the smallest participating
+    // vertex (no determinism requirement here)
+    const bool is_closed{smallest_endpoint == kUnconnectedVertex};
+    const VertexIndex starting_vertex{is_closed ? smallest_vertex : smallest_endpoint};
+
+    //----------------------------------------------
+    // Build compressed vertex ordering
+    //----------------------------------------------
+
+    // Lambda: given a vertex, return the neighbor that is not `already_visited`
+    // Returns -1 if no such neighbor exists (reached the end of open polyline)
+    auto next_neighbor = [&](VertexIndex vertex, VertexIndex already_visited) -> VertexIndex {
+        const auto [v1, v2] = vertex_connectivity[local(vertex)];
+        if (v1 != kUnconnectedVertex && v1 != already_visited) {
+            return v1;
+        }
+        if (v2 != kUnconnectedVertex && v2 != already_visited) {
+            return v2;
+        }
+        // No unvisited neighbors -> end of open polyline
+        return kUnconnectedVertex;
+    };
+
+    // Walk the chain: at each step, advance to the next neighbor that is not the previous vertex
+    size_t length{0};
+    ordering[length++] = starting_vertex;
+
+    // First step: just take the first neighbor (determinism for polylines is already guaranteed by
+    // starting at the smaller endpoint for open polylines)
+    VertexIndex previous_vertex{starting_vertex};
+    VertexIndex current_vertex{vertex_connectivity[local(starting_vertex)].first};
+    if (length < ordering.size()) {
+        ordering[length++] = current_vertex;
+    }
+
+    // Subsequent steps: walk the chain until we reach the end of an open polyline or loop back to
+    // the start of a polygon (or the output is full, which only malformed input reaches)
+    while (length < ordering.size()) {
+        const VertexIndex next_vertex = next_neighbor(current_vertex, previous_vertex);
+
+        // Break condition for polyline: reached the other endpoint
+        if (next_vertex == kUnconnectedVertex) {
+            break;
+        }
+
+        ordering[length++] = next_vertex;
+
+        // Break condition for polygon: completed the loop back to the starting vertex
+        if (is_closed && next_vertex == starting_vertex) {
+            break;
+        }
+
+        // Advance the walk: update previous and current vertices
+        previous_vertex = current_vertex;
+        current_vertex = next_vertex;
+    }
+
+    return length;
+}
+
+void compress_verbose_segments(
+    std::span<const VertexIndex> segments, SegmentScratch& scratch,
+    std::span<VertexIndex> ordering
+) {
+    //----------------------------------------------
+    // Checks
+    //----------------------------------------------
+
+    // Segment buffer is empty -> throw
+    if (segments.empty()) {
+        throw std::invalid_argument("segments buffer cannot be empty");
+    }
+
+    // Number of entries in segment data is NOT even -> throw
+    if (segments.size() % 2 != 0) {
+        throw std::invalid_argument("segments buffer must contain an even number of entries");
+    }
+
+    /**
+     * NOTE: This validation is not optimal for performance, but it establishes the assumptions
+     * made into the class invariants i.e. single-connected polyline/polygon and degree is 2 (1
+     * for endpoints). I am prioritizing robustness over performance here. The walk in
+     * walk_vertex_ordering() assumes valid input.
+     */
+
+    // Find the vertex window [min, max] of the segments buffer to determine the vertex count
+    const size_t num_segments{segments.size() / 2};
+    const auto [min_it, max_it] = std::minmax_element(segments.begin(), segments.end());
+    const VertexIndex min_vertex{*min_it};
+    const VertexIndex max_vertex{*max_it};
+    if (min_vertex < 0) {
+        throw std::invalid_argument("negative vertex index " + std::to_string(min_vertex));
+    }
+    size_t num_vertices{static_cast<size_t>(max_vertex - min_vertex) + 1};
+
+    // A few segments between ids far apart (e.g. global ids near 2^31) -> work on dense ranks
+    // instead of allocating the whole window
+    const bool compacted{is_sparse_window(num_vertices, segments.size())};
+    std::span<const VertexIndex> window_segments{segments};
+    VertexIndex first_vertex{min_vertex};
+    if (compacted) {
+        compact_vertex_ids(segments, scratch.compaction);
+        window_segments = scratch.compaction.local_segments;
+        first_vertex = 0;
+        num_vertices = scratch.compaction.vertex_ids.size();
+    }
+
+    // Lambda: original id of a vertex slot of the window
+    auto original_vertex = [&](size_t vertex) -> VertexIndex {
+        return compacted ? scratch.compaction.vertex_ids[vertex]
+                         : min_vertex + static_cast<VertexIndex>(vertex);
+    };
+
+    // Count degree of each vertex i.e. number of segments it participates in (32-bit counts: a
+    // vertex repeated 256 times must not wrap around to degree 0)
+    auto& degree_of_vertices{scratch.degrees};
+    degree_of_vertices.assign(num_vertices, 0);
+    for (const auto vertex : window_segments) {
+        // Each segment connects two vertices -> increment degree counts
+        ++degree_of_vertices[static_cast<size_t>(vertex - first_vertex)];
+    }
+
+    // Validate single-connected polyline/polygon assumptions:
+    // - every vertex has degree 1 or 2
+    // - exactly 0 degree-1 vertices (polygon) or exactly 2 vertices (open polyline)
+    size_t degree_1_count{0};
+    for (size_t vertex = 0; vertex < num_vertices; ++vertex) {
+        const uint32_t degree{degree_of_vertices[vertex]};
+
+        // Ignore unconnected vertices (degree 0)
+        if (degree == 0) {
+            continue;
+        }
+
+        // Count degree-1 endpoints
+        if (degree == 1) {
+            ++degree_1_count;
+        }
+
+        // Validate degree <= 2 for single-connected polyline/polygon
+        if (degree > 2) {
+            throw std::invalid_argument(
+                "vertex " + std::to_string(original_vertex(vertex)) +
+                " has degree " + std::to_string(degree) +
+                "; expected at most 2 for a single connected polyline/polygon"
+            );
+        }
+    }
+
+    // We have a problem if number of degree-1 endpoints is NOT 0 or 2 -> throw
+    if (degree_1_count != 0 && degree_1_count != 2) {
+        throw std::invalid_argument(
+            "expected 0 or 2 degree-1 endpoints, found " + std::to_string(degree_1_count)
+        );
+    }
+
+    //----------------------------------------------
+    // Compress
+    //----------------------------------------------
+
+    // A single chain visits one new vertex per segment -> N + 1 entries; a shorter walk left
+    // segments of another chain behind (e.g. two separate polygons)
+    const size_t length{
+        walk_vertex_ordering(window_segments, first_vertex, num_vertices, scratch, ordering)
+    };
+    if (length != num_segments + 1) {
+        throw std::invalid_argument(
+            "segments do not form a single connected polyline/polygon: the walk covers " +
+            std::to_string(length - 1) + " of " + std::to_string(num_segments) + " segments"
+        );
+    }
+
+    // Ranks back to the original ids
+    if (compacted) {
+        for (VertexIndex& vertex : ordering) {
+            vertex = scratch.compaction.vertex_ids[static_cast<size_t>(vertex)];
+        }
+    }
+}
+
+}  // namespace tsexam::problem2
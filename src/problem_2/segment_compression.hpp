@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "polyline.hpp"
+
+namespace tsexam::problem2 {
+
+/**
+ * @brief Dense relabeling of the vertex ids used by a segment buffer
+ *
+ * Vertex ids are replaced by their rank among the distinct ids, so arrays indexed by vertex scale
+ * with the number of segments rather than with the id range. Ranks preserve the order of the ids,
+ * which keeps every "smallest vertex" choice of the compression unchanged.
+ */
+struct VertexCompaction {
+    /// Segments relabeled to ranks in [0, vertex_ids.size())
+    std::vector<VertexIndex> local_segments;
+
+    /// Original id of every rank, ascending
+    std::vector<VertexIndex> vertex_ids;
+
+    /// Radix sort keys (id << 32 | position) and their ping-pong buffer
+    std::vector<uint64_t> keys;
+    std::vector<uint64_t> sort_buffer;
+};
+
+/**
+ * @brief Scratch buffers of the segment compression, reused from one polyline to the next
+ *
+ * The buffers cover the vertex window of the polyline being compressed, i.e. the range between
+ * its smallest and largest vertex index, so polylines indexing into one large shared vertex pool
+ * only pay for the vertices they span. Windows that are sparse even so (a few segments between
+ * ids far apart) are compacted to dense ids first.
+ */
+struct SegmentScratch {
+    /// Number of segments at every vertex of the window
+    std::vector<uint32_t> degrees;
+
+    /// Up to two neighbors of every vertex of the window (`kUnconnectedVertex` if unset)
+    std::vector<std::pair<VertexIndex, VertexIndex>> connectivity;
+
+    /// Relabeling of sparse windows
+    VertexCompaction compaction;
+};
+
+/**
+ * Determines whether a vertex window is too sparse for window-sized arrays
+ *
+ * @param num_vertices Number of vertex indices in the window
+ * @param num_entries Number of entries in the segment buffer (2N)
+ * @return true if the window should be compacted to dense ids first
+ */
+bool is_sparse_window(size_t num_vertices, size_t num_entries);
+
+/**
+ * Relabels the vertex ids of a segment buffer by their rank among the distinct ids
+ *
+ * A stable LSD radix sort of (id, position) keys, 8 bits per pass, skipping the passes in which
+ * all ids share the digit; time and memory are linear in the number of entries.
+ *
+ * @param segments Segment buffer with non-negative vertex ids (fewer than 2^32 entries)
+ * @param compaction Output: relabeled segments and the original id of every rank
+ */
+void compact_vertex_ids(std::span<const VertexIndex> segments, VertexCompaction& compaction);
+
+/**
+ * Walks verbose segments into their compressed vertex ordering, without validating them
+ *
+ * This is the traversal behind `Polyline::GetCompressedVertexOrdering`: connectivity is built
+ * over the vertices [first_vertex, first_vertex + num_vertices), an open polyline starts at its
+ * smaller endpoint and a polygon at its smallest vertex (repeated at the end). The walk stops
+ * after `ordering.size()` entries, so malformed input cannot run past the output.
+ *
+ * @param segments Flat list of vertex index pairs (2N entries) within the window
+ * @param first_vertex Smallest vertex index of the window
+ * @param num_vertices Number of vertex indices in the window
+ * @param scratch Reusable scratch buffers
+ * @param ordering Output, at least N + 1 entries for a valid polyline
+ * @return Number of entries written to `ordering`
+ */
+size_t walk_vertex_ordering(
+    std::span<const VertexIndex> segments, VertexIndex first_vertex, size_t num_vertices,
+    SegmentScratch& scratch, std::span<VertexIndex> ordering
+);
+
+/**
+ * Validates verbose segments and writes their compressed vertex ordering
+ *
+ * Checks the single connected polyline/polygon invariants of `Polyline`: an even, non-empty
+ * buffer, non-negative indices, vertex degrees of at most 2, 0 or 2 endpoints, and every segment
+ * reached by the walk. A valid polyline of N segments always compresses to N + 1 entries. Sparse
+ * vertex windows are compacted first, so time and memory scale with the segment count.
+ *
+ * @param segments Flat list of vertex index pairs (2N entries)
+ * @param scratch Reusable scratch buffers
+ * @param ordering Output of exactly N + 1 entries
+ *
+ * @throws std::invalid_argument if the segments violate the polyline invariants
+ */
+void compress_verbose_segments(
+    std::span<const VertexIndex> segments, SegmentScratch& scratch,
+    std::span<VertexIndex> ordering
+);
+
+}  // namespace tsexam::problem2
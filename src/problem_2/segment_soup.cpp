@@ -0,0 +1,529 @@
+#include "segment_soup.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "common/parallel.hpp"
+#include "segment_compression.hpp"
+
+namespace tsexam::problem2 {
+
+namespace {
+
+using tsexam::common::parallel_for;
+using tsexam::common::resolve_thread_count;
+
+/// Segment or arc id that is not set
+constexpr uint32_t kNone{std::numeric_limits<uint32_t>::max()};
+
+/// Segments, vertices or arcs per parallel task
+constexpr size_t kItemsPerChunk{size_t{1} << 16};
+
+/// About one arc in 2^kRulerSampleBits becomes a ruler of the list ranking (besides every chain
+/// start), so a ruler walks 2^kRulerSampleBits arcs on average
+constexpr int kRulerSampleBits{6};
+
+/// Rulers per parallel task (about kItemsPerChunk arcs walked)
+constexpr size_t kRulersPerChunk{kItemsPerChunk >> kRulerSampleBits};
+
+/// Number of chunks covering `count` items
+size_t num_chunks(size_t count, size_t chunk_size) { return (count + chunk_size - 1) / chunk_size; }
+
+/// First invalid vertex of a chunk
+struct VertexError {
+    VertexIndex vertex;   ///< smallest invalid vertex of the chunk
+    std::string message;  ///< validation message
+};
+
+/**
+ * Connectivity of a segment soup, shared by the walk and the list ranking
+ *
+ * Segment e joins `segments[2e]` and `segments[2e + 1]`. It is traversed as two directed arcs:
+ * arc 2e runs from `segments[2e]` to `segments[2e + 1]` and arc 2e + 1 runs back, so the tail of
+ * arc a is `segments[a]` and its head is `segments[a ^ 1]`.
+ */
+struct SoupConnectivity {
+    /// Flat list of vertex index pairs (dense ranks if the soup was compacted)
+    std::span<const VertexIndex> segments;
+
+    /// Original id of every rank of a compacted soup; empty if the ids are used as they are
+    std::span<const VertexIndex> vertex_ids;
+
+    /// Smallest vertex index of the window
+    VertexIndex first_vertex{0};
+
+    /// Number of segments at every vertex of the window
+    std::vector<uint32_t> degrees;
+
+    /// Up to two arcs leaving every vertex of the window, in ascending order (`kNone` if unset).
+    /// Arcs rather than segments, so stepping along a chain reads no segment endpoints.
+    std::vector<std::array<uint32_t, 2>> leaving;
+
+    /// Original id of a vertex of `segments`
+    VertexIndex original(VertexIndex vertex) const {
+        return vertex_ids.empty() ? vertex : vertex_ids[static_cast<size_t>(vertex)];
+    }
+
+    /// Slot of a vertex in the window
+    size_t local(VertexIndex vertex) const { return static_cast<size_t>(vertex - first_vertex); }
+
+    /// Number of segments at a vertex
+    uint32_t degree(VertexIndex vertex) const { return degrees[local(vertex)]; }
+
+    /// Number of arcs (twice the number of segments)
+    uint32_t num_arcs() const { return static_cast<uint32_t>(segments.size()); }
+
+    /// Vertex an arc leaves
+    VertexIndex tail(uint32_t arc) const { return segments[arc]; }
+
+    /// Vertex an arc enters
+    VertexIndex head(uint32_t arc) const { return segments[arc ^ 1u]; }
+
+    /// Arc that leaves a vertex along its earliest segment
+    uint32_t first_arc_leaving(VertexIndex vertex) const { return leaving[local(vertex)][0]; }
+
+    /// Arc that continues `arc` past its head, or `kNone` at the end of an open chain
+    uint32_t successor(uint32_t arc) const {
+        const std::array<uint32_t, 2>& slots{leaving[local(head(arc))]};
+        if (slots[1] == kNone) {
+            return kNone;
+        }
+        // Leave along the other segment (the reverse of `arc` is arc ^ 1)
+        return slots[0] == (arc ^ 1u) ? slots[1] : slots[0];
+    }
+};
+
+//----------------------------------------------
+// Connectivity
+//----------------------------------------------
+
+/// Validates the soup and builds its connectivity on `thread_count` threads; sparse soups are
+/// relabeled into `compaction`, which must outlive the result
+SoupConnectivity build_connectivity(
+    std::span<const VertexIndex> segments, size_t thread_count, VertexCompaction& compaction
+) {
+    SoupConnectivity soup;
+    soup.segments = segments;
+    const size_t num_segments{segments.size() / 2};
+
+    // Arc ids must fit, which any valid soup of 32-bit vertex indices does
+    if (segments.size() >= kNone) {
+        throw std::invalid_argument("segment soup has too many segments");
+    }
+
+    // Find the vertex window [min, max]; reject negative indices and segments from a vertex to
+    // itself (which would look like a vertex of degree 2)
+    const auto [min_it, max_it] = std::minmax_element(segments.begin(), segments.end());
+    if (*min_it < 0) {
+        throw std::invalid_argument("negative vertex index " + std::to_string(*min_it));
+    }
+    for (size_t i_segment = 0; i_segment < num_segments; ++i_segment) {
+        if (segments[2 * i_segment] == segments[2 * i_segment + 1]) {
+            throw std::invalid_argument(
+                "segment " + std::to_string(i_segment) + " connects vertex " +
+                std::to_string(segments[2 * i_segment]) + " to itself"
+            );
+        }
+    }
+    soup.first_vertex = *min_it;
+    size_t num_vertices{static_cast<size_t>(*max_it - *min_it) + 1};
+
+    // Few segments between ids far apart -> connectivity over dense ranks, so memory scales with
+    // the segment count rather than the id range
+    if (is_sparse_window(num_vertices, segments.size())) {
+        compact_vertex_ids(segments, compaction);
+        soup.segments = compaction.local_segments;
+        soup.vertex_ids = compaction.vertex_ids;
+        soup.first_vertex = 0;
+        num_vertices = compaction.vertex_ids.size();
+    }
+    soup.degrees.assign(num_vertices, 0);
+    soup.leaving.assign(num_vertices, {kNone, kNone});
+
+    // Record every arc at the vertex it leaves: the degree so far is the slot to fill (a third
+    // segment only raises the degree, which the checks below report)
+    if (thread_count == 1) {
+        for (size_t arc = 0; arc < segments.size(); ++arc) {
+            const size_t vertex{soup.local(soup.segments[arc])};
+            const uint32_t slot{soup.degrees[vertex]++};
+            if (slot < 2) {
+                soup.leaving[vertex][slot] = static_cast<uint32_t>(arc);
+            }
+        }
+    } else {
+        parallel_for(num_chunks(segments.size(), kItemsPerChunk), thread_count, [&](size_t chunk) {
+            const size_t begin{chunk * kItemsPerChunk};
+            const size_t end{std::min(begin + kItemsPerChunk, segments.size())};
+            for (size_t arc = begin; arc < end; ++arc) {
+                const size_t vertex{soup.local(soup.segments[arc])};
+                const uint32_t slot{std::atomic_ref<uint32_t>(soup.degrees[vertex])
+                                        .fetch_add(1, std::memory_order_relaxed)};
+                if (slot < 2) {
+                    soup.leaving[vertex][slot] = static_cast<uint32_t>(arc);
+                }
+            }
+        });
+    }
+
+    // Check every vertex, one chunk of the window per task; slots are sorted so both modes see the
+    // segments of a vertex in buffer order
+    std::vector<std::optional<VertexError>> errors(num_chunks(num_vertices, kItemsPerChunk));
+    parallel_for(errors.size(), thread_count, [&](size_t chunk) {
+        const size_t begin{chunk * kItemsPerChunk};
+        const size_t end{std::min(begin + kItemsPerChunk, num_vertices)};
+        for (size_t vertex = begin; vertex < end; ++vertex) {
+            const VertexIndex v{soup.first_vertex + static_cast<VertexIndex>(vertex)};
+            const uint32_t degree{soup.degrees[vertex]};
+            if (degree > 2) {
+                errors[chunk] = VertexError{
+                    v, "vertex " + std::to_string(soup.original(v)) + " has degree " +
+                           std::to_string(degree) +
+                           "; expected at most 2 for a soup of chains and loops"
+                };
+                return;
+            }
+            if (degree < 2) {
+                continue;
+            }
+            std::array<uint32_t, 2>& slots{soup.leaving[vertex]};
+            if (slots[0] > slots[1]) {
+                std::swap(slots[0], slots[1]);
+            }
+            const VertexIndex neighbor_0{soup.head(slots[0])};
+            const VertexIndex neighbor_1{soup.head(slots[1])};
+            if (neighbor_0 == neighbor_1) {
+                errors[chunk] = VertexError{
+                    v, "vertices " + std::to_string(soup.original(v)) + " and " +
+                           std::to_string(soup.original(neighbor_0)) +
+                           " are joined by more than one segment"
+                };
+                return;
+            }
+        }
+    });
+
+    // Chunks are in vertex order -> the first error is at the smallest invalid vertex
+    for (const std::optional<VertexError>& error : errors) {
+        if (error) {
+            throw std::invalid_argument(error->message);
+        }
+    }
+    return soup;
+}
+
+//----------------------------------------------
+// Linear walk
+//----------------------------------------------
+
+/// Compresses every chain and loop by walking it, on the calling thread
+void walk_soup(
+    const SoupConnectivity& soup, std::vector<VertexIndex>& indices, std::vector<size_t>& offsets
+) {
+    indices.reserve(soup.segments.size());
+    std::vector<uint8_t> visited(soup.segments.size() / 2, 0);  // per segment
+
+    // Lambda: append the chain or loop that starts with `arc`
+    auto walk = [&](uint32_t start_arc) {
+        uint32_t arc{start_arc};
+        while (true) {
+            visited[arc >> 1] = 1;
+            indices.push_back(soup.tail(arc));
+            const uint32_t next_arc{soup.successor(arc)};
+            if (next_arc == kNone || next_arc == start_arc) {
+                indices.push_back(soup.head(arc));  // other endpoint, or the start of a loop
+                break;
+            }
+            arc = next_arc;
+        }
+        offsets.push_back(indices.size());
+    };
+
+    // Open chains: the first endpoint an ascending scan meets is the smaller one, the other end is
+    // then already visited
+    const size_t num_vertices{soup.degrees.size()};
+    for (size_t vertex = 0; vertex < num_vertices; ++vertex) {
+        const VertexIndex v{soup.first_vertex + static_cast<VertexIndex>(vertex)};
+        if (soup.degrees[vertex] == 1 && visited[soup.leaving[vertex][0] >> 1] == 0) {
+            walk(soup.first_arc_leaving(v));
+        }
+    }
+
+    // Loops: every vertex left with degree 2 lies on a loop, first met at its smallest vertex
+    for (size_t vertex = 0; vertex < num_vertices; ++vertex) {
+        const VertexIndex v{soup.first_vertex + static_cast<VertexIndex>(vertex)};
+        if (soup.degrees[vertex] == 2 && visited[soup.leaving[vertex][0] >> 1] == 0) {
+            walk(soup.first_arc_leaving(v));
+        }
+    }
+}
+
+//----------------------------------------------
+// Parallel list ranking
+//----------------------------------------------
+
+/// Ruler of the list ranking and the run of arcs it walks up to the next ruler
+struct Ruler {
+    uint32_t arc;                           ///< first arc of the run
+    uint32_t next{kNone};                   ///< ruler that follows the run (kNone: chain end)
+    uint32_t length{0};                     ///< number of arcs in the run
+    VertexIndex min_vertex{0};              ///< smallest tail vertex of the run
+    VertexIndex end_vertex{kUnconnectedVertex};  ///< head of the last arc at a chain end
+};
+
+/// Directed chain or loop: every segment is traversed once in each direction, and only the
+/// direction the walk would take is kept
+struct DirectedComponent {
+    VertexIndex start_vertex;  ///< chain start or smallest loop vertex
+    uint32_t length{0};        ///< number of arcs
+    uint32_t start_rank{0};    ///< rank of the first output arc (non-zero only for loops)
+    bool closed{false};        ///< loop rather than open chain
+    bool kept{false};          ///< direction of the output
+    size_t offset{0};          ///< start of the compressed ordering in the output
+};
+
+/// Whether the hashed sample makes an arc a ruler
+bool is_sampled(uint32_t arc) {
+    return ((uint64_t{arc} * 0x9E3779B97F4A7C15ull) >> (64 - kRulerSampleBits)) == 0;
+}
+
+/// Compresses every chain and loop by parallel list ranking on `thread_count` threads
+void rank_soup(
+    const SoupConnectivity& soup, size_t thread_count, std::vector<VertexIndex>& indices,
+    std::vector<size_t>& offsets
+) {
+    const uint32_t num_arcs{soup.num_arcs()};
+    const size_t num_arc_chunks{num_chunks(num_arcs, kItemsPerChunk)};
+
+    // Lambda: chain starts (arcs leaving an endpoint) and sampled arcs are rulers
+    auto is_ruler = [&](uint32_t arc) {
+        return soup.degree(soup.tail(arc)) == 1 || is_sampled(arc);
+    };
+
+    //----------------------------------------------
+    // Pick rulers, in arc order
+    //----------------------------------------------
+
+    std::vector<std::vector<uint32_t>> chunk_rulers(num_arc_chunks);
+    parallel_for(num_arc_chunks, thread_count, [&](size_t chunk) {
+        const size_t begin{chunk * kItemsPerChunk};
+        const size_t end{std::min<size_t>(begin + kItemsPerChunk, num_arcs)};
+        for (size_t i = begin; i < end; ++i) {
+            const auto arc{static_cast<uint32_t>(i)};
+            if (is_ruler(arc)) {
+                chunk_rulers[chunk].push_back(arc);
+            }
+        }
+    });
+    std::vector<Ruler> rulers;
+    for (const std::vector<uint32_t>& arcs : chunk_rulers) {
+        for (const uint32_t arc : arcs) {
+            rulers.push_back(Ruler{arc});
+        }
+    }
+
+    // Every arc learns the ruler whose run it belongs to and its rank within the run
+    std::vector<uint32_t> ruler_of(num_arcs, kNone);
+    std::vector<uint32_t> rank(num_arcs, 0);
+    for (size_t r = 0; r < rulers.size(); ++r) {
+        ruler_of[rulers[r].arc] = static_cast<uint32_t>(r);
+    }
+
+    // Lambda: walk the run of a ruler up to the next ruler. Only this walk writes the arcs of the
+    // run, and rulers are marked before any walk starts, so concurrent walks never share an arc.
+    auto walk_run = [&](uint32_t r) {
+        Ruler& ruler{rulers[r]};
+        uint32_t arc{ruler.arc};
+        uint32_t length{0};
+        VertexIndex min_vertex{soup.tail(arc)};
+        while (true) {
+            ++length;
+            const uint32_t next_arc{soup.successor(arc)};
+            if (next_arc == kNone) {
+                ruler.end_vertex = soup.head(arc);
+                break;
+            }
+            if (ruler_of[next_arc] != kNone) {
+                ruler.next = ruler_of[next_arc];
+                break;
+            }
+            ruler_of[next_arc] = r;
+            rank[next_arc] = length;
+            min_vertex = std::min(min_vertex, soup.tail(next_arc));
+            arc = next_arc;
+        }
+        ruler.length = length;
+        ruler.min_vertex = min_vertex;
+    };
+
+    //----------------------------------------------
+    // Walk the runs of all rulers
+    //----------------------------------------------
+
+    parallel_for(num_chunks(rulers.size(), kRulersPerChunk), thread_count, [&](size_t chunk) {
+        const size_t begin{chunk * kRulersPerChunk};
+        const size_t end{std::min(begin + kRulersPerChunk, rulers.size())};
+        for (size_t r = begin; r < end; ++r) {
+            walk_run(static_cast<uint32_t>(r));
+        }
+    });
+
+    // Loops too short to catch a sampled ruler are left over -> their first arc becomes a ruler
+    // whose run is the whole loop
+    for (uint32_t arc = 0; arc < num_arcs; ++arc) {
+        if (ruler_of[arc] == kNone) {
+            const auto r{static_cast<uint32_t>(rulers.size())};
+            rulers.push_back(Ruler{arc});
+            ruler_of[arc] = r;
+            walk_run(r);
+        }
+    }
+
+    //----------------------------------------------
+    // Rank the rulers
+    //----------------------------------------------
+
+    // Few rulers -> follow them sequentially, giving every run its rank within its component
+    std::vector<uint32_t> component_of(rulers.size(), kNone);
+    std::vector<uint32_t> run_rank(rulers.size(), 0);
+    std::vector<DirectedComponent> components;
+
+    // Open chains, one per chain start
+    for (size_t r = 0; r < rulers.size(); ++r) {
+        const VertexIndex start{soup.tail(rulers[r].arc)};
+        if (soup.degree(start) != 1) {
+            continue;
+        }
+        const auto c{static_cast<uint32_t>(components.size())};
+        DirectedComponent component{start};
+        VertexIndex end_vertex{start};
+        for (uint32_t s = static_cast<uint32_t>(r); s != kNone; s = rulers[s].next) {
+            component_of[s] = c;
+            run_rank[s] = component.length;
+            component.length += rulers[s].length;
+            end_vertex = rulers[s].end_vertex;
+        }
+        component.kept = start < end_vertex;  // the walk starts at the smaller endpoint
+        components.push_back(component);
+    }
+
+    // Loops: every ruler not reached from a chain start lies on one
+    for (size_t r = 0; r < rulers.size(); ++r) {
+        if (component_of[r] != kNone) {
+            continue;
+        }
+        const auto c{static_cast<uint32_t>(components.size())};
+        DirectedComponent component{rulers[r].min_vertex};
+        component.closed = true;
+        auto s{static_cast<uint32_t>(r)};
+        do {
+            component_of[s] = c;
+            run_rank[s] = component.length;
+            component.length += rulers[s].length;
+            component.start_vertex = std::min(component.start_vertex, rulers[s].min_vertex);
+            s = rulers[s].next;
+        } while (s != r);
+        components.push_back(component);
+    }
+
+    // The walk leaves the smallest vertex of a loop along its earliest segment -> keep the
+    // direction holding that arc, shifted so the arc comes first
+    for (size_t c = 0; c < components.size(); ++c) {
+        DirectedComponent& component{components[c]};
+        if (!component.closed) {
+            continue;
+        }
+        const uint32_t first_arc{soup.first_arc_leaving(component.start_vertex)};
+        const uint32_t r{ruler_of[first_arc]};
+        component.kept = component_of[r] == c;
+        component.start_rank = run_rank[r] + rank[first_arc];
+    }
+
+    // Output order of the walk: open chains, then loops, each by ascending start vertex
+    std::vector<uint32_t> order;
+    for (size_t c = 0; c < components.size(); ++c) {
+        if (components[c].kept) {
+            order.push_back(static_cast<uint32_t>(c));
+        }
+    }
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return std::pair{components[a].closed, components[a].start_vertex} <
+               std::pair{components[b].closed, components[b].start_vertex};
+    });
+    for (const uint32_t c : order) {
+        components[c].offset = offsets.back();
+        offsets.push_back(offsets.back() + components[c].length + 1);  // N arcs -> N + 1 entries
+    }
+
+    //----------------------------------------------
+    // Write every arc to its place
+    //----------------------------------------------
+
+    indices.resize(offsets.back());
+    parallel_for(num_arc_chunks, thread_count, [&](size_t chunk) {
+        const size_t begin{chunk * kItemsPerChunk};
+        const size_t end{std::min<size_t>(begin + kItemsPerChunk, num_arcs)};
+        for (size_t i = begin; i < end; ++i) {
+            const auto arc{static_cast<uint32_t>(i)};
+            const uint32_t r{ruler_of[arc]};
+            const DirectedComponent& component{components[component_of[r]]};
+            if (!component.kept) {
+                continue;
+            }
+            size_t position{size_t{run_rank[r]} + rank[arc]};
+            if (component.closed) {
+                position = (position + component.length - component.start_rank) % component.length;
+            }
+            indices[component.offset + position] = soup.tail(arc);
+            if (position + 1 == component.length) {
+                // Last arc also writes the other endpoint, or the start of the loop again
+                indices[component.offset + component.length] = soup.head(arc);
+            }
+        }
+    });
+}
+
+}  // namespace
+
+PolylineSet split_segment_soup(
+    std::span<const VertexIndex> segments, std::vector<Point> vertices, size_t num_threads
+) {
+    // Number of entries in segment data is NOT even -> throw
+    if (segments.size() % 2 != 0) {
+        throw std::invalid_argument("segments buffer must contain an even number of entries");
+    }
+
+    std::vector<VertexIndex> indices;
+    std::vector<size_t> offsets{0};
+    if (!segments.empty()) {
+        const size_t thread_count{resolve_thread_count(num_threads)};
+        VertexCompaction compaction;
+        const SoupConnectivity soup{build_connectivity(segments, thread_count, compaction)};
+        if (thread_count == 1) {
+            walk_soup(soup, indices, offsets);
+        } else {
+            rank_soup(soup, thread_count, indices, offsets);
+        }
+
+        // Ranks of a compacted soup back to the original ids
+        if (!soup.vertex_ids.empty()) {
+            const size_t num_index_chunks{num_chunks(indices.size(), kItemsPerChunk)};
+            parallel_for(num_index_chunks, thread_count, [&](size_t chunk) {
+                const size_t begin{chunk * kItemsPerChunk};
+                const size_t end{std::min(begin + kItemsPerChunk, indices.size())};
+                for (size_t i = begin; i < end; ++i) {
+                    indices[i] = soup.original(indices[i]);
+                }
+            });
+        }
+    }
+    return PolylineSet(std::move(indices), std::move(offsets), std::move(vertices));
+}
+
+}  // namespace tsexam::problem2
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "polyline.hpp"
+#include "polyline_set.hpp"
+
+namespace tsexam::problem2 {
+
+/**
+ * Splits a soup of verbose segments into all the chains and loops it contains
+ *
+ * Unlike the `Polyline` constructor, the segments may form any number of open chains and closed
+ * loops, as long as every vertex has at most two segments attached. Every chain and loop is
+ * compressed exactly as the `Polyline` constructor would compress its segments on their own: an
+ * open chain starts at its smaller endpoint, a loop at its smallest vertex (repeated at the end)
+ * and continues along its earliest segment in the buffer. The result lists the open chains by
+ * ascending start vertex, followed by the loops by ascending start vertex.
+ *
+ * Both modes work from one shared connectivity array over the vertex window of the soup:
+ * - one thread: a linear walk of every chain and loop, $O(segments + window)$;
+ * - several threads: parallel list ranking. Every segment is split into its two directed arcs,
+ *   a sparse ruling set of arcs (every chain start plus a hashed sample) walks forward to the next
+ *   ruler in parallel, the short list of rulers is ranked sequentially, and every arc then writes
+ *   its vertex to its final place in parallel. The output is identical to the walk.
+ *
+ * @param segments Flat list of vertex index pairs (2N entries, N may be 0)
+ * @param vertices Optional vertex pool shared by all chains and loops
+ * @param num_threads Number of threads (1: linear walk; 0: one per hardware core)
+ * @return Compressed orderings of all chains and loops
+ *
+ * @throws std::invalid_argument if the buffer has an odd number of entries, holds a negative
+ *         vertex index, a segment from a vertex to itself, the same segment twice, or a vertex
+ *         with more than two segments
+ */
+PolylineSet split_segment_soup(
+    std::span<const VertexIndex> segments, std::vector<Point> vertices = {},
+    size_t num_threads = 1
+);
+
+}  // namespace tsexam::problem2
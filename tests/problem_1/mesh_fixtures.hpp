@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "problem_1/geometry.hpp"
+
+namespace tsexam::tests {
+
+//---------------------------------------------------------------------------
+// Synthetic triangle meshes shared by the Problem 1 tests
+//---------------------------------------------------------------------------
+
+/**
+ * @brief Appends the 12 outward-oriented triangles of an axis-aligned cube [o, o + size]^3
+ *
+ * @param triangles Triangle list to append to
+ * @param o Minimum corner
+ * @param size Edge length
+ */
+inline void append_cube(
+    std::vector<problem1::Triangle>& triangles, const problem1::Point& o, double size = 1.
+) {
+    const double x0{o[0]}, y0{o[1]}, z0{o[2]};
+    const double x1{o[0] + size}, y1{o[1] + size}, z1{o[2] + size};
+    const std::vector<problem1::Triangle> cube{
+        {{x0, y0, z0}, {x0, y1, z0}, {x1, y1, z0}}, {{x0, y0, z0}, {x1, y1, z0}, {x1, y0, z0}},
+        {{x0, y0, z1}, {x1, y0, z1}, {x1, y1, z1}}, {{x0, y0, z1}, {x1, y1, z1}, {x0, y1, z1}},
+        {{x0, y0, z0}, {x1, y0, z0}, {x1, y0, z1}}, {{x0, y0, z0}, {x1, y0, z1}, {x0, y0, z1}},
+        {{x0, y1, z0}, {x0, y1, z1}, {x1, y1, z1}}, {{x0, y1, z0}, {x1, y1, z1}, {x1, y1, z0}},
+        {{x0, y0, z0}, {x0, y0, z1}, {x0, y1, z1}}, {{x0, y0, z0}, {x0, y1, z1}, {x0, y1, z0}},
+        {{x1, y0, z0}, {x1, y1, z0}, {x1, y1, z1}}, {{x1, y0, z0}, {x1, y1, z1}, {x1, y0, z1}},
+    };
+    triangles.insert(triangles.end(), cube.begin(), cube.end());
+}
+
+/**
+ * @brief Appends an open n x n grid of unit quads in the plane z = z0
+ *
+ * @param triangles Triangle list to append to
+ * @param n Number of quads along each side (2 n^2 triangles)
+ * @param z0 Height of the plane
+ */
+inline void append_grid(std::vector<problem1::Triangle>& triangles, std::size_t n, double z0) {
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            const double x0{static_cast<double>(j)}, x1{x0 + 1.};
+            const double y0{static_cast<double>(i)}, y1{y0 + 1.};
+            triangles.push_back({{x0, y0, z0}, {x1, y0, z0}, {x1, y1, z0}});
+            triangles.push_back({{x0, y0, z0}, {x1, y1, z0}, {x0, y1, z0}});
+        }
+    }
+}
+
+/**
+ * @brief Makes an outer cube [0, 4]^3 with one cube void [1, 2]^3 inside
+ *
+ * @return The 24 triangles, outer cube first
+ */
+inline std::vector<problem1::Triangle> make_cube_with_void() {
+    std::vector<problem1::Triangle> triangles;
+    append_cube(triangles, {0., 0., 0.}, 4.);
+    append_cube(triangles, {1., 1., 1.}, 1.);
+    return triangles;
+}
+
+}  // namespace tsexam::tests
@@ -0,0 +1,293 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <sstream>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "problem_1/analysis_control.hpp"
+#include "problem_1/async_analysis.hpp"
+#include "problem_1/geometry.hpp"
+#include "problem_1/reorient_triangles.hpp"
+#include "problem_1/stl_io.hpp"
+#include "problem_1/thread_pool.hpp"
+#include "problem_1/triangle_mesh.hpp"
+#include "problem_1/void_detection.hpp"
+
+#include "mesh_fixtures.hpp"
+
+using tsexam::problem1::AnalysisCancelled;
+using tsexam::problem1::AnalysisProgress;
+using tsexam::problem1::AnalysisStage;
+using tsexam::problem1::AsyncAnalysisOptions;
+using tsexam::problem1::AsyncAnalysisResult;
+using tsexam::problem1::ConnectivityEngine;
+using tsexam::problem1::export_inconsistent_triangles;
+using tsexam::problem1::export_inconsistent_triangles_async;
+using tsexam::problem1::export_voids_to_stl;
+using tsexam::problem1::export_voids_to_stl_async;
+using tsexam::problem1::flip_triangle;
+using tsexam::problem1::kCheckpointInterval;
+using tsexam::problem1::Point;
+using tsexam::problem1::StlFormat;
+using tsexam::problem1::ThreadPool;
+using tsexam::problem1::Triangle;
+using tsexam::problem1::TriangleMesh;
+using tsexam::problem1::write_ascii_stl;
+using tsexam::tests::append_cube;
+
+//---------------------------------------------------------------------------
+// Helpers
+//---------------------------------------------------------------------------
+
+/// Appends an open n x n grid of unit quads in the plane z = z0, every third quad flipped
+static void append_grid(std::vector<Triangle>& triangles, std::size_t n, double z0) {
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            const double x0{static_cast<double>(j)}, x1{x0 + 1.};
+            const double y0{static_cast<double>(i)}, y1{y0 + 1.};
+            Triangle lower{{x0, y0, z0}, {x1, y0, z0}, {x1, y1, z0}};
+            if ((i * n + j) % 3 == 0) {
+                flip_triangle(lower);
+            }
+            triangles.push_back(lower);
+            triangles.push_back({{x0, y0, z0}, {x1, y1, z0}, {x0, y1, z0}});
+        }
+    }
+}
+
+/// Number of triangles before the grid of `make_test_triangles`
+constexpr std::size_t kGridStart{12 * 28};
+
+/**
+ * Outer cube [0, 64]^3 holding 27 cube voids, then a 60 x 60 grid (7200 triangles), so that the
+ * per-triangle loops pass several checkpoints
+ */
+static std::vector<Triangle> make_test_triangles() {
+    std::vector<Triangle> triangles;
+    append_cube(triangles, {0., 0., 0.}, 64.);
+    for (std::size_t i = 0; i < 27; ++i) {
+        const Point origin{
+            4. + 20. * static_cast<double>(i % 3), 4. + 20. * static_cast<double>(i / 3 % 3),
+            4. + 20. * static_cast<double>(i / 9)
+        };
+        append_cube(triangles, origin, 2.);
+    }
+    append_grid(triangles, 60, 100.);
+    return triangles;
+}
+
+/// Scratch directory of one test, emptied on construction and removed on destruction
+class ScratchDirectory {
+public:
+    explicit ScratchDirectory(const std::string& name)
+        : path_{std::filesystem::temp_directory_path() / name} {
+        std::filesystem::remove_all(this->path_);
+        std::filesystem::create_directories(this->path_);
+    }
+    ~ScratchDirectory() { std::filesystem::remove_all(this->path_); }
+
+    const std::filesystem::path& GetPath() const { return path_; }
+
+private:
+    std::filesystem::path path_;
+};
+
+/// Writes the test mesh as an ASCII STL file and returns its path
+static std::string write_test_mesh(const ScratchDirectory& scratch) {
+    const std::string path{(scratch.GetPath() / "mesh.stl").string()};
+    std::ofstream file(path, std::ios::binary);
+    write_ascii_stl(file, "mesh", make_test_triangles());
+    return path;
+}
+
+/// Progress callback that stops a job once a stage passes a checkpoint inside its loop
+struct StopInside {
+    AnalysisStage stage;
+    std::stop_source* stop;
+
+    void operator()(const AnalysisProgress& progress) const {
+        if (progress.stage == this->stage && progress.completed > 0 &&
+            progress.completed < progress.total) {
+            this->stop->request_stop();
+        }
+    }
+};
+
+/// Stage at which a job was cancelled (throws if it was not)
+static AnalysisStage cancelled_stage(std::future<AsyncAnalysisResult>& future) {
+    try {
+        future.get();
+    } catch (const AnalysisCancelled& cancelled) {
+        return cancelled.GetStage();
+    }
+    throw std::logic_error("job was not cancelled");
+}
+
+//---------------------------------------------------------------------------
+// Results
+//---------------------------------------------------------------------------
+
+TEST(AsyncAnalysis, VoidExportMatchesSynchronousExport) {
+    const ScratchDirectory scratch{"tsexam_async_voids"};
+    const std::string path{write_test_mesh(scratch)};
+    const TriangleMesh mesh(path);
+    ThreadPool pool(2);
+
+    for (const StlFormat format : {StlFormat::kAscii, StlFormat::kBinary}) {
+        std::ostringstream expected(std::ios::binary);
+        export_voids_to_stl(mesh, expected, format);
+
+        std::ostringstream actual(std::ios::binary);
+        AsyncAnalysisOptions options;
+        options.output_format = format;
+        const AsyncAnalysisResult result{
+            export_voids_to_stl_async(pool, path, actual, options).get()
+        };
+        EXPECT_EQ(actual.str(), expected.str());
+        EXPECT_EQ(result.num_triangles, mesh.GetTriangles().size());
+        EXPECT_EQ(result.num_components, 29u);
+        EXPECT_EQ(result.num_voids, 27u);
+    }
+}
+
+TEST(AsyncAnalysis, ReorientationMatchesSynchronousExport) {
+    const ScratchDirectory scratch{"tsexam_async_reorient"};
+    const std::string path{write_test_mesh(scratch)};
+    const TriangleMesh mesh(path);
+    ThreadPool pool(2);
+
+    for (const std::size_t seed : {std::size_t{0}, kGridStart + 1, kGridStart + 777}) {
+        std::ostringstream expected;
+        export_inconsistent_triangles(mesh, seed, expected);
+
+        std::ostringstream actual;
+        const AsyncAnalysisResult result{
+            export_inconsistent_triangles_async(pool, path, seed, actual).get()
+        };
+        EXPECT_EQ(actual.str(), expected.str()) << seed;
+        EXPECT_EQ(result.num_triangles, mesh.GetTriangles().size());
+        EXPECT_EQ(result.num_reoriented == 0, seed == 0) << seed;
+    }
+}
+
+TEST(AsyncAnalysis, MissingFileFailsTheFuture) {
+    ThreadPool pool(1);
+    std::ostringstream out;
+    auto future{export_voids_to_stl_async(pool, "missing_async_analysis.stl", out)};
+    EXPECT_THROW(future.get(), std::invalid_argument);
+}
+
+//---------------------------------------------------------------------------
+// Progress
+//---------------------------------------------------------------------------
+
+TEST(AsyncAnalysis, ReportsEveryStageFromStartToEnd) {
+    const ScratchDirectory scratch{"tsexam_async_progress"};
+    const std::string path{write_test_mesh(scratch)};
+    ThreadPool pool(1);
+
+    const std::vector<AnalysisStage> hash_map_stages{
+        AnalysisStage::kParse,         AnalysisStage::kValidation, AnalysisStage::kConnectivity,
+        AnalysisStage::kNeighborTable, AnalysisStage::kComponents, AnalysisStage::kVoids,
+        AnalysisStage::kExport,
+    };
+    std::vector<AnalysisStage> sorted_stages{hash_map_stages};
+    sorted_stages.insert(sorted_stages.begin() + 2, AnalysisStage::kWelding);
+
+    for (const ConnectivityEngine engine :
+         {ConnectivityEngine::kEdgeHashMap, ConnectivityEngine::kSortedEdges}) {
+        // The callback runs on the worker; the future synchronizes the vector with the test
+        std::vector<AnalysisProgress> reports;
+        AsyncAnalysisOptions options;
+        options.connectivity = engine;
+        options.on_progress = [&reports](const AnalysisProgress& progress) {
+            reports.push_back(progress);
+        };
+        std::ostringstream out;
+        export_voids_to_stl_async(pool, path, out, options).get();
+
+        // Stages in pipeline order, each going from 0 to its total in checkpoint steps
+        std::vector<AnalysisStage> stages;
+        for (std::size_t r = 0; r < reports.size(); ++r) {
+            const AnalysisProgress& progress{reports[r]};
+            const bool first{r == 0 || reports[r - 1].stage != progress.stage};
+            const bool last{r + 1 == reports.size() || reports[r + 1].stage != progress.stage};
+            if (first) {
+                stages.push_back(progress.stage);
+                EXPECT_EQ(progress.completed, 0u);
+            } else {
+                EXPECT_GT(progress.completed, reports[r - 1].completed);
+                EXPECT_EQ(progress.total, reports[r - 1].total);
+            }
+            if (last) {
+                EXPECT_EQ(progress.completed, progress.total);
+            } else if (progress.stage != AnalysisStage::kParse) {
+                EXPECT_EQ(progress.completed % kCheckpointInterval, 0u);
+            }
+        }
+        EXPECT_EQ(stages, engine == ConnectivityEngine::kEdgeHashMap ? hash_map_stages
+                                                                     : sorted_stages);
+    }
+}
+
+//---------------------------------------------------------------------------
+// Cancellation
+//---------------------------------------------------------------------------
+
+TEST(AsyncAnalysis, StopBeforeStartCancelsDuringParse) {
+    const ScratchDirectory scratch{"tsexam_async_stop_early"};
+    const std::string path{write_test_mesh(scratch)};
+    ThreadPool pool(2);
+
+    std::stop_source stopped;
+    stopped.request_stop();
+    AsyncAnalysisOptions stopped_options;
+    stopped_options.stop_token = stopped.get_token();
+
+    // The other jobs of the pool are not affected
+    std::ostringstream stopped_out, voids_out, flipped_out;
+    auto cancelled{export_voids_to_stl_async(pool, path, stopped_out, stopped_options)};
+    auto voids{export_voids_to_stl_async(pool, path, voids_out)};
+    auto flipped{export_inconsistent_triangles_async(pool, path, kGridStart, flipped_out)};
+
+    EXPECT_EQ(cancelled_stage(cancelled), AnalysisStage::kParse);
+    EXPECT_TRUE(stopped_out.str().empty());
+    EXPECT_EQ(voids.get().num_voids, 27u);
+    EXPECT_GT(flipped.get().num_reoriented, 0u);
+}
+
+TEST(AsyncAnalysis, StopInsideStageLoopsCancelsThatStage) {
+    const ScratchDirectory scratch{"tsexam_async_stop_inside"};
+    const std::string path{write_test_mesh(scratch)};
+    ThreadPool pool(2);
+
+    // Stages whose loops run more than one checkpoint interval on the test mesh
+    for (const AnalysisStage stage :
+         {AnalysisStage::kWelding, AnalysisStage::kConnectivity, AnalysisStage::kNeighborTable,
+          AnalysisStage::kComponents}) {
+        std::stop_source stop;
+        AsyncAnalysisOptions options;
+        options.connectivity = ConnectivityEngine::kIndexedHashMap;
+        options.stop_token = stop.get_token();
+        options.on_progress = StopInside{stage, &stop};
+        std::ostringstream out;
+        auto future{export_voids_to_stl_async(pool, path, out, options)};
+        EXPECT_EQ(cancelled_stage(future), stage) << stage_name(stage);
+        EXPECT_TRUE(out.str().empty());
+    }
+
+    // Reorientation BFS over the grid component
+    std::stop_source stop;
+    AsyncAnalysisOptions options;
+    options.stop_token = stop.get_token();
+    options.on_progress = StopInside{AnalysisStage::kReorientation, &stop};
+    std::ostringstream out;
+    auto future{export_inconsistent_triangles_async(pool, path, kGridStart, out, options)};
+    EXPECT_EQ(cancelled_stage(future), AnalysisStage::kReorientation);
+}
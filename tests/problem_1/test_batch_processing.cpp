@@ -0,0 +1,202 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "problem_1/batch_processing.hpp"
+#include "problem_1/geometry.hpp"
+#include "problem_1/reorient_triangles.hpp"
+#include "problem_1/stl_io.hpp"
+#include "problem_1/triangle_mesh.hpp"
+#include "problem_1/void_detection.hpp"
+
+#include "mesh_fixtures.hpp"
+
+using tsexam::problem1::BatchOptions;
+using tsexam::problem1::BatchResult;
+using tsexam::problem1::export_inconsistent_triangles;
+using tsexam::problem1::export_voids_to_stl;
+using tsexam::problem1::find_connected_components;
+using tsexam::problem1::flip_triangle;
+using tsexam::problem1::Point;
+using tsexam::problem1::process_mesh_batch;
+using tsexam::problem1::reorient_inconsistent_triangles;
+using tsexam::problem1::StlFormat;
+using tsexam::problem1::Triangle;
+using tsexam::problem1::TriangleMesh;
+using tsexam::problem1::write_ascii_stl;
+using tsexam::problem1::write_binary_stl;
+using tsexam::tests::append_cube;
+
+//---------------------------------------------------------------------------
+// Helpers
+//---------------------------------------------------------------------------
+
+/// Outer cube with `num_voids` cube voids along its diagonal and a few flipped triangles
+static std::vector<Triangle> make_mesh_with_voids(std::size_t num_voids) {
+    std::vector<Triangle> triangles;
+    append_cube(triangles, {0., 0., 0.}, 2. * static_cast<double>(num_voids) + 1.);
+    for (std::size_t k = 0; k < num_voids; ++k) {
+        const double offset{2. * static_cast<double>(k) + 1.};
+        append_cube(triangles, {offset, offset, offset}, 0.5);
+    }
+    for (const std::size_t index : {1u, 5u}) {
+        flip_triangle(triangles[index]);
+    }
+    return triangles;
+}
+
+/// Bytes of a file
+static std::string read_bytes(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+/// Scratch directory of one test, emptied on construction and removed on destruction
+class ScratchDirectory {
+public:
+    explicit ScratchDirectory(const std::string& name)
+        : path_{std::filesystem::temp_directory_path() / name} {
+        std::filesystem::remove_all(this->path_);
+        std::filesystem::create_directories(this->path_);
+    }
+    ~ScratchDirectory() { std::filesystem::remove_all(this->path_); }
+
+    const std::filesystem::path& GetPath() const { return path_; }
+
+private:
+    std::filesystem::path path_;
+};
+
+//---------------------------------------------------------------------------
+// process_mesh_batch
+//---------------------------------------------------------------------------
+
+TEST(ProcessMeshBatch, OutputsMatchSingleFileExports) {
+    const ScratchDirectory scratch("tsexam_batch_outputs");
+    std::vector<std::string> paths;
+    std::vector<std::vector<Triangle>> meshes;
+    for (std::size_t k = 0; k < 6; ++k) {
+        meshes.push_back(make_mesh_with_voids(k));
+        const auto path{scratch.GetPath() / ("mesh_" + std::to_string(k) + ".stl")};
+        std::ofstream out(path, std::ios::binary);
+        if (k % 2 == 0) {
+            write_binary_stl(out, "mesh", meshes.back());
+        } else {
+            write_ascii_stl(out, "mesh", meshes.back());
+        }
+        paths.push_back(path.string());
+    }
+
+    BatchOptions options;
+    options.num_workers = 3;
+    options.output_directory = (scratch.GetPath() / "out").string();
+    options.export_reoriented = true;
+    options.reorient_seed = 0;
+    const std::vector<BatchResult> results{process_mesh_batch(paths, options)};
+
+    ASSERT_EQ(results.size(), paths.size());
+    for (std::size_t k = 0; k < results.size(); ++k) {
+        const BatchResult& result{results[k]};
+        ASSERT_TRUE(result.succeeded) << result.error;
+        EXPECT_EQ(result.input_path, paths[k]);
+
+        const TriangleMesh mesh(meshes[k]);
+        EXPECT_EQ(result.num_triangles, mesh.GetTriangles().size());
+        EXPECT_EQ(result.num_components, find_connected_components(mesh).size());
+        EXPECT_EQ(result.num_voids, k);
+
+        std::ostringstream voids;
+        export_voids_to_stl(mesh, voids, StlFormat::kBinary);
+        EXPECT_EQ(read_bytes(result.voids_path), voids.str()) << k;
+
+        std::ostringstream reoriented;
+        export_inconsistent_triangles(mesh, 0, reoriented, StlFormat::kBinary);
+        EXPECT_EQ(read_bytes(result.reoriented_path), reoriented.str()) << k;
+        EXPECT_EQ(result.num_reoriented, reorient_inconsistent_triangles(mesh, 0).size());
+    }
+}
+
+TEST(ProcessMeshBatch, FailuresAreReportedPerFile) {
+    const ScratchDirectory scratch("tsexam_batch_failures");
+    const auto valid{scratch.GetPath() / "valid.stl"};
+    const auto degenerate{scratch.GetPath() / "degenerate.stl"};
+    {
+        std::ofstream out(valid, std::ios::binary);
+        write_binary_stl(out, "valid", make_mesh_with_voids(1));
+    }
+    {
+        std::ofstream out(degenerate, std::ios::binary);
+        const std::vector<Triangle> triangles{{{0, 0, 0}, {0, 0, 0}, {1, 0, 0}}};
+        write_binary_stl(out, "degenerate", triangles);
+    }
+    const std::vector<std::string> paths{
+        (scratch.GetPath() / "missing.stl").string(), degenerate.string(), valid.string()
+    };
+
+    const std::vector<BatchResult> results{process_mesh_batch(paths)};
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_FALSE(results[0].succeeded);
+    EXPECT_NE(results[0].error.find("missing.stl"), std::string::npos) << results[0].error;
+    EXPECT_FALSE(results[1].succeeded);
+    EXPECT_NE(results[1].error.find("duplicate vertices"), std::string::npos) << results[1].error;
+    EXPECT_TRUE(results[2].succeeded) << results[2].error;
+    EXPECT_EQ(results[2].num_voids, 1u);
+    EXPECT_TRUE(results[2].voids_path.empty());  // no output directory -> nothing written
+}
+
+TEST(ProcessMeshBatch, TinyMemoryBoundStillProcessesEveryFile) {
+    // Every file exceeds the bound -> the files run one at a time, all of them
+    const ScratchDirectory scratch("tsexam_batch_memory");
+    std::vector<std::string> paths;
+    for (std::size_t k = 0; k < 5; ++k) {
+        const auto path{scratch.GetPath() / ("mesh_" + std::to_string(k) + ".stl")};
+        std::ofstream out(path, std::ios::binary);
+        write_binary_stl(out, "mesh", make_mesh_with_voids(2));
+        paths.push_back(path.string());
+    }
+
+    BatchOptions options;
+    options.num_workers = 4;
+    options.max_in_flight_bytes = 1;
+    options.large_file_bytes = 0;  // every file is large -> internal stages on 2 threads
+    options.large_file_threads = 2;
+    for (const BatchResult& result : process_mesh_batch(paths, options)) {
+        EXPECT_TRUE(result.succeeded) << result.error;
+        EXPECT_EQ(result.num_voids, 2u);
+        EXPECT_EQ(result.num_components, 3u);
+    }
+}
+
+TEST(ProcessMeshBatch, FilesOverTheBoundAreSerialized) {
+    const ScratchDirectory scratch("tsexam_batch_serialized");
+    std::vector<std::string> paths;
+    for (std::size_t k = 0; k < 6; ++k) {
+        const auto path{scratch.GetPath() / ("mesh_" + std::to_string(k) + ".stl")};
+        std::ofstream out(path, std::ios::binary);
+        write_binary_stl(out, "mesh", make_mesh_with_voids(k % 3 + 1));
+        paths.push_back(path.string());
+    }
+
+    // Every file exceeds the bound -> each file is alone in flight when admitted
+    BatchOptions options;
+    options.num_workers = 4;
+    options.max_in_flight_bytes = 1;
+    for (const BatchResult& result : process_mesh_batch(paths, options)) {
+        EXPECT_TRUE(result.succeeded) << result.error;
+        EXPECT_EQ(result.in_flight_bytes, std::filesystem::file_size(result.input_path));
+    }
+
+    // Room for about two files -> never more than the bound in flight
+    options.max_in_flight_bytes = 2 * std::filesystem::file_size(paths.back());
+    for (const BatchResult& result : process_mesh_batch(paths, options)) {
+        EXPECT_TRUE(result.succeeded) << result.error;
+        EXPECT_LE(result.in_flight_bytes, options.max_in_flight_bytes);
+        EXPECT_GE(result.in_flight_bytes, std::filesystem::file_size(result.input_path));
+    }
+}
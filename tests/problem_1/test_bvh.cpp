@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "problem_1/bvh.hpp"
+#include "problem_1/geometry.hpp"
+
+#include "mesh_fixtures.hpp"
+
+using tsexam::problem1::Point;
+using tsexam::problem1::ray_intersects_triangle;
+using tsexam::problem1::Triangle;
+using tsexam::problem1::TriangleBvh;
+using tsexam::problem1::TriangleIndex;
+using tsexam::tests::append_cube;
+
+//---------------------------------------------------------------------------
+// Helpers
+//---------------------------------------------------------------------------
+
+/// Random cloud of small cubes (many overlapping bounds, > 1024 triangles)
+static std::vector<Triangle> make_cube_cloud(std::size_t num_cubes) {
+    std::mt19937 rng(2024);
+    std::uniform_real_distribution<double> position(-50., 50.);
+    std::uniform_real_distribution<double> size(0.5, 4.);
+    std::vector<Triangle> triangles;
+    for (std::size_t k = 0; k < num_cubes; ++k) {
+        append_cube(triangles, {position(rng), position(rng), position(rng)}, size(rng));
+    }
+    return triangles;
+}
+
+static std::size_t brute_force_hits(
+    const std::vector<Triangle>& triangles, const Point& origin, const Point& direction
+) {
+    std::size_t hits = 0;
+    for (const Triangle& triangle : triangles) {
+        double t = 0.;
+        hits += ray_intersects_triangle(origin, direction, triangle, t) ? 1u : 0u;
+    }
+    return hits;
+}
+
+//---------------------------------------------------------------------------
+// ray_intersects_triangle
+//---------------------------------------------------------------------------
+
+TEST(RayIntersectsTriangle, HitReportsParameter) {
+    const Triangle triangle{{0, 0, 0}, {1, 0, 0}, {0, 1, 0}};
+    double t = 0.;
+    ASSERT_TRUE(ray_intersects_triangle({0.25, 0.25, 2.}, {0, 0, -1}, triangle, t));
+    EXPECT_DOUBLE_EQ(t, 2.);
+}
+
+TEST(RayIntersectsTriangle, MissesOutsideBehindAndParallel) {
+    const Triangle triangle{{0, 0, 0}, {1, 0, 0}, {0, 1, 0}};
+    double t = -1.;
+    EXPECT_FALSE(ray_intersects_triangle({0.8, 0.8, 1.}, {0, 0, -1}, triangle, t));  // outside
+    EXPECT_FALSE(ray_intersects_triangle({0.2, 0.2, 1.}, {0, 0, 1}, triangle, t));   // behind
+    EXPECT_FALSE(ray_intersects_triangle({0.2, 0.2, 1.}, {1, 0, 0}, triangle, t));   // parallel
+    EXPECT_DOUBLE_EQ(t, -1.);  // untouched on a miss
+}
+
+//---------------------------------------------------------------------------
+// TriangleBvh
+//---------------------------------------------------------------------------
+
+TEST(TriangleBvh, RayHitsMatchBruteForce) {
+    const auto triangles = make_cube_cloud(300);
+    const TriangleBvh bvh(triangles, 1);
+    EXPECT_EQ(bvh.GetTriangleIndices().size(), triangles.size());
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> coordinate(-60., 60.);
+    for (int r = 0; r < 200; ++r) {
+        const Point origin{coordinate(rng), coordinate(rng), coordinate(rng)};
+        const Point direction{coordinate(rng), coordinate(rng), coordinate(rng)};
+        EXPECT_EQ(
+            bvh.CountRayHits(origin, direction), brute_force_hits(triangles, origin, direction)
+        );
+    }
+
+    // Axis-aligned directions exercise the parallel-slab case
+    const Point origin{0, 0, -100};
+    const Point up{0, 0, 1};
+    EXPECT_EQ(bvh.CountRayHits(origin, up), brute_force_hits(triangles, origin, up));
+}
+
+TEST(TriangleBvh, ParallelBuildMatchesSerialBuild) {
+    const auto triangles = make_cube_cloud(400);
+    const TriangleBvh serial(triangles, 1);
+    const TriangleBvh parallel(triangles, 4);
+    ASSERT_EQ(parallel.GetNodes().size(), serial.GetNodes().size());
+    EXPECT_EQ(parallel.GetTriangleIndices(), serial.GetTriangleIndices());
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> coordinate(-60., 60.);
+    for (int r = 0; r < 100; ++r) {
+        const Point origin{coordinate(rng), coordinate(rng), coordinate(rng)};
+        const Point direction{coordinate(rng), coordinate(rng), coordinate(rng)};
+        EXPECT_EQ(
+            parallel.CountRayHits(origin, direction), serial.CountRayHits(origin, direction)
+        );
+    }
+}
+
+TEST(TriangleBvh, ContainsPointOfClosedCube) {
+    std::vector<Triangle> triangles;
+    append_cube(triangles, {0, 0, 0}, 2.);
+    const TriangleBvh bvh(triangles);
+    EXPECT_TRUE(bvh.ContainsPoint({1., 1., 1.}));
+    EXPECT_TRUE(bvh.ContainsPoint({0.1, 1.9, 0.5}));
+    EXPECT_FALSE(bvh.ContainsPoint({3., 1., 1.}));
+    EXPECT_FALSE(bvh.ContainsPoint({-1., -1., -1.}));
+}
+
+TEST(TriangleBvh, SubsetIndexesOnlySelectedTriangles) {
+    std::vector<Triangle> triangles;
+    append_cube(triangles, {0, 0, 0}, 1.);
+    append_cube(triangles, {10, 0, 0}, 1.);
+
+    std::vector<TriangleIndex> second_cube;
+    for (TriangleIndex i = 12; i < 24; ++i) {
+        second_cube.push_back(i);
+    }
+    const TriangleBvh bvh(triangles, second_cube);
+    auto indices = bvh.GetTriangleIndices();
+    std::sort(indices.begin(), indices.end());
+    EXPECT_EQ(indices, second_cube);
+    EXPECT_TRUE(bvh.ContainsPoint({10.5, 0.5, 0.5}));
+    EXPECT_FALSE(bvh.ContainsPoint({0.5, 0.5, 0.5}));  // inside the cube that is not indexed
+}
+
+TEST(TriangleBvh, EmptyBvhHasNoHits) {
+    const TriangleBvh bvh(std::vector<Triangle>{});
+    EXPECT_EQ(bvh.CountRayHits({0, 0, 0}, {1, 1, 1}), 0u);
+    EXPECT_FALSE(bvh.ContainsPoint({0, 0, 0}));
+}
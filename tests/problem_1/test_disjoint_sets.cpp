@@ -0,0 +1,47 @@
+#include <cstddef>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "common/parallel.hpp"
+#include "problem_1/disjoint_sets.hpp"
+
+using tsexam::problem1::ConcurrentDisjointSets;
+using tsexam::common::parallel_for;
+
+//---------------------------------------------------------------------------
+// ConcurrentDisjointSets
+//---------------------------------------------------------------------------
+
+TEST(ConcurrentDisjointSets, StartsWithSingletons) {
+    ConcurrentDisjointSets sets(5);
+    EXPECT_EQ(sets.Size(), 5u);
+    for (std::size_t i = 0; i < 5; ++i) {
+        EXPECT_EQ(sets.Find(i), i);
+    }
+}
+
+TEST(ConcurrentDisjointSets, UniteLinksToSmallestRoot) {
+    ConcurrentDisjointSets sets(6);
+    EXPECT_TRUE(sets.Unite(4, 2));
+    EXPECT_TRUE(sets.Unite(5, 4));
+    EXPECT_FALSE(sets.Unite(2, 5));  // already in the same set
+    EXPECT_TRUE(sets.Unite(3, 1));
+
+    EXPECT_EQ(sets.Find(5), 2u);
+    EXPECT_EQ(sets.Find(4), 2u);
+    EXPECT_EQ(sets.Find(3), 1u);
+    EXPECT_EQ(sets.Find(0), 0u);
+}
+
+TEST(ConcurrentDisjointSets, ConcurrentUnionsMatchExpectedSets) {
+    // Chain i -- i + kStride for every i: exactly kStride sets, rooted at 0 .. kStride - 1
+    const std::size_t size = 100000;
+    const std::size_t stride = 7;
+    ConcurrentDisjointSets sets(size);
+    parallel_for(size - stride, 4, [&](std::size_t i) { sets.Unite(i + stride, i); });
+
+    for (std::size_t i = 0; i < size; ++i) {
+        EXPECT_EQ(sets.Find(i), i % stride);
+    }
+}
@@ -0,0 +1,177 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory_resource>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "problem_1/flat_hash_map.hpp"
+#include "problem_1/geometry.hpp"
+
+using tsexam::problem1::Edge;
+using tsexam::problem1::EdgeBitsHash;
+using tsexam::problem1::EdgeEquality;
+using tsexam::problem1::FlatHashMap;
+using tsexam::problem1::make_edge;
+using tsexam::problem1::mix_coordinate_bits;
+
+//---------------------------------------------------------------------------
+// Helpers
+//---------------------------------------------------------------------------
+
+/// Well-spread hash of integer keys
+struct IntegerHash {
+    std::size_t operator()(std::uint64_t key) const noexcept {
+        return mix_coordinate_bits(std::array<std::uint64_t, 1>{key});
+    }
+};
+
+/// Hash sending every key to the same slot with the same tag
+struct CollidingHash {
+    std::size_t operator()(std::uint64_t /*key*/) const noexcept { return 42; }
+};
+
+using IntegerMap = FlatHashMap<std::uint64_t, int, IntegerHash, std::equal_to<>>;
+
+//---------------------------------------------------------------------------
+// FlatHashMap
+//---------------------------------------------------------------------------
+
+TEST(FlatHashMap, StartsEmptyWithoutSlots) {
+    const IntegerMap map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.bucket_count(), 0u);
+    EXPECT_EQ(map.load_factor(), 0.0F);
+    EXPECT_EQ(map.begin(), map.end());
+    EXPECT_EQ(map.find(7), map.end());
+}
+
+TEST(FlatHashMap, TryEmplaceKeepsTheFirstValue) {
+    IntegerMap map;
+    const auto [first, inserted] = map.try_emplace(7, 1);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(first->second, 1);
+
+    const auto [second, inserted_again] = map.try_emplace(7, 2);
+    EXPECT_FALSE(inserted_again);
+    EXPECT_EQ(second, first);
+    EXPECT_EQ(second->second, 1);
+    EXPECT_EQ(map.size(), 1u);
+
+    // The returned iterator gives write access to the value
+    second->second = 3;
+    EXPECT_EQ(map.find(7)->second, 3);
+}
+
+TEST(FlatHashMap, GrowsAndKeepsEveryEntry) {
+    IntegerMap map;
+    std::size_t num_rehashes{0};
+    std::size_t bucket_count{map.bucket_count()};
+    for (std::uint64_t key = 0; key < 10000; ++key) {
+        map.try_emplace(key * 3, static_cast<int>(key));
+        if (map.bucket_count() != bucket_count) {
+            bucket_count = map.bucket_count();
+            ++num_rehashes;
+        }
+        ASSERT_LE(map.load_factor(), IntegerMap::kMaxLoadFactor);
+    }
+    EXPECT_EQ(map.size(), 10000u);
+    EXPECT_GT(num_rehashes, 1u);
+    EXPECT_EQ(map.bucket_count() & (map.bucket_count() - 1), 0u);  // power of two
+
+    for (std::uint64_t key = 0; key < 10000; ++key) {
+        const auto it = map.find(key * 3);
+        ASSERT_NE(it, map.end());
+        EXPECT_EQ(it->second, static_cast<int>(key));
+        EXPECT_EQ(map.find(key * 3 + 1), map.end());
+    }
+}
+
+TEST(FlatHashMap, ReserveAvoidsGrowth) {
+    IntegerMap map;
+    map.reserve(1000);
+    const std::size_t bucket_count{map.bucket_count()};
+    EXPECT_GE(static_cast<double>(bucket_count) * IntegerMap::kMaxLoadFactor, 1000.0);
+    for (std::uint64_t key = 0; key < 1000; ++key) {
+        map.try_emplace(key, 0);
+    }
+    EXPECT_EQ(map.bucket_count(), bucket_count);
+
+    // Reserving less than the capacity keeps it
+    map.reserve(10);
+    EXPECT_EQ(map.bucket_count(), bucket_count);
+}
+
+TEST(FlatHashMap, CollidingKeysProbeLinearly) {
+    FlatHashMap<std::uint64_t, int, CollidingHash, std::equal_to<>> map;
+    for (std::uint64_t key = 0; key < 100; ++key) {
+        EXPECT_TRUE(map.try_emplace(key, static_cast<int>(key) + 1).second);
+    }
+    for (std::uint64_t key = 0; key < 100; ++key) {
+        ASSERT_NE(map.find(key), map.end());
+        EXPECT_EQ(map.find(key)->second, static_cast<int>(key) + 1);
+    }
+    EXPECT_EQ(map.find(100), map.end());
+}
+
+TEST(FlatHashMap, IteratesEveryEntryOnce) {
+    IntegerMap map;
+    for (std::uint64_t key = 0; key < 500; ++key) {
+        map.try_emplace(key, static_cast<int>(key));
+    }
+    std::map<std::uint64_t, int> visited;
+    for (const auto& [key, value] : map) {
+        EXPECT_TRUE(visited.emplace(key, value).second);
+    }
+    ASSERT_EQ(visited.size(), 500u);
+    for (const auto& [key, value] : visited) {
+        EXPECT_EQ(value, static_cast<int>(key));
+    }
+}
+
+TEST(FlatHashMap, ClearKeepsTheSlots) {
+    IntegerMap map;
+    for (std::uint64_t key = 0; key < 100; ++key) {
+        map.try_emplace(key, 0);
+    }
+    const std::size_t bucket_count{map.bucket_count()};
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.bucket_count(), bucket_count);
+    EXPECT_EQ(map.begin(), map.end());
+    EXPECT_EQ(map.find(5), map.end());
+    EXPECT_TRUE(map.try_emplace(5, 1).second);
+}
+
+TEST(FlatHashMap, AllocatesFromTheMemoryResource) {
+    // Every allocation must come from the buffer: the arena has no upstream resource
+    std::vector<std::byte> buffer(std::size_t{1} << 20);
+    std::pmr::monotonic_buffer_resource arena(
+        buffer.data(), buffer.size(), std::pmr::null_memory_resource()
+    );
+    IntegerMap map{IntegerMap::allocator_type{&arena}};
+    for (std::uint64_t key = 0; key < 1000; ++key) {
+        map.try_emplace(key, 0);
+    }
+    EXPECT_EQ(map.size(), 1000u);
+    EXPECT_EQ(map.get_allocator().resource(), &arena);
+
+    // A copy uses the default resource
+    const IntegerMap copy{map};
+    EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+    EXPECT_EQ(copy.size(), 1000u);
+    EXPECT_NE(copy.find(999), copy.end());
+}
+
+TEST(FlatHashMap, EdgeKeysWithSignedZerosMatch) {
+    FlatHashMap<Edge, int, EdgeBitsHash, EdgeEquality> map;
+    map.try_emplace(make_edge({0., 0., 0.}, {1., 0., 0.}), 1);
+
+    const auto it = map.find(make_edge({-0., 0., -0.}, {1., -0., 0.}));
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ(it->second, 1);
+    EXPECT_EQ(map.find(make_edge({0., 0., 0.}, {0., 1., 0.})), map.end());
+}
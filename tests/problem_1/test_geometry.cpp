@@ -1,16 +1,22 @@
+#include <cmath>
+#include <cstddef>
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 #include <gtest/gtest.h>
 
 #include "problem_1/geometry.hpp"
 
+using tsexam::problem1::BasicPointBitsHash;
 using tsexam::problem1::Edge;
+using tsexam::problem1::EdgeBitsHash;
 using tsexam::problem1::EdgeEquality;
 using tsexam::problem1::EdgeHash;
 using tsexam::problem1::make_edge;
 using tsexam::problem1::Point;
+using tsexam::problem1::PointBitsHash;
 using tsexam::problem1::PointEquality;
 using tsexam::problem1::PointHash;
 using tsexam::problem1::Triangle;
@@ -185,6 +191,65 @@ TEST(EdgeHash, UnorderedMapOverwriteDoesNotCreateDuplicates) {
     EXPECT_EQ(map.begin()->second, 2);  // value should be 2 for edge
 }
 
+//---------------------------------------------------------------------------
+// Bit-pattern hashing
+//---------------------------------------------------------------------------
+
+TEST(PointBitsHash, SignedZerosHashEqual) {
+    Point p1{0., -0., 2.};
+    Point p2{-0., 0., 2.};
+
+    PointBitsHash hash;
+    ASSERT_TRUE(PointEquality{}(p1, p2));
+    EXPECT_EQ(hash(p1), hash(p2));
+}
+
+TEST(PointBitsHash, DependsOnCoordinateOrder) {
+    PointBitsHash hash;
+    EXPECT_NE(hash({1., 2., 3.}), hash({3., 2., 1.}));
+    EXPECT_NE(hash({1., 2., 3.}), hash({2., 1., 3.}));
+    EXPECT_NE(hash({1., 2., 3.}), hash({1., 2., std::nextafter(3., 4.)}));
+}
+
+TEST(PointBitsHash, FloatPointsHashTheirOwnBits) {
+    BasicPointBitsHash<float> hash;
+    EXPECT_EQ(hash({0.F, 1.5F, -2.F}), hash({-0.F, 1.5F, -2.F}));
+    EXPECT_NE(hash({0.F, 1.5F, -2.F}), hash({0.F, 1.5F, 2.F}));
+}
+
+TEST(EdgeBitsHash, SignedZerosHashEqual) {
+    const Edge e1 = make_edge({0., 0., 0.}, {1., -0., 0.});
+    const Edge e2 = make_edge({-0., 0., -0.}, {1., 0., 0.});
+
+    EdgeBitsHash hash;
+    ASSERT_TRUE(EdgeEquality{}(e1, e2));
+    EXPECT_EQ(hash(e1), hash(e2));
+}
+
+TEST(EdgeBitsHash, SymmetricUnderEndpointPermutation) {
+    Point a{0., 0., 0.};
+    Point b{1., 2., 3.};
+
+    EdgeBitsHash hash;
+    EXPECT_EQ(hash(make_edge(a, b)), hash(make_edge(b, a)));
+}
+
+TEST(EdgeBitsHash, DistinctGridEdgesRarelyShareAHash) {
+    // Unit grid edges differ in a few exponent and mantissa bits only
+    std::unordered_set<std::size_t> hashes;
+    std::size_t num_edges{0};
+    EdgeBitsHash hash;
+    for (int x = 0; x < 64; ++x) {
+        for (int y = 0; y < 64; ++y) {
+            const Point p{static_cast<double>(x), static_cast<double>(y), 0.};
+            hashes.insert(hash(make_edge(p, {p[0] + 1., p[1], 0.})));
+            hashes.insert(hash(make_edge(p, {p[0], p[1] + 1., 0.})));
+            num_edges += 2;
+        }
+    }
+    EXPECT_EQ(hashes.size(), num_edges);
+}
+
 //---------------------------------------------------------------------------
 // Triangle structure
 //---------------------------------------------------------------------------
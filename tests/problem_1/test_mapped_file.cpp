@@ -0,0 +1,59 @@
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "problem_1/mapped_file.hpp"
+
+using tsexam::problem1::MappedFile;
+
+//---------------------------------------------------------------------------
+// Helpers
+//---------------------------------------------------------------------------
+
+/// Write the provided bytes to a file (binary mode, no newline translation)
+static void write_file(const std::string& path, const std::string& content) {
+    std::ofstream f(path, std::ios::binary);
+    ASSERT_TRUE(f) << "failed to open " << path;
+    f << content;
+}
+
+//---------------------------------------------------------------------------
+// MappedFile
+//---------------------------------------------------------------------------
+
+TEST(MappedFile, NonexistentPathThrows) {
+    EXPECT_THROW({ MappedFile file("nonexistent_mapped_file.bin"); }, std::runtime_error);
+}
+
+TEST(MappedFile, MapsWholeFileContent) {
+    const std::string content{"solid mapped\n\0binary\xff bytes\nendsolid\n", 36};
+    write_file("mapped_file_content.bin", content);
+
+    MappedFile file("mapped_file_content.bin");
+    EXPECT_EQ(file.GetSize(), content.size());
+    EXPECT_EQ(file.GetData(), content);  // all bytes mapped, including NUL and high bytes
+}
+
+TEST(MappedFile, EmptyFileGivesEmptyView) {
+    write_file("mapped_file_empty.bin", "");
+
+    MappedFile file("mapped_file_empty.bin");
+    EXPECT_EQ(file.GetSize(), 0u);
+    EXPECT_TRUE(file.GetData().empty());
+}
+
+TEST(MappedFile, MoveTransfersMapping) {
+    write_file("mapped_file_move.bin", "abcdef");
+
+    MappedFile original("mapped_file_move.bin");
+    MappedFile moved(std::move(original));
+    EXPECT_EQ(moved.GetData(), "abcdef");
+    EXPECT_TRUE(original.GetData().empty());  // moved-from object is empty
+
+    MappedFile assigned("mapped_file_move.bin");
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned.GetData(), "abcdef");
+}
@@ -0,0 +1,180 @@
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "problem_1/geometry.hpp"
+#include "problem_1/mesh_analysis.hpp"
+#include "problem_1/pipeline_stats.hpp"
+#include "problem_1/reorient_triangles.hpp"
+#include "problem_1/stl_io.hpp"
+#include "problem_1/triangle_mesh.hpp"
+#include "problem_1/void_detection.hpp"
+
+#include "mesh_fixtures.hpp"
+
+using tsexam::problem1::compute_component_aabb;
+using tsexam::problem1::ConnectedComponent;
+using tsexam::problem1::export_inconsistent_triangles;
+using tsexam::problem1::export_voids_to_stl;
+using tsexam::problem1::find_connected_components;
+using tsexam::problem1::flip_triangle;
+using tsexam::problem1::identify_voids;
+using tsexam::problem1::is_connected_component_closed;
+using tsexam::problem1::kStatsEnabled;
+using tsexam::problem1::MeshAnalysis;
+using tsexam::problem1::PipelineStats;
+using tsexam::problem1::Point;
+using tsexam::problem1::reorient_inconsistent_triangles;
+using tsexam::problem1::StlFormat;
+using tsexam::problem1::Triangle;
+using tsexam::problem1::TriangleMesh;
+using tsexam::problem1::VoidClassification;
+using tsexam::tests::append_cube;
+using tsexam::tests::append_grid;
+
+//---------------------------------------------------------------------------
+// Helpers
+//---------------------------------------------------------------------------
+
+/**
+ * Outer cube [0, 4]^3 with two cube voids, an open grid above it and two separate closed cubes
+ * side by side; a few triangles are flipped so that there are orientation inconsistencies
+ */
+static std::vector<Triangle> make_mixed_mesh() {
+    std::vector<Triangle> triangles;
+    append_cube(triangles, {0., 0., 0.}, 4.);
+    append_grid(triangles, 4, 10.);
+    append_cube(triangles, {1., 1., 1.}, 1.);
+    append_cube(triangles, {2.5, 2.5, 2.5}, 1.);
+    append_cube(triangles, {10., 0., 0.}, 1.);
+    append_cube(triangles, {12., 0., 0.}, 1.);
+    for (const std::size_t index : {3u, 7u, 15u, 20u, 53u}) {
+        flip_triangle(triangles[index]);
+    }
+    return triangles;
+}
+
+//---------------------------------------------------------------------------
+// Single traversal results
+//---------------------------------------------------------------------------
+
+TEST(MeshAnalysis, ComponentsMatchFindConnectedComponents) {
+    const TriangleMesh mesh(make_mixed_mesh());
+    const MeshAnalysis analysis(mesh);
+    const std::vector<ConnectedComponent> expected{find_connected_components(mesh)};
+    ASSERT_EQ(analysis.GetComponents(), expected);
+    ASSERT_EQ(expected.size(), 6u);
+
+    for (std::size_t k = 0; k < expected.size(); ++k) {
+        for (const auto triangle : expected[k]) {
+            EXPECT_EQ(analysis.GetComponentOf(static_cast<std::size_t>(triangle)), k);
+        }
+    }
+}
+
+TEST(MeshAnalysis, ClosednessAndAabbsMatchPerComponentFunctions) {
+    const TriangleMesh mesh(make_mixed_mesh());
+    const MeshAnalysis analysis(mesh);
+    const auto& components{analysis.GetComponents()};
+    ASSERT_EQ(analysis.GetComponentAabbs().size(), components.size());
+
+    std::size_t num_open{0};
+    for (std::size_t k = 0; k < components.size(); ++k) {
+        EXPECT_EQ(analysis.IsClosed(k), is_connected_component_closed(mesh, components[k])) << k;
+        num_open += analysis.IsClosed(k) ? 0u : 1u;
+
+        const auto& box{analysis.GetComponentAabbs()[k]};
+        const auto expected{compute_component_aabb(mesh, components[k])};
+        EXPECT_EQ(box.min_x, expected.min_x);
+        EXPECT_EQ(box.min_y, expected.min_y);
+        EXPECT_EQ(box.min_z, expected.min_z);
+        EXPECT_EQ(box.max_x, expected.max_x);
+        EXPECT_EQ(box.max_y, expected.max_y);
+        EXPECT_EQ(box.max_z, expected.max_z);
+    }
+    EXPECT_EQ(num_open, 1u);  // only the grid is open
+    EXPECT_EQ(analysis.GetClosedComponents().size(), components.size() - 1);
+}
+
+TEST(MeshAnalysis, InconsistentTrianglesMatchReorientationForEverySeed) {
+    const TriangleMesh mesh(make_mixed_mesh());
+    const MeshAnalysis analysis(mesh);
+
+    // Component roots are answered from the traversal, other seeds by a BFS of their own
+    for (std::size_t seed = 0; seed < mesh.GetTriangles().size(); ++seed) {
+        const std::vector<Triangle> expected{reorient_inconsistent_triangles(mesh, seed)};
+        const std::vector<Triangle> actual{analysis.GetInconsistentTriangles(seed)};
+        ASSERT_EQ(actual.size(), expected.size()) << seed;
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(actual[i].a, expected[i].a);
+            EXPECT_EQ(actual[i].b, expected[i].b);
+            EXPECT_EQ(actual[i].c, expected[i].c);
+        }
+    }
+    EXPECT_FALSE(analysis.GetInconsistentTriangles(0).empty());
+    EXPECT_TRUE(analysis.GetInconsistentTriangles(mesh.GetTriangles().size()).empty());
+}
+
+//---------------------------------------------------------------------------
+// Exports fed by the analysis
+//---------------------------------------------------------------------------
+
+TEST(MeshAnalysis, VoidsMatchMeshBasedIdentification) {
+    const TriangleMesh mesh(make_mixed_mesh());
+    const MeshAnalysis analysis(mesh);
+    std::vector<ConnectedComponent> closed_components;
+    for (const ConnectedComponent& component : find_connected_components(mesh)) {
+        if (is_connected_component_closed(mesh, component)) {
+            closed_components.push_back(component);
+        }
+    }
+
+    for (const auto classification :
+         {VoidClassification::kAabbContainment, VoidClassification::kPointInSolid}) {
+        const auto voids{identify_voids(analysis, classification)};
+        EXPECT_EQ(voids, identify_voids(mesh, closed_components, classification));
+        EXPECT_EQ(voids.size(), 2u);
+    }
+}
+
+TEST(MeshAnalysis, BothExportsShareOneAnalysis) {
+    const TriangleMesh mesh(make_mixed_mesh());
+    const MeshAnalysis analysis(mesh);
+
+    for (const auto format : {StlFormat::kAscii, StlFormat::kBinary}) {
+        std::ostringstream from_analysis;
+        std::ostringstream from_mesh;
+        export_voids_to_stl(analysis, from_analysis, format);
+        export_voids_to_stl(mesh, from_mesh, format);
+        EXPECT_EQ(from_analysis.str(), from_mesh.str());
+    }
+
+    for (const std::size_t seed : {0u, 5u, 60u}) {
+        std::ostringstream from_analysis;
+        std::ostringstream from_mesh;
+        export_inconsistent_triangles(analysis, seed, from_analysis);
+        export_inconsistent_triangles(mesh, seed, from_mesh);
+        EXPECT_EQ(from_analysis.str(), from_mesh.str()) << seed;
+    }
+}
+
+TEST(MeshAnalysis, RecordsComponentCounts) {
+    if (!kStatsEnabled) {
+        GTEST_SKIP() << "built with TSEXAM_ENABLE_STATS=0";
+    }
+    const TriangleMesh mesh(make_mixed_mesh());
+    PipelineStats stats;
+    const MeshAnalysis analysis(mesh, &stats);
+    EXPECT_EQ(stats.num_components, 6u);
+    EXPECT_EQ(stats.num_closed_components, 5u);
+    EXPECT_GT(stats.components_time.count(), 0);
+
+    std::ostringstream out;
+    export_voids_to_stl(analysis, out, StlFormat::kAscii, &stats);
+    EXPECT_EQ(stats.num_components, 6u);  // the export does not traverse again
+    EXPECT_EQ(stats.num_voids, 2u);
+    EXPECT_EQ(stats.triangles_exported, 24u);
+}
@@ -0,0 +1,349 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "problem_1/geometry.hpp"
+#include "problem_1/mesh_cache.hpp"
+#include "problem_1/mesh_editor.hpp"
+#include "problem_1/pipeline_stats.hpp"
+#include "problem_1/reorient_triangles.hpp"
+#include "problem_1/stl_io.hpp"
+#include "problem_1/triangle_mesh.hpp"
+#include "problem_1/void_detection.hpp"
+
+#include "mesh_fixtures.hpp"
+
+using tsexam::problem1::ConnectedComponent;
+using tsexam::problem1::ConnectivityEngine;
+using tsexam::problem1::default_mesh_cache_path;
+using tsexam::problem1::export_voids_to_stl;
+using tsexam::problem1::find_connected_components;
+using tsexam::problem1::flip_triangle;
+using tsexam::problem1::hash_stl_content;
+using tsexam::problem1::kStatsEnabled;
+using tsexam::problem1::load_mesh_with_cache;
+using tsexam::problem1::make_mesh_cache_key;
+using tsexam::problem1::MeshCacheKey;
+using tsexam::problem1::MeshEditor;
+using tsexam::problem1::PipelineStats;
+using tsexam::problem1::Point;
+using tsexam::problem1::read_mesh_cache;
+using tsexam::problem1::reorient_all_components;
+using tsexam::problem1::Triangle;
+using tsexam::problem1::TriangleIndex;
+using tsexam::problem1::TriangleMesh;
+using tsexam::problem1::TriangleMeshOptions;
+using tsexam::problem1::write_binary_stl;
+using tsexam::problem1::write_mesh_cache;
+using tsexam::tests::append_cube;
+using tsexam::tests::make_cube_with_void;
+
+//---------------------------------------------------------------------------
+// Helpers
+//---------------------------------------------------------------------------
+
+/// STL file with a sidecar cache path in the temp directory, both removed on destruction
+class CachedStlFile {
+public:
+    explicit CachedStlFile(const std::string& name)
+        : path_{(std::filesystem::temp_directory_path() / name).string()},
+          cache_path_{default_mesh_cache_path(path_)} {
+        std::filesystem::remove(this->cache_path_);
+    }
+
+    ~CachedStlFile() {
+        std::filesystem::remove(this->path_);
+        std::filesystem::remove(this->cache_path_);
+    }
+
+    /// (Re)writes the STL file as binary STL
+    void Write(const std::vector<Triangle>& triangles) const {
+        std::ofstream out(this->path_, std::ios::binary | std::ios::trunc);
+        write_binary_stl(out, "cache_test", triangles);
+    }
+
+    /// Key of the current STL content
+    MeshCacheKey Key() const {
+        std::ifstream in(this->path_, std::ios::binary);
+        std::ostringstream content;
+        content << in.rdbuf();
+        return make_mesh_cache_key(content.str());
+    }
+
+    const std::string& Path() const { return path_; }
+    const std::string& CachePath() const { return cache_path_; }
+
+private:
+    std::string path_;
+    std::string cache_path_;
+};
+
+/// Void export of a mesh as ASCII STL text
+static std::string export_voids(const TriangleMesh& mesh) {
+    std::ostringstream out;
+    export_voids_to_stl(mesh, out);
+    return out.str();
+}
+
+//---------------------------------------------------------------------------
+// Content hash
+//---------------------------------------------------------------------------
+
+TEST(HashStlContent, IsDeterministicAndSensitiveToEveryByte) {
+    const std::string content{"solid cube\n  facet normal 0 0 1\nendsolid cube\n"};
+    EXPECT_EQ(hash_stl_content(content), hash_stl_content(std::string{content}));
+
+    // Flip one byte in the word-aligned body and one in the tail
+    for (const std::size_t position : {std::size_t{3}, content.size() - 2}) {
+        std::string changed{content};
+        changed[position] = static_cast<char>(changed[position] ^ 0x01);
+        EXPECT_NE(hash_stl_content(changed), hash_stl_content(content)) << position;
+    }
+
+    // Trailing zero bytes change the length and therefore the hash
+    EXPECT_NE(hash_stl_content(content + '\0'), hash_stl_content(content));
+    EXPECT_EQ(make_mesh_cache_key(content).source_size, content.size());
+}
+
+//---------------------------------------------------------------------------
+// Cache round trip
+//---------------------------------------------------------------------------
+
+TEST(LoadMeshWithCache, SecondLoadIsRestoredFromCache) {
+    const CachedStlFile file("mesh_cache_round_trip.stl");
+    file.Write(make_cube_with_void());
+    const TriangleMesh reference(make_cube_with_void());
+
+    const TriangleMesh built{load_mesh_with_cache(file.Path())};
+    ASSERT_TRUE(std::filesystem::exists(file.CachePath()));
+    EXPECT_EQ(built.GetConnectivityEngine(), ConnectivityEngine::kEdgeHashMap);
+    EXPECT_EQ(built.GetCachedComponents(), find_connected_components(reference));
+
+    const TriangleMesh restored{load_mesh_with_cache(file.Path())};
+    EXPECT_EQ(restored.GetConnectivityEngine(), ConnectivityEngine::kNeighborTable);
+    ASSERT_EQ(restored.GetTriangles().size(), reference.GetTriangles().size());
+    for (std::size_t i = 0; i < reference.GetTriangles().size(); ++i) {
+        EXPECT_EQ(restored.GetTriangles()[i].a, reference.GetTriangles()[i].a);
+        EXPECT_EQ(restored.GetTriangles()[i].b, reference.GetTriangles()[i].b);
+        EXPECT_EQ(restored.GetTriangles()[i].c, reference.GetTriangles()[i].c);
+        for (std::size_t local_edge = 0; local_edge < 3; ++local_edge) {
+            EXPECT_EQ(
+                restored.GetEdgeTriangles(i, local_edge), reference.GetEdgeTriangles(i, local_edge)
+            );
+        }
+    }
+    EXPECT_EQ(restored.GetTriangleNeighbors(), reference.GetTriangleNeighbors());
+    EXPECT_EQ(restored.GetCachedComponents(), find_connected_components(reference));
+    EXPECT_EQ(find_connected_components(restored, 4), find_connected_components(reference));
+
+    // The analysis results are unchanged by the cache
+    EXPECT_EQ(export_voids(restored), export_voids(reference));
+}
+
+TEST(LoadMeshWithCache, RecordsHitsAndMisses) {
+    if (!kStatsEnabled) {
+        GTEST_SKIP() << "built with TSEXAM_ENABLE_STATS=0";
+    }
+    const CachedStlFile file("mesh_cache_stats.stl");
+    file.Write(make_cube_with_void());
+
+    PipelineStats miss_stats;
+    const TriangleMesh built{load_mesh_with_cache(file.Path(), {{}, 0, &miss_stats})};
+    EXPECT_EQ(miss_stats.cache_misses, 1u);
+    EXPECT_EQ(miss_stats.cache_hits, 0u);
+    EXPECT_EQ(miss_stats.triangles_parsed, 24u);
+
+    PipelineStats hit_stats;
+    const TriangleMesh restored{load_mesh_with_cache(file.Path(), {{}, 0, &hit_stats})};
+    EXPECT_EQ(hit_stats.cache_hits, 1u);
+    EXPECT_EQ(hit_stats.cache_misses, 0u);
+    EXPECT_EQ(hit_stats.triangles_parsed, 0u);  // nothing parsed or rebuilt
+    EXPECT_EQ(hit_stats.connectivity_time.count(), 0);
+    EXPECT_GT(hit_stats.cache_time.count(), 0);
+}
+
+TEST(LoadMeshWithCache, ChangedSourceRebuildsCache) {
+    const CachedStlFile file("mesh_cache_stale.stl");
+    file.Write(make_cube_with_void());
+    (void)load_mesh_with_cache(file.Path());
+
+    // Same cache path, different content -> stale cache is ignored and replaced
+    std::vector<Triangle> single_cube;
+    append_cube(single_cube, {0., 0., 0.}, 1.);
+    file.Write(single_cube);
+    const TriangleMesh rebuilt{load_mesh_with_cache(file.Path())};
+    EXPECT_EQ(rebuilt.GetConnectivityEngine(), ConnectivityEngine::kEdgeHashMap);
+    EXPECT_EQ(rebuilt.GetTriangles().size(), 12u);
+    EXPECT_EQ(rebuilt.GetCachedComponents().size(), 1u);
+
+    const TriangleMesh restored{load_mesh_with_cache(file.Path())};
+    EXPECT_EQ(restored.GetConnectivityEngine(), ConnectivityEngine::kNeighborTable);
+    EXPECT_EQ(restored.GetTriangles().size(), 12u);
+}
+
+TEST(LoadMeshWithCache, UnwritableCacheLocationIsSkipped) {
+    const CachedStlFile file("mesh_cache_unwritable.stl");
+    file.Write(make_cube_with_void());
+    const std::string cache_path{
+        (std::filesystem::temp_directory_path() / "no_such_directory" / "mesh.tscache").string()
+    };
+    const TriangleMesh mesh{load_mesh_with_cache(file.Path(), {}, cache_path)};
+    EXPECT_EQ(mesh.GetTriangles().size(), 24u);
+    EXPECT_FALSE(std::filesystem::exists(cache_path));
+}
+
+//---------------------------------------------------------------------------
+// Cache validation
+//---------------------------------------------------------------------------
+
+TEST(ReadMeshCache, MissingCacheGivesNothing) {
+    EXPECT_FALSE(read_mesh_cache("nonexistent_mesh_cache.tscache", MeshCacheKey{1, 2}).has_value());
+}
+
+TEST(ReadMeshCache, KeyMismatchGivesNothing) {
+    const CachedStlFile file("mesh_cache_key.stl");
+    file.Write(make_cube_with_void());
+    const MeshCacheKey key{file.Key()};
+    write_mesh_cache(file.CachePath(), TriangleMesh(make_cube_with_void()), key);
+
+    EXPECT_TRUE(read_mesh_cache(file.CachePath(), key).has_value());
+    EXPECT_FALSE(
+        read_mesh_cache(file.CachePath(), {key.content_hash + 1, key.source_size}).has_value()
+    );
+    EXPECT_FALSE(
+        read_mesh_cache(file.CachePath(), {key.content_hash, key.source_size + 1}).has_value()
+    );
+}
+
+TEST(ReadMeshCache, VersionAndMagicMismatchGiveNothing) {
+    const CachedStlFile file("mesh_cache_version.stl");
+    file.Write(make_cube_with_void());
+    const MeshCacheKey key{file.Key()};
+
+    // Byte 0 is the start of the magic, byte 8 the start of the layout version
+    for (const std::streamoff position : {std::streamoff{0}, std::streamoff{8}}) {
+        write_mesh_cache(file.CachePath(), TriangleMesh(make_cube_with_void()), key);
+        {
+            std::fstream cache(file.CachePath(), std::ios::binary | std::ios::in | std::ios::out);
+            cache.seekp(position);
+            cache.put('\x7f');
+        }
+        EXPECT_FALSE(read_mesh_cache(file.CachePath(), key).has_value()) << position;
+
+        // The loader falls back to a rebuild and replaces the rejected cache
+        const TriangleMesh mesh{load_mesh_with_cache(file.Path())};
+        EXPECT_EQ(mesh.GetConnectivityEngine(), ConnectivityEngine::kEdgeHashMap);
+        EXPECT_TRUE(read_mesh_cache(file.CachePath(), key).has_value());
+    }
+}
+
+TEST(ReadMeshCache, TruncatedOrCorruptCacheGivesNothing) {
+    const CachedStlFile file("mesh_cache_truncated.stl");
+    file.Write(make_cube_with_void());
+    const MeshCacheKey key{file.Key()};
+    write_mesh_cache(file.CachePath(), TriangleMesh(make_cube_with_void()), key);
+    const auto full_size{std::filesystem::file_size(file.CachePath())};
+
+    std::filesystem::resize_file(file.CachePath(), full_size - 4);
+    EXPECT_FALSE(read_mesh_cache(file.CachePath(), key).has_value());
+    std::filesystem::resize_file(file.CachePath(), 20);
+    EXPECT_FALSE(read_mesh_cache(file.CachePath(), key).has_value());
+
+    // Out-of-range neighbor index: the neighbor table follows 48 + 72n + 8(m + 1) bytes
+    write_mesh_cache(file.CachePath(), TriangleMesh(make_cube_with_void()), key);
+    {
+        std::fstream cache(file.CachePath(), std::ios::binary | std::ios::in | std::ios::out);
+        cache.seekp(48 + 72 * 24 + 8 * 3);
+        const std::int32_t out_of_range{1000};
+        cache.write(reinterpret_cast<const char*>(&out_of_range), sizeof(out_of_range));
+    }
+    EXPECT_FALSE(read_mesh_cache(file.CachePath(), key).has_value());
+}
+
+TEST(WriteMeshCache, NeighborTableEngineMeshCanBeCachedAgain) {
+    const CachedStlFile file("mesh_cache_rewrite.stl");
+    file.Write(make_cube_with_void());
+    const MeshCacheKey key{file.Key()};
+    write_mesh_cache(
+        file.CachePath(),
+        TriangleMesh(make_cube_with_void(), {ConnectivityEngine::kNeighborTable}), key
+    );
+
+    const std::optional<TriangleMesh> restored{read_mesh_cache(file.CachePath(), key)};
+    ASSERT_TRUE(restored.has_value());
+    write_mesh_cache(file.CachePath(), *restored, key);
+    const std::optional<TriangleMesh> again{read_mesh_cache(file.CachePath(), key)};
+    ASSERT_TRUE(again.has_value());
+    EXPECT_EQ(again->GetTriangleNeighbors(), restored->GetTriangleNeighbors());
+    EXPECT_EQ(again->GetCachedComponents(), restored->GetCachedComponents());
+}
+
+TEST(LoadMeshWithCache, EditsDropTheCachedComponents) {
+    const CachedStlFile file("mesh_cache_edit.stl");
+    file.Write(make_cube_with_void());
+    TriangleMesh mesh{load_mesh_with_cache(file.Path())};
+    ASSERT_FALSE(mesh.GetCachedComponents().empty());
+
+    // Removing a triangle moves the last one into its slot: stale components would index past
+    // the end of the triangle array
+    MeshEditor editor(mesh);
+    const Triangle removed{mesh.GetTriangles().front()};
+    editor.RemoveTriangle(0);
+    EXPECT_TRUE(mesh.GetCachedComponents().empty());
+    std::vector<ConnectedComponent> components{find_connected_components(mesh)};
+    EXPECT_EQ(components, find_connected_components(TriangleMesh(mesh.GetTriangles())));
+    for (const ConnectedComponent& component : components) {
+        for (const auto index : component) {
+            EXPECT_LT(static_cast<std::size_t>(index), mesh.GetTriangles().size());
+        }
+    }
+
+    editor.InsertTriangle(removed);
+    EXPECT_TRUE(mesh.GetCachedComponents().empty());
+    components = find_connected_components(mesh);
+    EXPECT_EQ(components, find_connected_components(TriangleMesh(mesh.GetTriangles())));
+
+}
+
+TEST(LoadMeshWithCache, ReorientsCachedMeshInParallel) {
+    // Every other triangle flipped, so that both components have triangles to flip back
+    std::vector<Triangle> triangles{make_cube_with_void()};
+    for (std::size_t i = 1; i < triangles.size(); i += 2) {
+        flip_triangle(triangles[i]);
+    }
+    const CachedStlFile file("mesh_cache_reorient.stl");
+    file.Write(triangles);
+    TriangleMesh expected{triangles};
+    const std::vector<TriangleIndex> expected_flipped{reorient_all_components(expected, 1)};
+
+    // Load once to write the cache, then restore the mesh and its components from it
+    load_mesh_with_cache(file.Path());
+    TriangleMesh mesh{load_mesh_with_cache(file.Path())};
+    const std::vector<ConnectedComponent> cached{mesh.GetCachedComponents()};
+    ASSERT_EQ(cached.size(), 2u);
+
+    // Flips change no component -> the workers keep the cache and never write to it
+    EXPECT_EQ(reorient_all_components(mesh, 4), expected_flipped);
+    for (std::size_t i = 0; i < triangles.size(); ++i) {
+        EXPECT_EQ(mesh.GetTriangles()[i].b, expected.GetTriangles()[i].b) << i;
+        EXPECT_EQ(mesh.GetTriangles()[i].c, expected.GetTriangles()[i].c) << i;
+    }
+    EXPECT_EQ(mesh.GetCachedComponents(), cached);
+    // Same triangles in every component; the BFS order is the one from before the flips
+    std::vector<ConnectedComponent> components{find_connected_components(expected)};
+    ASSERT_EQ(components.size(), cached.size());
+    for (std::size_t k = 0; k < cached.size(); ++k) {
+        ConnectedComponent members{cached[k]};
+        std::sort(members.begin(), members.end());
+        std::sort(components[k].begin(), components[k].end());
+        EXPECT_EQ(members, components[k]);
+    }
+}
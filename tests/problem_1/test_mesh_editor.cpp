@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "problem_1/geometry.hpp"
+#include "problem_1/mesh_editor.hpp"
+#include "problem_1/triangle_mesh.hpp"
+#include "problem_1/void_detection.hpp"
+
+using tsexam::problem1::ConnectedComponent;
+using tsexam::problem1::ConnectivityEngine;
+using tsexam::problem1::find_connected_components;
+using tsexam::problem1::MeshEditor;
+using tsexam::problem1::Triangle;
+using tsexam::problem1::TriangleMesh;
+
+//---------------------------------------------------------------------------
+// Helpers
+//---------------------------------------------------------------------------
+
+/// Consistently oriented nrows x ncols grid of unit quads at height z, 2 triangles each
+static std::vector<Triangle> make_grid(std::size_t nrows, std::size_t ncols, double z = 0.) {
+    std::vector<Triangle> triangles;
+    for (std::size_t i = 0; i < nrows; ++i) {
+        for (std::size_t j = 0; j < ncols; ++j) {
+            const double x0{static_cast<double>(j)}, x1{x0 + 1.};
+            const double y0{static_cast<double>(i)}, y1{y0 + 1.};
+            triangles.push_back({{x0, y0, z}, {x1, y0, z}, {x1, y1, z}});
+            triangles.push_back({{x0, y0, z}, {x1, y1, z}, {x0, y1, z}});
+        }
+    }
+    return triangles;
+}
+
+/// Check the editor's labels and components against a full traversal of its mesh
+static void expect_components_match_traversal(const MeshEditor& editor) {
+    std::vector<ConnectedComponent> expected{find_connected_components(editor.GetMesh())};
+    for (ConnectedComponent& component : expected) {
+        std::sort(component.begin(), component.end());
+    }
+    ASSERT_EQ(editor.GetComponents(), expected);
+    ASSERT_EQ(editor.GetComponentCount(), expected.size());
+
+    // One label per component, different across components
+    std::set<std::uint32_t> labels;
+    for (const ConnectedComponent& component : expected) {
+        const std::uint32_t label{editor.GetComponentOf(static_cast<std::size_t>(component[0]))};
+        for (const auto triangle : component) {
+            ASSERT_EQ(editor.GetComponentOf(static_cast<std::size_t>(triangle)), label);
+        }
+        EXPECT_EQ(editor.GetComponentTriangles(label).size(), component.size());
+        labels.insert(label);
+    }
+    EXPECT_EQ(labels.size(), expected.size());
+}
+
+//---------------------------------------------------------------------------
+// MeshEditor
+//---------------------------------------------------------------------------
+
+TEST(MeshEditor, LabelsInitialComponents) {
+    std::vector<Triangle> triangles{make_grid(3, 3)};
+    const std::vector<Triangle> second{make_grid(2, 2, 5.)};
+    triangles.insert(triangles.end(), second.begin(), second.end());
+    TriangleMesh mesh(triangles);
+    const MeshEditor editor(mesh);
+    EXPECT_EQ(editor.GetComponentCount(), 2u);
+    expect_components_match_traversal(editor);
+}
+
+TEST(MeshEditor, RemovingAStripTriangleSplitsAndReinsertingJoins) {
+    // A 1 x 4 strip is a chain of 8 triangles -> removing an inner one cuts it in two
+    TriangleMesh mesh(make_grid(1, 4));
+    MeshEditor editor(mesh);
+    const Triangle cut{mesh.GetTriangles()[3]};
+    editor.RemoveTriangle(3);
+    EXPECT_EQ(editor.GetComponentCount(), 2u);
+    expect_components_match_traversal(editor);
+
+    editor.InsertTriangle(cut);
+    EXPECT_EQ(editor.GetComponentCount(), 1u);
+    expect_components_match_traversal(editor);
+}
+
+TEST(MeshEditor, RemovingAnInteriorTriangleKeepsOneComponent) {
+    TriangleMesh mesh(make_grid(5, 5));
+    MeshEditor editor(mesh);
+    editor.RemoveTriangle(24);
+    EXPECT_EQ(editor.GetComponentCount(), 1u);
+    expect_components_match_traversal(editor);
+}
+
+TEST(MeshEditor, RandomEditsMatchFullTraversal) {
+    std::vector<Triangle> triangles{make_grid(6, 6)};
+    const std::vector<Triangle> second{make_grid(2, 3, 4.)};
+    triangles.insert(triangles.end(), second.begin(), second.end());
+    TriangleMesh mesh(triangles);
+    MeshEditor editor(mesh);
+
+    // Removed triangles can always go back: their edges keep at most one other triangle
+    std::vector<Triangle> removed;
+    std::uint64_t state{12345};
+    auto next = [&state](std::size_t bound) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<std::size_t>((state >> 33) % bound);
+    };
+    for (int step = 0; step < 400; ++step) {
+        const bool remove{removed.empty() || (mesh.GetTriangles().size() > 1 && next(3) != 0)};
+        if (remove && mesh.GetTriangles().size() > 1) {
+            const std::size_t index{next(mesh.GetTriangles().size())};
+            removed.push_back(mesh.GetTriangles()[index]);
+            editor.RemoveTriangle(index);
+        } else {
+            const std::size_t pick{next(removed.size())};
+            editor.InsertTriangle(removed[pick]);
+            removed.erase(removed.begin() + static_cast<std::ptrdiff_t>(pick));
+        }
+        if (step % 7 == 0) {
+            editor.FlipTriangle(next(mesh.GetTriangles().size()));
+        }
+        expect_components_match_traversal(editor);
+    }
+}
+
+TEST(MeshEditor, RejectedEditsLeaveLabelsUnchanged) {
+    TriangleMesh mesh(make_grid(2, 2));
+    MeshEditor editor(mesh);
+    editor.InsertTriangle({{0, 0, 0}, {1, 0, 0}, {0, 0, 1}});
+    EXPECT_THROW(editor.InsertTriangle({{0, 0, 0}, {1, 0, 0}, {0, -1, 0}}), std::invalid_argument);
+    EXPECT_THROW(editor.RemoveTriangle(100), std::invalid_argument);
+    EXPECT_EQ(mesh.GetTriangles().size(), 9u);
+    expect_components_match_traversal(editor);
+}
+
+TEST(MeshEditor, RequiresEdgeHashMapEngine) {
+    TriangleMesh mesh(make_grid(2, 2), {ConnectivityEngine::kSortedEdges});
+    EXPECT_THROW(MeshEditor{mesh}, std::logic_error);
+}
@@ -0,0 +1,262 @@
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "problem_1/geometry.hpp"
+#include "problem_1/mesh_analysis.hpp"
+#include "problem_1/out_of_core_analysis.hpp"
+#include "problem_1/pipeline_stats.hpp"
+#include "problem_1/stl_io.hpp"
+#include "problem_1/triangle_mesh.hpp"
+#include "problem_1/void_detection.hpp"
+
+#include "mesh_fixtures.hpp"
+
+using tsexam::problem1::export_voids_to_stl;
+using tsexam::problem1::find_connected_components;
+using tsexam::problem1::find_void_components;
+using tsexam::problem1::kStatsEnabled;
+using tsexam::problem1::MeshAnalysis;
+using tsexam::problem1::OutOfCoreAnalysis;
+using tsexam::problem1::OutOfCoreOptions;
+using tsexam::problem1::parse_ascii_stl;
+using tsexam::problem1::parse_binary_stl;
+using tsexam::problem1::PipelineStats;
+using tsexam::problem1::Point;
+using tsexam::problem1::StlFormat;
+using tsexam::problem1::Triangle;
+using tsexam::problem1::TriangleMesh;
+using tsexam::problem1::write_ascii_stl;
+using tsexam::problem1::write_binary_stl;
+using tsexam::tests::append_cube;
+using tsexam::tests::append_grid;
+
+//---------------------------------------------------------------------------
+// Helpers
+//---------------------------------------------------------------------------
+
+/**
+ * Outer cube [0, 64]^3 holding a lattice of small cube voids, some cubes outside it and an open
+ * grid, with the triangles shuffled so that components interleave in the input
+ */
+static std::vector<Triangle> make_shuffled_mesh() {
+    std::vector<Triangle> triangles;
+    append_cube(triangles, {0., 0., 0.}, 64.);
+    for (std::size_t i = 0; i < 216; ++i) {
+        const Point origin{
+            2. + 10. * static_cast<double>(i % 6), 2. + 10. * static_cast<double>(i / 6 % 6),
+            2. + 10. * static_cast<double>(i / 36)
+        };
+        append_cube(triangles, origin, 1.5);
+    }
+    for (std::size_t i = 0; i < 20; ++i) {
+        append_cube(triangles, {100. + 3. * static_cast<double>(i), 0., 0.}, 1.);
+    }
+    append_grid(triangles, 12, 80.);
+
+    std::mt19937_64 generator{5};
+    std::shuffle(triangles.begin(), triangles.end(), generator);
+    return triangles;
+}
+
+/// ASCII STL text of a triangle list
+static std::string to_ascii_stl(const std::vector<Triangle>& triangles) {
+    std::ostringstream out;
+    write_ascii_stl(out, "mesh", triangles);
+    return out.str();
+}
+
+/// Binary STL bytes of a triangle list
+static std::string to_binary_stl(const std::vector<Triangle>& triangles) {
+    std::ostringstream out(std::ios::binary);
+    write_binary_stl(out, "mesh", triangles);
+    return out.str();
+}
+
+/// Out-of-core analysis of in-memory STL data
+static OutOfCoreAnalysis analyze(const std::string& stl, const OutOfCoreOptions& options = {}) {
+    std::istringstream input(stl, std::ios::binary);
+    return OutOfCoreAnalysis(input, options);
+}
+
+/// Message of the exception a callable throws (empty if it does not throw)
+template <typename Callable>
+static std::string thrown_message(const Callable& callable) {
+    try {
+        callable();
+    } catch (const std::exception& error) {
+        return error.what();
+    }
+    return {};
+}
+
+/// Number of entries of a directory
+static std::size_t count_entries(const std::filesystem::path& directory) {
+    return static_cast<std::size_t>(std::distance(
+        std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()
+    ));
+}
+
+/// Scratch directory of one test, emptied on construction and removed on destruction
+class ScratchDirectory {
+public:
+    explicit ScratchDirectory(const std::string& name)
+        : path_{std::filesystem::temp_directory_path() / name} {
+        std::filesystem::remove_all(this->path_);
+        std::filesystem::create_directories(this->path_);
+    }
+    ~ScratchDirectory() { std::filesystem::remove_all(this->path_); }
+
+    const std::filesystem::path& GetPath() const { return path_; }
+
+private:
+    std::filesystem::path path_;
+};
+
+/// Memory budget small enough to spread a test mesh over many buckets and ranges
+constexpr std::size_t kTinyBudget{4096};
+
+/// Default options with another memory budget
+static OutOfCoreOptions with_budget(std::size_t memory_budget) {
+    OutOfCoreOptions options;
+    options.memory_budget = memory_budget;
+    return options;
+}
+
+//---------------------------------------------------------------------------
+// Equivalence with the in-memory analysis
+//---------------------------------------------------------------------------
+
+TEST(OutOfCoreAnalysis, ComponentsMatchInMemoryMesh) {
+    const std::vector<Triangle> triangles{make_shuffled_mesh()};
+    const std::string stl{to_ascii_stl(triangles)};
+    const TriangleMesh mesh(parse_ascii_stl(std::string_view{stl}));
+    const MeshAnalysis expected(mesh);
+
+    for (const std::size_t budget : {kTinyBudget, OutOfCoreOptions{}.memory_budget}) {
+        const OutOfCoreAnalysis analysis{analyze(stl, with_budget(budget))};
+        EXPECT_EQ(analysis.GetNumTriangles(), triangles.size());
+        EXPECT_EQ(analysis.GetNumBuckets() > 1, budget == kTinyBudget);
+        ASSERT_EQ(find_connected_components(analysis), expected.GetComponents());
+
+        for (std::size_t k = 0; k < analysis.GetNumComponents(); ++k) {
+            EXPECT_EQ(analysis.IsClosed(k), expected.IsClosed(k)) << k;
+            EXPECT_EQ(analysis.GetComponentSize(k), expected.GetComponents()[k].size());
+            const auto& box{analysis.GetComponentAabbs()[k]};
+            const auto& expected_box{expected.GetComponentAabbs()[k]};
+            EXPECT_EQ(box.min_x, expected_box.min_x);
+            EXPECT_EQ(box.min_y, expected_box.min_y);
+            EXPECT_EQ(box.min_z, expected_box.min_z);
+            EXPECT_EQ(box.max_x, expected_box.max_x);
+            EXPECT_EQ(box.max_y, expected_box.max_y);
+            EXPECT_EQ(box.max_z, expected_box.max_z);
+        }
+        EXPECT_EQ(analysis.GetComponent(7), expected.GetComponents()[7]);
+    }
+}
+
+TEST(OutOfCoreAnalysis, RepartitionsBeyondTheScratchFileCap) {
+    // 256 buckets and 256 ranges of the tiny budget hold about 19k edges and 9k triangles: this
+    // mesh needs both re-partitioned
+    std::vector<Triangle> triangles{make_shuffled_mesh()};
+    append_grid(triangles, 80, -10.);
+    const std::string stl{to_binary_stl(triangles)};
+    const TriangleMesh mesh(parse_binary_stl(std::string_view{stl}));
+    const MeshAnalysis expected(mesh);
+
+    const OutOfCoreAnalysis analysis{analyze(stl, with_budget(kTinyBudget))};
+    EXPECT_GT(analysis.GetNumBuckets(), 256u);
+    ASSERT_EQ(find_connected_components(analysis), expected.GetComponents());
+    for (std::size_t k = 0; k < analysis.GetNumComponents(); ++k) {
+        EXPECT_EQ(analysis.IsClosed(k), expected.IsClosed(k)) << k;
+    }
+}
+
+TEST(OutOfCoreAnalysis, VoidExportMatchesInMemoryExport) {
+    const std::vector<Triangle> triangles{make_shuffled_mesh()};
+
+    // Binary input -> float-rounded coordinates, parsed the same way by both
+    for (const StlFormat input_format : {StlFormat::kAscii, StlFormat::kBinary}) {
+        const bool is_binary{input_format == StlFormat::kBinary};
+        const std::string stl{is_binary ? to_binary_stl(triangles) : to_ascii_stl(triangles)};
+        const TriangleMesh mesh(
+            is_binary ? parse_binary_stl(std::string_view{stl})
+                      : parse_ascii_stl(std::string_view{stl})
+        );
+        const OutOfCoreAnalysis analysis{analyze(stl, with_budget(kTinyBudget))};
+        EXPECT_EQ(find_void_components(analysis).size(), 216u);
+
+        for (const StlFormat format : {StlFormat::kAscii, StlFormat::kBinary}) {
+            std::ostringstream expected(std::ios::binary);
+            export_voids_to_stl(mesh, expected, format);
+            std::ostringstream actual(std::ios::binary);
+            PipelineStats stats;
+            export_voids_to_stl(analysis, actual, format, &stats);
+            EXPECT_EQ(actual.str(), expected.str());
+            if (kStatsEnabled) {
+                EXPECT_EQ(stats.num_voids, 216u);
+                EXPECT_EQ(stats.triangles_exported, 216u * 12u);
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------
+// Validation and scratch files
+//---------------------------------------------------------------------------
+
+TEST(OutOfCoreAnalysis, RejectsInvalidMeshesLikeTriangleMesh) {
+    const ScratchDirectory scratch{"tsexam_out_of_core_invalid"};
+    const OutOfCoreOptions options{
+        .scratch_directory = scratch.GetPath().string(), .memory_budget = kTinyBudget
+    };
+
+    // Degenerate triangle far past the first read chunk: the index is global
+    std::vector<Triangle> degenerate{make_shuffled_mesh()};
+    degenerate[1000].c = degenerate[1000].a;
+
+    // A third triangle on an edge of the outer cube
+    std::vector<Triangle> non_manifold{make_shuffled_mesh()};
+    non_manifold.push_back({{0., 0., 0.}, {64., 0., 0.}, {32., -5., 0.}});
+
+    for (const auto& triangles : {std::vector<Triangle>{}, degenerate, non_manifold}) {
+        const std::string expected{thrown_message([&] { const TriangleMesh mesh(triangles); })};
+        ASSERT_FALSE(expected.empty());
+        EXPECT_EQ(thrown_message([&] { analyze(to_ascii_stl(triangles), options); }), expected);
+        EXPECT_EQ(count_entries(scratch.GetPath()), 0u);  // scratch files removed
+    }
+    EXPECT_THROW(OutOfCoreAnalysis("missing_out_of_core.stl"), std::invalid_argument);
+}
+
+TEST(OutOfCoreAnalysis, ReadsFilesAndRemovesScratchDirectory) {
+    const ScratchDirectory scratch{"tsexam_out_of_core_files"};
+    const std::filesystem::path stl_path{scratch.GetPath() / "mesh.stl"};
+    std::vector<Triangle> triangles;
+    append_cube(triangles, {0., 0., 0.}, 4.);
+    append_cube(triangles, {1., 1., 1.}, 1.);
+    {
+        std::ofstream file(stl_path, std::ios::binary);
+        file << to_binary_stl(triangles);
+    }
+
+    const TriangleMesh mesh(triangles);
+
+    const std::filesystem::path work{scratch.GetPath() / "work"};
+    std::filesystem::create_directories(work);
+    {
+        const OutOfCoreAnalysis analysis(stl_path.string(), {.scratch_directory = work.string()});
+        EXPECT_EQ(count_entries(work), 1u);
+        EXPECT_EQ(find_connected_components(analysis), find_connected_components(mesh));
+        EXPECT_EQ(find_void_components(analysis), (std::vector<std::size_t>{1}));
+    }
+    EXPECT_EQ(count_entries(work), 0u);
+}
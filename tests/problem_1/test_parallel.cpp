@@ -0,0 +1,53 @@
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "common/parallel.hpp"
+
+using tsexam::common::parallel_for;
+using tsexam::common::resolve_thread_count;
+
+//---------------------------------------------------------------------------
+// resolve_thread_count
+//---------------------------------------------------------------------------
+
+TEST(ResolveThreadCount, ZeroMeansHardwareConcurrency) {
+    EXPECT_GE(resolve_thread_count(0), 1u);
+    EXPECT_EQ(resolve_thread_count(3), 3u);
+}
+
+//---------------------------------------------------------------------------
+// parallel_for
+//---------------------------------------------------------------------------
+
+TEST(ParallelFor, RunsEveryTaskExactlyOnce) {
+    const std::size_t num_tasks = 1000;
+    std::vector<std::atomic<int>> runs(num_tasks);
+    parallel_for(num_tasks, 4, [&](std::size_t i) { runs[i].fetch_add(1); });
+    for (std::size_t i = 0; i < num_tasks; ++i) {
+        EXPECT_EQ(runs[i].load(), 1) << "task " << i;
+    }
+}
+
+TEST(ParallelFor, ZeroTasksIsNoOp) {
+    bool called = false;
+    parallel_for(0, 4, [&](std::size_t) { called = true; });
+    EXPECT_FALSE(called);
+}
+
+TEST(ParallelFor, RethrowsTaskException) {
+    EXPECT_THROW(
+        parallel_for(
+            100, 4,
+            [](std::size_t i) {
+                if (i == 42) {
+                    throw std::runtime_error("task failed");
+                }
+            }
+        ),
+        std::runtime_error
+    );
+}
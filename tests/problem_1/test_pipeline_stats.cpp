@@ -0,0 +1,211 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "problem_1/geometry.hpp"
+#include "problem_1/pipeline_stats.hpp"
+#include "problem_1/stl_io.hpp"
+#include "problem_1/triangle_mesh.hpp"
+#include "problem_1/void_detection.hpp"
+
+#include "mesh_fixtures.hpp"
+
+using tsexam::problem1::AabbContainmentIndex;
+using tsexam::problem1::AxisAlignedBoundingBox;
+using tsexam::problem1::ConnectedComponent;
+using tsexam::problem1::ConnectivityEngine;
+using tsexam::problem1::export_voids_to_stl;
+using tsexam::problem1::find_connected_components;
+using tsexam::problem1::identify_voids;
+using tsexam::problem1::kStatsEnabled;
+using tsexam::problem1::PipelineStats;
+using tsexam::problem1::Point;
+using tsexam::problem1::ScopedStageTimer;
+using tsexam::problem1::Triangle;
+using tsexam::problem1::TriangleMesh;
+using tsexam::problem1::TriangleMeshOptions;
+using tsexam::problem1::VoidClassification;
+using tsexam::problem1::write_binary_stl;
+using tsexam::tests::append_cube;
+using tsexam::tests::make_cube_with_void;
+
+//---------------------------------------------------------------------------
+// Helpers
+//---------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------
+// ScopedStageTimer
+//---------------------------------------------------------------------------
+
+TEST(ScopedStageTimer, NullSinkIsIgnored) {
+    // Must not dereference the null sink
+    const ScopedStageTimer timer(nullptr, &PipelineStats::parse_time);
+    SUCCEED();
+}
+
+TEST(ScopedStageTimer, AccumulatesIntoSelectedStage) {
+    if (!kStatsEnabled) {
+        GTEST_SKIP() << "built with TSEXAM_ENABLE_STATS=0";
+    }
+    PipelineStats stats;
+    {
+        const ScopedStageTimer timer(&stats, &PipelineStats::export_time);
+        std::ostringstream sink;
+        for (int i = 0; i < 1000; ++i) {
+            sink << i;
+        }
+    }
+    EXPECT_GT(stats.export_time.count(), 0);
+    EXPECT_EQ(stats.parse_time.count(), 0);
+}
+
+//---------------------------------------------------------------------------
+// TriangleMesh load stages
+//---------------------------------------------------------------------------
+
+TEST(PipelineStatsLoad, HashMapEngineRecordsStagesAndMapFigures) {
+    if (!kStatsEnabled) {
+        GTEST_SKIP() << "built with TSEXAM_ENABLE_STATS=0";
+    }
+    PipelineStats stats;
+    TriangleMeshOptions options;
+    options.stats = &stats;
+    const TriangleMesh mesh(make_cube_with_void(), options);
+
+    // 2 cubes x 18 edges; the map is reserved up front, so the build never rehashes
+    EXPECT_EQ(stats.edge_map_size, 36u);
+    EXPECT_GE(stats.edge_map_bucket_count, stats.edge_map_size);
+    EXPECT_GT(stats.edge_map_load_factor, 0.);
+    EXPECT_LE(stats.edge_map_load_factor, 1.);
+    EXPECT_EQ(stats.edge_map_rehash_count, 0u);
+
+    // No parsing for in-memory triangles, no welding for the coordinate engine
+    EXPECT_EQ(stats.bytes_parsed, 0u);
+    EXPECT_EQ(stats.triangles_parsed, 0u);
+    EXPECT_EQ(stats.vertices_welded, 0u);
+    EXPECT_GT(stats.connectivity_time.count(), 0);
+    EXPECT_GT(stats.neighbor_table_time.count(), 0);
+}
+
+TEST(PipelineStatsLoad, IndexedEnginesRecordWelding) {
+    if (!kStatsEnabled) {
+        GTEST_SKIP() << "built with TSEXAM_ENABLE_STATS=0";
+    }
+    for (const ConnectivityEngine engine :
+         {ConnectivityEngine::kIndexedHashMap, ConnectivityEngine::kSortedEdges}) {
+        PipelineStats stats;
+        const TriangleMesh mesh(make_cube_with_void(), TriangleMeshOptions{engine, 0, &stats});
+        EXPECT_EQ(stats.vertices_welded, 16u);
+        EXPECT_GT(stats.welding_time.count(), 0);
+        EXPECT_GT(stats.connectivity_time.count(), 0);
+        if (engine == ConnectivityEngine::kIndexedHashMap) {
+            EXPECT_EQ(stats.edge_map_size, 36u);
+        } else {
+            EXPECT_EQ(stats.edge_map_size, 0u);  // no hash map in the sorted engine
+        }
+    }
+}
+
+TEST(PipelineStatsLoad, FileLoadersRecordParsedBytesAndTriangles) {
+    if (!kStatsEnabled) {
+        GTEST_SKIP() << "built with TSEXAM_ENABLE_STATS=0";
+    }
+    const std::vector<Triangle> triangles{make_cube_with_void()};
+    const std::filesystem::path path{
+        std::filesystem::temp_directory_path() / "pipeline_stats_cube_with_void.stl"
+    };
+    {
+        std::ofstream out(path, std::ios::binary);
+        write_binary_stl(out, "cube_with_void", triangles);
+    }
+
+    PipelineStats path_stats;
+    const TriangleMesh from_path(path.string(), TriangleMeshOptions{{}, 0, &path_stats});
+    EXPECT_EQ(path_stats.bytes_parsed, 84u + 50u * triangles.size());
+    EXPECT_EQ(path_stats.triangles_parsed, triangles.size());
+    EXPECT_GT(path_stats.parse_time.count(), 0);
+
+    PipelineStats mapped_stats;
+    const TriangleMesh mapped{
+        TriangleMesh::FromMappedFile(path.string(), TriangleMeshOptions{{}, 0, &mapped_stats})
+    };
+    EXPECT_EQ(mapped_stats.bytes_parsed, path_stats.bytes_parsed);
+    EXPECT_EQ(mapped_stats.triangles_parsed, triangles.size());
+    EXPECT_EQ(mapped_stats.edge_map_size, 36u);
+
+    std::filesystem::remove(path);
+}
+
+//---------------------------------------------------------------------------
+// Void detection
+//---------------------------------------------------------------------------
+
+TEST(PipelineStatsVoids, ExportRecordsComponentsVoidsAndTests) {
+    if (!kStatsEnabled) {
+        GTEST_SKIP() << "built with TSEXAM_ENABLE_STATS=0";
+    }
+    const TriangleMesh mesh(make_cube_with_void());
+    PipelineStats stats;
+    std::ostringstream out;
+    export_voids_to_stl(mesh, out, tsexam::problem1::StlFormat::kAscii, &stats);
+
+    EXPECT_EQ(stats.num_components, 2u);
+    EXPECT_EQ(stats.num_closed_components, 2u);
+    EXPECT_EQ(stats.num_voids, 1u);
+    EXPECT_EQ(stats.triangles_exported, 12u);
+    EXPECT_GE(stats.aabb_tests, 1u);
+    EXPECT_EQ(stats.point_in_solid_tests, 0u);
+    EXPECT_GT(stats.void_identification_time.count(), 0);
+    EXPECT_GT(stats.export_time.count(), 0);
+}
+
+TEST(PipelineStatsVoids, PointInSolidQueriesAreCounted) {
+    if (!kStatsEnabled) {
+        GTEST_SKIP() << "built with TSEXAM_ENABLE_STATS=0";
+    }
+    const TriangleMesh mesh(make_cube_with_void());
+    const std::vector<ConnectedComponent> closed{find_connected_components(mesh)};
+    PipelineStats stats;
+    const auto voids{identify_voids(mesh, closed, VoidClassification::kPointInSolid, &stats)};
+    EXPECT_EQ(voids.size(), 1u);
+    EXPECT_EQ(stats.num_voids, 1u);
+    EXPECT_EQ(stats.point_in_solid_tests, 1u);
+}
+
+TEST(PipelineStatsVoids, CountersAccumulateAcrossCalls) {
+    if (!kStatsEnabled) {
+        GTEST_SKIP() << "built with TSEXAM_ENABLE_STATS=0";
+    }
+    const TriangleMesh mesh(make_cube_with_void());
+    PipelineStats stats;
+    for (int run = 0; run < 3; ++run) {
+        std::ostringstream out;
+        export_voids_to_stl(mesh, out, tsexam::problem1::StlFormat::kAscii, &stats);
+    }
+    EXPECT_EQ(stats.num_components, 6u);
+    EXPECT_EQ(stats.num_voids, 3u);
+    EXPECT_EQ(stats.triangles_exported, 36u);
+}
+
+TEST(AabbContainmentIndex, CountsBoxTestsWhenAsked) {
+    // Box 0 contains boxes 1 and 2; box 3 is disjoint
+    const AabbContainmentIndex index({
+        AxisAlignedBoundingBox(0., 0., 0., 10., 10., 10.),
+        AxisAlignedBoundingBox(1., 1., 1., 2., 2., 2.),
+        AxisAlignedBoundingBox(3., 3., 3., 4., 4., 4.),
+        AxisAlignedBoundingBox(20., 20., 20., 21., 21., 21.),
+    });
+    std::size_t num_tests{0};
+    EXPECT_TRUE(index.HasContainer(1, 1e-12, &num_tests));
+    EXPECT_GE(num_tests, 1u);
+
+    const std::size_t before{num_tests};
+    EXPECT_FALSE(index.HasContainer(0, 1e-12, &num_tests));
+    EXPECT_EQ(index.FindContainers(2, 1e-12, &num_tests), (std::vector<std::size_t>{0}));
+    EXPECT_GE(num_tests, before + 1);
+}
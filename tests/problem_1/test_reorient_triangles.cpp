@@ -3,6 +3,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 #if defined(_WIN32)
 #include <windows.h>
@@ -18,16 +19,23 @@
 #include "problem_1/triangle_mesh.hpp"
 
 using tsexam::problem1::are_orientations_consistent;
+using tsexam::problem1::ConnectivityEngine;
+using tsexam::problem1::detect_stl_format;
 using tsexam::problem1::Edge;
+using tsexam::problem1::kBoundaryTriangleIndex;
 using tsexam::problem1::flip_triangle;
 using tsexam::problem1::has_directed_edge;
 using tsexam::problem1::make_edge;
 using tsexam::problem1::parse_ascii_stl;
+using tsexam::problem1::parse_binary_stl;
 using tsexam::problem1::Point;
 using tsexam::problem1::PointEquality;
+using tsexam::problem1::reorient_all_components;
 using tsexam::problem1::reorient_inconsistent_triangles;
+using tsexam::problem1::StlFormat;
 using tsexam::problem1::Triangle;
 using tsexam::problem1::TriangleMesh;
+using tsexam::problem1::TriangleMeshOptions;
 
 //---------------------------------------------------------------------------
 // Helpers
@@ -433,6 +441,24 @@ TEST(ExportInconsistentTriangles, WritesValidStlToStreamAndReadsItBack) {
     expect_point_eq(triangles[0].c, {0., 1., 0.});
 }
 
+TEST(ExportInconsistentTriangles, WritesBinaryStlOnRequest) {
+    const std::vector<Triangle> triangles{
+        {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}},
+        {{1, 0, 0}, {0, 1, 0}, {1, 1, 0}},
+    };
+    TriangleMesh mesh(triangles);
+    std::ostringstream out(std::ios::binary);
+    export_inconsistent_triangles(mesh, 0, out, StlFormat::kBinary);
+
+    const std::string bytes = out.str();
+    ASSERT_EQ(detect_stl_format(std::string_view{bytes}), StlFormat::kBinary);
+    const auto exported = parse_binary_stl(std::string_view{bytes});
+    ASSERT_EQ(exported.size(), 1u);
+    expect_point_eq(exported[0].a, {1., 0., 0.});
+    expect_point_eq(exported[0].b, {1., 1., 0.});
+    expect_point_eq(exported[0].c, {0., 1., 0.});
+}
+
 //---------------------------------------------------------------------------
 // Stress tests — time and space
 //---------------------------------------------------------------------------
@@ -703,3 +729,113 @@ TEST(ReorientTrianglePerformanceTest, FiveDisconnectedComponents_OnlySeedCompone
         }
     }
 }
+
+TEST(ReorientInconsistentTriangles, IndexedEnginesMatchCoordinateEngine) {
+    const std::string stl = make_stl_grid_inconsistent(10, 8);
+    TriangleMesh coordinate_mesh(parse_ascii_stl(std::string_view{stl}));
+    const auto expected = reorient_inconsistent_triangles(coordinate_mesh, 0);
+
+    const auto engines = {
+        ConnectivityEngine::kIndexedHashMap, ConnectivityEngine::kSortedEdges,
+        ConnectivityEngine::kNeighborTable
+    };
+    for (const auto engine : engines) {
+        TriangleMesh mesh(parse_ascii_stl(std::string_view{stl}), TriangleMeshOptions{engine});
+        const auto flipped = reorient_inconsistent_triangles(mesh, 0);
+        ASSERT_EQ(flipped.size(), expected.size());
+        for (std::size_t i = 0; i < flipped.size(); ++i) {
+            expect_point_eq(flipped[i].a, expected[i].a);
+            expect_point_eq(flipped[i].b, expected[i].b);
+            expect_point_eq(flipped[i].c, expected[i].c);
+        }
+    }
+}
+
+//---------------------------------------------------------------------------
+// reorient_all_components
+//---------------------------------------------------------------------------
+
+/// Every pair of triangles sharing an edge traverses it in opposite directions
+static void expect_consistently_oriented(const TriangleMesh& mesh) {
+    const auto& triangles = mesh.GetTriangles();
+    const auto& neighbors = mesh.GetTriangleNeighbors();
+    for (std::size_t i = 0; i < triangles.size(); ++i) {
+        const Triangle& t = triangles[i];
+        const Point* corners[3] = {&t.a, &t.b, &t.c};
+        for (std::size_t e = 0; e < 3; ++e) {
+            if (neighbors[i][e] == kBoundaryTriangleIndex) {
+                continue;
+            }
+            const Edge edge = make_edge(*corners[e], *corners[(e + 1) % 3]);
+            EXPECT_TRUE(are_orientations_consistent(
+                t, triangles[static_cast<std::size_t>(neighbors[i][e])], edge
+            )) << "triangle " << i << ", edge " << e;
+        }
+    }
+}
+
+TEST(ReorientAllComponents, InconsistentGridFlipsEveryOtherTriangleInPlace) {
+    // Every shared edge of the stacked strips joins a first-of-quad and a second-of-quad
+    // triangle, so keeping triangle 0 means flipping exactly the second triangle of every quad
+    const std::size_t rows = 10;
+    const std::size_t cols = 8;
+    TriangleMesh mesh = make_mesh_from_stl(make_stl_grid_inconsistent(rows, cols));
+
+    const auto flipped = reorient_all_components(mesh, 4);
+    ASSERT_EQ(flipped.size(), rows * cols);
+    for (std::size_t k = 0; k < flipped.size(); ++k) {
+        EXPECT_EQ(flipped[k], static_cast<int>(2 * k + 1));
+    }
+    expect_consistently_oriented(mesh);
+}
+
+TEST(ReorientAllComponents, ConsistentGridIsUnchanged) {
+    TriangleMesh mesh = make_mesh_from_stl(make_stl_grid_consistent(6, 5));
+    const auto before = mesh.GetTriangles();
+    EXPECT_TRUE(reorient_all_components(mesh, 4).empty());
+    for (std::size_t i = 0; i < before.size(); ++i) {
+        expect_point_eq(mesh.GetTriangles()[i].b, before[i].b);
+        expect_point_eq(mesh.GetTriangles()[i].c, before[i].c);
+    }
+}
+
+TEST(ReorientAllComponents, EveryComponentIsReorientedIndependently) {
+    // Three disconnected inconsistent strips; each keeps the orientation of its first triangle
+    std::ostringstream combined;
+    combined << "solid three\n";
+    combined << make_stl_strip_facets_at_y(20, 0.0);
+    combined << make_stl_strip_facets_at_y(5, 10.0);
+    combined << make_stl_strip_facets_at_y(50, 20.0);
+    combined << "endsolid three\n";
+    TriangleMesh mesh = make_mesh_from_stl(combined.str());
+    const auto original = mesh.GetTriangles();
+
+    const auto flipped = reorient_all_components(mesh, 4);
+    EXPECT_EQ(flipped.size(), 20u + 5u + 50u);
+    expect_consistently_oriented(mesh);
+
+    // Seed of every component is untouched
+    for (const std::size_t seed : {std::size_t{0}, std::size_t{40}, std::size_t{50}}) {
+        expect_point_eq(mesh.GetTriangles()[seed].b, original[seed].b);
+        expect_point_eq(mesh.GetTriangles()[seed].c, original[seed].c);
+    }
+
+    // Already consistent -> second pass flips nothing
+    EXPECT_TRUE(reorient_all_components(mesh, 4).empty());
+}
+
+TEST(ReorientAllComponents, IndexedEnginesGiveSameFlips) {
+    const std::string stl = make_stl_grid_inconsistent(7, 9);
+    TriangleMesh coordinate_mesh(parse_ascii_stl(std::string_view{stl}));
+    const auto expected = reorient_all_components(coordinate_mesh, 1);
+
+    const auto engines = {
+        ConnectivityEngine::kIndexedHashMap, ConnectivityEngine::kSortedEdges,
+        ConnectivityEngine::kNeighborTable
+    };
+    for (const auto engine : engines) {
+        TriangleMesh mesh(parse_ascii_stl(std::string_view{stl}), TriangleMeshOptions{engine});
+        EXPECT_EQ(reorient_all_components(mesh, 4), expected);
+        expect_consistently_oriented(mesh);
+    }
+}
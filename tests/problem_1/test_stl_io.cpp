@@ -1,18 +1,33 @@
+#include <cmath>
 #include <cstdint>
 #include <cstring>
 #include <fstream>
+#include <iterator>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include "problem_1/stl_io.hpp"
 
 using tsexam::problem1::convert_binary_stl_to_ascii;
+using tsexam::problem1::detect_stl_format;
 using tsexam::problem1::parse_ascii_stl;
+using tsexam::problem1::parse_binary_stl;
+using tsexam::problem1::parse_binary_stl_float;
 using tsexam::problem1::Point;
+using tsexam::problem1::StlFormat;
+using tsexam::problem1::StlReader;
+using tsexam::problem1::StlWriter;
 using tsexam::problem1::Triangle;
+using tsexam::problem1::triangle_cast;
+using tsexam::problem1::TriangleF;
 using tsexam::problem1::write_ascii_stl;
+using tsexam::problem1::write_binary_stl;
+using tsexam::problem1::write_triangle_in_ascii_stl;
 
 //---------------------------------------------------------------------------
 // Helpers
@@ -462,3 +477,458 @@ TEST(ConvertBinaryStlToAscii, TwoTrianglesRoundTrip) {
     expect_point_eq(triangles[1].b, {0., 1., 1.});
     expect_point_eq(triangles[1].c, {1., 0., 1.});
 }
+
+//---------------------------------------------------------------------------
+// Parse binary STL
+//---------------------------------------------------------------------------
+
+TEST(ParseBinaryStl, TwoTrianglesDecodedDirectly) {
+    const std::string binary_path = "binary_parse_two_triangles.stl";
+    const float verts[18] = {
+        0.f,  0.f,   0.f,    // triangle 0, vertex 0
+        1.5f, 0.f,   0.f,    // triangle 0, vertex 1
+        0.f,  2.25f, 0.f,    // triangle 0, vertex 2
+        -1.f, 0.f,   1.f,    // triangle 1, vertex 0
+        0.f,  1.f,   1.f,    // triangle 1, vertex 1
+        1.f,  0.f,   -3.5f,  // triangle 1, vertex 2
+    };
+    write_minimal_binary_stl(binary_path, 2u, verts);
+
+    std::ifstream in(binary_path, std::ios::binary);
+    auto triangles = parse_binary_stl(in);
+    ASSERT_EQ(triangles.size(), 2u);
+    expect_point_eq(triangles[0].a, {0., 0., 0.});
+    expect_point_eq(triangles[0].b, {1.5, 0., 0.});
+    expect_point_eq(triangles[0].c, {0., 2.25, 0.});
+    expect_point_eq(triangles[1].a, {-1., 0., 1.});
+    expect_point_eq(triangles[1].b, {0., 1., 1.});
+    expect_point_eq(triangles[1].c, {1., 0., -3.5});
+}
+
+TEST(ParseBinaryStl, MatchesAsciiConversion) {
+    // Coordinates that are exact in float and printed exactly by the ASCII conversion -> both
+    // loading paths must agree
+    const std::string binary_path = "binary_parse_vs_ascii.stl";
+    const std::string ascii_path = "ascii_parse_vs_binary.stl";
+    const float verts[9] = {0.5f, 0.25f, 0.125f, 1.f, 2.f, 3.f, -4.f, 5.5f, 6.f};
+    write_minimal_binary_stl(binary_path, 1u, verts);
+    convert_binary_stl_to_ascii(binary_path, ascii_path);
+
+    std::ifstream binary_in(binary_path, std::ios::binary);
+    std::ifstream ascii_in(ascii_path);
+    auto from_binary = parse_binary_stl(binary_in);
+    auto from_ascii = parse_ascii_stl(ascii_in);
+    ASSERT_EQ(from_binary.size(), 1u);
+    ASSERT_EQ(from_ascii.size(), 1u);
+    expect_point_eq(from_binary[0].a, from_ascii[0].a);
+    expect_point_eq(from_binary[0].b, from_ascii[0].b);
+    expect_point_eq(from_binary[0].c, from_ascii[0].c);
+}
+
+TEST(ParseBinaryStl, ZeroTrianglesReturnsEmpty) {
+    const std::string binary_path = "binary_parse_zero_triangles.stl";
+    write_minimal_binary_stl(binary_path, 0u, nullptr);
+
+    std::ifstream in(binary_path, std::ios::binary);
+    EXPECT_TRUE(parse_binary_stl(in).empty());
+}
+
+TEST(ParseBinaryStl, MissingHeaderThrows) {
+    std::istringstream in(std::string(40, '\0'));
+    EXPECT_THROW(parse_binary_stl(in), std::runtime_error);
+}
+
+TEST(ParseBinaryStl, TruncatedRecordsThrow) {
+    // Header announces 2 triangles but only one record follows
+    const std::string binary_path = "binary_parse_truncated.stl";
+    const float verts[9] = {0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 0.f};
+    write_minimal_binary_stl(binary_path, 1u, verts);
+    {
+        std::fstream f(binary_path, std::ios::binary | std::ios::in | std::ios::out);
+        const std::uint32_t announced = 2;
+        f.seekp(80);
+        f.write(reinterpret_cast<const char*>(&announced), sizeof(announced));
+    }
+
+    std::ifstream in(binary_path, std::ios::binary);
+    EXPECT_THROW(parse_binary_stl(in), std::runtime_error);
+}
+
+//---------------------------------------------------------------------------
+// Detect STL format
+//---------------------------------------------------------------------------
+
+TEST(DetectStlFormat, AsciiTextIsAscii) {
+    std::istringstream in(
+        "solid one\n facet normal 0 0 1\n  outer loop\n   vertex 0 0 0\n   vertex 1 0 0\n"
+        "   vertex 0 1 0\n  endloop\n endfacet\nendsolid one\n"
+    );
+    EXPECT_EQ(detect_stl_format(in), StlFormat::kAscii);
+    EXPECT_EQ(in.tellg(), 0);  // read position restored
+    EXPECT_EQ(parse_ascii_stl(in).size(), 1u);
+}
+
+TEST(DetectStlFormat, ShortInputIsAscii) {
+    std::istringstream in("solid empty\nendsolid empty\n");
+    EXPECT_EQ(detect_stl_format(in), StlFormat::kAscii);
+}
+
+TEST(DetectStlFormat, BinaryFileIsBinary) {
+    const std::string binary_path = "binary_detect.stl";
+    const float verts[9] = {0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 0.f};
+    write_minimal_binary_stl(binary_path, 1u, verts);
+
+    std::ifstream in(binary_path, std::ios::binary);
+    EXPECT_EQ(detect_stl_format(in), StlFormat::kBinary);
+    EXPECT_EQ(parse_binary_stl(in).size(), 1u);  // read position restored
+}
+
+TEST(DetectStlFormat, BinaryWithSolidHeaderIsBinary) {
+    // Some exporters start the binary header with "solid"; the size check must win
+    const std::string binary_path = "binary_detect_solid_header.stl";
+    const float verts[9] = {0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 0.f};
+    write_minimal_binary_stl(binary_path, 1u, verts);
+    {
+        std::fstream f(binary_path, std::ios::binary | std::ios::in | std::ios::out);
+        f.write("solid exported", 14);
+    }
+
+    std::ifstream in(binary_path, std::ios::binary);
+    EXPECT_EQ(detect_stl_format(in), StlFormat::kBinary);
+}
+
+//---------------------------------------------------------------------------
+// In-memory (memory-mapped) parsing
+//---------------------------------------------------------------------------
+
+TEST(ParseAsciiStlInMemory, MatchesStreamParser) {
+    const std::string stl = R"(
+        solid two
+          facet normal 0 0 1
+            outer loop
+              vertex 0.0 0.0 0.0
+              vertex 1.5e0 -2.25 3
+              vertex 0.0 1.0 0.0
+            endloop
+          endfacet
+          facet normal 0 0 1
+            outer loop
+              vertex 4 5 6
+              vertex 7 8 9
+              vertex 10 11 12
+            endloop
+          endfacet
+        endsolid two)";
+
+    auto from_stream = parse(stl);
+    auto from_memory = parse_ascii_stl(std::string_view{stl});
+    ASSERT_EQ(from_memory.size(), from_stream.size());
+    for (std::size_t i = 0; i < from_memory.size(); ++i) {
+        expect_point_eq(from_memory[i].a, from_stream[i].a);
+        expect_point_eq(from_memory[i].b, from_stream[i].b);
+        expect_point_eq(from_memory[i].c, from_stream[i].c);
+    }
+}
+
+TEST(ParseAsciiStlInMemory, LastTokenWithoutTrailingWhitespace) {
+    // The view ends right after the last coordinate -> the number must not be read past the end
+    const std::string stl{"vertex 0 0 0 vertex 1 0 0 vertex 0 1 0.5"};
+    auto triangles = parse_ascii_stl(std::string_view{stl}.substr(0, stl.size()));
+    ASSERT_EQ(triangles.size(), 1u);
+    expect_point_eq(triangles[0].c, {0., 1., 0.5});
+}
+
+TEST(ParseAsciiStlInMemory, MalformedNumberStopsParsing) {
+    const std::string stl{
+        "vertex 0 0 0 vertex 1 0 0 vertex 0 1 0 vertex 1 x 0 vertex 2 0 0 vertex 0 2 0 "
+        "vertex 3 0 0 vertex 0 3 0 vertex 3 3 0"
+    };
+    EXPECT_EQ(parse_ascii_stl(std::string_view{stl}).size(), 1u);
+    EXPECT_EQ(parse(stl).size(), 1u);
+}
+
+TEST(ParseAsciiStl, TokensSpanningChunkBoundariesAreParsed) {
+    // More than one 64KB chunk of facets -> tokens straddle chunk boundaries
+    std::string stl{"solid big\n"};
+    const std::size_t num_triangles = 3000;
+    for (std::size_t i = 0; i < num_triangles; ++i) {
+        const std::string x = std::to_string(i) + ".125";
+        stl += "facet normal 0 0 1\n outer loop\n  vertex " + x + " 0 0\n  vertex " + x +
+               " 1 0\n  vertex " + x + " 0 1\n endloop\nendfacet\n";
+    }
+    stl += "endsolid big\n";
+    ASSERT_GT(stl.size(), std::size_t{1} << 16);
+
+    auto triangles = parse(stl);
+    ASSERT_EQ(triangles.size(), num_triangles);
+    for (std::size_t i = 0; i < num_triangles; ++i) {
+        EXPECT_DOUBLE_EQ(triangles[i].a[0], static_cast<double>(i) + 0.125);
+    }
+}
+
+TEST(ParseBinaryStlInMemory, DecodesRecordsInPlace) {
+    const std::string binary_path = "binary_in_memory.stl";
+    const float verts[9] = {0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 0.f};
+    write_minimal_binary_stl(binary_path, 1u, verts);
+
+    std::ifstream in(binary_path, std::ios::binary);
+    const std::string bytes{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    EXPECT_EQ(detect_stl_format(std::string_view{bytes}), StlFormat::kBinary);
+
+    auto triangles = parse_binary_stl(std::string_view{bytes});
+    ASSERT_EQ(triangles.size(), 1u);
+    expect_point_eq(triangles[0].b, {1., 0., 0.});
+
+    // Drop the last byte -> truncated
+    EXPECT_THROW(
+        parse_binary_stl(std::string_view{bytes}.substr(0, bytes.size() - 1)), std::runtime_error
+    );
+}
+
+TEST(ParseBinaryStlFloat, WidensToDoubleParserOutput) {
+    // Coordinates that need all float32 bits, plus signed zero and subnormal values
+    const std::vector<Triangle> source{
+        {{0.1, -2.5e-3, 3e7}, {-0., 1.17549435e-38, 1e-45}, {123456.789, -0.333333333, 7.}},
+        {{1., 2., 3.}, {4., 5., 6.}, {-7.25, 8.5, -9.125}},
+    };
+    std::ostringstream out(std::ios::binary);
+    write_binary_stl(out, "float", source);
+    const std::string bytes{out.str()};
+
+    const std::vector<Triangle> expected{parse_binary_stl(std::string_view{bytes})};
+    std::istringstream in(bytes, std::ios::binary);
+    for (const std::vector<TriangleF>& triangles :
+         {parse_binary_stl_float(std::string_view{bytes}), parse_binary_stl_float(in)}) {
+        ASSERT_EQ(triangles.size(), expected.size());
+        for (std::size_t i = 0; i < triangles.size(); ++i) {
+            const Triangle widened{triangle_cast<double>(triangles[i])};
+            EXPECT_EQ(widened.a, expected[i].a);
+            EXPECT_EQ(widened.b, expected[i].b);
+            EXPECT_EQ(widened.c, expected[i].c);
+        }
+    }
+    EXPECT_TRUE(std::signbit(parse_binary_stl_float(std::string_view{bytes})[0].b[0]));
+
+    EXPECT_THROW(
+        parse_binary_stl_float(std::string_view{bytes}.substr(0, bytes.size() - 1)),
+        std::runtime_error
+    );
+}
+
+//---------------------------------------------------------------------------
+// Parallel ASCII parsing
+//---------------------------------------------------------------------------
+
+/// ASCII STL with `num_triangles` facets whose coordinates exercise the number parser
+static std::string make_large_ascii_stl(std::size_t num_triangles) {
+    std::string stl{"solid large\n"};
+    for (std::size_t i = 0; i < num_triangles; ++i) {
+        const std::string x = std::to_string(static_cast<double>(i) * 0.1);
+        stl += "  facet normal 0 0 1\n    outer loop\n      vertex " + x + " -1.5e-3 +2\n" +
+               "      vertex " + x + " 1e300 0.1\n      vertex 3.14159265358979 " + x +
+               " -0\n    endloop\n  endfacet\n";
+    }
+    stl += "endsolid large\n";
+    return stl;
+}
+
+/// Check that two triangle lists are bit-identical
+static void expect_same_triangles(
+    const std::vector<Triangle>& actual, const std::vector<Triangle>& expected
+) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (std::size_t i = 0; i < actual.size(); ++i) {
+        EXPECT_EQ(actual[i].a, expected[i].a) << "triangle " << i;
+        EXPECT_EQ(actual[i].b, expected[i].b) << "triangle " << i;
+        EXPECT_EQ(actual[i].c, expected[i].c) << "triangle " << i;
+    }
+}
+
+TEST(ParseAsciiStlParallel, MatchesSerialParser) {
+    const std::string stl = make_large_ascii_stl(5000);
+    const auto serial = parse(stl);
+    ASSERT_EQ(serial.size(), 5000u);
+    for (std::size_t threads : {1u, 2u, 3u, 8u}) {
+        expect_same_triangles(parse_ascii_stl(std::string_view{stl}, threads), serial);
+    }
+}
+
+TEST(ParseAsciiStlParallel, MalformedNumberStopsLikeSerial) {
+    std::string stl = make_large_ascii_stl(4000);
+    // Corrupt a coordinate roughly in the middle of the text
+    const std::size_t position = stl.find("1e300", stl.size() / 2);
+    ASSERT_NE(position, std::string::npos);
+    stl.replace(position, 5, "1e3x0");
+
+    const auto serial = parse(stl);
+    ASSERT_LT(serial.size(), 4000u);
+    expect_same_triangles(parse_ascii_stl(std::string_view{stl}, 4), serial);
+}
+
+TEST(ParseAsciiStlParallel, FacetWithExtraVertexShiftsGroupingLikeSerial) {
+    // A facet with four vertices shifts the "every three vertices" grouping for the rest of the
+    // file -> the parallel parser must reproduce the serial grouping
+    std::string stl = make_large_ascii_stl(4000);
+    const std::size_t position = stl.find("endloop", stl.size() / 3);
+    ASSERT_NE(position, std::string::npos);
+    stl.insert(position, "vertex 9 9 9\n    ");
+
+    const auto serial = parse(stl);
+    expect_same_triangles(parse_ascii_stl(std::string_view{stl}, 4), serial);
+}
+
+//---------------------------------------------------------------------------
+// StlWriter / write_binary_stl
+//---------------------------------------------------------------------------
+
+/// Reference facet text produced with std::ostream formatting (the pre-to_chars writer)
+static std::string reference_ascii_facet(const Triangle& t) {
+    const double v1[3]{t.b[0] - t.a[0], t.b[1] - t.a[1], t.b[2] - t.a[2]};
+    const double v2[3]{t.c[0] - t.a[0], t.c[1] - t.a[1], t.c[2] - t.a[2]};
+    std::ostringstream out;
+    out << "  facet normal " << v1[1] * v2[2] - v1[2] * v2[1] << ' '
+        << v1[2] * v2[0] - v1[0] * v2[2] << ' ' << v1[0] * v2[1] - v1[1] * v2[0] << '\n';
+    out << "    outer loop\n";
+    for (const Point* p : {&t.a, &t.b, &t.c}) {
+        out << "      vertex " << (*p)[0] << ' ' << (*p)[1] << ' ' << (*p)[2] << '\n';
+    }
+    out << "    endloop\n";
+    out << "  endfacet\n";
+    return out.str();
+}
+
+TEST(StlWriter, AsciiTextMatchesStreamFormatting) {
+    const std::vector<Triangle> triangles{
+        {{0.1, 1. / 3., -0.0}, {123456789., 1e-7, 2.5e20}, {-4.75, 1e6, 999999.5}},
+        {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}},
+        {{-1e-300, 3.14159265358979, 100}, {7, 8, 9}, {1e15, -2, 0.000123456}},
+    };
+    std::string expected = "solid ref\n";
+    for (const Triangle& t : triangles) {
+        expected += reference_ascii_facet(t);
+    }
+    expected += "endsolid ref\n";
+
+    std::ostringstream out;
+    write_ascii_stl(out, "ref", triangles);
+    EXPECT_EQ(out.str(), expected);
+
+    std::ostringstream single;
+    write_triangle_in_ascii_stl(single, triangles[0]);
+    EXPECT_EQ(single.str(), reference_ascii_facet(triangles[0]));
+}
+
+TEST(StlWriter, LargeOutputIsFlushedCompletely) {
+    std::vector<Triangle> triangles;
+    for (int i = 0; i < 5000; ++i) {
+        const double x = static_cast<double>(i);
+        triangles.push_back({{x, 0, 0}, {x + 1, 0, 0}, {x, 1, 0}});
+    }
+    std::ostringstream out;
+    write_ascii_stl(out, "big", triangles);
+    expect_same_triangles(parse(out.str()), triangles);
+}
+
+TEST(WriteBinaryStl, RoundTripsThroughBinaryParser) {
+    const std::vector<Triangle> triangles{
+        {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}},
+        {{-2.5, 3, 0.125}, {4, -1, 2}, {0.5, 0.25, -8}},
+    };
+    std::ostringstream out(std::ios::binary);
+    write_binary_stl(out, "binary part", triangles);
+    const std::string bytes = out.str();
+
+    ASSERT_EQ(bytes.size(), 84u + 50u * triangles.size());
+    EXPECT_EQ(bytes.substr(0, 11), "binary part");
+    EXPECT_EQ(detect_stl_format(std::string_view{bytes}), StlFormat::kBinary);
+    expect_same_triangles(parse_binary_stl(std::string_view{bytes}), triangles);
+
+    // Unit normal of the first facet is +z
+    float normal_z = 0.f;
+    std::memcpy(&normal_z, bytes.data() + 84 + 8, sizeof(float));
+    EXPECT_FLOAT_EQ(normal_z, 1.f);
+}
+
+TEST(StlWriter, BinaryCountMismatchThrowsOnFinish) {
+    std::ostringstream out(std::ios::binary);
+    StlWriter writer(out, StlFormat::kBinary, "short", 2);
+    writer.Write({{0, 0, 0}, {1, 0, 0}, {0, 1, 0}});
+    EXPECT_THROW(writer.Finish(), std::logic_error);
+}
+
+TEST(StlWriter, FinishedByDestructor) {
+    std::ostringstream out;
+    {
+        StlWriter writer(out, StlFormat::kAscii, "scoped", 1);
+        writer.Write({{0, 0, 0}, {1, 0, 0}, {0, 1, 0}});
+    }
+    EXPECT_EQ(parse(out.str()).size(), 1u);
+    EXPECT_NE(out.str().find("endsolid scoped\n"), std::string::npos);
+}
+
+//---------------------------------------------------------------------------
+// StlReader (batched reading)
+//---------------------------------------------------------------------------
+
+/// Reads a whole stream with StlReader in batches of at most batch_size triangles
+static std::vector<Triangle> read_in_batches(std::istream& in, std::size_t batch_size) {
+    StlReader reader(in);
+    std::vector<Triangle> all;
+    std::vector<Triangle> batch;
+    while (const std::size_t count = reader.Read(batch, batch_size)) {
+        EXPECT_EQ(batch.size(), count);
+        EXPECT_LE(count, batch_size);
+        all.insert(all.end(), batch.begin(), batch.end());
+    }
+    EXPECT_EQ(reader.Read(batch, batch_size), 0u);  // stays exhausted
+    return all;
+}
+
+TEST(StlReader, AsciiBatchesConcatenateToParserOutput) {
+    const std::string stl = make_large_ascii_stl(5000);
+    const auto expected = parse(stl);
+    for (const std::size_t batch_size : {1u, 7u, 1000u, 5000u, 8000u}) {
+        std::istringstream in(stl);
+        expect_same_triangles(read_in_batches(in, batch_size), expected);
+    }
+}
+
+TEST(StlReader, BinaryBatchesConcatenateToParserOutput) {
+    const auto triangles = parse(make_large_ascii_stl(3000));
+    std::ostringstream out(std::ios::binary);
+    write_binary_stl(out, "batches", triangles);
+    const std::string bytes = out.str();
+    const auto expected = parse_binary_stl(std::string_view{bytes});
+    for (const std::size_t batch_size : {1u, 7u, 1000u, 3000u}) {
+        std::istringstream in(bytes, std::ios::binary);
+        {
+            const StlReader reader(in);
+            EXPECT_EQ(reader.GetFormat(), StlFormat::kBinary);
+        }
+        in.seekg(0);
+        expect_same_triangles(read_in_batches(in, batch_size), expected);
+    }
+}
+
+TEST(StlReader, TruncatedBinaryThrows) {
+    const std::string binary_path = "binary_reader_truncated.stl";
+    const float verts[9] = {0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 0.f};
+    write_minimal_binary_stl(binary_path, 1u, verts);
+    {
+        std::fstream f(binary_path, std::ios::binary | std::ios::in | std::ios::out);
+        const std::uint32_t announced = 2;
+        f.seekp(80);
+        f.write(reinterpret_cast<const char*>(&announced), sizeof(announced));
+    }
+
+    std::ifstream in(binary_path, std::ios::binary);
+    EXPECT_THROW(StlReader{in}, std::runtime_error);
+}
+
+TEST(StlReader, ZeroBatchSizeThrows) {
+    std::istringstream in("solid empty\nendsolid empty\n");
+    StlReader reader(in);
+    std::vector<Triangle> batch;
+    EXPECT_THROW(reader.Read(batch, 0), std::invalid_argument);
+    EXPECT_EQ(reader.Read(batch, 4), 0u);
+}
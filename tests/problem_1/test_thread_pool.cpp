@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "problem_1/thread_pool.hpp"
+
+using tsexam::problem1::ThreadPool;
+
+//---------------------------------------------------------------------------
+// ThreadPool
+//---------------------------------------------------------------------------
+
+TEST(ThreadPool, RunsEveryTaskExactlyOnce) {
+    const std::size_t num_tasks = 1000;
+    std::vector<std::atomic<int>> runs(num_tasks);
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.GetThreadCount(), 4u);
+    for (std::size_t i = 0; i < num_tasks; ++i) {
+        pool.Submit([&runs, i]() { runs[i].fetch_add(1); });
+    }
+    pool.Wait();
+    for (std::size_t i = 0; i < num_tasks; ++i) {
+        EXPECT_EQ(runs[i].load(), 1) << "task " << i;
+    }
+}
+
+TEST(ThreadPool, TasksSubmittedFromTasksAreWaitedFor) {
+    // A binary tree of tasks: every task but the leaves submits two children from its worker
+    std::atomic<std::size_t> num_runs{0};
+    ThreadPool pool(3);
+    std::function<void(int)> spawn = [&](int depth) {
+        num_runs.fetch_add(1);
+        if (depth > 0) {
+            pool.Submit([&spawn, depth]() { spawn(depth - 1); });
+            pool.Submit([&spawn, depth]() { spawn(depth - 1); });
+        }
+    };
+    pool.Submit([&spawn]() { spawn(10); });
+    pool.Wait();
+    EXPECT_EQ(num_runs.load(), (std::size_t{1} << 11) - 1);
+}
+
+TEST(ThreadPool, IdleWorkersStealFromBusyOnes) {
+    // All tasks are submitted from one worker -> they land in its deque, the others must steal
+    std::atomic<std::size_t> num_runs{0};
+    std::mutex threads_mutex;
+    std::vector<std::thread::id> threads;
+    ThreadPool pool(4);
+    pool.Submit([&]() {
+        for (int i = 0; i < 64; ++i) {
+            pool.Submit([&]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                const std::lock_guard<std::mutex> lock(threads_mutex);
+                threads.push_back(std::this_thread::get_id());
+                num_runs.fetch_add(1);
+            });
+        }
+    });
+    pool.Wait();
+    EXPECT_EQ(num_runs.load(), 64u);
+    std::sort(threads.begin(), threads.end());
+    const auto num_threads{std::unique(threads.begin(), threads.end()) - threads.begin()};
+    EXPECT_GT(num_threads, 1);
+}
+
+TEST(ThreadPool, WaitRethrowsFirstExceptionAndPoolStaysUsable) {
+    std::atomic<std::size_t> num_runs{0};
+    ThreadPool pool(2);
+    for (int i = 0; i < 50; ++i) {
+        pool.Submit([&num_runs, i]() {
+            num_runs.fetch_add(1);
+            if (i == 7) {
+                throw std::runtime_error("task failed");
+            }
+        });
+    }
+    EXPECT_THROW(pool.Wait(), std::runtime_error);
+    EXPECT_EQ(num_runs.load(), 50u);  // the other tasks still ran
+
+    pool.Submit([&num_runs]() { num_runs.fetch_add(1); });
+    EXPECT_NO_THROW(pool.Wait());
+    EXPECT_EQ(num_runs.load(), 51u);
+}
+
+TEST(ThreadPool, DestructorRunsPendingTasks) {
+    std::atomic<std::size_t> num_runs{0};
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 100; ++i) {
+            pool.Submit([&num_runs]() { num_runs.fetch_add(1); });
+        }
+    }
+    EXPECT_EQ(num_runs.load(), 100u);
+}
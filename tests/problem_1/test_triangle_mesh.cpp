@@ -1,30 +1,56 @@
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
 #include <fstream>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include "problem_1/geometry.hpp"
+#include "problem_1/stl_io.hpp"
 #include "problem_1/triangle_mesh.hpp"
+#include "problem_1/void_detection.hpp"
 
+using tsexam::problem1::ConnectivityEngine;
 using tsexam::problem1::Edge;
+using tsexam::problem1::find_connected_components;
+using tsexam::problem1::is_connected_component_closed;
 using tsexam::problem1::kBoundaryTriangleIndex;
 using tsexam::problem1::make_edge;
+using tsexam::problem1::make_edge_key;
 using tsexam::problem1::Point;
+using tsexam::problem1::PointF;
 using tsexam::problem1::Triangle;
+using tsexam::problem1::triangle_cast;
+using tsexam::problem1::TriangleF;
 using tsexam::problem1::TriangleMesh;
+using tsexam::problem1::TriangleMeshF;
+using tsexam::problem1::TriangleMeshOptions;
+using tsexam::problem1::write_binary_stl;
 
 //---------------------------------------------------------------------------
 // Helpers
 //---------------------------------------------------------------------------
 
-static const char* kTestStlPath = "triangle_mesh_test.stl";
+/// Path of a scratch file in the system temporary directory, so that runs leave the tree clean
+static std::string temp_stl_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+static const std::string kTestStlPath{temp_stl_path("triangle_mesh_test.stl")};
 
 /// Build a TriangleMesh from in-memory STL content (writes to a temp file)
 static TriangleMesh make_mesh_from_stl(const std::string& stl_content) {
     std::ofstream f(kTestStlPath);
     if (!f) {
-        throw std::runtime_error("failed to open " + std::string(kTestStlPath) + " for writing");
+        throw std::runtime_error("failed to open " + kTestStlPath + " for writing");
     }
     f << stl_content;
     f.close();
@@ -171,6 +197,102 @@ TEST(TriangleMeshConstructor, ValidManifoldTwoTrianglesSucceeds) {
     });
 }
 
+//---------------------------------------------------------------------------
+// Constructor — binary STL and in-memory triangles
+//---------------------------------------------------------------------------
+
+TEST(TriangleMeshConstructor, BinaryStlLoadsWithoutConversion) {
+    // Two triangles forming a unit square (z = 0), written as binary STL
+    const std::string path{temp_stl_path("triangle_mesh_test_binary.stl")};
+    {
+        std::ofstream f(path, std::ios::binary);
+        ASSERT_TRUE(f) << "failed to create " << path;
+        char header[80] = {};
+        f.write(header, 80);
+        const std::uint32_t num_triangles = 2;
+        f.write(reinterpret_cast<const char*>(&num_triangles), sizeof(num_triangles));
+        const float records[2][12] = {
+            {0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 1.f, 1.f, 0.f},
+            {0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 1.f, 0.f, 0.f, 1.f, 0.f},
+        };
+        const std::uint16_t attribute = 0;
+        for (const auto& record : records) {
+            f.write(reinterpret_cast<const char*>(record), sizeof(record));
+            f.write(reinterpret_cast<const char*>(&attribute), sizeof(attribute));
+        }
+    }
+
+    TriangleMesh mesh(path);
+    const auto& triangles = mesh.GetTriangles();
+    ASSERT_EQ(triangles.size(), 2u);
+    expect_point_eq(triangles[0].a, {0., 0., 0.});
+    expect_point_eq(triangles[0].b, {1., 0., 0.});
+    expect_point_eq(triangles[0].c, {1., 1., 0.});
+    expect_point_eq(triangles[1].c, {0., 1., 0.});
+    EXPECT_EQ(mesh.GetEdgeConnectivity().size(), 5u);  // four boundary edges + one diagonal
+    std::remove(path.c_str());
+}
+
+TEST(TriangleMeshConstructor, FromTrianglesBuildsConnectivity) {
+    std::vector<Triangle> triangles{
+        {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}},
+        {{0, 0, 0}, {1, 1, 0}, {0, 1, 0}},
+    };
+    TriangleMesh mesh(std::move(triangles));
+    EXPECT_EQ(mesh.GetTriangles().size(), 2u);
+
+    const auto it = mesh.GetEdgeConnectivity().find(make_edge({0, 0, 0}, {1, 1, 0}));
+    ASSERT_NE(it, mesh.GetEdgeConnectivity().end());
+    EXPECT_EQ(it->second[0], 0);  // first triangle
+    EXPECT_EQ(it->second[1], 1);  // second triangle
+}
+
+TEST(TriangleMeshConstructor, FromTrianglesValidatesInput) {
+    EXPECT_THROW({ TriangleMesh mesh(std::vector<Triangle>{}); }, std::invalid_argument);
+    EXPECT_THROW(
+        { TriangleMesh mesh(std::vector<Triangle>{{{0, 0, 0}, {1, 0, 0}, {2, 0, 0}}}); },
+        std::invalid_argument
+    );
+}
+
+TEST(TriangleMeshFromMappedFile, MatchesPathConstructor) {
+    const std::string stl = R"(
+        solid two_tri
+        facet normal 0 0 1
+            outer loop
+            vertex 0 0 0
+            vertex 1 0 0
+            vertex 1 1 0
+            endloop
+        endfacet
+        facet normal 0 0 1
+            outer loop
+            vertex 0 0 0
+            vertex 1 1 0
+            vertex 0 1 0
+            endloop
+        endfacet
+        endsolid two_tri
+    )";
+
+    TriangleMesh from_stream = make_mesh_from_stl(stl);
+    TriangleMesh from_mapping = TriangleMesh::FromMappedFile(kTestStlPath);
+    ASSERT_EQ(from_mapping.GetTriangles().size(), from_stream.GetTriangles().size());
+    for (std::size_t i = 0; i < from_mapping.GetTriangles().size(); ++i) {
+        expect_point_eq(from_mapping.GetTriangles()[i].a, from_stream.GetTriangles()[i].a);
+        expect_point_eq(from_mapping.GetTriangles()[i].b, from_stream.GetTriangles()[i].b);
+        expect_point_eq(from_mapping.GetTriangles()[i].c, from_stream.GetTriangles()[i].c);
+    }
+    EXPECT_EQ(from_mapping.GetEdgeConnectivity().size(), 5u);
+}
+
+TEST(TriangleMeshFromMappedFile, NonexistentPathThrows) {
+    EXPECT_THROW(
+        { TriangleMesh::FromMappedFile("nonexistent_file_that_does_not_exist.stl"); },
+        std::runtime_error
+    );
+}
+
 //---------------------------------------------------------------------------
 // GetTriangles
 //---------------------------------------------------------------------------
@@ -379,3 +501,681 @@ TEST(TriangleMeshEdgeConnectivity, TwoTrianglesBoundaryEdgesHaveBoundaryIndex) {
     EXPECT_EQ(it->second[0], 0);                       // triangle index 0
     EXPECT_EQ(it->second[1], kBoundaryTriangleIndex);  // boundary index
 }
+
+//---------------------------------------------------------------------------
+// Indexed connectivity engine
+//---------------------------------------------------------------------------
+
+/// Closed, consistently oriented unit cube (12 triangles, 8 shared vertices)
+static std::vector<Triangle> make_unit_cube() {
+    const Point p000{0, 0, 0}, p100{1, 0, 0}, p110{1, 1, 0}, p010{0, 1, 0};
+    const Point p001{0, 0, 1}, p101{1, 0, 1}, p111{1, 1, 1}, p011{0, 1, 1};
+    return {
+        {p000, p110, p100}, {p000, p010, p110},  // z = 0
+        {p001, p101, p111}, {p001, p111, p011},  // z = 1
+        {p000, p100, p101}, {p000, p101, p001},  // y = 0
+        {p010, p111, p110}, {p010, p011, p111},  // y = 1
+        {p000, p001, p011}, {p000, p011, p010},  // x = 0
+        {p100, p110, p111}, {p100, p111, p101},  // x = 1
+    };
+}
+
+TEST(TriangleMeshIndexedEngine, WeldsSharedVertices) {
+    const TriangleMesh mesh(make_unit_cube(), {ConnectivityEngine::kIndexedHashMap});
+    EXPECT_EQ(mesh.GetConnectivityEngine(), ConnectivityEngine::kIndexedHashMap);
+    EXPECT_EQ(mesh.GetVertices().size(), 8u);
+    EXPECT_EQ(mesh.GetIndexedEdgeConnectivity().size(), 18u);  // 12 cube edges + 6 diagonals
+    EXPECT_TRUE(mesh.GetEdgeConnectivity().empty());
+
+    // Every triangle's vertex indices map back to its original points
+    const auto& triangles = mesh.GetTriangles();
+    const auto& vertices = mesh.GetVertices();
+    const auto& triangle_vertices = mesh.GetTriangleVertices();
+    ASSERT_EQ(triangle_vertices.size(), triangles.size());
+    for (std::size_t i = 0; i < triangles.size(); ++i) {
+        expect_point_eq(vertices[triangle_vertices[i][0]], triangles[i].a);
+        expect_point_eq(vertices[triangle_vertices[i][1]], triangles[i].b);
+        expect_point_eq(vertices[triangle_vertices[i][2]], triangles[i].c);
+    }
+}
+
+TEST(TriangleMeshIndexedEngine, EdgeTrianglesMatchCoordinateEngine) {
+    const TriangleMesh coordinate_mesh(make_unit_cube());
+    const TriangleMesh indexed_mesh(make_unit_cube(), {ConnectivityEngine::kIndexedHashMap});
+    for (std::size_t i = 0; i < coordinate_mesh.GetTriangles().size(); ++i) {
+        for (std::size_t local_edge = 0; local_edge < 3; ++local_edge) {
+            EXPECT_EQ(
+                indexed_mesh.GetEdgeTriangles(i, local_edge),
+                coordinate_mesh.GetEdgeTriangles(i, local_edge)
+            );
+        }
+    }
+}
+
+TEST(TriangleMeshIndexedEngine, BoundaryEdgesReportBoundaryIndex) {
+    std::vector<Triangle> triangles{
+        {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}},
+        {{0, 0, 0}, {1, 1, 0}, {0, 1, 0}},
+    };
+    const TriangleMesh mesh(std::move(triangles), {ConnectivityEngine::kIndexedHashMap});
+    EXPECT_EQ(mesh.GetVertices().size(), 4u);
+    EXPECT_EQ(mesh.GetIndexedEdgeConnectivity().size(), 5u);
+
+    // Local edge 0 of triangle 0 is (0,0,0)-(1,0,0), a boundary edge
+    const auto boundary = mesh.GetEdgeTriangles(0, 0);
+    EXPECT_EQ(boundary[0], 0);
+    EXPECT_EQ(boundary[1], kBoundaryTriangleIndex);
+
+    // Local edge 2 of triangle 0 is the shared diagonal (1,1,0)-(0,0,0)
+    const auto shared = mesh.GetEdgeTriangles(0, 2);
+    EXPECT_EQ(shared[0], 0);
+    EXPECT_EQ(shared[1], 1);
+}
+
+TEST(TriangleMeshIndexedEngine, NonManifoldEdgeThrows) {
+    std::vector<Triangle> triangles{
+        {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}},
+        {{0, 0, 0}, {1, 0, 0}, {0, -1, 0}},
+        {{0, 0, 0}, {1, 0, 0}, {0, 0, 1}},
+    };
+    EXPECT_THROW(
+        { TriangleMesh mesh(std::move(triangles), {ConnectivityEngine::kIndexedHashMap}); },
+        std::invalid_argument
+    );
+}
+
+//---------------------------------------------------------------------------
+// Sorted edge connectivity engine
+//---------------------------------------------------------------------------
+
+/// Consistently oriented nrows x ncols grid of unit quads in the z = 0 plane, 2 triangles each
+static std::vector<Triangle> make_grid(std::size_t nrows, std::size_t ncols) {
+    std::vector<Triangle> triangles;
+    for (std::size_t i = 0; i < nrows; ++i) {
+        for (std::size_t j = 0; j < ncols; ++j) {
+            const double x0{static_cast<double>(j)}, x1{x0 + 1.};
+            const double y0{static_cast<double>(i)}, y1{y0 + 1.};
+            triangles.push_back({{x0, y0, 0}, {x1, y0, 0}, {x1, y1, 0}});
+            triangles.push_back({{x0, y0, 0}, {x1, y1, 0}, {x0, y1, 0}});
+        }
+    }
+    return triangles;
+}
+
+TEST(TriangleMeshSortedEngine, BuildsUniqueSortedEdges) {
+    const TriangleMesh mesh(make_unit_cube(), {ConnectivityEngine::kSortedEdges});
+    EXPECT_EQ(mesh.GetConnectivityEngine(), ConnectivityEngine::kSortedEdges);
+    EXPECT_EQ(mesh.GetVertices().size(), 8u);
+    EXPECT_TRUE(mesh.GetEdgeConnectivity().empty());
+    EXPECT_TRUE(mesh.GetIndexedEdgeConnectivity().empty());
+
+    const auto& keys = mesh.GetSortedEdgeKeys();
+    ASSERT_EQ(keys.size(), 18u);  // 12 cube edges + 6 diagonals
+    ASSERT_EQ(mesh.GetSortedEdgeTriangles().size(), keys.size());
+    for (std::size_t i = 1; i < keys.size(); ++i) {
+        EXPECT_LT(keys[i - 1], keys[i]);
+    }
+
+    // Closed cube -> every edge has two triangles
+    for (const auto& triangles : mesh.GetSortedEdgeTriangles()) {
+        EXPECT_NE(triangles[0], kBoundaryTriangleIndex);
+        EXPECT_NE(triangles[1], kBoundaryTriangleIndex);
+    }
+}
+
+TEST(TriangleMeshSortedEngine, EdgeTrianglesMatchHashMapEngines) {
+    // 40 x 30 grid -> more than 256 vertices, so the radix sort needs several passes
+    const TriangleMesh coordinate_mesh(make_grid(40, 30));
+    const TriangleMesh indexed_mesh(make_grid(40, 30), {ConnectivityEngine::kIndexedHashMap});
+    const TriangleMesh sorted_mesh(make_grid(40, 30), {ConnectivityEngine::kSortedEdges});
+    ASSERT_EQ(
+        sorted_mesh.GetSortedEdgeKeys().size(), indexed_mesh.GetIndexedEdgeConnectivity().size()
+    );
+
+    for (std::size_t i = 0; i < coordinate_mesh.GetTriangles().size(); ++i) {
+        for (std::size_t local_edge = 0; local_edge < 3; ++local_edge) {
+            EXPECT_EQ(
+                sorted_mesh.GetEdgeTriangles(i, local_edge),
+                coordinate_mesh.GetEdgeTriangles(i, local_edge)
+            );
+        }
+    }
+
+    // Key lookup agrees with the indexed hash map for every edge
+    for (const auto& [key, triangles] : indexed_mesh.GetIndexedEdgeConnectivity()) {
+        EXPECT_EQ(sorted_mesh.FindEdgeTriangles(key), triangles);
+        EXPECT_EQ(indexed_mesh.FindEdgeTriangles(key), triangles);
+    }
+}
+
+TEST(TriangleMeshSortedEngine, UnknownEdgeLookupReturnsBoundaryIndices) {
+    const TriangleMesh mesh(make_unit_cube(), {ConnectivityEngine::kSortedEdges});
+    const auto unknown = mesh.FindEdgeTriangles(make_edge_key(100, 200));
+    EXPECT_EQ(unknown[0], kBoundaryTriangleIndex);
+    EXPECT_EQ(unknown[1], kBoundaryTriangleIndex);
+}
+
+TEST(TriangleMeshSortedEngine, BoundaryEdgesReportBoundaryIndex) {
+    const TriangleMesh mesh(make_grid(1, 1), {ConnectivityEngine::kSortedEdges});
+    EXPECT_EQ(mesh.GetSortedEdgeKeys().size(), 5u);
+
+    // Local edge 0 of triangle 0 is (0,0,0)-(1,0,0), a boundary edge
+    const auto boundary = mesh.GetEdgeTriangles(0, 0);
+    EXPECT_EQ(boundary[0], 0);
+    EXPECT_EQ(boundary[1], kBoundaryTriangleIndex);
+
+    // Local edge 2 of triangle 0 is the shared diagonal (1,1,0)-(0,0,0)
+    const auto shared = mesh.GetEdgeTriangles(0, 2);
+    EXPECT_EQ(shared[0], 0);
+    EXPECT_EQ(shared[1], 1);
+}
+
+TEST(TriangleMeshSortedEngine, NonManifoldEdgeThrows) {
+    std::vector<Triangle> triangles{
+        {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}},
+        {{0, 0, 0}, {1, 0, 0}, {0, -1, 0}},
+        {{0, 0, 0}, {1, 0, 0}, {0, 0, 1}},
+    };
+    EXPECT_THROW(
+        { TriangleMesh mesh(std::move(triangles), {ConnectivityEngine::kSortedEdges}); },
+        std::invalid_argument
+    );
+}
+
+//---------------------------------------------------------------------------
+// Neighbor table connectivity engine
+//---------------------------------------------------------------------------
+
+TEST(TriangleMeshNeighborTableEngine, KeepsOnlyTheNeighborTable) {
+    const TriangleMesh mesh(make_unit_cube(), {ConnectivityEngine::kNeighborTable});
+    EXPECT_EQ(mesh.GetConnectivityEngine(), ConnectivityEngine::kNeighborTable);
+    EXPECT_EQ(mesh.GetTriangleNeighbors().size(), 12u);
+    EXPECT_TRUE(mesh.GetVertices().empty());
+    EXPECT_TRUE(mesh.GetTriangleVertices().empty());
+    EXPECT_TRUE(mesh.GetSortedEdgeKeys().empty());
+    EXPECT_TRUE(mesh.GetSortedEdgeTriangles().empty());
+    EXPECT_TRUE(mesh.GetEdgeConnectivity().empty());
+
+    // No vertex ids -> every key lookup is unknown
+    const auto unknown = mesh.FindEdgeTriangles(make_edge_key(0, 1));
+    EXPECT_EQ(unknown[0], kBoundaryTriangleIndex);
+    EXPECT_EQ(unknown[1], kBoundaryTriangleIndex);
+}
+
+TEST(TriangleMeshNeighborTableEngine, EdgeTrianglesMatchCoordinateEngine) {
+    const TriangleMesh coordinate_mesh(make_grid(40, 30));
+    const TriangleMesh table_mesh(make_grid(40, 30), {ConnectivityEngine::kNeighborTable});
+    EXPECT_EQ(table_mesh.GetTriangleNeighbors(), coordinate_mesh.GetTriangleNeighbors());
+    for (std::size_t i = 0; i < coordinate_mesh.GetTriangles().size(); ++i) {
+        for (std::size_t local_edge = 0; local_edge < 3; ++local_edge) {
+            EXPECT_EQ(
+                table_mesh.GetEdgeTriangles(i, local_edge),
+                coordinate_mesh.GetEdgeTriangles(i, local_edge)
+            );
+        }
+    }
+}
+
+TEST(TriangleMeshNeighborTableEngine, NonManifoldEdgeThrows) {
+    std::vector<Triangle> triangles{
+        {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}},
+        {{0, 0, 0}, {1, 0, 0}, {0, -1, 0}},
+        {{0, 0, 0}, {1, 0, 0}, {0, 0, 1}},
+    };
+    EXPECT_THROW(
+        { TriangleMesh mesh(std::move(triangles), {ConnectivityEngine::kNeighborTable}); },
+        std::invalid_argument
+    );
+}
+
+//---------------------------------------------------------------------------
+// Flat coordinate-keyed connectivity engine
+//---------------------------------------------------------------------------
+
+TEST(TriangleMeshFlatEdgeEngine, MatchesCoordinateHashMapEngine) {
+    const TriangleMesh coordinate_mesh(make_grid(40, 30));
+    const TriangleMesh flat_mesh(make_grid(40, 30), {ConnectivityEngine::kFlatEdgeHashMap});
+    EXPECT_EQ(flat_mesh.GetConnectivityEngine(), ConnectivityEngine::kFlatEdgeHashMap);
+    EXPECT_TRUE(flat_mesh.GetEdgeConnectivity().empty());
+    EXPECT_TRUE(flat_mesh.GetVertices().empty());
+
+    // Same entries as the node-based map
+    const auto& flat = flat_mesh.GetFlatEdgeConnectivity();
+    ASSERT_EQ(flat.size(), coordinate_mesh.GetEdgeConnectivity().size());
+    for (const auto& [edge, triangles] : coordinate_mesh.GetEdgeConnectivity()) {
+        const auto it = flat.find(edge);
+        ASSERT_NE(it, flat.end());
+        EXPECT_EQ(it->second, triangles);
+    }
+
+    EXPECT_EQ(flat_mesh.GetTriangleNeighbors(), coordinate_mesh.GetTriangleNeighbors());
+    for (std::size_t i = 0; i < coordinate_mesh.GetTriangles().size(); ++i) {
+        for (std::size_t local_edge = 0; local_edge < 3; ++local_edge) {
+            EXPECT_EQ(
+                flat_mesh.GetEdgeTriangles(i, local_edge),
+                coordinate_mesh.GetEdgeTriangles(i, local_edge)
+            );
+        }
+    }
+}
+
+TEST(TriangleMeshFlatEdgeEngine, SignedZerosShareAnEdge) {
+    // T1 spells the shared edge (0,0,0)-(1,0,0) with negative zeros
+    std::vector<Triangle> triangles{
+        {{0., 0., 0.}, {1., 0., 0.}, {0., 1., 0.}},
+        {{1., -0., -0.}, {-0., 0., -0.}, {0., -1., 0.}},
+    };
+    const TriangleMesh mesh(std::move(triangles), {ConnectivityEngine::kFlatEdgeHashMap});
+    EXPECT_EQ(mesh.GetFlatEdgeConnectivity().size(), 5u);
+    EXPECT_EQ(mesh.GetTriangleNeighbors()[0][0], 1);
+    EXPECT_EQ(mesh.GetTriangleNeighbors()[1][0], 0);
+}
+
+TEST(TriangleMeshFlatEdgeEngine, NonManifoldEdgeThrows) {
+    std::vector<Triangle> triangles{
+        {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}},
+        {{0, 0, 0}, {1, 0, 0}, {0, -1, 0}},
+        {{0, 0, 0}, {1, 0, 0}, {0, 0, 1}},
+    };
+    EXPECT_THROW(
+        { TriangleMesh mesh(std::move(triangles), {ConnectivityEngine::kFlatEdgeHashMap}); },
+        std::invalid_argument
+    );
+}
+
+TEST(TriangleMeshFlatEdgeEngine, ComponentsMatchCoordinateHashMapEngine) {
+    // Closed cube plus an open grid above it
+    std::vector<Triangle> triangles{make_unit_cube()};
+    for (Triangle triangle : make_grid(4, 3)) {
+        triangle.a[2] = triangle.b[2] = triangle.c[2] = 5.;
+        triangles.push_back(triangle);
+    }
+    const TriangleMesh coordinate_mesh(triangles);
+    const TriangleMesh flat_mesh(triangles, {ConnectivityEngine::kFlatEdgeHashMap});
+
+    const auto expected = find_connected_components(coordinate_mesh);
+    const auto components = find_connected_components(flat_mesh);
+    ASSERT_EQ(components.size(), 2u);
+    ASSERT_EQ(components, expected);
+    EXPECT_TRUE(is_connected_component_closed(flat_mesh, components[0]));
+    EXPECT_FALSE(is_connected_component_closed(flat_mesh, components[1]));
+}
+
+//---------------------------------------------------------------------------
+// Triangle neighbor table
+//---------------------------------------------------------------------------
+
+TEST(TriangleMeshNeighbors, TwoTrianglesShareDiagonal) {
+    const TriangleMesh mesh(make_grid(1, 1));
+    const auto& neighbors = mesh.GetTriangleNeighbors();
+    ASSERT_EQ(neighbors.size(), 2u);
+
+    // T0 = (0,0)-(1,0)-(1,1): edges a-b and b-c are open, c-a is the diagonal shared with T1
+    EXPECT_EQ(neighbors[0][0], kBoundaryTriangleIndex);
+    EXPECT_EQ(neighbors[0][1], kBoundaryTriangleIndex);
+    EXPECT_EQ(neighbors[0][2], 1);
+
+    // T1 = (0,0)-(1,1)-(0,1): edge a-b is the diagonal shared with T0
+    EXPECT_EQ(neighbors[1][0], 0);
+    EXPECT_EQ(neighbors[1][1], kBoundaryTriangleIndex);
+    EXPECT_EQ(neighbors[1][2], kBoundaryTriangleIndex);
+}
+
+TEST(TriangleMeshNeighbors, ClosedCubeHasNoBoundaryAndIsSymmetric) {
+    for (const auto engine :
+         {ConnectivityEngine::kEdgeHashMap, ConnectivityEngine::kIndexedHashMap,
+          ConnectivityEngine::kSortedEdges, ConnectivityEngine::kNeighborTable,
+          ConnectivityEngine::kFlatEdgeHashMap}) {
+        const TriangleMesh mesh(make_unit_cube(), {engine});
+        const auto& neighbors = mesh.GetTriangleNeighbors();
+        ASSERT_EQ(neighbors.size(), 12u);
+        for (std::size_t i = 0; i < neighbors.size(); ++i) {
+            for (const auto neighbor : neighbors[i]) {
+                ASSERT_NE(neighbor, kBoundaryTriangleIndex);
+                const auto& back = neighbors[static_cast<std::size_t>(neighbor)];
+                EXPECT_NE(std::find(back.begin(), back.end(), static_cast<int>(i)), back.end());
+            }
+        }
+    }
+}
+
+TEST(TriangleMeshNeighbors, MatchesEdgeTrianglesOnGrid) {
+    const TriangleMesh mesh(make_grid(12, 9), {ConnectivityEngine::kSortedEdges});
+    const auto& neighbors = mesh.GetTriangleNeighbors();
+    for (std::size_t i = 0; i < neighbors.size(); ++i) {
+        for (std::size_t local_edge = 0; local_edge < 3; ++local_edge) {
+            const auto degree_of_edge = mesh.GetEdgeTriangles(i, local_edge);
+            const auto expected =
+                (degree_of_edge[0] == static_cast<int>(i)) ? degree_of_edge[1] : degree_of_edge[0];
+            EXPECT_EQ(neighbors[i][local_edge], expected);
+        }
+    }
+}
+
+TEST(TriangleMeshNeighbors, FlipTriangleKeepsDerivedDataInStep) {
+    for (const auto engine :
+         {ConnectivityEngine::kEdgeHashMap, ConnectivityEngine::kIndexedHashMap,
+          ConnectivityEngine::kSortedEdges, ConnectivityEngine::kNeighborTable,
+          ConnectivityEngine::kFlatEdgeHashMap}) {
+        TriangleMesh mesh(make_grid(3, 3), {engine});
+        mesh.FlipTriangle(4);
+        mesh.FlipTriangle(9);
+
+        const Triangle& flipped = mesh.GetTriangles()[4];
+        expect_point_eq(flipped.b, {3, 1, 0});  // was c
+        expect_point_eq(flipped.c, {3, 0, 0});  // was b
+
+        const auto& neighbors = mesh.GetTriangleNeighbors();
+        for (std::size_t i = 0; i < neighbors.size(); ++i) {
+            for (std::size_t local_edge = 0; local_edge < 3; ++local_edge) {
+                const auto degree_of_edge = mesh.GetEdgeTriangles(i, local_edge);
+                const auto expected = (degree_of_edge[0] == static_cast<int>(i))
+                                          ? degree_of_edge[1]
+                                          : degree_of_edge[0];
+                EXPECT_EQ(neighbors[i][local_edge], expected);
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------
+// Float coordinates (TriangleMeshF)
+//---------------------------------------------------------------------------
+
+/// Float-sourced mesh: a grid and a separate closed cube at coordinates that use all float bits
+static std::vector<TriangleF> make_float_mesh() {
+    std::vector<Triangle> triangles{make_grid(7, 5)};
+    for (Triangle cube_triangle : make_unit_cube()) {
+        for (Point* p : {&cube_triangle.a, &cube_triangle.b, &cube_triangle.c}) {
+            *p = {(*p)[0] * 0.3 + 20.1, (*p)[1] * 0.3 - 1.7, (*p)[2] * 0.3};
+        }
+        triangles.push_back(cube_triangle);
+    }
+    std::vector<TriangleF> float_triangles;
+    for (const Triangle& triangle : triangles) {
+        float_triangles.push_back(triangle_cast<float>(triangle));
+    }
+    return float_triangles;
+}
+
+/// Check that a float mesh has exactly the connectivity of a double mesh
+static void expect_same_connectivity(const TriangleMeshF& actual, const TriangleMesh& expected) {
+    ASSERT_EQ(actual.GetTriangles().size(), expected.GetTriangles().size());
+    for (std::size_t i = 0; i < actual.GetTriangles().size(); ++i) {
+        const Triangle widened{triangle_cast<double>(actual.GetTriangles()[i])};
+        EXPECT_EQ(widened.a, expected.GetTriangles()[i].a);
+        EXPECT_EQ(widened.b, expected.GetTriangles()[i].b);
+        EXPECT_EQ(widened.c, expected.GetTriangles()[i].c);
+        for (std::size_t local_edge = 0; local_edge < 3; ++local_edge) {
+            EXPECT_EQ(
+                actual.GetEdgeTriangles(i, local_edge), expected.GetEdgeTriangles(i, local_edge)
+            );
+        }
+    }
+    EXPECT_EQ(actual.GetTriangleNeighbors(), expected.GetTriangleNeighbors());
+    EXPECT_EQ(actual.GetEdgeConnectivity().size(), expected.GetEdgeConnectivity().size());
+    EXPECT_EQ(actual.GetTriangleVertices(), expected.GetTriangleVertices());
+    EXPECT_EQ(actual.GetSortedEdgeKeys(), expected.GetSortedEdgeKeys());
+    EXPECT_EQ(actual.GetSortedEdgeTriangles(), expected.GetSortedEdgeTriangles());
+    ASSERT_EQ(actual.GetVertices().size(), expected.GetVertices().size());
+    for (std::size_t v = 0; v < actual.GetVertices().size(); ++v) {
+        const PointF& p{actual.GetVertices()[v]};
+        EXPECT_EQ((Point{p[0], p[1], p[2]}), expected.GetVertices()[v]);
+    }
+
+    const auto components = find_connected_components(actual);
+    EXPECT_EQ(components, find_connected_components(expected));
+    EXPECT_EQ(find_connected_components(actual, 4), components);
+    for (const auto& component : components) {
+        EXPECT_EQ(
+            is_connected_component_closed(actual, component),
+            is_connected_component_closed(expected, component)
+        );
+    }
+}
+
+TEST(TriangleMeshFloat, HalvesTriangleMemory) {
+    static_assert(sizeof(TriangleF) == sizeof(Triangle) / 2);
+    static_assert(std::is_same_v<TriangleMeshF::TriangleType, TriangleF>);
+    const TriangleMeshF mesh(make_float_mesh());
+    EXPECT_EQ(mesh.GetTriangles().size(), 7u * 5u * 2u + 12u);
+}
+
+TEST(TriangleMeshFloat, ConnectivityMatchesWidenedDoubleMesh) {
+    const std::vector<TriangleF> float_triangles{make_float_mesh()};
+    std::vector<Triangle> widened;
+    for (const TriangleF& triangle : float_triangles) {
+        widened.push_back(triangle_cast<double>(triangle));
+    }
+
+    for (const auto engine :
+         {ConnectivityEngine::kEdgeHashMap, ConnectivityEngine::kIndexedHashMap,
+          ConnectivityEngine::kSortedEdges, ConnectivityEngine::kNeighborTable,
+          ConnectivityEngine::kFlatEdgeHashMap}) {
+        const TriangleMeshF float_mesh(float_triangles, {engine});
+        const TriangleMesh double_mesh(widened, {engine});
+        EXPECT_EQ(float_mesh.GetConnectivityEngine(), engine);
+        expect_same_connectivity(float_mesh, double_mesh);
+    }
+
+    // Coordinate edge lookups work with float edges
+    const TriangleMeshF float_mesh(float_triangles);
+    const TriangleF& t0{float_triangles[0]};
+    const auto it = float_mesh.GetEdgeConnectivity().find(make_edge<float>(t0.a, t0.c));
+    ASSERT_NE(it, float_mesh.GetEdgeConnectivity().end());
+    EXPECT_EQ(it->second[0], 0);
+    EXPECT_EQ(it->second[1], 1);
+}
+
+TEST(TriangleMeshFloat, BinaryStlLoadsLikeDoubleMesh) {
+    const std::string path{temp_stl_path("triangle_mesh_test_float.stl")};
+    std::vector<Triangle> widened;
+    for (const TriangleF& triangle : make_float_mesh()) {
+        widened.push_back(triangle_cast<double>(triangle));
+    }
+    {
+        std::ofstream f(path, std::ios::binary);
+        ASSERT_TRUE(f) << "failed to create " << path;
+        write_binary_stl(f, "float_mesh", widened);
+    }
+
+    for (const auto engine : {ConnectivityEngine::kEdgeHashMap, ConnectivityEngine::kSortedEdges}) {
+        const TriangleMesh expected(path, {engine});
+        expect_same_connectivity(TriangleMeshF(path, {engine}), expected);
+        expect_same_connectivity(TriangleMeshF::FromMappedFile(path, {engine}), expected);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(TriangleMeshFloat, ValidatesLikeDoubleMesh) {
+    std::vector<TriangleF> triangles{make_float_mesh()};
+    triangles[5].c = triangles[5].a;
+    try {
+        const TriangleMeshF mesh(triangles);
+        ADD_FAILURE() << "degenerate mesh was accepted";
+    } catch (const std::invalid_argument& e) {
+        EXPECT_EQ(std::string(e.what()), "degenerate triangle at index 5: duplicate vertices");
+    }
+
+    // Distinct double points can round to the same float point
+    EXPECT_THROW(
+        {
+            const TriangleMeshF mesh(std::vector<TriangleF>{
+                triangle_cast<float>(Triangle{{1., 0., 0.}, {1. + 1e-12, 0., 0.}, {0., 1., 0.}})
+            });
+        },
+        std::invalid_argument
+    );
+}
+
+//---------------------------------------------------------------------------
+// Memory resource
+//---------------------------------------------------------------------------
+
+namespace {
+
+/// Memory resource that counts the allocations it forwards to the new/delete resource
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t allocations{0};
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++this->allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+}  // namespace
+
+TEST(TriangleMeshMemoryResource, HashMapsAllocateFromGivenResource) {
+    const std::vector<Triangle> grid{make_grid(20, 30)};
+    for (const auto engine : {ConnectivityEngine::kEdgeHashMap, ConnectivityEngine::kIndexedHashMap,
+                              ConnectivityEngine::kSortedEdges,
+                              ConnectivityEngine::kFlatEdgeHashMap}) {
+        CountingResource counting;
+        TriangleMeshOptions options;
+        options.connectivity = engine;
+        options.memory_resource = &counting;
+        const TriangleMesh mesh(grid, options);
+        const TriangleMesh expected(grid, {engine});
+
+        EXPECT_GT(counting.allocations, 0u);
+        EXPECT_EQ(mesh.GetEdgeConnectivity().get_allocator().resource(), &counting);
+        EXPECT_EQ(mesh.GetIndexedEdgeConnectivity().get_allocator().resource(), &counting);
+        EXPECT_EQ(mesh.GetFlatEdgeConnectivity().get_allocator().resource(), &counting);
+        EXPECT_EQ(mesh.GetEdgeConnectivity().size(), expected.GetEdgeConnectivity().size());
+        EXPECT_EQ(
+            mesh.GetFlatEdgeConnectivity().size(), expected.GetFlatEdgeConnectivity().size()
+        );
+        EXPECT_EQ(
+            mesh.GetIndexedEdgeConnectivity().size(), expected.GetIndexedEdgeConnectivity().size()
+        );
+        EXPECT_EQ(mesh.GetTriangleVertices(), expected.GetTriangleVertices());
+        EXPECT_EQ(mesh.GetSortedEdgeKeys(), expected.GetSortedEdgeKeys());
+        EXPECT_EQ(mesh.GetTriangleNeighbors(), expected.GetTriangleNeighbors());
+    }
+}
+
+TEST(TriangleMeshMemoryResource, MonotonicArenaHoldsAllEdgeNodes) {
+    // Upstream sees only the arena's blocks, far fewer than the per-edge nodes
+    CountingResource counting;
+    std::pmr::monotonic_buffer_resource arena(&counting);
+    TriangleMeshOptions options;
+    options.memory_resource = &arena;
+    const TriangleMesh mesh(make_grid(40, 50), options);
+    EXPECT_GT(mesh.GetEdgeConnectivity().size(), 1000u);
+    EXPECT_LT(counting.allocations, 40u);
+}
+
+TEST(TriangleMeshMemoryResource, CopyRebuildsFromDefaultResource) {
+    CountingResource counting;
+    std::optional<TriangleMesh> copy;
+    {
+        std::pmr::monotonic_buffer_resource arena(&counting);
+        TriangleMeshOptions options;
+        options.memory_resource = &arena;
+        const TriangleMesh mesh(make_grid(10, 12), options);
+        copy.emplace(mesh);
+    }
+
+    // The arena is gone: the copy's builds must not reach it (nor its upstream)
+    const std::size_t allocations{counting.allocations};
+    EXPECT_EQ(copy->GetEdgeConnectivity().get_allocator().resource(),
+              std::pmr::get_default_resource());
+    copy->BuildIndexedRepresentation();
+    copy->BuildSortedEdgeToTriangleConnectivity();
+    EXPECT_EQ(counting.allocations, allocations);
+
+    const TriangleMesh expected(make_grid(10, 12), {ConnectivityEngine::kSortedEdges});
+    EXPECT_EQ(copy->GetSortedEdgeKeys(), expected.GetSortedEdgeKeys());
+    EXPECT_EQ(copy->GetTriangleNeighbors(), expected.GetTriangleNeighbors());
+}
+
+//---------------------------------------------------------------------------
+// Incremental edits
+//---------------------------------------------------------------------------
+
+/// Check that an edited mesh holds the connectivity of a mesh rebuilt from its triangles
+static void expect_same_as_rebuild(const TriangleMesh& mesh) {
+    const TriangleMesh rebuilt(mesh.GetTriangles());
+    const auto& edges = mesh.GetEdgeConnectivity();
+    ASSERT_EQ(edges.size(), rebuilt.GetEdgeConnectivity().size());
+    for (const auto& [edge, triangles] : rebuilt.GetEdgeConnectivity()) {
+        const auto it = edges.find(edge);
+        ASSERT_NE(it, edges.end());
+        EXPECT_EQ(it->second, triangles);
+    }
+    EXPECT_EQ(mesh.GetTriangleNeighbors(), rebuilt.GetTriangleNeighbors());
+}
+
+TEST(TriangleMeshEdits, InsertAndRemoveMatchRebuild) {
+    TriangleMesh mesh(make_grid(4, 5));
+    std::vector<Triangle> removed;
+
+    // Punch holes (first, middle and last indices), then put some triangles back
+    for (const std::size_t index : {0u, 17u, 37u, 5u, 11u}) {
+        removed.push_back(mesh.GetTriangles()[index]);
+        mesh.RemoveTriangle(index);
+        expect_same_as_rebuild(mesh);
+    }
+    EXPECT_EQ(mesh.GetTriangles().size(), 35u);
+    for (const Triangle& triangle : removed) {
+        const auto index = mesh.InsertTriangle(triangle);
+        EXPECT_EQ(static_cast<std::size_t>(index), mesh.GetTriangles().size() - 1);
+        expect_same_as_rebuild(mesh);
+    }
+
+    // A triangle detached from the grid is its own boundary component
+    mesh.InsertTriangle({{10, 10, 0}, {11, 10, 0}, {10, 11, 0}});
+    expect_same_as_rebuild(mesh);
+    EXPECT_EQ(find_connected_components(mesh).size(), 2u);
+}
+
+TEST(TriangleMeshEdits, FlipKeepsEditedConnectivity) {
+    TriangleMesh mesh(make_grid(3, 3));
+    mesh.RemoveTriangle(4);
+    mesh.FlipTriangle(4);  // the moved last triangle
+    mesh.InsertTriangle(make_grid(3, 3)[4]);
+    expect_same_as_rebuild(mesh);
+}
+
+TEST(TriangleMeshEdits, RejectedInsertLeavesMeshUnchanged) {
+    // Folding a triangle onto a boundary edge gives that edge its second triangle
+    TriangleMesh mesh(make_grid(2, 2));
+    mesh.InsertTriangle({{0, 0, 0}, {1, 0, 0}, {0, 0, 1}});  // fold on a boundary edge
+    const std::size_t num_edges = mesh.GetEdgeConnectivity().size();
+    const auto neighbors = mesh.GetTriangleNeighbors();
+
+    EXPECT_THROW(mesh.InsertTriangle({{0, 0, 0}, {1, 0, 0}, {0, -1, 0}}), std::invalid_argument);
+    EXPECT_THROW(mesh.InsertTriangle({{5, 5, 5}, {5, 5, 5}, {6, 5, 5}}), std::invalid_argument);
+    EXPECT_THROW(mesh.InsertTriangle({{5, 5, 5}, {6, 5, 5}, {7, 5, 5}}), std::invalid_argument);
+    EXPECT_EQ(mesh.GetTriangles().size(), 9u);
+    EXPECT_EQ(mesh.GetEdgeConnectivity().size(), num_edges);
+    EXPECT_EQ(mesh.GetTriangleNeighbors(), neighbors);
+}
+
+TEST(TriangleMeshEdits, RemoveRejectsBadIndexAndLastTriangle) {
+    TriangleMesh mesh(make_grid(1, 1));
+    EXPECT_THROW(mesh.RemoveTriangle(2), std::invalid_argument);
+    mesh.RemoveTriangle(0);
+    EXPECT_THROW(mesh.RemoveTriangle(0), std::invalid_argument);
+    EXPECT_EQ(mesh.GetTriangles().size(), 1u);
+    expect_same_as_rebuild(mesh);
+}
+
+TEST(TriangleMeshEdits, RequireEdgeHashMapEngine) {
+    for (const auto engine :
+         {ConnectivityEngine::kIndexedHashMap, ConnectivityEngine::kSortedEdges,
+          ConnectivityEngine::kNeighborTable, ConnectivityEngine::kFlatEdgeHashMap}) {
+        TriangleMesh mesh(make_grid(2, 2), {engine});
+        EXPECT_THROW(mesh.InsertTriangle({{5, 5, 5}, {6, 5, 5}, {5, 6, 5}}), std::logic_error);
+        EXPECT_THROW(mesh.RemoveTriangle(0), std::logic_error);
+    }
+}
@@ -0,0 +1,205 @@
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "problem_1/geometry.hpp"
+#include "problem_1/triangle_mesh.hpp"
+#include "problem_1/triangle_validation.hpp"
+
+using tsexam::problem1::classify_triangle;
+using tsexam::problem1::DegenerateTriangle;
+using tsexam::problem1::find_first_degenerate_triangle;
+using tsexam::problem1::Point;
+using tsexam::problem1::Triangle;
+using tsexam::problem1::TriangleDefect;
+using tsexam::problem1::TriangleMesh;
+using tsexam::problem1::TriangleMeshOptions;
+using tsexam::problem1::triangle_validation_kernel;
+using tsexam::problem1::validate_triangles;
+
+//---------------------------------------------------------------------------
+// Helpers
+//---------------------------------------------------------------------------
+
+/// Random, almost surely non-degenerate triangles with coordinates in [-100, 100]
+static std::vector<Triangle> make_random_triangles(std::size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coordinate(-100., 100.);
+    std::vector<Triangle> triangles(count);
+    for (Triangle& t : triangles) {
+        for (Point* p : {&t.a, &t.b, &t.c}) {
+            *p = {coordinate(rng), coordinate(rng), coordinate(rng)};
+        }
+    }
+    return triangles;
+}
+
+/// Index and defect of the first degenerate triangle, checked one triangle at a time
+static std::optional<DegenerateTriangle> find_first_sequentially(
+    const std::vector<Triangle>& triangles
+) {
+    for (std::size_t i = 0; i < triangles.size(); ++i) {
+        const TriangleDefect defect{classify_triangle(triangles[i])};
+        if (defect != TriangleDefect::kNone) {
+            return DegenerateTriangle{i, defect};
+        }
+    }
+    return std::nullopt;
+}
+
+/// Message of the exception thrown by `validate_triangles` (empty if it does not throw)
+static std::string validation_message(const std::vector<Triangle>& triangles) {
+    try {
+        validate_triangles(triangles);
+    } catch (const std::invalid_argument& e) {
+        return e.what();
+    }
+    return {};
+}
+
+//---------------------------------------------------------------------------
+// Single triangle classification
+//---------------------------------------------------------------------------
+
+TEST(TriangleValidation, ClassifiesSingleTriangles) {
+    const auto classify = [](const Triangle& triangle) { return classify_triangle(triangle); };
+    EXPECT_EQ(classify({{0, 0, 0}, {1, 0, 0}, {0, 1, 0}}), TriangleDefect::kNone);
+    EXPECT_EQ(classify({{0, 0, 0}, {0, 0, 0}, {0, 1, 0}}), TriangleDefect::kDuplicateVertices);
+    EXPECT_EQ(classify({{0, 0, 0}, {1, 0, 0}, {1, 0, 0}}), TriangleDefect::kDuplicateVertices);
+    EXPECT_EQ(classify({{0, 0, 0}, {1, 1, 1}, {2, 2, 2}}), TriangleDefect::kCollinearVertices);
+
+    // -0.0 == 0.0, so these vertices are duplicates
+    EXPECT_EQ(classify({{-0., 0, 0}, {0, -0., 0}, {0, 1, 0}}), TriangleDefect::kDuplicateVertices);
+
+    // NaN compares unequal and its area is not below the tolerance -> passes, as before
+    const double nan{std::numeric_limits<double>::quiet_NaN()};
+    EXPECT_EQ(classify({{nan, 0, 0}, {1, 0, 0}, {0, 1, 0}}), TriangleDefect::kNone);
+}
+
+//---------------------------------------------------------------------------
+// First degenerate triangle of a list
+//---------------------------------------------------------------------------
+
+TEST(TriangleValidation, ValidListHasNoDegenerateTriangle) {
+    EXPECT_FALSE(find_first_degenerate_triangle(std::span<const Triangle>{}).has_value());
+    const std::vector<Triangle> triangles{make_random_triangles(1000, 1)};
+    ASSERT_FALSE(find_first_sequentially(triangles).has_value());
+    EXPECT_FALSE(find_first_degenerate_triangle(triangles).has_value());
+    EXPECT_FALSE(find_first_degenerate_triangle(triangles, 4).has_value());
+}
+
+TEST(TriangleValidation, ReportsSmallestIndexForEveryPosition) {
+    // 1 to 2 blocks plus a partial kernel step -> every lane position and the padded tail
+    const Triangle duplicate{{1, 2, 3}, {1, 2, 3}, {4, 5, 6}};
+    const Triangle collinear{{0, 0, 0}, {1, 2, 3}, {2, 4, 6}};
+    for (const std::size_t count : {1u, 3u, 7u, 255u, 256u, 259u, 515u}) {
+        const std::vector<Triangle> valid{make_random_triangles(count, 2)};
+        for (std::size_t position = 0; position < count; ++position) {
+            std::vector<Triangle> triangles{valid};
+            triangles[position] = (position % 2 == 0) ? duplicate : collinear;
+            if (position + 1 < count) {
+                triangles[count - 1] = duplicate;  // later defect must not win
+            }
+            const auto found{find_first_degenerate_triangle(triangles)};
+            ASSERT_TRUE(found.has_value()) << count << " " << position;
+            EXPECT_EQ(found->index, position) << count;
+            EXPECT_EQ(
+                found->defect, (position % 2 == 0) ? TriangleDefect::kDuplicateVertices
+                                                   : TriangleDefect::kCollinearVertices
+            );
+        }
+    }
+}
+
+TEST(TriangleValidation, ResultDoesNotDependOnThreadCount) {
+    // Several chunks with defects in later chunks too: the earliest one must be reported
+    std::vector<Triangle> triangles{make_random_triangles(3 * 65536 + 123, 3)};
+    const Triangle duplicate{{1, 2, 3}, {4, 5, 6}, {1, 2, 3}};
+    for (const std::size_t position : {3u * 65536u + 100u, 2u * 65536u + 5u, 65536u, 65535u}) {
+        triangles[position] = duplicate;
+        const auto expected{find_first_sequentially(triangles)};
+        ASSERT_TRUE(expected.has_value());
+        EXPECT_EQ(expected->index, position);
+        for (const std::size_t num_threads : {1u, 2u, 3u, 8u, 0u}) {
+            const auto found{find_first_degenerate_triangle(triangles, num_threads)};
+            ASSERT_TRUE(found.has_value()) << num_threads;
+            EXPECT_EQ(found->index, expected->index) << num_threads;
+            EXPECT_EQ(found->defect, expected->defect) << num_threads;
+        }
+    }
+}
+
+TEST(TriangleValidation, MatchesScalarCheckOnEdgeCases) {
+    // Tiny and huge coordinates, signed zeros, NaN and infinities around the area threshold
+    const double nan{std::numeric_limits<double>::quiet_NaN()};
+    const double inf{std::numeric_limits<double>::infinity()};
+    const std::vector<Triangle> cases{
+        {{0, 0, 0}, {1e-8, 0, 0}, {0, 1e-8, 0}},      // area^2 right at the threshold
+        {{0, 0, 0}, {1e-8, 0, 0}, {0, 0.99e-8, 0}},   // just below the threshold
+        {{1e8, 1e8, 1e8}, {1e8 + 1, 1e8, 1e8}, {1e8, 1e8 + 1, 1e8}},
+        {{0., 0., 0.}, {-0., -0., -0.}, {1, 1, 0}},   // duplicates by signed zero
+        {{nan, 0, 0}, {nan, 0, 0}, {0, 1, 0}},        // NaN vertices are never equal
+        {{inf, 0, 0}, {1, 0, 0}, {0, 1, 0}},          // area is NaN
+        {{0, 0, 0}, {inf, 0, 0}, {0, inf, 0}},
+        {{0, 0, 0}, {1e-200, 0, 0}, {0, 1e-200, 0}},  // area underflows to 0
+    };
+    for (std::size_t k = 0; k < cases.size(); ++k) {
+        // Put the case in every lane of a kernel step
+        for (std::size_t position = 0; position < 4; ++position) {
+            std::vector<Triangle> triangles{make_random_triangles(8, 4)};
+            triangles[position] = cases[k];
+            const auto expected{find_first_sequentially(triangles)};
+            const auto found{find_first_degenerate_triangle(triangles)};
+            ASSERT_EQ(found.has_value(), expected.has_value()) << k;
+            if (expected) {
+                EXPECT_EQ(found->index, expected->index) << k;
+                EXPECT_EQ(found->defect, expected->defect) << k;
+            }
+        }
+    }
+}
+
+TEST(TriangleValidation, ReportsKnownKernel) {
+    const std::string kernel{triangle_validation_kernel()};
+    EXPECT_TRUE(kernel == "avx2" || kernel == "neon" || kernel == "scalar") << kernel;
+}
+
+//---------------------------------------------------------------------------
+// Error messages
+//---------------------------------------------------------------------------
+
+TEST(TriangleValidation, ThrowsSameMessagesAsBefore) {
+    const std::string collinear_message{
+        "degenerate triangle at index 300: vertices are co-linear (area is effectively zero)"
+    };
+    std::vector<Triangle> triangles{make_random_triangles(600, 5)};
+    EXPECT_EQ(validation_message(triangles), "");
+
+    // The duplicate check wins over the area check for the same triangle
+    triangles[517] = {{1, 1, 1}, {1, 1, 1}, {1, 1, 1}};
+    EXPECT_EQ(
+        validation_message(triangles), "degenerate triangle at index 517: duplicate vertices"
+    );
+
+    triangles[300] = {{0, 0, 0}, {1, 0, 0}, {2, 0, 0}};
+    EXPECT_EQ(validation_message(triangles), collinear_message);
+
+    // The mesh constructor reports the same message whatever the thread count
+    for (const std::size_t num_threads : {1u, 4u}) {
+        TriangleMeshOptions options;
+        options.num_threads = num_threads;
+        try {
+            const TriangleMesh mesh(triangles, options);
+            ADD_FAILURE() << "degenerate mesh was accepted";
+        } catch (const std::invalid_argument& e) {
+            EXPECT_EQ(std::string(e.what()), collinear_message);
+        }
+    }
+}
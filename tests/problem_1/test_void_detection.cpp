@@ -1,12 +1,17 @@
+#include <array>
 #include <cassert>
+#include <cmath>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <memory_resource>
+#include <random>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -16,15 +21,33 @@
 #include "problem_1/triangle_mesh.hpp"
 #include "problem_1/void_detection.hpp"
 
+#include "mesh_fixtures.hpp"
+
+using tsexam::problem1::aabb_contains;
+using tsexam::problem1::AabbContainmentIndex;
 using tsexam::problem1::AxisAlignedBoundingBox;
+using tsexam::problem1::ComponentSet;
 using tsexam::problem1::compute_component_aabb;
 using tsexam::problem1::ConnectedComponent;
+using tsexam::problem1::ConnectivityEngine;
 using tsexam::problem1::convert_binary_stl_to_ascii;
+using tsexam::problem1::detect_stl_format;
 using tsexam::problem1::export_voids_to_stl;
+using tsexam::problem1::find_component_set;
 using tsexam::problem1::find_connected_components;
+using tsexam::problem1::find_void_components;
 using tsexam::problem1::identify_voids;
 using tsexam::problem1::is_connected_component_closed;
+using tsexam::problem1::parse_ascii_stl;
+using tsexam::problem1::parse_binary_stl;
+using tsexam::problem1::Point;
+using tsexam::problem1::StlFormat;
+using tsexam::problem1::Triangle;
+using tsexam::problem1::TriangleIndex;
 using tsexam::problem1::TriangleMesh;
+using tsexam::problem1::TriangleMeshOptions;
+using tsexam::problem1::VoidClassification;
+using tsexam::tests::append_cube;
 
 //---------------------------------------------------------------------------
 // Helpers
@@ -725,6 +748,27 @@ TEST(ExportVoidsToStl, WritesPyramidVoidToStl) {
     expect_void_stl_content("void_detection_voids_pyramid.stl");
 }
 
+TEST(ExportVoidsToStl, BinaryExportMatchesAsciiExport) {
+    TriangleMesh mesh = make_mesh_from_stl(make_outer_cube_inner_pyramid_stl());
+    std::ostringstream ascii;
+    export_voids_to_stl(mesh, ascii);
+    std::ostringstream binary(std::ios::binary);
+    export_voids_to_stl(mesh, binary, StlFormat::kBinary);
+
+    const std::string bytes = binary.str();
+    ASSERT_EQ(detect_stl_format(std::string_view{bytes}), StlFormat::kBinary);
+    const std::vector<Triangle> from_ascii = parse_ascii_stl(std::string_view{ascii.str()});
+    const std::vector<Triangle> from_binary = parse_binary_stl(std::string_view{bytes});
+    ASSERT_EQ(from_binary.size(), from_ascii.size());
+    ASSERT_FALSE(from_binary.empty());
+    for (std::size_t i = 0; i < from_ascii.size(); ++i) {
+        // Binary STL stores float32 coordinates; the test coordinates are exactly representable
+        EXPECT_EQ(from_binary[i].a, from_ascii[i].a) << "triangle " << i;
+        EXPECT_EQ(from_binary[i].b, from_ascii[i].b) << "triangle " << i;
+        EXPECT_EQ(from_binary[i].c, from_ascii[i].c) << "triangle " << i;
+    }
+}
+
 /// Outer cube [0,0,0]-[4,4,4] with three small closed cubes inside (three voids)
 static std::string make_big_cube_with_several_voids_stl() {
     std::string s;
@@ -899,3 +943,344 @@ TEST(VoidDetection, GeometryWithVoids_BinaryStl) {
               << "  Total:                         "
               << std::chrono::duration_cast<milliseconds>(t6 - t0).count() << " ms\n";
 }
+
+TEST(VoidDetection, GeometryWithVoids_NativeBinaryStl) {
+    std::string binary_path = "geometry_with_voids.stl";
+    if (!std::filesystem::exists(binary_path)) {
+        // try relative path
+        binary_path = "../geometry_with_voids.stl";
+    }
+    // skip test if file not found
+    if (!std::filesystem::exists(binary_path)) {
+        GTEST_SKIP() << "geometry_with_voids.stl not found";
+    }
+
+    // Load the binary file directly (no ASCII round-trip) -> same voids as the converted file
+    TriangleMesh mesh(binary_path);
+    auto components = find_connected_components(mesh);
+    std::vector<ConnectedComponent> closed;
+    for (const auto& c : components) {
+        if (is_connected_component_closed(mesh, c)) {
+            closed.push_back(c);
+        }
+    }
+    EXPECT_EQ(identify_voids(mesh, closed).size(), 3u);
+
+    // Exact point-in-solid classification agrees on the exam part
+    EXPECT_EQ(identify_voids(mesh, closed, VoidClassification::kPointInSolid).size(), 3u);
+}
+
+TEST(IdentifyVoids, IndexedEnginesMatchCoordinateEngine) {
+    const auto closed_components = [](const TriangleMesh& mesh) {
+        std::vector<ConnectedComponent> closed;
+        for (auto& c : find_connected_components(mesh)) {
+            if (is_connected_component_closed(mesh, c)) {
+                closed.push_back(std::move(c));
+            }
+        }
+        return closed;
+    };
+
+    const std::string stl = make_big_cube_with_several_voids_stl();
+    const TriangleMesh coordinate_mesh(parse_ascii_stl(std::string_view{stl}));
+    const auto coordinate_closed = closed_components(coordinate_mesh);
+
+    const auto engines = {
+        ConnectivityEngine::kIndexedHashMap, ConnectivityEngine::kSortedEdges,
+        ConnectivityEngine::kNeighborTable
+    };
+    for (const auto engine : engines) {
+        const TriangleMesh mesh(
+            parse_ascii_stl(std::string_view{stl}), TriangleMeshOptions{engine}
+        );
+        const auto closed = closed_components(mesh);
+        ASSERT_EQ(closed.size(), coordinate_closed.size());
+        for (std::size_t i = 0; i < closed.size(); ++i) {
+            EXPECT_EQ(closed[i], coordinate_closed[i]);
+        }
+        EXPECT_EQ(identify_voids(mesh, closed).size(), 3u);
+    }
+}
+
+//---------------------------------------------------------------------------
+// find_connected_components -> parallel union-find labeling
+//---------------------------------------------------------------------------
+
+static void expect_same_components(
+    const std::vector<ConnectedComponent>& actual, const std::vector<ConnectedComponent>& expected
+) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (std::size_t i = 0; i < actual.size(); ++i) {
+        EXPECT_EQ(actual[i], expected[i]) << "component " << i;
+    }
+}
+
+TEST(FindConnectedComponentsParallel, ManyShellsMatchSerialOrder) {
+    // 1000 disjoint cubes whose triangles are interleaved, so every component spans the whole
+    // triangle range and the labeling chunks
+    const std::size_t num_cubes = 1000;
+    std::vector<Triangle> cubes;
+    for (std::size_t k = 0; k < num_cubes; ++k) {
+        append_cube(cubes, {2.0 * static_cast<double>(k), 0, 0});
+    }
+    std::vector<Triangle> interleaved;
+    for (std::size_t t = 0; t < 12; ++t) {
+        for (std::size_t k = 0; k < num_cubes; ++k) {
+            interleaved.push_back(cubes[12 * ((k * 7) % num_cubes) + t]);
+        }
+    }
+
+    const TriangleMesh mesh(std::move(interleaved));
+    const auto serial = find_connected_components(mesh);
+    ASSERT_EQ(serial.size(), num_cubes);
+    expect_same_components(find_connected_components(mesh, 4), serial);
+    expect_same_components(find_connected_components(mesh, 1), serial);
+}
+
+TEST(FindConnectedComponentsParallel, VoidsPipelineMatchesSerial) {
+    const TriangleMesh mesh = make_mesh_from_stl(make_big_cube_with_several_voids_stl());
+    expect_same_components(find_connected_components(mesh, 4), find_connected_components(mesh));
+}
+
+//---------------------------------------------------------------------------
+// AabbContainmentIndex
+//---------------------------------------------------------------------------
+
+TEST(AabbContainmentIndex, MatchesBruteForceOnRandomBoxes) {
+    // Boxes of widely varying sizes so that many are nested, some share coordinates exactly
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<double> position(0., 100.);
+    std::uniform_int_distribution<int> size_class(0, 3);
+    std::vector<AxisAlignedBoundingBox> boxes;
+    for (int i = 0; i < 600; ++i) {
+        const double size = (size_class(rng) == 0) ? 60. : 3.;
+        const double x = std::floor(position(rng)), y = position(rng), z = position(rng);
+        boxes.emplace_back(x, y, z, x + size, y + size, z + size);
+    }
+    boxes.push_back(boxes[0]);  // identical box is not contained (tolerance)
+
+    const AabbContainmentIndex index(boxes);
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+        std::vector<std::size_t> expected;
+        for (std::size_t j = 0; j < boxes.size(); ++j) {
+            if (i != j && aabb_contains(boxes[j], boxes[i])) {
+                expected.push_back(j);
+            }
+        }
+        EXPECT_EQ(index.FindContainers(i), expected) << "box " << i;
+        EXPECT_EQ(index.HasContainer(i), !expected.empty()) << "box " << i;
+    }
+}
+
+TEST(AabbContainmentIndex, EmptyAndSingleBox) {
+    const AabbContainmentIndex single({AxisAlignedBoundingBox(0, 0, 0, 1, 1, 1)});
+    EXPECT_FALSE(single.HasContainer(0));
+    EXPECT_TRUE(single.FindContainers(0).empty());
+    EXPECT_TRUE(AabbContainmentIndex({}).GetBoxes().empty());
+}
+
+TEST(IdentifyVoids, ManyShellsInsideAndOutsideOuterCube) {
+    // 10 x 10 small cubes inside a big cube, plus 50 small cubes next to it
+    std::vector<Triangle> triangles;
+    append_cube(triangles, {0, 0, 0}, 100.);
+    for (std::size_t i = 0; i < 10; ++i) {
+        for (std::size_t j = 0; j < 10; ++j) {
+            const double x = 5. + 9. * static_cast<double>(i);
+            const double y = 5. + 9. * static_cast<double>(j);
+            append_cube(triangles, {x, y, 50.});
+        }
+    }
+    for (std::size_t k = 0; k < 50; ++k) {
+        append_cube(triangles, {200. + 2. * static_cast<double>(k), 0, 0});
+    }
+
+    const TriangleMesh mesh(std::move(triangles));
+    const auto components = find_connected_components(mesh);
+    ASSERT_EQ(components.size(), 151u);
+    const auto voids = identify_voids(mesh, components);
+    ASSERT_EQ(voids.size(), 100u);
+    for (std::size_t k = 0; k < voids.size(); ++k) {
+        EXPECT_EQ(voids[k], components[k + 1]);  // same order as the input components
+    }
+}
+
+//---------------------------------------------------------------------------
+// identify_voids -> exact point-in-solid classification
+//---------------------------------------------------------------------------
+
+/// Closed L-shaped prism [0,10]^2 minus [4,10]^2, extruded over z in [0, 10]
+static void append_l_prism(std::vector<Triangle>& triangles) {
+    const double h = 10.;
+    const std::vector<std::array<double, 2>> polygon{{0, 0}, {10, 0}, {10, 4},
+                                                     {4, 4}, {4, 10}, {0, 10}};
+    const std::size_t n = polygon.size();
+
+    // Caps: fan from the reflex corner (4,4), which sees every other corner
+    const std::size_t fan = 3;
+    for (std::size_t k = 0; k < n; ++k) {
+        const std::size_t k1 = (k + 1) % n;
+        if (k == fan || k1 == fan) {
+            continue;
+        }
+        const auto& c = polygon[fan];
+        const auto& p = polygon[k];
+        const auto& q = polygon[k1];
+        triangles.push_back({{c[0], c[1], 0}, {q[0], q[1], 0}, {p[0], p[1], 0}});
+        triangles.push_back({{c[0], c[1], h}, {p[0], p[1], h}, {q[0], q[1], h}});
+    }
+
+    // Side walls
+    for (std::size_t k = 0; k < n; ++k) {
+        const auto& p = polygon[k];
+        const auto& q = polygon[(k + 1) % n];
+        triangles.push_back({{p[0], p[1], 0}, {q[0], q[1], 0}, {q[0], q[1], h}});
+        triangles.push_back({{p[0], p[1], 0}, {q[0], q[1], h}, {p[0], p[1], h}});
+    }
+}
+
+TEST(IdentifyVoids, PointInSolidRejectsShellInConcaveNotch) {
+    std::vector<Triangle> triangles;
+    append_l_prism(triangles);
+    append_cube(triangles, {1, 1, 1}, 2.);  // inside the L material -> real void
+    append_cube(triangles, {6, 6, 4}, 2.);  // in the notch: inside the AABB but outside the solid
+
+    const TriangleMesh mesh(std::move(triangles));
+    const auto components = find_connected_components(mesh);
+    ASSERT_EQ(components.size(), 3u);
+    for (const auto& component : components) {
+        ASSERT_TRUE(is_connected_component_closed(mesh, component));
+    }
+
+    // AABB containment reports both cubes
+    EXPECT_EQ(identify_voids(mesh, components).size(), 2u);
+
+    // Exact classification keeps only the cube inside the material
+    const auto voids = identify_voids(mesh, components, VoidClassification::kPointInSolid);
+    ASSERT_EQ(voids.size(), 1u);
+    EXPECT_EQ(voids[0], components[1]);
+}
+
+TEST(IdentifyVoids, PointInSolidMatchesAabbForNestedCubes) {
+    const TriangleMesh mesh = make_mesh_from_stl(make_big_cube_with_several_voids_stl());
+    std::vector<ConnectedComponent> closed;
+    for (auto& c : find_connected_components(mesh)) {
+        if (is_connected_component_closed(mesh, c)) {
+            closed.push_back(std::move(c));
+        }
+    }
+    const auto aabb_voids = identify_voids(mesh, closed);
+    const auto exact_voids = identify_voids(mesh, closed, VoidClassification::kPointInSolid);
+    expect_same_components(exact_voids, aabb_voids);
+}
+
+//---------------------------------------------------------------------------
+// find_component_set -> CSR components on a memory resource
+//---------------------------------------------------------------------------
+
+namespace {
+
+/// Memory resource that counts the allocations it forwards to the new/delete resource
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t allocations{0};
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++this->allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+}  // namespace
+
+/// Copies of the components of a component set
+static std::vector<ConnectedComponent> to_components(const ComponentSet& set) {
+    std::vector<ConnectedComponent> components;
+    for (std::size_t k = 0; k < set.size(); ++k) {
+        components.emplace_back(set[k].begin(), set[k].end());
+    }
+    return components;
+}
+
+TEST(FindComponentSet, MatchesFindConnectedComponents) {
+    std::vector<Triangle> triangles;
+    append_l_prism(triangles);
+    for (std::size_t k = 0; k < 300; ++k) {
+        append_cube(triangles, {20. + 2. * static_cast<double>(k), 0, 0});
+    }
+    triangles.push_back({{0, 0, 50}, {1, 0, 50}, {0, 1, 50}});  // open component
+    const TriangleMesh mesh(std::move(triangles));
+
+    const ComponentSet set{find_component_set(mesh)};
+    ASSERT_EQ(set.size(), 302u);
+    expect_same_components(to_components(set), find_connected_components(mesh));
+    EXPECT_EQ(set.GetOffsets().back(), mesh.GetTriangles().size());
+    EXPECT_FALSE(is_connected_component_closed(mesh, set[301]));
+    EXPECT_TRUE(is_connected_component_closed(mesh, set[0]));
+}
+
+TEST(FindComponentSet, AllocatesFromGivenResourceOnly) {
+    // 1000 components: a vector per component would take at least 1000 allocations
+    std::vector<Triangle> triangles;
+    for (std::size_t k = 0; k < 1000; ++k) {
+        append_cube(triangles, {2. * static_cast<double>(k), 0, 0});
+    }
+    const TriangleMesh mesh(std::move(triangles));
+
+    CountingResource counting;
+    const ComponentSet set{find_component_set(mesh, &counting)};
+    ASSERT_EQ(set.size(), 1000u);
+    EXPECT_EQ(set.GetTriangles().get_allocator().resource(), &counting);
+    EXPECT_EQ(set.GetOffsets().get_allocator().resource(), &counting);
+    EXPECT_LT(counting.allocations, 20u);
+}
+
+TEST(FindComponentSet, RejectsInconsistentOffsets) {
+    EXPECT_TRUE(ComponentSet().empty());
+    const std::pmr::vector<TriangleIndex> triangles{0, 1, 2};
+    EXPECT_THROW(ComponentSet(triangles, {}), std::invalid_argument);
+    EXPECT_THROW(ComponentSet(triangles, {1, 3}), std::invalid_argument);
+    EXPECT_THROW(ComponentSet(triangles, {0, 2}), std::invalid_argument);
+    EXPECT_THROW(ComponentSet(triangles, {0, 2, 1, 3}), std::invalid_argument);
+    const ComponentSet set(triangles, {0, 1, 3});
+    ASSERT_EQ(set.size(), 2u);
+    EXPECT_EQ(set[1].size(), 2u);
+    EXPECT_EQ(set[1][0], 1);
+}
+
+TEST(ExportVoidsToStl, ComponentSetExportMatchesMeshExport) {
+    // Whole analysis on one arena: mesh connectivity, components and void export
+    std::pmr::monotonic_buffer_resource arena;
+    TriangleMeshOptions options;
+    options.memory_resource = &arena;
+    const std::string stl{make_big_cube_with_several_voids_stl()};
+    const TriangleMesh mesh(parse_ascii_stl(std::string_view{stl}), options);
+    const ComponentSet components{find_component_set(mesh, &arena)};
+
+    std::vector<ConnectedComponent> closed;
+    for (const auto& c : find_connected_components(mesh)) {
+        if (is_connected_component_closed(mesh, c)) {
+            closed.push_back(c);
+        }
+    }
+    std::vector<ConnectedComponent> set_voids;
+    for (const std::size_t k : find_void_components(mesh, components)) {
+        set_voids.emplace_back(components[k].begin(), components[k].end());
+    }
+    ASSERT_EQ(set_voids.size(), 3u);
+    expect_same_components(set_voids, identify_voids(mesh, closed));
+
+    for (const StlFormat format : {StlFormat::kAscii, StlFormat::kBinary}) {
+        std::ostringstream expected;
+        std::ostringstream actual;
+        export_voids_to_stl(mesh, expected, format);
+        export_voids_to_stl(mesh, components, actual, format);
+        EXPECT_EQ(actual.str(), expected.str());
+    }
+}
@@ -0,0 +1,167 @@
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "problem_2/encoded_polyline.hpp"
+#include "problem_2/polyline.hpp"
+#include "problem_2/polyline_set.hpp"
+#include "problem_2/polyline_view.hpp"
+
+using tsexam::problem2::EncodedPolyline;
+using tsexam::problem2::Polyline;
+using tsexam::problem2::PolylineRepresentation;
+using tsexam::problem2::PolylineSet;
+using tsexam::problem2::PolylineType;
+using tsexam::problem2::PolylineView;
+using tsexam::problem2::VertexIndex;
+
+static_assert(std::forward_iterator<EncodedPolyline::Iterator>);
+
+//----------------------------------------------------------------------------------
+// Helpers
+//----------------------------------------------------------------------------------
+
+/// Indices produced by iterating an encoded polyline
+static std::vector<VertexIndex> iterate(const EncodedPolyline& encoded) {
+    return {encoded.begin(), encoded.end()};
+}
+
+/// Expects iteration, decoding and a serialization round trip to reproduce the ordering
+static void expect_round_trip(const std::vector<VertexIndex>& ordering) {
+    const EncodedPolyline encoded{PolylineView(ordering)};
+    EXPECT_EQ(encoded.size(), ordering.size());
+    EXPECT_EQ(iterate(encoded), ordering);
+    EXPECT_EQ(encoded.Decode(), ordering);
+
+    const EncodedPolyline restored{EncodedPolyline::Deserialize(encoded.Serialize())};
+    EXPECT_EQ(restored.Decode(), ordering);
+    EXPECT_EQ(restored.GetType(), encoded.GetType());
+}
+
+//----------------------------------------------------------------------------------
+// Encoded polyline — round trips
+//----------------------------------------------------------------------------------
+
+TEST(EncodedPolyline, RoundTripsOpenAndClosed) {
+    const Polyline open(PolylineRepresentation::kVerboseSegments, {0, 1, 4, 1, 4, 2});
+    const Polyline closed(PolylineRepresentation::kVerboseSegments, {0, 1, 1, 2, 2, 0});
+
+    const EncodedPolyline encoded_open{open};
+    EXPECT_EQ(encoded_open.Decode(), open.GetCompressedSegments());
+    EXPECT_EQ(encoded_open.GetType(), PolylineType::kOpen);
+    EXPECT_FALSE(encoded_open.IsPolygon());
+
+    const EncodedPolyline encoded_closed{closed};
+    EXPECT_EQ(encoded_closed.Decode(), closed.GetCompressedSegments());
+    EXPECT_EQ(encoded_closed.GetType(), PolylineType::kClosed);
+    EXPECT_TRUE(encoded_closed.IsPolygon());
+
+    expect_round_trip(open.GetCompressedSegments());
+    expect_round_trip(closed.GetCompressedSegments());
+    expect_round_trip({7});
+}
+
+TEST(EncodedPolyline, RoundTripsExtremeDeltas) {
+    // Jumps across the whole index range wrap around and still take at most five bytes each
+    constexpr VertexIndex kMax{std::numeric_limits<VertexIndex>::max()};
+    expect_round_trip({0, kMax, 0, kMax - 1, 1, kMax, 0});
+    expect_round_trip({kMax, 0, 1, kMax});
+
+    std::mt19937 generator{5};
+    std::uniform_int_distribution<VertexIndex> index_of{0, kMax};
+    std::vector<VertexIndex> random(10000);
+    for (VertexIndex& index : random) {
+        index = index_of(generator);
+    }
+    expect_round_trip(random);
+    EXPECT_LE(EncodedPolyline(PolylineView(random)).GetEncodedBytes().size(), 5 * random.size());
+}
+
+TEST(EncodedPolyline, DecodeMixesFastAndGeneralPaths) {
+    // Runs of small steps with an occasional large jump, at every alignment of the 8-byte loads
+    std::vector<VertexIndex> ordering;
+    VertexIndex next{100};
+    for (size_t i = 0; i < 1000; ++i) {
+        next += (i % 13 == 0) ? 100000 : (i % 2 == 0 ? 1 : -1) * static_cast<VertexIndex>(i % 7);
+        ordering.push_back(next);
+    }
+    for (size_t size = 1; size <= 40; ++size) {
+        expect_round_trip({ordering.begin(), ordering.begin() + static_cast<std::ptrdiff_t>(size)});
+    }
+    expect_round_trip(ordering);
+}
+
+//----------------------------------------------------------------------------------
+// Encoded polyline — footprint and sources
+//----------------------------------------------------------------------------------
+
+TEST(EncodedPolyline, ScanLineOrderingIsCompact) {
+    // Consecutive ids: one byte per index against four for `VertexIndex`
+    std::vector<VertexIndex> ordering(100000);
+    std::iota(ordering.begin(), ordering.end(), VertexIndex{0});
+    ordering.push_back(0);
+    const EncodedPolyline encoded{PolylineView(ordering)};
+    EXPECT_TRUE(encoded.IsPolygon());
+    EXPECT_LE(3 * encoded.GetEncodedBytes().size(), ordering.size() * sizeof(VertexIndex));
+    EXPECT_LT(encoded.Serialize().size(), ordering.size() + 16);
+    EXPECT_EQ(encoded.Decode(), ordering);
+}
+
+TEST(EncodedPolyline, EncodesSetMembersAndExternalOrderings) {
+    const PolylineSet set(std::vector<VertexIndex>{3, 4, 5, 9, 8, 7, 9}, {0, 3, 7});
+    for (size_t i = 0; i < set.size(); ++i) {
+        const EncodedPolyline encoded{set.GetPolyline(i)};
+        const auto ordering = set.GetCompressedSegments(i);
+        EXPECT_EQ(encoded.Decode(), std::vector<VertexIndex>(ordering.begin(), ordering.end()));
+        EXPECT_EQ(encoded.GetType(), set.GetType(i));
+    }
+
+    const VertexIndex external[] = {2, 1, 0};
+    EXPECT_EQ(iterate(EncodedPolyline(PolylineView(external))),
+              (std::vector<VertexIndex>{2, 1, 0}));
+    EXPECT_THROW(EncodedPolyline(PolylineView(std::vector<VertexIndex>{})), std::invalid_argument);
+}
+
+//----------------------------------------------------------------------------------
+// Encoded polyline — deserialization validation
+//----------------------------------------------------------------------------------
+
+TEST(EncodedPolyline, MalformedBytesThrow) {
+    const EncodedPolyline encoded{PolylineView(std::vector<VertexIndex>{1, 300, 2, 1})};
+    const std::vector<uint8_t> bytes{encoded.Serialize()};
+    ASSERT_NO_THROW(EncodedPolyline::Deserialize(bytes));
+
+    // Every strict prefix is truncated, and extra data is rejected
+    for (size_t size = 0; size < bytes.size(); ++size) {
+        EXPECT_THROW(EncodedPolyline::Deserialize({bytes.data(), size}), std::invalid_argument);
+    }
+    std::vector<uint8_t> trailing{bytes};
+    trailing.push_back(0);
+    EXPECT_THROW(EncodedPolyline::Deserialize(trailing), std::invalid_argument);
+
+    // Header: count, flags, payload size
+    std::vector<uint8_t> open_flag{bytes};
+    open_flag[1] = 0;
+    EXPECT_THROW(EncodedPolyline::Deserialize(open_flag), std::invalid_argument);
+    std::vector<uint8_t> unknown_flag{bytes};
+    unknown_flag[1] = 3;
+    EXPECT_THROW(EncodedPolyline::Deserialize(unknown_flag), std::invalid_argument);
+    const std::vector<uint8_t> empty = {0, 0, 0};
+    EXPECT_THROW(EncodedPolyline::Deserialize(empty), std::invalid_argument);
+
+    // Payload: a sixth varint byte, and a fifth byte carrying more than 32 bits
+    const std::vector<uint8_t> too_long = {1, 0, 6, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00};
+    EXPECT_THROW(EncodedPolyline::Deserialize(too_long), std::invalid_argument);
+    const std::vector<uint8_t> too_wide = {1, 0, 5, 0x80, 0x80, 0x80, 0x80, 0x10};
+    EXPECT_THROW(EncodedPolyline::Deserialize(too_wide), std::invalid_argument);
+    const std::vector<uint8_t> widest = {1, 0, 5, 0xFE, 0xFF, 0xFF, 0xFF, 0x0F};
+    EXPECT_EQ(EncodedPolyline::Deserialize(widest).Decode(),
+              (std::vector<VertexIndex>{std::numeric_limits<VertexIndex>::max()}));
+}
@@ -1,5 +1,8 @@
 #include <iostream>
+#include <span>
 #include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -354,6 +357,31 @@ TEST(InputValidation, FourEndpointsThrows) {
     );
 }
 
+TEST(InputValidation, TwoSeparatePolygonsThrows) {
+    //  0 --- 1     3 --- 4   (every vertex has degree 2, but the segments form two polygons)
+    //   \   /       \   /
+    //     2           5
+    const std::vector<VertexIndex> segments = {0, 1, 1, 2, 2, 0, 3, 4, 4, 5, 5, 3};
+    EXPECT_THROW(
+        Polyline(PolylineRepresentation::kVerboseSegments, segments), std::invalid_argument
+    );
+}
+
+TEST(InputValidation, OpenPolylinePlusPolygonThrows) {
+    //  0 --- 1     2 --- 3 --- 4 --- 2   (two endpoints, and a polygon the walk never reaches)
+    const std::vector<VertexIndex> segments = {0, 1, 2, 3, 3, 4, 4, 2};
+    EXPECT_THROW(
+        Polyline(PolylineRepresentation::kVerboseSegments, segments), std::invalid_argument
+    );
+}
+
+TEST(InputValidation, NegativeVertexIndexThrows) {
+    const std::vector<VertexIndex> segments = {-1, 0, 0, 1};
+    EXPECT_THROW(
+        Polyline(PolylineRepresentation::kVerboseSegments, segments), std::invalid_argument
+    );
+}
+
 //----------------------------------------------------------------------------------
 // Vertices constructor — verify vertices are preserved when provided
 //----------------------------------------------------------------------------------
@@ -381,6 +409,63 @@ TEST(VerticesConstructor, SameBehaviorAsWithout) {
     EXPECT_EQ(with_verts.IsPolygon(), without_verts.IsPolygon());
 }
 
+//----------------------------------------------------------------------------------
+// Zero-copy construction — spans and moved buffers
+//----------------------------------------------------------------------------------
+// Spans let callers pass external memory (e.g. one polyline of a memory-mapped
+// file) without materializing a vector; a moved compressed ordering becomes
+// the polyline's storage without a copy.
+//----------------------------------------------------------------------------------
+
+TEST(ZeroCopyConstruction, SpanOverPartOfLargerBuffer) {
+    // Two polylines back to back in one buffer, e.g. a file: 0-1-2-3 then 5-6-7-5
+    const std::vector<VertexIndex> file = {2, 3, 0, 1, 1, 2, 5, 6, 6, 7, 7, 5};
+    const std::span<const VertexIndex> contents(file);
+    Polyline open(PolylineRepresentation::kVerboseSegments, contents.first(6));
+    Polyline closed(PolylineRepresentation::kVerboseSegments, contents.subspan(6));
+    EXPECT_EQ(open.GetCompressedSegments(), (std::vector<VertexIndex>{0, 1, 2, 3}));
+    EXPECT_EQ(closed.GetCompressedSegments(), (std::vector<VertexIndex>{5, 6, 7, 5}));
+}
+
+TEST(ZeroCopyConstruction, MovedCompressedOrderingIsTakenOver) {
+    std::vector<VertexIndex> ordering = {4, 2, 9, 4};
+    const VertexIndex* storage{ordering.data()};
+    Polyline p(PolylineRepresentation::kCompressedVertexOrdering, std::move(ordering));
+    EXPECT_EQ(p.GetCompressedSegments().data(), storage);
+    EXPECT_TRUE(p.IsPolygon());
+}
+
+TEST(ZeroCopyConstruction, AllOverloadsAgree) {
+    const std::vector<VertexIndex> segments = {3, 2, 1, 0, 2, 1};
+    const Polyline from_vector(PolylineRepresentation::kVerboseSegments, segments);
+    const Polyline from_span(
+        PolylineRepresentation::kVerboseSegments, std::span<const VertexIndex>(segments)
+    );
+    const Polyline from_moved(
+        PolylineRepresentation::kVerboseSegments, std::vector<VertexIndex>(segments)
+    );
+    const Polyline from_list(PolylineRepresentation::kVerboseSegments, {3, 2, 1, 0, 2, 1});
+    for (const Polyline* p : {&from_span, &from_moved, &from_list}) {
+        EXPECT_EQ(p->GetCompressedSegments(), from_vector.GetCompressedSegments());
+        EXPECT_EQ(p->GetType(), from_vector.GetType());
+    }
+}
+
+TEST(ZeroCopyConstruction, MovedBuffersAreValidated) {
+    EXPECT_THROW(
+        Polyline(PolylineRepresentation::kCompressedVertexOrdering, std::vector<VertexIndex>{}),
+        std::invalid_argument
+    );
+    EXPECT_THROW(
+        Polyline(PolylineRepresentation::kVerboseSegments, std::vector<VertexIndex>{0, 1, 2}),
+        std::invalid_argument
+    );
+    EXPECT_THROW(
+        Polyline(static_cast<PolylineRepresentation>(7), std::vector<VertexIndex>{0, 1}),
+        std::invalid_argument
+    );
+}
+
 //----------------------------------------------------------------------------------
 // Sparse Vertex Indices — not all vertex indices between 0 and max are used
 //----------------------------------------------------------------------------------
@@ -462,6 +547,79 @@ TEST(SparseVertices, LongerChainMultipleGaps) {
     EXPECT_FALSE(p.IsPolygon());
 }
 
+//----------------------------------------------------------------------------------
+// Sparse Vertex Ids — global ids far apart
+//----------------------------------------------------------------------------------
+// A few segments between ids near 2^31 must not allocate window-sized arrays:
+// such windows are compacted to dense ranks, which preserve the id order and
+// therefore the compressed ordering.
+//----------------------------------------------------------------------------------
+
+TEST(SparseVertexIds, GlobalIdsNearInt32Max) {
+    //  5 --- 2147483647 --- 1000000000 --- 7
+    const std::vector<VertexIndex> segments = {1000000000, 2147483647, 7, 1000000000,
+                                               2147483647, 5};
+    Polyline p(PolylineRepresentation::kVerboseSegments, segments);
+    EXPECT_EQ(p.GetCompressedSegments(),
+              (std::vector<VertexIndex>{5, 2147483647, 1000000000, 7}));
+    EXPECT_FALSE(p.IsPolygon());
+}
+
+TEST(SparseVertexIds, MatchesDenseIdsUnderMonotoneRelabeling) {
+    // Scrambled polygon and polyline over dense ids, then the same with ids spread out by an
+    // order-preserving map: the orderings must correspond vertex for vertex
+    const std::vector<std::vector<VertexIndex>> dense_inputs = {
+        {3, 1, 4, 0, 1, 0, 5, 4, 2, 5, 3, 2},  // polygon
+        {6, 4, 2, 0, 4, 1, 0, 6, 1, 3},        // open polyline
+    };
+    auto spread = [](VertexIndex vertex) { return vertex * 300000007 + 11; };
+    for (const auto& dense : dense_inputs) {
+        std::vector<VertexIndex> sparse;
+        for (const VertexIndex vertex : dense) {
+            sparse.push_back(spread(vertex));
+        }
+        const Polyline dense_polyline(PolylineRepresentation::kVerboseSegments, dense);
+        std::vector<VertexIndex> expected;
+        for (const VertexIndex vertex : dense_polyline.GetCompressedSegments()) {
+            expected.push_back(spread(vertex));
+        }
+        EXPECT_EQ(
+            Polyline(PolylineRepresentation::kVerboseSegments, sparse).GetCompressedSegments(),
+            expected
+        );
+        EXPECT_EQ(Polyline::GetCompressedVertexOrdering(sparse, size_t{1} << 31), expected);
+    }
+}
+
+TEST(SparseVertexIds, ErrorNamesOriginalId) {
+    // Vertex 2000000000 has degree 3 in a compacted window
+    const std::vector<VertexIndex> segments = {2000000000, 3, 2000000000, 900000000, 2000000000,
+                                               17};
+    try {
+        Polyline(PolylineRepresentation::kVerboseSegments, segments);
+        FAIL() << "expected std::invalid_argument";
+    } catch (const std::invalid_argument& e) {
+        EXPECT_EQ(std::string(e.what()).rfind("vertex 2000000000 has degree 3", 0), 0u)
+            << e.what();
+    }
+}
+
+TEST(InputValidation, DegreeDoesNotWrapAround) {
+    // Star of 256 segments around vertex 0: a byte-sized degree would wrap to 0, and 256
+    // endpoints would wrap to 0 as well, passing for a polygon
+    std::vector<VertexIndex> segments;
+    for (VertexIndex leaf = 1; leaf <= 256; ++leaf) {
+        segments.push_back(0);
+        segments.push_back(leaf);
+    }
+    try {
+        Polyline(PolylineRepresentation::kVerboseSegments, segments);
+        FAIL() << "expected std::invalid_argument";
+    } catch (const std::invalid_argument& e) {
+        EXPECT_EQ(std::string(e.what()).rfind("vertex 0 has degree 256", 0), 0u) << e.what();
+    }
+}
+
 //----------------------------------------------------------------------------------
 // Additional Input Validation — degenerate and duplicate cases
 //----------------------------------------------------------------------------------
@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "problem_2/polyline.hpp"
+#include "problem_2/polyline_builder.hpp"
+
+using tsexam::problem2::Point;
+using tsexam::problem2::Polyline;
+using tsexam::problem2::PolylineBuilder;
+using tsexam::problem2::PolylineRepresentation;
+using tsexam::problem2::PolylineType;
+using tsexam::problem2::VertexIndex;
+
+//----------------------------------------------------------------------------------
+// Helpers
+//----------------------------------------------------------------------------------
+
+/**
+ * Verbose segments of a random open or closed polyline: vertex ids with gaps in shuffled order,
+ * segments shuffled and randomly flipped
+ */
+static std::vector<VertexIndex> make_segments(size_t num_segments, bool closed, uint64_t seed) {
+    std::mt19937_64 generator{seed};
+    std::vector<VertexIndex> ids(2 * num_segments + 2);
+    std::iota(ids.begin(), ids.end(), VertexIndex{1});
+    std::shuffle(ids.begin(), ids.end(), generator);
+
+    const size_t num_vertices{closed ? num_segments : num_segments + 1};
+    std::vector<std::pair<VertexIndex, VertexIndex>> segments;
+    for (size_t i = 0; i < num_segments; ++i) {
+        segments.emplace_back(ids[i], ids[(i + 1) % num_vertices]);
+    }
+    std::shuffle(segments.begin(), segments.end(), generator);
+
+    std::bernoulli_distribution coin{0.5};
+    std::vector<VertexIndex> data;
+    for (auto [from, to] : segments) {
+        if (coin(generator)) {
+            std::swap(from, to);
+        }
+        data.push_back(from);
+        data.push_back(to);
+    }
+    return data;
+}
+
+//----------------------------------------------------------------------------------
+// Polyline builder — incremental status
+//----------------------------------------------------------------------------------
+
+TEST(PolylineBuilder, TracksChainsAndClosure) {
+    //  0 --- 1 --- 2 --- 3
+    //  |                 |
+    //  +------- 4 -------+
+    PolylineBuilder builder;
+    EXPECT_EQ(builder.GetNumChains(), 0u);
+
+    builder.AddSegment(0, 1);
+    builder.AddSegment(3, 2);
+    EXPECT_EQ(builder.GetNumChains(), 2u);
+    EXPECT_EQ(builder.GetType(), PolylineType::kOpen);
+
+    builder.AddSegment(1, 2);  // joins the two chains
+    builder.AddSegment(4, 3);
+    EXPECT_EQ(builder.GetNumChains(), 1u);
+    EXPECT_FALSE(builder.IsPolygon());
+
+    builder.AddSegment(0, 4);  // closes the chain
+    EXPECT_EQ(builder.GetNumSegments(), 5u);
+    EXPECT_EQ(builder.GetNumChains(), 1u);
+    EXPECT_TRUE(builder.IsPolygon());
+    EXPECT_EQ(builder.GetType(), PolylineType::kClosed);
+
+    const Polyline polyline{builder.Build()};
+    EXPECT_EQ(polyline.GetCompressedSegments(), (std::vector<VertexIndex>{0, 1, 2, 3, 4, 0}));
+    EXPECT_EQ(polyline.GetType(), PolylineType::kClosed);
+}
+
+//----------------------------------------------------------------------------------
+// Polyline builder — equivalence with Polyline
+//----------------------------------------------------------------------------------
+
+TEST(PolylineBuilder, MatchesPolylineForAnySegmentOrder) {
+    PolylineBuilder builder;
+    for (uint64_t seed = 0; seed < 300; ++seed) {
+        const size_t num_segments{1 + seed % 40};
+        for (const bool closed : {false, true}) {
+            if (closed && num_segments < 3) {
+                continue;
+            }
+            const std::vector<VertexIndex> segments{make_segments(num_segments, closed, seed)};
+            for (size_t i = 0; i < segments.size(); i += 2) {
+                builder.AddSegment(segments[i], segments[i + 1]);
+            }
+            ASSERT_EQ(builder.IsPolygon(), closed);
+            const Polyline expected(PolylineRepresentation::kVerboseSegments, segments);
+            EXPECT_EQ(builder.Build().GetCompressedSegments(), expected.GetCompressedSegments())
+                << "seed " << seed << (closed ? ", closed" : ", open");
+            EXPECT_EQ(builder.GetNumSegments(), 0u);
+        }
+    }
+}
+
+TEST(PolylineBuilder, LongChainsFromBatches) {
+    // Batches arrive in shuffled order, so many chains are merged into each other
+    for (const bool closed : {false, true}) {
+        const std::vector<VertexIndex> segments{make_segments(50000, closed, 17)};
+        PolylineBuilder builder;
+        const size_t batch{2 * 777};
+        for (size_t begin = 0; begin < segments.size(); begin += batch) {
+            const size_t size{std::min(batch, segments.size() - begin)};
+            builder.AddSegments(std::span<const VertexIndex>(segments).subspan(begin, size));
+        }
+        const std::vector<Point> vertices(100002, Point{1., 2., 3.});
+        const Polyline polyline{builder.Build(vertices)};
+        EXPECT_EQ(polyline.GetCompressedSegments(),
+                  Polyline(PolylineRepresentation::kVerboseSegments, segments)
+                      .GetCompressedSegments());
+        EXPECT_EQ(polyline.GetVertices(), vertices);
+    }
+}
+
+TEST(PolylineBuilder, SparseIdsNearTheIndexLimit) {
+    // A table indexed by these ids would take 16 GiB
+    PolylineBuilder builder;
+    builder.AddSegment(2147483646, 2147483647);
+    EXPECT_EQ(builder.Build().GetCompressedSegments(),
+              (std::vector<VertexIndex>{2147483646, 2147483647}));
+
+    // Ids spread over the whole range, mixed with small ones, in every segment order
+    for (uint64_t seed = 0; seed < 50; ++seed) {
+        for (const bool closed : {false, true}) {
+            std::vector<VertexIndex> segments{make_segments(2000, closed, seed)};
+            for (VertexIndex& vertex : segments) {
+                if (vertex % 3 != 0) {
+                    vertex = INT32_MAX - vertex * 1000;
+                }
+            }
+            builder.AddSegments(segments);
+            EXPECT_EQ(builder.Build().GetCompressedSegments(),
+                      Polyline(PolylineRepresentation::kVerboseSegments, segments)
+                          .GetCompressedSegments())
+                << "seed " << seed << (closed ? ", closed" : ", open");
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Polyline builder — input validation
+//----------------------------------------------------------------------------------
+
+TEST(PolylineBuilder, RejectedSegmentsLeaveBuilderUnchanged) {
+    PolylineBuilder builder;
+    builder.AddSegments(std::vector<VertexIndex>{5, 9, 9, 7, 2, 3});
+
+    EXPECT_THROW(builder.AddSegment(9, 4), std::invalid_argument);   // degree 3
+    EXPECT_THROW(builder.AddSegment(6, 6), std::invalid_argument);   // to itself
+    EXPECT_THROW(builder.AddSegment(3, 2), std::invalid_argument);   // repeated
+    EXPECT_THROW(builder.AddSegment(-1, 2), std::invalid_argument);  // negative
+    EXPECT_THROW(builder.AddSegment(5, 7), std::invalid_argument);   // closes next to 2 -- 3
+    EXPECT_THROW(builder.AddSegments(std::vector<VertexIndex>{1, 2, 4}), std::invalid_argument);
+    EXPECT_EQ(builder.GetNumSegments(), 3u);
+    EXPECT_EQ(builder.GetNumChains(), 2u);
+    EXPECT_THROW(builder.Build(), std::invalid_argument);  // two chains
+
+    builder.AddSegment(7, 3);
+    EXPECT_EQ(builder.Build().GetCompressedSegments(), (std::vector<VertexIndex>{2, 3, 7, 9, 5}));
+}
+
+TEST(PolylineBuilder, ClosedPolygonAcceptsNoFurtherSegment) {
+    PolylineBuilder builder;
+    builder.AddSegments(std::vector<VertexIndex>{0, 1, 1, 2, 2, 0});
+    EXPECT_THROW(builder.AddSegment(3, 4), std::invalid_argument);
+    EXPECT_THROW(builder.AddSegment(0, 3), std::invalid_argument);
+    EXPECT_EQ(builder.Build().GetCompressedSegments(), (std::vector<VertexIndex>{0, 1, 2, 0}));
+}
+
+TEST(PolylineBuilder, EmptyBuildThrowsAndClearResets) {
+    PolylineBuilder builder;
+    EXPECT_THROW(builder.Build(), std::invalid_argument);
+
+    // The same ids after `Clear()` belong to a new polyline
+    builder.AddSegments(std::vector<VertexIndex>{0, 1, 1, 2});
+    builder.Clear();
+    EXPECT_EQ(builder.GetNumSegments(), 0u);
+    EXPECT_EQ(builder.GetNumChains(), 0u);
+    builder.AddSegments(std::vector<VertexIndex>{2, 1, 0, 2});
+    EXPECT_EQ(builder.Build().GetCompressedSegments(), (std::vector<VertexIndex>{0, 2, 1}));
+}
@@ -0,0 +1,293 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "problem_2/polyline.hpp"
+#include "problem_2/polyline_geometry.hpp"
+#include "problem_2/polyline_view.hpp"
+
+using tsexam::problem2::BoundingBox;
+using tsexam::problem2::Point;
+using tsexam::problem2::polygon_properties;
+using tsexam::problem2::PolygonProperties;
+using tsexam::problem2::Polyline;
+using tsexam::problem2::polyline_bounds;
+using tsexam::problem2::polyline_length;
+using tsexam::problem2::PolylineRepresentation;
+using tsexam::problem2::PolylineView;
+using tsexam::problem2::segment_lengths;
+using tsexam::problem2::simplify_douglas_peucker;
+using tsexam::problem2::TraversalVertices;
+using tsexam::problem2::VertexIndex;
+
+//----------------------------------------------------------------------------------
+// Helpers
+//----------------------------------------------------------------------------------
+
+/// Ordering 0, 1, ..., n - 1 (and 0 again if closed)
+static std::vector<VertexIndex> iota_ordering(size_t n, bool closed) {
+    std::vector<VertexIndex> ordering(n);
+    for (size_t i = 0; i < n; ++i) {
+        ordering[i] = static_cast<VertexIndex>(i);
+    }
+    if (closed) {
+        ordering.push_back(0);
+    }
+    return ordering;
+}
+
+/// Random walk in 3D
+static std::vector<Point> random_walk(size_t n, uint64_t seed) {
+    std::mt19937_64 generator{seed};
+    std::normal_distribution<double> step{0., 1.};
+    std::vector<Point> points(n);
+    for (size_t i = 1; i < n; ++i) {
+        for (size_t d = 0; d < 3; ++d) {
+            points[i][d] = points[i - 1][d] + step(generator);
+        }
+    }
+    return points;
+}
+
+/// Distance of p to the segment [a, b]
+static double segment_distance(const Point& p, const Point& a, const Point& b) {
+    double dot{0.}, length_squared{0.};
+    for (size_t d = 0; d < 3; ++d) {
+        dot += (p[d] - a[d]) * (b[d] - a[d]);
+        length_squared += (b[d] - a[d]) * (b[d] - a[d]);
+    }
+    const double t{length_squared > 0. ? std::clamp(dot / length_squared, 0., 1.) : 0.};
+    double distance_squared{0.};
+    for (size_t d = 0; d < 3; ++d) {
+        const double e{p[d] - a[d] - t * (b[d] - a[d])};
+        distance_squared += e * e;
+    }
+    return std::sqrt(distance_squared);
+}
+
+/// Textbook recursive Douglas–Peucker over range [first, last] of an open traversal
+static void reference_simplify(const std::vector<Point>& points, size_t first, size_t last,
+                               double tolerance, std::vector<bool>& keep) {
+    double farthest{-1.};
+    size_t index{first};
+    for (size_t i = first + 1; i < last; ++i) {
+        const double distance{segment_distance(points[i], points[first], points[last])};
+        if (distance > farthest) {
+            farthest = distance;
+            index = i;
+        }
+    }
+    if (index == first || !(farthest > tolerance)) {
+        return;
+    }
+    keep[index] = true;
+    reference_simplify(points, first, index, tolerance, keep);
+    reference_simplify(points, index, last, tolerance, keep);
+}
+
+/// Reference simplification of the open traversal 0, 1, ..., n - 1
+static std::vector<VertexIndex> reference_ordering(const std::vector<Point>& points,
+                                                   double tolerance) {
+    std::vector<bool> keep(points.size(), false);
+    keep.front() = true;
+    keep.back() = true;
+    reference_simplify(points, 0, points.size() - 1, tolerance, keep);
+    std::vector<VertexIndex> ordering;
+    for (size_t i = 0; i < keep.size(); ++i) {
+        if (keep[i]) {
+            ordering.push_back(static_cast<VertexIndex>(i));
+        }
+    }
+    return ordering;
+}
+
+//----------------------------------------------------------------------------------
+// Polyline geometry — length and bounds
+//----------------------------------------------------------------------------------
+
+TEST(PolylineGeometry, SquareLengthAndBounds) {
+    const std::vector<Point> vertices = {{0., 0., 0.}, {1., 0., 0.}, {1., 1., 0.}, {0., 1., 2.}};
+    const Polyline open(PolylineRepresentation::kCompressedVertexOrdering, {0, 1, 2, 3}, vertices);
+    const Polyline closed(PolylineRepresentation::kCompressedVertexOrdering, {0, 1, 2, 3, 0},
+                          vertices);
+    const double slanted{std::sqrt(5.)};
+
+    EXPECT_DOUBLE_EQ(polyline_length(open), 2. + slanted);
+    EXPECT_DOUBLE_EQ(polyline_length(closed), 2. + 2. * slanted);
+    EXPECT_EQ(segment_lengths(closed), (std::vector<double>{1., 1., slanted, slanted}));
+    EXPECT_EQ(segment_lengths(TraversalVertices(closed)), segment_lengths(closed));
+
+    const BoundingBox box{polyline_bounds(open)};
+    EXPECT_EQ(box.min, (Point{0., 0., 0.}));
+    EXPECT_EQ(box.max, (Point{1., 1., 2.}));
+
+    // One vertex: no segment, the box is the point
+    const std::vector<VertexIndex> single = {2};
+    EXPECT_EQ(polyline_length(PolylineView(single, vertices)), 0.);
+    EXPECT_TRUE(segment_lengths(PolylineView(single, vertices)).empty());
+    EXPECT_EQ(polyline_bounds(PolylineView(single, vertices)).max, (Point{1., 1., 0.}));
+}
+
+TEST(PolylineGeometry, GatheredAndTraversalOrderKernelsAgree) {
+    // Shuffled indices into the vertex pool, across many blocks and with a partial last step
+    std::mt19937_64 generator{4};
+    const std::vector<Point> vertices{random_walk(5000, 9)};
+    std::vector<VertexIndex> ordering{iota_ordering(vertices.size(), false)};
+    std::shuffle(ordering.begin(), ordering.end(), generator);
+    ordering.resize(4099);
+    const PolylineView view(ordering, vertices);
+    const TraversalVertices points{view};
+    ASSERT_EQ(points.size(), ordering.size());
+    EXPECT_EQ(points.GetY()[17], vertices[static_cast<size_t>(ordering[17])][1]);
+
+    double expected_length{0.};
+    BoundingBox expected_box{vertices[static_cast<size_t>(ordering[0])],
+                             vertices[static_cast<size_t>(ordering[0])]};
+    for (size_t i = 0; i < ordering.size(); ++i) {
+        const Point& p{vertices[static_cast<size_t>(ordering[i])]};
+        for (size_t d = 0; d < 3; ++d) {
+            expected_box.min[d] = std::min(expected_box.min[d], p[d]);
+            expected_box.max[d] = std::max(expected_box.max[d], p[d]);
+        }
+        if (i > 0) {
+            // Distance to a degenerate segment is the distance to its point
+            const Point& previous{vertices[static_cast<size_t>(ordering[i - 1])]};
+            expected_length += segment_distance(p, previous, previous);
+        }
+    }
+
+    // Both paths sum in the same lanes -> bitwise equal to each other
+    EXPECT_NEAR(polyline_length(view), expected_length, 1e-9 * expected_length);
+    EXPECT_EQ(polyline_length(view), polyline_length(points));
+    EXPECT_EQ(segment_lengths(view), segment_lengths(points));
+    EXPECT_EQ(polyline_bounds(view).min, expected_box.min);
+    EXPECT_EQ(polyline_bounds(points).max, expected_box.max);
+}
+
+TEST(PolylineGeometry, MissingVertexCoordinatesThrow) {
+    const std::vector<Point> vertices(3, Point{0., 0., 0.});
+    const std::vector<VertexIndex> ordering = {0, 1, 3};
+    const PolylineView view(ordering, vertices);
+    EXPECT_THROW(polyline_length(view), std::invalid_argument);
+    EXPECT_THROW(TraversalVertices{view}, std::invalid_argument);
+    EXPECT_THROW(polyline_bounds(PolylineView(ordering)), std::invalid_argument);
+}
+
+//----------------------------------------------------------------------------------
+// Polyline geometry — polygon area and centroid
+//----------------------------------------------------------------------------------
+
+TEST(PolylineGeometry, PolygonAreaCentroidAndNormal) {
+    // L shape: [0, 2] x [0, 1] and [0, 1] x [1, 2], counter-clockwise
+    const std::vector<Point> vertices = {{0., 0., 0.}, {2., 0., 0.}, {2., 1., 0.},
+                                         {1., 1., 0.}, {1., 2., 0.}, {0., 2., 0.}};
+    const std::vector<VertexIndex> ccw = {0, 1, 2, 3, 4, 5, 0};
+    const PolygonProperties properties{polygon_properties(PolylineView(ccw, vertices))};
+    EXPECT_DOUBLE_EQ(properties.area, 3.);
+    EXPECT_NEAR(properties.centroid[0], 2.5 / 3., 1e-15);
+    EXPECT_NEAR(properties.centroid[1], 2.5 / 3., 1e-15);
+    EXPECT_EQ(properties.normal, (Point{0., 0., 1.}));
+
+    // Clockwise: same area and centroid, flipped normal
+    const std::vector<VertexIndex> cw = {3, 2, 1, 0, 5, 4, 3};
+    const PolygonProperties flipped{
+        polygon_properties(TraversalVertices(PolylineView(cw, vertices)))
+    };
+    EXPECT_DOUBLE_EQ(flipped.area, 3.);
+    EXPECT_NEAR(flipped.centroid[0], 2.5 / 3., 1e-15);
+    EXPECT_EQ(flipped.normal, (Point{0., 0., -1.}));
+
+    const std::vector<VertexIndex> open = {0, 1, 2};
+    EXPECT_THROW(polygon_properties(PolylineView(open, vertices)), std::invalid_argument);
+}
+
+TEST(PolylineGeometry, TiltedPolygonFarFromOrigin) {
+    // Regular polygon of radius 1 in a tilted plane around (1e6, -2e6, 3e6)
+    constexpr size_t kNumVertices{1000};
+    const Point center{1e6, -2e6, 3e6};
+    const Point u{1. / std::sqrt(2.), 1. / std::sqrt(2.), 0.};
+    const Point v{0., 0., 1.};
+    std::vector<Point> vertices(kNumVertices);
+    for (size_t i = 0; i < kNumVertices; ++i) {
+        const double angle{2. * std::numbers::pi * static_cast<double>(i) / kNumVertices};
+        for (size_t d = 0; d < 3; ++d) {
+            vertices[i][d] = center[d] + std::cos(angle) * u[d] + std::sin(angle) * v[d];
+        }
+    }
+    const std::vector<VertexIndex> ordering{iota_ordering(kNumVertices, true)};
+    const PolygonProperties properties{polygon_properties(PolylineView(ordering, vertices))};
+
+    const double expected_area{0.5 * kNumVertices * std::sin(2. * std::numbers::pi / kNumVertices)};
+    EXPECT_NEAR(properties.area, expected_area, 1e-9);
+    for (size_t d = 0; d < 3; ++d) {
+        EXPECT_NEAR(properties.centroid[d], center[d], 1e-8);
+    }
+    // u x v, up to the rounding of the input coordinates (1e-10 near 1e6)
+    EXPECT_NEAR(properties.normal[0], 1. / std::sqrt(2.), 1e-9);
+    EXPECT_NEAR(properties.normal[1], -1. / std::sqrt(2.), 1e-9);
+    EXPECT_NEAR(properties.normal[2], 0., 1e-9);
+}
+
+//----------------------------------------------------------------------------------
+// Polyline geometry — Douglas–Peucker simplification
+//----------------------------------------------------------------------------------
+
+TEST(PolylineGeometry, SimplifyStraightAndZigZag) {
+    std::vector<Point> vertices;
+    for (size_t i = 0; i < 100; ++i) {
+        vertices.push_back({static_cast<double>(i), i % 2 == 0 ? 0. : 0.1, 0.});
+    }
+    const std::vector<VertexIndex> ordering{iota_ordering(vertices.size(), false)};
+    const PolylineView view(ordering, vertices);
+
+    EXPECT_EQ(simplify_douglas_peucker(view, 0.2), (std::vector<VertexIndex>{0, 99}));
+    EXPECT_EQ(simplify_douglas_peucker(view, 0.05), reference_ordering(vertices, 0.05));
+    EXPECT_GT(simplify_douglas_peucker(view, 0.05).size(), 50u);
+    EXPECT_THROW(simplify_douglas_peucker(view, -1.), std::invalid_argument);
+    EXPECT_THROW(simplify_douglas_peucker(view, std::numeric_limits<double>::quiet_NaN()),
+                 std::invalid_argument);
+}
+
+TEST(PolylineGeometry, SimplifyMatchesReferenceForAnyThreadCount) {
+    // Large enough for the parallel levels (several chunks per thread)
+    const std::vector<Point> vertices{random_walk(300000, 11)};
+    const std::vector<VertexIndex> ordering{iota_ordering(vertices.size(), false)};
+    const PolylineView view(ordering, vertices);
+    for (const double tolerance : {0.5, 5., 50.}) {
+        const std::vector<VertexIndex> expected{reference_ordering(vertices, tolerance)};
+        for (const size_t num_threads : {1u, 2u, 4u}) {
+            EXPECT_EQ(simplify_douglas_peucker(view, tolerance, num_threads), expected)
+                << "tolerance " << tolerance << ", " << num_threads << " threads";
+        }
+    }
+}
+
+TEST(PolylineGeometry, SimplifiedPolygonStaysPolygon) {
+    std::vector<Point> vertices;
+    for (size_t i = 0; i < 64; ++i) {
+        const double angle{2. * std::numbers::pi * static_cast<double>(i) / 64.};
+        vertices.push_back({std::cos(angle), std::sin(angle), 0.});
+    }
+    const std::vector<VertexIndex> ordering{iota_ordering(vertices.size(), true)};
+    const std::vector<VertexIndex> simplified{
+        simplify_douglas_peucker(PolylineView(ordering, vertices), 10.)
+    };
+    // Start, the opposite point, and the farthest point of one half (16 and 48 tie up to rounding)
+    ASSERT_EQ(simplified.size(), 4u);
+    EXPECT_TRUE(simplified == (std::vector<VertexIndex>{0, 16, 32, 0}) ||
+                simplified == (std::vector<VertexIndex>{0, 32, 48, 0}));
+    EXPECT_TRUE(Polyline(PolylineRepresentation::kCompressedVertexOrdering, simplified)
+                    .IsPolygon());
+
+    // A triangle is kept whole
+    const std::vector<VertexIndex> triangle = {0, 20, 40, 0};
+    EXPECT_EQ(simplify_douglas_peucker(PolylineView(triangle, vertices), 10.), triangle);
+}
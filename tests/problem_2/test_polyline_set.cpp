@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "problem_2/polyline.hpp"
+#include "problem_2/polyline_set.hpp"
+
+using tsexam::problem2::Point;
+using tsexam::problem2::Polyline;
+using tsexam::problem2::PolylineRepresentation;
+using tsexam::problem2::PolylineSet;
+using tsexam::problem2::PolylineType;
+using tsexam::problem2::VertexIndex;
+
+//----------------------------------------------------------------------------------
+// Helpers
+//----------------------------------------------------------------------------------
+
+/// Batch of polylines in one flat verbose segment buffer
+struct SegmentBatch {
+    std::vector<VertexIndex> data;  ///< verbose segments of all polylines, back to back
+    std::vector<size_t> offsets;    ///< start of every polyline in `data`, then `data.size()`
+    size_t num_vertices{0};         ///< size of the shared vertex index space
+};
+
+/// Random open and closed polylines with shuffled, flipped segments over disjoint index ranges
+static SegmentBatch make_batch(size_t num_polylines, uint64_t seed) {
+    std::mt19937_64 generator{seed};
+    std::uniform_int_distribution<size_t> num_segments_of{3, 12};
+    std::bernoulli_distribution coin{0.5};
+
+    SegmentBatch batch;
+    batch.offsets.push_back(0);
+    for (size_t p = 0; p < num_polylines; ++p) {
+        const size_t num_segments{num_segments_of(generator)};
+        const bool closed{coin(generator)};
+        const size_t num_vertices{closed ? num_segments : num_segments + 1};
+
+        // Vertices of the polyline are a shuffled range of the shared index space, with a gap
+        std::vector<VertexIndex> order(num_vertices);
+        std::iota(order.begin(), order.end(), static_cast<VertexIndex>(batch.num_vertices + 2));
+        std::shuffle(order.begin(), order.end(), generator);
+        batch.num_vertices += num_vertices + 2;
+
+        std::vector<std::pair<VertexIndex, VertexIndex>> segments;
+        for (size_t i = 0; i < num_segments; ++i) {
+            const VertexIndex from{order[i]};
+            const VertexIndex to{order[(i + 1) % num_vertices]};
+            segments.push_back(coin(generator) ? std::pair{to, from} : std::pair{from, to});
+        }
+        std::shuffle(segments.begin(), segments.end(), generator);
+        for (const auto& [from, to] : segments) {
+            batch.data.push_back(from);
+            batch.data.push_back(to);
+        }
+        batch.offsets.push_back(batch.data.size());
+    }
+    return batch;
+}
+
+/// Segments of polyline i of a batch
+static std::vector<VertexIndex> polyline_data(const SegmentBatch& batch, size_t i) {
+    return {batch.data.begin() + static_cast<std::ptrdiff_t>(batch.offsets[i]),
+            batch.data.begin() + static_cast<std::ptrdiff_t>(batch.offsets[i + 1])};
+}
+
+//----------------------------------------------------------------------------------
+// PolylineSet — bulk construction
+//----------------------------------------------------------------------------------
+
+TEST(PolylineSet, MatchesIndividualPolylines) {
+    // More than two chunks of polylines, compressed on several threads
+    const SegmentBatch batch{make_batch(10000, 11)};
+    for (const size_t num_threads : {1u, 4u}) {
+        const PolylineSet set(
+            PolylineRepresentation::kVerboseSegments, batch.data, batch.offsets, {}, num_threads
+        );
+        ASSERT_EQ(set.size(), 10000u);
+        for (size_t i = 0; i < set.size(); ++i) {
+            const Polyline polyline(
+                PolylineRepresentation::kVerboseSegments, polyline_data(batch, i)
+            );
+            const auto ordering = set.GetCompressedSegments(i);
+            ASSERT_EQ(std::vector<VertexIndex>(ordering.begin(), ordering.end()),
+                      polyline.GetCompressedSegments())
+                << "polyline " << i;
+            ASSERT_EQ(set.GetType(i), polyline.GetType()) << "polyline " << i;
+            ASSERT_EQ(set.IsPolygon(i), polyline.IsPolygon()) << "polyline " << i;
+        }
+        EXPECT_EQ(set.GetOffsets().back(), set.GetIndices().size());
+    }
+}
+
+TEST(PolylineSet, CompressedOrderingsAreStoredAsGiven) {
+    //  0 --- 1 --- 2        3 --- 4 --- 5 --- 3
+    const std::vector<VertexIndex> data = {0, 1, 2, 3, 4, 5, 3};
+    const std::vector<size_t> offsets = {0, 3, 7};
+    const std::vector<Point> vertices(6, Point{1., 2., 3.});
+    const PolylineSet set(
+        PolylineRepresentation::kCompressedVertexOrdering, data, offsets, vertices
+    );
+    ASSERT_EQ(set.size(), 2u);
+    EXPECT_EQ(set.GetIndices(), data);
+    EXPECT_EQ(set.GetOffsets(), offsets);
+    EXPECT_EQ(set.GetType(0), PolylineType::kOpen);
+    EXPECT_EQ(set.GetType(1), PolylineType::kClosed);
+    EXPECT_EQ(set.GetVertices(), vertices);
+}
+
+TEST(PolylineSet, AdoptsFlatOrderings) {
+    std::vector<VertexIndex> indices = {0, 1, 2, 3, 4, 5, 3};
+    const VertexIndex* storage{indices.data()};
+    const PolylineSet set(std::move(indices), {0, 3, 7});
+    ASSERT_EQ(set.size(), 2u);
+    EXPECT_EQ(set.GetIndices().data(), storage);  // taken over, not copied
+    EXPECT_EQ(set.GetType(0), PolylineType::kOpen);
+    EXPECT_EQ(set.GetType(1), PolylineType::kClosed);
+
+    EXPECT_THROW(PolylineSet({0, 1}, {0, 0, 2}), std::invalid_argument);  // empty polyline
+    EXPECT_THROW(PolylineSet({0, 1}, {0, 1}), std::invalid_argument);     // offsets too short
+}
+
+TEST(PolylineSet, EmptySet) {
+    const PolylineSet empty;
+    EXPECT_TRUE(empty.empty());
+    const std::vector<size_t> offsets = {0};
+    const PolylineSet also_empty(PolylineRepresentation::kVerboseSegments, {}, offsets);
+    EXPECT_EQ(also_empty.size(), 0u);
+    EXPECT_TRUE(also_empty.GetIndices().empty());
+}
+
+//----------------------------------------------------------------------------------
+// PolylineSet — input validation
+//----------------------------------------------------------------------------------
+
+TEST(PolylineSet, ErrorNamesSmallestInvalidPolyline) {
+    SegmentBatch batch{make_batch(9000, 5)};
+
+    // Break polylines 8500 and 5000 (in different chunks) by giving a vertex degree 3
+    for (const size_t broken : {8500u, 5000u}) {
+        batch.data[batch.offsets[broken] + 1] = batch.data[batch.offsets[broken]];
+    }
+    for (const size_t num_threads : {1u, 3u}) {
+        try {
+            const PolylineSet set(
+                PolylineRepresentation::kVerboseSegments, batch.data, batch.offsets, {},
+                num_threads
+            );
+            FAIL() << "expected std::invalid_argument";
+        } catch (const std::invalid_argument& e) {
+            EXPECT_EQ(std::string(e.what()).rfind("polyline 5000: ", 0), 0u) << e.what();
+        }
+    }
+}
+
+TEST(PolylineSet, InvalidPolylinesThrowLikePolyline) {
+    // Empty, odd-sized and four-endpoint polylines, each in a batch of its own
+    const std::vector<std::vector<VertexIndex>> invalid = {{}, {0, 1, 2}, {0, 1, 2, 3}};
+    for (const auto& data : invalid) {
+        const std::vector<size_t> offsets = {0, data.size()};
+        EXPECT_THROW(
+            PolylineSet(PolylineRepresentation::kVerboseSegments, data, offsets),
+            std::invalid_argument
+        );
+    }
+    const std::vector<size_t> empty_offsets = {0, 0};
+    EXPECT_THROW(
+        PolylineSet(PolylineRepresentation::kCompressedVertexOrdering, {}, empty_offsets),
+        std::invalid_argument
+    );
+}
+
+TEST(PolylineSet, MalformedOffsetsThrow) {
+    const std::vector<VertexIndex> data = {0, 1, 1, 2};
+    for (const std::vector<size_t>& offsets :
+         {std::vector<size_t>{}, std::vector<size_t>{1, 4}, std::vector<size_t>{0, 2},
+          std::vector<size_t>{0, 4, 2, 4}}) {
+        EXPECT_THROW(
+            PolylineSet(PolylineRepresentation::kVerboseSegments, data, offsets),
+            std::invalid_argument
+        );
+    }
+}
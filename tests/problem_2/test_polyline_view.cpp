@@ -0,0 +1,63 @@
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "problem_2/polyline.hpp"
+#include "problem_2/polyline_set.hpp"
+#include "problem_2/polyline_view.hpp"
+
+using tsexam::problem2::Point;
+using tsexam::problem2::Polyline;
+using tsexam::problem2::PolylineRepresentation;
+using tsexam::problem2::PolylineSet;
+using tsexam::problem2::PolylineType;
+using tsexam::problem2::PolylineView;
+using tsexam::problem2::VertexIndex;
+
+//----------------------------------------------------------------------------------
+// PolylineView — non-owning views of compressed orderings
+//----------------------------------------------------------------------------------
+
+TEST(PolylineView, ViewsExternalMemoryWithoutCopying) {
+    // Compressed orderings back to back, e.g. in a memory-mapped file: 0-1-2 then 3-4-5-3
+    const std::vector<VertexIndex> file = {0, 1, 2, 3, 4, 5, 3};
+    const std::vector<Point> vertices(6, Point{1., 2., 3.});
+    const PolylineView open(std::span<const VertexIndex>(file).first(3), vertices);
+    const PolylineView closed(std::span<const VertexIndex>(file).subspan(3));
+
+    EXPECT_EQ(open.GetCompressedSegments().data(), file.data());
+    EXPECT_EQ(open.GetVertices().data(), vertices.data());
+    EXPECT_EQ(open.GetType(), PolylineType::kOpen);
+    EXPECT_FALSE(open.IsPolygon());
+    EXPECT_EQ(closed.GetCompressedSegments().data(), file.data() + 3);
+    EXPECT_TRUE(closed.GetVertices().empty());
+    EXPECT_EQ(closed.GetType(), PolylineType::kClosed);
+    EXPECT_TRUE(closed.IsPolygon());
+}
+
+TEST(PolylineView, EmptyOrderingThrows) {
+    EXPECT_THROW(PolylineView(std::span<const VertexIndex>{}), std::invalid_argument);
+}
+
+TEST(PolylineView, ViewsPolylinesAndSetMembers) {
+    const std::vector<Point> vertices(4, Point{0., 0., 0.});
+    const Polyline polyline(PolylineRepresentation::kVerboseSegments, {2, 3, 1, 2, 0, 1}, vertices);
+    const PolylineView view{polyline};
+    EXPECT_EQ(view.GetCompressedSegments().data(), polyline.GetCompressedSegments().data());
+    EXPECT_EQ(view.GetVertices().data(), polyline.GetVertices().data());
+    EXPECT_EQ(view.GetType(), polyline.GetType());
+
+    const std::vector<VertexIndex> data = {0, 1, 2, 3, 4, 5, 3};
+    const std::vector<size_t> offsets = {0, 3, 7};
+    const PolylineSet set(
+        PolylineRepresentation::kCompressedVertexOrdering, data, offsets, vertices
+    );
+    for (size_t i = 0; i < set.size(); ++i) {
+        const PolylineView member{set.GetPolyline(i)};
+        EXPECT_EQ(member.GetCompressedSegments().data(), set.GetCompressedSegments(i).data());
+        EXPECT_EQ(member.GetVertices().data(), set.GetVertices().data());
+        EXPECT_EQ(member.IsPolygon(), set.IsPolygon(i));
+    }
+}
@@ -0,0 +1,234 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "problem_2/polyline.hpp"
+#include "problem_2/polyline_set.hpp"
+#include "problem_2/segment_soup.hpp"
+
+using tsexam::problem2::Point;
+using tsexam::problem2::Polyline;
+using tsexam::problem2::PolylineRepresentation;
+using tsexam::problem2::PolylineSet;
+using tsexam::problem2::PolylineType;
+using tsexam::problem2::split_segment_soup;
+using tsexam::problem2::VertexIndex;
+
+//----------------------------------------------------------------------------------
+// Helpers
+//----------------------------------------------------------------------------------
+
+/// Compressed ordering of polyline i of a set
+static std::vector<VertexIndex> ordering_of(const PolylineSet& set, size_t i) {
+    const auto ordering = set.GetCompressedSegments(i);
+    return {ordering.begin(), ordering.end()};
+}
+
+/// Segment soup with the expected split, computed with one `Polyline` per component
+struct Soup {
+    std::vector<VertexIndex> segments;                ///< all segments, shuffled and flipped
+    std::vector<std::vector<VertexIndex>> expected;  ///< orderings in the documented output order
+};
+
+/**
+ * Random soup of open chains and loops with the given segment counts. Vertex ids are drawn from
+ * one shuffled pool with gaps, so components interleave in the index space and in the buffer.
+ */
+static Soup make_soup(const std::vector<size_t>& segment_counts, uint64_t seed) {
+    std::mt19937_64 generator{seed};
+    std::bernoulli_distribution coin{0.5};
+
+    const size_t total_segments{std::accumulate(segment_counts.begin(), segment_counts.end(),
+                                                size_t{0})};
+    std::vector<VertexIndex> pool(2 * total_segments + segment_counts.size());
+    std::iota(pool.begin(), pool.end(), VertexIndex{3});
+    std::shuffle(pool.begin(), pool.end(), generator);
+
+    // Build every component, tagging segments with their component before shuffling
+    std::vector<std::pair<size_t, std::pair<VertexIndex, VertexIndex>>> tagged;
+    std::vector<bool> closed;
+    size_t next_vertex{0};
+    for (size_t c = 0; c < segment_counts.size(); ++c) {
+        const size_t num_segments{segment_counts[c]};
+        closed.push_back(num_segments >= 3 && coin(generator));
+        const size_t num_vertices{closed.back() ? num_segments : num_segments + 1};
+        for (size_t i = 0; i < num_segments; ++i) {
+            const VertexIndex from{pool[next_vertex + i]};
+            const VertexIndex to{pool[next_vertex + (i + 1) % num_vertices]};
+            tagged.push_back({c, coin(generator) ? std::pair{to, from} : std::pair{from, to}});
+        }
+        next_vertex += num_vertices;
+    }
+    std::shuffle(tagged.begin(), tagged.end(), generator);
+
+    // Expected: each component compressed on its own, segments kept in soup order
+    Soup soup;
+    std::vector<std::vector<VertexIndex>> component_segments(segment_counts.size());
+    for (const auto& [c, segment] : tagged) {
+        soup.segments.push_back(segment.first);
+        soup.segments.push_back(segment.second);
+        component_segments[c].push_back(segment.first);
+        component_segments[c].push_back(segment.second);
+    }
+    for (const auto& data : component_segments) {
+        soup.expected.push_back(
+            Polyline(PolylineRepresentation::kVerboseSegments, data).GetCompressedSegments()
+        );
+    }
+
+    // Open chains first, then loops, each by ascending start vertex
+    std::sort(soup.expected.begin(), soup.expected.end(), [](const auto& a, const auto& b) {
+        const bool a_closed{a.front() == a.back()};
+        const bool b_closed{b.front() == b.back()};
+        return std::pair{a_closed, a.front()} < std::pair{b_closed, b.front()};
+    });
+    return soup;
+}
+
+//----------------------------------------------------------------------------------
+// Segment soup — splitting
+//----------------------------------------------------------------------------------
+
+TEST(SegmentSoup, SplitsChainsAndLoops) {
+    //  7 --- 2 --- 5        0 --- 1        3 --- 4
+    //                                       \   /
+    //                                        6
+    const std::vector<VertexIndex> segments = {5, 2, 4, 6, 1, 0, 3, 4, 2, 7, 6, 3};
+    for (const size_t num_threads : {1u, 2u}) {
+        const PolylineSet set{split_segment_soup(segments, {}, num_threads)};
+        ASSERT_EQ(set.size(), 3u);
+        EXPECT_EQ(ordering_of(set, 0), (std::vector<VertexIndex>{0, 1}));
+        EXPECT_EQ(ordering_of(set, 1), (std::vector<VertexIndex>{5, 2, 7}));
+        EXPECT_EQ(ordering_of(set, 2), (std::vector<VertexIndex>{3, 4, 6, 3}));
+        EXPECT_EQ(set.GetType(0), PolylineType::kOpen);
+        EXPECT_EQ(set.GetType(1), PolylineType::kOpen);
+        EXPECT_EQ(set.GetType(2), PolylineType::kClosed);
+    }
+}
+
+TEST(SegmentSoup, SingleComponentMatchesPolyline) {
+    const std::vector<VertexIndex> open = {4, 9, 2, 4, 9, 7};
+    const std::vector<VertexIndex> loop = {4, 9, 2, 4, 9, 2};
+    for (const auto& segments : {open, loop}) {
+        const PolylineSet set{split_segment_soup(segments)};
+        ASSERT_EQ(set.size(), 1u);
+        EXPECT_EQ(ordering_of(set, 0),
+                  Polyline(PolylineRepresentation::kVerboseSegments, segments)
+                      .GetCompressedSegments());
+    }
+}
+
+TEST(SegmentSoup, MatchesPolylinePerComponent) {
+    std::mt19937_64 generator{21};
+    std::uniform_int_distribution<size_t> num_segments_of{1, 40};
+    std::vector<size_t> counts(500);
+    for (size_t& count : counts) {
+        count = num_segments_of(generator);
+    }
+    const Soup soup{make_soup(counts, 3)};
+    const PolylineSet set{split_segment_soup(soup.segments)};
+    ASSERT_EQ(set.size(), soup.expected.size());
+    for (size_t i = 0; i < set.size(); ++i) {
+        ASSERT_EQ(ordering_of(set, i), soup.expected[i]) << "polyline " << i;
+    }
+}
+
+TEST(SegmentSoup, ListRankingMatchesWalk) {
+    // Long chains and loops span many rulers; loops of 3 mostly catch none
+    std::vector<size_t> counts = {20000, 15000, 9000, 1, 2};
+    counts.insert(counts.end(), 3000, 3);
+    counts.insert(counts.end(), 200, 70);
+    const Soup soup{make_soup(counts, 8)};
+
+    const PolylineSet walk{split_segment_soup(soup.segments, {}, 1)};
+    ASSERT_EQ(walk.size(), soup.expected.size());
+    for (size_t i = 0; i < walk.size(); ++i) {
+        ASSERT_EQ(ordering_of(walk, i), soup.expected[i]) << "polyline " << i;
+    }
+    for (const size_t num_threads : {2u, 4u, 0u}) {
+        const PolylineSet ranked{split_segment_soup(soup.segments, {}, num_threads)};
+        EXPECT_EQ(ranked.GetIndices(), walk.GetIndices()) << num_threads << " threads";
+        EXPECT_EQ(ranked.GetOffsets(), walk.GetOffsets()) << num_threads << " threads";
+    }
+}
+
+TEST(SegmentSoup, SparseIdsAreCompacted) {
+    // The same soup with ids spread out by an order-preserving map up to near 2^31: the split must
+    // correspond vertex for vertex, and the error must name the original id
+    const Soup soup{make_soup({5, 9, 3, 4, 1}, 13)};
+    auto spread = [](VertexIndex vertex) { return vertex * 40000003 + 4; };
+    std::vector<VertexIndex> sparse;
+    for (const VertexIndex vertex : soup.segments) {
+        sparse.push_back(spread(vertex));
+    }
+    std::vector<VertexIndex> expected;
+    for (const auto& ordering : soup.expected) {
+        for (const VertexIndex vertex : ordering) {
+            expected.push_back(spread(vertex));
+        }
+    }
+    for (const size_t num_threads : {1u, 2u}) {
+        EXPECT_EQ(split_segment_soup(sparse, {}, num_threads).GetIndices(), expected);
+    }
+
+    const std::vector<VertexIndex> star = {2000000000, 3, 2000000000, 9, 2000000000, 17};
+    EXPECT_THROW(
+        {
+            try {
+                split_segment_soup(star);
+            } catch (const std::invalid_argument& e) {
+                EXPECT_EQ(std::string(e.what()).rfind("vertex 2000000000 has degree 3", 0), 0u)
+                    << e.what();
+                throw;
+            }
+        },
+        std::invalid_argument
+    );
+}
+
+TEST(SegmentSoup, EmptySoupAndVertexPool) {
+    const std::vector<Point> vertices(4, Point{1., 2., 3.});
+    const PolylineSet empty{split_segment_soup({}, vertices)};
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.GetVertices(), vertices);
+}
+
+//----------------------------------------------------------------------------------
+// Segment soup — input validation
+//----------------------------------------------------------------------------------
+
+TEST(SegmentSoup, InvalidSoupsThrowInBothModes) {
+    const std::vector<std::vector<VertexIndex>> invalid = {
+        {0, 1, 2},              // odd number of entries
+        {0, 1, -2, 1},          // negative index
+        {0, 1, 1, 1},           // segment from a vertex to itself
+        {0, 1, 2, 3, 1, 0},     // same segment twice
+        {5, 9, 5, 7, 5, 6},     // vertex of degree 3
+    };
+    for (const auto& segments : invalid) {
+        for (const size_t num_threads : {1u, 2u}) {
+            EXPECT_THROW(split_segment_soup(segments, {}, num_threads), std::invalid_argument);
+        }
+    }
+}
+
+TEST(SegmentSoup, ErrorNamesSmallestInvalidVertex) {
+    // Vertices 2 and 6 both have degree 3
+    const std::vector<VertexIndex> segments = {6, 7, 2, 0, 6, 8, 2, 1, 6, 9, 2, 3};
+    for (const size_t num_threads : {1u, 2u}) {
+        try {
+            split_segment_soup(segments, {}, num_threads);
+            FAIL() << "expected std::invalid_argument";
+        } catch (const std::invalid_argument& e) {
+            EXPECT_EQ(std::string(e.what()).rfind("vertex 2 has degree 3", 0), 0u) << e.what();
+        }
+    }
+}
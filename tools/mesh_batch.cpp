@@ -0,0 +1,166 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "problem_1/batch_processing.hpp"
+
+using tsexam::problem1::BatchOptions;
+using tsexam::problem1::BatchResult;
+using tsexam::problem1::ConnectivityEngine;
+using tsexam::problem1::process_mesh_batch;
+using tsexam::problem1::StlFormat;
+
+namespace {
+
+constexpr std::string_view kUsage{
+    "usage: mesh_batch [options] <file.stl>...\n"
+    "\n"
+    "Runs parse -> connectivity -> voids / reorientation on every file.\n"
+    "\n"
+    "options:\n"
+    "  --output <dir>        write <stem>_voids.stl / <stem>_reoriented.stl into <dir>\n"
+    "  --workers <n>         worker threads (default: one per core)\n"
+    "  --memory-mb <n>       bound on the input megabytes in flight (default: 1024)\n"
+    "  --large-file-mb <n>   files from this size run their stages in parallel (default: 64)\n"
+    "  --engine <name>       edge-hash-map, flat-edge-hash-map, indexed-hash-map, sorted-edges\n"
+    "                        or neighbor-table\n"
+    "  --reorient <seed>     also export the triangles reorienting from <seed> flips\n"
+    "  --no-voids            skip the void export\n"
+    "  --ascii               write ASCII STL (default: binary)\n"
+};
+
+/**
+ * @brief Parses a non-negative integer argument
+ *
+ * @param value Argument text
+ * @return Parsed value
+ *
+ * @throws std::invalid_argument if the text is not a non-negative integer
+ */
+std::size_t parse_count(const std::string& value) {
+    // std::stoull accepts a leading '-' (and wraps) -> reject it up front
+    if (value.empty() || value.front() == '-') {
+        throw std::invalid_argument("not a non-negative integer: " + value);
+    }
+    std::size_t end{0};
+    const unsigned long long count{std::stoull(value, &end)};
+    if (end != value.size()) {
+        throw std::invalid_argument("not a non-negative integer: " + value);
+    }
+    return static_cast<std::size_t>(count);
+}
+
+/**
+ * @brief Parses a connectivity engine name
+ *
+ * @param name Engine name as listed in the usage
+ * @return Connectivity engine
+ *
+ * @throws std::invalid_argument if the name is unknown
+ */
+ConnectivityEngine parse_engine(const std::string& name) {
+    if (name == "edge-hash-map") {
+        return ConnectivityEngine::kEdgeHashMap;
+    }
+    if (name == "indexed-hash-map") {
+        return ConnectivityEngine::kIndexedHashMap;
+    }
+    if (name == "sorted-edges") {
+        return ConnectivityEngine::kSortedEdges;
+    }
+    if (name == "neighbor-table") {
+        return ConnectivityEngine::kNeighborTable;
+    }
+    if (name == "flat-edge-hash-map") {
+        return ConnectivityEngine::kFlatEdgeHashMap;
+    }
+    throw std::invalid_argument("unknown connectivity engine: " + name);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    BatchOptions options;
+    std::vector<std::string> paths;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg{argv[i]};
+
+            // Lambda: value of an option that takes one
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument("missing value for " + arg);
+                }
+                return argv[++i];
+            };
+
+            if (arg == "--help" || arg == "-h") {
+                std::cout << kUsage;
+                return EXIT_SUCCESS;
+            } else if (arg == "--output") {
+                options.output_directory = value();
+            } else if (arg == "--workers") {
+                options.num_workers = parse_count(value());
+            } else if (arg == "--memory-mb") {
+                options.max_in_flight_bytes = parse_count(value()) << 20;
+            } else if (arg == "--large-file-mb") {
+                options.large_file_bytes = parse_count(value()) << 20;
+            } else if (arg == "--engine") {
+                options.connectivity = parse_engine(value());
+            } else if (arg == "--reorient") {
+                options.export_reoriented = true;
+                options.reorient_seed = parse_count(value());
+            } else if (arg == "--no-voids") {
+                options.export_voids = false;
+            } else if (arg == "--ascii") {
+                options.output_format = StlFormat::kAscii;
+            } else if (arg.starts_with("--")) {
+                throw std::invalid_argument("unknown option: " + arg);
+            } else {
+                paths.push_back(arg);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "mesh_batch: " << e.what() << "\n\n" << kUsage;
+        return EXIT_FAILURE;
+    }
+    if (paths.empty()) {
+        std::cerr << kUsage;
+        return EXIT_FAILURE;
+    }
+
+    const auto start{std::chrono::steady_clock::now()};
+    std::vector<BatchResult> results;
+    try {
+        results = process_mesh_batch(paths, options);
+    } catch (const std::exception& e) {
+        std::cerr << "mesh_batch: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+
+    // One line per file, then a summary
+    std::size_t num_failed{0};
+    for (const BatchResult& result : results) {
+        if (!result.succeeded) {
+            ++num_failed;
+            std::cout << result.input_path << ": error: " << result.error << '\n';
+            continue;
+        }
+        std::cout << result.input_path << ": " << result.num_triangles << " triangles, "
+                  << result.num_components << " components, " << result.num_voids << " voids";
+        if (options.export_reoriented) {
+            std::cout << ", " << result.num_reoriented << " reoriented";
+        }
+        std::cout << '\n';
+    }
+    std::cout << results.size() - num_failed << " of " << results.size() << " files processed in "
+              << elapsed.count() << " s\n";
+    return (num_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}